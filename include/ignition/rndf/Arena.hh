@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_ARENA_HH_
+#define IGNITION_RNDF_ARENA_HH_
+
+#include <cstddef>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class ArenaPrivate;
+
+    /// \brief A monotonic memory resource for the private data of the RNDF
+    /// elements (segments, lanes, zones, parking spots, perimeters,
+    /// checkpoints and nodes). Memory is requested in a few large chunks and
+    /// is never reused: releasing an object allocated in the arena costs
+    /// nothing, and the chunks are given back at once when the arena and
+    /// all the objects allocated in it have been destroyed. Objects can
+    /// therefore outlive the arena that allocated them.
+    ///
+    /// The objects are allocated in the arena that is active in the current
+    /// thread (see Arena::Scope), or on the heap when there is none. The
+    /// vectors and strings of the elements always use the heap.
+    class IGNITION_RNDF_VISIBLE Arena
+    {
+      /// \brief Activates an arena in the current thread while it exists.
+      public: class IGNITION_RNDF_VISIBLE Scope
+      {
+        /// \brief Constructor.
+        /// \param[in] _arena The arena, or nullptr to allocate on the heap.
+        public: explicit Scope(Arena *_arena);
+
+        /// \brief Destructor. The arena active before is restored.
+        public: ~Scope();
+
+        /// \brief Not copyable.
+        public: Scope(const Scope &) = delete;
+
+        /// \brief Not copyable.
+        public: Scope &operator=(const Scope &) = delete;
+
+        /// \brief The arena active before.
+        private: ArenaPrivate *previous;
+      };
+
+      /// \brief Default constructor. No memory is requested until the first
+      /// allocation.
+      public: Arena();
+
+      /// \brief Destructor. The memory is released once the objects
+      /// allocated in the arena are destroyed.
+      public: ~Arena();
+
+      /// \brief Not copyable.
+      public: Arena(const Arena &) = delete;
+
+      /// \brief Not copyable.
+      public: Arena &operator=(const Arena &) = delete;
+
+      /// \brief Get the number of chunks requested.
+      /// \return The number of chunks.
+      public: size_t NumChunks() const;
+
+      /// \brief Get the bytes requested for all the chunks.
+      /// \return The bytes.
+      public: size_t Capacity() const;
+
+      /// \brief Get the number of objects allocated in the arena and not
+      /// destroyed yet.
+      /// \return The number of objects.
+      public: size_t NumObjects() const;
+
+      /// \brief Private data. It's reference counted by the arena and by
+      /// every object allocated in it, so it outlives the arena as needed.
+      private: ArenaPrivate *dataPtr;
+    };
+
+    /// \internal
+    /// \brief Base class of the private data allocated in the active arena.
+    /// Objects in an arena carry a header with a pointer to it, while the
+    /// objects on the heap are plain allocations without any overhead.
+    /// \sa Arena
+    class IGNITION_RNDF_VISIBLE ArenaObject
+    {
+      /// \brief Allocate an object in the active arena or on the heap.
+      /// \param[in] _size Size of the object.
+      /// \return The memory for the object.
+      public: static void *operator new(std::size_t _size);
+
+      /// \brief Release an object allocated by operator new().
+      /// \param[in] _ptr The memory of the object.
+      public: static void operator delete(void *_ptr) noexcept;
+    };
+  }
+}
+#endif
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_CONTRACTIONHIERARCHY_HH_
+#define IGNITION_RNDF_CONTRACTIONHIERARCHY_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class ContractionHierarchyPrivate;
+    class RNDF;
+    class RoadGraph;
+    class UniqueId;
+
+    /// \brief A contraction hierarchy of a RoadGraph, for fast travel
+    /// distance queries between many waypoints. The nodes are contracted
+    /// one by one, from the least to the most important, adding shortcut
+    /// edges that preserve the shortest distances between the remaining
+    /// nodes. A query then only follows edges towards more important nodes,
+    /// from both ends, and visits a small part of the graph.
+    ///
+    /// Building a hierarchy is slow compared with a query, so it can be
+    /// saved next to the map and loaded later. The hierarchy stores the
+    /// unique Ids of the nodes and a hash of the graph it was built from.
+    /// The distances are the lengths in meters of the shortest routes; the
+    /// penalties of a Router aren't considered. A hierarchy isn't thread
+    /// safe: the queries reuse its search state.
+    class IGNITION_RNDF_VISIBLE ContractionHierarchy
+    {
+      /// \brief Default constructor. The hierarchy is empty.
+      public: ContractionHierarchy();
+
+      /// \brief Constructor.
+      /// \param[in] _graph The graph to contract.
+      public: explicit ContractionHierarchy(const RoadGraph &_graph);
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Other hierarchy.
+      public: ContractionHierarchy(const ContractionHierarchy &_other);
+
+      /// \brief Destructor.
+      public: virtual ~ContractionHierarchy();
+
+      /// \brief Rebuild the hierarchy from a graph.
+      /// \param[in] _graph The graph to contract.
+      public: void Update(const RoadGraph &_graph);
+
+      /// \brief Write the hierarchy to a binary file. The file is written
+      /// under a temporary name and renamed when complete.
+      /// \param[in] _filePath Path of the file.
+      /// \return True if the file was written.
+      public: bool Save(const std::string &_filePath) const;
+
+      /// \brief Read a hierarchy written by Save().
+      /// \param[in] _filePath Path of the file.
+      /// \return True if the file was read. On failure the hierarchy is
+      /// empty.
+      public: bool Load(const std::string &_filePath);
+
+      /// \brief Read a hierarchy written by Save(), checking that it was
+      /// built from a graph.
+      /// \param[in] _filePath Path of the file.
+      /// \param[in] _graph The graph.
+      /// \return True if the file was read and was built from _graph. On
+      /// failure the hierarchy is empty.
+      public: bool Load(const std::string &_filePath,
+                        const RoadGraph &_graph);
+
+      /// \brief Whether the hierarchy was built from a graph.
+      /// \param[in] _graph The graph.
+      /// \return True if the graph has the same nodes and edges as the one
+      /// the hierarchy was built from.
+      public: bool Matches(const RoadGraph &_graph) const;
+
+      /// \brief Get the number of nodes.
+      /// \return The number of nodes.
+      public: size_t NumNodes() const;
+
+      /// \brief Get the number of edges of the hierarchy, including the
+      /// shortcuts.
+      /// \return The number of edges.
+      public: size_t NumEdges() const;
+
+      /// \brief Compute the travel distance between two waypoints.
+      /// \param[in] _start Unique Id of the first waypoint.
+      /// \param[in] _goal Unique Id of the last waypoint.
+      /// \param[out] _distance Length of the shortest route in meters, or
+      /// infinity if there is no route.
+      /// \return True if both waypoints are in the hierarchy.
+      public: bool Distance(const UniqueId &_start,
+                            const UniqueId &_goal,
+                            double &_distance);
+
+      /// \brief Compute the travel distances from some waypoints to others.
+      /// \param[in] _sources Unique Ids of the first waypoints.
+      /// \param[in] _targets Unique Ids of the last waypoints.
+      /// \param[out] _distances Row-major matrix with the distance in meters
+      /// from every source (row) to every target (column), infinity if
+      /// there is no route. Its memory is reused.
+      /// \return True if all the waypoints are in the hierarchy.
+      public: bool Distances(const std::vector<UniqueId> &_sources,
+                             const std::vector<UniqueId> &_targets,
+                             std::vector<double> &_distances);
+
+      /// \brief Compute the travel distances from some checkpoints to
+      /// others.
+      /// \param[in] _rndf The RNDF with the checkpoints.
+      /// \param[in] _sources Ids of the first checkpoints.
+      /// \param[in] _targets Ids of the last checkpoints.
+      /// \param[out] _distances Row-major matrix with the distance in meters
+      /// from every source (row) to every target (column), infinity if
+      /// there is no route. Its memory is reused.
+      /// \return True if all the checkpoints are in the RNDF and their
+      /// waypoints are in the hierarchy.
+      /// \sa Checkpoint::CheckpointId()
+      public: bool CheckpointDistances(const RNDF &_rndf,
+                                       const std::vector<int> &_sources,
+                                       const std::vector<int> &_targets,
+                                       std::vector<double> &_distances);
+
+      /// \brief Assignment operator.
+      /// \param[in] _other The new hierarchy.
+      /// \return A reference to this instance.
+      public: ContractionHierarchy &operator=(
+        const ContractionHierarchy &_other);
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<ContractionHierarchyPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
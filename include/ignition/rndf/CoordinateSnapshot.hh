@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_COORDINATESNAPSHOT_HH_
+#define IGNITION_RNDF_COORDINATESNAPSHOT_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class CoordinateSnapshotPrivate;
+    class RNDF;
+
+    /// \brief A contiguous run of waypoints in a CoordinateSnapshot that
+    /// belong to the same lane, perimeter or parking spot.
+    struct CoordinateRange
+    {
+      /// \brief Segment or zone Id.
+      public: int x;
+
+      /// \brief Lane or parking spot Id, or 0 for a zone perimeter.
+      public: int y;
+
+      /// \brief Position of the first waypoint of the range.
+      public: uint32_t begin;
+
+      /// \brief Position after the last waypoint of the range.
+      public: uint32_t end;
+    };
+
+    /// \brief A flat, structure-of-arrays copy of the coordinates of all the
+    /// waypoints of a RNDF. Waypoint i has latitude Latitudes()[i],
+    /// longitude Longitudes()[i] and unique Id key Keys()[i]. The waypoints
+    /// of the lanes come first, in segment and lane order, followed by the
+    /// perimeter and the parking spots of every zone.
+    class IGNITION_RNDF_VISIBLE CoordinateSnapshot
+    {
+      /// \brief Default constructor. The snapshot is empty.
+      public: CoordinateSnapshot();
+
+      /// \brief Constructor.
+      /// \param[in] _rndf The RNDF to copy the coordinates from.
+      public: explicit CoordinateSnapshot(const RNDF &_rndf);
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Other snapshot.
+      public: CoordinateSnapshot(const CoordinateSnapshot &_other);
+
+      /// \brief Destructor.
+      public: virtual ~CoordinateSnapshot();
+
+      /// \brief Replace the content of the snapshot with the coordinates
+      /// of a RNDF.
+      /// \param[in] _rndf The RNDF to copy the coordinates from.
+      public: void Update(const RNDF &_rndf);
+
+      /// \brief Copy the coordinates of the waypoints of some segments and
+      /// zones of a RNDF in place. If the other segments and zones, or the
+      /// waypoints of these, are not the ones stored, the whole snapshot is
+      /// rebuilt instead.
+      /// \param[in] _rndf The RNDF to copy the coordinates from.
+      /// \param[in] _ids Sorted Ids of the segments and zones to copy.
+      /// \param[out] _updated Positions of the waypoints copied in place.
+      /// \return True if the coordinates were copied in place, false if the
+      /// snapshot was rebuilt.
+      /// \sa RNDF::Changes()
+      public: bool Update(const RNDF &_rndf, const std::vector<int> &_ids,
+                          std::vector<uint32_t> &_updated);
+
+      /// \brief Get the number of waypoints stored.
+      /// \return The number of waypoints.
+      public: size_t Size() const;
+
+      /// \brief Get the latitudes of the waypoints.
+      /// \return The latitudes in degrees.
+      public: const std::vector<double> &Latitudes() const;
+
+      /// \brief Get the longitudes of the waypoints.
+      /// \return The longitudes in degrees.
+      public: const std::vector<double> &Longitudes() const;
+
+      /// \brief Get the unique Id keys of the waypoints.
+      /// \return The keys.
+      /// \sa UniqueId::Key()
+      public: const std::vector<uint64_t> &Keys() const;
+
+      /// \brief Get the ranges of waypoints of every lane, perimeter and
+      /// parking spot, in the order they are stored.
+      /// \return The ranges.
+      public: const std::vector<CoordinateRange> &Ranges() const;
+
+      /// \brief Assignment operator.
+      /// \param[in] _other The new snapshot.
+      /// \return A reference to this instance.
+      public: CoordinateSnapshot &operator=(const CoordinateSnapshot &_other);
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<CoordinateSnapshotPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
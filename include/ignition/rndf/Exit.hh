@@ -28,6 +28,9 @@ namespace ignition
 {
   namespace rndf
   {
+    // Forward declarations.
+    class LineReader;
+
     /// \brief An exit clas that shows how to go from an exit waypoint to
     /// an entry waypoint. The waypoints are represented with their unique Id.
     class IGNITION_RNDF_VISIBLE Exit
@@ -53,6 +56,21 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load an exit from a line reader.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _x The expected "x" value from an x.y.z Id.
+      /// \param[in] _y The expected "y" value from an x.y.z Id.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[out] _lineRead Entire text line used to parse the exit.
+      /// \return True if a zone block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const int _x,
+                        const int _y,
+                        int &_lineNumber,
+                        std::string &_lineRead);
+
       /// \brief Load an exit from an input stream coming from a text file.
       /// The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -18,6 +18,7 @@
 #ifndef IGNITION_RNDF_LANE_HH_
 #define IGNITION_RNDF_LANE_HH_
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -34,6 +35,8 @@ namespace ignition
     class Exit;
     class LaneHeaderPrivate;
     class LanePrivate;
+    class LineReader;
+    class RNDFVisitor;
     class Waypoint;
     struct ExitCacheEntry;
 
@@ -66,6 +69,22 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a lane header from a line reader. The expected
+      /// format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _segmentId The expected zone Id.
+      /// \param[in] _laneId The expected lane Id.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _visitor Visitor that receives the checkpoints,
+      /// stops and exits parsed.
+      /// \return True if a lane header block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const int _segmentId,
+                        const int _laneId,
+                        int &_lineNumber,
+                        RNDFVisitor &_visitor);
+
       /// \brief Load a lane header from an input stream coming from a
       /// text file. The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -226,6 +245,12 @@ namespace ignition
       /// \sa Valid.
       public: explicit Lane(const Lane &_other);
 
+      /// \brief Move constructor. The content of _other is transferred
+      /// without copying it.
+      /// \param[in, out] _other Other lane. It can only be destroyed or
+      /// assigned to after the move.
+      public: Lane(Lane &&_other) noexcept;  // NOLINT
+
       /// \brief Destructor.
       public: virtual ~Lane();
 
@@ -233,6 +258,37 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a lane from a line reader.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _segmentId Expected segment Id.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Keys of the waypoints parsed.
+      /// \return True if a lane block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const int _segmentId,
+                        int &_lineNumber,
+                        std::vector<ExitCacheEntry> &_exitCache,
+                        std::vector<uint64_t> &_waypointCache);
+
+      /// \brief Parse a lane from a line reader and report its elements to
+      /// a visitor, without storing them.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _segmentId Expected segment Id.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _visitor Visitor that receives the lane elements.
+      /// \param[out] _laneId Id of the lane parsed.
+      /// \return True if a lane block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: static bool Parse(LineReader &_reader,
+                                const int _segmentId,
+                                int &_lineNumber,
+                                RNDFVisitor &_visitor,
+                                int &_laneId);
+
       /// \brief Load a lane from an input stream coming from a text file.
       /// The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -240,6 +296,23 @@ namespace ignition
       /// \param[in, out] _lineNumber Line number pointed by the stream position
       /// indicator.
       /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Keys of the waypoints parsed.
+      /// \return True if a lane block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(std::ifstream &_rndfFile,
+                        const int _segmentId,
+                        int &_lineNumber,
+                        std::vector<ExitCacheEntry> &_exitCache,
+                        std::vector<uint64_t> &_waypointCache);
+
+      /// \brief Load a lane from an input stream coming from a text file.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \deprecated Use the overload that caches the waypoint keys.
+      /// \param[in, out] _rndfFile Input file stream.
+      /// \param[in, out] _segmentId Expected segment Id.
+      /// \param[in, out] _lineNumber Line number pointed by the stream position
+      /// indicator.
+      /// \param[in, out] _exitCache Cache of exits parsed.
       /// \param[in, out] _waypointCache Cache of waypoints parsed.
       /// \return True if a lane block was found and parsed or
       /// false otherwise (e.g.: EoF or incorrect format found).
@@ -249,6 +322,16 @@ namespace ignition
                         std::vector<ExitCacheEntry> &_exitCache,
                         std::vector<std::string> &_waypointCache);
 
+      /// \brief Write the lane as text, in the format read by Load().
+      /// The width is written in feet, rounded to an integer, as the format
+      /// requires.
+      /// \param[in, out] _stream Output stream.
+      /// \param[in] _segmentId Id of the segment that contains the lane.
+      /// \return True if the lane was written or false otherwise
+      /// (e.g.: the stream is in a bad state).
+      public: bool Save(std::ostream &_stream,
+                        const int _segmentId) const;
+
       ///////
       /// Id
       ///////
@@ -287,6 +370,18 @@ namespace ignition
       public: bool Waypoint(const int _wpId,
                             rndf::Waypoint &_wp) const;
 
+      /// \brief Get the waypoint with Id _wpId without copying it.
+      /// \param[in] _wpId The waypoint Id.
+      /// \return Pointer to the waypoint, or nullptr if not found. It is
+      /// valid until the vector of waypoints changes.
+      public: const rndf::Waypoint *Waypoint(const int _wpId) const;
+
+      /// \brief Get the waypoint with Id _wpId to edit it in place.
+      /// \param[in] _wpId The waypoint Id.
+      /// \return Pointer to the waypoint, or nullptr if not found. It is
+      /// valid until the vector of waypoints changes.
+      public: rndf::Waypoint *Waypoint(const int _wpId);
+
       /// \brief Update an existing waypoint.
       /// \param[in] _wp The updated waypoint.
       /// \return True if the waypoint was found and updated or false otherwise.
@@ -465,6 +560,13 @@ namespace ignition
       /// \return A reference to this instance.
       public: Lane &operator=(const Lane &_other);
 
+      /// \brief Move assignment operator. The content of _other is
+      /// transferred without copying it.
+      /// \param[in, out] _other The new lane. It receives the previous
+      /// content of this instance.
+      /// \return A reference to this instance.
+      public: Lane &operator=(Lane &&_other) noexcept;  // NOLINT
+
       /// \internal
       /// \brief Smart pointer to private data.
 #ifdef _WIN32
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_LANEINDEX_HH_
+#define IGNITION_RNDF_LANEINDEX_HH_
+
+#include <memory>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class LaneIndexPrivate;
+    class RNDF;
+
+    /// \brief The projection of a location on the centerline of a lane.
+    struct LaneProjection
+    {
+      /// \brief Id of the segment of the lane, or 0 if the location wasn't
+      /// projected.
+      public: int segmentId = 0;
+
+      /// \brief Id of the lane, or 0 if the location wasn't projected.
+      public: int laneId = 0;
+
+      /// \brief Id of the waypoint at the start of the centerline piece
+      /// that contains the projection.
+      public: int waypointId = 0;
+
+      /// \brief Distance in meters along the centerline from the first
+      /// waypoint of the lane to the projection.
+      public: double arcLength = 0;
+
+      /// \brief Signed distance in meters from the projection to the
+      /// location. It's positive when the location is on the left of the
+      /// lane, in the direction of its waypoints.
+      public: double lateralOffset = 0;
+
+      /// \brief Whether the location is inside the lane, i.e. the distance
+      /// to the centerline is at most half the width of the lane. Always
+      /// false for lanes without a width.
+      public: bool inLane = false;
+    };
+
+    /// \brief A bounding volume hierarchy over the centerlines of the lanes
+    /// of a RNDF, for projecting locations on the closest lane. The
+    /// centerline of a lane is the polyline through its waypoints. The
+    /// waypoints are projected to a local frame in meters centered on the
+    /// RNDF (an equirectangular projection), where distances are accurate
+    /// for networks spanning tens of kilometers. The index is a copy: it
+    /// isn't updated when the RNDF changes. RNDF::LaneIndex() returns an
+    /// index that is rebuilt when needed.
+    class IGNITION_RNDF_VISIBLE LaneIndex
+    {
+      /// \brief Default constructor. The index is empty.
+      public: LaneIndex();
+
+      /// \brief Constructor.
+      /// \param[in] _rndf The RNDF with the lanes to index.
+      public: explicit LaneIndex(const RNDF &_rndf);
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Other index.
+      public: LaneIndex(const LaneIndex &_other);
+
+      /// \brief Destructor.
+      public: virtual ~LaneIndex();
+
+      /// \brief Rebuild the index with the lanes of a RNDF.
+      /// \param[in] _rndf The RNDF with the lanes to index.
+      public: void Update(const RNDF &_rndf);
+
+      /// \brief Get the number of centerline pieces indexed. A lane with
+      /// n > 1 waypoints has n - 1 pieces and a lane with one waypoint has
+      /// one piece of length zero.
+      /// \return The number of pieces.
+      public: size_t Size() const;
+
+      /// \brief Project a location on the closest lane centerline.
+      /// \param[in] _latitude Latitude of the location in degrees.
+      /// \param[in] _longitude Longitude of the location in degrees.
+      /// \param[out] _projection The projection.
+      /// \return True if the location was projected or false if there are
+      /// no lanes.
+      public: bool Project(const double _latitude,
+                           const double _longitude,
+                           LaneProjection &_projection) const;
+
+      /// \brief Project many locations on their closest lane centerlines.
+      /// The locations are visited in an order that keeps nearby locations
+      /// together, and the result of each one bounds the search of the
+      /// next one, so a batch of locations along a trajectory is faster to
+      /// project than the same locations one by one.
+      /// \param[in] _latitudes Latitudes of the locations in degrees.
+      /// \param[in] _longitudes Longitudes of the locations in degrees. It
+      /// must have the same size as _latitudes.
+      /// \param[out] _projections Projection of every location, in the
+      /// same order as the locations. Its memory is reused.
+      /// \return The number of locations projected: the number of locations
+      /// or 0 if there are no lanes or the input sizes don't match.
+      public: size_t Project(const std::vector<double> &_latitudes,
+                             const std::vector<double> &_longitudes,
+                             std::vector<LaneProjection> &_projections) const;
+
+      /// \brief Assignment operator.
+      /// \param[in] _other The new index.
+      /// \return A reference to this instance.
+      public: LaneIndex &operator=(const LaneIndex &_other);
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<LaneIndexPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
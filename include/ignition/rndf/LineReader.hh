@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_LINEREADER_HH_
+#define IGNITION_RNDF_LINEREADER_HH_
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include "ignition/rndf/Helpers.hh"
+#include "ignition/rndf/StringView.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class LineReaderPrivate;
+
+    /// \brief Sequential reader of the lines of a RNDF text with one line of
+    /// lookahead. The content is either memory-mapped from a file, borrowed
+    /// from a caller's buffer or read line by line from an input stream.
+    /// Lines are returned as views, so reading a line doesn't allocate
+    /// memory.
+    ///
+    /// Parsers of optional blocks call Peek() to inspect the next line and
+    /// Consume() only if the line belongs to them. This way each line is read
+    /// and trimmed once and the source never needs to be rewound, so
+    /// non-seekable streams (e.g.: pipes) are supported.
+    class IGNITION_RNDF_VISIBLE LineReader
+    {
+      /// \brief Default constructor. The reader is empty until Open() is
+      /// called.
+      public: LineReader();
+
+      /// \brief Constructor that reads from a memory buffer. The buffer is
+      /// not copied and must outlive the reader.
+      /// \param[in] _data Pointer to the first character.
+      /// \param[in] _size Number of characters.
+      public: LineReader(const char *_data,
+                         const size_t _size);
+
+      /// \brief Constructor that reads from an input stream. When the reader
+      /// is destroyed, a seekable stream is positioned right after the last
+      /// line consumed, as if the lines had been read directly from it.
+      /// \param[in, out] _stream Input stream.
+      public: explicit LineReader(std::istream &_stream);
+
+      /// \brief Destructor.
+      public: virtual ~LineReader();
+
+      /// \brief Map a file in memory for reading. Files that can't be
+      /// mapped, such as pipes, FIFOs or /dev/stdin, are read entirely into
+      /// memory instead.
+      /// \param[in] _filePath Path to the file.
+      /// \return True if the file was opened and mapped or read, false
+      /// otherwise.
+      public: bool Open(const std::string &_filePath);
+
+      /// \brief Get the next line containing parsable content without
+      /// consuming it. Blank lines or lines with just a comment aren't
+      /// considered parsable lines and are skipped. The line returned is
+      /// trimmed as described in trimWhitespaces(). Calling Peek() again
+      /// before Consume() returns the same line. The view stays valid after
+      /// the line is consumed, until the next line is read by Peek() or
+      /// NextRealLine(), Open() is called or the reader is destroyed.
+      /// \param[out] _line Next line with parsable content or an empty view
+      /// if the end of the content was reached.
+      /// \return True if a line was found or false otherwise.
+      public: bool Peek(StringView &_line);
+
+      /// \brief Consume the line returned by Peek(), including the blank
+      /// lines skipped before it.
+      /// \param[in, out] _lineNumber Line number pointed by the reader. It's
+      /// advanced by the number of lines consumed.
+      public: void Consume(int &_lineNumber);
+
+      /// \brief Read lines until one containing parsable content is found.
+      /// This is equivalent to Peek() followed by Consume().
+      /// \param[out] _line First line found with parsable content or an empty
+      /// view if the end of the content was reached. It's valid for as long
+      /// as a view returned by Peek().
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \return True if a line was found or false otherwise.
+      public: bool NextRealLine(StringView &_line,
+                                int &_lineNumber);
+
+      /// \brief Get the content that hasn't been consumed yet. It's only
+      /// available when reading from a memory buffer or a mapped file.
+      /// \param[out] _content View of the content after the last line
+      /// consumed. It's valid as long as the reader's source.
+      /// \return True if the content is available or false if reading from
+      /// a stream.
+      public: bool Remaining(StringView &_content) const;
+
+      /// \brief Consume a number of characters from the start of
+      /// Remaining(). It should end at a line boundary.
+      /// \param[in] _size Number of characters to consume.
+      /// \param[in, out] _lineNumber Line number pointed by the reader. It's
+      /// advanced by the number of lines consumed.
+      /// \return True if the characters were consumed or false if reading
+      /// from a stream or if there aren't enough characters left.
+      public: bool Skip(const size_t _size,
+                        int &_lineNumber);
+
+      /// \brief Whether all the content has been consumed.
+      /// \return True if there are no more lines to read.
+      public: bool Eof() const;
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<LineReaderPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_LOCALCOORDINATES_HH_
+#define IGNITION_RNDF_LOCALCOORDINATES_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class CoordinateSnapshot;
+    class LocalCoordinatesPrivate;
+    struct CoordinateRange;
+
+    /// \brief The waypoints of a CoordinateSnapshot projected once to a
+    /// local east-north-up (ENU) frame on the WGS84 ellipsoid, so metric
+    /// geometry runs on planar coordinates in meters without any
+    /// trigonometry. Waypoint i of the snapshot has east coordinate East()[i]
+    /// and north coordinate North()[i]. The origin of the frame is either
+    /// given or the centroid of the waypoints. The coordinates are a copy:
+    /// they aren't updated when the RNDF changes. RNDF::LocalCoordinates()
+    /// returns coordinates that are updated when needed.
+    class IGNITION_RNDF_VISIBLE LocalCoordinates
+    {
+      /// \brief Default constructor. There are no waypoints and the origin
+      /// is at latitude and longitude 0.
+      public: LocalCoordinates();
+
+      /// \brief Constructor. The origin is the centroid of the waypoints.
+      /// \param[in] _coordinates Coordinates of the waypoints to project.
+      public: explicit LocalCoordinates(
+                const CoordinateSnapshot &_coordinates);
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Other local coordinates.
+      public: LocalCoordinates(const LocalCoordinates &_other);
+
+      /// \brief Destructor.
+      public: virtual ~LocalCoordinates();
+
+      /// \brief Project other waypoints, with the origin at their centroid:
+      /// the mean of their latitudes and longitudes.
+      /// \param[in] _coordinates Coordinates of the waypoints to project.
+      public: void Update(const CoordinateSnapshot &_coordinates);
+
+      /// \brief Project other waypoints with a given origin.
+      /// \param[in] _coordinates Coordinates of the waypoints to project.
+      /// \param[in] _originLatitude Latitude of the origin in degrees.
+      /// \param[in] _originLongitude Longitude of the origin in degrees.
+      public: void Update(const CoordinateSnapshot &_coordinates,
+                          const double _originLatitude,
+                          const double _originLongitude);
+
+      /// \brief Project again some waypoints that moved. The origin is
+      /// kept.
+      /// \param[in] _coordinates Coordinates of the waypoints, which must
+      /// be the ones projected, in the same order, with some of them moved.
+      /// Otherwise all of them are projected again.
+      /// \param[in] _moved Positions in _coordinates of the waypoints moved.
+      /// \sa CoordinateSnapshot::Update(const RNDF &,
+      /// const std::vector<int> &, std::vector<uint32_t> &)
+      public: void Update(const CoordinateSnapshot &_coordinates,
+                          const std::vector<uint32_t> &_moved);
+
+      /// \brief Get the number of waypoints projected.
+      /// \return The number of waypoints.
+      public: size_t Size() const;
+
+      /// \brief Get the latitude of the origin of the frame.
+      /// \return The latitude in degrees.
+      public: double OriginLatitude() const;
+
+      /// \brief Get the longitude of the origin of the frame.
+      /// \return The longitude in degrees.
+      public: double OriginLongitude() const;
+
+      /// \brief Get the east coordinates of the waypoints.
+      /// \return The coordinates in meters.
+      public: const std::vector<double> &East() const;
+
+      /// \brief Get the north coordinates of the waypoints.
+      /// \return The coordinates in meters.
+      public: const std::vector<double> &North() const;
+
+      /// \brief Project a location to the frame.
+      /// \param[in] _latitude Latitude in degrees.
+      /// \param[in] _longitude Longitude in degrees.
+      /// \param[out] _east East coordinate in meters.
+      /// \param[out] _north North coordinate in meters.
+      public: void Project(const double _latitude,
+                           const double _longitude,
+                           double &_east,
+                           double &_north) const;
+
+      /// \brief Get the location of a point of the frame on the ellipsoid.
+      /// It's the inverse of Project().
+      /// \param[in] _east East coordinate in meters.
+      /// \param[in] _north North coordinate in meters.
+      /// \param[out] _latitude Latitude in degrees.
+      /// \param[out] _longitude Longitude in degrees.
+      public: void Unproject(const double _east,
+                             const double _north,
+                             double &_latitude,
+                             double &_longitude) const;
+
+      /// \brief Get the planar distance between two waypoints.
+      /// \param[in] _a Position of a waypoint.
+      /// \param[in] _b Position of another waypoint.
+      /// \return The distance in meters.
+      public: double Distance(const uint32_t _a, const uint32_t _b) const;
+
+      /// \brief Get the heading from a waypoint to another one.
+      /// \param[in] _a Position of a waypoint.
+      /// \param[in] _b Position of another waypoint.
+      /// \return The angle in radians from the east axis, counterclockwise,
+      /// in [-pi, pi].
+      public: double Heading(const uint32_t _a, const uint32_t _b) const;
+
+      /// \brief Get the curvature of the circle through three waypoints.
+      /// \param[in] _a Position of the first waypoint.
+      /// \param[in] _b Position of the second waypoint.
+      /// \param[in] _c Position of the third waypoint.
+      /// \return The curvature in 1/meters, positive if the waypoints turn
+      /// counterclockwise, negative if they turn clockwise and 0 if they
+      /// are aligned or two of them are at the same location.
+      public: double Curvature(const uint32_t _a, const uint32_t _b,
+                               const uint32_t _c) const;
+
+      /// \brief Get the length of the polyline through a range of waypoints,
+      /// such as a lane.
+      /// \param[in] _range The range.
+      /// \return The length in meters.
+      /// \sa CoordinateSnapshot::Ranges()
+      public: double Length(const CoordinateRange &_range) const;
+
+      /// \brief Assignment operator.
+      /// \param[in] _other The new local coordinates.
+      /// \return A reference to this instance.
+      public: LocalCoordinates &operator=(const LocalCoordinates &_other);
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<LocalCoordinatesPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
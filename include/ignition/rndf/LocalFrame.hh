@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_LOCALFRAME_HH_
+#define IGNITION_RNDF_LOCALFRAME_HH_
+
+#include <cmath>
+#include <ignition/math/Helpers.hh>
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief A planar frame around an origin, where locations are
+    /// projected with an equirectangular approximation: the east and north
+    /// coordinates are proportional to the differences of longitude and
+    /// latitude with the origin. It's accurate enough over the extent of a
+    /// RNDF and only takes two multiplications per location, so the spatial
+    /// and lane indexes use it for their queries. LocalCoordinates is the
+    /// exact east-north-up frame.
+    class LocalFrame
+    {
+      /// \brief Place the origin at the center of a bounding box.
+      /// \param[in] _minLatitude Minimum latitude in degrees.
+      /// \param[in] _maxLatitude Maximum latitude in degrees.
+      /// \param[in] _minLongitude Minimum longitude in degrees.
+      /// \param[in] _maxLongitude Maximum longitude in degrees.
+      public: void SetBounds(const double _minLatitude,
+                             const double _maxLatitude,
+                             const double _minLongitude,
+                             const double _maxLongitude)
+      {
+        // Mean radius of the Earth in meters.
+        const double kEarthRadius = 6371008.8;
+        this->originLatitude = (_minLatitude + _maxLatitude) / 2;
+        this->originLongitude = (_minLongitude + _maxLongitude) / 2;
+        this->metersPerDegreeLat = kEarthRadius * IGN_DTOR(1.0);
+        this->metersPerDegreeLon = this->metersPerDegreeLat *
+          std::cos(IGN_DTOR(this->originLatitude));
+      }
+
+      /// \brief Project a location to the frame.
+      /// \param[in] _latitude Latitude in degrees.
+      /// \param[in] _longitude Longitude in degrees.
+      /// \param[out] _x East coordinate in meters.
+      /// \param[out] _y North coordinate in meters.
+      public: void Project(const double _latitude, const double _longitude,
+                           double &_x, double &_y) const
+      {
+        _x = (_longitude - this->originLongitude) * this->metersPerDegreeLon;
+        _y = (_latitude - this->originLatitude) * this->metersPerDegreeLat;
+      }
+
+      /// \brief Latitude of the origin in degrees.
+      private: double originLatitude = 0;
+
+      /// \brief Longitude of the origin in degrees.
+      private: double originLongitude = 0;
+
+      /// \brief Meters per degree of latitude.
+      private: double metersPerDegreeLat = 0;
+
+      /// \brief Meters per degree of longitude at the origin.
+      private: double metersPerDegreeLon = 0;
+    };
+  }
+}
+#endif
@@ -30,8 +30,10 @@ namespace ignition
   {
     // Forward declarations.
     class Checkpoint;
+    class LineReader;
     class ParkingSpotPrivate;
     class ParkingSpotHeaderPrivate;
+    class RNDFVisitor;
     class Waypoint;
 
     /// \internal
@@ -48,6 +50,19 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a parking spot header from a line reader. The expected
+      /// format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _zoneId The zone Id in which the spot is located.
+      /// \param[in] _spotId The spot Id.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \return True if a parking spot header block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const int _zoneId,
+                        const int _spotId,
+                        int &_lineNumber);
+
       /// \brief Load a parking spot header from an input stream coming from a
       /// text file. The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -102,6 +117,12 @@ namespace ignition
       /// \param[in] _other Other parking spot.
       public: ParkingSpot(const ParkingSpot &_other);
 
+      /// \brief Move constructor. The content of _other is transferred
+      /// without copying it.
+      /// \param[in, out] _other Other parking spot. It can only be destroyed or
+      /// assigned to after the move.
+      public: ParkingSpot(ParkingSpot &&_other) noexcept;  // NOLINT
+
       /// \brief Destructor.
       public: virtual ~ParkingSpot();
 
@@ -109,6 +130,33 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a parking spot from a line reader.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _zoneId The zone Id in which the spot is located.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \return True if a parking spot block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const int _zoneId,
+                        int &_lineNumber);
+
+      /// \brief Parse a parking spot from a line reader and report its
+      /// elements to a visitor, without storing them.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _zoneId The zone Id in which the spot is located.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _visitor Visitor that receives the spot elements.
+      /// \param[out] _spotId Id of the parking spot parsed.
+      /// \return True if a parking spot block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: static bool Parse(LineReader &_reader,
+                                const int _zoneId,
+                                int &_lineNumber,
+                                RNDFVisitor &_visitor,
+                                int &_spotId);
+
       /// \brief Load a parking spot from an input stream coming from a text
       /// file. The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -121,6 +169,15 @@ namespace ignition
                         const int _zoneId,
                         int &_lineNumber);
 
+      /// \brief Write the parking spot as text, in the format read by
+      /// Load().
+      /// \param[in, out] _stream Output stream.
+      /// \param[in] _zoneId Id of the zone that contains the spot.
+      /// \return True if the parking spot was written or false otherwise
+      /// (e.g.: the stream is in a bad state).
+      public: bool Save(std::ostream &_stream,
+                        const int _zoneId) const;
+
       ///////
       /// Id
       ///////
@@ -159,6 +216,18 @@ namespace ignition
       public: bool Waypoint(const int _wpId,
                             rndf::Waypoint &_wp) const;
 
+      /// \brief Get the waypoint with Id _wpId without copying it.
+      /// \param[in] _wpId The waypoint Id.
+      /// \return Pointer to the waypoint, or nullptr if not found. It is
+      /// valid until the vector of waypoints changes.
+      public: const rndf::Waypoint *Waypoint(const int _wpId) const;
+
+      /// \brief Get the waypoint with Id _wpId to edit it in place.
+      /// \param[in] _wpId The waypoint Id.
+      /// \return Pointer to the waypoint, or nullptr if not found. It is
+      /// valid until the vector of waypoints changes.
+      public: rndf::Waypoint *Waypoint(const int _wpId);
+
       /// \brief Update an existing waypoint.
       /// \param[in] _wp The updated waypoint.
       /// \return True if the waypoint was found and updated or false otherwise.
@@ -230,6 +299,13 @@ namespace ignition
       /// \return A reference to this instance.
       public: ParkingSpot &operator=(const ParkingSpot &_other);
 
+      /// \brief Move assignment operator. The content of _other is
+      /// transferred without copying it.
+      /// \param[in, out] _other The new parking spot. It receives the previous
+      /// content of this instance.
+      /// \return A reference to this instance.
+      public: ParkingSpot &operator=(ParkingSpot &&_other) noexcept;  // NOLINT
+
       /// \internal
       /// \brief Smart pointer to private data.
 #ifdef _WIN32
@@ -18,11 +18,15 @@
 #ifndef IGNITION_RNDF_PARSERUTILS_HH_
 #define IGNITION_RNDF_PARSERUTILS_HH_
 
+#include <array>
+#include <cassert>
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 #include <vector>
 
 #include "ignition/rndf/Helpers.hh"
+#include "ignition/rndf/StringView.hh"
 
 namespace ignition
 {
@@ -31,6 +35,7 @@ namespace ignition
     // Forward declarations.
     class Checkpoint;
     class Exit;
+    class LineReader;
     class UniqueId;
     enum class Marking;
 
@@ -48,22 +53,252 @@ namespace ignition
 
       /// \brief The entire line containing the exit.
       public: std::string line;
+
+      /// \brief Key of the exit Id.
+      /// \sa waypointKey()
+      public: uint64_t exitKey;
+
+      /// \brief Key of the entry Id.
+      /// \sa waypointKey()
+      public: uint64_t entryKey;
+    };
+
+    /// \brief A fixed-capacity sequence of tokens. Each token is a view of
+    /// the string that was tokenized, so the string must outlive the tokens.
+    /// Tokens beyond the capacity are counted but not stored.
+    /// \sa tokenize()
+    class Tokens
+    {
+      /// \brief Maximum number of tokens stored.
+      public: static const size_t kCapacity = 8;
+
+      /// \brief Get the number of tokens found.
+      /// \return The number of tokens, which might exceed kCapacity.
+      public: size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Access a token.
+      /// \param[in] _index Position of the token. It must be lower than
+      /// Size() and kCapacity.
+      /// \return The token.
+      public: const StringView &operator[](const size_t _index) const
+      {
+        assert(_index < this->size && _index < kCapacity);
+        return this->tokens[_index];
+      }
+
+      /// \brief Remove all the tokens.
+      public: void Clear()
+      {
+        this->size = 0;
+      }
+
+      /// \brief Append a token.
+      /// \param[in] _token The new token.
+      public: void PushBack(const StringView &_token)
+      {
+        if (this->size < kCapacity)
+          this->tokens[this->size] = _token;
+        ++this->size;
+      }
+
+      /// \brief The tokens stored.
+      private: std::array<StringView, kCapacity> tokens;
+
+      /// \brief Number of tokens found.
+      private: size_t size = 0;
     };
 
+    /// \brief Redirects the errors reported by the RNDF elements in the
+    /// current thread to another stream while it exists. The errors of
+    /// blocks parsed in parallel are buffered this way, so they can be
+    /// reported in the order of a serial load.
+    class IGNITION_RNDF_VISIBLE ErrorCapture
+    {
+      /// \brief Constructor.
+      /// \param[in] _stream Stream that receives the errors.
+      public: explicit ErrorCapture(std::ostream &_stream);
+
+      /// \brief Destructor. The stream used before is restored.
+      public: ~ErrorCapture();
+
+      /// \brief Not copyable.
+      public: ErrorCapture(const ErrorCapture &) = delete;
+
+      /// \brief Not copyable.
+      public: ErrorCapture &operator=(const ErrorCapture &) = delete;
+
+      /// \brief The stream used before.
+      private: std::ostream *previous;
+    };
+
+    /// \brief Get the stream where the RNDF elements report errors.
+    /// \return The stream of the innermost ErrorCapture of the current
+    /// thread, or std::cerr if there is none.
+    IGNITION_RNDF_VISIBLE
+    std::ostream &errorStream();
+
     /// \brief Remove comments, consecutive whitespaces (leaving onle one) and
     /// leading and trailing whitespaces.
     /// \param[in] _str Input string.
     IGNITION_RNDF_VISIBLE
     void trimWhitespaces(std::string &_str);
 
+    /// \brief Get a version of a string without comments, consecutive
+    /// whitespaces or leading and trailing whitespaces, as described in
+    /// trimWhitespaces(std::string &). Strings that are already trimmed aren't
+    /// copied.
+    /// \param[in] _str Input string.
+    /// \param[in, out] _buffer Storage used when _str needs to be modified.
+    /// \return The trimmed string. It references either _str or _buffer.
+    IGNITION_RNDF_VISIBLE
+    StringView trimWhitespaces(const StringView &_str,
+                               std::string &_buffer);
+
+    /// \brief Splits a string into tokens without allocating memory.
+    /// A token is a maximal sequence of characters not contained in _delim,
+    /// so empty tokens are never produced.
+    /// \param[in] _str Input string.
+    /// \param[in] _delim Set of delimiter characters.
+    /// \param[out] _tokens The tokens found.
+    /// \return The number of tokens found.
+    IGNITION_RNDF_VISIBLE
+    size_t tokenize(const StringView &_str,
+                    const StringView &_delim,
+                    Tokens &_tokens);
+
     /// \brief Splits a string into tokens.
     /// \param[in] _str Input string.
     /// \param[in] _delim Token delimiter.
     /// \return Vector of tokens.
+    /// \sa tokenize()
     IGNITION_RNDF_VISIBLE
     std::vector<std::string> split(const std::string &_str,
                                    const std::string &_delim);
 
+    /// \brief Converts a string into an integer. The whole string must be a
+    /// base 10 number with an optional sign. Unlike std::stoi(), this
+    /// function doesn't depend on the locale, doesn't allocate memory and
+    /// doesn't throw exceptions.
+    /// \param[in] _str Input string.
+    /// \param[out] _value The number parsed. It's only modified on success.
+    /// \return True if _str is a valid number in the range of an int or false
+    /// otherwise.
+    IGNITION_RNDF_VISIBLE
+    bool parseInt(const StringView &_str,
+                  int &_value);
+
+    /// \brief Converts the beginning of a string into an integer, as
+    /// std::stoi() does: leading whitespaces are skipped and the number ends
+    /// at the first character that isn't a digit. Unlike std::stoi(), this
+    /// function doesn't depend on the locale, doesn't allocate memory and
+    /// doesn't throw exceptions.
+    /// \param[in] _str Input string.
+    /// \param[out] _value The number parsed. It's only modified on success.
+    /// \param[out] _size Number of characters used. It's only modified on
+    /// success.
+    /// \return True if _str starts with a valid number in the range of an int
+    /// or false otherwise.
+    IGNITION_RNDF_VISIBLE
+    bool parseInt(const StringView &_str,
+                  int &_value,
+                  size_t &_size);
+
+    /// \brief Converts a string into a double. The whole string must be a
+    /// decimal number with an optional sign, fractional part and exponent
+    /// (e.g.: "-117.365607" or "1.5e3"). The result is correctly rounded.
+    /// Unlike std::stod(), this function doesn't depend on the locale and
+    /// doesn't throw exceptions.
+    /// \param[in] _str Input string.
+    /// \param[out] _value The number parsed. It's only modified on success.
+    /// \return True if _str is a valid number or false otherwise.
+    IGNITION_RNDF_VISIBLE
+    bool parseDouble(const StringView &_str,
+                     double &_value);
+
+    /// \brief Converts the beginning of a string into a double, as
+    /// std::stod() does: leading whitespaces are skipped and the number ends
+    /// at the first character that can't continue it (e.g.: "38.86.300" is
+    /// 38.86). Infinities, NaNs and hexadecimal numbers are accepted, and
+    /// numbers that overflow or underflow a double are rejected. Decimal
+    /// numbers are correctly rounded and, unlike std::stod(), don't depend
+    /// on the locale. This function doesn't throw exceptions.
+    /// \param[in] _str Input string.
+    /// \param[out] _value The number parsed. It's only modified on success.
+    /// \param[out] _size Number of characters used. It's only modified on
+    /// success.
+    /// \return True if _str starts with a valid number or false otherwise.
+    IGNITION_RNDF_VISIBLE
+    bool parseDouble(const StringView &_str,
+                     double &_value,
+                     size_t &_size);
+
+    /// \brief Pack the three elements of a waypoint Id (x.y.z) into an
+    /// integer, so ids can be compared and hashed without building strings.
+    /// Each element is stored in its own bit field (x in the upper 32 bits,
+    /// y and z in 16 bits each), so two ids have the same key only if they
+    /// are equal, as long as y and z don't exceed 65535. The parser limits
+    /// all the elements to 32768.
+    /// \param[in] _x The "x" element (segment or zone Id).
+    /// \param[in] _y The "y" element (lane Id or 0 for perimeters).
+    /// \param[in] _z The "z" element (waypoint Id).
+    /// \return The key.
+    IGNITION_RNDF_VISIBLE
+    uint64_t waypointKey(const int _x,
+                         const int _y,
+                         const int _z);
+
+    /// \brief Find an element by Id. The specification numbers the segments,
+    /// zones, lanes, spots and waypoints consecutively from 1, so the element
+    /// at position _id - 1 is checked first. The elements are only scanned
+    /// when the Ids are not consecutive.
+    /// \param[in] _items The elements.
+    /// \param[in] _id The Id.
+    /// \return Pointer to the element, or nullptr if not found.
+    template<typename T>
+    const T *findById(const std::vector<T> &_items, const int _id)
+    {
+      const size_t position = static_cast<size_t>(_id) - 1;
+      if (_id > 0 && position < _items.size() &&
+          _items[position].Id() == _id)
+      {
+        return &_items[position];
+      }
+      for (auto const &item : _items)
+      {
+        if (item.Id() == _id)
+          return &item;
+      }
+      return nullptr;
+    }
+
+    /// \brief Find a mutable element by Id.
+    /// \param[in] _items The elements.
+    /// \param[in] _id The Id.
+    /// \return Pointer to the element, or nullptr if not found.
+    /// \sa findById(const std::vector<T> &, const int)
+    template<typename T>
+    T *findById(std::vector<T> &_items, const int _id)
+    {
+      return const_cast<T *>(
+        findById(static_cast<const std::vector<T> &>(_items), _id));
+    }
+
+    /// \brief Consumes lines from a line reader.
+    /// The function reads line by line until it finds a line containing
+    /// parsable content or EoF. Blank lines or lines with just a comment aren't
+    /// considered parsable lines, so they will be consumed by this function.
+    /// \param[in, out] _reader Line reader.
+    /// \param[out] _line First line found with parsable content. The view is
+    /// valid until the next read operation on _reader.
+    /// \param[in, out] _lineNumber Line number pointed by the reader.
+    IGNITION_RNDF_VISIBLE
+    void nextRealLine(LineReader &_reader,
+                      StringView &_line,
+                      int &_lineNumber);
+
     /// \brief Consumes lines from an input stream coming from a text file.
     /// The function reads line by line until it finds a line containing
     /// parsable content or EoF. Blank lines or lines with just a comment aren't
@@ -77,6 +312,26 @@ namespace ignition
                       std::string &_line,
                       int &_lineNumber);
 
+    /// \brief Checks if the next parsable line from a line reader matches
+    /// the following expression:
+    /// "<DELIMITER> <STRING> [<COMMENT>]".
+    /// <DELIMITER> is a string such as "RNDF_name".
+    /// <STRING> is a sequence of characters with a maximum length of 128, and
+    /// do not contain any spaces, backslashes or '*'.
+    /// <COMMENT> is an optional element delimited by "/*" and "*/" and is
+    /// always placed at the end of the line.
+    /// \param[in, out] _reader Line reader.
+    /// \param[in] _delimiter The <DELIMITER>.
+    /// \param[out] _value The parsed <STRING>.
+    /// \param[in, out] _lineNumber Line number pointed by the reader.
+    /// \return True if the next parsable line matched the expression or false
+    /// otherwise.
+    IGNITION_RNDF_VISIBLE
+    bool parseString(LineReader &_reader,
+                     const std::string &_delimiter,
+                     std::string &_value,
+                     int &_lineNumber);
+
     /// \brief Checks if the next parsable line from an input stream coming from
     /// a text file matches the following expression:
     /// "<DELIMITER> <STRING> [<COMMENT>]".
@@ -98,6 +353,22 @@ namespace ignition
                      std::string &_value,
                      int &_lineNumber);
 
+    /// \brief Checks if the next parsable line from a line reader matches
+    /// the following expression:
+    /// "<DELIMITER> [<COMMENT>]".
+    /// <DELIMITER> is a string such as "RNDF_name".
+    /// <COMMENT> is an optional element delimited by "/*" and "*/" and is
+    /// always placed at the end of the line.
+    /// \param[in, out] _reader Line reader.
+    /// \param[in] _delimiter The <DELIMITER>.
+    /// \param[in, out] _lineNumber Line number pointed by the reader.
+    /// \return True if the next parsable line matched the expression or false
+    /// otherwise.
+    IGNITION_RNDF_VISIBLE
+    bool parseDelimiter(LineReader &_reader,
+                        const std::string &_delimiter,
+                        int &_lineNumber);
+
     /// \brief Checks if the next parsable line from an input stream coming from
     /// a text file matches the following expression:
     /// "<DELIMITER> [<COMMENT>]".
@@ -115,6 +386,25 @@ namespace ignition
                         const std::string &_delimiter,
                         int &_lineNumber);
 
+    /// \brief Checks if the next parsable line from a line reader matches
+    /// the following expression:
+    /// "<DELIMITER> <POSITIVE> [<COMMENT>]".
+    /// <DELIMITER> is a string such as "RNDF_name".
+    /// <POSITIVE> is an integer value between [1, 32768].
+    /// <COMMENT> is an optional element delimited by "/*" and "*/" and is
+    /// always placed at the end of the line.
+    /// \param[in, out] _reader Line reader.
+    /// \param[in] _delimiter The <DELIMITER>.
+    /// \param[out] _value The parsed <POSITIVE>.
+    /// \param[in, out] _lineNumber Line number pointed by the reader.
+    /// \return True if the next parsable line matched the expression or false
+    /// otherwise.
+    IGNITION_RNDF_VISIBLE
+    bool parsePositive(LineReader &_reader,
+                       const std::string &_delimiter,
+                       int &_value,
+                       int &_lineNumber);
+
     /// \brief Checks if the next parsable line from an input stream coming from
     /// a text file matches the following expression:
     /// "<DELIMITER> <POSITIVE> [<COMMENT>]".
@@ -135,6 +425,25 @@ namespace ignition
                        int &_value,
                        int &_lineNumber);
 
+    /// \brief Checks if the next parsable line from a line reader matches
+    /// the following expression:
+    /// "<DELIMITER> <NON_NEGATIVE> [<COMMENT>]".
+    /// <DELIMITER> is a string such as "RNDF_name".
+    /// <NON_NEGATIVE> is an integer value between [0, 32768].
+    /// <COMMENT> is an optional element delimited by "/*" and "*/" and is
+    /// always placed at the end of the line.
+    /// \param[in, out] _reader Line reader.
+    /// \param[in] _delimiter The <DELIMITER>.
+    /// \param[out] _value The parsed <NON_NEGATIVE>.
+    /// \param[in, out] _lineNumber Line number pointed by the reader.
+    /// \return True if the next parsable line matched the expression or false
+    /// otherwise.
+    IGNITION_RNDF_VISIBLE
+    bool parseNonNegative(LineReader &_reader,
+                         const std::string &_delimiter,
+                         int &_value,
+                         int &_lineNumber);
+
     /// \brief Checks if the next parsable line from an input stream coming from
     /// a text file matches the following expression:
     /// "<DELIMITER> <NON_NEGATIVE> [<COMMENT>]".
@@ -167,7 +476,7 @@ namespace ignition
     /// \return True if the input string matched the expression or false
     /// otherwise.
     IGNITION_RNDF_VISIBLE
-    bool parseNonNegative(const std::string &_input,
+    bool parseNonNegative(const StringView &_input,
                           const std::string &_delimiter,
                           int &_value);
 
@@ -183,7 +492,7 @@ namespace ignition
     /// \return True if the input string matched the expression or false
     /// otherwise.
     IGNITION_RNDF_VISIBLE
-    bool parsePositive(const std::string &_input,
+    bool parsePositive(const StringView &_input,
                        const std::string &_delimiter,
                        int &_value);
 
@@ -199,7 +508,7 @@ namespace ignition
     /// \return True if the input string matched the expression or false
     /// otherwise.
     IGNITION_RNDF_VISIBLE
-    bool parseBoundary(const std::string &_input,
+    bool parseBoundary(const StringView &_input,
                        Marking &_boundary);
 
     /// \brief Checks if a string matches the following expression:
@@ -217,7 +526,7 @@ namespace ignition
     /// \return True if the input string matched the expression or false
     /// otherwise.
     IGNITION_RNDF_VISIBLE
-    bool parseCheckpoint(const std::string &_input,
+    bool parseCheckpoint(const StringView &_input,
                          const int _segmentId,
                          const int _laneId,
                          Checkpoint &_checkpoint);
@@ -235,7 +544,7 @@ namespace ignition
     /// \return True if the input string matched the expression or false
     /// otherwise.
     IGNITION_RNDF_VISIBLE
-    bool parseStop(const std::string &_input,
+    bool parseStop(const StringView &_input,
                    const int _segmentId,
                    const int _laneId,
                    UniqueId &_stop);
@@ -257,7 +566,7 @@ namespace ignition
     /// \return True if the input string matched the expression or false
     /// otherwise.
     IGNITION_RNDF_VISIBLE
-    bool parseExit(const std::string &_input,
+    bool parseExit(const StringView &_input,
                    const int _segmentId,
                    const int _laneId,
                    Exit &_exit);
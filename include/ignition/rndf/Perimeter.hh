@@ -18,6 +18,7 @@
 #ifndef IGNITION_RNDF_PERIMETER_HH_
 #define IGNITION_RNDF_PERIMETER_HH_
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -31,8 +32,10 @@ namespace ignition
   {
     // Forward declarations.
     class Exit;
+    class LineReader;
     class PerimeterHeaderPrivate;
     class PerimeterPrivate;
+    class RNDFVisitor;
     class Waypoint;
     struct ExitCacheEntry;
 
@@ -50,6 +53,21 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a perimeter header from a line reader. The expected
+      /// format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _zoneId The zone Id in which the spot is located.
+      /// \param[in] _perimeterId The perimeter Id.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _visitor Visitor that receives the exits parsed.
+      /// \return True if a perimeter header block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const int _zoneId,
+                        const int _perimeterId,
+                        int &_lineNumber,
+                        RNDFVisitor &_visitor);
+
       /// \brief Load a perimeter header from an input stream coming from a
       /// text file. The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -109,6 +127,12 @@ namespace ignition
       /// \sa Valid.
       public: Perimeter(const Perimeter &_other);
 
+      /// \brief Move constructor. The content of _other is transferred
+      /// without copying it.
+      /// \param[in, out] _other Other perimeter. It can only be destroyed or
+      /// assigned to after the move.
+      public: Perimeter(Perimeter &&_other) noexcept;  // NOLINT
+
       /// \brief Destructor.
       public: virtual ~Perimeter();
 
@@ -116,8 +140,55 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a perimeter from a line reader.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _zoneId The zone Id in which the perimeter is located.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Keys of the waypoints parsed.
+      /// \return True if a perimeter block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const int _zoneId,
+                        int &_lineNumber,
+                        std::vector<ExitCacheEntry> &_exitCache,
+                        std::vector<uint64_t> &_waypointCache);
+
+      /// \brief Parse a perimeter from a line reader and report its
+      /// elements to a visitor, without storing them.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _zoneId The zone Id in which the perimeter is located.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _visitor Visitor that receives the perimeter
+      /// elements.
+      /// \return True if a perimeter block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: static bool Parse(LineReader &_reader,
+                                const int _zoneId,
+                                int &_lineNumber,
+                                RNDFVisitor &_visitor);
+
+      /// \brief Load a perimeter from an input stream coming from a text file.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _rndfFile Input file stream.
+      /// \param[in] _zoneId The zone Id in which the perimeter is located.
+      /// \param[in, out] _lineNumber Line number pointed by the stream position
+      /// indicator.
+      /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Keys of the waypoints parsed.
+      /// \return True if a perimeter block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(std::ifstream &_rndfFile,
+                        const int _zoneId,
+                        int &_lineNumber,
+                        std::vector<ExitCacheEntry> &_exitCache,
+                        std::vector<uint64_t> &_waypointCache);
+
       /// \brief Load a perimeter from an input stream coming from a text file.
       /// The expected format is the one specified on the RNDF spec.
+      /// \deprecated Use the overload that caches the waypoint keys.
       /// \param[in, out] _rndfFile Input file stream.
       /// \param[in] _zoneId The zone Id in which the perimeter is located.
       /// \param[in, out] _lineNumber Line number pointed by the stream position
@@ -132,6 +203,14 @@ namespace ignition
                         std::vector<ExitCacheEntry> &_exitCache,
                         std::vector<std::string> &_waypointCache);
 
+      /// \brief Write the perimeter as text, in the format read by Load().
+      /// \param[in, out] _stream Output stream.
+      /// \param[in] _zoneId Id of the zone that contains the perimeter.
+      /// \return True if the perimeter was written or false otherwise
+      /// (e.g.: the stream is in a bad state).
+      public: bool Save(std::ostream &_stream,
+                        const int _zoneId) const;
+
       ////////////////////
       /// Perimeter points
       ////////////////////
@@ -155,6 +234,18 @@ namespace ignition
       public: bool Point(const int _wpId,
                          rndf::Waypoint &_wp) const;
 
+      /// \brief Get the point with Id _wpId without copying it.
+      /// \param[in] _wpId The point Id.
+      /// \return Pointer to the point, or nullptr if not found. It is
+      /// valid until the vector of points changes.
+      public: const rndf::Waypoint *Point(const int _wpId) const;
+
+      /// \brief Get the point with Id _wpId to edit it in place.
+      /// \param[in] _wpId The point Id.
+      /// \return Pointer to the point, or nullptr if not found. It is
+      /// valid until the vector of points changes.
+      public: rndf::Waypoint *Point(const int _wpId);
+
       /// \brief Update an existing point.
       /// \param[in] _wp The updated waypoint.
       /// \return True if the point was found and updated or false otherwise.
@@ -228,6 +319,13 @@ namespace ignition
       /// \return A reference to this instance.
       public: Perimeter &operator=(const Perimeter &_other);
 
+      /// \brief Move assignment operator. The content of _other is
+      /// transferred without copying it.
+      /// \param[in, out] _other The new perimeter. It receives the previous
+      /// content of this instance.
+      /// \return A reference to this instance.
+      public: Perimeter &operator=(Perimeter &&_other) noexcept;  // NOLINT
+
       /// \internal
       /// \brief Smart pointer to private data.
 #ifdef _WIN32
@@ -18,6 +18,7 @@
 #ifndef IGNITION_RNDF_RNDF_HH_
 #define IGNITION_RNDF_RNDF_HH_
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -30,10 +31,19 @@ namespace ignition
   namespace rndf
   {
     // Forward declarations.
+    class Arena;
+    class CoordinateSnapshot;
+    class Lane;
+    class LaneIndex;
+    class LineReader;
+    class LocalCoordinates;
     class RNDFHeaderPrivate;
     class RNDFNode;
     class RNDFPrivate;
+    class RNDFVisitor;
+    class RoadGraph;
     class Segment;
+    class SpatialIndex;
     class UniqueId;
     class Zone;
 
@@ -51,6 +61,15 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a RNDF header from a line reader. The expected format
+      /// is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \return True if a RNDF header block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        int &_lineNumber);
+
       /// \brief Load a RNDF header from an input stream coming from a
       /// text file. The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -92,6 +111,14 @@ namespace ignition
     /// \brief An abstraction to represent a Route Network Definition File
     /// (RNDF). Please, refer to the specification for more details.
     /// \reference http://www.grandchallenge.org/grandchallenge/docs/RNDF_MDF_Formats_031407.pdf
+    ///
+    /// Threading: the const member functions can be called from several
+    /// threads at once, as long as no non-const member function runs at the
+    /// same time and the segments and zones aren't being edited in place.
+    /// The non-const member functions, including MarkModified(), need
+    /// exclusive access. The derived structures, like Coordinates() or
+    /// RoadGraph(), are updated by the first thread that requests them after
+    /// a modification while the others wait.
     class IGNITION_RNDF_VISIBLE RNDF
     {
       /// \brief Default constructor.
@@ -101,6 +128,19 @@ namespace ignition
       /// \param[in] _filepath Path to an existing RNDF file.
       public: explicit RNDF(const std::string &_filepath);
 
+      /// \brief Move constructor. The content of _other is transferred
+      /// without copying it.
+      /// \param[in, out] _other Other RNDF. It can only be destroyed or
+      /// assigned to after the move.
+      public: RNDF(RNDF &&_other) noexcept;  // NOLINT
+
+      /// \brief Move assignment operator. The content of _other is
+      /// transferred without copying it.
+      /// \param[in, out] _other The new RNDF. It receives the previous
+      /// content of this instance.
+      /// \return A reference to this instance.
+      public: RNDF &operator=(RNDF &&_other) noexcept;  // NOLINT
+
       /// \brief Destructor.
       public: virtual ~RNDF();
 
@@ -108,13 +148,130 @@ namespace ignition
       /// Parsing
       ///////////
 
-      /// \brief Load a RNDF from an input stream coming from a text file.
-      /// The expected format is the one specified on the RNDF spec.
+      /// \brief Load a RNDF from a text file. The file is memory-mapped and
+      /// parsed in place. The expected format is the one specified on the
+      /// RNDF spec.
       /// \param[in, out] _filePath Path to RNDF file.
       /// \return True if the entire RNDF was correctly parsed or false
       /// otherwise (e.g.: EoF or incorrect format found).
       public: bool Load(const std::string &_filePath);
 
+      /// \brief Load a RNDF from a text file, parsing its segments and
+      /// zones in parallel.
+      /// \param[in] _filePath Path to RNDF file.
+      /// \param[in] _numThreads Number of threads used for parsing the
+      /// segments and zones, or 0 to use one per hardware thread.
+      /// \return True if the entire RNDF was correctly parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      /// \sa Load(LineReader &, const unsigned int)
+      public: bool Load(const std::string &_filePath,
+                        const unsigned int _numThreads);
+
+      /// \brief Load a RNDF from a text file using a binary cache. If the
+      /// cache file exists and was created from a file with the same
+      /// content, the RNDF is read from it without parsing any text.
+      /// Otherwise the text file is parsed and the cache is (re)written.
+      /// \param[in] _filePath Path to RNDF file.
+      /// \param[in] _cachePath Path to the cache file.
+      /// \return True if the entire RNDF was correctly loaded or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(const std::string &_filePath,
+                        const std::string &_cachePath);
+
+      /// \brief Load a RNDF from an input stream. The stream is read
+      /// sequentially and never rewound, so non-seekable streams such as
+      /// pipes or decompression filters are supported.
+      /// \param[in, out] _stream Input stream with the RNDF content.
+      /// \return True if the entire RNDF was correctly parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(std::istream &_stream);
+
+      /// \brief Load a RNDF from a line reader. The expected format is the
+      /// one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \return True if the entire RNDF was correctly parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader);
+
+      /// \brief Load a RNDF from a line reader, parsing its segments and
+      /// zones in parallel. A first pass over the content finds where each
+      /// segment and zone block ends. Then the blocks are parsed by a pool
+      /// of threads and the exits of all of them are validated at the end.
+      /// The result is identical to the one of Load(LineReader &). Readers
+      /// working on a stream, a single thread or content that can't be split
+      /// in blocks are parsed serially. When several blocks contain errors,
+      /// only the errors of the first one in file order are reported, as
+      /// when loading serially.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _numThreads Number of threads used for parsing the
+      /// segments and zones, or 0 to use one per hardware thread.
+      /// \return True if the entire RNDF was correctly parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const unsigned int _numThreads);
+
+      /// \brief Set whether the segments, lanes, zones, parking spots,
+      /// perimeters, checkpoints and nodes loaded from now on are allocated
+      /// in an arena owned by this RNDF. Loading and destroying a large RNDF
+      /// then takes a few large allocations instead of several per element.
+      /// Every load creates a new arena, and the previous one is released
+      /// with the elements it contains. The elements added or updated after
+      /// loading, and the vectors and strings of all of them, use the heap.
+      /// \param[in] _enabled True to use an arena.
+      /// \sa Arena
+      public: void SetArenaEnabled(const bool _enabled);
+
+      /// \brief Get whether the elements loaded are allocated in an arena.
+      /// \return True if an arena is used.
+      /// \sa SetArenaEnabled()
+      public: bool ArenaEnabled() const;
+
+      /// \brief Get the arena of the last load.
+      /// \return The arena, or nullptr if the last load didn't use one.
+      public: const rndf::Arena *Arena() const;
+
+      /// \brief Parse a RNDF text file and report its elements to a visitor
+      /// in the order they appear, without storing them. The memory used
+      /// doesn't depend on the size of the file.
+      /// \param[in] _filePath Path to RNDF file.
+      /// \param[in, out] _visitor Visitor that receives the RNDF elements.
+      /// \return True if the entire RNDF was correctly parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      /// \sa Parse(LineReader &, RNDFVisitor &)
+      public: static bool Parse(const std::string &_filePath,
+                                RNDFVisitor &_visitor);
+
+      /// \brief Parse a RNDF from a line reader and report its elements to
+      /// a visitor in the order they appear, without storing them. The
+      /// grammar is the same one used by Load(), which builds its objects
+      /// from these elements. Unlike Load(), the exits aren't checked
+      /// against the waypoints, as that requires knowing all of them. If an
+      /// error is found, the elements already reported are not undone.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _visitor Visitor that receives the RNDF elements.
+      /// \return True if the entire RNDF was correctly parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: static bool Parse(LineReader &_reader,
+                                RNDFVisitor &_visitor);
+
+      /// \brief Write the RNDF to a text file, in the format read by
+      /// Load().
+      /// \param[in] _filePath Path to the RNDF file.
+      /// \return True if the file was written or false otherwise
+      /// (e.g.: the file can't be created).
+      /// \sa Save(std::ostream &)
+      public: bool Save(const std::string &_filePath) const;
+
+      /// \brief Write the RNDF as text to an output stream, in the format
+      /// read by Load(). Loading the text back produces the same RNDF,
+      /// except for lane and spot widths, which the format stores in whole
+      /// feet. Coordinates are written with the fewest digits that read
+      /// back as the same value.
+      /// \param[in, out] _stream Output stream.
+      /// \return True if the RNDF was written or false otherwise
+      /// (e.g.: the stream is in a bad state).
+      public: bool Save(std::ostream &_stream) const;
+
       ////////
       /// Name
       ////////
@@ -135,7 +292,11 @@ namespace ignition
       /// \return The number of segments in this RNDF.
       public: size_t NumSegments() const;
 
-      /// \brief Get a mutable reference to the vector of segments.
+      /// \brief Get a mutable reference to the vector of segments. Getting
+      /// it doesn't modify anything: call MarkModified() once the edits are
+      /// done, so Info(), Changes() and the derived structures see them.
+      /// Prefer AddSegment(), RemoveSegment(), UpdateSegment() and
+      /// UpdateLane(), which record their changes themselves.
       /// \return A mutable reference to the vector of segments.
       public: std::vector<rndf::Segment> &Segments();
 
@@ -150,6 +311,20 @@ namespace ignition
       public: bool Segment(const int _segmentId,
                            rndf::Segment &_segment) const;
 
+      /// \brief Get the segment with Id _segmentId without copying it.
+      /// \param[in] _segmentId The segment Id.
+      /// \return Pointer to the segment, or nullptr if not found. It is
+      /// valid until the vector of segments changes.
+      public: const rndf::Segment *Segment(const int _segmentId) const;
+
+      /// \brief Get the segment with Id _segmentId to edit it in place.
+      /// Getting it doesn't modify anything: call MarkModified(_segmentId)
+      /// once the edits are done, as with Segments().
+      /// \param[in] _segmentId The segment Id.
+      /// \return Pointer to the segment, or nullptr if not found. It is
+      /// valid until the vector of segments changes.
+      public: rndf::Segment *Segment(const int _segmentId);
+
       /// \brief Update an existing segment.
       /// \param[in] _segment The updated segment.
       /// \return True if the segment was found and updated or false otherwise.
@@ -169,6 +344,13 @@ namespace ignition
       /// or invalid).
       public: bool RemoveSegment(const int _segmentId);
 
+      /// \brief Update an existing lane of a segment. Only the unique Ids of
+      /// the lane are reindexed.
+      /// \param[in] _segmentId Id of the segment containing the lane.
+      /// \param[in] _lane The updated lane.
+      /// \return True if the lane was found and updated or false otherwise.
+      public: bool UpdateLane(const int _segmentId, const rndf::Lane &_lane);
+
       /////////
       /// Zones
       /////////
@@ -177,7 +359,11 @@ namespace ignition
       /// \return The number of zones in this RNDF.
       public: size_t NumZones() const;
 
-      /// \brief Get a mutable reference to the vector of zones.
+      /// \brief Get a mutable reference to the vector of zones. Getting it
+      /// doesn't modify anything: call MarkModified() once the edits are
+      /// done, so Info(), Changes() and the derived structures see them.
+      /// Prefer AddZone(), RemoveZone() and UpdateZone(), which record their
+      /// changes themselves.
       /// \return A mutable reference to the vector of zones.
       public: std::vector<rndf::Zone> &Zones();
 
@@ -192,6 +378,20 @@ namespace ignition
       public: bool Zone(const int _zoneId,
                         rndf::Zone &_zone) const;
 
+      /// \brief Get the zone with Id _zoneId without copying it.
+      /// \param[in] _zoneId The zone Id.
+      /// \return Pointer to the zone, or nullptr if not found. It is
+      /// valid until the vector of zones changes.
+      public: const rndf::Zone *Zone(const int _zoneId) const;
+
+      /// \brief Get the zone with Id _zoneId to edit it in place. Getting
+      /// it doesn't modify anything: call MarkModified(_zoneId) once the
+      /// edits are done, as with Zones().
+      /// \param[in] _zoneId The zone Id.
+      /// \return Pointer to the zone, or nullptr if not found. It is
+      /// valid until the vector of zones changes.
+      public: rndf::Zone *Zone(const int _zoneId);
+
       /// \brief Update an existing zone.
       /// \param[in] _zone The updated zone.
       /// \return True if the zone was found and updated or false otherwise.
@@ -249,10 +449,114 @@ namespace ignition
 
       /// \brief Get a pointer to the associated RNDF node given a unique Id.
       /// The RNDFNode object contains the metadata associated to the id.
+      /// The node finds its segment, lane, zone and waypoint by Id when they
+      /// are requested, so the pointer to the node remains valid across
+      /// modifications of the RNDF as long as the unique Id exists. The
+      /// pointers returned by the node are valid until the next
+      /// modification. The unique Ids are indexed by the modifications
+      /// themselves, so this function only reads.
       /// \param[in] _id The Unique Id to check.
       /// \return A pointer to the RNDFnode.
       public: RNDFNode *Info(const rndf::UniqueId &_id) const;
 
+      /// \brief Get the revision of the segments and zones. It's incremented
+      /// by every modification made through a member function of this class,
+      /// including the edits in place recorded with MarkModified().
+      /// \return The revision.
+      public: uint64_t Revision() const;
+
+      /// \brief Get the segments and zones modified since a revision, so
+      /// the structures derived from the RNDF can be updated partially.
+      /// \param[in] _revision A revision returned by Revision().
+      /// \param[out] _ids Sorted Ids, without duplicates, of the segments and
+      /// zones added, removed or updated since _revision.
+      /// \param[out] _sameLayout True if the modifications kept the layout
+      /// of the waypoints: the segments, lanes, zones, parking spots,
+      /// waypoints and exits are the same and only their other properties,
+      /// like the locations, changed.
+      /// \return True if the modifications are known. False if any segment
+      /// or zone may have changed, because MarkModified() was called
+      /// without an Id or too many modifications ago, so everything derived
+      /// from the RNDF has to be rebuilt.
+      public: bool Changes(const uint64_t _revision,
+                           std::vector<int> &_ids,
+                           bool &_sameLayout) const;
+
+      /// \brief Record that a segment or zone was edited in place, through
+      /// Segments(), Zones(), Segment() or Zone(), or added or removed
+      /// through the first two. The change is reported by Changes() as one
+      /// that may alter the layout of the waypoints.
+      /// \param[in] _id Id of the segment or zone.
+      public: void MarkModified(const int _id);
+
+      /// \brief Record that any segment or zone may have been edited in
+      /// place, added or removed. Everything derived from the RNDF is
+      /// rebuilt.
+      public: void MarkModified();
+
+      /// \brief Get a structure-of-arrays copy of the coordinates of all the
+      /// waypoints. The snapshot is built on the first call and reused until
+      /// the segments or zones are changed through a member function of this
+      /// class, including the edits in place recorded with MarkModified().
+      /// If the modifications kept the layout of the waypoints, only the
+      /// coordinates of the segments and zones modified are copied.
+      /// \return The coordinate snapshot.
+      public: const CoordinateSnapshot &Coordinates() const;
+
+      /// \brief Get a spatial index of all the waypoints, for nearest
+      /// waypoint and radius queries. The index is built from Coordinates()
+      /// on the first call. After modifications that kept the layout of the
+      /// waypoints, only the waypoints of the segments and zones modified
+      /// are updated; otherwise the index is rebuilt.
+      /// The nodes of the Ids returned by the queries can be retrieved with
+      /// Info().
+      /// \return The spatial index.
+      public: const rndf::SpatialIndex &SpatialIndex() const;
+
+      /// \brief Get a bounding volume hierarchy over the centerlines of the
+      /// lanes, for projecting locations on the closest lane. The index is
+      /// built on the first call and rebuilt after any modification.
+      /// \return The lane index.
+      public: const rndf::LaneIndex &LaneIndex() const;
+
+      /// \brief Get the directed graph of the road network, for routing
+      /// between waypoints. The graph is built on the first call. After
+      /// modifications that kept the layout of the waypoints, only the
+      /// locations and edge lengths of the waypoints of the segments and
+      /// zones modified are updated; otherwise the graph is rebuilt.
+      /// \return The road graph.
+      public: const rndf::RoadGraph &RoadGraph() const;
+
+      /// \brief Set the origin of the frame of LocalCoordinates().
+      /// \param[in] _latitude Latitude of the origin in degrees.
+      /// \param[in] _longitude Longitude of the origin in degrees.
+      /// \sa ClearOrigin()
+      public: void SetOrigin(const double _latitude,
+                             const double _longitude);
+
+      /// \brief Place the origin of the frame of LocalCoordinates() at the
+      /// centroid of the waypoints again, which is the default.
+      /// \sa SetOrigin()
+      public: void ClearOrigin();
+
+      /// \brief Get whether the origin of the frame of LocalCoordinates()
+      /// was set with SetOrigin().
+      /// \return True if the origin was set, false if it's the centroid of
+      /// the waypoints.
+      public: bool HasOrigin() const;
+
+      /// \brief Get the coordinates in meters of all the waypoints in a
+      /// local east-north-up frame, in the order of Coordinates(), for
+      /// metric geometry without trigonometry. The origin of the frame is
+      /// the one set with SetOrigin(), or else the centroid of the
+      /// waypoints. The coordinates are computed on the first call. After
+      /// modifications that kept the layout of the waypoints, only the
+      /// waypoints of the segments and zones modified are projected again
+      /// and a centroid origin stays where it was; otherwise all of them
+      /// are projected.
+      /// \return The local coordinates.
+      public: const rndf::LocalCoordinates &LocalCoordinates() const;
+
       /// \brief Populates the "cache" member variable linking all unique Ids
       /// with their metadata (RNDFNode).
       private: void UpdateCache();
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_RNDFBUILDER_HH_
+#define IGNITION_RNDF_RNDFBUILDER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class RNDFBuilderPrivate;
+    class Segment;
+    class Zone;
+    struct ExitCacheEntry;
+
+    /// \internal
+    /// \brief A visitor that builds the segments and zones reported by the
+    /// parser. This is how the Load() functions create their objects.
+    /// Every lane is added to the last segment reported and every perimeter
+    /// and parking spot to the last zone.
+    class RNDFBuilder : public RNDFVisitor
+    {
+      /// \brief Constructor.
+      /// \param[in, out] _exitCache Cache where the exits parsed are added.
+      /// \param[in, out] _waypointCache Cache where the keys of the lane
+      /// waypoints and perimeter points parsed are added.
+      public: RNDFBuilder(std::vector<ExitCacheEntry> &_exitCache,
+                          std::vector<uint64_t> &_waypointCache);
+
+      /// \brief Destructor.
+      public: virtual ~RNDFBuilder();
+
+      /// \brief Get a mutable reference to the segments built.
+      /// \return A mutable reference to the segments.
+      public: std::vector<Segment> &Segments();
+
+      /// \brief Get a mutable reference to the zones built.
+      /// \return A mutable reference to the zones.
+      public: std::vector<Zone> &Zones();
+
+      // Documentation inherited.
+      public: virtual void OnSegment(const int _segmentId,
+                                     const int _numLanes,
+                                     const std::string &_name);
+
+      // Documentation inherited.
+      public: virtual void OnLane(const int _segmentId,
+                                  const int _laneId,
+                                  const int _numWaypoints);
+
+      // Documentation inherited.
+      public: virtual void OnLaneHeader(const int _segmentId,
+                                        const int _laneId,
+                                        const double _width,
+                                        const Marking _leftBoundary,
+                                        const Marking _rightBoundary);
+
+      // Documentation inherited.
+      public: virtual void OnCheckpoint(const int _segmentId,
+                                        const int _laneId,
+                                        const Checkpoint &_checkpoint);
+
+      // Documentation inherited.
+      public: virtual void OnStop(const int _segmentId,
+                                  const int _laneId,
+                                  const int _waypointId);
+
+      // Documentation inherited.
+      public: virtual void OnExit(const Exit &_exit,
+                                  const int _lineNumber,
+                                  const StringView &_line);
+
+      // Documentation inherited.
+      public: virtual void OnWaypoint(const int _x,
+                                      const int _y,
+                                      const Waypoint &_waypoint);
+
+      // Documentation inherited.
+      public: virtual void OnZone(const int _zoneId,
+                                  const int _numSpots,
+                                  const std::string &_name);
+
+      // Documentation inherited.
+      public: virtual void OnSpot(const int _zoneId,
+                                  const int _spotId,
+                                  const double _width,
+                                  const Checkpoint &_checkpoint);
+
+      /// \brief Smart pointer to private data.
+      private: std::unique_ptr<RNDFBuilderPrivate> dataPtr;
+    };
+  }
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_RNDFCACHE_HH_
+#define IGNITION_RNDF_RNDFCACHE_HH_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class RNDF;
+    class Segment;
+    class StringView;
+    class Zone;
+
+    /// \internal
+    /// \brief Binary cache of a loaded RNDF. The cache is a RNDF image (see
+    /// RNDFImage.hh) tagged with the hash of the RNDF text it was created
+    /// from. A cache is read by mapping the file and copying the records,
+    /// no text is parsed.
+    class IGNITION_RNDF_VISIBLE RNDFCache
+    {
+      /// \brief Compute the hash of a RNDF text.
+      /// \param[in] _content The text.
+      /// \return The hash.
+      public: static uint64_t Hash(const StringView &_content);
+
+      /// \brief Write the cache of a RNDF. The file is written under a
+      /// temporary name and renamed when complete, so a partially written
+      /// cache is never read.
+      /// \param[in] _cachePath Path of the cache file.
+      /// \param[in] _sourceHash Hash of the text the RNDF was loaded from.
+      /// \param[in] _rndf The RNDF.
+      /// \return True if the cache was written.
+      public: static bool Write(const std::string &_cachePath,
+                                const uint64_t _sourceHash,
+                                const RNDF &_rndf);
+
+      /// \brief Read the content of a cache file.
+      /// \param[in] _cachePath Path of the cache file.
+      /// \param[in] _sourceHash Expected hash of the RNDF text.
+      /// \param[out] _name RNDF name.
+      /// \param[out] _version RNDF format version.
+      /// \param[out] _date RNDF creation date.
+      /// \param[out] _segments Segments.
+      /// \param[out] _zones Zones.
+      /// \return True if the cache exists, it is valid and it was created
+      /// from a text with the same hash.
+      public: static bool Read(const std::string &_cachePath,
+                               const uint64_t _sourceHash,
+                               std::string &_name,
+                               std::string &_version,
+                               std::string &_date,
+                               std::vector<Segment> &_segments,
+                               std::vector<Zone> &_zones);
+    };
+  }
+}
+#endif
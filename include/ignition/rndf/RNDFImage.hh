@@ -0,0 +1,398 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_RNDFIMAGE_HH_
+#define IGNITION_RNDF_RNDFIMAGE_HH_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "ignition/rndf/Helpers.hh"
+#include "ignition/rndf/StringView.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // This file describes the binary image of a RNDF, written by RNDFCache
+    // and mapped by RNDFView. All the records have a fixed size without
+    // padding, their fields are stored in the native byte order and every
+    // table starts at a multiple of 8 bytes. The tables are stored in this
+    // order after the header:
+    //
+    //   segments, lanes, waypoints, exits, checkpoints, stops, zones,
+    //   spots, nodes, text
+    //
+    // The elements of a segment, lane, zone or spot are contiguous ranges
+    // of the tables that follow it, in RNDF file order. The waypoints of
+    // all the lanes come first, then the perimeter points and spot
+    // waypoints of every zone. The exits of the lanes come before the
+    // perimeter exits.
+
+    /// \internal
+    /// \brief Magic string at the beginning of every image.
+    const char kImageMagic[8] = {'R', 'N', 'D', 'F', 'B', 'I', 'N', 0};
+
+    /// \internal
+    /// \brief Version of the image format. Images with a different version
+    /// are ignored.
+    const uint32_t kImageVersion = 2;
+
+    /// \internal
+    /// \brief Value used to detect images written with another byte order.
+    const uint32_t kImageByteOrder = 0x01020304;
+
+    /// \internal
+    /// \brief Flag of an image waypoint that is an entry point.
+    const uint32_t kImageEntry = 1;
+
+    /// \internal
+    /// \brief Flag of an image waypoint that is an exit point.
+    const uint32_t kImageExit = 2;
+
+    /// \internal
+    /// \brief A string of the image, stored in the text section.
+    struct ImageString
+    {
+      /// \brief Offset of the string in the text section.
+      public: uint32_t offset;
+
+      /// \brief Length of the string.
+      public: uint32_t size;
+    };
+
+    /// \internal
+    /// \brief Header of an image.
+    struct ImageHeader
+    {
+      /// \brief Magic string (kImageMagic).
+      public: char magic[8];
+
+      /// \brief Format version (kImageVersion).
+      public: uint32_t version;
+
+      /// \brief Byte order mark (kImageByteOrder).
+      public: uint32_t byteOrder;
+
+      /// \brief Hash of the RNDF text.
+      public: uint64_t sourceHash;
+
+      /// \brief Number of segment records.
+      public: uint32_t numSegments;
+
+      /// \brief Number of lane records.
+      public: uint32_t numLanes;
+
+      /// \brief Number of waypoint records. There is a node per waypoint.
+      public: uint32_t numWaypoints;
+
+      /// \brief Number of exit records.
+      public: uint32_t numExits;
+
+      /// \brief Number of checkpoint records.
+      public: uint32_t numCheckpoints;
+
+      /// \brief Number of stop records.
+      public: uint32_t numStops;
+
+      /// \brief Number of zone records.
+      public: uint32_t numZones;
+
+      /// \brief Number of parking spot records.
+      public: uint32_t numSpots;
+
+      /// \brief Size of the text section.
+      public: uint32_t textSize;
+
+      /// \brief Unused, always 0.
+      public: uint32_t reserved;
+
+      /// \brief RNDF name.
+      public: ImageString name;
+
+      /// \brief RNDF format version.
+      public: ImageString formatVersion;
+
+      /// \brief RNDF creation date.
+      public: ImageString date;
+    };
+
+    /// \internal
+    /// \brief A segment of the image.
+    struct ImageSegment
+    {
+      /// \brief Segment Id.
+      public: int32_t id;
+
+      /// \brief Index of the first lane.
+      public: uint32_t firstLane;
+
+      /// \brief Number of lanes.
+      public: uint32_t numLanes;
+
+      /// \brief Unused, always 0.
+      public: uint32_t reserved;
+
+      /// \brief Segment name.
+      public: ImageString name;
+    };
+
+    /// \internal
+    /// \brief A lane of the image.
+    struct ImageLane
+    {
+      /// \brief Lane Id.
+      public: int32_t id;
+
+      /// \brief Index of the first waypoint.
+      public: uint32_t firstWaypoint;
+
+      /// \brief Number of waypoints.
+      public: uint32_t numWaypoints;
+
+      /// \brief Index of the first exit.
+      public: uint32_t firstExit;
+
+      /// \brief Number of exits.
+      public: uint32_t numExits;
+
+      /// \brief Index of the first checkpoint.
+      public: uint32_t firstCheckpoint;
+
+      /// \brief Number of checkpoints.
+      public: uint32_t numCheckpoints;
+
+      /// \brief Index of the first stop.
+      public: uint32_t firstStop;
+
+      /// \brief Number of stops.
+      public: uint32_t numStops;
+
+      /// \brief Left boundary (Marking).
+      public: int32_t leftBoundary;
+
+      /// \brief Right boundary (Marking).
+      public: int32_t rightBoundary;
+
+      /// \brief Unused, always 0.
+      public: uint32_t reserved;
+
+      /// \brief Lane width in meters.
+      public: double width;
+    };
+
+    /// \internal
+    /// \brief A waypoint of the image.
+    struct ImageWaypoint
+    {
+      /// \brief Latitude.
+      public: double latitude;
+
+      /// \brief Longitude.
+      public: double longitude;
+
+      /// \brief Waypoint Id.
+      public: int32_t id;
+
+      /// \brief Combination of kImageEntry and kImageExit.
+      public: uint32_t flags;
+    };
+
+    /// \internal
+    /// \brief An exit of the image.
+    struct ImageExit
+    {
+      /// \brief X, Y and Z of the exit waypoint.
+      public: int32_t exit[3];
+
+      /// \brief X, Y and Z of the entry waypoint.
+      public: int32_t entry[3];
+    };
+
+    /// \internal
+    /// \brief A checkpoint of the image.
+    struct ImageCheckpoint
+    {
+      /// \brief Checkpoint Id.
+      public: int32_t checkpointId;
+
+      /// \brief Waypoint Id.
+      public: int32_t waypointId;
+    };
+
+    /// \internal
+    /// \brief A zone of the image.
+    struct ImageZone
+    {
+      /// \brief Zone Id.
+      public: int32_t id;
+
+      /// \brief Index of the first parking spot.
+      public: uint32_t firstSpot;
+
+      /// \brief Number of parking spots.
+      public: uint32_t numSpots;
+
+      /// \brief Index of the first perimeter point.
+      public: uint32_t firstPoint;
+
+      /// \brief Number of perimeter points.
+      public: uint32_t numPoints;
+
+      /// \brief Index of the first perimeter exit.
+      public: uint32_t firstExit;
+
+      /// \brief Number of perimeter exits.
+      public: uint32_t numExits;
+
+      /// \brief Unused, always 0.
+      public: uint32_t reserved;
+
+      /// \brief Zone name.
+      public: ImageString name;
+    };
+
+    /// \internal
+    /// \brief A parking spot of the image.
+    struct ImageSpot
+    {
+      /// \brief Spot Id.
+      public: int32_t id;
+
+      /// \brief Index of the first waypoint.
+      public: uint32_t firstWaypoint;
+
+      /// \brief Number of waypoints.
+      public: uint32_t numWaypoints;
+
+      /// \brief Unused, always 0.
+      public: uint32_t reserved;
+
+      /// \brief Checkpoint of the spot.
+      public: ImageCheckpoint checkpoint;
+
+      /// \brief Spot width in meters.
+      public: double width;
+    };
+
+    /// \internal
+    /// \brief Kind of element a node belongs to.
+    enum class ImageNodeKind : uint32_t
+    {
+      /// \brief A lane waypoint.
+      LANE = 0,
+
+      /// \brief A perimeter point.
+      PERIMETER = 1,
+
+      /// \brief A parking spot waypoint.
+      SPOT = 2
+    };
+
+    /// \internal
+    /// \brief Entry of the waypoint index. The nodes are sorted by key.
+    struct ImageNode
+    {
+      /// \brief Key of the waypoint unique Id.
+      /// \sa waypointKey()
+      public: uint64_t key;
+
+      /// \brief Index of the waypoint.
+      public: uint32_t waypoint;
+
+      /// \brief Kind of element the waypoint belongs to.
+      public: ImageNodeKind kind;
+
+      /// \brief Index of the segment (lane waypoints) or zone (perimeter
+      /// points and spot waypoints).
+      public: uint32_t parent;
+
+      /// \brief Index of the lane, zone or parking spot that contains the
+      /// waypoint.
+      public: uint32_t owner;
+    };
+
+    /// \internal
+    /// \brief The tables of an image mapped in memory.
+    struct RNDFImage
+    {
+      /// \brief Point the tables to the content of an image, checking that
+      /// the image is complete and that every range of records and string
+      /// is within its table. The fields of the nodes aren't checked, see
+      /// ValidNode().
+      /// \param[in] _content The image. It must be aligned to 8 bytes and
+      /// outlive this object.
+      /// \return True if the image is valid.
+      public: bool Map(const StringView &_content);
+
+      /// \brief Check the fields of a node.
+      /// \param[in] _node The node.
+      /// \return True if all the indices of the node are within their
+      /// tables.
+      public: bool ValidNode(const ImageNode &_node) const;
+
+      /// \brief Get a string of the text section.
+      /// \param[in] _str The string.
+      /// \return The string.
+      public: StringView String(const ImageString &_str) const;
+
+      /// \brief The header.
+      public: const ImageHeader *header = nullptr;
+
+      /// \brief The segments.
+      public: const ImageSegment *segments = nullptr;
+
+      /// \brief The lanes.
+      public: const ImageLane *lanes = nullptr;
+
+      /// \brief The waypoints.
+      public: const ImageWaypoint *waypoints = nullptr;
+
+      /// \brief The exits.
+      public: const ImageExit *exits = nullptr;
+
+      /// \brief The checkpoints.
+      public: const ImageCheckpoint *checkpoints = nullptr;
+
+      /// \brief The stops.
+      public: const int32_t *stops = nullptr;
+
+      /// \brief The zones.
+      public: const ImageZone *zones = nullptr;
+
+      /// \brief The parking spots.
+      public: const ImageSpot *spots = nullptr;
+
+      /// \brief The nodes, sorted by key.
+      public: const ImageNode *nodes = nullptr;
+
+      /// \brief The text section.
+      public: const char *text = nullptr;
+    };
+
+    /// \internal
+    /// \brief Get the size of a table, padded to a multiple of 8 bytes.
+    /// \param[in] _count Number of records.
+    /// \param[in] _recordSize Size of a record.
+    /// \return The size of the table in bytes.
+    inline size_t imageTableSize(const size_t _count, const size_t _recordSize)
+    {
+      return (_count * _recordSize + 7u) & ~static_cast<size_t>(7u);
+    }
+  }
+}
+#endif
@@ -18,7 +18,9 @@
 #ifndef IGNITION_RNDF_RNDFNODE_HH_
 #define IGNITION_RNDF_RNDFNODE_HH_
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 #include "ignition/rndf/Helpers.hh"
 
@@ -29,6 +31,7 @@ namespace ignition
     // Forward declarations.
     class Lane;
     class RNDFNodePrivate;
+    class RNDFPrivate;
     class Segment;
     class UniqueId;
     class Waypoint;
@@ -37,6 +40,12 @@ namespace ignition
     // \internal
     /// \brief An RNDF node class. Stores all the information associated with a
     /// given a unique Id .
+    ///
+    /// A node either stores pointers set with SetSegment(), SetLane(),
+    /// SetZone() and SetWaypoint(), or a handle set by the RNDF that owns
+    /// it. A handle refers to the segments or zones of the RNDF and finds
+    /// the elements of the node by Id when they are requested, so it
+    /// remains valid when the containers grow, shrink or are reallocated.
     class IGNITION_RNDF_VISIBLE RNDFNode
     {
       /// \brief Default constructor.
@@ -83,25 +92,29 @@ namespace ignition
       public: void SetUniqueId(const rndf::UniqueId &_id);
 
       /// \brief Set the pointer to the segment that contains the waypoint.
+      /// Any handle set with SetHandle() is discarded.
       /// \param[in] _segment Pointer to the segment that contains the waypoint
       /// or nullpr if there's no segment (e.g. ig the waypoint belongs to a
       /// zone).
       public: void SetSegment(rndf::Segment *_segment);
 
       /// \brief Set the pointer to the lane that contains the waypoint.
+      /// Any handle set with SetHandle() is discarded.
       /// \param[in] _lane Pointer to the lane that contains the waypoint
       /// or nullpr if there's no lane (e.g. ig the waypoint belongs to a
       /// zone).
       public: void SetLane(rndf::Lane *_lane);
 
       /// \brief Set the pointer to the zone that contains the waypoint.
+      /// Any handle set with SetHandle() is discarded.
       /// \param[in] _zone Pointer to the zone that contains the waypoint
       /// or nullpr if there's no zone (e.g. ig the waypoint belongs to a
       /// segment).
       public: void SetZone(rndf::Zone *_zone);
 
       /// \brief Set the pointer to the waypoint associated with the given
-      /// unique Id passed in the constructor.
+      /// unique Id passed in the constructor. Any handle set with
+      /// SetHandle() is discarded.
       /// \param[in] _segment Pointer to the waypoint with the given unique
       /// Id passed in the constructor or null not possible (e.g. if the Id
       // pased in the constructor was incorrect).
@@ -126,6 +139,38 @@ namespace ignition
       /// \return A reference to this instance.
       public: RNDFNode &operator=(const RNDFNode &_other);
 
+      /// \brief The RNDF sets the handles of the nodes it owns.
+      friend class RNDFPrivate;
+
+      /// \brief Resolve the node from the segments of a RNDF. The positions
+      /// are hints where the segment, lane and waypoint are looked up first;
+      /// they are searched by Id when the containers have changed.
+      /// \param[in] _segments The segments containing the waypoint.
+      /// \param[in] _segment Position of the segment in _segments.
+      /// \param[in] _lane Position of the lane in the segment.
+      /// \param[in] _waypoint Position of the waypoint in the lane.
+      /// \sa SetSegment, SetLane, SetWaypoint
+      private: void SetHandle(std::vector<rndf::Segment> *_segments,
+                              const size_t _segment,
+                              const size_t _lane,
+                              const size_t _waypoint);
+
+      /// \brief Resolve the node from the zones of a RNDF. The waypoint is
+      /// in the perimeter if the lane of the unique Id is 0, or in the
+      /// parking spot with that Id otherwise. The positions are hints where
+      /// the zone, spot and waypoint are looked up first.
+      /// \param[in] _zones The zones containing the waypoint.
+      /// \param[in] _zone Position of the zone in _zones.
+      /// \param[in] _spot Position of the parking spot in the zone, ignored
+      /// for perimeter waypoints.
+      /// \param[in] _waypoint Position of the waypoint in the perimeter or
+      /// in the parking spot.
+      /// \sa SetZone, SetWaypoint
+      private: void SetHandle(std::vector<rndf::Zone> *_zones,
+                              const size_t _zone,
+                              const size_t _spot,
+                              const size_t _waypoint);
+
       /// \internal
       /// \brief Smart pointer to private data.
 #ifdef _WIN32
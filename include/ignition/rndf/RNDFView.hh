@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_RNDFVIEW_HH_
+#define IGNITION_RNDF_RNDFVIEW_HH_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Helpers.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class RNDFViewPrivate;
+    struct RNDFImage;
+
+    // The classes of this file give read-only access to a RNDF image
+    // mapped in memory by RNDFView. They are small handles that read the
+    // image on every call, so they are cheap to copy and don't own any
+    // data. A handle can't be used after its RNDFView is destroyed or
+    // opened again.
+
+    /// \brief Read-only view of a lane of a RNDF image.
+    class IGNITION_RNDF_VISIBLE LaneView
+    {
+      /// \brief Default constructor. The view doesn't point to any lane.
+      public: LaneView() = default;
+
+      /// \internal
+      /// \brief Constructor.
+      /// \param[in] _image The image.
+      /// \param[in] _index Index of the lane in the image.
+      public: LaneView(const RNDFImage *_image, const uint32_t _index);
+
+      /// \brief Get the unique identifier of the lane.
+      /// \return The lane Id.
+      public: int Id() const;
+
+      /// \brief Get the number of waypoints.
+      /// \return The number of waypoints.
+      public: size_t NumWaypoints() const;
+
+      /// \brief Get a waypoint by position.
+      /// \param[in] _index Index of the waypoint, in [0, NumWaypoints()).
+      /// \return The waypoint or a default waypoint if the index is out of
+      /// range.
+      public: rndf::Waypoint WaypointAt(const size_t _index) const;
+
+      /// \brief Get the details of one of the waypoints with Id _wpId.
+      /// \param[in] _wpId The waypoint Id.
+      /// \param[out] _wp The waypoint requested.
+      /// \return True if the waypoint was found or false otherwise.
+      public: bool Waypoint(const int _wpId, rndf::Waypoint &_wp) const;
+
+      /// \brief Get the lane width in meters.
+      /// \return The lane width in meters.
+      public: double Width() const;
+
+      /// \brief Get the left boundary type.
+      /// \return The left boundary type.
+      public: Marking LeftBoundary() const;
+
+      /// \brief Get the right boundary type.
+      /// \return The right boundary type.
+      public: Marking RightBoundary() const;
+
+      /// \brief Get the number of checkpoints.
+      /// \return The number of checkpoints.
+      public: size_t NumCheckpoints() const;
+
+      /// \brief Get a checkpoint by position.
+      /// \param[in] _index Index of the checkpoint, in [0, NumCheckpoints()).
+      /// \return The checkpoint or a default checkpoint if the index is out
+      /// of range.
+      public: rndf::Checkpoint CheckpointAt(const size_t _index) const;
+
+      /// \brief Get the details of one of the checkpoints with Id _cpId.
+      /// \param[in] _cpId The checkpoint Id.
+      /// \param[out] _cp The checkpoint requested.
+      /// \return True if the checkpoint was found or false otherwise.
+      public: bool Checkpoint(const int _cpId, rndf::Checkpoint &_cp) const;
+
+      /// \brief Get the number of stops.
+      /// \return The number of stops.
+      public: size_t NumStops() const;
+
+      /// \brief Get a stop by position.
+      /// \param[in] _index Index of the stop, in [0, NumStops()).
+      /// \return The waypoint Id of the stop or -1 if the index is out of
+      /// range.
+      public: int StopAt(const size_t _index) const;
+
+      /// \brief Get the number of exits.
+      /// \return The number of exits.
+      public: size_t NumExits() const;
+
+      /// \brief Get an exit by position.
+      /// \param[in] _index Index of the exit, in [0, NumExits()).
+      /// \return The exit or a default exit if the index is out of range.
+      public: rndf::Exit ExitAt(const size_t _index) const;
+
+      /// \brief The image.
+      private: const RNDFImage *image = nullptr;
+
+      /// \brief Index of the lane in the image.
+      private: uint32_t index = 0;
+    };
+
+    /// \brief Read-only view of a segment of a RNDF image.
+    class IGNITION_RNDF_VISIBLE SegmentView
+    {
+      /// \brief Default constructor. The view doesn't point to any segment.
+      public: SegmentView() = default;
+
+      /// \internal
+      /// \brief Constructor.
+      /// \param[in] _image The image.
+      /// \param[in] _index Index of the segment in the image.
+      public: SegmentView(const RNDFImage *_image, const uint32_t _index);
+
+      /// \brief Get the unique identifier of the segment.
+      /// \return The segment Id.
+      public: int Id() const;
+
+      /// \brief Get the segment name.
+      /// \return The segment name.
+      public: std::string Name() const;
+
+      /// \brief Get the number of lanes.
+      /// \return The number of lanes.
+      public: size_t NumLanes() const;
+
+      /// \brief Get a lane by position.
+      /// \param[in] _index Index of the lane, in [0, NumLanes()).
+      /// \return The lane or an empty view if the index is out of range.
+      public: LaneView LaneAt(const size_t _index) const;
+
+      /// \brief Get the details of one of the lanes with Id _laneId.
+      /// \param[in] _laneId The lane Id.
+      /// \param[out] _lane The lane requested.
+      /// \return True if the lane was found or false otherwise.
+      public: bool Lane(const int _laneId, LaneView &_lane) const;
+
+      /// \brief The image.
+      private: const RNDFImage *image = nullptr;
+
+      /// \brief Index of the segment in the image.
+      private: uint32_t index = 0;
+    };
+
+    /// \brief Read-only view of the perimeter of a zone of a RNDF image.
+    class IGNITION_RNDF_VISIBLE PerimeterView
+    {
+      /// \brief Default constructor. The view doesn't point to any
+      /// perimeter.
+      public: PerimeterView() = default;
+
+      /// \internal
+      /// \brief Constructor.
+      /// \param[in] _image The image.
+      /// \param[in] _index Index of the zone in the image.
+      public: PerimeterView(const RNDFImage *_image, const uint32_t _index);
+
+      /// \brief Get the number of points.
+      /// \return The number of points.
+      public: size_t NumPoints() const;
+
+      /// \brief Get a point by position.
+      /// \param[in] _index Index of the point, in [0, NumPoints()).
+      /// \return The point or a default waypoint if the index is out of
+      /// range.
+      public: rndf::Waypoint PointAt(const size_t _index) const;
+
+      /// \brief Get the details of one of the points with Id _wpId.
+      /// \param[in] _wpId The point Id.
+      /// \param[out] _wp The point requested.
+      /// \return True if the point was found or false otherwise.
+      public: bool Point(const int _wpId, rndf::Waypoint &_wp) const;
+
+      /// \brief Get the number of exits.
+      /// \return The number of exits.
+      public: size_t NumExits() const;
+
+      /// \brief Get an exit by position.
+      /// \param[in] _index Index of the exit, in [0, NumExits()).
+      /// \return The exit or a default exit if the index is out of range.
+      public: rndf::Exit ExitAt(const size_t _index) const;
+
+      /// \brief The image.
+      private: const RNDFImage *image = nullptr;
+
+      /// \brief Index of the zone in the image.
+      private: uint32_t index = 0;
+    };
+
+    /// \brief Read-only view of a parking spot of a RNDF image.
+    class IGNITION_RNDF_VISIBLE ParkingSpotView
+    {
+      /// \brief Default constructor. The view doesn't point to any spot.
+      public: ParkingSpotView() = default;
+
+      /// \internal
+      /// \brief Constructor.
+      /// \param[in] _image The image.
+      /// \param[in] _index Index of the spot in the image.
+      public: ParkingSpotView(const RNDFImage *_image,
+                              const uint32_t _index);
+
+      /// \brief Get the unique identifier of the parking spot.
+      /// \return The parking spot Id.
+      public: int Id() const;
+
+      /// \brief Get the number of waypoints.
+      /// \return The number of waypoints.
+      public: size_t NumWaypoints() const;
+
+      /// \brief Get a waypoint by position.
+      /// \param[in] _index Index of the waypoint, in [0, NumWaypoints()).
+      /// \return The waypoint or a default waypoint if the index is out of
+      /// range.
+      public: rndf::Waypoint WaypointAt(const size_t _index) const;
+
+      /// \brief Get the details of one of the waypoints with Id _wpId.
+      /// \param[in] _wpId The waypoint Id.
+      /// \param[out] _wp The waypoint requested.
+      /// \return True if the waypoint was found or false otherwise.
+      public: bool Waypoint(const int _wpId, rndf::Waypoint &_wp) const;
+
+      /// \brief Get the parking spot width in meters.
+      /// \return The parking spot width in meters.
+      public: double Width() const;
+
+      /// \brief Get the checkpoint of the parking spot.
+      /// \return The checkpoint.
+      public: rndf::Checkpoint Checkpoint() const;
+
+      /// \brief The image.
+      private: const RNDFImage *image = nullptr;
+
+      /// \brief Index of the spot in the image.
+      private: uint32_t index = 0;
+    };
+
+    /// \brief Read-only view of a zone of a RNDF image.
+    class IGNITION_RNDF_VISIBLE ZoneView
+    {
+      /// \brief Default constructor. The view doesn't point to any zone.
+      public: ZoneView() = default;
+
+      /// \internal
+      /// \brief Constructor.
+      /// \param[in] _image The image.
+      /// \param[in] _index Index of the zone in the image.
+      public: ZoneView(const RNDFImage *_image, const uint32_t _index);
+
+      /// \brief Get the unique identifier of the zone.
+      /// \return The zone Id.
+      public: int Id() const;
+
+      /// \brief Get the zone name.
+      /// \return The zone name.
+      public: std::string Name() const;
+
+      /// \brief Get the number of parking spots.
+      /// \return The number of parking spots.
+      public: size_t NumSpots() const;
+
+      /// \brief Get a parking spot by position.
+      /// \param[in] _index Index of the spot, in [0, NumSpots()).
+      /// \return The spot or an empty view if the index is out of range.
+      public: ParkingSpotView SpotAt(const size_t _index) const;
+
+      /// \brief Get the details of one of the parking spots with Id _psId.
+      /// \param[in] _psId The parking spot Id.
+      /// \param[out] _ps The parking spot requested.
+      /// \return True if the parking spot was found or false otherwise.
+      public: bool Spot(const int _psId, ParkingSpotView &_ps) const;
+
+      /// \brief Get the perimeter of the zone.
+      /// \return The perimeter.
+      public: PerimeterView Perimeter() const;
+
+      /// \brief The image.
+      private: const RNDFImage *image = nullptr;
+
+      /// \brief Index of the zone in the image.
+      private: uint32_t index = 0;
+    };
+
+    /// \brief Read-only view of a waypoint of a RNDF image and the elements
+    /// that contain it, returned by RNDFView::Info().
+    class IGNITION_RNDF_VISIBLE RNDFNodeView
+    {
+      /// \brief Default constructor. The view doesn't point to any node.
+      public: RNDFNodeView() = default;
+
+      /// \internal
+      /// \brief Constructor.
+      /// \param[in] _image The image.
+      /// \param[in] _index Index of the node in the image.
+      public: RNDFNodeView(const RNDFImage *_image, const uint32_t _index);
+
+      /// \brief Get the unique Id of the waypoint.
+      /// \return The unique Id.
+      public: rndf::UniqueId UniqueId() const;
+
+      /// \brief Get the waypoint.
+      /// \return The waypoint.
+      public: rndf::Waypoint Waypoint() const;
+
+      /// \brief Get the segment that contains the waypoint.
+      /// \param[out] _segment The segment.
+      /// \return True if the waypoint belongs to a lane.
+      public: bool Segment(SegmentView &_segment) const;
+
+      /// \brief Get the lane that contains the waypoint.
+      /// \param[out] _lane The lane.
+      /// \return True if the waypoint belongs to a lane.
+      public: bool Lane(LaneView &_lane) const;
+
+      /// \brief Get the zone that contains the waypoint.
+      /// \param[out] _zone The zone.
+      /// \return True if the waypoint is a perimeter point or belongs to a
+      /// parking spot.
+      public: bool Zone(ZoneView &_zone) const;
+
+      /// \brief Get the parking spot that contains the waypoint.
+      /// \param[out] _spot The parking spot.
+      /// \return True if the waypoint belongs to a parking spot.
+      public: bool Spot(ParkingSpotView &_spot) const;
+
+      /// \brief The image.
+      private: const RNDFImage *image = nullptr;
+
+      /// \brief Index of the node in the image.
+      private: uint32_t index = 0;
+    };
+
+    /// \brief Read-only view of a RNDF stored as a binary image (the cache
+    /// written by RNDF::Load(const std::string &, const std::string &)).
+    /// The image is memory-mapped and queried in place: opening it doesn't
+    /// create any object, and processes that open the same image share the
+    /// pages of the file instead of holding a copy of the network each.
+    class IGNITION_RNDF_VISIBLE RNDFView
+    {
+      /// \brief Default constructor.
+      public: RNDFView();
+
+      /// \brief Destructor.
+      public: virtual ~RNDFView();
+
+      /// \brief Open a RNDF image.
+      /// \param[in] _imagePath Path to the image.
+      /// \return True if the image was mapped and it's valid.
+      public: bool Open(const std::string &_imagePath);
+
+      /// \brief Open the image of a RNDF text file. If the image doesn't
+      /// exist or it was created from a different text, the text is parsed
+      /// and the image is written first.
+      /// \param[in] _filePath Path to RNDF file.
+      /// \param[in] _imagePath Path to the image.
+      /// \return True if the image was mapped and it's valid.
+      public: bool Open(const std::string &_filePath,
+                        const std::string &_imagePath);
+
+      /// \brief Whether an image is open.
+      /// \return True if an image is open.
+      public: bool IsOpen() const;
+
+      /// \brief Get the name of the RNDF.
+      /// \return The name of the RNDF.
+      public: std::string Name() const;
+
+      /// \brief Get the RNDF version.
+      /// \return The RNDF version.
+      public: std::string Version() const;
+
+      /// \brief Get the RNDF creation date.
+      /// \return The RNDF creation date.
+      public: std::string Date() const;
+
+      /// \brief Get the number of segments.
+      /// \return The number of segments.
+      public: size_t NumSegments() const;
+
+      /// \brief Get a segment by position.
+      /// \param[in] _index Index of the segment, in [0, NumSegments()).
+      /// \return The segment or an empty view if the index is out of range.
+      public: SegmentView SegmentAt(const size_t _index) const;
+
+      /// \brief Get the details of one of the segments with Id _segmentId.
+      /// \param[in] _segmentId The segment Id.
+      /// \param[out] _segment The segment requested.
+      /// \return True if the segment was found or false otherwise.
+      public: bool Segment(const int _segmentId, SegmentView &_segment) const;
+
+      /// \brief Get the number of zones.
+      /// \return The number of zones.
+      public: size_t NumZones() const;
+
+      /// \brief Get a zone by position.
+      /// \param[in] _index Index of the zone, in [0, NumZones()).
+      /// \return The zone or an empty view if the index is out of range.
+      public: ZoneView ZoneAt(const size_t _index) const;
+
+      /// \brief Get the details of one of the zones with Id _zoneId.
+      /// \param[in] _zoneId The zone Id.
+      /// \param[out] _zone The zone requested.
+      /// \return True if the zone was found or false otherwise.
+      public: bool Zone(const int _zoneId, ZoneView &_zone) const;
+
+      /// \brief Get the waypoint with a unique Id and the elements that
+      /// contain it. The waypoints of the image are sorted by unique Id, so
+      /// the lookup takes logarithmic time.
+      /// \param[in] _id The unique Id.
+      /// \param[out] _node The waypoint requested.
+      /// \return True if the waypoint was found or false otherwise.
+      public: bool Info(const rndf::UniqueId &_id, RNDFNodeView &_node) const;
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<RNDFViewPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_RNDFVISITOR_HH_
+#define IGNITION_RNDF_RNDFVISITOR_HH_
+
+#include <string>
+
+#include "ignition/rndf/Helpers.hh"
+#include "ignition/rndf/Lane.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class Checkpoint;
+    class Exit;
+    class StringView;
+    class Waypoint;
+
+    /// \brief Receives the elements of a RNDF while it's parsed, in the
+    /// order they appear in the file. A visitor decides what to keep, so a
+    /// RNDF can be processed without storing all its waypoints.
+    /// All the callbacks do nothing by default.
+    /// \sa RNDF::Parse()
+    class IGNITION_RNDF_VISIBLE RNDFVisitor
+    {
+      /// \brief Destructor.
+      public: virtual ~RNDFVisitor();
+
+      /// \brief Called after the file name, the number of segments and zones
+      /// and the optional file header are parsed.
+      /// \param[in] _name RNDF name.
+      /// \param[in] _numSegments Number of segments.
+      /// \param[in] _numZones Number of zones.
+      /// \param[in] _version Format version or empty if not present.
+      /// \param[in] _date Creation date or empty if not present.
+      public: virtual void OnRNDF(const std::string &_name,
+                                  const int _numSegments,
+                                  const int _numZones,
+                                  const std::string &_version,
+                                  const std::string &_date);
+
+      /// \brief Called after the header of a segment is parsed, before its
+      /// lanes.
+      /// \param[in] _segmentId Segment Id.
+      /// \param[in] _numLanes Number of lanes.
+      /// \param[in] _name Segment name or empty if not present.
+      public: virtual void OnSegment(const int _segmentId,
+                                     const int _numLanes,
+                                     const std::string &_name);
+
+      /// \brief Called when a lane starts, before its header.
+      /// \param[in] _segmentId Segment Id.
+      /// \param[in] _laneId Lane Id.
+      /// \param[in] _numWaypoints Number of waypoints.
+      public: virtual void OnLane(const int _segmentId,
+                                  const int _laneId,
+                                  const int _numWaypoints);
+
+      /// \brief Called after the header of a lane is parsed, before its
+      /// waypoints. The checkpoints, stops and exits of the header are
+      /// reported before this call.
+      /// \param[in] _segmentId Segment Id.
+      /// \param[in] _laneId Lane Id.
+      /// \param[in] _width Lane width in meters (0 if not present).
+      /// \param[in] _leftBoundary Left boundary type.
+      /// \param[in] _rightBoundary Right boundary type.
+      public: virtual void OnLaneHeader(const int _segmentId,
+                                        const int _laneId,
+                                        const double _width,
+                                        const Marking _leftBoundary,
+                                        const Marking _rightBoundary);
+
+      /// \brief Called for every checkpoint of a lane header.
+      /// \param[in] _segmentId Segment Id.
+      /// \param[in] _laneId Lane Id.
+      /// \param[in] _checkpoint The checkpoint.
+      public: virtual void OnCheckpoint(const int _segmentId,
+                                        const int _laneId,
+                                        const Checkpoint &_checkpoint);
+
+      /// \brief Called for every stop of a lane header.
+      /// \param[in] _segmentId Segment Id.
+      /// \param[in] _laneId Lane Id.
+      /// \param[in] _waypointId Id of the waypoint that is a stop.
+      public: virtual void OnStop(const int _segmentId,
+                                  const int _laneId,
+                                  const int _waypointId);
+
+      /// \brief Called for every exit of a lane or perimeter header.
+      /// The exit of a perimeter has a 0 lane Id.
+      /// \param[in] _exit The exit.
+      /// \param[in] _lineNumber Line number of the exit.
+      /// \param[in] _line Text of the line. It's only valid during the call.
+      public: virtual void OnExit(const Exit &_exit,
+                                  const int _lineNumber,
+                                  const StringView &_line);
+
+      /// \brief Called for every waypoint of a lane, perimeter or parking
+      /// spot. The exit flag of the waypoint is already set.
+      /// \param[in] _x Segment or zone Id.
+      /// \param[in] _y Lane or parking spot Id, or 0 for a perimeter point.
+      /// \param[in] _waypoint The waypoint.
+      public: virtual void OnWaypoint(const int _x,
+                                      const int _y,
+                                      const Waypoint &_waypoint);
+
+      /// \brief Called after the header of a zone is parsed, before its
+      /// perimeter.
+      /// \param[in] _zoneId Zone Id.
+      /// \param[in] _numSpots Number of parking spots.
+      /// \param[in] _name Zone name or empty if not present.
+      public: virtual void OnZone(const int _zoneId,
+                                  const int _numSpots,
+                                  const std::string &_name);
+
+      /// \brief Called when a perimeter starts, before its exits.
+      /// \param[in] _zoneId Zone Id.
+      /// \param[in] _numPoints Number of perimeter points.
+      public: virtual void OnPerimeter(const int _zoneId,
+                                       const int _numPoints);
+
+      /// \brief Called after the header of a parking spot is parsed, before
+      /// its waypoints.
+      /// \param[in] _zoneId Zone Id.
+      /// \param[in] _spotId Parking spot Id.
+      /// \param[in] _width Spot width in meters (0 if not present).
+      /// \param[in] _checkpoint The checkpoint of the spot. It's not valid
+      /// if not present.
+      public: virtual void OnSpot(const int _zoneId,
+                                  const int _spotId,
+                                  const double _width,
+                                  const Checkpoint &_checkpoint);
+    };
+  }
+}
+#endif
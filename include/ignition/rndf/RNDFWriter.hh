@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_RNDFWRITER_HH_
+#define IGNITION_RNDF_RNDFWRITER_HH_
+
+#include <iosfwd>
+#include <memory>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class Lane;
+    class ParkingSpot;
+    class Perimeter;
+    class RNDF;
+    class RNDFWriterPrivate;
+    class Segment;
+    class Zone;
+
+    /// \internal
+    /// \brief Writes RNDF elements as text, in the format read by the
+    /// Load() functions. The text is accumulated in a large buffer that is
+    /// written to the stream when full, so the output is written in a few
+    /// big blocks without creating intermediate strings. The buffer is
+    /// flushed by Flush() and on destruction.
+    class IGNITION_RNDF_VISIBLE RNDFWriter
+    {
+      /// \brief Constructor.
+      /// \param[in, out] _stream Stream where the text is written.
+      public: explicit RNDFWriter(std::ostream &_stream);
+
+      /// \brief Destructor. Flushes the buffer.
+      public: virtual ~RNDFWriter();
+
+      /// \brief Write the buffered text to the stream.
+      /// \return True if the stream is in a good state.
+      public: bool Flush();
+
+      /// \brief Write a whole RNDF, from "RNDF_name" to "end_file".
+      /// \param[in] _rndf The RNDF.
+      public: void WriteRNDF(const RNDF &_rndf);
+
+      /// \brief Write a segment, from "segment" to "end_segment".
+      /// \param[in] _segment The segment.
+      public: void WriteSegment(const Segment &_segment);
+
+      /// \brief Write a lane, from "lane" to "end_lane".
+      /// \param[in] _segmentId Id of the segment that contains the lane.
+      /// \param[in] _lane The lane.
+      public: void WriteLane(const int _segmentId, const Lane &_lane);
+
+      /// \brief Write a zone, from "zone" to "end_zone".
+      /// \param[in] _zone The zone.
+      public: void WriteZone(const Zone &_zone);
+
+      /// \brief Write a perimeter, from "perimeter" to "end_perimeter".
+      /// \param[in] _zoneId Id of the zone that contains the perimeter.
+      /// \param[in] _perimeter The perimeter.
+      public: void WritePerimeter(const int _zoneId,
+                                  const Perimeter &_perimeter);
+
+      /// \brief Write a parking spot, from "spot" to "end_spot".
+      /// \param[in] _zoneId Id of the zone that contains the spot.
+      /// \param[in] _spot The parking spot.
+      public: void WriteSpot(const int _zoneId, const ParkingSpot &_spot);
+
+      /// \brief Format a double with the fewest digits that parseDouble()
+      /// reads back as the same value. Values with up to nine decimals,
+      /// like the coordinates of a RNDF, are written in fixed notation
+      /// without calling the C library. The result doesn't depend on the
+      /// locale.
+      /// \param[in] _value The value.
+      /// \param[out] _buffer Buffer of at least kMaxDoubleSize characters.
+      /// The result isn't null-terminated.
+      /// \return The number of characters written.
+      public: static size_t FormatDouble(const double _value, char *_buffer);
+
+      /// \brief Maximum number of characters written by FormatDouble().
+      public: static const size_t kMaxDoubleSize = 32;
+
+      /// \brief Size of the output buffer.
+      public: static const size_t kBufferSize = 1 << 20;
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<RNDFWriterPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_ROADGRAPH_HH_
+#define IGNITION_RNDF_ROADGRAPH_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class CoordinateSnapshot;
+    class RNDF;
+    class RoadGraphPrivate;
+    class UniqueId;
+
+    /// \brief A directed graph of the road network of a RNDF, stored in
+    /// compressed sparse row (CSR) form. The nodes are all the waypoints of
+    /// the RNDF, in the order of RNDF::Coordinates(): node i has the unique
+    /// Id key Keys()[i]. The outgoing edges of node i are the positions
+    /// [Offsets()[i], Offsets()[i + 1]) of Targets() and Lengths().
+    ///
+    /// The edges are:
+    /// * Every waypoint of a lane to the next one.
+    /// * Every exit of a lane or perimeter to its entry.
+    /// * Every waypoint of a parking spot to the next one and back, so a
+    ///   vehicle can drive in and out of the spot.
+    /// * Inside a zone, which is an unstructured area, every perimeter
+    ///   point and the first waypoint of every parking spot to and from
+    ///   the gates of the zone: the perimeter points that are the exit or
+    ///   the entry of an exit, or the first perimeter point or parking spot
+    ///   waypoint if there are none. The number of edges is then linear in
+    ///   the number of parking spots. Routes between two parking spots go
+    ///   through a gate.
+    ///
+    /// The length of an edge is the great-circle distance in meters between
+    /// its waypoints. Exits to unknown waypoints are ignored. The graph is a
+    /// copy: it isn't updated when the RNDF changes. RNDF::RoadGraph()
+    /// returns a graph that is updated when needed.
+    class IGNITION_RNDF_VISIBLE RoadGraph
+    {
+      /// \brief Default constructor. The graph is empty.
+      public: RoadGraph();
+
+      /// \brief Constructor.
+      /// \param[in] _rndf The RNDF with the road network.
+      public: explicit RoadGraph(const RNDF &_rndf);
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Other graph.
+      public: RoadGraph(const RoadGraph &_other);
+
+      /// \brief Destructor.
+      public: virtual ~RoadGraph();
+
+      /// \brief Rebuild the graph with the road network of a RNDF.
+      /// \param[in] _rndf The RNDF with the road network.
+      public: void Update(const RNDF &_rndf);
+
+      /// \brief Update the location of some nodes and the length of their
+      /// edges. The first call builds the incoming edges of every node.
+      /// \param[in] _coordinates Coordinates of the waypoints of the RNDF
+      /// the graph was built from. Only their locations may have changed:
+      /// the waypoints and exits must be the same.
+      /// \param[in] _moved Nodes moved, which are also their positions in
+      /// _coordinates.
+      public: void Update(const CoordinateSnapshot &_coordinates,
+                          const std::vector<uint32_t> &_moved);
+
+      /// \brief Get the number of nodes.
+      /// \return The number of nodes.
+      public: size_t NumNodes() const;
+
+      /// \brief Get the number of edges.
+      /// \return The number of edges.
+      public: size_t NumEdges() const;
+
+      /// \brief Get the node of a waypoint.
+      /// \param[in] _id Unique Id of the waypoint.
+      /// \param[out] _node The node.
+      /// \return True if the waypoint is in the graph or false otherwise.
+      public: bool Node(const UniqueId &_id, uint32_t &_node) const;
+
+      /// \brief Get the unique Id keys of the nodes.
+      /// \return The keys.
+      /// \sa UniqueId::Key()
+      public: const std::vector<uint64_t> &Keys() const;
+
+      /// \brief Get the latitudes of the nodes.
+      /// \return The latitudes in degrees.
+      public: const std::vector<double> &Latitudes() const;
+
+      /// \brief Get the longitudes of the nodes.
+      /// \return The longitudes in degrees.
+      public: const std::vector<double> &Longitudes() const;
+
+      /// \brief Get the position of the first outgoing edge of every node,
+      /// followed by the number of edges.
+      /// \return NumNodes() + 1 offsets, or none if the graph is empty.
+      public: const std::vector<uint32_t> &Offsets() const;
+
+      /// \brief Get the target node of every edge.
+      /// \return The targets.
+      public: const std::vector<uint32_t> &Targets() const;
+
+      /// \brief Get the length of every edge.
+      /// \return The lengths in meters.
+      public: const std::vector<double> &Lengths() const;
+
+      /// \brief Assignment operator.
+      /// \param[in] _other The new graph.
+      /// \return A reference to this instance.
+      public: RoadGraph &operator=(const RoadGraph &_other);
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<RoadGraphPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_ROUTER_HH_
+#define IGNITION_RNDF_ROUTER_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class RNDF;
+    class RoadGraph;
+    class RouterPrivate;
+    class UniqueId;
+
+    /// \brief Shortest routes between waypoints over a RoadGraph, computed
+    /// with A*. The heuristic is the straight-line distance through the
+    /// Earth between two waypoints, a lower bound of their great-circle
+    /// distance that needs no trigonometry. The search state is kept
+    /// between queries, so repeated queries don't allocate memory.
+    ///
+    /// The cost of a route is its length in meters plus the penalties of
+    /// the waypoints that it enters (all but the first one). The router
+    /// keeps a reference to the graph, which must outlive it, and has to be
+    /// updated when the graph changes. A router isn't thread safe: use one
+    /// per thread.
+    class IGNITION_RNDF_VISIBLE Router
+    {
+      /// \brief Default constructor. The router has no graph.
+      public: Router();
+
+      /// \brief Constructor.
+      /// \param[in] _graph The graph to route over.
+      public: explicit Router(const RoadGraph &_graph);
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Other router.
+      public: Router(const Router &_other);
+
+      /// \brief Destructor.
+      public: virtual ~Router();
+
+      /// \brief Set the graph to route over and clear all the penalties.
+      /// Call it again after the graph changes.
+      /// \param[in] _graph The graph.
+      public: void Update(const RoadGraph &_graph);
+
+      /// \brief Set the penalty of entering a waypoint.
+      /// \param[in] _id Unique Id of the waypoint.
+      /// \param[in] _penalty Penalty in meters (non-negative).
+      /// \return True if the penalty was set or false if the waypoint isn't
+      /// in the graph or the penalty is negative.
+      public: bool SetPenalty(const UniqueId &_id, const double _penalty);
+
+      /// \brief Set the penalty of entering every stop waypoint of a RNDF.
+      /// \param[in] _rndf The RNDF with the stops.
+      /// \param[in] _penalty Penalty in meters (non-negative).
+      /// \return True if the penalties were set or false if the penalty is
+      /// negative.
+      /// \sa Lane::Stops()
+      public: bool SetStopPenalty(const RNDF &_rndf, const double _penalty);
+
+      /// \brief Remove all the penalties.
+      public: void ClearPenalties();
+
+      /// \brief Compute the shortest route between two waypoints.
+      /// \param[in] _start Unique Id of the first waypoint.
+      /// \param[in] _goal Unique Id of the last waypoint.
+      /// \param[out] _waypoints Unique Ids of the waypoints of the route,
+      /// from _start to _goal. Its memory is reused.
+      /// \return True if there is a route or false otherwise.
+      public: bool Route(const UniqueId &_start,
+                         const UniqueId &_goal,
+                         std::vector<UniqueId> &_waypoints);
+
+      /// \brief Compute the shortest route between two waypoints.
+      /// \param[in] _start Unique Id of the first waypoint.
+      /// \param[in] _goal Unique Id of the last waypoint.
+      /// \param[out] _waypoints Unique Ids of the waypoints of the route,
+      /// from _start to _goal. Its memory is reused.
+      /// \param[out] _cost Cost of the route.
+      /// \return True if there is a route or false otherwise.
+      public: bool Route(const UniqueId &_start,
+                         const UniqueId &_goal,
+                         std::vector<UniqueId> &_waypoints,
+                         double &_cost);
+
+      /// \brief Compute the shortest route between two nodes of the graph.
+      /// \param[in] _start The first node.
+      /// \param[in] _goal The last node.
+      /// \param[out] _nodes Nodes of the route, from _start to _goal. Its
+      /// memory is reused.
+      /// \param[out] _cost Cost of the route.
+      /// \return True if there is a route or false otherwise.
+      public: bool Route(const uint32_t _start,
+                         const uint32_t _goal,
+                         std::vector<uint32_t> &_nodes,
+                         double &_cost);
+
+      /// \brief Get the number of nodes settled by the last query.
+      /// \return The number of nodes.
+      public: size_t LastSettled() const;
+
+      /// \brief Assignment operator.
+      /// \param[in] _other The new router.
+      /// \return A reference to this instance.
+      public: Router &operator=(const Router &_other);
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<RouterPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
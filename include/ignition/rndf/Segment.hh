@@ -18,6 +18,7 @@
 #ifndef IGNITION_RNDF_SEGMENT_HH_
 #define IGNITION_RNDF_SEGMENT_HH_
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -31,6 +32,8 @@ namespace ignition
   {
     // Forward declarations.
     class Lane;
+    class LineReader;
+    class RNDFVisitor;
     class SegmentHeaderPrivate;
     class SegmentPrivate;
     struct ExitCacheEntry;
@@ -49,6 +52,15 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a segment header from a line reader. The expected
+      /// format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \return True if a segment header block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        int &_lineNumber);
+
       /// \brief Load a segment header from an input stream coming from a
       /// text file. The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -94,6 +106,12 @@ namespace ignition
       /// \sa Valid.
       public: Segment(const Segment &_other);
 
+      /// \brief Move constructor. The content of _other is transferred
+      /// without copying it.
+      /// \param[in, out] _other Other segment. It can only be destroyed or
+      /// assigned to after the move.
+      public: Segment(Segment &&_other) noexcept;  // NOLINT
+
       /// \brief Destructor.
       public: virtual ~Segment();
 
@@ -101,12 +119,54 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a segment from a line reader.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Keys of the waypoints parsed.
+      /// \return True if a segment block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        int &_lineNumber,
+                        std::vector<ExitCacheEntry> &_exitCache,
+                        std::vector<uint64_t> &_waypointCache);
+
+      /// \brief Parse a segment from a line reader and report its elements to
+      /// a visitor, without storing them.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _visitor Visitor that receives the segment elements.
+      /// \param[out] _segmentId Id of the segment parsed.
+      /// \return True if a segment block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: static bool Parse(LineReader &_reader,
+                                int &_lineNumber,
+                                RNDFVisitor &_visitor,
+                                int &_segmentId);
+
       /// \brief Load a segment from an input stream coming from a text file.
       /// The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
       /// \param[in, out] _lineNumber Line number pointed by the stream position
       /// indicator.
       /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Keys of the waypoints parsed.
+      /// \return True if a segment block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(std::ifstream &_rndfFile,
+                        int &_lineNumber,
+                        std::vector<ExitCacheEntry> &_exitCache,
+                        std::vector<uint64_t> &_waypointCache);
+
+      /// \brief Load a segment from an input stream coming from a text file.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \deprecated Use the overload that caches the waypoint keys.
+      /// \param[in, out] _rndfFile Input file stream.
+      /// \param[in, out] _lineNumber Line number pointed by the stream position
+      /// indicator.
+      /// \param[in, out] _exitCache Cache of exits parsed.
       /// \param[in, out] _waypointCache Cache of waypoints parsed.
       /// \return True if a segment block was found and parsed or false
       /// otherwise (e.g.: EoF or incorrect format found).
@@ -115,6 +175,12 @@ namespace ignition
                         std::vector<ExitCacheEntry> &_exitCache,
                         std::vector<std::string> &_waypointCache);
 
+      /// \brief Write the segment as text, in the format read by Load().
+      /// \param[in, out] _stream Output stream.
+      /// \return True if the segment was written or false otherwise
+      /// (e.g.: the stream is in a bad state).
+      public: bool Save(std::ostream &_stream) const;
+
       ///////
       /// Id
       ///////
@@ -153,6 +219,18 @@ namespace ignition
       public: bool Lane(const int _laneId,
                         rndf::Lane &_lane) const;
 
+      /// \brief Get the lane with Id _laneId without copying it.
+      /// \param[in] _laneId The lane Id.
+      /// \return Pointer to the lane, or nullptr if not found. It is
+      /// valid until the vector of lanes changes.
+      public: const rndf::Lane *Lane(const int _laneId) const;
+
+      /// \brief Get the lane with Id _laneId to edit it in place.
+      /// \param[in] _laneId The lane Id.
+      /// \return Pointer to the lane, or nullptr if not found. It is
+      /// valid until the vector of lanes changes.
+      public: rndf::Lane *Lane(const int _laneId);
+
       /// \brief Update an existing lane.
       /// \param[in] _lane The updated lane.
       /// \return True if the lane was found and updated or false otherwise.
@@ -210,6 +288,13 @@ namespace ignition
       /// \return A reference to this instance.
       public: Segment &operator=(const Segment &_other);
 
+      /// \brief Move assignment operator. The content of _other is
+      /// transferred without copying it.
+      /// \param[in, out] _other The new segment. It receives the previous
+      /// content of this instance.
+      /// \return A reference to this instance.
+      public: Segment &operator=(Segment &&_other) noexcept;  // NOLINT
+
       /// \internal
       /// \brief Smart pointer to private data.
 #ifdef _WIN32
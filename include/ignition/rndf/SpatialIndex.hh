@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_SPATIALINDEX_HH_
+#define IGNITION_RNDF_SPATIALINDEX_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "ignition/rndf/Helpers.hh"
+
+namespace ignition
+{
+  namespace rndf
+  {
+    // Forward declarations.
+    class CoordinateSnapshot;
+    class SpatialIndexPrivate;
+    class UniqueId;
+
+    /// \brief Waypoints considered by a spatial query.
+    enum class SpatialFilter
+    {
+      /// \brief All the waypoints.
+      ALL,
+      /// \brief Only the waypoints of the lanes.
+      LANES,
+      /// \brief Only the perimeter and parking spot waypoints of the zones.
+      ZONES
+    };
+
+    /// \brief A static k-d tree over the waypoints of a RNDF, for nearest
+    /// waypoint and radius queries. The waypoints are projected to a local
+    /// frame in meters centered on the RNDF (an equirectangular projection),
+    /// where distances are accurate for networks spanning tens of
+    /// kilometers. The index is a copy: it isn't updated when the RNDF
+    /// changes. RNDF::SpatialIndex() returns an index that is updated when
+    /// needed.
+    class IGNITION_RNDF_VISIBLE SpatialIndex
+    {
+      /// \brief Default constructor. The index is empty.
+      public: SpatialIndex();
+
+      /// \brief Constructor.
+      /// \param[in] _coordinates Coordinates of the waypoints to index.
+      public: explicit SpatialIndex(const CoordinateSnapshot &_coordinates);
+
+      /// \brief Copy constructor.
+      /// \param[in] _other Other index.
+      public: SpatialIndex(const SpatialIndex &_other);
+
+      /// \brief Destructor.
+      public: virtual ~SpatialIndex();
+
+      /// \brief Rebuild the index with the coordinates of other waypoints.
+      /// \param[in] _coordinates Coordinates of the waypoints to index.
+      public: void Update(const CoordinateSnapshot &_coordinates);
+
+      /// \brief Update the location of some waypoints without rebuilding
+      /// the tree. The moved waypoints are scanned linearly by the queries
+      /// until there are too many of them, and then the tree is rebuilt.
+      /// \param[in] _coordinates Coordinates of the waypoints, which must
+      /// be the ones indexed, in the same order, with some of them moved.
+      /// Otherwise the index is rebuilt.
+      /// \param[in] _moved Positions in _coordinates of the waypoints moved.
+      /// \sa CoordinateSnapshot::Update(const RNDF &,
+      /// const std::vector<int> &, std::vector<uint32_t> &)
+      public: void Update(const CoordinateSnapshot &_coordinates,
+                          const std::vector<uint32_t> &_moved);
+
+      /// \brief Get the number of waypoints indexed.
+      /// \return The number of waypoints.
+      public: size_t Size() const;
+
+      /// \brief Find the waypoint closest to a location.
+      /// \param[in] _latitude Latitude of the location in degrees.
+      /// \param[in] _longitude Longitude of the location in degrees.
+      /// \param[out] _id Unique Id of the closest waypoint.
+      /// \param[in] _filter Waypoints considered.
+      /// \return True if a waypoint was found or false if there are no
+      /// waypoints matching the filter.
+      public: bool Nearest(const double _latitude,
+                           const double _longitude,
+                           UniqueId &_id,
+                           const SpatialFilter _filter =
+                             SpatialFilter::ALL) const;
+
+      /// \brief Find the waypoint closest to a location and its distance.
+      /// \param[in] _latitude Latitude of the location in degrees.
+      /// \param[in] _longitude Longitude of the location in degrees.
+      /// \param[out] _id Unique Id of the closest waypoint.
+      /// \param[out] _distance Distance to the waypoint in meters.
+      /// \param[in] _filter Waypoints considered.
+      /// \return True if a waypoint was found or false if there are no
+      /// waypoints matching the filter.
+      public: bool Nearest(const double _latitude,
+                           const double _longitude,
+                           UniqueId &_id,
+                           double &_distance,
+                           const SpatialFilter _filter =
+                             SpatialFilter::ALL) const;
+
+      /// \brief Find all the waypoints within a distance of a location.
+      /// \param[in] _latitude Latitude of the location in degrees.
+      /// \param[in] _longitude Longitude of the location in degrees.
+      /// \param[in] _radius Maximum distance in meters.
+      /// \param[out] _ids Unique Ids of the waypoints found, in no
+      /// particular order. The previous content is removed, but its memory
+      /// is reused, so calling this function repeatedly with the same vector
+      /// doesn't allocate memory.
+      /// \param[in] _filter Waypoints considered.
+      /// \return The number of waypoints found.
+      public: size_t Within(const double _latitude,
+                            const double _longitude,
+                            const double _radius,
+                            std::vector<UniqueId> &_ids,
+                            const SpatialFilter _filter =
+                              SpatialFilter::ALL) const;
+
+      /// \brief Assignment operator.
+      /// \param[in] _other The new index.
+      /// \return A reference to this instance.
+      public: SpatialIndex &operator=(const SpatialIndex &_other);
+
+      /// \internal
+      /// \brief Smart pointer to private data.
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      private: std::unique_ptr<SpatialIndexPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+  }
+}
+#endif
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_STRINGVIEW_HH_
+#define IGNITION_RNDF_STRINGVIEW_HH_
+
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \brief A non-owning reference to a contiguous sequence of characters,
+    /// similar to C++17's std::string_view. The referenced characters are
+    /// not copied, so they must outlive the view.
+    class StringView
+    {
+      /// \brief Default constructor. Creates an empty view.
+      public: StringView() = default;
+
+      /// \brief Constructor.
+      /// \param[in] _data Pointer to the first character.
+      /// \param[in] _size Number of characters.
+      public: StringView(const char *_data, const size_t _size)
+        : data(_data),
+          size(_size)
+      {
+      }
+
+      /// \brief Constructor from a null-terminated string.
+      /// \param[in] _str Null-terminated string.
+      public: StringView(const char *_str)
+        : data(_str),
+          size(std::strlen(_str))
+      {
+      }
+
+      /// \brief Constructor from a std::string.
+      /// \param[in] _str The string to reference.
+      public: StringView(const std::string &_str)
+        : data(_str.data()),
+          size(_str.size())
+      {
+      }
+
+      /// \brief Get a pointer to the first character.
+      /// \return Pointer to the first character.
+      public: const char *Data() const
+      {
+        return this->data;
+      }
+
+      /// \brief Get the number of characters.
+      /// \return The number of characters in the view.
+      public: size_t Size() const
+      {
+        return this->size;
+      }
+
+      /// \brief Whether the view is empty.
+      /// \return True if the view doesn't contain any characters.
+      public: bool Empty() const
+      {
+        return this->size == 0;
+      }
+
+      /// \brief Get an iterator to the first character.
+      /// \return Iterator to the first character.
+      public: const char *begin() const
+      {
+        return this->data;
+      }
+
+      /// \brief Get an iterator past the last character.
+      /// \return Iterator past the last character.
+      public: const char *end() const
+      {
+        return this->data + this->size;
+      }
+
+      /// \brief Access a character. No bounds checking is performed.
+      /// \param[in] _index Position of the character.
+      /// \return The character at position _index.
+      public: char operator[](const size_t _index) const
+      {
+        return this->data[_index];
+      }
+
+      /// \brief Get a view of a substring.
+      /// \param[in] _pos Position of the first character.
+      /// \param[in] _count Maximum number of characters.
+      /// \return The view [_pos, _pos + _count), clamped to this view.
+      public: StringView Substr(const size_t _pos,
+                                const size_t _count = std::string::npos) const
+      {
+        if (_pos >= this->size)
+          return StringView(this->data + this->size, 0);
+
+        size_t count = this->size - _pos;
+        if (_count < count)
+          count = _count;
+        return StringView(this->data + _pos, count);
+      }
+
+      /// \brief Check whether the view starts with a given prefix.
+      /// \param[in] _prefix The prefix.
+      /// \return True if the view starts with _prefix.
+      public: bool StartsWith(const StringView &_prefix) const
+      {
+        return _prefix.size <= this->size &&
+          std::memcmp(this->data, _prefix.data, _prefix.size) == 0;
+      }
+
+      /// \brief Find the first character equal to any of the given ones.
+      /// \param[in] _chars Characters to search for.
+      /// \param[in] _pos Position where the search starts.
+      /// \return Position of the character found or std::string::npos if
+      /// no such character was found.
+      public: size_t FindFirstOf(const StringView &_chars,
+                                 const size_t _pos = 0) const
+      {
+        for (size_t i = _pos; i < this->size; ++i)
+        {
+          if (_chars.size > 0 &&
+              std::memchr(_chars.data, this->data[i], _chars.size))
+            return i;
+        }
+        return std::string::npos;
+      }
+
+      /// \brief Create a std::string with a copy of the referenced
+      /// characters.
+      /// \return A new string.
+      public: std::string String() const
+      {
+        return std::string(this->data, this->size);
+      }
+
+      /// \brief Equality operator.
+      /// \param[in] _lhs First view.
+      /// \param[in] _rhs Second view.
+      /// \return True if both views reference the same sequence of characters.
+      public: friend bool operator==(const StringView &_lhs,
+                                     const StringView &_rhs)
+      {
+        return _lhs.size == _rhs.size &&
+          (_lhs.size == 0 ||
+           std::memcmp(_lhs.data, _rhs.data, _lhs.size) == 0);
+      }
+
+      /// \brief Inequality operator.
+      /// \param[in] _lhs First view.
+      /// \param[in] _rhs Second view.
+      /// \return True if the views reference different character sequences.
+      public: friend bool operator!=(const StringView &_lhs,
+                                     const StringView &_rhs)
+      {
+        return !(_lhs == _rhs);
+      }
+
+      /// \brief Stream insertion operator.
+      /// \param[out] _out The output stream.
+      /// \param[in] _view View to write to the stream.
+      public: friend std::ostream &operator<<(std::ostream &_out,
+                                              const StringView &_view)
+      {
+        _out.write(_view.data, static_cast<std::streamsize>(_view.size));
+        return _out;
+      }
+
+      /// \brief Pointer to the first character.
+      private: const char *data = nullptr;
+
+      /// \brief Number of characters.
+      private: size_t size = 0;
+    };
+  }
+}
+#endif
@@ -18,6 +18,7 @@
 #ifndef IGNITION_RNDF_UNIQUEID_HH_
 #define IGNITION_RNDF_UNIQUEID_HH_
 
+#include <cstdint>
 #include <iostream>
 #include <string>
 
@@ -95,6 +96,19 @@ namespace ignition
       /// \return A string representation of the unique Id.
       public: std::string String() const;
 
+      /// \brief Get a packed integer representation of the unique Id. Two
+      /// unique Ids with values in the allowed range have the same key only
+      /// if they are equal. Unlike String(), this function doesn't allocate
+      /// memory, so it's suitable for hashing and indexing.
+      /// \return The key.
+      /// \sa waypointKey()
+      public: uint64_t Key() const;
+
+      /// \brief Get the unique Id of a packed integer representation.
+      /// \param[in] _key The key, as returned by Key() or waypointKey().
+      /// \return The unique Id.
+      public: static UniqueId FromKey(const uint64_t _key);
+
       /// \brief Equality operator, result = this == _other
       /// \param[in] _other UniqueId to check for equality.
       /// \return true if this == _other
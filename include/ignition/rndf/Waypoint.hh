@@ -18,8 +18,8 @@
 #ifndef IGNITION_WAYPOINT_WAYPOINT_HH_
 #define IGNITION_WAYPOINT_WAYPOINT_HH_
 
+#include <atomic>
 #include <iosfwd>
-#include <memory>
 
 #include <ignition/math/SphericalCoordinates.hh>
 
@@ -30,9 +30,21 @@ namespace ignition
   namespace rndf
   {
     // Forward declarations.
-    class WaypointPrivate;
+    class LineReader;
 
     /// \brief A reference point.
+    ///
+    /// Waypoints are stored by value inside lanes, perimeters and parking
+    /// spots, so their content is kept inline: the Id, the flags and the
+    /// latitude and longitude in degrees. The SphericalCoordinates object
+    /// returned by Location() is only created the first time it's requested.
+    /// It's then kept until the location is set or the waypoint is
+    /// destroyed, so calling Location() on every waypoint of a map brings
+    /// back the memory of a SphericalCoordinates object per waypoint.
+    ///
+    /// On 64-bit platforms a waypoint takes 40 bytes: 8 for the vtable
+    /// pointer, 8 for the Id and the flags, 16 for the latitude and
+    /// longitude and 8 for the SphericalCoordinates pointer.
     class IGNITION_RNDF_VISIBLE Waypoint
     {
       /// \brief Default constructor.
@@ -50,6 +62,21 @@ namespace ignition
       /// \param[in] _other Other waypoint.
       public: Waypoint(const Waypoint &_other);
 
+      /// \brief Constructor.
+      /// \param[in] _id Waypoint Id (a positive number).
+      /// \param[in] _latitude Latitude in decimal degrees.
+      /// \param[in] _longitude Longitude in decimal degrees.
+      /// \sa Valid.
+      public: Waypoint(const int _id,
+                       const double _latitude,
+                       const double _longitude);
+
+      /// \brief Move constructor. The content of _other is transferred
+      /// without copying it.
+      /// \param[in, out] _other Other waypoint. It can only be destroyed or
+      /// assigned to after the move.
+      public: Waypoint(Waypoint &&_other) noexcept;  // NOLINT
+
       /// \brief Destructor.
       public: virtual ~Waypoint();
 
@@ -57,6 +84,19 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a waypoint from a line reader.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _segmentId The segment Id in which the waypoint is located.
+      /// \param[in] _laneId The lane Id in which the waypoint is located.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \return True if a waypoint block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        const int _segmentId,
+                        const int _laneId,
+                        int &_lineNumber);
+
       /// \brief Load a waypoint from an input stream coming from a text file.
       /// The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -90,13 +130,37 @@ namespace ignition
       ////////////
 
       /// \brief Get a non-mutable reference to the waypoint location.
+      /// The SphericalCoordinates object is created on the first call, so
+      /// prefer Latitude() and Longitude() when iterating many waypoints.
+      /// Several threads can call it concurrently: they all get the same
+      /// object, which is never freed before SetLocation() is called or the
+      /// waypoint is destroyed.
       /// \return A non-mutable reference to the waypoint location.
       public: const ignition::math::SphericalCoordinates &Location() const;
 
       /// \brief Get a mutable reference to the waypoint location.
+      /// The SphericalCoordinates object is created on the first call. From
+      /// then on, it's the one that stores the location of the waypoint.
       /// \return A mutable reference to the waypoint location.
       public: ignition::math::SphericalCoordinates &Location();
 
+      /// \brief Get the latitude of the waypoint without creating a
+      /// SphericalCoordinates object.
+      /// \return The latitude in decimal degrees.
+      public: double Latitude() const;
+
+      /// \brief Get the longitude of the waypoint without creating a
+      /// SphericalCoordinates object.
+      /// \return The longitude in decimal degrees.
+      public: double Longitude() const;
+
+      /// \brief Set the location of the waypoint on the WGS84 ellipsoid, with
+      /// zero elevation and heading.
+      /// \param[in] _latitude Latitude in decimal degrees.
+      /// \param[in] _longitude Longitude in decimal degrees.
+      public: void SetLocation(const double _latitude,
+                               const double _longitude);
+
       //////////////
       /// Entry/Exit
       //////////////
@@ -144,15 +208,45 @@ namespace ignition
       /// \return A reference to this instance.
       public: Waypoint &operator=(const Waypoint &_other);
 
-      /// \internal
-      /// \brief Smart pointer to private data.
+      /// \brief Move assignment operator. The content of _other is
+      /// transferred without copying it.
+      /// \param[in, out] _other The new waypoint. It receives the previous
+      /// content of this instance.
+      /// \return A reference to this instance.
+      public: Waypoint &operator=(Waypoint &&_other) noexcept;  // NOLINT
+
+      /// \brief Waypoint identifier.
+      private: int id = -1;
+
+      /// \brief Is the waypoint an entry?
+      private: bool isEntry = false;
+
+      /// \brief Is the waypoint an exit?
+      private: bool isExit = false;
+
+      /// \brief Whether the location might have been modified through the
+      /// mutable Location() accessor. In that case "location" is the source
+      /// of truth instead of "latitude" and "longitude".
+      private: bool locationExposed = false;
+
+      /// \brief Latitude in decimal degrees.
+      private: double latitude = 0.0;
+
+      /// \brief Longitude in decimal degrees.
+      private: double longitude = 0.0;
+
+      /// \brief Location of the waypoint in decimal-degrees, using ITRF00
+      /// reference frame and the GRS80 ellipsoid, or nullptr. Created on
+      /// demand by Location(), possibly by several readers at once, and
+      /// owned by the waypoint.
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
-// std::unique_ptr
+// std::atomic
 #pragma warning(push)
 #pragma warning(disable: 4251)
 #endif
-      private: std::unique_ptr<WaypointPrivate> dataPtr;
+      private: mutable std::atomic<ignition::math::SphericalCoordinates *>
+        location{nullptr};
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
@@ -18,6 +18,7 @@
 #ifndef IGNITION_RNDF_ZONE_HH_
 #define IGNITION_RNDF_ZONE_HH_
 
+#include <cstdint>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -30,8 +31,10 @@ namespace ignition
   namespace rndf
   {
     // Forward declarations.
+    class LineReader;
     class ParkingSpot;
     class Perimeter;
+    class RNDFVisitor;
     class ZoneHeaderPrivate;
     class ZonePrivate;
 
@@ -49,6 +52,15 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a zone header from a line reader. The expected format
+      /// is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \return True if a zone header block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        int &_lineNumber);
+
       /// \brief Load a zone header from an input stream coming from a
       /// text file. The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
@@ -97,6 +109,12 @@ namespace ignition
       /// \sa Valid.
       public: Zone(const Zone &_other);
 
+      /// \brief Move constructor. The content of _other is transferred
+      /// without copying it.
+      /// \param[in, out] _other Other zone. It can only be destroyed or
+      /// assigned to after the move.
+      public: Zone(Zone &&_other) noexcept;  // NOLINT
+
       /// \brief Destructor.
       public: virtual ~Zone();
 
@@ -104,12 +122,54 @@ namespace ignition
       /// Parsing
       ///////////
 
+      /// \brief Load a zone from a line reader.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Keys of the waypoints parsed.
+      /// \return True if a zone block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(LineReader &_reader,
+                        int &_lineNumber,
+                        std::vector<ExitCacheEntry> &_exitCache,
+                        std::vector<uint64_t> &_waypointCache);
+
+      /// \brief Parse a zone from a line reader and report its elements to
+      /// a visitor, without storing them.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _visitor Visitor that receives the zone elements.
+      /// \param[out] _zoneId Id of the zone parsed.
+      /// \return True if a zone block was found and parsed or false
+      /// otherwise (e.g.: EoF or incorrect format found).
+      public: static bool Parse(LineReader &_reader,
+                                int &_lineNumber,
+                                RNDFVisitor &_visitor,
+                                int &_zoneId);
+
       /// \brief Load a zone from an input stream coming from a text file.
       /// The expected format is the one specified on the RNDF spec.
       /// \param[in, out] _rndfFile Input file stream.
       /// \param[in, out] _lineNumber Line number pointed by the stream position
       /// indicator.
       /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Keys of the waypoints parsed.
+      /// \return True if a zone block was found and parsed or
+      /// false otherwise (e.g.: EoF or incorrect format found).
+      public: bool Load(std::ifstream &_rndfFile,
+                        int &_lineNumber,
+                        std::vector<ExitCacheEntry> &_exitCache,
+                        std::vector<uint64_t> &_waypointCache);
+
+      /// \brief Load a zone from an input stream coming from a text file.
+      /// The expected format is the one specified on the RNDF spec.
+      /// \deprecated Use the overload that caches the waypoint keys.
+      /// \param[in, out] _rndfFile Input file stream.
+      /// \param[in, out] _lineNumber Line number pointed by the stream position
+      /// indicator.
+      /// \param[in, out] _exitCache Cache of exits parsed.
       /// \param[in, out] _waypointCache Cache of waypoints parsed.
       /// \return True if a zone block was found and parsed or
       /// false otherwise (e.g.: EoF or incorrect format found).
@@ -118,6 +178,12 @@ namespace ignition
                         std::vector<ExitCacheEntry> &_exitCache,
                         std::vector<std::string> &_waypointCache);
 
+      /// \brief Write the zone as text, in the format read by Load().
+      /// \param[in, out] _stream Output stream.
+      /// \return True if the zone was written or false otherwise
+      /// (e.g.: the stream is in a bad state).
+      public: bool Save(std::ostream &_stream) const;
+
       ///////
       /// Id
       ///////
@@ -155,6 +221,18 @@ namespace ignition
       public: bool Spot(const int _psId,
                         ParkingSpot &_ps) const;
 
+      /// \brief Get the parking spot with Id _psId without copying it.
+      /// \param[in] _psId The parking spot Id.
+      /// \return Pointer to the parking spot, or nullptr if not found. It is
+      /// valid until the vector of spots changes.
+      public: const ParkingSpot *Spot(const int _psId) const;
+
+      /// \brief Get the parking spot with Id _psId to edit it in place.
+      /// \param[in] _psId The parking spot Id.
+      /// \return Pointer to the parking spot, or nullptr if not found. It is
+      /// valid until the vector of spots changes.
+      public: ParkingSpot *Spot(const int _psId);
+
       /// \brief Update an existing parking spot.
       /// \param[in] _ps The updated parking spot.
       /// \return True if the spot was found and updated or false otherwise.
@@ -225,6 +303,13 @@ namespace ignition
       /// \return A reference to this instance.
       public: Zone &operator=(const Zone &_other);
 
+      /// \brief Move assignment operator. The content of _other is
+      /// transferred without copying it.
+      /// \param[in, out] _other The new zone. It receives the previous
+      /// content of this instance.
+      /// \return A reference to this instance.
+      public: Zone &operator=(Zone &&_other) noexcept;  // NOLINT
+
       /// \internal
       /// \brief Smart pointer to private data.
 #ifdef _WIN32
@@ -0,0 +1,307 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "ignition/rndf/Arena.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief A block of memory of an arena.
+    class ArenaChunk
+    {
+      /// \brief Alignment of the memory.
+      public: static const size_t kAlignment = 16;
+
+      /// \brief Constructor.
+      /// \param[in] _size Size of the chunk in bytes.
+      public: explicit ArenaChunk(const size_t _size)
+        : memory(new char[_size + kAlignment]), size(_size)
+      {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(
+          this->memory.get());
+        this->data = this->memory.get() +
+          (kAlignment - address % kAlignment) % kAlignment;
+      }
+
+      /// \brief The memory allocated.
+      public: std::unique_ptr<char[]> memory;
+
+      /// \brief The memory aligned to kAlignment.
+      public: char *data;
+
+      /// \brief Size of the memory in bytes.
+      public: const size_t size;
+
+      /// \brief Bytes handed out. It may go past "size" when several
+      /// threads race for the end of the chunk; those bytes are not used.
+      public: std::atomic<size_t> used{0};
+    };
+
+    /// \internal
+    /// \brief Private data for Arena class.
+    class ArenaPrivate
+    {
+      /// \brief Alignment of every block handed out.
+      public: static const size_t kAlignment = ArenaChunk::kAlignment;
+
+      /// \brief Size of the first chunk in bytes.
+      public: static const size_t kFirstChunk = 64 * 1024;
+
+      /// \brief Maximum size of a chunk in bytes. The chunks double in size
+      /// until they reach it.
+      public: static const size_t kMaxChunk = 4 * 1024 * 1024;
+
+      /// \brief Arena active in the current thread, or nullptr.
+      public: static thread_local ArenaPrivate *current;
+
+      /// \brief Allocate memory for an object. The arena is kept alive until
+      /// the memory is released. Threads bump the offset of the current
+      /// chunk without locking; the mutex is only taken to add a chunk.
+      /// \param[in] _size Size of the object.
+      /// \return The memory, aligned to kAlignment.
+      public: void *Allocate(const size_t _size)
+      {
+        const size_t size = (_size + kAlignment - 1) / kAlignment * kAlignment;
+        ArenaChunk *chunk = this->currentChunk.load(std::memory_order_acquire);
+        while (true)
+        {
+          if (chunk)
+          {
+            const size_t offset =
+              chunk->used.fetch_add(size, std::memory_order_relaxed);
+            if (offset + size <= chunk->size)
+            {
+              ++this->objects;
+              ++this->references;
+              return chunk->data + offset;
+            }
+          }
+          chunk = this->AddChunk(chunk, size);
+        }
+      }
+
+      /// \brief Add a chunk when the current one is full, unless another
+      /// thread did it already.
+      /// \param[in] _full The chunk found full, or nullptr.
+      /// \param[in] _size Size of the allocation that didn't fit.
+      /// \return The current chunk.
+      public: ArenaChunk *AddChunk(ArenaChunk *_full, const size_t _size)
+      {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        ArenaChunk *chunk = this->currentChunk.load(std::memory_order_relaxed);
+        if (chunk != _full)
+          return chunk;
+
+        if (this->chunks.empty())
+          this->chunkSize = kFirstChunk;
+        else if (this->chunkSize < kMaxChunk)
+          this->chunkSize *= 2;
+        this->chunks.emplace_back(
+          new ArenaChunk(std::max(this->chunkSize, _size)));
+        chunk = this->chunks.back().get();
+        this->capacity += chunk->size;
+        this->currentChunk.store(chunk, std::memory_order_release);
+        return chunk;
+      }
+
+      /// \brief Release the memory of an object.
+      public: void Deallocate()
+      {
+        --this->objects;
+        this->Release();
+      }
+
+      /// \brief Drop a reference to the arena, and destroy it with all its
+      /// chunks when it was the last one.
+      public: void Release()
+      {
+        if (--this->references == 0)
+          delete this;
+      }
+
+      /// \brief Protects the list of chunks and its statistics.
+      public: std::mutex mutex;
+
+      /// \brief The chunks.
+      public: std::vector<std::unique_ptr<ArenaChunk>> chunks;
+
+      /// \brief The chunk where objects are allocated.
+      public: std::atomic<ArenaChunk *> currentChunk{nullptr};
+
+      /// \brief Size of the last chunk before rounding it up to the
+      /// allocation that required it.
+      public: size_t chunkSize = 0;
+
+      /// \brief Total size of the chunks.
+      public: size_t capacity = 0;
+
+      /// \brief Number of objects allocated and not released.
+      public: std::atomic<size_t> objects{0};
+
+      /// \brief References held by the Arena instance and by the objects.
+      public: std::atomic<size_t> references{1};
+    };
+
+    /// \internal
+    /// \brief Layout of the memory of the ArenaObjects. Objects on the heap
+    /// are plain allocations, aligned to kAlignment by ::operator new().
+    /// Objects in an arena are placed kHeaderSize bytes past a multiple of
+    /// kAlignment, which is how operator delete() tells them apart, and the
+    /// header in front of them stores their arena. The private data of the
+    /// elements doesn't need more than kHeaderSize alignment.
+    class ArenaObjectHeader
+    {
+      /// \brief Alignment of the blocks.
+      public: static const size_t kAlignment = ArenaPrivate::kAlignment;
+
+      /// \brief Size of the header of the objects in an arena.
+      public: static const size_t kHeaderSize = kAlignment / 2;
+
+      /// \brief Whether an object has a header.
+      /// \param[in] _ptr Memory of the object.
+      /// \return True if there's a header in front of the object.
+      public: static bool HasHeader(const void *_ptr)
+      {
+        return reinterpret_cast<uintptr_t>(_ptr) % kAlignment == kHeaderSize;
+      }
+
+      /// \brief Get the header in front of an object. It's either the
+      /// address of its arena or, for the rare heap objects that need a
+      /// header (see ArenaObject::operator new()), the address of their heap
+      /// block with the lowest bit set.
+      /// \param[in] _ptr Memory of the object.
+      /// \return The header.
+      public: static uintptr_t &Header(void *_ptr)
+      {
+        return *reinterpret_cast<uintptr_t *>(
+          static_cast<char *>(_ptr) - kHeaderSize);
+      }
+    };
+
+    static_assert(sizeof(uintptr_t) <= ArenaObjectHeader::kHeaderSize,
+      "The header must fit a pointer");
+  }
+}
+
+//////////////////////////////////////////////////
+thread_local ArenaPrivate *ArenaPrivate::current = nullptr;
+
+//////////////////////////////////////////////////
+Arena::Scope::Scope(Arena *_arena)
+  : previous(ArenaPrivate::current)
+{
+  ArenaPrivate::current = _arena ? _arena->dataPtr : nullptr;
+}
+
+//////////////////////////////////////////////////
+Arena::Scope::~Scope()
+{
+  ArenaPrivate::current = this->previous;
+}
+
+//////////////////////////////////////////////////
+Arena::Arena()
+  : dataPtr(new ArenaPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+Arena::~Arena()
+{
+  this->dataPtr->Release();
+}
+
+//////////////////////////////////////////////////
+size_t Arena::NumChunks() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->chunks.size();
+}
+
+//////////////////////////////////////////////////
+size_t Arena::Capacity() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->capacity;
+}
+
+//////////////////////////////////////////////////
+size_t Arena::NumObjects() const
+{
+  return this->dataPtr->objects;
+}
+
+//////////////////////////////////////////////////
+void *ArenaObject::operator new(std::size_t _size)
+{
+  const size_t kHeaderSize = ArenaObjectHeader::kHeaderSize;
+  ArenaPrivate *arena = ArenaPrivate::current;
+  if (arena)
+  {
+    char *ptr = static_cast<char *>(arena->Allocate(kHeaderSize + _size)) +
+      kHeaderSize;
+    ArenaObjectHeader::Header(ptr) = reinterpret_cast<uintptr_t>(arena);
+    return ptr;
+  }
+
+  void *ptr = ::operator new(_size);
+  if (!ArenaObjectHeader::HasHeader(ptr))
+    return ptr;
+
+  // The heap didn't align the memory to kAlignment, so the object would be
+  // taken for one in an arena. Give it a header pointing to its block.
+  ::operator delete(ptr);
+  char *block = static_cast<char *>(
+    ::operator new(ArenaObjectHeader::kAlignment + _size));
+  ptr = block + (ArenaObjectHeader::HasHeader(block) ?
+    ArenaObjectHeader::kAlignment : kHeaderSize);
+  ArenaObjectHeader::Header(ptr) = reinterpret_cast<uintptr_t>(block) | 1;
+  return ptr;
+}
+
+//////////////////////////////////////////////////
+void ArenaObject::operator delete(void *_ptr) noexcept
+{
+  if (!_ptr)
+    return;
+
+  if (!ArenaObjectHeader::HasHeader(_ptr))
+  {
+    ::operator delete(_ptr);
+    return;
+  }
+
+  const uintptr_t header = ArenaObjectHeader::Header(_ptr);
+  if (header & 1)
+    ::operator delete(reinterpret_cast<void *>(header & ~uintptr_t(1)));
+  else
+    reinterpret_cast<ArenaPrivate *>(header)->Deallocate();
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Arena.hh"
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFNode.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+//////////////////////////////////////////////////
+/// \brief Check that only the objects created in a scope use the arena.
+TEST(Arena, scope)
+{
+  Arena arena;
+  EXPECT_EQ(arena.NumChunks(), 0u);
+  EXPECT_EQ(arena.Capacity(), 0u);
+  EXPECT_EQ(arena.NumObjects(), 0u);
+
+  std::vector<Lane> lanes;
+  {
+    Arena::Scope scope(&arena);
+    for (int i = 1; i <= 100; ++i)
+      lanes.emplace_back(i);
+
+    // Nested scopes restore the previous arena.
+    {
+      Arena::Scope heap(nullptr);
+      Checkpoint checkpoint(1, 1);
+      EXPECT_EQ(checkpoint.CheckpointId(), 1);
+    }
+    Checkpoint checkpoint(1, 1);
+    EXPECT_EQ(checkpoint.CheckpointId(), 1);
+  }
+
+  // The private data of every lane and of its header. The checkpoint
+  // allocated in the arena was released when destroyed.
+  EXPECT_EQ(arena.NumObjects(), 200u);
+  EXPECT_EQ(arena.NumChunks(), 1u);
+  EXPECT_GT(arena.Capacity(), 0u);
+
+  Lane copy(lanes.front());
+  EXPECT_EQ(arena.NumObjects(), 200u);
+
+  lanes.pop_back();
+  EXPECT_EQ(arena.NumObjects(), 198u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the objects can outlive their arena.
+TEST(Arena, outlive)
+{
+  std::vector<Lane> lanes;
+  {
+    Arena arena;
+    Arena::Scope scope(&arena);
+    for (int i = 1; i <= 10000; ++i)
+      lanes.emplace_back(i);
+    EXPECT_GT(arena.NumChunks(), 1u);
+  }
+
+  for (size_t i = 0; i < lanes.size(); ++i)
+  {
+    EXPECT_EQ(lanes[i].Id(), static_cast<int>(i + 1));
+    EXPECT_TRUE(lanes[i].SetWidth(3.5));
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that several threads can allocate in the same arena.
+TEST(Arena, concurrent)
+{
+  const int kNumThreads = 4;
+  const int kNumLanes = 5000;
+  Arena arena;
+  std::vector<std::vector<Lane>> lanes(kNumThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t)
+  {
+    threads.emplace_back([&arena, &lanes, t]()
+    {
+      Arena::Scope scope(&arena);
+      for (int i = 1; i <= kNumLanes; ++i)
+        lanes[t].emplace_back(i);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  // The private data of every lane and of its header.
+  EXPECT_EQ(arena.NumObjects(), 2u * kNumThreads * kNumLanes);
+  EXPECT_GT(arena.NumChunks(), 1u);
+  for (auto const &threadLanes : lanes)
+  {
+    ASSERT_EQ(threadLanes.size(), static_cast<size_t>(kNumLanes));
+    for (int i = 0; i < kNumLanes; ++i)
+      EXPECT_EQ(threadLanes[i].Id(), i + 1);
+  }
+
+  lanes.clear();
+  EXPECT_EQ(arena.NumObjects(), 0u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check loading a RNDF in an arena.
+TEST(Arena, rndf)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  const std::string filePath = dirPath + "/test/rndf/sample1.rndf";
+  RNDF expected(filePath);
+  ASSERT_TRUE(expected.Valid());
+  EXPECT_EQ(expected.Arena(), nullptr);
+
+  for (auto const numThreads : {1u, 4u})
+  {
+    std::unique_ptr<RNDF> rndf(new RNDF());
+    EXPECT_FALSE(rndf->ArenaEnabled());
+    rndf->SetArenaEnabled(true);
+    EXPECT_TRUE(rndf->ArenaEnabled());
+    ASSERT_TRUE(rndf->Load(filePath, numThreads));
+    ASSERT_TRUE(rndf->Arena() != nullptr);
+    EXPECT_GT(rndf->Arena()->NumObjects(), 0u);
+    EXPECT_LE(rndf->Arena()->NumChunks(), 2u);
+
+    const RNDF &constRndf = *rndf;
+    ASSERT_EQ(constRndf.NumSegments(), expected.NumSegments());
+    ASSERT_EQ(constRndf.NumZones(), expected.NumZones());
+    for (size_t i = 0; i < expected.NumSegments(); ++i)
+    {
+      const Segment &segment = constRndf.Segments()[i];
+      const Segment &expectedSegment = expected.Segments()[i];
+      ASSERT_EQ(segment.NumLanes(), expectedSegment.NumLanes());
+      for (size_t j = 0; j < segment.NumLanes(); ++j)
+      {
+        EXPECT_EQ(segment.Lanes()[j].Waypoints(),
+          expectedSegment.Lanes()[j].Waypoints());
+      }
+    }
+    RNDFNode *node = rndf->Info(UniqueId(1, 1, 1));
+    ASSERT_TRUE(node != nullptr);
+    EXPECT_EQ(node->Waypoint()->Id(), 1);
+
+    // Copies use the heap.
+    const size_t numObjects = rndf->Arena()->NumObjects();
+    Segment copy(constRndf.Segments().front());
+    EXPECT_EQ(rndf->Arena()->NumObjects(), numObjects);
+
+    // A segment moved out of the RNDF outlives it.
+    Segment moved(std::move(rndf->Segments().front()));
+    rndf.reset();
+    EXPECT_EQ(moved, copy);
+    EXPECT_EQ(moved.Lanes().size(), copy.Lanes().size());
+    EXPECT_EQ(moved.Lanes().front().Waypoints(),
+      copy.Lanes().front().Waypoints());
+  }
+
+  // Reloading replaces the arena, and disabling it uses the heap again.
+  RNDF rndf;
+  rndf.SetArenaEnabled(true);
+  ASSERT_TRUE(rndf.Load(filePath));
+  ASSERT_TRUE(rndf.Load(filePath));
+  ASSERT_TRUE(rndf.Arena() != nullptr);
+  EXPECT_GT(rndf.Arena()->NumObjects(), 0u);
+  rndf.SetArenaEnabled(false);
+  ASSERT_TRUE(rndf.Load(filePath));
+  EXPECT_EQ(rndf.Arena(), nullptr);
+  EXPECT_TRUE(rndf.Valid());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,6 +16,7 @@
 */
 
 #include <iostream>
+#include "ignition/rndf/Arena.hh"
 #include "ignition/rndf/Checkpoint.hh"
 
 using namespace ignition;
@@ -27,7 +28,7 @@ namespace ignition
   {
     /// \internal
     /// \brief Private data for Checkpoint class.
-    class CheckpointPrivate
+    class CheckpointPrivate : public ArenaObject
     {
       /// \brief Constructor.
       /// \param[in] _checkpointId Checkpoint Id.
@@ -0,0 +1,1133 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/ContractionHierarchy.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFCache.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/StringView.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Header of a contraction hierarchy file. It's followed by the
+    /// keys of the nodes, the offsets, targets and weights of the upward
+    /// edges, and the offsets, targets and weights of the downward edges.
+    struct ContractionHeader
+    {
+      /// \brief Magic string.
+      public: char magic[8];
+
+      /// \brief Format version.
+      public: uint32_t version;
+
+      /// \brief Byte order mark.
+      public: uint32_t byteOrder;
+
+      /// \brief Hash of the graph the hierarchy was built from.
+      public: uint64_t graphHash;
+
+      /// \brief Number of nodes.
+      public: uint32_t numNodes;
+
+      /// \brief Number of upward edges.
+      public: uint32_t numUpEdges;
+
+      /// \brief Number of downward edges.
+      public: uint32_t numDownEdges;
+
+      /// \brief Unused, always 0.
+      public: uint32_t reserved;
+    };
+
+    /// \internal
+    /// \brief An edge of the graph being contracted.
+    struct ContractionEdge
+    {
+      /// \brief The node at the other end of the edge.
+      public: uint32_t node;
+
+      /// \brief Length of the edge in meters.
+      public: double weight;
+
+      /// \brief Number of edges of the original graph it replaces.
+      public: uint32_t hops;
+    };
+
+    /// \internal
+    /// \brief An entry of the queue of nodes to contract.
+    struct ContractionQueueEntry
+    {
+      /// \brief Compare the priorities of two entries.
+      /// \param[in] _other The other entry.
+      /// \return True if this entry is contracted after the other.
+      public: bool operator>(const ContractionQueueEntry &_other) const
+      {
+        return this->priority > _other.priority ||
+          (!(this->priority < _other.priority) && this->node > _other.node);
+      }
+
+      /// \brief Priority of the node, lower is contracted first.
+      public: double priority;
+
+      /// \brief The node.
+      public: uint32_t node;
+    };
+
+    /// \internal
+    /// \brief An entry of the bucket of a node in a many-to-many query:
+    /// the distance from the node to a target.
+    struct ContractionBucketEntry
+    {
+      /// \brief The node.
+      public: uint32_t node;
+
+      /// \brief Position of the target.
+      public: uint32_t target;
+
+      /// \brief Distance from the node to the target in meters.
+      public: double distance;
+    };
+
+    /// \internal
+    /// \brief Private data for ContractionHierarchy class.
+    /// An edge between two nodes belongs to the less important one. The
+    /// upward edges of a node go to more important nodes and are followed
+    /// by the searches from the sources. The downward edges of a node come
+    /// from more important nodes and are followed backwards by the searches
+    /// from the targets.
+    class ContractionHierarchyPrivate
+    {
+      /// \brief Maximum number of nodes settled by a witness search when
+      /// contracting a node.
+      public: static const size_t kMaxWitnessSettled = 100;
+
+      /// \brief Maximum number of nodes settled by a witness search when
+      /// estimating the priority of a node.
+      public: static const size_t kMaxEstimateSettled = 10;
+
+      /// \brief File format version.
+      public: static const uint32_t kVersion = 1;
+
+      /// \brief File byte order mark.
+      public: static const uint32_t kByteOrder = 0x01020304;
+
+      /// \brief An entry of a priority queue: a cost and a node.
+      public: using Entry = std::pair<double, uint32_t>;
+
+      /// \brief Get the magic string of the files.
+      /// \return Eight characters.
+      public: static const char *Magic()
+      {
+        return "RNDFCH\0";
+      }
+
+      /// \brief Compute the hash of the nodes and edges of a graph.
+      /// \param[in] _graph The graph.
+      /// \return The hash, 0 for an empty graph.
+      public: static uint64_t GraphHash(const RoadGraph &_graph)
+      {
+        if (_graph.NumNodes() == 0)
+          return 0;
+
+        const uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+        uint64_t hash = _graph.NumNodes();
+        auto mix = [&](const void *_data, const size_t _bytes)
+        {
+          hash = (hash ^ RNDFCache::Hash(StringView(
+            static_cast<const char *>(_data), _bytes))) * kMultiplier;
+        };
+        mix(_graph.Keys().data(), _graph.Keys().size() * sizeof(uint64_t));
+        mix(_graph.Offsets().data(),
+          _graph.Offsets().size() * sizeof(uint32_t));
+        mix(_graph.Targets().data(),
+          _graph.Targets().size() * sizeof(uint32_t));
+        mix(_graph.Lengths().data(), _graph.Lengths().size() * sizeof(double));
+        return hash;
+      }
+
+      /// \brief Copy a table from a file.
+      /// \param[in,out] _cursor Position of the table in the file, moved
+      /// past its end.
+      /// \param[in] _count Number of values of the table.
+      /// \param[out] _values The values.
+      public: template<typename T>
+              static void Read(const char *&_cursor, const size_t _count,
+                               std::vector<T> &_values)
+      {
+        _values.resize(_count);
+        if (_count > 0)
+          std::memcpy(&_values[0], _cursor, _count * sizeof(T));
+        _cursor += _count * sizeof(T);
+      }
+
+      /// \brief Find the node of a waypoint.
+      /// \param[in] _id Unique Id of the waypoint.
+      /// \param[out] _node The node.
+      /// \return True if the waypoint was found.
+      public: bool Find(const UniqueId &_id, uint32_t &_node) const
+      {
+        const uint64_t key = _id.Key();
+        auto it = std::lower_bound(this->lookup.begin(), this->lookup.end(),
+          std::make_pair(key, static_cast<uint32_t>(0)));
+        if (it == this->lookup.end() || it->first != key)
+          return false;
+
+        _node = it->second;
+        return true;
+      }
+
+      /// \brief Rebuild the lookup table and the query state after the
+      /// nodes change.
+      public: void Prepare()
+      {
+        const uint32_t numNodes = static_cast<uint32_t>(this->keys.size());
+        this->lookup.resize(numNodes);
+        for (uint32_t i = 0; i < numNodes; ++i)
+          this->lookup[i] = std::make_pair(this->keys[i], i);
+        std::sort(this->lookup.begin(), this->lookup.end());
+
+        this->stamp = 0;
+        this->stamps.assign(numNodes, 0);
+        this->bucketStamp = 0;
+        this->distances.resize(numNodes);
+        this->bucketStamps.assign(numNodes, 0);
+        this->bucketFirst.resize(numNodes);
+      }
+
+      /// \brief Remove all the nodes and edges.
+      public: void Clear()
+      {
+        this->graphHash = 0;
+        this->keys.clear();
+        this->upOffsets.assign(1, 0);
+        this->upTargets.clear();
+        this->upWeights.clear();
+        this->downOffsets.assign(1, 0);
+        this->downTargets.clear();
+        this->downWeights.clear();
+        this->Prepare();
+      }
+
+      /// \brief Start a new search.
+      public: void NextStamp()
+      {
+        this->stamp += 2;
+        if (this->stamp < 2)
+        {
+          // The stamps wrapped around.
+          std::fill(this->stamps.begin(), this->stamps.end(), 0);
+          this->stamp = 2;
+        }
+      }
+
+      /// \brief Settle all the nodes reachable from a node following the
+      /// upward or the downward edges. A node is stalled, and its edges
+      /// aren't followed, if a more important node already reached gives a
+      /// shorter distance to it through an edge in the other direction.
+      /// \param[in] _start The node.
+      /// \param[in] _upward True to follow the upward edges, or false to
+      /// follow the downward edges backwards.
+      /// \param[out] _settled The nodes settled and not stalled, and their
+      /// distances.
+      public: void Search(const uint32_t _start, const bool _upward,
+                          std::vector<Entry> &_settled)
+      {
+        const std::vector<uint32_t> &offsets =
+          _upward ? this->upOffsets : this->downOffsets;
+        const std::vector<uint32_t> &targets =
+          _upward ? this->upTargets : this->downTargets;
+        const std::vector<double> &weights =
+          _upward ? this->upWeights : this->downWeights;
+        const std::vector<uint32_t> &stallOffsets =
+          _upward ? this->downOffsets : this->upOffsets;
+        const std::vector<uint32_t> &stallTargets =
+          _upward ? this->downTargets : this->upTargets;
+        const std::vector<double> &stallWeights =
+          _upward ? this->downWeights : this->upWeights;
+
+        this->NextStamp();
+        const uint32_t reached = this->stamp;
+        const uint32_t settled = this->stamp + 1;
+        std::greater<Entry> order;
+        std::vector<Entry> &heap = this->queue;
+        heap.clear();
+        _settled.clear();
+
+        this->stamps[_start] = reached;
+        this->distances[_start] = 0;
+        heap.emplace_back(0, _start);
+        while (!heap.empty())
+        {
+          const Entry entry = heap.front();
+          std::pop_heap(heap.begin(), heap.end(), order);
+          heap.pop_back();
+          if (this->stamps[entry.second] == settled)
+            continue;
+          this->stamps[entry.second] = settled;
+
+          bool stalled = false;
+          for (uint32_t e = stallOffsets[entry.second];
+               !stalled && e < stallOffsets[entry.second + 1]; ++e)
+          {
+            const uint32_t other = stallTargets[e];
+            stalled = this->stamps[other] >= reached &&
+              this->distances[other] + stallWeights[e] < entry.first;
+          }
+          if (stalled)
+            continue;
+          _settled.push_back(entry);
+
+          for (uint32_t e = offsets[entry.second];
+               e < offsets[entry.second + 1]; ++e)
+          {
+            const uint32_t target = targets[e];
+            const double distance = entry.first + weights[e];
+            const uint32_t targetStamp = this->stamps[target];
+            if (targetStamp == settled)
+              continue;
+            if (targetStamp != reached || distance < this->distances[target])
+            {
+              this->stamps[target] = reached;
+              this->distances[target] = distance;
+              heap.emplace_back(distance, target);
+              std::push_heap(heap.begin(), heap.end(), order);
+            }
+          }
+        }
+      }
+
+      /// \brief Compute the distances between nodes.
+      /// \param[in] _sources The first nodes.
+      /// \param[in] _targets The last nodes.
+      /// \param[out] _distances Row-major matrix of distances.
+      public: void Distances(const std::vector<uint32_t> &_sources,
+                             const std::vector<uint32_t> &_targets,
+                             std::vector<double> &_distances)
+      {
+        _distances.assign(_sources.size() * _targets.size(),
+          std::numeric_limits<double>::infinity());
+        if (_distances.empty())
+          return;
+
+        // The buckets of the nodes reached backwards from every target.
+        this->buckets.clear();
+        for (size_t t = 0; t < _targets.size(); ++t)
+        {
+          this->Search(_targets[t], false, this->settledNodes);
+          for (auto const &entry : this->settledNodes)
+          {
+            this->buckets.push_back({entry.second,
+              static_cast<uint32_t>(t), entry.first});
+          }
+        }
+        std::sort(this->buckets.begin(), this->buckets.end(),
+          [](const ContractionBucketEntry &_a,
+             const ContractionBucketEntry &_b)
+          {
+            return _a.node < _b.node;
+          });
+
+        if (++this->bucketStamp == 0)
+        {
+          std::fill(this->bucketStamps.begin(), this->bucketStamps.end(), 0);
+          this->bucketStamp = 1;
+        }
+        const uint32_t current = this->bucketStamp;
+        for (size_t i = 0; i < this->buckets.size(); ++i)
+        {
+          const uint32_t node = this->buckets[i].node;
+          if (this->bucketStamps[node] != current)
+          {
+            this->bucketStamps[node] = current;
+            this->bucketFirst[node] = static_cast<uint32_t>(i);
+          }
+        }
+
+        // The shortest route from a source to a target goes through the
+        // most important node of the route, reached upwards from both.
+        for (size_t s = 0; s < _sources.size(); ++s)
+        {
+          double *row = &_distances[s * _targets.size()];
+          this->Search(_sources[s], true, this->settledNodes);
+          for (auto const &entry : this->settledNodes)
+          {
+            if (this->bucketStamps[entry.second] != current)
+              continue;
+
+            for (size_t b = this->bucketFirst[entry.second];
+                 b < this->buckets.size() &&
+                 this->buckets[b].node == entry.second; ++b)
+            {
+              const ContractionBucketEntry &bucket = this->buckets[b];
+              row[bucket.target] = std::min(row[bucket.target],
+                entry.first + bucket.distance);
+            }
+          }
+        }
+      }
+
+      /// \brief Contract the nodes of a graph.
+      /// \param[in] _graph The graph.
+      public: void Build(const RoadGraph &_graph);
+
+      /// \brief Find the shortest distances from a node to its neighbors in
+      /// the graph being contracted, without going through a node.
+      /// \param[in] _source The node.
+      /// \param[in] _skip The node to avoid.
+      /// \param[in] _maxDistance Distance beyond which nodes aren't needed.
+      /// \param[in] _maxSettled Maximum number of nodes to settle.
+      /// \param[in] _numTargets Number of neighbors marked with the current
+      /// target stamp. The search stops when all of them are settled.
+      public: void Witness(const uint32_t _source, const uint32_t _skip,
+                           const double _maxDistance,
+                           const size_t _maxSettled,
+                           const size_t _numTargets);
+
+      /// \brief Get the distance found by the last witness search.
+      /// \param[in] _node The node.
+      /// \return The distance, or infinity if the node wasn't reached.
+      public: double WitnessDistance(const uint32_t _node) const
+      {
+        return this->stamps[_node] >= this->stamp ?
+          this->distances[_node] : std::numeric_limits<double>::infinity();
+      }
+
+      /// \brief Count or add the shortcuts needed to contract a node.
+      /// \param[in] _node The node.
+      /// \param[in] _add True to add the shortcuts, false to estimate them.
+      /// \param[out] _hops Number of original edges the shortcuts replace.
+      /// \return The number of shortcuts.
+      public: size_t Shortcuts(const uint32_t _node, const bool _add,
+                               size_t &_hops);
+
+      /// \brief Compute the priority of a node from the shortcuts needed to
+      /// contract it.
+      /// \param[in] _node The node.
+      /// \param[in] _depth Length of the longest chain of contracted nodes
+      /// below the node.
+      /// \return The priority.
+      public: double Priority(const uint32_t _node, const uint32_t _depth);
+
+      /// \brief Add an edge to the graph being contracted, or shorten an
+      /// existing one.
+      /// \param[in] _from Source node.
+      /// \param[in] _to Target node.
+      /// \param[in] _weight Length of the edge.
+      /// \param[in] _hops Number of original edges it replaces.
+      public: void AddEdge(const uint32_t _from, const uint32_t _to,
+                           const double _weight, const uint32_t _hops);
+
+      /// \brief Hash of the graph the hierarchy was built from.
+      public: uint64_t graphHash = 0;
+
+      /// \brief Unique Id keys of the nodes.
+      public: std::vector<uint64_t> keys;
+
+      /// \brief Position of the first upward edge of every node.
+      public: std::vector<uint32_t> upOffsets = {0};
+
+      /// \brief Target of every upward edge.
+      public: std::vector<uint32_t> upTargets;
+
+      /// \brief Length of every upward edge.
+      public: std::vector<double> upWeights;
+
+      /// \brief Position of the first downward edge of every node.
+      public: std::vector<uint32_t> downOffsets = {0};
+
+      /// \brief Source of every downward edge.
+      public: std::vector<uint32_t> downTargets;
+
+      /// \brief Length of every downward edge.
+      public: std::vector<double> downWeights;
+
+      /// \brief (key, node) pairs sorted by key, to find nodes by Id.
+      public: std::vector<std::pair<uint64_t, uint32_t>> lookup;
+
+      /// \brief Stamp of the current search. A node is reached if its stamp
+      /// is "stamp" and settled if it's "stamp" + 1.
+      public: uint32_t stamp = 0;
+
+      /// \brief Stamp of every node.
+      public: std::vector<uint32_t> stamps;
+
+      /// \brief Distance to every node reached.
+      public: std::vector<double> distances;
+
+      /// \brief Priority queue of the current search.
+      public: std::vector<Entry> queue;
+
+      /// \brief Nodes settled by the last search.
+      public: std::vector<Entry> settledNodes;
+
+      /// \brief Bucket entries of a many-to-many query, sorted by node.
+      public: std::vector<ContractionBucketEntry> buckets;
+
+      /// \brief Stamp of the current many-to-many query.
+      public: uint32_t bucketStamp = 0;
+
+      /// \brief Stamp of the nodes with a bucket in the current query.
+      public: std::vector<uint32_t> bucketStamps;
+
+      /// \brief Position of the first bucket entry of every node.
+      public: std::vector<uint32_t> bucketFirst;
+
+      /// \brief Stamp of the neighbors a witness search looks for.
+      public: uint32_t witnessTarget = 0;
+
+      /// \brief Target stamp of every node.
+      public: std::vector<uint32_t> witnessTargets;
+
+      /// \brief Outgoing edges of the graph being contracted.
+      public: std::vector<std::vector<ContractionEdge>> out;
+
+      /// \brief Incoming edges of the graph being contracted.
+      public: std::vector<std::vector<ContractionEdge>> in;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+void ContractionHierarchyPrivate::Witness(const uint32_t _source,
+  const uint32_t _skip, const double _maxDistance, const size_t _maxSettled,
+  const size_t _numTargets)
+{
+  this->NextStamp();
+  const uint32_t reached = this->stamp;
+  const uint32_t settled = this->stamp + 1;
+  std::greater<Entry> order;
+  this->queue.clear();
+
+  this->stamps[_source] = reached;
+  this->distances[_source] = 0;
+  this->queue.emplace_back(0, _source);
+  size_t numSettled = 0;
+  size_t numTargets = 0;
+  while (!this->queue.empty() && numSettled < _maxSettled &&
+         numTargets < _numTargets)
+  {
+    const Entry entry = this->queue.front();
+    std::pop_heap(this->queue.begin(), this->queue.end(), order);
+    this->queue.pop_back();
+    if (this->stamps[entry.second] == settled)
+      continue;
+    if (entry.first > _maxDistance)
+      break;
+    this->stamps[entry.second] = settled;
+    ++numSettled;
+    if (this->witnessTargets[entry.second] == this->witnessTarget)
+      ++numTargets;
+
+    for (auto const &edge : this->out[entry.second])
+    {
+      if (edge.node == _skip)
+        continue;
+      const double distance = entry.first + edge.weight;
+      const uint32_t targetStamp = this->stamps[edge.node];
+      if (targetStamp == settled)
+        continue;
+      if (targetStamp != reached || distance < this->distances[edge.node])
+      {
+        this->stamps[edge.node] = reached;
+        this->distances[edge.node] = distance;
+        this->queue.emplace_back(distance, edge.node);
+        std::push_heap(this->queue.begin(), this->queue.end(), order);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+size_t ContractionHierarchyPrivate::Shortcuts(const uint32_t _node,
+  const bool _add, size_t &_hops)
+{
+  const size_t maxSettled = _add ? kMaxWitnessSettled : kMaxEstimateSettled;
+  size_t count = 0;
+  _hops = 0;
+  const std::vector<ContractionEdge> &incoming = this->in[_node];
+  const std::vector<ContractionEdge> &outgoing = this->out[_node];
+  for (size_t i = 0; i < incoming.size(); ++i)
+  {
+    const ContractionEdge from = incoming[i];
+    double maxOut = -1;
+    for (auto const &to : outgoing)
+    {
+      if (to.node != from.node)
+        maxOut = std::max(maxOut, to.weight);
+    }
+    if (maxOut < 0)
+      continue;
+
+    if (++this->witnessTarget == 0)
+    {
+      std::fill(this->witnessTargets.begin(), this->witnessTargets.end(), 0);
+      this->witnessTarget = 1;
+    }
+    size_t numTargets = 0;
+    for (auto const &to : outgoing)
+    {
+      if (to.node != from.node)
+      {
+        this->witnessTargets[to.node] = this->witnessTarget;
+        ++numTargets;
+      }
+    }
+
+    this->Witness(from.node, _node, from.weight + maxOut, maxSettled,
+      numTargets);
+    for (size_t j = 0; j < outgoing.size(); ++j)
+    {
+      const ContractionEdge to = outgoing[j];
+      if (to.node == from.node)
+        continue;
+
+      const double via = from.weight + to.weight;
+      if (this->WitnessDistance(to.node) > via)
+      {
+        ++count;
+        _hops += from.hops + to.hops;
+        if (_add)
+          this->AddEdge(from.node, to.node, via, from.hops + to.hops);
+      }
+    }
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+void ContractionHierarchyPrivate::AddEdge(const uint32_t _from,
+  const uint32_t _to, const double _weight, const uint32_t _hops)
+{
+  for (auto &edge : this->out[_from])
+  {
+    if (edge.node == _to)
+    {
+      if (_weight < edge.weight)
+      {
+        edge.weight = _weight;
+        edge.hops = _hops;
+        for (auto &reverse : this->in[_to])
+        {
+          if (reverse.node == _from)
+          {
+            reverse.weight = _weight;
+            reverse.hops = _hops;
+          }
+        }
+      }
+      return;
+    }
+  }
+
+  this->out[_from].push_back({_to, _weight, _hops});
+  this->in[_to].push_back({_from, _weight, _hops});
+}
+
+//////////////////////////////////////////////////
+double ContractionHierarchyPrivate::Priority(const uint32_t _node,
+  const uint32_t _depth)
+{
+  size_t removed = 0;
+  size_t removedHops = 0;
+  for (auto const *edges : {&this->in[_node], &this->out[_node]})
+  {
+    removed += edges->size();
+    for (auto const &edge : *edges)
+      removedHops += edge.hops;
+  }
+  if (removed == 0)
+    return _depth;
+
+  // Prefer the nodes that add fewer edges than they remove, and whose
+  // shortcuts replace few original edges, so that the shortcuts stay short
+  // and the searches upwards stay small. The depth spreads the contraction
+  // evenly over the graph; a small weight keeps it from contracting the
+  // densely connected nodes early.
+  size_t hops;
+  const size_t shortcuts = this->Shortcuts(_node, false, hops);
+  return 2.0 * static_cast<double>(shortcuts) / static_cast<double>(removed) +
+    static_cast<double>(hops) / static_cast<double>(removedHops) +
+    0.1 * _depth;
+}
+
+//////////////////////////////////////////////////
+void ContractionHierarchyPrivate::Build(const RoadGraph &_graph)
+{
+  const uint32_t numNodes = static_cast<uint32_t>(_graph.NumNodes());
+  this->graphHash = GraphHash(_graph);
+  this->keys = _graph.Keys();
+  this->Prepare();
+
+  this->witnessTarget = 0;
+  this->witnessTargets.assign(numNodes, 0);
+  this->out.assign(numNodes, std::vector<ContractionEdge>());
+  this->in.assign(numNodes, std::vector<ContractionEdge>());
+  for (uint32_t i = 0; i < numNodes; ++i)
+  {
+    for (uint32_t e = _graph.Offsets()[i]; e < _graph.Offsets()[i + 1]; ++e)
+    {
+      if (_graph.Targets()[e] != i)
+        this->AddEdge(i, _graph.Targets()[e], _graph.Lengths()[e], 1);
+    }
+  }
+
+  // Nodes are contracted in order of priority. Contracting a node changes
+  // the priorities of its neighbors, so the priority of a node is computed
+  // again when it reaches the front of the queue, and the node goes back to
+  // the queue if it's no longer the lowest. Updating all the neighbors
+  // instead is too slow when the last nodes become densely connected.
+  std::vector<uint32_t> depths(numNodes, 0);
+  std::vector<ContractionQueueEntry> order;
+  order.reserve(numNodes);
+  for (uint32_t i = 0; i < numNodes; ++i)
+    order.push_back({this->Priority(i, 0), i});
+  std::greater<ContractionQueueEntry> compare;
+  std::make_heap(order.begin(), order.end(), compare);
+
+  std::vector<std::vector<ContractionEdge>> up(numNodes);
+  std::vector<std::vector<ContractionEdge>> down(numNodes);
+  size_t hops;
+  while (!order.empty())
+  {
+    const uint32_t node = order.front().node;
+    std::pop_heap(order.begin(), order.end(), compare);
+    order.pop_back();
+
+    const double current = this->Priority(node, depths[node]);
+    if (!order.empty() && current > order.front().priority)
+    {
+      order.push_back({current, node});
+      std::push_heap(order.begin(), order.end(), compare);
+      continue;
+    }
+
+    this->Shortcuts(node, true, hops);
+
+    // The remaining edges of the node become its upward and downward
+    // edges, and are removed from the graph being contracted.
+    for (auto const &edge : this->out[node])
+    {
+      up[node].push_back(edge);
+      std::vector<ContractionEdge> &reverse = this->in[edge.node];
+      reverse.erase(std::remove_if(reverse.begin(), reverse.end(),
+        [node](const ContractionEdge &_e) {return _e.node == node;}),
+        reverse.end());
+      depths[edge.node] = std::max(depths[edge.node], depths[node] + 1);
+    }
+    for (auto const &edge : this->in[node])
+    {
+      down[node].push_back(edge);
+      std::vector<ContractionEdge> &reverse = this->out[edge.node];
+      reverse.erase(std::remove_if(reverse.begin(), reverse.end(),
+        [node](const ContractionEdge &_e) {return _e.node == node;}),
+        reverse.end());
+      depths[edge.node] = std::max(depths[edge.node], depths[node] + 1);
+    }
+    std::vector<ContractionEdge>().swap(this->out[node]);
+    std::vector<ContractionEdge>().swap(this->in[node]);
+  }
+  std::vector<uint32_t>().swap(this->witnessTargets);
+  std::vector<std::vector<ContractionEdge>>().swap(this->out);
+  std::vector<std::vector<ContractionEdge>>().swap(this->in);
+
+  // Flatten the edges.
+  auto flatten = [numNodes](const std::vector<std::vector<ContractionEdge>>
+    &_edges, std::vector<uint32_t> &_offsets, std::vector<uint32_t> &_targets,
+    std::vector<double> &_weights)
+  {
+    _offsets.assign(numNodes + 1, 0);
+    for (uint32_t i = 0; i < numNodes; ++i)
+      _offsets[i + 1] = _offsets[i] + static_cast<uint32_t>(_edges[i].size());
+    _targets.clear();
+    _weights.clear();
+    _targets.reserve(_offsets.back());
+    _weights.reserve(_offsets.back());
+    for (auto const &edges : _edges)
+    {
+      for (auto const &edge : edges)
+      {
+        _targets.push_back(edge.node);
+        _weights.push_back(edge.weight);
+      }
+    }
+  };
+  flatten(up, this->upOffsets, this->upTargets, this->upWeights);
+  flatten(down, this->downOffsets, this->downTargets, this->downWeights);
+}
+
+//////////////////////////////////////////////////
+ContractionHierarchy::ContractionHierarchy()
+  : dataPtr(new ContractionHierarchyPrivate())
+{
+  this->dataPtr->Clear();
+}
+
+//////////////////////////////////////////////////
+ContractionHierarchy::ContractionHierarchy(const RoadGraph &_graph)
+  : ContractionHierarchy()
+{
+  this->Update(_graph);
+}
+
+//////////////////////////////////////////////////
+ContractionHierarchy::ContractionHierarchy(
+  const ContractionHierarchy &_other)
+  : ContractionHierarchy()
+{
+  *this = _other;
+}
+
+//////////////////////////////////////////////////
+ContractionHierarchy::~ContractionHierarchy()
+{
+}
+
+//////////////////////////////////////////////////
+void ContractionHierarchy::Update(const RoadGraph &_graph)
+{
+  this->dataPtr->Build(_graph);
+}
+
+//////////////////////////////////////////////////
+bool ContractionHierarchy::Save(const std::string &_filePath) const
+{
+  const ContractionHierarchyPrivate &data = *this->dataPtr;
+  ContractionHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, ContractionHierarchyPrivate::Magic(),
+    sizeof(header.magic));
+  header.version = ContractionHierarchyPrivate::kVersion;
+  header.byteOrder = ContractionHierarchyPrivate::kByteOrder;
+  header.graphHash = data.graphHash;
+  header.numNodes = static_cast<uint32_t>(data.keys.size());
+  header.numUpEdges = static_cast<uint32_t>(data.upTargets.size());
+  header.numDownEdges = static_cast<uint32_t>(data.downTargets.size());
+
+  // Write under a temporary name, so the file is replaced atomically.
+  const std::string tmpPath = _filePath + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+      std::cerr << "ContractionHierarchy::Save() error: Unable to open ["
+                << tmpPath << "]" << std::endl;
+      return false;
+    }
+
+    auto write = [&file](const void *_data, const size_t _bytes)
+    {
+      file.write(static_cast<const char *>(_data),
+        static_cast<std::streamsize>(_bytes));
+    };
+    write(&header, sizeof(header));
+    write(data.keys.data(), data.keys.size() * sizeof(uint64_t));
+    write(data.upOffsets.data(), data.upOffsets.size() * sizeof(uint32_t));
+    write(data.upTargets.data(), data.upTargets.size() * sizeof(uint32_t));
+    write(data.upWeights.data(), data.upWeights.size() * sizeof(double));
+    write(data.downOffsets.data(),
+      data.downOffsets.size() * sizeof(uint32_t));
+    write(data.downTargets.data(),
+      data.downTargets.size() * sizeof(uint32_t));
+    write(data.downWeights.data(), data.downWeights.size() * sizeof(double));
+    if (!file.good())
+    {
+      file.close();
+      std::remove(tmpPath.c_str());
+      std::cerr << "ContractionHierarchy::Save() error: Unable to write ["
+                << tmpPath << "]" << std::endl;
+      return false;
+    }
+  }
+
+  if (std::rename(tmpPath.c_str(), _filePath.c_str()) != 0)
+  {
+    // Some platforms don't replace existing files when renaming.
+    std::remove(_filePath.c_str());
+    if (std::rename(tmpPath.c_str(), _filePath.c_str()) != 0)
+    {
+      std::remove(tmpPath.c_str());
+      std::cerr << "ContractionHierarchy::Save() error: Unable to rename ["
+                << tmpPath << "]" << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ContractionHierarchy::Load(const std::string &_filePath)
+{
+  ContractionHierarchyPrivate &data = *this->dataPtr;
+  data.Clear();
+
+  LineReader reader;
+  StringView content;
+  if (!reader.Open(_filePath) || !reader.Remaining(content))
+  {
+    std::cerr << "ContractionHierarchy::Load() error: Unable to read ["
+              << _filePath << "]" << std::endl;
+    return false;
+  }
+
+  ContractionHeader header;
+  if (content.Size() < sizeof(header))
+  {
+    std::cerr << "ContractionHierarchy::Load() error: Truncated file ["
+              << _filePath << "]" << std::endl;
+    return false;
+  }
+  std::memcpy(&header, content.Data(), sizeof(header));
+
+  const size_t n = header.numNodes;
+  const size_t expectedSize = sizeof(header) + n * sizeof(uint64_t) +
+    2 * (n + 1) * sizeof(uint32_t) +
+    (static_cast<size_t>(header.numUpEdges) + header.numDownEdges) *
+    (sizeof(uint32_t) + sizeof(double));
+  if (std::memcmp(header.magic, ContractionHierarchyPrivate::Magic(),
+        sizeof(header.magic)) != 0 ||
+      header.version != ContractionHierarchyPrivate::kVersion ||
+      header.byteOrder != ContractionHierarchyPrivate::kByteOrder ||
+      content.Size() != expectedSize)
+  {
+    std::cerr << "ContractionHierarchy::Load() error: Invalid file ["
+              << _filePath << "]" << std::endl;
+    return false;
+  }
+
+  const char *cursor = content.Data() + sizeof(header);
+  ContractionHierarchyPrivate::Read(cursor, n, data.keys);
+  ContractionHierarchyPrivate::Read(cursor, n + 1, data.upOffsets);
+  ContractionHierarchyPrivate::Read(cursor, header.numUpEdges,
+    data.upTargets);
+  ContractionHierarchyPrivate::Read(cursor, header.numUpEdges,
+    data.upWeights);
+  ContractionHierarchyPrivate::Read(cursor, n + 1, data.downOffsets);
+  ContractionHierarchyPrivate::Read(cursor, header.numDownEdges,
+    data.downTargets);
+  ContractionHierarchyPrivate::Read(cursor, header.numDownEdges,
+    data.downWeights);
+
+  // Check the edges, so a corrupted file can't be used.
+  bool valid = data.upOffsets.front() == 0 && data.downOffsets.front() == 0 &&
+    data.upOffsets.back() == header.numUpEdges &&
+    data.downOffsets.back() == header.numDownEdges;
+  for (size_t i = 0; valid && i < n; ++i)
+  {
+    valid = data.upOffsets[i] <= data.upOffsets[i + 1] &&
+      data.downOffsets[i] <= data.downOffsets[i + 1];
+  }
+  for (auto const target : data.upTargets)
+    valid = valid && target < n;
+  for (auto const target : data.downTargets)
+    valid = valid && target < n;
+  if (!valid)
+  {
+    data.Clear();
+    std::cerr << "ContractionHierarchy::Load() error: Invalid edges in ["
+              << _filePath << "]" << std::endl;
+    return false;
+  }
+
+  data.graphHash = header.graphHash;
+  data.Prepare();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ContractionHierarchy::Load(const std::string &_filePath,
+  const RoadGraph &_graph)
+{
+  if (!this->Load(_filePath))
+    return false;
+
+  if (!this->Matches(_graph))
+  {
+    this->dataPtr->Clear();
+    std::cerr << "ContractionHierarchy::Load() error: [" << _filePath
+              << "] was built from a different graph" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ContractionHierarchy::Matches(const RoadGraph &_graph) const
+{
+  return this->dataPtr->keys.size() == _graph.NumNodes() &&
+    this->dataPtr->graphHash == ContractionHierarchyPrivate::GraphHash(_graph);
+}
+
+//////////////////////////////////////////////////
+size_t ContractionHierarchy::NumNodes() const
+{
+  return this->dataPtr->keys.size();
+}
+
+//////////////////////////////////////////////////
+size_t ContractionHierarchy::NumEdges() const
+{
+  return this->dataPtr->upTargets.size() + this->dataPtr->downTargets.size();
+}
+
+//////////////////////////////////////////////////
+bool ContractionHierarchy::Distance(const UniqueId &_start,
+  const UniqueId &_goal, double &_distance)
+{
+  uint32_t start;
+  uint32_t goal;
+  if (!this->dataPtr->Find(_start, start) ||
+      !this->dataPtr->Find(_goal, goal))
+  {
+    return false;
+  }
+
+  std::vector<double> distances;
+  this->dataPtr->Distances({start}, {goal}, distances);
+  _distance = distances[0];
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ContractionHierarchy::Distances(const std::vector<UniqueId> &_sources,
+  const std::vector<UniqueId> &_targets, std::vector<double> &_distances)
+{
+  std::vector<uint32_t> sources(_sources.size());
+  std::vector<uint32_t> targets(_targets.size());
+  for (size_t i = 0; i < _sources.size(); ++i)
+  {
+    if (!this->dataPtr->Find(_sources[i], sources[i]))
+    {
+      _distances.clear();
+      return false;
+    }
+  }
+  for (size_t i = 0; i < _targets.size(); ++i)
+  {
+    if (!this->dataPtr->Find(_targets[i], targets[i]))
+    {
+      _distances.clear();
+      return false;
+    }
+  }
+
+  this->dataPtr->Distances(sources, targets, _distances);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ContractionHierarchy::CheckpointDistances(const RNDF &_rndf,
+  const std::vector<int> &_sources, const std::vector<int> &_targets,
+  std::vector<double> &_distances)
+{
+  // The waypoints of all the checkpoints, sorted by checkpoint Id.
+  std::vector<std::pair<int, UniqueId>> checkpoints;
+  for (auto const &segment : _rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      for (auto const &cp : lane.Checkpoints())
+      {
+        checkpoints.emplace_back(cp.CheckpointId(),
+          UniqueId(segment.Id(), lane.Id(), cp.WaypointId()));
+      }
+    }
+  }
+  for (auto const &zone : _rndf.Zones())
+  {
+    for (auto const &spot : zone.Spots())
+    {
+      const Checkpoint &cp = spot.Checkpoint();
+      if (cp.Valid())
+      {
+        checkpoints.emplace_back(cp.CheckpointId(),
+          UniqueId(zone.Id(), spot.Id(), cp.WaypointId()));
+      }
+    }
+  }
+  std::stable_sort(checkpoints.begin(), checkpoints.end(),
+    [](const std::pair<int, UniqueId> &_a,
+       const std::pair<int, UniqueId> &_b)
+    {
+      return _a.first < _b.first;
+    });
+
+  auto find = [&](const std::vector<int> &_ids, std::vector<UniqueId> &_wps)
+  {
+    _wps.clear();
+    for (auto const id : _ids)
+    {
+      auto it = std::lower_bound(checkpoints.begin(), checkpoints.end(), id,
+        [](const std::pair<int, UniqueId> &_a, const int _id)
+        {
+          return _a.first < _id;
+        });
+      if (it == checkpoints.end() || it->first != id)
+      {
+        std::cerr << "ContractionHierarchy::CheckpointDistances() error: "
+                  << "Unknown checkpoint [" << id << "]" << std::endl;
+        return false;
+      }
+      _wps.push_back(it->second);
+    }
+    return true;
+  };
+
+  std::vector<UniqueId> sources;
+  std::vector<UniqueId> targets;
+  if (!find(_sources, sources) || !find(_targets, targets))
+  {
+    _distances.clear();
+    return false;
+  }
+
+  return this->Distances(sources, targets, _distances);
+}
+
+//////////////////////////////////////////////////
+ContractionHierarchy &ContractionHierarchy::operator=(
+  const ContractionHierarchy &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/ContractionHierarchy.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/Router.hh"
+#include "ignition/rndf/UniqueId.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Get the length of the shortest route between two nodes from a
+/// router without penalties, which is the reference for the hierarchy.
+/// \param[in, out] _router The router.
+/// \param[in] _start The first node.
+/// \param[in] _goal The last node.
+/// \return The length, infinite if there is no route.
+double routeLength(Router &_router, const uint32_t _start,
+  const uint32_t _goal)
+{
+  std::vector<uint32_t> nodes;
+  double cost;
+  if (!_router.Route(_start, _goal, nodes, cost))
+    return std::numeric_limits<double>::infinity();
+  return cost;
+}
+
+/// \brief Check that two distances are equal, or both infinite.
+/// \param[in] _distance The distance.
+/// \param[in] _expected The expected distance.
+void expectDistance(const double _distance, const double _expected)
+{
+  if (std::isinf(_expected))
+  {
+    EXPECT_TRUE(std::isinf(_distance));
+  }
+  else
+  {
+    EXPECT_NEAR(_distance, _expected, 1e-6);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check an empty hierarchy.
+TEST(ContractionHierarchy, Empty)
+{
+  ContractionHierarchy hierarchy;
+  EXPECT_EQ(hierarchy.NumNodes(), 0u);
+  EXPECT_EQ(hierarchy.NumEdges(), 0u);
+  double distance;
+  EXPECT_FALSE(hierarchy.Distance(UniqueId(1, 1, 1), UniqueId(1, 1, 2),
+    distance));
+
+  std::vector<double> distances(3);
+  EXPECT_TRUE(hierarchy.Distances({}, {}, distances));
+  EXPECT_TRUE(distances.empty());
+
+  RNDF rndf;
+  EXPECT_TRUE(hierarchy.Matches(rndf.RoadGraph()));
+  EXPECT_FALSE(hierarchy.Load("/non/existing/file.ch"));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the distances of the sample files against the router.
+TEST(ContractionHierarchy, Samples)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    RNDF rndf(dirPath + "/test/rndf/" + sample);
+    ASSERT_TRUE(rndf.Valid());
+    const RoadGraph &graph = rndf.RoadGraph();
+    ContractionHierarchy hierarchy(graph);
+    EXPECT_EQ(hierarchy.NumNodes(), graph.NumNodes());
+    EXPECT_TRUE(hierarchy.Matches(graph));
+
+    const uint32_t numNodes = static_cast<uint32_t>(graph.NumNodes());
+    std::vector<UniqueId> sources;
+    std::vector<UniqueId> targets;
+    for (uint32_t i = 0; i < numNodes; i += 7)
+      sources.push_back(UniqueId::FromKey(graph.Keys()[i]));
+    for (uint32_t i = 0; i < numNodes; ++i)
+      targets.push_back(UniqueId::FromKey(graph.Keys()[i]));
+
+    Router router(graph);
+    std::vector<double> distances;
+    ASSERT_TRUE(hierarchy.Distances(sources, targets, distances));
+    ASSERT_EQ(distances.size(), sources.size() * targets.size());
+    for (size_t s = 0; s < sources.size(); ++s)
+    {
+      const uint32_t start = static_cast<uint32_t>(7 * s);
+      for (uint32_t t = 0; t < targets.size(); ++t)
+      {
+        expectDistance(distances[s * targets.size() + t],
+          routeLength(router, start, t));
+      }
+
+      double distance;
+      ASSERT_TRUE(hierarchy.Distance(sources[s], targets.back(), distance));
+      expectDistance(distance, routeLength(router, start, numNodes - 1));
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the distances between checkpoints.
+TEST(ContractionHierarchy, Checkpoints)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+  const RoadGraph &graph = rndf.RoadGraph();
+  ContractionHierarchy hierarchy(graph);
+
+  // Checkpoint 1 is 4.1.3 and checkpoint 7 is 2.1.2.
+  std::vector<double> distances;
+  ASSERT_TRUE(hierarchy.CheckpointDistances(rndf, {1, 7}, {7, 1, 1},
+    distances));
+  ASSERT_EQ(distances.size(), 6u);
+  EXPECT_NEAR(distances[1], 0, 1e-9);
+  EXPECT_NEAR(distances[3], 0, 1e-9);
+  EXPECT_NEAR(distances[2], distances[1], 1e-9);
+
+  uint32_t first;
+  uint32_t seventh;
+  ASSERT_TRUE(graph.Node(UniqueId(4, 1, 3), first));
+  ASSERT_TRUE(graph.Node(UniqueId(2, 1, 2), seventh));
+  Router router(graph);
+  expectDistance(distances[0], routeLength(router, first, seventh));
+  expectDistance(distances[4], routeLength(router, seventh, first));
+
+  EXPECT_FALSE(hierarchy.CheckpointDistances(rndf, {1, 999}, {1},
+    distances));
+  EXPECT_TRUE(distances.empty());
+  EXPECT_FALSE(hierarchy.Distances({UniqueId(99, 1, 1)},
+    {UniqueId(4, 1, 3)}, distances));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check saving and loading a hierarchy.
+TEST(ContractionHierarchy, SaveLoad)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+  ContractionHierarchy hierarchy(rndf.RoadGraph());
+
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/ContractionHierarchy_TEST.ch";
+  ASSERT_TRUE(hierarchy.Save(filePath));
+
+  ContractionHierarchy loaded;
+  ASSERT_TRUE(loaded.Load(filePath, rndf.RoadGraph()));
+  EXPECT_EQ(loaded.NumNodes(), hierarchy.NumNodes());
+  EXPECT_EQ(loaded.NumEdges(), hierarchy.NumEdges());
+
+  std::vector<double> expected;
+  std::vector<double> distances;
+  ASSERT_TRUE(hierarchy.CheckpointDistances(rndf, {1, 2, 3, 4, 5},
+    {6, 7, 8, 9, 10}, expected));
+  ASSERT_TRUE(loaded.CheckpointDistances(rndf, {1, 2, 3, 4, 5},
+    {6, 7, 8, 9, 10}, distances));
+  ASSERT_EQ(distances.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+    expectDistance(distances[i], expected[i]);
+
+  // A copy answers the same queries.
+  ContractionHierarchy copy(loaded);
+  ASSERT_TRUE(copy.CheckpointDistances(rndf, {1, 2, 3, 4, 5},
+    {6, 7, 8, 9, 10}, distances));
+  for (size_t i = 0; i < expected.size(); ++i)
+    expectDistance(distances[i], expected[i]);
+
+  // The hierarchy doesn't match a modified graph.
+  ASSERT_TRUE(rndf.RemoveSegment(13));
+  EXPECT_FALSE(hierarchy.Matches(rndf.RoadGraph()));
+  EXPECT_FALSE(loaded.Load(filePath, rndf.RoadGraph()));
+  EXPECT_EQ(loaded.NumNodes(), 0u);
+
+  // Truncated and corrupted files.
+  std::string content;
+  {
+    std::ifstream file(filePath, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file << content.substr(0, content.size() - 1);
+  }
+  EXPECT_FALSE(loaded.Load(filePath));
+  {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file << "RNDFCH" << content.substr(6, 10);
+  }
+  EXPECT_FALSE(loaded.Load(filePath));
+  {
+    std::string corrupted = content;
+    corrupted[0] = 'X';
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file << corrupted;
+  }
+  EXPECT_FALSE(loaded.Load(filePath));
+
+  std::remove(filePath.c_str());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
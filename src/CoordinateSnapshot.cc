@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for CoordinateSnapshot class.
+    class CoordinateSnapshotPrivate
+    {
+      /// \brief Default constructor.
+      public: CoordinateSnapshotPrivate() = default;
+
+      /// \brief Destructor.
+      public: virtual ~CoordinateSnapshotPrivate() = default;
+
+      /// \brief Append a sequence of waypoints as a new range.
+      /// \param[in] _x Segment or zone Id.
+      /// \param[in] _y Lane or parking spot Id, or 0 for a perimeter.
+      /// \param[in] _waypoints The waypoints.
+      public: void Append(const int _x, const int _y,
+                          const std::vector<Waypoint> &_waypoints)
+      {
+        CoordinateRange range;
+        range.x = _x;
+        range.y = _y;
+        range.begin = static_cast<uint32_t>(this->latitudes.size());
+        for (auto const &wp : _waypoints)
+        {
+          this->latitudes.push_back(wp.Latitude());
+          this->longitudes.push_back(wp.Longitude());
+          this->keys.push_back(waypointKey(_x, _y, wp.Id()));
+        }
+        range.end = static_cast<uint32_t>(this->latitudes.size());
+        this->ranges.push_back(range);
+      }
+
+      /// \brief Copy in place the coordinates of the waypoints of a range.
+      /// \param[in] _range Position of the range.
+      /// \param[in] _x Segment or zone Id.
+      /// \param[in] _y Lane or parking spot Id, or 0 for a perimeter.
+      /// \param[in] _waypoints The waypoints.
+      /// \param[out] _updated Positions of the waypoints copied.
+      /// \return False if the range doesn't contain these waypoints.
+      public: bool Copy(const size_t _range, const int _x, const int _y,
+                        const std::vector<Waypoint> &_waypoints,
+                        std::vector<uint32_t> &_updated)
+      {
+        if (_range >= this->ranges.size())
+          return false;
+
+        const CoordinateRange &range = this->ranges[_range];
+        if (range.x != _x || range.y != _y ||
+            range.end - range.begin != _waypoints.size())
+        {
+          return false;
+        }
+
+        for (uint32_t i = range.begin; i < range.end; ++i)
+        {
+          const Waypoint &wp = _waypoints[i - range.begin];
+          if (this->keys[i] != waypointKey(_x, _y, wp.Id()))
+            return false;
+
+          this->latitudes[i] = wp.Latitude();
+          this->longitudes[i] = wp.Longitude();
+          _updated.push_back(i);
+        }
+        return true;
+      }
+
+      /// \brief Latitudes in degrees.
+      public: std::vector<double> latitudes;
+
+      /// \brief Longitudes in degrees.
+      public: std::vector<double> longitudes;
+
+      /// \brief Unique Id keys.
+      public: std::vector<uint64_t> keys;
+
+      /// \brief Ranges of waypoints of every lane, perimeter and spot.
+      public: std::vector<CoordinateRange> ranges;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+CoordinateSnapshot::CoordinateSnapshot()
+  : dataPtr(new CoordinateSnapshotPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+CoordinateSnapshot::CoordinateSnapshot(const RNDF &_rndf)
+  : CoordinateSnapshot()
+{
+  this->Update(_rndf);
+}
+
+//////////////////////////////////////////////////
+CoordinateSnapshot::CoordinateSnapshot(const CoordinateSnapshot &_other)
+  : CoordinateSnapshot()
+{
+  *this = _other;
+}
+
+//////////////////////////////////////////////////
+CoordinateSnapshot::~CoordinateSnapshot()
+{
+}
+
+//////////////////////////////////////////////////
+void CoordinateSnapshot::Update(const RNDF &_rndf)
+{
+  size_t numWaypoints = 0;
+  size_t numRanges = 0;
+  for (auto const &segment : _rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+      numWaypoints += lane.NumWaypoints();
+    numRanges += segment.NumLanes();
+  }
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    numWaypoints += zone.Perimeter().NumPoints();
+    for (auto const &spot : zone.Spots())
+      numWaypoints += spot.NumWaypoints();
+    numRanges += 1 + zone.NumSpots();
+  }
+
+  this->dataPtr->latitudes.clear();
+  this->dataPtr->longitudes.clear();
+  this->dataPtr->keys.clear();
+  this->dataPtr->ranges.clear();
+  this->dataPtr->latitudes.reserve(numWaypoints);
+  this->dataPtr->longitudes.reserve(numWaypoints);
+  this->dataPtr->keys.reserve(numWaypoints);
+  this->dataPtr->ranges.reserve(numRanges);
+
+  for (auto const &segment : _rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+      this->dataPtr->Append(segment.Id(), lane.Id(), lane.Waypoints());
+  }
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    this->dataPtr->Append(zone.Id(), 0, zone.Perimeter().Points());
+    for (auto const &spot : zone.Spots())
+      this->dataPtr->Append(zone.Id(), spot.Id(), spot.Waypoints());
+  }
+}
+
+//////////////////////////////////////////////////
+bool CoordinateSnapshot::Update(const RNDF &_rndf,
+  const std::vector<int> &_ids, std::vector<uint32_t> &_updated)
+{
+  _updated.clear();
+  CoordinateSnapshotPrivate &data = *this->dataPtr;
+
+  // Walk the segments and zones along the ranges, which are in the same
+  // order, and only visit the waypoints of the ones requested.
+  bool valid = true;
+  size_t r = 0;
+  for (auto const &segment : _rndf.Segments())
+  {
+    const bool copy =
+      std::binary_search(_ids.begin(), _ids.end(), segment.Id());
+    for (auto const &lane : segment.Lanes())
+    {
+      if (copy)
+      {
+        valid = valid && data.Copy(r, segment.Id(), lane.Id(),
+          lane.Waypoints(), _updated);
+      }
+      else
+      {
+        valid = valid && r < data.ranges.size() &&
+          data.ranges[r].x == segment.Id() && data.ranges[r].y == lane.Id();
+      }
+      ++r;
+    }
+  }
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    const bool copy =
+      std::binary_search(_ids.begin(), _ids.end(), zone.Id());
+    for (size_t s = 0; s <= zone.NumSpots(); ++s)
+    {
+      // The perimeter comes first.
+      const int y = s == 0 ? 0 : zone.Spots()[s - 1].Id();
+      if (copy)
+      {
+        valid = valid && data.Copy(r, zone.Id(), y,
+          s == 0 ? zone.Perimeter().Points() : zone.Spots()[s - 1].Waypoints(),
+          _updated);
+      }
+      else
+      {
+        valid = valid && r < data.ranges.size() &&
+          data.ranges[r].x == zone.Id() && data.ranges[r].y == y;
+      }
+      ++r;
+    }
+  }
+
+  if (!valid || r != data.ranges.size())
+  {
+    _updated.clear();
+    this->Update(_rndf);
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t CoordinateSnapshot::Size() const
+{
+  return this->dataPtr->latitudes.size();
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &CoordinateSnapshot::Latitudes() const
+{
+  return this->dataPtr->latitudes;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &CoordinateSnapshot::Longitudes() const
+{
+  return this->dataPtr->longitudes;
+}
+
+//////////////////////////////////////////////////
+const std::vector<uint64_t> &CoordinateSnapshot::Keys() const
+{
+  return this->dataPtr->keys;
+}
+
+//////////////////////////////////////////////////
+const std::vector<CoordinateRange> &CoordinateSnapshot::Ranges() const
+{
+  return this->dataPtr->ranges;
+}
+
+//////////////////////////////////////////////////
+CoordinateSnapshot &CoordinateSnapshot::operator=(
+  const CoordinateSnapshot &_other)
+{
+  this->dataPtr->latitudes = _other.dataPtr->latitudes;
+  this->dataPtr->longitudes = _other.dataPtr->longitudes;
+  this->dataPtr->keys = _other.dataPtr->keys;
+  this->dataPtr->ranges = _other.dataPtr->ranges;
+  return *this;
+}
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+//////////////////////////////////////////////////
+/// \brief Check that a default snapshot is empty.
+TEST(CoordinateSnapshot, empty)
+{
+  CoordinateSnapshot snapshot;
+  EXPECT_EQ(snapshot.Size(), 0u);
+  EXPECT_TRUE(snapshot.Latitudes().empty());
+  EXPECT_TRUE(snapshot.Longitudes().empty());
+  EXPECT_TRUE(snapshot.Keys().empty());
+  EXPECT_TRUE(snapshot.Ranges().empty());
+
+  RNDF rndf;
+  snapshot.Update(rndf);
+  EXPECT_EQ(snapshot.Size(), 0u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the snapshot matches the waypoints of a RNDF.
+TEST(CoordinateSnapshot, update)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+
+  CoordinateSnapshot snapshot(rndf);
+  ASSERT_EQ(snapshot.Latitudes().size(), snapshot.Size());
+  ASSERT_EQ(snapshot.Longitudes().size(), snapshot.Size());
+  ASSERT_EQ(snapshot.Keys().size(), snapshot.Size());
+
+  // Visit the waypoints in the order they are stored.
+  size_t i = 0;
+  size_t r = 0;
+  auto const &ranges = snapshot.Ranges();
+  auto check = [&](const int _x, const int _y,
+                   const std::vector<Waypoint> &_waypoints)
+  {
+    ASSERT_LT(r, ranges.size());
+    EXPECT_EQ(ranges[r].x, _x);
+    EXPECT_EQ(ranges[r].y, _y);
+    EXPECT_EQ(ranges[r].begin, i);
+    EXPECT_EQ(ranges[r].end, i + _waypoints.size());
+    for (auto const &wp : _waypoints)
+    {
+      EXPECT_DOUBLE_EQ(snapshot.Latitudes()[i], wp.Latitude());
+      EXPECT_DOUBLE_EQ(snapshot.Longitudes()[i], wp.Longitude());
+      EXPECT_EQ(snapshot.Keys()[i], UniqueId(_x, _y, wp.Id()).Key());
+      ++i;
+    }
+    ++r;
+  };
+
+  for (auto const &segment : rndf.Segments())
+    for (auto const &lane : segment.Lanes())
+      check(segment.Id(), lane.Id(), lane.Waypoints());
+
+  for (auto const &zone : rndf.Zones())
+  {
+    check(zone.Id(), 0, zone.Perimeter().Points());
+    for (auto const &spot : zone.Spots())
+      check(zone.Id(), spot.Id(), spot.Waypoints());
+  }
+
+  EXPECT_EQ(i, snapshot.Size());
+  EXPECT_EQ(r, ranges.size());
+
+  // First waypoint of the file: 1.1.1 38.875413 -77.205045
+  EXPECT_DOUBLE_EQ(snapshot.Latitudes().front(), 38.875413);
+  EXPECT_DOUBLE_EQ(snapshot.Longitudes().front(), -77.205045);
+
+  // Updating again replaces the content.
+  snapshot.Update(RNDF());
+  EXPECT_EQ(snapshot.Size(), 0u);
+  EXPECT_TRUE(snapshot.Ranges().empty());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check copy constructor and assignment operator.
+TEST(CoordinateSnapshot, copy)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+
+  CoordinateSnapshot snapshot1(rndf);
+  CoordinateSnapshot snapshot2(snapshot1);
+  EXPECT_EQ(snapshot2.Size(), snapshot1.Size());
+  EXPECT_EQ(snapshot2.Latitudes(), snapshot1.Latitudes());
+  EXPECT_EQ(snapshot2.Keys(), snapshot1.Keys());
+  EXPECT_EQ(snapshot2.Ranges().size(), snapshot1.Ranges().size());
+
+  CoordinateSnapshot snapshot3;
+  snapshot3 = snapshot1;
+  EXPECT_EQ(snapshot3.Longitudes(), snapshot1.Longitudes());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check updating the coordinates of some segments and zones.
+TEST(CoordinateSnapshot, partialUpdate)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+  CoordinateSnapshot snapshot(rndf);
+  const double *latitudes = snapshot.Latitudes().data();
+
+  // Move a waypoint of segment 2 and of zone 14.
+  rndf.Segments().at(1).Lanes().at(0).Waypoints().at(0).SetLocation(1, 2);
+  rndf.Zones().at(0).Perimeter().Points().at(0).SetLocation(3, 4);
+  std::vector<uint32_t> updated;
+  EXPECT_TRUE(snapshot.Update(rndf, {2, 14}, updated));
+  EXPECT_EQ(snapshot.Latitudes().data(), latitudes);
+
+  size_t expected = 0;
+  for (auto const &lane : rndf.Segments().at(1).Lanes())
+    expected += lane.NumWaypoints();
+  expected += rndf.Zones().at(0).Perimeter().NumPoints();
+  for (auto const &spot : rndf.Zones().at(0).Spots())
+    expected += spot.NumWaypoints();
+  EXPECT_EQ(updated.size(), expected);
+
+  CoordinateSnapshot rebuilt(rndf);
+  EXPECT_EQ(snapshot.Latitudes(), rebuilt.Latitudes());
+  EXPECT_EQ(snapshot.Longitudes(), rebuilt.Longitudes());
+
+  // A different layout rebuilds the snapshot.
+  ASSERT_TRUE(rndf.Segments().at(1).Lanes().at(0).RemoveWaypoint(1));
+  EXPECT_FALSE(snapshot.Update(rndf, {2}, updated));
+  EXPECT_TRUE(updated.empty());
+  EXPECT_EQ(snapshot.Size(), rebuilt.Size() - 1);
+  EXPECT_EQ(snapshot.Keys(), CoordinateSnapshot(rndf).Keys());
+
+  ASSERT_TRUE(rndf.RemoveSegment(3));
+  EXPECT_FALSE(snapshot.Update(rndf, {}, updated));
+  EXPECT_EQ(snapshot.Keys(), CoordinateSnapshot(rndf).Keys());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,6 +18,7 @@
 #include <fstream>
 #include <string>
 #include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/LineReader.hh"
 #include "ignition/rndf/ParserUtils.hh"
 #include "ignition/rndf/UniqueId.hh"
 
@@ -46,13 +47,23 @@ Exit::~Exit()
 }
 
 //////////////////////////////////////////////////
-bool Exit::Load(std::ifstream &_rndfFile, const int _x, const int _y,
+bool Exit::Load(LineReader &_reader, const int _x, const int _y,
   int &_lineNumber, std::string &_lineread)
 {
-  nextRealLine(_rndfFile, _lineread, _lineNumber);
+  StringView line;
+  nextRealLine(_reader, line, _lineNumber);
+  _lineread = line.String();
   return parseExit(_lineread, _x, _y, *this);
 }
 
+//////////////////////////////////////////////////
+bool Exit::Load(std::ifstream &_rndfFile, const int _x, const int _y,
+  int &_lineNumber, std::string &_lineread)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _x, _y, _lineNumber, _lineread);
+}
+
 //////////////////////////////////////////////////
 const UniqueId &Exit::ExitId() const
 {
@@ -17,14 +17,24 @@
 
 #include <algorithm>
 #include <cassert>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <utility>
 #include <vector>
 #include <ignition/math/SphericalCoordinates.hh>
 
+#include "ignition/rndf/Arena.hh"
 #include "ignition/rndf/Checkpoint.hh"
 #include "ignition/rndf/Exit.hh"
 #include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LineReader.hh"
 #include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/RNDFBuilder.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+#include "ignition/rndf/RNDFWriter.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
 #include "ignition/rndf/Waypoint.hh"
 
 using namespace ignition;
@@ -36,7 +46,7 @@ namespace ignition
   {
     /// \internal
     /// \brief Private data for ZoneHeader class.
-    class LaneHeaderPrivate
+    class LaneHeaderPrivate : public ArenaObject
     {
       /// \brief Default constructor.
       public: LaneHeaderPrivate() = default;
@@ -66,7 +76,7 @@ namespace ignition
 
     /// \internal
     /// \brief Private data for Lane class.
-    class LanePrivate
+    class LanePrivate : public ArenaObject
     {
       /// \brief Constructor.
       /// \param[in] _id Lane Id.
@@ -102,8 +112,8 @@ LaneHeader::~LaneHeader()
 }
 
 //////////////////////////////////////////////////
-bool LaneHeader::Load(std::ifstream &_rndfFile, const int _segmentId,
-  const int _laneId, int &_lineNumber, std::vector<ExitCacheEntry> &_exitCache)
+bool LaneHeader::Load(LineReader &_reader, const int _segmentId,
+  const int _laneId, int &_lineNumber, RNDFVisitor &_visitor)
 {
   double width = 0;
   Marking leftBoundary = Marking::UNDEFINED;
@@ -116,27 +126,40 @@ bool LaneHeader::Load(std::ifstream &_rndfFile, const int _segmentId,
   bool widthFound = false;
   bool leftBoundaryFound = false;
   bool rightBoundaryFound = false;
-  bool done = false;
 
-  do
+  while (true)
   {
-    auto oldPos = _rndfFile.tellg();
-    int oldLineNumber = _lineNumber;
-
-    std::string lineread;
-    nextRealLine(_rndfFile, lineread, _lineNumber);
+    StringView lineread;
+    _reader.Peek(lineread);
+
+    Tokens tokens;
+    tokenize(lineread, " ", tokens);
+
+    // Any other element is the start of the waypoint section, which is left
+    // for the waypoint parser.
+    if (tokens.Size() >= 2                &&
+        tokens[0] != "lane_width"         &&
+        tokens[0] != "left_boundary"      &&
+        tokens[0] != "right_boundary"     &&
+        tokens[0] != "checkpoint"         &&
+        tokens[0] != "stop"               &&
+        tokens[0] != "exit")
+    {
+      break;
+    }
 
-    auto tokens = split(lineread, " ");
+    _reader.Consume(_lineNumber);
 
-    if ((tokens.size() < 2)                                  ||
+    if ((tokens.Size() < 2)                                  ||
        (tokens[0] == "lane_width"     && widthFound)         ||
        (tokens[0] == "left_boundary"  && leftBoundaryFound)  ||
        (tokens[0] == "right_boundary" && rightBoundaryFound))
     {
       // Invalid or repeated header element.
-      std::cerr << "[Line " << _lineNumber << "]: Unable to parse lane header "
-                << "element." << std::endl;
-      std::cerr << " \"" << lineread << "\"" << std::endl;
+      errorStream() << "[Line " << _lineNumber
+                    << "]: Unable to parse lane header "
+                    << "element." << std::endl;
+      errorStream() << " \"" << lineread << "\"" << std::endl;
       return false;
     }
 
@@ -145,9 +168,9 @@ bool LaneHeader::Load(std::ifstream &_rndfFile, const int _segmentId,
       int widthFeet;
       if (!parseNonNegative(lineread, "lane_width", widthFeet))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "lane width element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "lane width element" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
@@ -159,9 +182,9 @@ bool LaneHeader::Load(std::ifstream &_rndfFile, const int _segmentId,
     {
       if (!parseBoundary(lineread, leftBoundary))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "lane boundary element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "lane boundary element" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
@@ -171,9 +194,9 @@ bool LaneHeader::Load(std::ifstream &_rndfFile, const int _segmentId,
     {
       if (!parseBoundary(lineread, rightBoundary))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "lane boundary element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "lane boundary element" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
@@ -182,68 +205,73 @@ bool LaneHeader::Load(std::ifstream &_rndfFile, const int _segmentId,
     else if (tokens[0] == "checkpoint")
     {
       rndf::Checkpoint checkpoint;
-      if (!parseCheckpoint(lineread, _segmentId, _laneId, checkpoint))
+      if (!parseCheckpoint(lineread, _segmentId, _laneId,
+            checkpoint))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "lane checkpoint element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "lane checkpoint element" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
       checkpoints.push_back(checkpoint);
+      _visitor.OnCheckpoint(_segmentId, _laneId, checkpoint);
     }
     else if (tokens[0] == "stop")
     {
       rndf::UniqueId stop;
       if (!parseStop(lineread, _segmentId, _laneId, stop))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "lane stop element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "lane stop element" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
       stops.push_back(stop.Z());
+      _visitor.OnStop(_segmentId, _laneId, stop.Z());
     }
-    else if (tokens[0] == "exit")
+    else
     {
       rndf::Exit exit;
       if (!parseExit(lineread, _segmentId, _laneId, exit))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "lane exit element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "lane exit element" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
       exits.push_back(exit);
-
-      // Update the exit cache.
-      _exitCache.push_back({exit.ExitId().String(),
-        exit.EntryId().String(), _lineNumber, lineread});
-    }
-    else
-    {
-      // This is the end of the header and the start of the waypoint section.
-      // Restore the file position and line number.
-      // ParseHeader() shouldn't have any effect.
-      _rndfFile.seekg(oldPos);
-      _lineNumber = oldLineNumber;
-      done = true;
+      _visitor.OnExit(exit, _lineNumber, lineread);
     }
-  } while (!done);
+  }
 
   // Populate all fields.
   this->SetWidth(width);
   this->SetLeftBoundary(leftBoundary);
   this->SetRightBoundary(rightBoundary);
-  this->Checkpoints() = checkpoints;
-  this->Stops() = stops;
-  this->Exits() = exits;
+  this->Checkpoints() = std::move(checkpoints);
+  this->Stops() = std::move(stops);
+  this->Exits() = std::move(exits);
 
   return true;
 }
 
+//////////////////////////////////////////////////
+bool LaneHeader::Load(std::ifstream &_rndfFile, const int _segmentId,
+  const int _laneId, int &_lineNumber, std::vector<ExitCacheEntry> &_exitCache)
+{
+  // The exits are added to the cache by a builder with a placeholder lane.
+  std::vector<uint64_t> waypointCache;
+  RNDFBuilder builder(_exitCache, waypointCache);
+  builder.OnSegment(_segmentId, 1, "");
+  builder.OnLane(_segmentId, _laneId, 0);
+
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _segmentId, _laneId, _lineNumber, builder);
+}
+
 //////////////////////////////////////////////////
 double LaneHeader::Width() const
 {
@@ -256,8 +284,8 @@ bool LaneHeader::SetWidth(const double _newWidth)
   bool valid = _newWidth >= 0;
   if (!valid)
   {
-    std::cerr << "LaneHeader::SetWidth() Invalid lane width [" << _newWidth
-              << "]" << std::endl;
+    errorStream() << "LaneHeader::SetWidth() Invalid lane width [" << _newWidth
+                  << "]" << std::endl;
     return false;
   }
 
@@ -337,10 +365,10 @@ bool LaneHeader::AddCheckpoint(const rndf::Checkpoint &_newCheckpoint)
   // Validate the checkpoint.
   if (!_newCheckpoint.Valid())
   {
-    std::cerr << "[Lane::AddCheckpoint() Invalid checkpoint: "
-              << "checkpointId [" << _newCheckpoint.CheckpointId() << "], "
-              << "waypointId [" << _newCheckpoint.WaypointId() << "]"
-              << std::endl;
+    errorStream() << "[Lane::AddCheckpoint() Invalid checkpoint: "
+                  << "checkpointId [" << _newCheckpoint.CheckpointId() << "], "
+                  << "waypointId [" << _newCheckpoint.WaypointId() << "]"
+                  << std::endl;
     return false;
   }
 
@@ -349,8 +377,8 @@ bool LaneHeader::AddCheckpoint(const rndf::Checkpoint &_newCheckpoint)
         this->dataPtr->checkpoints.end(), _newCheckpoint) !=
           this->dataPtr->checkpoints.end())
   {
-    std::cerr << "[Lane::AddCheckpoint() error: Existing checkpoint"
-              << std::endl;
+    errorStream() << "[Lane::AddCheckpoint() error: Existing checkpoint"
+                  << std::endl;
     return false;
   }
 
@@ -387,8 +415,8 @@ bool LaneHeader::AddStop(const int _waypointId)
   // Validate the waypoint Id.
   if (_waypointId <= 0)
   {
-    std::cerr << "[Lane::AddStop() Invalid waypoint Id: [" << _waypointId
-              << "]" << std::endl;
+    errorStream() << "[Lane::AddStop() Invalid waypoint Id: [" << _waypointId
+                  << "]" << std::endl;
     return false;
   }
 
@@ -396,7 +424,7 @@ bool LaneHeader::AddStop(const int _waypointId)
   if (std::find(this->dataPtr->stops.begin(),
         this->dataPtr->stops.end(), _waypointId) != this->dataPtr->stops.end())
   {
-    std::cerr << "[Lane::AddStop() error: Existing waypoint" << std::endl;
+    errorStream() << "[Lane::AddStop() error: Existing waypoint" << std::endl;
     return false;
   }
 
@@ -431,9 +459,9 @@ bool LaneHeader::AddExit(const Exit &_newExit)
   // Validate the exit.
   if (!_newExit.Valid())
   {
-    std::cerr << "LaneHeader::AddExit() Invalid exit [("
-              << _newExit.ExitId() << ")(" << _newExit.EntryId()
-              << ")]" << std::endl;
+    errorStream() << "LaneHeader::AddExit() Invalid exit [("
+                  << _newExit.ExitId() << ")(" << _newExit.EntryId()
+                  << ")]" << std::endl;
     return false;
   }
 
@@ -441,7 +469,7 @@ bool LaneHeader::AddExit(const Exit &_newExit)
   if (std::find(this->dataPtr->exits.begin(),
         this->dataPtr->exits.end(), _newExit) != this->dataPtr->exits.end())
   {
-    std::cerr << "[Lane::AddExit() error: Existing exit" << std::endl;
+    errorStream() << "[Lane::AddExit() error: Existing exit" << std::endl;
     return false;
   }
 
@@ -481,85 +509,111 @@ Lane::Lane(const Lane &_other)
   *this = _other;
 }
 
+//////////////////////////////////////////////////
+Lane::Lane(Lane &&_other) noexcept  // NOLINT
+  : dataPtr(std::move(_other.dataPtr))
+{
+}
+
 //////////////////////////////////////////////////
 Lane::~Lane()
 {
 }
 
 //////////////////////////////////////////////////
-bool Lane::Load(std::ifstream &_rndfFile, const int _segmentId,
+bool Lane::Load(LineReader &_reader, const int _segmentId,
   int &_lineNumber, std::vector<ExitCacheEntry> &_exitCache,
-  std::vector<std::string> &_waypointCache)
+  std::vector<uint64_t> &_waypointCache)
 {
-  std::string lineread;
+  // The lane is built inside a placeholder segment.
+  RNDFBuilder builder(_exitCache, _waypointCache);
+  builder.OnSegment(_segmentId, 1, "");
 
-  nextRealLine(_rndfFile, lineread, _lineNumber);
+  int laneId;
+  if (!Parse(_reader, _segmentId, _lineNumber, builder, laneId))
+    return false;
+
+  *this = std::move(builder.Segments().back().Lanes().back());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Lane::Parse(LineReader &_reader, const int _segmentId,
+  int &_lineNumber, RNDFVisitor &_visitor, int &_laneId)
+{
+  StringView lineread;
+
+  nextRealLine(_reader, lineread, _lineNumber);
 
   // Parse the "lane ID" .
-  auto tokens = split(lineread, " ");
-  if (tokens.size() != 2 || tokens.at(0) != "lane")
+  Tokens tokens;
+  tokenize(lineread, " ", tokens);
+  if (tokens.Size() != 2 || tokens[0] != "lane")
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse lane element"
-              << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber
+                  << "]: Unable to parse lane element"
+                  << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  auto laneIdTokens = split(tokens.at(1), ".");
-  if (laneIdTokens.size() != 2 ||
-      laneIdTokens.at(0) != std::to_string(_segmentId))
+  Tokens laneIdTokens;
+  tokenize(tokens[1], ".", laneIdTokens);
+  if (laneIdTokens.Size() != 2 ||
+      laneIdTokens[0] != std::to_string(_segmentId))
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse lane element"
-              << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber
+                  << "]: Unable to parse lane element"
+                  << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  std::string::size_type sz;
+  size_t sz;
   int laneId;
-
-  try
+  if (!parseInt(laneIdTokens[1], laneId, sz))
   {
-    laneId = std::stoi(laneIdTokens.at(1), &sz);
-  }
-  catch(...)
-  {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse lane element"
-              << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber
+                  << "]: Unable to parse lane element"
+                  << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  if (laneId <= 0 || laneId > 32768 || sz != laneIdTokens.at(1).size())
+  if (laneId <= 0 || laneId > 32768 || sz != laneIdTokens[1].Size())
   {
-    std::cerr << "[Line " << _lineNumber << "]: Out of range value ["
-              << laneId << "]" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber << "]: Out of range value ["
+                  << laneId << "]" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
   // Parse "num_waypoints".
   int numWaypoints;
-  if (!parsePositive(_rndfFile, "num_waypoints", numWaypoints, _lineNumber))
+  if (!parsePositive(_reader, "num_waypoints", numWaypoints, _lineNumber))
     return false;
 
+  _visitor.OnLane(_segmentId, laneId, numWaypoints);
+
   // Parse optional lane header.
   LaneHeader header;
-  if (!header.Load(_rndfFile, _segmentId, laneId, _lineNumber, _exitCache))
+  if (!header.Load(_reader, _segmentId, laneId, _lineNumber, _visitor))
     return false;
 
+  _visitor.OnLaneHeader(_segmentId, laneId, header.Width(),
+    header.LeftBoundary(), header.RightBoundary());
+
   // Parse waypoints.
-  std::vector<rndf::Waypoint> waypoints;
   for (auto i = 0; i < numWaypoints; ++i)
   {
     rndf::Waypoint waypoint;
-    if (!waypoint.Load(_rndfFile, _segmentId, laneId, _lineNumber))
+    if (!waypoint.Load(_reader, _segmentId, laneId, _lineNumber))
       return false;
 
     if (waypoint.Id() != i + 1)
     {
-      std::cerr << "[Line " << _lineNumber << "]: Found non-consecutive "
-                << "waypoint Id [" << waypoint.Id() << "]" << std::endl;
+      errorStream() << "[Line " << _lineNumber << "]: Found non-consecutive "
+                    << "waypoint Id [" << waypoint.Id() << "]" << std::endl;
       return false;
     }
 
@@ -573,29 +627,48 @@ bool Lane::Load(std::ifstream &_rndfFile, const int _segmentId,
       }
     }
 
-    waypoints.push_back(waypoint);
-    std::string wpStr(std::to_string(_segmentId) + "." + std::to_string(laneId)
-      + "." + std::to_string(waypoint.Id()));
-    _waypointCache.push_back(wpStr);
+    _visitor.OnWaypoint(_segmentId, laneId, waypoint);
   }
 
   // Parse "end_lane".
-  if (!parseDelimiter(_rndfFile, "end_lane", _lineNumber))
+  if (!parseDelimiter(_reader, "end_lane", _lineNumber))
     return false;
 
-  // Populate the lane.
-  this->SetId(laneId);
-  this->Waypoints() = waypoints;
-  this->SetWidth(header.Width());
-  this->SetLeftBoundary(header.LeftBoundary());
-  this->SetRightBoundary(header.RightBoundary());
-  this->Checkpoints() = header.Checkpoints();
-  this->Stops() = header.Stops();
-  this->Exits() = header.Exits();
-
+  _laneId = laneId;
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Lane::Load(std::ifstream &_rndfFile, const int _segmentId,
+  int &_lineNumber, std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<uint64_t> &_waypointCache)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _segmentId, _lineNumber, _exitCache,
+    _waypointCache);
+}
+
+//////////////////////////////////////////////////
+bool Lane::Load(std::ifstream &_rndfFile, const int _segmentId,
+  int &_lineNumber, std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<std::string> &_waypointCache)
+{
+  std::vector<uint64_t> waypointKeys;
+  const bool result = this->Load(_rndfFile, _segmentId, _lineNumber,
+    _exitCache, waypointKeys);
+  for (const uint64_t key : waypointKeys)
+    _waypointCache.push_back(UniqueId::FromKey(key).String());
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool Lane::Save(std::ostream &_stream, const int _segmentId) const
+{
+  RNDFWriter writer(_stream);
+  writer.WriteLane(_segmentId, *this);
+  return writer.Flush();
+}
+
 //////////////////////////////////////////////////
 int Lane::Id() const
 {
@@ -632,31 +705,33 @@ const std::vector<rndf::Waypoint> &Lane::Waypoints() const
 //////////////////////////////////////////////////
 bool Lane::Waypoint(const int _wpId, rndf::Waypoint &_wp) const
 {
-  auto it = std::find_if(this->dataPtr->waypoints.begin(),
-    this->dataPtr->waypoints.end(),
-    [_wpId](const rndf::Waypoint &_waypoint)
-    {
-      return _waypoint.Id() == _wpId;
-    });
+  const rndf::Waypoint *wp = this->Waypoint(_wpId);
+  if (wp)
+    _wp = *wp;
 
-  bool found = it != this->dataPtr->waypoints.end();
-  if (found)
-    _wp = *it;
+  return wp != nullptr;
+}
 
-  return found;
+//////////////////////////////////////////////////
+const rndf::Waypoint *Lane::Waypoint(const int _wpId) const
+{
+  return findById(this->dataPtr->waypoints, _wpId);
 }
 
 //////////////////////////////////////////////////
-bool Lane::UpdateWaypoint(const rndf::Waypoint &_wp)
+rndf::Waypoint *Lane::Waypoint(const int _wpId)
 {
-  auto it = std::find(this->dataPtr->waypoints.begin(),
-    this->dataPtr->waypoints.end(), _wp);
+  return findById(this->dataPtr->waypoints, _wpId);
+}
 
-  bool found = it != this->dataPtr->waypoints.end();
-  if (found)
-    *it = _wp;
+//////////////////////////////////////////////////
+bool Lane::UpdateWaypoint(const rndf::Waypoint &_wp)
+{
+  rndf::Waypoint *wp = this->Waypoint(_wp.Id());
+  if (wp)
+    *wp = _wp;
 
-  return found;
+  return wp != nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -665,8 +740,8 @@ bool Lane::AddWaypoint(const rndf::Waypoint &_newWaypoint)
   // Validate the waypoint.
   if (!_newWaypoint.Valid())
   {
-    std::cerr << "[Lane::Addwaypoint() Invalid waypoint Id ["
-              << _newWaypoint.Id() << "]" << std::endl;
+    errorStream() << "[Lane::Addwaypoint() Invalid waypoint Id ["
+                  << _newWaypoint.Id() << "]" << std::endl;
     return false;
   }
 
@@ -675,7 +750,8 @@ bool Lane::AddWaypoint(const rndf::Waypoint &_newWaypoint)
         this->dataPtr->waypoints.end(), _newWaypoint) !=
           this->dataPtr->waypoints.end())
   {
-    std::cerr << "[Lane::AddWaypoint() error: Existing waypoint" << std::endl;
+    errorStream() << "[Lane::AddWaypoint() error: Existing waypoint"
+                  << std::endl;
     return false;
   }
 
@@ -883,6 +959,10 @@ bool Lane::operator!=(const Lane &_other) const
 //////////////////////////////////////////////////
 Lane &Lane::operator=(const Lane &_other)
 {
+  // This instance might have been moved from.
+  if (!this->dataPtr)
+    this->dataPtr.reset(new LanePrivate(-1));
+
   this->SetId(_other.Id());
   this->Waypoints() = _other.Waypoints();
   this->SetWidth(_other.Width());
@@ -893,3 +973,10 @@ Lane &Lane::operator=(const Lane &_other)
   this->Exits() = _other.Exits();
   return *this;
 }
+
+//////////////////////////////////////////////////
+Lane &Lane::operator=(Lane &&_other) noexcept  // NOLINT
+{
+  std::swap(this->dataPtr, _other.dataPtr);
+  return *this;
+}
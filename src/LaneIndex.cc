@@ -0,0 +1,688 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LaneIndex.hh"
+#include "ignition/rndf/LocalFrame.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/Waypoint.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief A node of the bounding volume hierarchy.
+    struct LaneIndexNode
+    {
+      /// \brief Minimum east coordinate of the bounding box.
+      double minX;
+
+      /// \brief Minimum north coordinate of the bounding box.
+      double minY;
+
+      /// \brief Maximum east coordinate of the bounding box.
+      double maxX;
+
+      /// \brief Maximum north coordinate of the bounding box.
+      double maxY;
+
+      /// \brief Position of the first piece of a leaf, or of the left child
+      /// of an inner node. The right child follows the left one.
+      uint32_t first;
+
+      /// \brief Number of pieces of a leaf, or 0 for an inner node.
+      uint32_t count;
+    };
+
+    /// \internal
+    /// \brief A lane of the index.
+    struct LaneIndexLane
+    {
+      /// \brief Segment Id.
+      int segmentId;
+
+      /// \brief Lane Id.
+      int laneId;
+
+      /// \brief Half the width of the lane in meters.
+      double halfWidth;
+    };
+
+    /// \internal
+    /// \brief Private data for LaneIndex class.
+    /// The pieces of the centerlines are stored as a structure of arrays in
+    /// the order of the leaves of the hierarchy, so the distances from a
+    /// location to all the pieces of a leaf are computed by a loop without
+    /// branches that the compiler can vectorize.
+    class LaneIndexPrivate
+    {
+      /// \brief Maximum number of pieces of a leaf.
+      public: static const size_t kLeafSize = 8;
+
+      /// \brief Maximum depth of the hierarchy supported by the queries.
+      public: static const size_t kMaxDepth = 64;
+
+      /// \brief Number of locations traversing the hierarchy together in a
+      /// batch projection.
+      public: static const size_t kPacketSize = 8;
+
+      /// \brief Get the squared distance from a point to a piece.
+      /// \param[in] _x East coordinate of the point.
+      /// \param[in] _y North coordinate of the point.
+      /// \param[in] _piece Position of the piece.
+      /// \return The squared distance in square meters.
+      public: double SquaredDistance(const double _x, const double _y,
+                                     const size_t _piece) const
+      {
+        const double px = _x - this->ax[_piece];
+        const double py = _y - this->ay[_piece];
+        double t = (px * this->dx[_piece] + py * this->dy[_piece]) *
+          this->invLength2[_piece];
+        t = std::min(std::max(t, 0.0), 1.0);
+        const double ex = px - t * this->dx[_piece];
+        const double ey = py - t * this->dy[_piece];
+        return ex * ex + ey * ey;
+      }
+
+      /// \brief Get the squared distance from a point to the bounding box
+      /// of a node.
+      /// \param[in] _x East coordinate of the point.
+      /// \param[in] _y North coordinate of the point.
+      /// \param[in] _node The node.
+      /// \return The squared distance in square meters.
+      public: static double SquaredDistance(const double _x, const double _y,
+                                            const LaneIndexNode &_node)
+      {
+        const double ex = std::max(std::max(_node.minX - _x, 0.0),
+                                   _x - _node.maxX);
+        const double ey = std::max(std::max(_node.minY - _y, 0.0),
+                                   _y - _node.maxY);
+        return ex * ex + ey * ey;
+      }
+
+      /// \brief Build the subtree of a range of pieces.
+      /// \param[in] _node Position of the root node of the subtree.
+      /// \param[in] _begin First position of the range.
+      /// \param[in] _end Position after the last one of the range.
+      /// \param[in] _cx East coordinates of the centers of the pieces.
+      /// \param[in] _cy North coordinates of the centers of the pieces.
+      /// \param[in, out] _order Positions of the pieces in the input
+      /// arrays, reordered as the leaves.
+      public: void Build(const uint32_t _node, const size_t _begin,
+                         const size_t _end, const std::vector<double> &_cx,
+                         const std::vector<double> &_cy,
+                         std::vector<uint32_t> &_order)
+      {
+        LaneIndexNode node;
+        node.minX = std::numeric_limits<double>::max();
+        node.minY = std::numeric_limits<double>::max();
+        node.maxX = std::numeric_limits<double>::lowest();
+        node.maxY = std::numeric_limits<double>::lowest();
+        double minCx = node.minX;
+        double minCy = node.minY;
+        double maxCx = node.maxX;
+        double maxCy = node.maxY;
+        for (size_t i = _begin; i < _end; ++i)
+        {
+          const uint32_t p = _order[i];
+          const double bx = this->ax[p] + this->dx[p];
+          const double by = this->ay[p] + this->dy[p];
+          node.minX = std::min(node.minX, std::min(this->ax[p], bx));
+          node.minY = std::min(node.minY, std::min(this->ay[p], by));
+          node.maxX = std::max(node.maxX, std::max(this->ax[p], bx));
+          node.maxY = std::max(node.maxY, std::max(this->ay[p], by));
+          minCx = std::min(minCx, _cx[p]);
+          minCy = std::min(minCy, _cy[p]);
+          maxCx = std::max(maxCx, _cx[p]);
+          maxCy = std::max(maxCy, _cy[p]);
+        }
+
+        if (_end - _begin <= kLeafSize)
+        {
+          node.first = static_cast<uint32_t>(_begin);
+          node.count = static_cast<uint32_t>(_end - _begin);
+          this->nodes[_node] = node;
+          return;
+        }
+
+        // Split at the median center along the axis with the largest
+        // extent.
+        const std::vector<double> &centers =
+          maxCx - minCx >= maxCy - minCy ? _cx : _cy;
+        const size_t mid = _begin + (_end - _begin) / 2;
+        std::nth_element(_order.begin() + _begin, _order.begin() + mid,
+          _order.begin() + _end,
+          [&centers](const uint32_t _a, const uint32_t _b)
+          {
+            return centers[_a] < centers[_b];
+          });
+
+        const uint32_t left = static_cast<uint32_t>(this->nodes.size());
+        this->nodes.resize(this->nodes.size() + 2);
+        node.first = left;
+        node.count = 0;
+        this->nodes[_node] = node;
+
+        this->Build(left, _begin, mid, _cx, _cy, _order);
+        this->Build(left + 1, mid, _end, _cx, _cy, _order);
+      }
+
+      /// \brief Find the piece closest to a point.
+      /// \param[in] _x East coordinate of the point.
+      /// \param[in] _y North coordinate of the point.
+      /// \param[in, out] _best Position of the closest piece found.
+      /// \param[in, out] _bestDistance Squared distance to _best. Subtrees
+      /// farther than this distance aren't visited.
+      public: void Closest(const double _x, const double _y, size_t &_best,
+                           double &_bestDistance) const
+      {
+        uint32_t stack[kMaxDepth];
+        size_t size = 0;
+        stack[size++] = 0;
+        while (size > 0)
+        {
+          const LaneIndexNode &node = this->nodes[stack[--size]];
+          if (SquaredDistance(_x, _y, node) >= _bestDistance)
+            continue;
+
+          if (node.count > 0)
+          {
+            // Distances to all the pieces of the leaf.
+            double distances[kLeafSize];
+            const uint32_t first = node.first;
+            const uint32_t count = node.count;
+            for (uint32_t k = 0; k < count; ++k)
+            {
+              const double px = _x - this->ax[first + k];
+              const double py = _y - this->ay[first + k];
+              double t = (px * this->dx[first + k] + py * this->dy[first + k])
+                * this->invLength2[first + k];
+              t = std::min(std::max(t, 0.0), 1.0);
+              const double ex = px - t * this->dx[first + k];
+              const double ey = py - t * this->dy[first + k];
+              distances[k] = ex * ex + ey * ey;
+            }
+
+            for (uint32_t k = 0; k < count; ++k)
+            {
+              if (distances[k] < _bestDistance)
+              {
+                _best = first + k;
+                _bestDistance = distances[k];
+              }
+            }
+            continue;
+          }
+
+          // Visit the closest child first.
+          const uint32_t left = node.first;
+          const double leftDistance =
+            SquaredDistance(_x, _y, this->nodes[left]);
+          const double rightDistance =
+            SquaredDistance(_x, _y, this->nodes[left + 1]);
+          const uint32_t nearChild = leftDistance <= rightDistance ?
+            left : left + 1;
+          const double farDistance = std::max(leftDistance, rightDistance);
+          if (farDistance < _bestDistance && size < kMaxDepth)
+            stack[size++] = nearChild == left ? left + 1 : left;
+          if (size < kMaxDepth)
+            stack[size++] = nearChild;
+        }
+      }
+
+      /// \brief Find the pieces closest to a packet of nearby points. The
+      /// points traverse the hierarchy together: a node is visited if it can
+      /// contain a closer piece for any of them. The loops over the points
+      /// have a fixed length and no early exits, so the compiler can unroll
+      /// and vectorize them.
+      /// \param[in] _x East coordinates of the points.
+      /// \param[in] _y North coordinates of the points.
+      /// \param[in, out] _best Positions of the closest pieces found.
+      /// \param[in, out] _bestDistance Squared distances to _best.
+      public: void ClosestPacket(const double *_x, const double *_y,
+                                 size_t *_best, double *_bestDistance) const
+      {
+        // Children are visited in order of distance to the center of the
+        // packet.
+        double centerX = 0;
+        double centerY = 0;
+        for (size_t j = 0; j < kPacketSize; ++j)
+        {
+          centerX += _x[j];
+          centerY += _y[j];
+        }
+        centerX /= kPacketSize;
+        centerY /= kPacketSize;
+
+        uint32_t stack[kMaxDepth];
+        size_t size = 0;
+        stack[size++] = 0;
+        while (size > 0)
+        {
+          const LaneIndexNode &node = this->nodes[stack[--size]];
+          int visit = 0;
+          for (size_t j = 0; j < kPacketSize; ++j)
+          {
+            const double ex = std::max(std::max(node.minX - _x[j], 0.0),
+                                       _x[j] - node.maxX);
+            const double ey = std::max(std::max(node.minY - _y[j], 0.0),
+                                       _y[j] - node.maxY);
+            visit |= ex * ex + ey * ey < _bestDistance[j];
+          }
+          if (!visit)
+            continue;
+
+          if (node.count > 0)
+          {
+            for (uint32_t p = node.first; p < node.first + node.count; ++p)
+            {
+              const double ax0 = this->ax[p];
+              const double ay0 = this->ay[p];
+              const double dx0 = this->dx[p];
+              const double dy0 = this->dy[p];
+              const double inv = this->invLength2[p];
+              for (size_t j = 0; j < kPacketSize; ++j)
+              {
+                const double px = _x[j] - ax0;
+                const double py = _y[j] - ay0;
+                double t = (px * dx0 + py * dy0) * inv;
+                t = std::min(std::max(t, 0.0), 1.0);
+                const double ex = px - t * dx0;
+                const double ey = py - t * dy0;
+                const double distance = ex * ex + ey * ey;
+                const bool closer = distance < _bestDistance[j];
+                _bestDistance[j] = closer ? distance : _bestDistance[j];
+                _best[j] = closer ? p : _best[j];
+              }
+            }
+            continue;
+          }
+
+          const uint32_t left = node.first;
+          const bool leftFirst =
+            SquaredDistance(centerX, centerY, this->nodes[left]) <=
+            SquaredDistance(centerX, centerY, this->nodes[left + 1]);
+          if (size + 2 <= kMaxDepth)
+          {
+            stack[size++] = leftFirst ? left + 1 : left;
+            stack[size++] = leftFirst ? left : left + 1;
+          }
+        }
+      }
+
+      /// \brief Fill a projection with the closest point of a piece.
+      /// \param[in] _x East coordinate of the point.
+      /// \param[in] _y North coordinate of the point.
+      /// \param[in] _piece Position of the piece.
+      /// \param[out] _projection The projection.
+      public: void Fill(const double _x, const double _y, const size_t _piece,
+                        LaneProjection &_projection) const
+      {
+        const LaneIndexLane &lane = this->lanes[this->laneIndices[_piece]];
+        const double px = _x - this->ax[_piece];
+        const double py = _y - this->ay[_piece];
+        const double t = std::min(std::max((px * this->dx[_piece] +
+          py * this->dy[_piece]) * this->invLength2[_piece], 0.0), 1.0);
+        const double length = std::sqrt(this->dx[_piece] * this->dx[_piece] +
+          this->dy[_piece] * this->dy[_piece]);
+        const double distance = std::sqrt(this->SquaredDistance(_x, _y,
+          _piece));
+        const double cross = this->dx[_piece] * py - this->dy[_piece] * px;
+
+        _projection.segmentId = lane.segmentId;
+        _projection.laneId = lane.laneId;
+        _projection.waypointId = this->waypointIds[_piece];
+        _projection.arcLength = this->arcLengths[_piece] + t * length;
+        _projection.lateralOffset = cross < 0 ? -distance : distance;
+        _projection.inLane = lane.halfWidth > 0 &&
+          distance <= lane.halfWidth;
+      }
+
+      /// \brief Local frame of the waypoints.
+      public: LocalFrame frame;
+
+      /// \brief East coordinates of the start of the pieces.
+      public: std::vector<double> ax;
+
+      /// \brief North coordinates of the start of the pieces.
+      public: std::vector<double> ay;
+
+      /// \brief East extent of the pieces.
+      public: std::vector<double> dx;
+
+      /// \brief North extent of the pieces.
+      public: std::vector<double> dy;
+
+      /// \brief Inverse of the squared length of the pieces, or 0 for
+      /// pieces of length zero.
+      public: std::vector<double> invLength2;
+
+      /// \brief Distance along the lane to the start of the pieces.
+      public: std::vector<double> arcLengths;
+
+      /// \brief Waypoint Id at the start of the pieces.
+      public: std::vector<int> waypointIds;
+
+      /// \brief Position in "lanes" of the lane of the pieces.
+      public: std::vector<uint32_t> laneIndices;
+
+      /// \brief The lanes.
+      public: std::vector<LaneIndexLane> lanes;
+
+      /// \brief The nodes of the hierarchy. The first one is the root.
+      public: std::vector<LaneIndexNode> nodes;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+LaneIndex::LaneIndex()
+  : dataPtr(new LaneIndexPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+LaneIndex::LaneIndex(const RNDF &_rndf)
+  : LaneIndex()
+{
+  this->Update(_rndf);
+}
+
+//////////////////////////////////////////////////
+LaneIndex::LaneIndex(const LaneIndex &_other)
+  : LaneIndex()
+{
+  *this = _other;
+}
+
+//////////////////////////////////////////////////
+LaneIndex::~LaneIndex()
+{
+}
+
+//////////////////////////////////////////////////
+void LaneIndex::Update(const RNDF &_rndf)
+{
+  LaneIndexPrivate &data = *this->dataPtr;
+
+  // The origin of the local frame is the center of the bounding box.
+  double minLat = std::numeric_limits<double>::max();
+  double maxLat = std::numeric_limits<double>::lowest();
+  double minLon = minLat;
+  double maxLon = maxLat;
+  size_t numPieces = 0;
+  for (auto const &segment : _rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      for (auto const &wp : lane.Waypoints())
+      {
+        minLat = std::min(minLat, wp.Latitude());
+        maxLat = std::max(maxLat, wp.Latitude());
+        minLon = std::min(minLon, wp.Longitude());
+        maxLon = std::max(maxLon, wp.Longitude());
+      }
+      numPieces += std::max(lane.NumWaypoints(), static_cast<size_t>(2)) - 1;
+    }
+  }
+  if (minLat > maxLat)
+  {
+    minLat = maxLat = 0;
+    minLon = maxLon = 0;
+  }
+
+  data.frame.SetBounds(minLat, maxLat, minLon, maxLon);
+
+  // The pieces in lane order.
+  std::vector<double> ax;
+  std::vector<double> ay;
+  std::vector<double> dx;
+  std::vector<double> dy;
+  std::vector<double> arcLengths;
+  std::vector<int> waypointIds;
+  std::vector<uint32_t> laneIndices;
+  ax.reserve(numPieces);
+  ay.reserve(numPieces);
+  dx.reserve(numPieces);
+  dy.reserve(numPieces);
+  arcLengths.reserve(numPieces);
+  waypointIds.reserve(numPieces);
+  laneIndices.reserve(numPieces);
+  data.lanes.clear();
+  for (auto const &segment : _rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      const std::vector<Waypoint> &wps = lane.Waypoints();
+      if (wps.empty())
+        continue;
+
+      LaneIndexLane entry;
+      entry.segmentId = segment.Id();
+      entry.laneId = lane.Id();
+      entry.halfWidth = lane.Width() / 2;
+      const uint32_t laneIndex = static_cast<uint32_t>(data.lanes.size());
+      data.lanes.push_back(entry);
+
+      double x;
+      double y;
+      data.frame.Project(wps.front().Latitude(), wps.front().Longitude(), x, y);
+      double arcLength = 0;
+      const size_t last = wps.size() > 1 ? wps.size() - 1 : 1;
+      for (size_t i = 0; i < last; ++i)
+      {
+        double nextX = x;
+        double nextY = y;
+        if (i + 1 < wps.size())
+        {
+          data.frame.Project(wps[i + 1].Latitude(), wps[i + 1].Longitude(),
+            nextX, nextY);
+        }
+
+        ax.push_back(x);
+        ay.push_back(y);
+        dx.push_back(nextX - x);
+        dy.push_back(nextY - y);
+        arcLengths.push_back(arcLength);
+        waypointIds.push_back(wps[i].Id());
+        laneIndices.push_back(laneIndex);
+
+        arcLength += std::hypot(nextX - x, nextY - y);
+        x = nextX;
+        y = nextY;
+      }
+    }
+  }
+
+  // Build the hierarchy over the pieces in lane order, then store them in
+  // the order of the leaves.
+  const size_t size = ax.size();
+  std::vector<double> cx(size);
+  std::vector<double> cy(size);
+  std::vector<uint32_t> order(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    cx[i] = ax[i] + dx[i] / 2;
+    cy[i] = ay[i] + dy[i] / 2;
+    order[i] = static_cast<uint32_t>(i);
+  }
+
+  data.ax.swap(ax);
+  data.ay.swap(ay);
+  data.dx.swap(dx);
+  data.dy.swap(dy);
+  data.nodes.clear();
+  if (size > 0)
+  {
+    data.nodes.reserve(2 * (size / LaneIndexPrivate::kLeafSize + 1));
+    data.nodes.resize(1);
+    data.Build(0, 0, size, cx, cy, order);
+  }
+
+  ax.resize(size);
+  ay.resize(size);
+  dx.resize(size);
+  dy.resize(size);
+  data.invLength2.resize(size);
+  data.arcLengths.resize(size);
+  data.waypointIds.resize(size);
+  data.laneIndices.resize(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    const uint32_t p = order[i];
+    ax[i] = data.ax[p];
+    ay[i] = data.ay[p];
+    dx[i] = data.dx[p];
+    dy[i] = data.dy[p];
+    const double length2 = dx[i] * dx[i] + dy[i] * dy[i];
+    data.invLength2[i] = length2 > 0 ? 1 / length2 : 0;
+    data.arcLengths[i] = arcLengths[p];
+    data.waypointIds[i] = waypointIds[p];
+    data.laneIndices[i] = laneIndices[p];
+  }
+  data.ax.swap(ax);
+  data.ay.swap(ay);
+  data.dx.swap(dx);
+  data.dy.swap(dy);
+}
+
+//////////////////////////////////////////////////
+size_t LaneIndex::Size() const
+{
+  return this->dataPtr->ax.size();
+}
+
+//////////////////////////////////////////////////
+bool LaneIndex::Project(const double _latitude, const double _longitude,
+  LaneProjection &_projection) const
+{
+  if (this->Size() == 0)
+    return false;
+
+  double x;
+  double y;
+  this->dataPtr->frame.Project(_latitude, _longitude, x, y);
+  size_t best = 0;
+  double bestDistance = std::numeric_limits<double>::infinity();
+  this->dataPtr->Closest(x, y, best, bestDistance);
+  this->dataPtr->Fill(x, y, best, _projection);
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t LaneIndex::Project(const std::vector<double> &_latitudes,
+  const std::vector<double> &_longitudes,
+  std::vector<LaneProjection> &_projections) const
+{
+  const size_t size = _latitudes.size();
+  _projections.resize(size);
+  if (this->Size() == 0 || _longitudes.size() != size)
+  {
+    std::fill(_projections.begin(), _projections.end(), LaneProjection());
+    return 0;
+  }
+
+  const LaneIndexPrivate &data = *this->dataPtr;
+  std::vector<double> xs(size);
+  std::vector<double> ys(size);
+  double minX = std::numeric_limits<double>::max();
+  double minY = minX;
+  double maxX = std::numeric_limits<double>::lowest();
+  double maxY = maxX;
+  for (size_t i = 0; i < size; ++i)
+  {
+    data.frame.Project(_latitudes[i], _longitudes[i], xs[i], ys[i]);
+    minX = std::min(minX, xs[i]);
+    minY = std::min(minY, ys[i]);
+    maxX = std::max(maxX, xs[i]);
+    maxY = std::max(maxY, ys[i]);
+  }
+
+  // Group the locations in packets along a Z-order curve of a square
+  // 65536 x 65536 grid over their bounding box, so each packet contains
+  // nearby locations. Each entry has the code in the upper 32 bits and the
+  // position of the location in the lower ones.
+  const double extent = std::max(maxX - minX, maxY - minY);
+  const double scale = extent > 0 ? 65535 / extent : 0;
+  std::vector<uint64_t> order(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    uint64_t qx = 0;
+    uint64_t qy = 0;
+    if (std::isfinite(xs[i]) && std::isfinite(ys[i]))
+    {
+      qx = static_cast<uint64_t>((xs[i] - minX) * scale);
+      qy = static_cast<uint64_t>((ys[i] - minY) * scale);
+    }
+    uint64_t code = 0;
+    for (uint64_t bit = 0; bit < 16; ++bit)
+    {
+      code |= ((qx >> bit) & 1u) << (2 * bit);
+      code |= ((qy >> bit) & 1u) << (2 * bit + 1);
+    }
+    order[i] = (code << 32) | i;
+  }
+  std::sort(order.begin(), order.end());
+
+  // The closest pieces of the previous packet bound the search of the
+  // next one. The last packet is completed with copies of its last
+  // location.
+  const size_t kPacketSize = LaneIndexPrivate::kPacketSize;
+  double packetX[kPacketSize];
+  double packetY[kPacketSize];
+  size_t best[kPacketSize] = {};
+  double bestDistance[kPacketSize];
+  for (size_t begin = 0; begin < size; begin += kPacketSize)
+  {
+    const size_t count = std::min(kPacketSize, size - begin);
+    for (size_t j = 0; j < kPacketSize; ++j)
+    {
+      const size_t i = order[begin + std::min(j, count - 1)] & 0xFFFFFFFF;
+      packetX[j] = xs[i];
+      packetY[j] = ys[i];
+      bestDistance[j] = data.SquaredDistance(xs[i], ys[i], best[j]);
+    }
+
+    data.ClosestPacket(packetX, packetY, best, bestDistance);
+
+    for (size_t j = 0; j < count; ++j)
+    {
+      const size_t i = order[begin + j] & 0xFFFFFFFF;
+      data.Fill(xs[i], ys[i], best[j], _projections[i]);
+    }
+  }
+
+  return size;
+}
+
+//////////////////////////////////////////////////
+LaneIndex &LaneIndex::operator=(const LaneIndex &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LaneIndex.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/Waypoint.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Meters per degree of latitude used by the index.
+static const double kMetersPerDegree =
+  6371008.8 * 3.14159265358979323846 / 180;
+
+/// \brief Create a RNDF with a single straight lane running east along
+/// the equator, 4 meters wide.
+/// \param[out] _rndf The RNDF.
+void straightLane(RNDF &_rndf)
+{
+  Lane lane(1);
+  lane.SetWidth(4);
+  lane.Waypoints().push_back(Waypoint(1, 0, 0));
+  lane.Waypoints().push_back(Waypoint(2, 0, 0.001));
+  lane.Waypoints().push_back(Waypoint(3, 0, 0.002));
+  Segment segment(1);
+  segment.Lanes().push_back(lane);
+  ASSERT_TRUE(_rndf.AddSegment(segment));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a default index is empty.
+TEST(LaneIndex, Empty)
+{
+  LaneIndex index;
+  EXPECT_EQ(index.Size(), 0u);
+
+  LaneProjection projection;
+  EXPECT_FALSE(index.Project(34.58, -117.36, projection));
+
+  std::vector<LaneProjection> projections;
+  EXPECT_EQ(index.Project({34.58}, {-117.36}, projections), 0u);
+  ASSERT_EQ(projections.size(), 1u);
+  EXPECT_EQ(projections[0].laneId, 0);
+
+  RNDF rndf;
+  EXPECT_EQ(rndf.LaneIndex().Size(), 0u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the projections on a straight lane.
+TEST(LaneIndex, StraightLane)
+{
+  RNDF rndf;
+  straightLane(rndf);
+  const LaneIndex &index = rndf.LaneIndex();
+  EXPECT_EQ(index.Size(), 2u);
+
+  // One meter north of the middle of the second piece.
+  LaneProjection projection;
+  ASSERT_TRUE(index.Project(1 / kMetersPerDegree, 0.0015, projection));
+  EXPECT_EQ(projection.segmentId, 1);
+  EXPECT_EQ(projection.laneId, 1);
+  EXPECT_EQ(projection.waypointId, 2);
+  EXPECT_NEAR(projection.arcLength, 0.0015 * kMetersPerDegree, 1e-6);
+  EXPECT_NEAR(projection.lateralOffset, 1, 1e-6);
+  EXPECT_TRUE(projection.inLane);
+
+  // Three meters south of the first piece.
+  ASSERT_TRUE(index.Project(-3 / kMetersPerDegree, 0.0005, projection));
+  EXPECT_EQ(projection.waypointId, 1);
+  EXPECT_NEAR(projection.arcLength, 0.0005 * kMetersPerDegree, 1e-6);
+  EXPECT_NEAR(projection.lateralOffset, -3, 1e-6);
+  EXPECT_FALSE(projection.inLane);
+
+  // Beyond the end of the lane.
+  ASSERT_TRUE(index.Project(0, 0.003, projection));
+  EXPECT_EQ(projection.waypointId, 2);
+  EXPECT_NEAR(projection.arcLength, 0.002 * kMetersPerDegree, 1e-6);
+  EXPECT_NEAR(std::fabs(projection.lateralOffset),
+    0.001 * kMetersPerDegree, 1e-6);
+  EXPECT_FALSE(projection.inLane);
+
+  // Without a width, no location is inside the lane.
+  rndf.Segments().front().Lanes().front().SetWidth(0);
+  rndf.MarkModified(rndf.Segments().front().Id());
+  ASSERT_TRUE(rndf.LaneIndex().Project(0, 0.0015, projection));
+  EXPECT_NEAR(projection.lateralOffset, 0, 1e-6);
+  EXPECT_FALSE(projection.inLane);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check single and batch projections against a linear scan of all
+/// the pieces of the lanes.
+TEST(LaneIndex, Samples)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    RNDF rndf(dirPath + "/test/rndf/" + sample);
+    ASSERT_TRUE(rndf.Valid());
+    const LaneIndex &index = rndf.LaneIndex();
+
+    // Centerlines in the local frame used by the index.
+    double minLat = std::numeric_limits<double>::max();
+    double maxLat = std::numeric_limits<double>::lowest();
+    double minLon = minLat;
+    double maxLon = maxLat;
+    size_t numPieces = 0;
+    for (auto const &segment : rndf.Segments())
+    {
+      for (auto const &lane : segment.Lanes())
+      {
+        for (auto const &wp : lane.Waypoints())
+        {
+          minLat = std::min(minLat, wp.Latitude());
+          maxLat = std::max(maxLat, wp.Latitude());
+          minLon = std::min(minLon, wp.Longitude());
+          maxLon = std::max(maxLon, wp.Longitude());
+        }
+        numPieces += std::max(lane.NumWaypoints(), static_cast<size_t>(2)) - 1;
+      }
+    }
+    EXPECT_EQ(index.Size(), numPieces);
+
+    const double lat0 = (minLat + maxLat) / 2;
+    const double lon0 = (minLon + maxLon) / 2;
+    const double lonScale = kMetersPerDegree *
+      std::cos(lat0 * 3.14159265358979323846 / 180);
+
+    // A grid of locations around the lanes.
+    std::vector<double> lats;
+    std::vector<double> lons;
+    const int kSteps = 40;
+    for (int i = 0; i <= kSteps; ++i)
+    {
+      for (int j = 0; j <= kSteps; ++j)
+      {
+        lats.push_back(minLat - 0.001 + (maxLat - minLat + 0.002) * i / kSteps);
+        lons.push_back(minLon - 0.001 + (maxLon - minLon + 0.002) * j / kSteps);
+      }
+    }
+
+    std::vector<LaneProjection> batch;
+    ASSERT_EQ(index.Project(lats, lons, batch), lats.size());
+    ASSERT_EQ(batch.size(), lats.size());
+
+    for (size_t q = 0; q < lats.size(); ++q)
+    {
+      const double qx = (lons[q] - lon0) * lonScale;
+      const double qy = (lats[q] - lat0) * kMetersPerDegree;
+      double best = std::numeric_limits<double>::infinity();
+      for (auto const &segment : rndf.Segments())
+      {
+        for (auto const &lane : segment.Lanes())
+        {
+          const std::vector<Waypoint> &wps = lane.Waypoints();
+          for (size_t k = 0; k + 1 < wps.size(); ++k)
+          {
+            const double ax = (wps[k].Longitude() - lon0) * lonScale;
+            const double ay = (wps[k].Latitude() - lat0) * kMetersPerDegree;
+            const double dx = (wps[k + 1].Longitude() - lon0) * lonScale - ax;
+            const double dy =
+              (wps[k + 1].Latitude() - lat0) * kMetersPerDegree - ay;
+            const double length2 = dx * dx + dy * dy;
+            double t = length2 > 0 ?
+              ((qx - ax) * dx + (qy - ay) * dy) / length2 : 0;
+            t = std::min(std::max(t, 0.0), 1.0);
+            best = std::min(best,
+              std::hypot(qx - ax - t * dx, qy - ay - t * dy));
+          }
+        }
+      }
+
+      LaneProjection single;
+      ASSERT_TRUE(index.Project(lats[q], lons[q], single));
+      EXPECT_NEAR(std::fabs(single.lateralOffset), best, 1e-6);
+      EXPECT_NEAR(std::fabs(batch[q].lateralOffset), best, 1e-6);
+      EXPECT_GT(batch[q].segmentId, 0);
+      EXPECT_GT(batch[q].laneId, 0);
+      EXPECT_GT(batch[q].waypointId, 0);
+      EXPECT_GE(batch[q].arcLength, 0);
+    }
+
+    // Mismatched input sizes.
+    lons.pop_back();
+    EXPECT_EQ(index.Project(lats, lons, batch), 0u);
+    EXPECT_EQ(batch.size(), lats.size());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check copies of an index.
+TEST(LaneIndex, Copy)
+{
+  RNDF rndf;
+  straightLane(rndf);
+  LaneIndex copy(rndf.LaneIndex());
+  EXPECT_EQ(copy.Size(), 2u);
+
+  LaneIndex assigned;
+  assigned = copy;
+  LaneProjection projection;
+  ASSERT_TRUE(assigned.Project(0, 0.0015, projection));
+  EXPECT_EQ(projection.waypointId, 2);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
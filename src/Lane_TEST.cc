@@ -19,6 +19,8 @@
 #include <map>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
@@ -127,6 +129,33 @@ TEST(Lane, waypoints)
   EXPECT_EQ(lane.NumWaypoints(), 0u);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the accessors of waypoints by Id that don't copy them.
+TEST(Lane, waypointById)
+{
+  Lane lane(1);
+  for (auto const id : {1, 2, 4})
+    lane.Waypoints().emplace_back(id, 10.0, 20.0);
+  const Lane &constLane = lane;
+
+  // Consecutive and non-consecutive Ids.
+  EXPECT_EQ(constLane.Waypoint(1), &constLane.Waypoints().at(0));
+  EXPECT_EQ(constLane.Waypoint(2), &constLane.Waypoints().at(1));
+  EXPECT_EQ(constLane.Waypoint(4), &constLane.Waypoints().at(2));
+  EXPECT_EQ(constLane.Waypoint(3), nullptr);
+  EXPECT_EQ(constLane.Waypoint(0), nullptr);
+  EXPECT_EQ(constLane.Waypoint(-1), nullptr);
+
+  // Edit a waypoint in place.
+  Waypoint *mutableWaypoint = lane.Waypoint(4);
+  ASSERT_TRUE(mutableWaypoint != nullptr);
+  mutableWaypoint->SetLocation(11.0, 21.0);
+  Waypoint copy;
+  EXPECT_TRUE(lane.Waypoint(4, copy));
+  EXPECT_DOUBLE_EQ(copy.Latitude(), 11.0);
+  EXPECT_EQ(lane.Waypoint(5), nullptr);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check function that validates the Id of a lane.
 TEST(Lane, valid)
@@ -392,6 +421,35 @@ TEST(Lane, assignment)
   EXPECT_EQ(lane1, lane2);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check move constructor and move assignment operator.
+TEST(Lane, move)
+{
+  static_assert(std::is_nothrow_move_constructible<Lane>::value &&
+    std::is_nothrow_move_assignable<Lane>::value,
+    "Lane should be nothrow movable");
+
+  Lane lane1(1);
+  lane1.Waypoints().push_back(Waypoint(1,
+    ignition::math::SphericalCoordinates()));
+  lane1.SetWidth(3.5);
+
+  Lane lane2(std::move(lane1));
+  EXPECT_EQ(lane2.Id(), 1);
+  EXPECT_EQ(lane2.NumWaypoints(), 1u);
+  EXPECT_DOUBLE_EQ(lane2.Width(), 3.5);
+
+  // A moved-from lane can be assigned to.
+  lane1 = lane2;
+  EXPECT_EQ(lane1, lane2);
+  EXPECT_EQ(lane1.NumWaypoints(), 1u);
+
+  Lane lane3(3);
+  lane3 = std::move(lane2);
+  EXPECT_EQ(lane3.Id(), 1);
+  EXPECT_EQ(lane3.NumWaypoints(), 1u);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check loading a lane from a text file.
 TEST_F(LaneTest, Load)
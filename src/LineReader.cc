@@ -0,0 +1,441 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <istream>
+#include <string>
+
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/ParserUtils.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for LineReader class.
+    class LineReaderPrivate
+    {
+      /// \brief Default constructor.
+      public: LineReaderPrivate() = default;
+
+      /// \brief Destructor.
+      public: virtual ~LineReaderPrivate()
+      {
+        this->Unmap();
+      }
+
+      /// \brief Release the memory mapping, if any.
+      public: void Unmap()
+      {
+#ifdef _WIN32
+        if (this->mapping)
+          UnmapViewOfFile(this->mapping);
+#else
+        if (this->mapping)
+          munmap(this->mapping, this->size);
+#endif
+        this->mapping = nullptr;
+      }
+
+      /// \brief Read the whole content of a file that can't be mapped, such
+      /// as a pipe or a character device, into "owned".
+      /// \param[in] _file The file.
+      /// \return True if the content was read or false if an error occurred.
+#ifdef _WIN32
+      public: bool ReadAll(HANDLE _file)
+#else
+      public: bool ReadAll(const int _file)
+#endif
+      {
+        const size_t kChunkSize = 64 * 1024;
+        size_t length = 0;
+        while (true)
+        {
+          this->owned.resize(length + kChunkSize);
+#ifdef _WIN32
+          DWORD bytes = 0;
+          if (!ReadFile(_file, &this->owned[length],
+                static_cast<DWORD>(kChunkSize), &bytes, nullptr))
+          {
+            // The writer closing a pipe is the end of the content.
+            if (GetLastError() != ERROR_BROKEN_PIPE)
+              return false;
+            bytes = 0;
+          }
+#else
+          const ssize_t bytes = read(_file, &this->owned[length], kChunkSize);
+          if (bytes < 0 && errno == EINTR)
+            continue;
+          if (bytes < 0)
+            return false;
+#endif
+          if (bytes == 0)
+            break;
+          length += static_cast<size_t>(bytes);
+        }
+
+        this->owned.resize(length);
+        this->data = this->owned.data();
+        this->size = length;
+        return true;
+      }
+
+      /// \brief Read the next raw line, excluding the end of line character.
+      /// \param[out] _line The line read. The view is valid until the next
+      /// call.
+      /// \return True if a line was read or false if the end of the content
+      /// was reached.
+      public: bool ReadLine(StringView &_line)
+      {
+        if (this->stream)
+        {
+          if (!std::getline(*this->stream, this->streamLine))
+            return false;
+
+          _line = StringView(this->streamLine);
+          this->peekBytes += this->streamLine.size() +
+            (this->stream->eof() ? 0u : 1u);
+          return true;
+        }
+
+        if (this->pos >= this->size)
+          return false;
+
+        const char *start = this->data + this->pos;
+        const size_t remaining = this->size - this->pos;
+        const char *eol = static_cast<const char *>(
+          std::memchr(start, '\n', remaining));
+
+        if (eol)
+        {
+          _line = StringView(start, static_cast<size_t>(eol - start));
+          this->pos += _line.Size() + 1;
+        }
+        else
+        {
+          _line = StringView(start, remaining);
+          this->pos = this->size;
+        }
+
+        return true;
+      }
+
+      /// \brief Whether the underlying content has been entirely read.
+      /// \return True if there are no more raw lines to read.
+      public: bool RawEof() const
+      {
+        if (this->stream)
+        {
+          return !this->stream->good() ||
+            this->stream->peek() == std::char_traits<char>::eof();
+        }
+
+        return this->pos >= this->size;
+      }
+
+      /// \brief Pointer to the first character of the content.
+      public: const char *data = nullptr;
+
+      /// \brief Size of the content.
+      public: size_t size = 0;
+
+      /// \brief Offset of the next character to read.
+      public: size_t pos = 0;
+
+      /// \brief Offset of the first character not consumed yet.
+      public: size_t consumed = 0;
+
+      /// \brief Start address of the memory-mapped file, if any.
+      public: void *mapping = nullptr;
+
+      /// \brief Content read from a file that can't be mapped, if any.
+      public: std::string owned;
+
+      /// \brief Input stream that provides the content, if any.
+      public: std::istream *stream = nullptr;
+
+      /// \brief Position of the input stream when the reader was created or
+      /// -1 if the stream isn't seekable.
+      public: std::streamoff streamStart = -1;
+
+      /// \brief Number of characters consumed from the input stream.
+      public: std::streamoff streamConsumed = 0;
+
+      /// \brief Last line read from the input stream.
+      public: std::string streamLine;
+
+      /// \brief Whether a line has been peeked and not consumed yet.
+      public: bool peeked = false;
+
+      /// \brief The line peeked.
+      public: StringView peekLine;
+
+      /// \brief Number of raw lines read while peeking, including the
+      /// blank lines skipped.
+      public: int peekLines = 0;
+
+      /// \brief Number of stream characters read while peeking.
+      public: size_t peekBytes = 0;
+
+      /// \brief Buffer used for normalizing lines that aren't already
+      /// trimmed. Its capacity is reused across lines.
+      public: std::string buffer;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+LineReader::LineReader()
+  : dataPtr(new LineReaderPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+LineReader::LineReader(const char *_data, const size_t _size)
+  : LineReader()
+{
+  this->dataPtr->data = _data;
+  this->dataPtr->size = _size;
+}
+
+//////////////////////////////////////////////////
+LineReader::LineReader(std::istream &_stream)
+  : LineReader()
+{
+  this->dataPtr->stream = &_stream;
+  this->dataPtr->streamStart = _stream.tellg();
+}
+
+//////////////////////////////////////////////////
+LineReader::~LineReader()
+{
+  // A line peeked but not consumed has been extracted from the stream.
+  // Put the stream back right after the last line consumed, if possible.
+  auto &d = *this->dataPtr;
+  if (d.stream && d.streamStart >= 0 && d.peeked && d.peekLines > 0)
+  {
+    d.stream->clear();
+    d.stream->seekg(d.streamStart + d.streamConsumed);
+  }
+}
+
+//////////////////////////////////////////////////
+bool LineReader::Open(const std::string &_filePath)
+{
+  this->dataPtr.reset(new LineReaderPrivate());
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(_filePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+    nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  // Pipes and character devices can't be mapped, so they are read.
+  if (GetFileType(file) != FILE_TYPE_DISK)
+  {
+    const bool result = this->dataPtr->ReadAll(file);
+    CloseHandle(file);
+    return result;
+  }
+
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize))
+  {
+    CloseHandle(file);
+    return false;
+  }
+
+  // Empty files can't be mapped.
+  if (fileSize.QuadPart == 0)
+  {
+    CloseHandle(file);
+    return true;
+  }
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+    nullptr);
+  CloseHandle(file);
+  if (!mapping)
+    return false;
+
+  void *addr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!addr)
+    return false;
+
+  this->dataPtr->size = static_cast<size_t>(fileSize.QuadPart);
+#else
+  int fd = open(_filePath.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    close(fd);
+    return false;
+  }
+
+  // Pipes, FIFOs and character devices can't be mapped, so they are read.
+  if (!S_ISREG(st.st_mode))
+  {
+    const bool result = this->dataPtr->ReadAll(fd);
+    close(fd);
+    return result;
+  }
+
+  // Empty files can't be mapped.
+  if (st.st_size == 0)
+  {
+    close(fd);
+    return true;
+  }
+
+  void *addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+    MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED)
+    return false;
+
+  // The file is read once from start to end.
+  madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+
+  this->dataPtr->size = static_cast<size_t>(st.st_size);
+#endif
+
+  this->dataPtr->mapping = addr;
+  this->dataPtr->data = static_cast<const char *>(addr);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LineReader::Peek(StringView &_line)
+{
+  auto &d = *this->dataPtr;
+  if (d.peeked)
+  {
+    _line = d.peekLine;
+    return !_line.Empty();
+  }
+
+  d.peeked = true;
+  d.peekLines = 0;
+  d.peekBytes = 0;
+  d.peekLine = StringView();
+
+  StringView raw;
+  while (d.ReadLine(raw))
+  {
+    ++d.peekLines;
+
+    // Lines that need normalization are copied into the buffer, reusing
+    // its capacity.
+    d.peekLine = trimWhitespaces(raw, d.buffer);
+
+    // Ignore blank lines.
+    if (!d.peekLine.Empty())
+      break;
+  }
+
+  _line = d.peekLine;
+  return !_line.Empty();
+}
+
+//////////////////////////////////////////////////
+void LineReader::Consume(int &_lineNumber)
+{
+  auto &d = *this->dataPtr;
+  if (!d.peeked)
+  {
+    StringView line;
+    this->Peek(line);
+  }
+
+  _lineNumber += d.peekLines;
+  d.streamConsumed += static_cast<std::streamoff>(d.peekBytes);
+  d.consumed = d.pos;
+  d.peeked = false;
+}
+
+//////////////////////////////////////////////////
+bool LineReader::NextRealLine(StringView &_line, int &_lineNumber)
+{
+  bool found = this->Peek(_line);
+  this->Consume(_lineNumber);
+  return found;
+}
+
+//////////////////////////////////////////////////
+bool LineReader::Remaining(StringView &_content) const
+{
+  auto &d = *this->dataPtr;
+  if (d.stream)
+    return false;
+
+  _content = StringView(d.data + d.consumed, d.size - d.consumed);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LineReader::Skip(const size_t _size, int &_lineNumber)
+{
+  auto &d = *this->dataPtr;
+  if (d.stream || _size > d.size - d.consumed)
+    return false;
+
+  // Count the lines the same way ReadLine() does: an unterminated last line
+  // is a line too.
+  const char *start = d.data + d.consumed;
+  const char *end = start + _size;
+  for (const char *p = start; p < end; ++p)
+  {
+    p = static_cast<const char *>(std::memchr(p, '\n', end - p));
+    if (!p)
+    {
+      ++_lineNumber;
+      break;
+    }
+    ++_lineNumber;
+  }
+
+  d.consumed += _size;
+  d.pos = d.consumed;
+  d.peeked = false;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool LineReader::Eof() const
+{
+  auto &d = *this->dataPtr;
+  return (!d.peeked || d.peekLines == 0) && d.RawEof();
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <fstream>
+#include <istream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/StringView.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+// The fixture for testing LineReader class.
+class LineReaderTest : public testing::FileParserUtils
+{
+};
+
+//////////////////////////////////////////////////
+/// \brief Check that the lines returned by NextRealLine() are trimmed
+/// exactly as trimWhitespaces() does.
+TEST(LineReader, NextRealLine)
+{
+  const std::vector<std::string> lines =
+  {
+    "segment 1",
+    "  segment   1 ",
+    "\tnum_lanes\t2\r",
+    "lane_width 12 /* comment */",
+    "/* only a comment */",
+    "   ",
+    "a/*b*/c /* d */",
+    "",
+    "1.1.1\t34.587489\t-117.367106",
+  };
+
+  std::string content;
+  for (auto const &line : lines)
+    content += line + "\n";
+
+  std::vector<std::pair<std::string, int>> expected;
+  for (size_t i = 0; i < lines.size(); ++i)
+  {
+    std::string trimmed = lines[i];
+    trimWhitespaces(trimmed);
+    if (!trimmed.empty())
+      expected.push_back({trimmed, static_cast<int>(i) + 1});
+  }
+
+  LineReader reader(content.data(), content.size());
+  int lineNumber = 0;
+  StringView line;
+  for (auto const &entry : expected)
+  {
+    ASSERT_TRUE(reader.NextRealLine(line, lineNumber));
+    EXPECT_EQ(line.String(), entry.first);
+    EXPECT_EQ(lineNumber, entry.second);
+  }
+
+  EXPECT_FALSE(reader.NextRealLine(line, lineNumber));
+  EXPECT_TRUE(line.Empty());
+  EXPECT_EQ(lineNumber, static_cast<int>(lines.size()));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the one line lookahead.
+TEST(LineReader, PeekConsume)
+{
+  const std::string content = "one\n\n  two \nthree";
+  LineReader reader(content.data(), content.size());
+
+  StringView line;
+  int lineNumber = 0;
+  EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+  EXPECT_EQ(line, "one");
+  EXPECT_EQ(lineNumber, 1);
+
+  // Peeking doesn't advance the reader.
+  EXPECT_TRUE(reader.Peek(line));
+  EXPECT_EQ(line, "two");
+  EXPECT_TRUE(reader.Peek(line));
+  EXPECT_EQ(line, "two");
+  EXPECT_EQ(lineNumber, 1);
+
+  // Consuming accounts for the blank line skipped.
+  reader.Consume(lineNumber);
+  EXPECT_EQ(lineNumber, 3);
+
+  EXPECT_FALSE(reader.Eof());
+  EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+  EXPECT_EQ(line, "three");
+  EXPECT_EQ(lineNumber, 4);
+  EXPECT_TRUE(reader.Eof());
+
+  EXPECT_FALSE(reader.Peek(line));
+  EXPECT_TRUE(line.Empty());
+  EXPECT_FALSE(reader.NextRealLine(line, lineNumber));
+  EXPECT_EQ(lineNumber, 4);
+
+  LineReader empty;
+  EXPECT_TRUE(empty.Eof());
+  EXPECT_FALSE(empty.Peek(line));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check access to the content not consumed yet.
+TEST(LineReader, RemainingSkip)
+{
+  const std::string content = "one\n\n  two \nthree\nfour";
+  LineReader reader(content.data(), content.size());
+
+  StringView rest;
+  ASSERT_TRUE(reader.Remaining(rest));
+  EXPECT_EQ(rest, content);
+
+  // Peeked lines aren't consumed.
+  StringView line;
+  int lineNumber = 0;
+  EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+  EXPECT_TRUE(reader.Peek(line));
+  EXPECT_EQ(line, "two");
+  ASSERT_TRUE(reader.Remaining(rest));
+  EXPECT_EQ(rest, "\n  two \nthree\nfour");
+
+  // Skip the blank line and "two".
+  EXPECT_TRUE(reader.Skip(8, lineNumber));
+  EXPECT_EQ(lineNumber, 3);
+  EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+  EXPECT_EQ(line, "three");
+  EXPECT_EQ(lineNumber, 4);
+
+  // An unterminated last line counts as a line.
+  EXPECT_FALSE(reader.Skip(5, lineNumber));
+  EXPECT_TRUE(reader.Skip(4, lineNumber));
+  EXPECT_EQ(lineNumber, 5);
+  EXPECT_TRUE(reader.Eof());
+  ASSERT_TRUE(reader.Remaining(rest));
+  EXPECT_TRUE(rest.Empty());
+
+  // Streams don't support it.
+  std::istringstream stream(content);
+  LineReader streamReader(stream);
+  EXPECT_FALSE(streamReader.Remaining(rest));
+  EXPECT_FALSE(streamReader.Skip(1, lineNumber));
+  EXPECT_EQ(lineNumber, 5);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check mapping files.
+TEST_F(LineReaderTest, Open)
+{
+  LineReader reader;
+  EXPECT_FALSE(reader.Open("__nonexistent__.rndf"));
+
+  this->PopulateFile("RNDF_name\tsample\n\nnum_segments 1");
+  ASSERT_TRUE(reader.Open(this->fileName));
+
+  StringView line;
+  int lineNumber = 0;
+  EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+  EXPECT_EQ(line, "RNDF_name sample");
+  EXPECT_EQ(lineNumber, 1);
+  EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+  EXPECT_EQ(line, "num_segments 1");
+  EXPECT_EQ(lineNumber, 3);
+  EXPECT_FALSE(reader.NextRealLine(line, lineNumber));
+
+  // Empty files are valid.
+  std::ofstream(this->fileName, std::ios::trunc).close();
+  ASSERT_TRUE(reader.Open(this->fileName));
+  EXPECT_TRUE(reader.Eof());
+  EXPECT_FALSE(reader.NextRealLine(line, lineNumber));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a stream is left right after the last line consumed.
+TEST_F(LineReaderTest, Stream)
+{
+  this->PopulateFile("\nfirst\nsecond\nthird");
+  std::ifstream f(this->fileName);
+
+  {
+    LineReader reader(f);
+    StringView line;
+    int lineNumber = 0;
+    EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+    EXPECT_EQ(line, "first");
+    EXPECT_EQ(lineNumber, 2);
+  }
+
+  std::string next;
+  ASSERT_TRUE(std::getline(f, next).good());
+  EXPECT_EQ(next, "second");
+
+  // A line peeked and not consumed is given back to the stream.
+  {
+    LineReader reader(f);
+    StringView line;
+    EXPECT_TRUE(reader.Peek(line));
+    EXPECT_EQ(line, "third");
+  }
+
+  ASSERT_TRUE(std::getline(f, next).good());
+  EXPECT_EQ(next, "third");
+}
+
+//////////////////////////////////////////////////
+/// \brief A stream buffer that can't be rewound, like a pipe.
+class ForwardOnlyBuf : public std::streambuf
+{
+  /// \brief Constructor.
+  /// \param[in] _content Content to serve.
+  public: explicit ForwardOnlyBuf(const std::string &_content)
+    : content(_content)
+  {
+    char *data = &this->content[0];
+    this->setg(data, data, data + this->content.size());
+  }
+
+  /// \brief The content served.
+  private: std::string content;
+};
+
+//////////////////////////////////////////////////
+/// \brief Check reading from a non-seekable stream.
+TEST(LineReader, NonSeekableStream)
+{
+  ForwardOnlyBuf buf("first\n/* comment */\nsecond  \n");
+  std::istream stream(&buf);
+  ASSERT_EQ(stream.tellg(), std::streampos(-1));
+
+  LineReader reader(stream);
+  StringView line;
+  int lineNumber = 0;
+  EXPECT_TRUE(reader.Peek(line));
+  EXPECT_EQ(line, "first");
+  EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+  EXPECT_EQ(line, "first");
+  EXPECT_TRUE(reader.NextRealLine(line, lineNumber));
+  EXPECT_EQ(line, "second");
+  EXPECT_EQ(lineNumber, 3);
+  EXPECT_TRUE(reader.Eof());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,326 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <ignition/math/Helpers.hh>
+
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/LocalCoordinates.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for LocalCoordinates class.
+    /// A location is converted to Earth-centered coordinates on the WGS84
+    /// ellipsoid, already rotated around the polar axis by the longitude of
+    /// the origin, and then to the east and north axes of the plane tangent
+    /// to the ellipsoid at the origin.
+    class LocalCoordinatesPrivate
+    {
+      /// \brief Set the origin of the frame.
+      /// \param[in] _latitude Latitude in degrees.
+      /// \param[in] _longitude Longitude in degrees.
+      public: void SetOrigin(const double _latitude, const double _longitude)
+      {
+        this->originLatitude = _latitude;
+        this->originLongitude = _longitude;
+        this->sinOriginLat = std::sin(IGN_DTOR(_latitude));
+        this->cosOriginLat = std::cos(IGN_DTOR(_latitude));
+        const double n = this->PrimeVerticalRadius(this->sinOriginLat);
+        this->originX = n * this->cosOriginLat;
+        this->originZ = n * (1 - kEccentricity2) * this->sinOriginLat;
+      }
+
+      /// \brief Project locations to the frame, in a single pass without
+      /// branches.
+      /// \param[in] _latitudes Latitudes in degrees.
+      /// \param[in] _longitudes Longitudes in degrees.
+      /// \param[in] _size Number of locations.
+      /// \param[out] _east East coordinates in meters.
+      /// \param[out] _north North coordinates in meters.
+      public: void Project(const double *_latitudes,
+                           const double *_longitudes, const size_t _size,
+                           double *_east, double *_north) const
+      {
+        for (size_t i = 0; i < _size; ++i)
+        {
+          const double lat = IGN_DTOR(_latitudes[i]);
+          const double dLon = IGN_DTOR(_longitudes[i] - this->originLongitude);
+          const double sinLat = std::sin(lat);
+          const double n = this->PrimeVerticalRadius(sinLat);
+          const double r = n * std::cos(lat);
+          const double x = r * std::cos(dLon) - this->originX;
+          const double z = n * (1 - kEccentricity2) * sinLat - this->originZ;
+          _east[i] = r * std::sin(dLon);
+          _north[i] = this->cosOriginLat * z - this->sinOriginLat * x;
+        }
+      }
+
+      /// \brief Get the radius of curvature of the ellipsoid in the prime
+      /// vertical.
+      /// \param[in] _sinLat Sine of the latitude.
+      /// \return The radius in meters.
+      public: static double PrimeVerticalRadius(const double _sinLat)
+      {
+        return kSemiMajorAxis /
+          std::sqrt(1 - kEccentricity2 * _sinLat * _sinLat);
+      }
+
+      /// \brief Semi-major axis of the WGS84 ellipsoid in meters.
+      public: static const double kSemiMajorAxis;
+
+      /// \brief Squared first eccentricity of the WGS84 ellipsoid.
+      public: static const double kEccentricity2;
+
+      /// \brief Latitude of the origin in degrees.
+      public: double originLatitude = 0;
+
+      /// \brief Longitude of the origin in degrees.
+      public: double originLongitude = 0;
+
+      /// \brief Sine of the latitude of the origin.
+      public: double sinOriginLat = 0;
+
+      /// \brief Cosine of the latitude of the origin.
+      public: double cosOriginLat = 1;
+
+      /// \brief Distance of the origin to the polar axis in meters.
+      public: double originX = kSemiMajorAxis;
+
+      /// \brief Distance of the origin to the equatorial plane in meters.
+      public: double originZ = 0;
+
+      /// \brief East coordinates of the waypoints in meters.
+      public: std::vector<double> east;
+
+      /// \brief North coordinates of the waypoints in meters.
+      public: std::vector<double> north;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+const double LocalCoordinatesPrivate::kSemiMajorAxis = 6378137.0;
+
+//////////////////////////////////////////////////
+const double LocalCoordinatesPrivate::kEccentricity2 =
+  (2 - 1 / 298.257223563) / 298.257223563;
+
+//////////////////////////////////////////////////
+LocalCoordinates::LocalCoordinates()
+  : dataPtr(new LocalCoordinatesPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+LocalCoordinates::LocalCoordinates(const CoordinateSnapshot &_coordinates)
+  : LocalCoordinates()
+{
+  this->Update(_coordinates);
+}
+
+//////////////////////////////////////////////////
+LocalCoordinates::LocalCoordinates(const LocalCoordinates &_other)
+  : LocalCoordinates()
+{
+  *this = _other;
+}
+
+//////////////////////////////////////////////////
+LocalCoordinates::~LocalCoordinates()
+{
+}
+
+//////////////////////////////////////////////////
+void LocalCoordinates::Update(const CoordinateSnapshot &_coordinates)
+{
+  const size_t size = _coordinates.Size();
+  double latitude = 0;
+  double longitude = 0;
+  for (size_t i = 0; i < size; ++i)
+  {
+    latitude += _coordinates.Latitudes()[i];
+    longitude += _coordinates.Longitudes()[i];
+  }
+  if (size > 0)
+  {
+    latitude /= static_cast<double>(size);
+    longitude /= static_cast<double>(size);
+  }
+  this->Update(_coordinates, latitude, longitude);
+}
+
+//////////////////////////////////////////////////
+void LocalCoordinates::Update(const CoordinateSnapshot &_coordinates,
+  const double _originLatitude, const double _originLongitude)
+{
+  LocalCoordinatesPrivate &data = *this->dataPtr;
+  const size_t size = _coordinates.Size();
+  data.SetOrigin(_originLatitude, _originLongitude);
+  data.east.resize(size);
+  data.north.resize(size);
+  data.Project(_coordinates.Latitudes().data(),
+    _coordinates.Longitudes().data(), size, data.east.data(),
+    data.north.data());
+}
+
+//////////////////////////////////////////////////
+void LocalCoordinates::Update(const CoordinateSnapshot &_coordinates,
+  const std::vector<uint32_t> &_moved)
+{
+  LocalCoordinatesPrivate &data = *this->dataPtr;
+  if (_coordinates.Size() != data.east.size())
+  {
+    this->Update(_coordinates, data.originLatitude, data.originLongitude);
+    return;
+  }
+
+  for (auto const pos : _moved)
+  {
+    data.Project(&_coordinates.Latitudes()[pos],
+      &_coordinates.Longitudes()[pos], 1, &data.east[pos], &data.north[pos]);
+  }
+}
+
+//////////////////////////////////////////////////
+size_t LocalCoordinates::Size() const
+{
+  return this->dataPtr->east.size();
+}
+
+//////////////////////////////////////////////////
+double LocalCoordinates::OriginLatitude() const
+{
+  return this->dataPtr->originLatitude;
+}
+
+//////////////////////////////////////////////////
+double LocalCoordinates::OriginLongitude() const
+{
+  return this->dataPtr->originLongitude;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &LocalCoordinates::East() const
+{
+  return this->dataPtr->east;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &LocalCoordinates::North() const
+{
+  return this->dataPtr->north;
+}
+
+//////////////////////////////////////////////////
+void LocalCoordinates::Project(const double _latitude,
+  const double _longitude, double &_east, double &_north) const
+{
+  this->dataPtr->Project(&_latitude, &_longitude, 1, &_east, &_north);
+}
+
+//////////////////////////////////////////////////
+void LocalCoordinates::Unproject(const double _east, const double _north,
+  double &_latitude, double &_longitude) const
+{
+  const LocalCoordinatesPrivate &data = *this->dataPtr;
+  _latitude = data.originLatitude;
+  _longitude = data.originLongitude;
+
+  // Newton's method, with the meters per degree at the current estimate as
+  // the derivatives of the projection. It converges to a fraction of a
+  // millimeter in a few iterations within hundreds of kilometers.
+  const int kMaxIterations = 10;
+  const double kTolerance = 1e-9;
+  double east = 0;
+  double north = 0;
+  for (int i = 0; i < kMaxIterations; ++i)
+  {
+    const double errorEast = _east - east;
+    const double errorNorth = _north - north;
+    if (std::abs(errorEast) < kTolerance && std::abs(errorNorth) < kTolerance)
+      break;
+
+    const double sinLat = std::sin(IGN_DTOR(_latitude));
+    const double n = LocalCoordinatesPrivate::PrimeVerticalRadius(sinLat);
+    const double e2 = LocalCoordinatesPrivate::kEccentricity2;
+    const double meridionalRadius =
+      n * (1 - e2) / (1 - e2 * sinLat * sinLat);
+    _latitude += errorNorth / IGN_DTOR(meridionalRadius);
+    _longitude += errorEast /
+      IGN_DTOR(n * std::cos(IGN_DTOR(_latitude)));
+    this->Project(_latitude, _longitude, east, north);
+  }
+}
+
+//////////////////////////////////////////////////
+double LocalCoordinates::Distance(const uint32_t _a, const uint32_t _b) const
+{
+  const LocalCoordinatesPrivate &data = *this->dataPtr;
+  return std::hypot(data.east[_b] - data.east[_a],
+    data.north[_b] - data.north[_a]);
+}
+
+//////////////////////////////////////////////////
+double LocalCoordinates::Heading(const uint32_t _a, const uint32_t _b) const
+{
+  const LocalCoordinatesPrivate &data = *this->dataPtr;
+  return std::atan2(data.north[_b] - data.north[_a],
+    data.east[_b] - data.east[_a]);
+}
+
+//////////////////////////////////////////////////
+double LocalCoordinates::Curvature(const uint32_t _a, const uint32_t _b,
+  const uint32_t _c) const
+{
+  const LocalCoordinatesPrivate &data = *this->dataPtr;
+  const double abx = data.east[_b] - data.east[_a];
+  const double aby = data.north[_b] - data.north[_a];
+  const double acx = data.east[_c] - data.east[_a];
+  const double acy = data.north[_c] - data.north[_a];
+
+  // Twice the signed area of the triangle over the product of its sides.
+  const double sides = this->Distance(_a, _b) * this->Distance(_b, _c) *
+    this->Distance(_a, _c);
+  if (sides <= 0)
+    return 0;
+  return 2 * (abx * acy - aby * acx) / sides;
+}
+
+//////////////////////////////////////////////////
+double LocalCoordinates::Length(const CoordinateRange &_range) const
+{
+  double length = 0;
+  for (uint32_t i = _range.begin + 1; i < _range.end; ++i)
+    length += this->Distance(i - 1, i);
+  return length;
+}
+
+//////////////////////////////////////////////////
+LocalCoordinates &LocalCoordinates::operator=(
+  const LocalCoordinates &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
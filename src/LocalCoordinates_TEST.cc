@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <string>
+#include <utility>
+#include <vector>
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/SphericalCoordinates.hh>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LocalCoordinates.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/Waypoint.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+//////////////////////////////////////////////////
+/// \brief Reference conversion of a location to the east-north-up frame of
+/// an origin, through Earth-centered, Earth-fixed coordinates on the WGS84
+/// ellipsoid.
+/// \param[in] _lat0 Latitude of the origin in degrees.
+/// \param[in] _lon0 Longitude of the origin in degrees.
+/// \param[in] _lat Latitude in degrees.
+/// \param[in] _lon Longitude in degrees.
+/// \param[out] _east East coordinate in meters.
+/// \param[out] _north North coordinate in meters.
+void enu(const double _lat0, const double _lon0, const double _lat,
+  const double _lon, double &_east, double &_north)
+{
+  const double a = 6378137.0;
+  const double f = 1 / 298.257223563;
+  const double e2 = f * (2 - f);
+  auto ecef = [&](const double _la, const double _lo, double _p[3])
+  {
+    const double la = IGN_DTOR(_la);
+    const double lo = IGN_DTOR(_lo);
+    const double n = a / std::sqrt(1 - e2 * std::sin(la) * std::sin(la));
+    _p[0] = n * std::cos(la) * std::cos(lo);
+    _p[1] = n * std::cos(la) * std::sin(lo);
+    _p[2] = n * (1 - e2) * std::sin(la);
+  };
+  double p0[3];
+  double p[3];
+  ecef(_lat0, _lon0, p0);
+  ecef(_lat, _lon, p);
+  const double dx = p[0] - p0[0];
+  const double dy = p[1] - p0[1];
+  const double dz = p[2] - p0[2];
+  const double la0 = IGN_DTOR(_lat0);
+  const double lo0 = IGN_DTOR(_lon0);
+  _east = -std::sin(lo0) * dx + std::cos(lo0) * dy;
+  _north = -std::sin(la0) * std::cos(lo0) * dx -
+    std::sin(la0) * std::sin(lo0) * dy + std::cos(la0) * dz;
+}
+
+//////////////////////////////////////////////////
+/// \brief Create a RNDF with a single lane.
+/// \param[in] _latitudes Latitudes of the waypoints of the lane.
+/// \param[in] _longitudes Longitudes of the waypoints of the lane.
+/// \param[out] _rndf The RNDF.
+void singleLane(const std::vector<double> &_latitudes,
+  const std::vector<double> &_longitudes, RNDF &_rndf)
+{
+  Lane lane(1);
+  for (size_t i = 0; i < _latitudes.size(); ++i)
+  {
+    ASSERT_TRUE(lane.AddWaypoint(Waypoint(static_cast<int>(i + 1),
+      _latitudes[i], _longitudes[i])));
+  }
+  Segment segment(1);
+  ASSERT_TRUE(segment.AddLane(lane));
+  ASSERT_TRUE(_rndf.AddSegment(segment));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the default local coordinates.
+TEST(LocalCoordinates, empty)
+{
+  LocalCoordinates local;
+  EXPECT_EQ(local.Size(), 0u);
+  EXPECT_TRUE(local.East().empty());
+  EXPECT_TRUE(local.North().empty());
+  EXPECT_DOUBLE_EQ(local.OriginLatitude(), 0.0);
+  EXPECT_DOUBLE_EQ(local.OriginLongitude(), 0.0);
+
+  double east;
+  double north;
+  local.Project(0, 0, east, north);
+  EXPECT_NEAR(east, 0, 1e-9);
+  EXPECT_NEAR(north, 0, 1e-9);
+
+  local.Update(CoordinateSnapshot());
+  EXPECT_EQ(local.Size(), 0u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the projection against a conversion through Earth-centered
+/// coordinates, and its inverse.
+TEST(LocalCoordinates, projection)
+{
+  RNDF rndf;
+  singleLane({37.0, 37.01, 36.95, 37.2, -33.9},
+    {-122.0, -122.05, -121.9, -122.3, 151.2}, rndf);
+  LocalCoordinates local;
+  local.Update(rndf.Coordinates(), 37.0, -122.0);
+  EXPECT_DOUBLE_EQ(local.OriginLatitude(), 37.0);
+  EXPECT_DOUBLE_EQ(local.OriginLongitude(), -122.0);
+  ASSERT_EQ(local.Size(), 5u);
+  ASSERT_EQ(local.East().size(), 5u);
+  ASSERT_EQ(local.North().size(), 5u);
+
+  EXPECT_NEAR(local.East()[0], 0, 1e-9);
+  EXPECT_NEAR(local.North()[0], 0, 1e-9);
+  for (size_t i = 0; i < local.Size(); ++i)
+  {
+    const double lat = rndf.Coordinates().Latitudes()[i];
+    const double lon = rndf.Coordinates().Longitudes()[i];
+    double east;
+    double north;
+    enu(37.0, -122.0, lat, lon, east, north);
+    EXPECT_NEAR(local.East()[i], east, 1e-6);
+    EXPECT_NEAR(local.North()[i], north, 1e-6);
+
+    local.Project(lat, lon, east, north);
+    EXPECT_DOUBLE_EQ(local.East()[i], east);
+    EXPECT_DOUBLE_EQ(local.North()[i], north);
+  }
+
+  // A hundredth of a degree of latitude is about 1110 meters, and a
+  // twentieth of a degree of longitude about 4450 meters at this latitude.
+  // The tangent plane adds about a meter to the north, as the meridians
+  // converge.
+  EXPECT_NEAR(local.North()[1], 1110.9, 0.5);
+  EXPECT_NEAR(local.East()[1], -4450.5, 2.0);
+
+  // Unproject near the origin.
+  for (auto const &point : {std::make_pair(0.0, 0.0),
+                            std::make_pair(150.0, -20.0),
+                            std::make_pair(-8000.0, 12000.0),
+                            std::make_pair(40000.0, 35000.0)})
+  {
+    double lat;
+    double lon;
+    local.Unproject(point.first, point.second, lat, lon);
+    double east;
+    double north;
+    local.Project(lat, lon, east, north);
+    EXPECT_NEAR(east, point.first, 1e-6);
+    EXPECT_NEAR(north, point.second, 1e-6);
+  }
+
+  double lat;
+  double lon;
+  local.Unproject(local.East()[2], local.North()[2], lat, lon);
+  EXPECT_NEAR(lat, 36.95, 1e-10);
+  EXPECT_NEAR(lon, -121.9, 1e-10);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the automatic origin is the centroid.
+TEST(LocalCoordinates, centroid)
+{
+  RNDF rndf;
+  singleLane({10.0, 10.002, 10.004}, {20.0, 20.003, 20.0}, rndf);
+  LocalCoordinates local(rndf.Coordinates());
+  EXPECT_DOUBLE_EQ(local.OriginLatitude(), 10.002);
+  EXPECT_DOUBLE_EQ(local.OriginLongitude(), 20.001);
+
+  // Symmetric around the origin.
+  EXPECT_NEAR(local.East()[0], local.East()[2], 1e-2);
+  EXPECT_NEAR(local.North()[0], -local.North()[2], 1e-2);
+
+  LocalCoordinates copy(local);
+  EXPECT_EQ(copy.East(), local.East());
+  EXPECT_EQ(copy.North(), local.North());
+  EXPECT_DOUBLE_EQ(copy.OriginLatitude(), local.OriginLatitude());
+
+  LocalCoordinates assigned;
+  assigned = local;
+  EXPECT_EQ(assigned.East(), local.East());
+  EXPECT_DOUBLE_EQ(assigned.OriginLongitude(), local.OriginLongitude());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the distances, headings, curvatures and lengths.
+TEST(LocalCoordinates, geometry)
+{
+  // Five waypoints a quarter of a circle of 100 meters apart,
+  // counterclockwise, and then straight to the east.
+  LocalCoordinates frame;
+  frame.Update(CoordinateSnapshot(), 45.0, 7.0);
+  std::vector<double> latitudes;
+  std::vector<double> longitudes;
+  for (int i = 0; i <= 4; ++i)
+  {
+    const double angle = IGN_PI / 8 * i - IGN_PI / 2;
+    double lat;
+    double lon;
+    frame.Unproject(100 * std::cos(angle), 100 * std::sin(angle), lat, lon);
+    latitudes.push_back(lat);
+    longitudes.push_back(lon);
+  }
+  double lat;
+  double lon;
+  frame.Unproject(200, 0, lat, lon);
+  latitudes.push_back(lat);
+  longitudes.push_back(lon);
+
+  RNDF rndf;
+  singleLane(latitudes, longitudes, rndf);
+  LocalCoordinates local;
+  local.Update(rndf.Coordinates(), 45.0, 7.0);
+  ASSERT_EQ(local.Size(), 6u);
+
+  const double chord = 200 * std::sin(IGN_PI / 16);
+  EXPECT_NEAR(local.Distance(0, 1), chord, 1e-6);
+  EXPECT_NEAR(local.Distance(1, 0), chord, 1e-6);
+  EXPECT_NEAR(local.Distance(0, 4), 100 * std::sqrt(2.0), 1e-6);
+  EXPECT_NEAR(local.Distance(4, 5), 100, 1e-6);
+  EXPECT_DOUBLE_EQ(local.Distance(3, 3), 0.0);
+
+  EXPECT_NEAR(local.Heading(0, 4), IGN_PI / 4, 1e-9);
+  EXPECT_NEAR(local.Heading(4, 0), -3 * IGN_PI / 4, 1e-9);
+  EXPECT_NEAR(local.Heading(4, 5), 0, 1e-9);
+  EXPECT_NEAR(std::abs(local.Heading(5, 4)), IGN_PI, 1e-9);
+
+  EXPECT_NEAR(local.Curvature(0, 1, 2), 0.01, 1e-9);
+  EXPECT_NEAR(local.Curvature(1, 2, 4), 0.01, 1e-9);
+  EXPECT_NEAR(local.Curvature(2, 1, 0), -0.01, 1e-9);
+  EXPECT_DOUBLE_EQ(local.Curvature(0, 0, 1), 0.0);
+  EXPECT_NEAR(local.Curvature(2, 4, 2), 0, 1e-9);
+
+  ASSERT_EQ(rndf.Coordinates().Ranges().size(), 1u);
+  const CoordinateRange &range = rndf.Coordinates().Ranges()[0];
+  EXPECT_NEAR(local.Length(range), 4 * chord + 100, 1e-6);
+  CoordinateRange single = range;
+  single.end = single.begin + 1;
+  EXPECT_DOUBLE_EQ(local.Length(single), 0.0);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the lengths of the lanes of a RNDF against the great-circle
+/// distances.
+TEST(LocalCoordinates, lanes)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+
+  const CoordinateSnapshot &snapshot = rndf.Coordinates();
+  LocalCoordinates local(snapshot);
+  ASSERT_EQ(local.Size(), snapshot.Size());
+  for (auto const &range : snapshot.Ranges())
+  {
+    double expected = 0;
+    for (uint32_t i = range.begin + 1; i < range.end; ++i)
+    {
+      expected += math::SphericalCoordinates::Distance(
+        math::Angle(IGN_DTOR(snapshot.Latitudes()[i - 1])),
+        math::Angle(IGN_DTOR(snapshot.Longitudes()[i - 1])),
+        math::Angle(IGN_DTOR(snapshot.Latitudes()[i])),
+        math::Angle(IGN_DTOR(snapshot.Longitudes()[i])));
+    }
+    // The ellipsoid and the sphere differ by less than a percent.
+    EXPECT_NEAR(local.Length(range), expected, 0.01 * expected);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the local coordinates kept by a RNDF.
+TEST(LocalCoordinates, rndf)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  EXPECT_FALSE(rndf.HasOrigin());
+  EXPECT_EQ(rndf.LocalCoordinates().Size(), 0u);
+
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const RNDF &constRndf = rndf;
+  const LocalCoordinates &local = constRndf.LocalCoordinates();
+  const LocalCoordinates expected(constRndf.Coordinates());
+  EXPECT_EQ(local.Size(), constRndf.Coordinates().Size());
+  EXPECT_DOUBLE_EQ(local.OriginLatitude(), expected.OriginLatitude());
+  EXPECT_DOUBLE_EQ(local.OriginLongitude(), expected.OriginLongitude());
+  EXPECT_EQ(local.East(), expected.East());
+  EXPECT_EQ(local.North(), expected.North());
+
+  // Const access doesn't project again.
+  const double *east = local.East().data();
+  EXPECT_EQ(constRndf.Segments().size(), 13u);
+  EXPECT_EQ(constRndf.LocalCoordinates().East().data(), east);
+
+  // Set the origin.
+  const double lat = constRndf.Coordinates().Latitudes()[3];
+  const double lon = constRndf.Coordinates().Longitudes()[3];
+  rndf.SetOrigin(lat, lon);
+  EXPECT_TRUE(rndf.HasOrigin());
+  EXPECT_DOUBLE_EQ(constRndf.LocalCoordinates().OriginLatitude(), lat);
+  EXPECT_DOUBLE_EQ(constRndf.LocalCoordinates().OriginLongitude(), lon);
+  EXPECT_NEAR(local.East()[3], 0, 1e-9);
+  EXPECT_NEAR(local.North()[3], 0, 1e-9);
+
+  // The origin set is kept when the RNDF is loaded again.
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample2.rndf"));
+  EXPECT_TRUE(rndf.HasOrigin());
+  EXPECT_DOUBLE_EQ(constRndf.LocalCoordinates().OriginLatitude(), lat);
+  EXPECT_EQ(local.Size(), constRndf.Coordinates().Size());
+
+  rndf.ClearOrigin();
+  EXPECT_FALSE(rndf.HasOrigin());
+  const LocalCoordinates centroid(constRndf.Coordinates());
+  EXPECT_DOUBLE_EQ(constRndf.LocalCoordinates().OriginLatitude(),
+    centroid.OriginLatitude());
+  EXPECT_EQ(local.East(), centroid.East());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that only the waypoints moved are projected again.
+TEST(LocalCoordinates, PartialUpdate)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+  const RNDF &constRndf = rndf;
+  const LocalCoordinates &local = constRndf.LocalCoordinates();
+  const double originLat = local.OriginLatitude();
+  const double originLon = local.OriginLongitude();
+
+  for (int round = 0; round < 5; ++round)
+  {
+    Lane lane(constRndf.Segments().at(round).Lanes().at(0));
+    for (auto &wp : lane.Waypoints())
+      wp.SetLocation(wp.Latitude() + 0.0001, wp.Longitude() - 0.0002);
+    ASSERT_TRUE(rndf.UpdateLane(constRndf.Segments().at(round).Id(), lane));
+
+    // The centroid origin stays where it was.
+    EXPECT_EQ(&constRndf.LocalCoordinates(), &local);
+    EXPECT_DOUBLE_EQ(local.OriginLatitude(), originLat);
+    EXPECT_DOUBLE_EQ(local.OriginLongitude(), originLon);
+
+    LocalCoordinates expected;
+    expected.Update(constRndf.Coordinates(), originLat, originLon);
+    ASSERT_EQ(local.Size(), expected.Size());
+    for (size_t i = 0; i < local.Size(); ++i)
+    {
+      EXPECT_DOUBLE_EQ(local.East()[i], expected.East()[i]);
+      EXPECT_DOUBLE_EQ(local.North()[i], expected.North()[i]);
+    }
+  }
+
+  // Changing the layout projects all the waypoints with a new centroid.
+  ASSERT_TRUE(rndf.RemoveSegment(13));
+  const LocalCoordinates expected(constRndf.Coordinates());
+  EXPECT_EQ(constRndf.LocalCoordinates().Size(), expected.Size());
+  EXPECT_DOUBLE_EQ(local.OriginLatitude(), expected.OriginLatitude());
+  EXPECT_EQ(local.East(), expected.East());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
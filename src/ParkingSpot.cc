@@ -17,15 +17,24 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <utility>
 #include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
 
+#include "ignition/rndf/Arena.hh"
 #include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/LineReader.hh"
 #include "ignition/rndf/ParkingSpot.hh"
 #include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/RNDFBuilder.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+#include "ignition/rndf/RNDFWriter.hh"
 #include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
 
 using namespace ignition;
 using namespace rndf;
@@ -36,7 +45,7 @@ namespace ignition
   {
     /// \internal
     /// \brief Private data for ParkingSpotHeader class.
-    class ParkingSpotHeaderPrivate
+    class ParkingSpotHeaderPrivate : public ArenaObject
     {
       /// \brief Default constructor.
       public: ParkingSpotHeaderPrivate() = default;
@@ -53,7 +62,7 @@ namespace ignition
 
     /// \internal
     /// \brief Private data for ParkingSpot class.
-    class ParkingSpotPrivate
+    class ParkingSpotPrivate : public ArenaObject
     {
       /// \brief Constructor.
       /// \param[in] _id Parking spot Id.
@@ -93,7 +102,7 @@ ParkingSpotHeader::~ParkingSpotHeader()
 }
 
 //////////////////////////////////////////////////
-bool ParkingSpotHeader::Load(std::ifstream &_rndfFile, const int _zoneId,
+bool ParkingSpotHeader::Load(LineReader &_reader, const int _zoneId,
   const int _spotId, int &_lineNumber)
 {
   double width = 0;
@@ -104,21 +113,31 @@ bool ParkingSpotHeader::Load(std::ifstream &_rndfFile, const int _zoneId,
 
   for (auto i = 0; i < 2; ++i)
   {
-    auto oldPos = _rndfFile.tellg();
-    int oldLineNumber = _lineNumber;
+    StringView lineread;
+    _reader.Peek(lineread);
+
+    Tokens tokens;
+    tokenize(lineread, " ", tokens);
 
-    std::string lineread;
-    nextRealLine(_rndfFile, lineread, _lineNumber);
+    // Any other element is the start of the waypoint section, which is left
+    // for the waypoint parser.
+    if (tokens.Size() >= 2          &&
+        tokens[0] != "spot_width"   &&
+        tokens[0] != "checkpoint")
+    {
+      break;
+    }
 
-    auto tokens = split(lineread, " ");
-    if ((tokens.size() < 2)                             ||
+    _reader.Consume(_lineNumber);
+    if ((tokens.Size() < 2)                             ||
         (tokens[0] == "spot_width"  && widthFound)      ||
         (tokens[0] == "checkpoint"  && checkpointFound))
     {
       // Invalid or repeated header element.
-      std::cerr << "[Line " << _lineNumber << "]: Unable to parse spot header "
-                << "element." << std::endl;
-      std::cerr << " \"" << lineread << "\"" << std::endl;
+      errorStream() << "[Line " << _lineNumber
+                    << "]: Unable to parse spot header "
+                    << "element." << std::endl;
+      errorStream() << " \"" << lineread << "\"" << std::endl;
       return false;
     }
 
@@ -127,9 +146,9 @@ bool ParkingSpotHeader::Load(std::ifstream &_rndfFile, const int _zoneId,
       int widthFeet;
       if (!parsePositive(lineread, "spot_width", widthFeet))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "spot width element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "spot width element" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
@@ -137,27 +156,18 @@ bool ParkingSpotHeader::Load(std::ifstream &_rndfFile, const int _zoneId,
       width = widthFeet * 0.3048;
       widthFound = true;
     }
-    else if (tokens[0] == "checkpoint")
+    else
     {
       if (!parseCheckpoint(lineread, _zoneId, _spotId, cp))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "spot checkpoint element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "spot checkpoint element" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
       checkpointFound = true;
     }
-    else
-    {
-      // This is the end of the header and the start of the waypoint section.
-      // Restore the file position and line number.
-      // ParseHeader() shouldn't have any effect.
-      _rndfFile.seekg(oldPos);
-      _lineNumber = oldLineNumber;
-      break;
-    }
   }
 
   // Populate the header.
@@ -167,6 +177,14 @@ bool ParkingSpotHeader::Load(std::ifstream &_rndfFile, const int _zoneId,
   return true;
 }
 
+//////////////////////////////////////////////////
+bool ParkingSpotHeader::Load(std::ifstream &_rndfFile, const int _zoneId,
+  const int _spotId, int &_lineNumber)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _zoneId, _spotId, _lineNumber);
+}
+
 //////////////////////////////////////////////////
 double ParkingSpotHeader::Width() const
 {
@@ -214,97 +232,134 @@ ParkingSpot::ParkingSpot(const ParkingSpot &_other)
   *this = _other;
 }
 
+//////////////////////////////////////////////////
+ParkingSpot::ParkingSpot(ParkingSpot &&_other) noexcept  // NOLINT
+  : dataPtr(std::move(_other.dataPtr))
+{
+}
+
 //////////////////////////////////////////////////
 ParkingSpot::~ParkingSpot()
 {
 }
 
 //////////////////////////////////////////////////
-bool ParkingSpot::Load(std::ifstream &_rndfFile, const int _zoneId,
+bool ParkingSpot::Load(LineReader &_reader, const int _zoneId,
   int &_lineNumber)
 {
-  std::string lineread;
-  nextRealLine(_rndfFile, lineread, _lineNumber);
+  // The spot is built inside a placeholder zone. Parking spots don't have
+  // exits and their waypoints aren't cached.
+  std::vector<ExitCacheEntry> exitCache;
+  std::vector<uint64_t> waypointCache;
+  RNDFBuilder builder(exitCache, waypointCache);
+  builder.OnZone(_zoneId, 1, "");
+
+  int spotId;
+  if (!Parse(_reader, _zoneId, _lineNumber, builder, spotId))
+    return false;
+
+  *this = std::move(builder.Zones().back().Spots().back());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ParkingSpot::Parse(LineReader &_reader, const int _zoneId,
+  int &_lineNumber, RNDFVisitor &_visitor, int &_spotId)
+{
+  StringView lineread;
+  nextRealLine(_reader, lineread, _lineNumber);
 
   // Parse the "spot Id" .
-  auto tokens =  split(lineread, " ");
-  if (tokens.size() != 2 || tokens.at(0) != "spot")
+  Tokens tokens;
+  tokenize(lineread, " ", tokens);
+  if (tokens.Size() != 2 || tokens[0] != "spot")
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse spot element"
-              << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber
+                  << "]: Unable to parse spot element"
+                  << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  auto spotIdTokens = split(tokens.at(1), ".");
-  if (spotIdTokens.size() != 2 ||
-      spotIdTokens.at(0) != std::to_string(_zoneId))
+  Tokens spotIdTokens;
+  tokenize(tokens[1], ".", spotIdTokens);
+  if (spotIdTokens.Size() != 2 ||
+      spotIdTokens[0] != std::to_string(_zoneId))
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse spot element"
-              << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber
+                  << "]: Unable to parse spot element"
+                  << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  std::string::size_type sz;
+  size_t sz;
   int spotId;
-  try
+  if (!parseInt(spotIdTokens[1], spotId, sz))
   {
-    spotId = std::stoi(spotIdTokens[1], &sz);
-  }
-  catch(...)
-  {
-    std::cout << "Exception catched" << std::endl;
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse spot element"
-              << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber
+                  << "]: Unable to parse spot element"
+                  << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  if (spotId <= 0 || spotId > 32768 || sz != spotIdTokens.at(1).size())
+  if (spotId <= 0 || spotId > 32768 || sz != spotIdTokens[1].Size())
   {
-    std::cerr << "[Line " << _lineNumber << "]: Out of range value ["
-              << spotId << "]" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber << "]: Out of range value ["
+                  << spotId << "]" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
   // Parse optional parking spot header.
   ParkingSpotHeader header;
-  if (!header.Load(_rndfFile, _zoneId, spotId, _lineNumber))
+  if (!header.Load(_reader, _zoneId, spotId, _lineNumber))
     return false;
 
+  _visitor.OnSpot(_zoneId, spotId, header.Width(), header.Checkpoint());
+
   // Parse waypoints.
-  std::vector<rndf::Waypoint> waypoints;
   for (auto i = 0; i < 2; ++i)
   {
     rndf::Waypoint waypoint;
-    if (!waypoint.Load(_rndfFile, _zoneId, spotId, _lineNumber))
+    if (!waypoint.Load(_reader, _zoneId, spotId, _lineNumber))
       return false;
 
     if (waypoint.Id() != i + 1)
     {
-      std::cerr << "[Line " << _lineNumber << "]: Found non-consecutive "
-                << "waypoint Id [" << waypoint.Id() << "]" << std::endl;
+      errorStream() << "[Line " << _lineNumber << "]: Found non-consecutive "
+                    << "waypoint Id [" << waypoint.Id() << "]" << std::endl;
       return false;
     }
 
-    waypoints.push_back(waypoint);
+    _visitor.OnWaypoint(_zoneId, spotId, waypoint);
   }
 
   // Parse "end_spot".
-  if (!parseDelimiter(_rndfFile, "end_spot", _lineNumber))
+  if (!parseDelimiter(_reader, "end_spot", _lineNumber))
     return false;
 
-  // Populate the spot.
-  this->SetId(spotId);
-  this->Waypoints() = waypoints;
-  this->SetWidth(header.Width());
-  this->Checkpoint() = header.Checkpoint();
-
+  _spotId = spotId;
   return true;
 }
 
+//////////////////////////////////////////////////
+bool ParkingSpot::Load(std::ifstream &_rndfFile, const int _zoneId,
+  int &_lineNumber)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _zoneId, _lineNumber);
+}
+
+//////////////////////////////////////////////////
+bool ParkingSpot::Save(std::ostream &_stream, const int _zoneId) const
+{
+  RNDFWriter writer(_stream);
+  writer.WriteSpot(_zoneId, *this);
+  return writer.Flush();
+}
+
 //////////////////////////////////////////////////
 int ParkingSpot::Id() const
 {
@@ -341,31 +396,33 @@ const std::vector<rndf::Waypoint> &ParkingSpot::Waypoints() const
 //////////////////////////////////////////////////
 bool ParkingSpot::Waypoint(const int _wpId, rndf::Waypoint &_wp) const
 {
-  auto it = std::find_if(this->dataPtr->waypoints.begin(),
-    this->dataPtr->waypoints.end(),
-    [_wpId](const rndf::Waypoint &_waypoint)
-    {
-      return _waypoint.Id() == _wpId;
-    });
+  const rndf::Waypoint *wp = this->Waypoint(_wpId);
+  if (wp)
+    _wp = *wp;
 
-  bool found = it != this->dataPtr->waypoints.end();
-  if (found)
-    _wp = *it;
+  return wp != nullptr;
+}
 
-  return found;
+//////////////////////////////////////////////////
+const rndf::Waypoint *ParkingSpot::Waypoint(const int _wpId) const
+{
+  return findById(this->dataPtr->waypoints, _wpId);
 }
 
 //////////////////////////////////////////////////
-bool ParkingSpot::UpdateWaypoint(const rndf::Waypoint &_wp)
+rndf::Waypoint *ParkingSpot::Waypoint(const int _wpId)
 {
-  auto it = std::find(this->dataPtr->waypoints.begin(),
-    this->dataPtr->waypoints.end(), _wp);
+  return findById(this->dataPtr->waypoints, _wpId);
+}
 
-  bool found = it != this->dataPtr->waypoints.end();
-  if (found)
-    *it = _wp;
+//////////////////////////////////////////////////
+bool ParkingSpot::UpdateWaypoint(const rndf::Waypoint &_wp)
+{
+  rndf::Waypoint *wp = this->Waypoint(_wp.Id());
+  if (wp)
+    *wp = _wp;
 
-  return found;
+  return wp != nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -374,16 +431,17 @@ bool ParkingSpot::AddWaypoint(const rndf::Waypoint &_newWaypoint)
   // Validate the waypoint.
   if (!_newWaypoint.Valid())
   {
-    std::cerr << "ParkingSpot::Addwaypoint() Invalid waypoint Id ["
-              << _newWaypoint.Id() << "]" << std::endl;
+    errorStream() << "ParkingSpot::Addwaypoint() Invalid waypoint Id ["
+                  << _newWaypoint.Id() << "]" << std::endl;
     return false;
   }
 
   // We allow a maximum of two waypoints.
   if (this->dataPtr->waypoints.size() >= 2)
   {
-    std::cerr << "ParkingSpot::AddWaypoint() We only allow two waypoints "
-              << "per spot and two waypoints were already found" << std::endl;
+    errorStream() << "ParkingSpot::AddWaypoint() We only allow two waypoints "
+                  << "per spot and two waypoints were already found"
+                  << std::endl;
     return false;
   }
 
@@ -392,8 +450,8 @@ bool ParkingSpot::AddWaypoint(const rndf::Waypoint &_newWaypoint)
         this->dataPtr->waypoints.end(), _newWaypoint) !=
           this->dataPtr->waypoints.end())
   {
-    std::cerr << "ParkingSpot::AddWaypoint() error: Existing waypoint"
-              << std::endl;
+    errorStream() << "ParkingSpot::AddWaypoint() error: Existing waypoint"
+                  << std::endl;
     return false;
   }
 
@@ -469,9 +527,20 @@ bool ParkingSpot::operator!=(const ParkingSpot &_other) const
 //////////////////////////////////////////////////
 ParkingSpot &ParkingSpot::operator=(const ParkingSpot &_other)
 {
+  // This instance might have been moved from.
+  if (!this->dataPtr)
+    this->dataPtr.reset(new ParkingSpotPrivate(-1));
+
   this->SetId(_other.Id());
   this->Waypoints() = _other.Waypoints();
   this->SetWidth(_other.Width());
   this->Checkpoint() = _other.Checkpoint();
   return *this;
 }
+
+//////////////////////////////////////////////////
+ParkingSpot &ParkingSpot::operator=(ParkingSpot &&_other) noexcept  // NOLINT
+{
+  std::swap(this->dataPtr, _other.dataPtr);
+  return *this;
+}
@@ -19,6 +19,8 @@
 #include <map>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
@@ -124,6 +126,33 @@ TEST(ParkingSpot, waypoints)
   EXPECT_EQ(spot.NumWaypoints(), 0u);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the accessors of waypoints by Id that don't copy them.
+TEST(ParkingSpot, waypointById)
+{
+  ParkingSpot spot(1);
+  for (auto const id : {1, 2, 4})
+    spot.Waypoints().emplace_back(id, 10.0, 20.0);
+  const ParkingSpot &constParkingSpot = spot;
+
+  // Consecutive and non-consecutive Ids.
+  EXPECT_EQ(constParkingSpot.Waypoint(1), &constParkingSpot.Waypoints().at(0));
+  EXPECT_EQ(constParkingSpot.Waypoint(2), &constParkingSpot.Waypoints().at(1));
+  EXPECT_EQ(constParkingSpot.Waypoint(4), &constParkingSpot.Waypoints().at(2));
+  EXPECT_EQ(constParkingSpot.Waypoint(3), nullptr);
+  EXPECT_EQ(constParkingSpot.Waypoint(0), nullptr);
+  EXPECT_EQ(constParkingSpot.Waypoint(-1), nullptr);
+
+  // Edit a waypoint in place.
+  Waypoint *mutableWaypoint = spot.Waypoint(4);
+  ASSERT_TRUE(mutableWaypoint != nullptr);
+  mutableWaypoint->SetLocation(11.0, 21.0);
+  Waypoint copy;
+  EXPECT_TRUE(spot.Waypoint(4, copy));
+  EXPECT_DOUBLE_EQ(copy.Latitude(), 11.0);
+  EXPECT_EQ(spot.Waypoint(5), nullptr);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check parking spot width.
 TEST(ParkingSpot, Width)
@@ -262,6 +291,35 @@ TEST(ParkingSpot, assignment)
   EXPECT_EQ(ps1, ps2);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check move constructor and move assignment operator.
+TEST(ParkingSpot, move)
+{
+  static_assert(std::is_nothrow_move_constructible<ParkingSpot>::value &&
+    std::is_nothrow_move_assignable<ParkingSpot>::value,
+    "ParkingSpot should be nothrow movable");
+
+  ParkingSpot ps1(1);
+  ps1.Waypoints().push_back(Waypoint(1,
+    ignition::math::SphericalCoordinates()));
+  ps1.SetWidth(2.5);
+
+  ParkingSpot ps2(std::move(ps1));
+  EXPECT_EQ(ps2.Id(), 1);
+  EXPECT_EQ(ps2.NumWaypoints(), 1u);
+  EXPECT_DOUBLE_EQ(ps2.Width(), 2.5);
+
+  // A moved-from parking spot can be assigned to.
+  ps1 = ps2;
+  EXPECT_EQ(ps1, ps2);
+  EXPECT_EQ(ps1.NumWaypoints(), 1u);
+
+  ParkingSpot ps3(3);
+  ps3 = std::move(ps2);
+  EXPECT_EQ(ps3.Id(), 1);
+  EXPECT_EQ(ps3.NumWaypoints(), 1u);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check loading a parking spot from a file.
 TEST_F(ParkingSpotTest, load)
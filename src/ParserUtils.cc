@@ -17,30 +17,135 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <locale>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "ignition/rndf/Checkpoint.hh"
 #include "ignition/rndf/Exit.hh"
 #include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LineReader.hh"
 #include "ignition/rndf/ParserUtils.hh"
 #include "ignition/rndf/UniqueId.hh"
 #include "ignition/rndf/Waypoint.hh"
 
-#ifdef _WIN32
-  const auto& ignition_rndf_strtok = strtok_s;
-  const auto& ignition_rndf_strdup = _strdup;
-#else
-  const auto& ignition_rndf_strtok = strtok_r;
-  const auto& ignition_rndf_strdup = strdup;
-#endif
-
 namespace ignition
 {
   namespace rndf
   {
+    // Out-of-line definition required by C++11 when the constant is bound to
+    // a reference.
+    const size_t Tokens::kCapacity;
+
+    /// \internal
+    /// \brief Private data for ErrorCapture class.
+    class ErrorCapturePrivate
+    {
+      /// \brief Stream of the innermost capture of the current thread, or
+      /// nullptr.
+      public: static thread_local std::ostream *current;
+    };
+
+    /////////////////////////////////////////////////
+    thread_local std::ostream *ErrorCapturePrivate::current = nullptr;
+
+    /////////////////////////////////////////////////
+    ErrorCapture::ErrorCapture(std::ostream &_stream)
+      : previous(ErrorCapturePrivate::current)
+    {
+      ErrorCapturePrivate::current = &_stream;
+    }
+
+    /////////////////////////////////////////////////
+    ErrorCapture::~ErrorCapture()
+    {
+      ErrorCapturePrivate::current = this->previous;
+    }
+
+    /////////////////////////////////////////////////
+    std::ostream &errorStream()
+    {
+      std::ostream *stream = ErrorCapturePrivate::current;
+      return stream ? *stream : std::cerr;
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Whether a character is a whitespace in the "C" locale.
+    /// \param[in] _c The character.
+    /// \return True if _c is a whitespace.
+    static bool isSpace(const char _c)
+    {
+      return _c == ' ' || (_c >= '\t' && _c <= '\r');
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Whether a string is already in the form produced by
+    /// trimWhitespaces(): no comments, no leading or trailing whitespaces and
+    /// only single ' ' characters between tokens.
+    /// \param[in] _str The string to check.
+    /// \return True if trimWhitespaces() wouldn't modify the string.
+    static bool isTrimmed(const StringView &_str)
+    {
+      if (_str.Empty())
+        return true;
+
+      if (isSpace(_str[0]) || isSpace(_str[_str.Size() - 1]))
+        return false;
+
+      for (size_t i = 1; i < _str.Size(); ++i)
+      {
+        const char c = _str[i];
+        if (c == '*' && _str[i - 1] == '/')
+          return false;
+
+        if (isSpace(c) && (c != ' ' || _str[i - 1] == ' '))
+          return false;
+      }
+
+      return true;
+    }
+
+    /////////////////////////////////////////////////
+    /// \brief Find the next token of a string.
+    /// \param[in] _str Input string.
+    /// \param[in] _delim Set of delimiter characters.
+    /// \param[in, out] _pos Position where the search starts. It's updated
+    /// to the position right after the token found.
+    /// \param[out] _token The token found.
+    /// \return True if a token was found or false otherwise.
+    static bool nextToken(const StringView &_str, const StringView &_delim,
+      size_t &_pos, StringView &_token)
+    {
+      auto isDelim = [&_delim](const char _c)
+      {
+        if (_delim.Size() == 1)
+          return _c == _delim[0];
+        return std::memchr(_delim.Data(), _c, _delim.Size()) != nullptr;
+      };
+
+      while (_pos < _str.Size() && isDelim(_str[_pos]))
+        ++_pos;
+
+      if (_pos >= _str.Size())
+        return false;
+
+      const size_t start = _pos;
+      while (_pos < _str.Size() && !isDelim(_str[_pos]))
+        ++_pos;
+
+      _token = _str.Substr(start, _pos - start);
+      return true;
+    }
+
     //////////////////////////////////////////////////
     void trimWhitespaces(std::string &_str)
     {
@@ -72,122 +177,416 @@ namespace ignition
       std::replace_if(_str.begin(), _str.end(), ::isspace, ' ');
     }
 
+    /////////////////////////////////////////////////
+    StringView trimWhitespaces(const StringView &_str, std::string &_buffer)
+    {
+      if (isTrimmed(_str))
+        return _str;
+
+      _buffer.assign(_str.Data(), _str.Size());
+      trimWhitespaces(_buffer);
+      return StringView(_buffer);
+    }
+
+    /////////////////////////////////////////////////
+    size_t tokenize(const StringView &_str, const StringView &_delim,
+      Tokens &_tokens)
+    {
+      _tokens.Clear();
+
+      size_t pos = 0;
+      StringView token;
+      while (nextToken(_str, _delim, pos, token))
+        _tokens.PushBack(token);
+
+      return _tokens.Size();
+    }
+
     /////////////////////////////////////////////////
     std::vector<std::string> split(const std::string &_str,
         const std::string &_delim)
     {
       std::vector<std::string> tokens;
-      char *saveptr;
-      char *str = ignition_rndf_strdup(_str.c_str());
 
-      auto token = ignition_rndf_strtok(str, _delim.c_str(), &saveptr);
+      size_t pos = 0;
+      StringView token;
+      while (nextToken(_str, _delim, pos, token))
+        tokens.push_back(token.String());
+
+      return tokens;
+    }
 
-      while (token)
+    /////////////////////////////////////////////////
+    bool parseInt(const StringView &_str, int &_value)
+    {
+      int value;
+      size_t size;
+      if (_str.Empty() || isSpace(_str[0]) ||
+          !parseInt(_str, value, size) || size != _str.Size())
       {
-        tokens.push_back(token);
-        token = ignition_rndf_strtok(nullptr, _delim.c_str(), &saveptr);
+        return false;
       }
 
-      free(str);
-      return tokens;
+      _value = value;
+      return true;
     }
 
-    //////////////////////////////////////////////////
-    void nextRealLine(std::ifstream &_rndfFile, std::string &_line,
-      int &_lineNumber)
+    /////////////////////////////////////////////////
+    bool parseInt(const StringView &_str, int &_value, size_t &_size)
     {
-      while (std::getline(_rndfFile, _line))
+      size_t i = 0;
+      while (i < _str.Size() && isSpace(_str[i]))
+        ++i;
+
+      bool negative = false;
+      if (i < _str.Size() && (_str[i] == '+' || _str[i] == '-'))
+        negative = _str[i++] == '-';
+
+      if (i == _str.Size() || _str[i] < '0' || _str[i] > '9')
+        return false;
+
+      // Accumulate as a negative number, which has the largest magnitude.
+      const int64_t kMin = std::numeric_limits<int>::min();
+      int64_t value = 0;
+      for (; i < _str.Size() && _str[i] >= '0' && _str[i] <= '9'; ++i)
       {
-        ++_lineNumber;
+        value = value * 10 - (_str[i] - '0');
+        if (value < kMin)
+          return false;
+      }
+
+      if (!negative)
+      {
+        value = -value;
+        if (value > std::numeric_limits<int>::max())
+          return false;
+      }
+
+      _value = static_cast<int>(value);
+      _size = i;
+      return true;
+    }
 
-        trimWhitespaces(_line);
+    /////////////////////////////////////////////////
+    /// \brief Converts the beginning of a string into a double. Leading
+    /// whitespaces are skipped and the number is a decimal number with an
+    /// optional sign, fractional part and exponent. The result is correctly
+    /// rounded.
+    /// \param[in] _str Input string.
+    /// \param[out] _value The number parsed. It's only modified on success.
+    /// \param[out] _size Number of characters used. It's only modified on
+    /// success.
+    /// \return True if _str starts with a decimal number or false otherwise.
+    static bool parseDecimal(const StringView &_str, double &_value,
+      size_t &_size)
+    {
+      // Exact powers of ten representable as a double.
+      static const double kPow10[] =
+      {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+        1e22
+      };
+
+      size_t i = 0;
+      while (i < _str.Size() && isSpace(_str[i]))
+        ++i;
+
+      const size_t first = i;
+      bool negative = false;
+      if (i < _str.Size() && (_str[i] == '+' || _str[i] == '-'))
+        negative = _str[i++] == '-';
+
+      // Mantissa, ignoring leading zeros. Only the first 19 significant
+      // digits fit in 64 bits, the rest are dropped.
+      uint64_t mantissa = 0;
+      int significantDigits = 0;
+      int exponent = 0;
+      bool digitsFound = false;
+      bool dotFound = false;
+      bool truncated = false;
+      for (; i < _str.Size(); ++i)
+      {
+        const char c = _str[i];
+        if (c == '.' && !dotFound)
+        {
+          dotFound = true;
+          continue;
+        }
 
-        // Ignore blank lines.
-        if (!_line.empty())
+        if (c < '0' || c > '9')
           break;
+
+        digitsFound = true;
+        if (significantDigits == 0 && c == '0')
+        {
+          if (dotFound)
+            --exponent;
+        }
+        else if (significantDigits < 19)
+        {
+          mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+          ++significantDigits;
+          if (dotFound)
+            --exponent;
+        }
+        else
+        {
+          if (!dotFound)
+            ++exponent;
+          truncated = truncated || c != '0';
+        }
       }
+
+      if (!digitsFound)
+        return false;
+
+      // Optional exponent. It's only part of the number if it has digits.
+      if (i < _str.Size() && (_str[i] == 'e' || _str[i] == 'E'))
+      {
+        size_t j = i + 1;
+        bool negativeExp = false;
+        if (j < _str.Size() && (_str[j] == '+' || _str[j] == '-'))
+          negativeExp = _str[j++] == '-';
+
+        if (j < _str.Size() && _str[j] >= '0' && _str[j] <= '9')
+        {
+          int exp = 0;
+          for (; j < _str.Size() && _str[j] >= '0' && _str[j] <= '9'; ++j)
+          {
+            // Saturate, the result is zero or infinity anyway.
+            if (exp < 100000)
+              exp = exp * 10 + (_str[j] - '0');
+          }
+          exponent += negativeExp ? -exp : exp;
+          i = j;
+        }
+      }
+
+      // Fast path: when both the mantissa and the power of ten are exact
+      // doubles, a single IEEE-754 operation yields the correctly rounded
+      // result.
+      if (!truncated && mantissa <= (uint64_t(1) << 53) &&
+          exponent >= -22 && exponent <= 22)
+      {
+        double value = static_cast<double>(mantissa);
+        if (exponent < 0)
+          value /= kPow10[-exponent];
+        else
+          value *= kPow10[exponent];
+
+        _value = negative ? -value : value;
+        _size = i;
+        return true;
+      }
+
+      // Slow path: delegate to the C library, which rounds correctly, using
+      // the "C" locale so that the decimal separator is always '.'.
+      std::istringstream stream(_str.Substr(first, i - first).String());
+      stream.imbue(std::locale::classic());
+      double value;
+      stream >> value;
+      if (stream.fail())
+        return false;
+
+      _value = value;
+      _size = i;
+      return true;
     }
 
-    //////////////////////////////////////////////////
-    bool parseString(std::ifstream &_rndfFile, const std::string &_delimiter,
-      std::string &_value, int &_lineNumber)
+    /////////////////////////////////////////////////
+    bool parseDouble(const StringView &_str, double &_value)
+    {
+      double value;
+      size_t size;
+      if (_str.Empty() || isSpace(_str[0]) ||
+          !parseDecimal(_str, value, size) || size != _str.Size())
+      {
+        return false;
+      }
+
+      _value = value;
+      return true;
+    }
+
+    /////////////////////////////////////////////////
+    bool parseDouble(const StringView &_str, double &_value,
+      size_t &_size)
     {
-      std::string lineread;
-      nextRealLine(_rndfFile, lineread, _lineNumber);
+      size_t i = 0;
+      while (i < _str.Size() && isSpace(_str[i]))
+        ++i;
 
-      auto tokens = split(lineread, " ");
-      if (tokens.size() != 2                                     ||
-          tokens.at(0) != _delimiter                             ||
-          tokens.at(1).find_first_of("*\\") != std::string::npos ||
-          tokens.at(1).size() > 128)
+      size_t j = i;
+      if (j < _str.Size() && (_str[j] == '+' || _str[j] == '-'))
+        ++j;
+
+      // Infinities, NaNs and hexadecimal numbers are left to the C library,
+      // as std::stod() does.
+      const char c = j < _str.Size() ? _str[j] : '\0';
+      if (c == 'i' || c == 'I' || c == 'n' || c == 'N' ||
+          (c == '0' && j + 1 < _str.Size() &&
+           (_str[j + 1] == 'x' || _str[j + 1] == 'X')))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << _delimiter << " element" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        const std::string str = _str.Substr(i).String();
+        char *end;
+        errno = 0;
+        const double value = std::strtod(str.c_str(), &end);
+        if (end == str.c_str() || errno == ERANGE)
+          return false;
+
+        _value = value;
+        _size = i + static_cast<size_t>(end - str.c_str());
+        return true;
+      }
+
+      double value;
+      size_t size;
+      if (!parseDecimal(_str, value, size))
         return false;
+
+      // Like std::stod(), reject the numbers that overflow a double and the
+      // non-zero numbers that underflow to a subnormal number or zero.
+      const bool isZero = std::fpclassify(value) == FP_ZERO;
+      if (std::isinf(value) ||
+          (!isZero && std::fabs(value) < std::numeric_limits<double>::min()))
+      {
+        return false;
+      }
+
+      if (isZero)
+      {
+        for (size_t k = i; k < size; ++k)
+        {
+          if (_str[k] == 'e' || _str[k] == 'E')
+            break;
+          if (_str[k] >= '1' && _str[k] <= '9')
+            return false;
+        }
       }
 
-      _value = tokens.at(1);
+      _value = value;
+      _size = size;
       return true;
     }
 
     //////////////////////////////////////////////////
-    bool parseDelimiter(std::ifstream &_rndfFile, const std::string &_delimiter,
+    uint64_t waypointKey(const int _x, const int _y, const int _z)
+    {
+      return (static_cast<uint64_t>(static_cast<uint32_t>(_x)) << 32) |
+             (static_cast<uint64_t>(static_cast<uint16_t>(_y)) << 16) |
+              static_cast<uint64_t>(static_cast<uint16_t>(_z));
+    }
+
+    //////////////////////////////////////////////////
+    void nextRealLine(LineReader &_reader, StringView &_line,
       int &_lineNumber)
     {
-      if (_rndfFile.eof())
-        return false;
+      _reader.NextRealLine(_line, _lineNumber);
+    }
+
+    //////////////////////////////////////////////////
+    void nextRealLine(std::ifstream &_rndfFile, std::string &_line,
+      int &_lineNumber)
+    {
+      LineReader reader(_rndfFile);
+      StringView line;
+      nextRealLine(reader, line, _lineNumber);
+      _line = line.String();
+    }
 
-      std::string lineread;
-      nextRealLine(_rndfFile, lineread, _lineNumber);
+    //////////////////////////////////////////////////
+    bool parseString(LineReader &_reader, const std::string &_delimiter,
+      std::string &_value, int &_lineNumber)
+    {
+      StringView line;
+      nextRealLine(_reader, line, _lineNumber);
 
-      if (lineread != _delimiter)
+      Tokens tokens;
+      if (tokenize(line, " ", tokens) != 2                       ||
+          tokens[0] != _delimiter                                ||
+          tokens[1].FindFirstOf("*\\") != std::string::npos      ||
+          tokens[1].Size() > 128)
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse delimiter ["
-                  << _delimiter << "]" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << _delimiter << " element" << std::endl;
+        errorStream() << " \"" << line << "\"" << std::endl;
         return false;
       }
 
+      _value = tokens[1].String();
       return true;
     }
 
     //////////////////////////////////////////////////
-    bool parsePositive(std::ifstream &_rndfFile, const std::string &_delimiter,
-      int &_value, int &_lineNumber)
+    bool parseString(std::ifstream &_rndfFile, const std::string &_delimiter,
+      std::string &_value, int &_lineNumber)
     {
-      std::string lineread;
-      nextRealLine(_rndfFile, lineread, _lineNumber);
+      LineReader reader(_rndfFile);
+      return parseString(reader, _delimiter, _value, _lineNumber);
+    }
+
+    //////////////////////////////////////////////////
+    bool parseDelimiter(LineReader &_reader, const std::string &_delimiter,
+      int &_lineNumber)
+    {
+      StringView line;
+      nextRealLine(_reader, line, _lineNumber);
 
-      auto start = lineread.find(_delimiter + " ");
-      if (start != 0)
+      if (line != _delimiter)
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse delimiter ["
-                  << _delimiter << "]" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber
+                      << "]: Unable to parse delimiter ["
+                      << _delimiter << "]" << std::endl;
+        errorStream() << " \"" << line << "\"" << std::endl;
         return false;
       }
 
-      lineread.erase(0, _delimiter.size() + 1);
+      return true;
+    }
+
+    //////////////////////////////////////////////////
+    bool parseDelimiter(std::ifstream &_rndfFile, const std::string &_delimiter,
+      int &_lineNumber)
+    {
+      LineReader reader(_rndfFile);
+      return parseDelimiter(reader, _delimiter, _lineNumber);
+    }
 
-      std::string::size_type sz;
-      try
+    //////////////////////////////////////////////////
+    bool parsePositive(LineReader &_reader, const std::string &_delimiter,
+      int &_value, int &_lineNumber)
+    {
+      StringView line;
+      nextRealLine(_reader, line, _lineNumber);
+
+      if (!line.StartsWith(_delimiter)         ||
+          line.Size() <= _delimiter.size()     ||
+          line[_delimiter.size()] != ' ')
       {
-        _value = std::stoi(lineread, &sz);
+        errorStream() << "[Line " << _lineNumber
+                      << "]: Unable to parse delimiter ["
+                      << _delimiter << "]" << std::endl;
+        errorStream() << " \"" << line << "\"" << std::endl;
+        return false;
       }
-      catch(...)
+
+      StringView lineread = line.Substr(_delimiter.size() + 1);
+
+      size_t sz;
+      if (!parseInt(lineread, _value, sz))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << _value << "as a positive number" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "value as a positive number" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
-      if (_value <= 0 || _value > 32768 || sz != lineread.size())
+      if (_value <= 0 || _value > 32768 || sz != lineread.Size())
       {
-        std::cerr << "[Line " << _lineNumber << "]: Out of range value ["
-                  << _value << "]" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Out of range value ["
+                      << _value << "]" << std::endl;
+        errorStream() << " \"" << lineread << "\"" << std::endl;
         return false;
       }
 
@@ -195,17 +594,25 @@ namespace ignition
     }
 
     //////////////////////////////////////////////////
-    bool parseNonNegative(std::ifstream &_rndfFile,
+    bool parsePositive(std::ifstream &_rndfFile, const std::string &_delimiter,
+      int &_value, int &_lineNumber)
+    {
+      LineReader reader(_rndfFile);
+      return parsePositive(reader, _delimiter, _value, _lineNumber);
+    }
+
+    //////////////////////////////////////////////////
+    bool parseNonNegative(LineReader &_reader,
       const std::string &_delimiter, int &_value, int &_lineNumber)
     {
-      std::string lineread;
-      nextRealLine(_rndfFile, lineread, _lineNumber);
+      StringView line;
+      nextRealLine(_reader, line, _lineNumber);
 
-      if (!parseNonNegative(lineread, _delimiter, _value))
+      if (!parseNonNegative(line, _delimiter, _value))
       {
-        std::cerr << "[Line " << _lineNumber << "]: Unable to parse "
-                  << "non-negative value" << std::endl;
-        std::cerr << " \"" << lineread << "\"" << std::endl;
+        errorStream() << "[Line " << _lineNumber << "]: Unable to parse "
+                      << "non-negative value" << std::endl;
+        errorStream() << " \"" << line << "\"" << std::endl;
         return false;
       }
 
@@ -213,36 +620,38 @@ namespace ignition
     }
 
     //////////////////////////////////////////////////
-    bool parseNonNegative(const std::string &_input,
-      const std::string &_delimiter, int &_value)
+    bool parseNonNegative(std::ifstream &_rndfFile,
+      const std::string &_delimiter, int &_value, int &_lineNumber)
     {
-      std::string input = _input;
-      trimWhitespaces(input);
-
-      auto start = input.find(_delimiter + " ");
-      if (start != 0)
-        return false;
+      LineReader reader(_rndfFile);
+      return parseNonNegative(reader, _delimiter, _value, _lineNumber);
+    }
 
-      input.erase(0, _delimiter.size() + 1);
+    //////////////////////////////////////////////////
+    bool parseNonNegative(const StringView &_input,
+      const std::string &_delimiter, int &_value)
+    {
+      std::string buffer;
+      StringView line = trimWhitespaces(_input, buffer);
 
-      std::string::size_type sz;
-      try
-      {
-        _value = std::stoi(input, &sz);
-      }
-      catch(...)
+      if (!line.StartsWith(_delimiter)         ||
+          line.Size() <= _delimiter.size()     ||
+          line[_delimiter.size()] != ' ')
       {
         return false;
       }
 
-      if (_value < 0 || _value > 32768 || sz != input.size())
+      if (!parseInt(line.Substr(_delimiter.size() + 1), _value))
+        return false;
+
+      if (_value < 0 || _value > 32768)
         return false;
 
       return true;
     }
 
     //////////////////////////////////////////////////
-    bool parsePositive(const std::string &_input,
+    bool parsePositive(const StringView &_input,
       const std::string &_delimiter, int &_value)
     {
       bool res = parseNonNegative(_input, _delimiter, _value);
@@ -250,11 +659,11 @@ namespace ignition
     }
 
     //////////////////////////////////////////////////
-    bool parseBoundary(const std::string &_input, Marking &_boundary)
+    bool parseBoundary(const StringView &_input, Marking &_boundary)
     {
       _boundary = Marking::UNDEFINED;
-      std::string input = _input;
-      trimWhitespaces(input);
+      std::string buffer;
+      StringView input = trimWhitespaces(_input, buffer);
 
       if (input == "left_boundary double_yellow" ||
           input == "right_boundary double_yellow")
@@ -283,58 +692,41 @@ namespace ignition
     }
 
     //////////////////////////////////////////////////
-    bool parseCheckpoint(const std::string &_input, const int _segmentId,
+    bool parseCheckpoint(const StringView &_input, const int _segmentId,
       const int _laneId, Checkpoint &_checkpoint)
     {
-      std::string input = _input;
-      trimWhitespaces(input);
-
-      auto tokens = split(input, " ");
-      if (tokens.size() != 3)
+      std::string buffer;
+      Tokens tokens;
+      if (tokenize(trimWhitespaces(_input, buffer), " ", tokens) != 3)
         return false;
 
-      if (tokens.at(0) != "checkpoint")
+      if (tokens[0] != "checkpoint")
         return false;
 
-      auto checkpointTokens = split(tokens.at(1), ".");
-      if (checkpointTokens.size() != 3)
+      Tokens checkpointTokens;
+      if (tokenize(tokens[1], ".", checkpointTokens) != 3)
         return false;
 
-      if (checkpointTokens.at(0) != std::to_string(_segmentId))
+      if (checkpointTokens[0] != std::to_string(_segmentId))
         return false;
 
-      if (checkpointTokens.at(1) != std::to_string(_laneId))
+      if (checkpointTokens[1] != std::to_string(_laneId))
         return false;
 
-      std::string::size_type sz;
       int waypointId;
-      try
-      {
-        waypointId = std::stoi(checkpointTokens.at(2), &sz);
-      }
-      catch(...)
-      {
+      if (!parseInt(checkpointTokens[2], waypointId))
         return false;
-      }
 
-      if (waypointId <= 0 || waypointId > 32768 ||
-          sz != checkpointTokens.at(2).size())
+      if (waypointId <= 0 || waypointId > 32768)
       {
         return false;
       }
 
       int checkpointId;
-      try
-      {
-        checkpointId = std::stoi(tokens.at(2), &sz);
-      }
-      catch(...)
-      {
+      if (!parseInt(tokens[2], checkpointId))
         return false;
-      }
 
-      if (checkpointId <= 0 || checkpointId > 32768 ||
-          sz != tokens.at(2).size())
+      if (checkpointId <= 0 || checkpointId > 32768)
       {
         return false;
       }
@@ -345,41 +737,32 @@ namespace ignition
     }
 
     //////////////////////////////////////////////////
-    bool parseStop(const std::string &_input, const int _segmentId,
+    bool parseStop(const StringView &_input, const int _segmentId,
       const int _laneId, UniqueId &_stop)
     {
-      std::string input = _input;
-      trimWhitespaces(input);
-
-      auto tokens = split(input, " ");
-      if (tokens.size() != 2)
+      std::string buffer;
+      Tokens tokens;
+      if (tokenize(trimWhitespaces(_input, buffer), " ", tokens) != 2)
         return false;
 
-      if (tokens.at(0) != "stop")
+      if (tokens[0] != "stop")
         return false;
 
-      auto waypointTokens = split(tokens.at(1), ".");
-      if (waypointTokens.size() != 3)
+      Tokens waypointTokens;
+      if (tokenize(tokens[1], ".", waypointTokens) != 3)
         return false;
 
-      if (waypointTokens.at(0) != std::to_string(_segmentId))
+      if (waypointTokens[0] != std::to_string(_segmentId))
         return false;
 
-      if (waypointTokens.at(1) != std::to_string(_laneId))
+      if (waypointTokens[1] != std::to_string(_laneId))
         return false;
 
-      std::string::size_type sz;
       int z;
-      try
-      {
-        z = std::stoi(waypointTokens.at(2), &sz);
-      }
-      catch(...)
-      {
+      if (!parseInt(waypointTokens[2], z))
         return false;
-      }
 
-      if (z <= 0 || z > 32768 || sz != waypointTokens.at(2).size())
+      if (z <= 0 || z > 32768)
         return false;
 
       _stop.SetX(_segmentId);
@@ -389,91 +772,63 @@ namespace ignition
     }
 
     //////////////////////////////////////////////////
-    bool parseExit(const std::string &_input, const int _segmentId,
+    bool parseExit(const StringView &_input, const int _segmentId,
       const int _laneId, Exit &_exit)
     {
-      std::string input = _input;
-      trimWhitespaces(input);
-
-      auto tokens = split(input, " ");
-      if (tokens.size() != 3)
+      std::string buffer;
+      Tokens tokens;
+      if (tokenize(trimWhitespaces(_input, buffer), " ", tokens) != 3)
         return false;
 
-      if (tokens.at(0) != "exit")
+      if (tokens[0] != "exit")
         return false;
 
-      auto exitTokens = split(tokens.at(1), ".");
-      if (exitTokens.size() != 3)
+      Tokens exitTokens;
+      if (tokenize(tokens[1], ".", exitTokens) != 3)
         return false;
 
-      if (exitTokens.at(0) != std::to_string(_segmentId))
+      if (exitTokens[0] != std::to_string(_segmentId))
         return false;
 
-      if (exitTokens.at(1) != std::to_string(_laneId))
+      if (exitTokens[1] != std::to_string(_laneId))
         return false;
 
-      std::string::size_type sz;
       int exitWaypointId;
-      try
-      {
-        exitWaypointId = std::stoi(exitTokens.at(2), &sz);
-      }
-      catch(...)
-      {
+      if (!parseInt(exitTokens[2], exitWaypointId))
         return false;
-      }
 
-      if (exitWaypointId <= 0 || exitWaypointId > 32768 ||
-          sz != exitTokens.at(2).size())
+      if (exitWaypointId <= 0 || exitWaypointId > 32768)
       {
         return false;
       }
 
-      auto entryTokens = split(tokens.at(2), ".");
-      if (entryTokens.size() != 3)
+      Tokens entryTokens;
+      if (tokenize(tokens[2], ".", entryTokens) != 3)
         return false;
 
       int x;
-      try
-      {
-        x = std::stoi(entryTokens.at(0), &sz);
-      }
-      catch(...)
-      {
+      if (!parseInt(entryTokens[0], x))
         return false;
-      }
 
-      if (x <= 0 || x > 32768 || sz != entryTokens.at(0).size())
+      if (x <= 0 || x > 32768)
       {
         return false;
       }
 
       int y;
-      try
-      {
-        y = std::stoi(entryTokens.at(1), &sz);
-      }
-      catch(...)
-      {
+      if (!parseInt(entryTokens[1], y))
         return false;
-      }
 
-      if (y < 0 || y > 32768 || sz != entryTokens.at(1).size())
+      if (y < 0 || y > 32768)
       {
         return false;
       }
 
       int z;
-      try
-      {
-        z = std::stoi(entryTokens.at(2), &sz);
-      }
-      catch(...)
-      {
+      if (!parseInt(entryTokens[2], z))
         return false;
-      }
 
-      if (z <= 0 || z > 32768 || sz != entryTokens.at(2).size())
+      if (z <= 0 || z > 32768)
       {
         return false;
       }
@@ -15,8 +15,17 @@
  *
 */
 
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
 #include <tuple>
 #include <string>
 
@@ -194,6 +203,25 @@ TEST_F(ParserUtilsTest, positive)
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that a positive value followed by other characters is
+/// reported as out of range, with the value parsed.
+TEST_F(ParserUtilsTest, positiveTrailingGarbage)
+{
+  this->PopulateFile("\n\ndelim 7abc");
+  std::ifstream f(this->fileName);
+  std::ostringstream errors;
+  int line = 0;
+  int value;
+  {
+    ErrorCapture capture(errors);
+    EXPECT_FALSE(parsePositive(f, "delim", value, line));
+  }
+  EXPECT_EQ(line, 3);
+  EXPECT_EQ(errors.str(),
+    "[Line 3]: Out of range value [7]\n \"7abc\"\n");
+}
+
 //////////////////////////////////////////////////
 /// \brief Check the function that parses a positive value.
 TEST(ParserUtils, positive)
@@ -478,6 +506,251 @@ TEST(ParserUtils, trim)
   EXPECT_EQ(str, "Space ... the final frontier");
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the function that trims whitespaces into a buffer.
+TEST(ParserUtils, trimView)
+{
+  std::string buffer;
+  const std::string trimmed = "Space...the final frontier";
+  StringView view = trimWhitespaces(trimmed, buffer);
+  EXPECT_EQ(view, trimmed);
+
+  // Already trimmed strings aren't copied.
+  EXPECT_EQ(view.Data(), trimmed.data());
+  EXPECT_TRUE(buffer.empty());
+
+  for (auto const &input : {"\t Space ...   the \tfinal\t\tfrontier ",
+                            "lane_width 12 /* comment */",
+                            "  ",
+                            "a/*b"})
+  {
+    std::string expected = input;
+    trimWhitespaces(expected);
+    EXPECT_EQ(trimWhitespaces(input, buffer), expected);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Test the non-allocating tokenize() function.
+TEST(ParserUtils, tokenize)
+{
+  const std::string line = "exit  1.2.3 4.5.6 ";
+  Tokens tokens;
+  ASSERT_EQ(tokenize(line, " ", tokens), 3u);
+  EXPECT_EQ(tokens[0], "exit");
+  EXPECT_EQ(tokens[1], "1.2.3");
+  EXPECT_EQ(tokens[2], "4.5.6");
+
+  // Tokens reference the input.
+  EXPECT_EQ(tokens[1].Data(), line.data() + 6);
+
+  Tokens idTokens;
+  ASSERT_EQ(tokenize(tokens[1], ".", idTokens), 3u);
+  EXPECT_EQ(idTokens[0], "1");
+  EXPECT_EQ(idTokens[1], "2");
+  EXPECT_EQ(idTokens[2], "3");
+
+  // The same object can be reused.
+  EXPECT_EQ(tokenize("", " ", tokens), 0u);
+  EXPECT_EQ(tokenize("///", "/", tokens), 0u);
+  ASSERT_EQ(tokenize("//abc/def::123::567///", ":/", tokens), 4u);
+  EXPECT_EQ(tokens[3], "567");
+
+  // Tokens beyond the capacity are counted.
+  std::string many;
+  for (size_t i = 0; i < Tokens::kCapacity + 2; ++i)
+    many += "t ";
+  EXPECT_EQ(tokenize(many, " ", tokens), Tokens::kCapacity + 2);
+}
+
+/////////////////////////////////////////////////
+/// \brief Check the non-throwing integer parser.
+TEST(ParserUtils, parseInt)
+{
+  std::vector<std::pair<std::string, int>> valid =
+  {
+    {"0", 0}, {"7", 7}, {"+5", 5}, {"-12", -12}, {"32768", 32768},
+    {"007", 7}, {"2147483647", 2147483647}, {"-2147483648", INT_MIN},
+  };
+
+  for (auto const &testCase : valid)
+  {
+    int value = -1;
+    EXPECT_TRUE(parseInt(testCase.first, value)) << testCase.first;
+    EXPECT_EQ(value, testCase.second);
+  }
+
+  for (auto const &input : {"", "+", "-", "12a", " 1", "1 ", "0x10", "1.0",
+                            "2147483648", "-2147483649", "99999999999"})
+  {
+    int value = -1;
+    EXPECT_FALSE(parseInt(input, value)) << input;
+    EXPECT_EQ(value, -1);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the integer parser accepts the same prefixes as
+/// std::stoi().
+TEST(ParserUtils, parseIntPrefix)
+{
+  for (auto const &input : {"7", "7abc", "-12.5", " +3x", "\t42", "007 1",
+                            "2147483647", "32768.1.1"})
+  {
+    size_t expectedSize;
+    const int expected = std::stoi(input, &expectedSize);
+    int value = -1;
+    size_t size = 0;
+    ASSERT_TRUE(parseInt(input, value, size)) << input;
+    EXPECT_EQ(value, expected) << input;
+    EXPECT_EQ(size, expectedSize) << input;
+  }
+
+  for (auto const &input : {"", " ", "+", "-x", "abc", ".5", "2147483648"})
+  {
+    int value = -1;
+    size_t size = 0;
+    EXPECT_FALSE(parseInt(input, value, size)) << input;
+    EXPECT_EQ(value, -1);
+    EXPECT_EQ(size, 0u);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the double parser accepts the same prefixes as
+/// std::stod() for decimal numbers.
+TEST(ParserUtils, parseDoublePrefix)
+{
+  for (auto const &input : {"34.582012abc", "38.866291-1", "-117.351657+1",
+                            "38.86.300", "1e", "1e+", "1e+x", "2E3.5",
+                            " 2.5", "5.e-1z", "-.5,", "0.1 2"})
+  {
+    char *end;
+    const double expected = std::strtod(input, &end);
+    double value = -1;
+    size_t size = 0;
+    ASSERT_TRUE(parseDouble(input, value, size)) << input;
+    EXPECT_DOUBLE_EQ(value, expected) << input;
+    EXPECT_EQ(size, static_cast<size_t>(end - input)) << input;
+  }
+
+  for (auto const &input : {"", " ", ".", "-", "+.", "e5", "abc", "-e1"})
+  {
+    double value = -1;
+    size_t size = 0;
+    EXPECT_FALSE(parseDouble(input, value, size)) << input;
+    EXPECT_DOUBLE_EQ(value, -1);
+    EXPECT_EQ(size, 0u);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the double parser accepts infinities, NaNs and
+/// hexadecimal numbers and rejects numbers out of range as std::stod() does.
+TEST(ParserUtils, parseDoubleStod)
+{
+  for (auto const &input : {"inf", "-inf", "+INF", "Infinity", "infinit",
+                            " -inf", "nan", "-nan", "NaN(abc)x", "nanx",
+                            "0x1A", "0x1Ag", "0X1P+2", "0x1.8p1", "0x.8", "0x",
+                            "0xg", "-0x10", "0x1p-1074", "0e-400",
+                            "2.2250738585072014e-308",
+                            "1.7976931348623157e308"})
+  {
+    size_t expectedSize;
+    const double expected = std::stod(input, &expectedSize);
+    double value = -1;
+    size_t size = 0;
+    ASSERT_TRUE(parseDouble(input, value, size)) << input;
+    EXPECT_EQ(size, expectedSize) << input;
+    if (std::isnan(expected))
+      EXPECT_TRUE(std::isnan(value)) << input;
+    else
+      EXPECT_DOUBLE_EQ(value, expected) << input;
+  }
+
+  for (auto const &input : {"1e-400", "-1e-400", "4.9e-324", "1e-320",
+                            "2.2250738585072011e-308", "1e400", "-1e400",
+                            "1.8e308", "0x1p5000", "0x1p-5000"})
+  {
+    EXPECT_THROW(std::stod(input), std::out_of_range) << input;
+    double value = -1;
+    size_t size = 0;
+    EXPECT_FALSE(parseDouble(input, value, size)) << input;
+    EXPECT_DOUBLE_EQ(value, -1);
+    EXPECT_EQ(size, 0u);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that the non-throwing double parser is correctly rounded.
+TEST(ParserUtils, parseDouble)
+{
+  std::vector<std::string> valid =
+  {
+    "0", "-0", "0.1", "34.587489", "-117.365607", ".5", "5.", "+3.25",
+    "1e23", "1E-5", "8.5e+2", "9007199254740993", "9007199254740992.5",
+    "123456789012345678901234567890", "0.000000000000000000000000001",
+    "2.2250738585072011e-308", "1.7976931348623157e308", "4.9e-324",
+    "0.30000000000000004", "1000000000000000000000000000000e-30",
+  };
+
+  // Random coordinates with the usual number of decimals and random doubles
+  // printed with full precision.
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> coordinate(-180.0, 180.0);
+  std::uniform_int_distribution<uint64_t> bits;
+  char buf[64];
+  for (int i = 0; i < 1000; ++i)
+  {
+    std::snprintf(buf, sizeof(buf), "%.6f", coordinate(gen));
+    valid.push_back(buf);
+
+    uint64_t b = bits(gen);
+    double d;
+    std::memcpy(&d, &b, sizeof(d));
+    if (std::isfinite(d))
+    {
+      std::snprintf(buf, sizeof(buf), "%.17g", d);
+      valid.push_back(buf);
+    }
+  }
+
+  for (auto const &input : valid)
+  {
+    double expected = std::strtod(input.c_str(), nullptr);
+    double value = 0;
+    ASSERT_TRUE(parseDouble(input, value)) << input;
+    EXPECT_EQ(std::memcmp(&value, &expected, sizeof(value)), 0) << input;
+  }
+
+  for (auto const &input : {"", ".", "-", "+.", "e5", "1e", "1e+", "1.2.3",
+                            "abc", "nan", "inf", "1,5", " 1", "1 ", "1ee2",
+                            "0x1p3", "12a"})
+  {
+    double value = -1;
+    EXPECT_FALSE(parseDouble(input, value)) << input;
+    EXPECT_DOUBLE_EQ(value, -1);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Check that waypoint keys identify ids uniquely.
+TEST(ParserUtils, waypointKey)
+{
+  EXPECT_EQ(waypointKey(1, 2, 3), waypointKey(1, 2, 3));
+  EXPECT_NE(waypointKey(1, 2, 3), waypointKey(3, 2, 1));
+  EXPECT_NE(waypointKey(1, 0, 3), waypointKey(1, 3, 0));
+  EXPECT_NE(waypointKey(2, 1, 1), waypointKey(1, 2, 1));
+
+  // Adjacent bit fields don't overlap for the largest ids allowed.
+  const int kMax = 32768;
+  EXPECT_NE(waypointKey(kMax, kMax, kMax), waypointKey(kMax, kMax, 1));
+  EXPECT_NE(waypointKey(kMax, kMax, kMax), waypointKey(kMax, 1, kMax));
+  EXPECT_NE(waypointKey(kMax, kMax, kMax), waypointKey(1, kMax, kMax));
+  EXPECT_NE(waypointKey(1, kMax, 1), waypointKey(2, 0, 1));
+  EXPECT_NE(waypointKey(1, 1, kMax), waypointKey(1, 2, 0));
+}
+
 /////////////////////////////////////////////////
 /// \brief Test the string tokenizer split() function.
 TEST(ParserUtils, split)
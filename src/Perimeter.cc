@@ -20,13 +20,21 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <ignition/math/SphericalCoordinates.hh>
 
+#include "ignition/rndf/Arena.hh"
 #include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/LineReader.hh"
 #include "ignition/rndf/ParserUtils.hh"
 #include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDFBuilder.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+#include "ignition/rndf/RNDFWriter.hh"
+#include "ignition/rndf/UniqueId.hh"
 #include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
 
 using namespace ignition;
 using namespace rndf;
@@ -37,7 +45,7 @@ namespace ignition
   {
     /// \internal
     /// \brief Private data for PerimeterHeader class.
-    class PerimeterHeaderPrivate
+    class PerimeterHeaderPrivate : public ArenaObject
     {
       /// \brief Default constructor.
       public: PerimeterHeaderPrivate() = default;
@@ -51,7 +59,7 @@ namespace ignition
 
     /// \internal
     /// \brief Private data for Perimeter class.
-    class PerimeterPrivate
+    class PerimeterPrivate : public ArenaObject
     {
       /// \brief Constructor.
       public: PerimeterPrivate() = default;
@@ -80,36 +88,41 @@ PerimeterHeader::~PerimeterHeader()
 }
 
 //////////////////////////////////////////////////
-bool PerimeterHeader::Load(std::ifstream &_rndfFile, const int _zoneId,
-  const int _perimeterId, int &_lineNumber,
-  std::vector<ExitCacheEntry> &_exitCache)
+bool PerimeterHeader::Load(LineReader &_reader, const int _zoneId,
+  const int _perimeterId, int &_lineNumber, RNDFVisitor &_visitor)
 {
-  auto oldPos = _rndfFile.tellg();
-  int oldLineNumber = _lineNumber;
-
-  // We should leave if we don't find the "exit" element.
+  // We should leave if we don't find the "exit" element. The line is left
+  // for the parser of the next element.
   rndf::Exit exit;
-  std::string lineread;
-  while (exit.Load(_rndfFile, _zoneId, _perimeterId, _lineNumber, lineread))
+  StringView lineread;
+  while (_reader.Peek(lineread) &&
+         parseExit(lineread, _zoneId, _perimeterId, exit))
   {
-    this->AddExit(exit);
+    _reader.Consume(_lineNumber);
 
-    // Add the exit to the cache.
-    _exitCache.push_back({exit.ExitId().String(), exit.EntryId().String(),
-      _lineNumber, lineread});
-
-    oldPos = _rndfFile.tellg();
-    oldLineNumber = _lineNumber;
+    // Repeated exits are kept here, they are only used to flag the
+    // perimeter points. The visitor decides what to do with them.
+    this->Exits().push_back(exit);
+    _visitor.OnExit(exit, _lineNumber, lineread);
   }
 
-  // Restore the file position and line number.
-  // The next nextRealLine() call should point to the next element that is not
-  // part of the header.
-  _rndfFile.seekg(oldPos);
-  _lineNumber = oldLineNumber;
   return true;
 }
 
+//////////////////////////////////////////////////
+bool PerimeterHeader::Load(std::ifstream &_rndfFile, const int _zoneId,
+  const int _perimeterId, int &_lineNumber,
+  std::vector<ExitCacheEntry> &_exitCache)
+{
+  // The exits are added to the cache by a builder with a placeholder zone.
+  std::vector<uint64_t> waypointCache;
+  RNDFBuilder builder(_exitCache, waypointCache);
+  builder.OnZone(_zoneId, 0, "");
+
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _zoneId, _perimeterId, _lineNumber, builder);
+}
+
 //////////////////////////////////////////////////
 size_t PerimeterHeader::NumExits() const
 {
@@ -128,9 +141,9 @@ bool PerimeterHeader::AddExit(const Exit &_newExit)
   // Validate the exit unique Id.
   if (!_newExit.Valid())
   {
-    std::cerr << "PerimeterHeader::AddExit() Invalid exit [("
-              << _newExit.ExitId() << ")(" << _newExit.EntryId()
-              << ")]" << std::endl;
+    errorStream() << "PerimeterHeader::AddExit() Invalid exit [("
+                  << _newExit.ExitId() << ")(" << _newExit.EntryId()
+                  << ")]" << std::endl;
     return false;
   }
 
@@ -138,7 +151,8 @@ bool PerimeterHeader::AddExit(const Exit &_newExit)
   if (std::find(this->dataPtr->exits.begin(),
         this->dataPtr->exits.end(), _newExit) != this->dataPtr->exits.end())
   {
-    std::cerr << "PerimeterHeader::AddExit() error: Existing exit" << std::endl;
+    errorStream() << "PerimeterHeader::AddExit() error: Existing exit"
+                  << std::endl;
     return false;
   }
 
@@ -168,61 +182,85 @@ Perimeter::Perimeter(const Perimeter &_other)
   *this = _other;
 }
 
+//////////////////////////////////////////////////
+Perimeter::Perimeter(Perimeter &&_other) noexcept  // NOLINT
+  : dataPtr(std::move(_other.dataPtr))
+{
+}
+
 //////////////////////////////////////////////////
 Perimeter::~Perimeter()
 {
 }
 
 //////////////////////////////////////////////////
-bool Perimeter::Load(std::ifstream &_rndfFile, const int _zoneId,
+bool Perimeter::Load(LineReader &_reader, const int _zoneId,
   int &_lineNumber, std::vector<ExitCacheEntry> &_exitCache,
-  std::vector<std::string> &_waypointCache)
+  std::vector<uint64_t> &_waypointCache)
 {
-  std::string lineread;
-  nextRealLine(_rndfFile, lineread, _lineNumber);
+  // The perimeter is built inside a placeholder zone.
+  RNDFBuilder builder(_exitCache, _waypointCache);
+  builder.OnZone(_zoneId, 0, "");
+
+  if (!Parse(_reader, _zoneId, _lineNumber, builder))
+    return false;
+
+  *this = std::move(builder.Zones().back().Perimeter());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Perimeter::Parse(LineReader &_reader, const int _zoneId,
+  int &_lineNumber, RNDFVisitor &_visitor)
+{
+  StringView lineread;
+  nextRealLine(_reader, lineread, _lineNumber);
 
   // Parse the "perimeter Id" .
-  auto tokens = split(lineread, " ");
-  if (tokens.size() != 2 || tokens.at(0) != "perimeter")
+  Tokens tokens;
+  tokenize(lineread, " ", tokens);
+  if (tokens.Size() != 2 || tokens[0] != "perimeter")
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse perimeter "
-              << "element" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber << "]: Unable to parse perimeter "
+                  << "element" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  auto perimeterIdTokens = split(tokens.at(1), ".");
-  if (perimeterIdTokens.size() != 2                      ||
-      perimeterIdTokens.at(0) != std::to_string(_zoneId) ||
-      perimeterIdTokens.at(1) != "0")
+  Tokens perimeterIdTokens;
+  tokenize(tokens[1], ".", perimeterIdTokens);
+  if (perimeterIdTokens.Size() != 2                   ||
+      perimeterIdTokens[0] != std::to_string(_zoneId) ||
+      perimeterIdTokens[1] != "0")
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse perimeter "
-              << "element" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber << "]: Unable to parse perimeter "
+                  << "element" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
   // Parse "num_perimeterpoints".
   int numPoints;
-  if (!parsePositive(_rndfFile, "num_perimeterpoints", numPoints, _lineNumber))
+  if (!parsePositive(_reader, "num_perimeterpoints", numPoints, _lineNumber))
     return false;
 
+  _visitor.OnPerimeter(_zoneId, numPoints);
+
   // Parse optional perimeter header.
   PerimeterHeader header;
-  header.Load(_rndfFile, _zoneId, 0, _lineNumber, _exitCache);
+  header.Load(_reader, _zoneId, 0, _lineNumber, _visitor);
 
   // Parse the perimeter points.
-  std::vector<rndf::Waypoint> perimeterPoints;
   for (auto i = 0; i < numPoints; ++i)
   {
     rndf::Waypoint waypoint;
-    if (!waypoint.Load(_rndfFile, _zoneId, 0, _lineNumber))
+    if (!waypoint.Load(_reader, _zoneId, 0, _lineNumber))
       return false;
 
     if (waypoint.Id() != i + 1)
     {
-      std::cerr << "[Line " << _lineNumber << "]: Found non-consecutive "
-                << "waypoint Id [" << waypoint.Id() << "]" << std::endl;
+      errorStream() << "[Line " << _lineNumber << "]: Found non-consecutive "
+                    << "waypoint Id [" << waypoint.Id() << "]" << std::endl;
       return false;
     }
 
@@ -236,22 +274,42 @@ bool Perimeter::Load(std::ifstream &_rndfFile, const int _zoneId,
       }
     }
 
-    perimeterPoints.push_back(waypoint);
-
-    std::string wpStr(std::to_string(_zoneId) + ".0." +
-      std::to_string(waypoint.Id()));
-    _waypointCache.push_back(wpStr);
+    _visitor.OnWaypoint(_zoneId, 0, waypoint);
   }
 
   // Parse "end_perimeter".
-  if (!parseDelimiter(_rndfFile, "end_perimeter", _lineNumber))
-    return false;
+  return parseDelimiter(_reader, "end_perimeter", _lineNumber);
+}
 
-  // Populate the perimeter.
-  this->Points() = perimeterPoints;
-  this->Exits() = header.Exits();
+//////////////////////////////////////////////////
+bool Perimeter::Load(std::ifstream &_rndfFile, const int _zoneId,
+  int &_lineNumber, std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<uint64_t> &_waypointCache)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _zoneId, _lineNumber, _exitCache,
+    _waypointCache);
+}
 
-  return true;
+//////////////////////////////////////////////////
+bool Perimeter::Load(std::ifstream &_rndfFile, const int _zoneId,
+  int &_lineNumber, std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<std::string> &_waypointCache)
+{
+  std::vector<uint64_t> waypointKeys;
+  const bool result = this->Load(_rndfFile, _zoneId, _lineNumber, _exitCache,
+    waypointKeys);
+  for (const uint64_t key : waypointKeys)
+    _waypointCache.push_back(UniqueId::FromKey(key).String());
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool Perimeter::Save(std::ostream &_stream, const int _zoneId) const
+{
+  RNDFWriter writer(_stream);
+  writer.WritePerimeter(_zoneId, *this);
+  return writer.Flush();
 }
 
 //////////////////////////////////////////////////
@@ -275,31 +333,33 @@ const std::vector<rndf::Waypoint> &Perimeter::Points() const
 //////////////////////////////////////////////////
 bool Perimeter::Point(const int _wpId, rndf::Waypoint &_wp) const
 {
-  auto it = std::find_if(this->dataPtr->points.begin(),
-    this->dataPtr->points.end(),
-    [_wpId](const rndf::Waypoint &_waypoint)
-    {
-      return _waypoint.Id() == _wpId;
-    });
+  const rndf::Waypoint *point = this->Point(_wpId);
+  if (point)
+    _wp = *point;
 
-  bool found = it != this->dataPtr->points.end();
-  if (found)
-    _wp = *it;
+  return point != nullptr;
+}
 
-  return found;
+//////////////////////////////////////////////////
+const rndf::Waypoint *Perimeter::Point(const int _wpId) const
+{
+  return findById(this->dataPtr->points, _wpId);
 }
 
 //////////////////////////////////////////////////
-bool Perimeter::UpdatePoint(const rndf::Waypoint &_wp)
+rndf::Waypoint *Perimeter::Point(const int _wpId)
 {
-  auto it = std::find(this->dataPtr->points.begin(),
-    this->dataPtr->points.end(), _wp);
+  return findById(this->dataPtr->points, _wpId);
+}
 
-  bool found = it != this->dataPtr->points.end();
-  if (found)
-    *it = _wp;
+//////////////////////////////////////////////////
+bool Perimeter::UpdatePoint(const rndf::Waypoint &_wp)
+{
+  rndf::Waypoint *point = this->Point(_wp.Id());
+  if (point)
+    *point = _wp;
 
-  return found;
+  return point != nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -308,8 +368,8 @@ bool Perimeter::AddPoint(const rndf::Waypoint &_newWaypoint)
   // Validate the waypoint.
   if (!_newWaypoint.Valid())
   {
-    std::cerr << "[Perimeter::AddPoint() Invalid point Id ["
-              << _newWaypoint.Id() << "]" << std::endl;
+    errorStream() << "[Perimeter::AddPoint() Invalid point Id ["
+                  << _newWaypoint.Id() << "]" << std::endl;
     return false;
   }
 
@@ -318,7 +378,8 @@ bool Perimeter::AddPoint(const rndf::Waypoint &_newWaypoint)
         this->dataPtr->points.end(), _newWaypoint) !=
           this->dataPtr->points.end())
   {
-    std::cerr << "[Perimeter::AddPoint() error: Existing point" << std::endl;
+    errorStream() << "[Perimeter::AddPoint() error: Existing point"
+                  << std::endl;
     return false;
   }
 
@@ -430,7 +491,18 @@ bool Perimeter::operator!=(const Perimeter &_other) const
 //////////////////////////////////////////////////
 Perimeter &Perimeter::operator=(const Perimeter &_other)
 {
+  // This instance might have been moved from.
+  if (!this->dataPtr)
+    this->dataPtr.reset(new PerimeterPrivate());
+
   this->Points() = _other.Points();
   this->Exits() = _other.Exits();
   return *this;
 }
+
+//////////////////////////////////////////////////
+Perimeter &Perimeter::operator=(Perimeter &&_other) noexcept  // NOLINT
+{
+  std::swap(this->dataPtr, _other.dataPtr);
+  return *this;
+}
@@ -18,6 +18,8 @@
 #include <iostream>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
@@ -118,6 +120,33 @@ TEST(Perimeter, points)
   EXPECT_FALSE(perimeter.Valid());
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the accessors of points by Id that don't copy them.
+TEST(Perimeter, pointById)
+{
+  Perimeter perimeter;
+  for (auto const id : {1, 2, 4})
+    perimeter.Points().emplace_back(id, 10.0, 20.0);
+  const Perimeter &constPerimeter = perimeter;
+
+  // Consecutive and non-consecutive Ids.
+  EXPECT_EQ(constPerimeter.Point(1), &constPerimeter.Points().at(0));
+  EXPECT_EQ(constPerimeter.Point(2), &constPerimeter.Points().at(1));
+  EXPECT_EQ(constPerimeter.Point(4), &constPerimeter.Points().at(2));
+  EXPECT_EQ(constPerimeter.Point(3), nullptr);
+  EXPECT_EQ(constPerimeter.Point(0), nullptr);
+  EXPECT_EQ(constPerimeter.Point(-1), nullptr);
+
+  // Edit a point in place.
+  Waypoint *mutablePoint = perimeter.Point(4);
+  ASSERT_TRUE(mutablePoint != nullptr);
+  mutablePoint->SetLocation(11.0, 21.0);
+  Waypoint copy;
+  EXPECT_TRUE(perimeter.Point(4, copy));
+  EXPECT_DOUBLE_EQ(copy.Latitude(), 11.0);
+  EXPECT_EQ(perimeter.Point(5), nullptr);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check exits-related functions.
 TEST(Perimeter, checkExits)
@@ -252,6 +281,33 @@ TEST(Perimeter, assignment)
   EXPECT_EQ(perimeter1, perimeter2);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check move constructor and move assignment operator.
+TEST(Perimeter, move)
+{
+  static_assert(std::is_nothrow_move_constructible<Perimeter>::value &&
+    std::is_nothrow_move_assignable<Perimeter>::value,
+    "Perimeter should be nothrow movable");
+
+  Perimeter perimeter1;
+  perimeter1.Points().push_back(Waypoint(1,
+    ignition::math::SphericalCoordinates()));
+  EXPECT_TRUE(perimeter1.AddExit(Exit(UniqueId(1, 0, 1), UniqueId(2, 1, 1))));
+
+  Perimeter perimeter2(std::move(perimeter1));
+  EXPECT_EQ(perimeter2.NumPoints(), 1u);
+  EXPECT_EQ(perimeter2.NumExits(), 1u);
+
+  // A moved-from perimeter can be assigned to.
+  perimeter1 = perimeter2;
+  EXPECT_EQ(perimeter1, perimeter2);
+
+  Perimeter perimeter3;
+  perimeter3 = std::move(perimeter2);
+  EXPECT_EQ(perimeter3.NumPoints(), 1u);
+  EXPECT_EQ(perimeter3.NumExits(), 1u);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check copy constructor.
 TEST(Perimeter, copyConstructor)
@@ -16,22 +16,46 @@
 */
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cctype>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <deque>
 #include <fstream>
 #include <iostream>
-#include <map>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "ignition/rndf/Arena.hh"
+#include "ignition/rndf/CoordinateSnapshot.hh"
 #include "ignition/rndf/Exit.hh"
 #include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LaneIndex.hh"
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/LocalCoordinates.hh"
 #include "ignition/rndf/ParkingSpot.hh"
 #include "ignition/rndf/ParserUtils.hh"
 #include "ignition/rndf/Perimeter.hh"
 #include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFBuilder.hh"
+#include "ignition/rndf/RNDFCache.hh"
 #include "ignition/rndf/RNDFNode.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+#include "ignition/rndf/RNDFWriter.hh"
+#include "ignition/rndf/RoadGraph.hh"
 #include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/SpatialIndex.hh"
 #include "ignition/rndf/UniqueId.hh"
 #include "ignition/rndf/Waypoint.hh"
 #include "ignition/rndf/Zone.hh"
@@ -82,21 +106,974 @@ namespace ignition
       /// \brief Optional segment header members.
       public: RNDFHeader header;
 
-      /// \brief A map used as a cache where the keys are the string
-      /// representation of unique Ids (e.g. 1.2.1) and the values are the
-      /// associated RNDFNode objects containing the metadata associated to
-      /// the unique Id..
-      public: std::map<std::string, rndf::RNDFNode> cache;
+      /// \brief A slot of the node index.
+      public: struct Slot
+      {
+        /// \brief Key of the unique Id stored in the slot.
+        public: uint64_t key;
+
+        /// \brief Position of the node in "nodes" or kEmptySlot.
+        public: uint32_t node;
+      };
+
+      /// \brief Value of Slot::node for unused slots.
+      public: static const uint32_t kEmptySlot =
+        std::numeric_limits<uint32_t>::max();
+
+      /// \brief Remove all the nodes.
+      public: void ClearNodes()
+      {
+        this->nodes.clear();
+        this->nodeStamps.clear();
+        this->freeNodes.clear();
+        this->numNodes = 0;
+        this->index.assign(16, {0, kEmptySlot});
+        this->elementKeys.clear();
+      }
+
+      /// \brief Grow the index, if needed, so it has room for some nodes.
+      /// \param[in] _numNodes Expected number of nodes.
+      public: void ReserveNodes(const size_t _numNodes)
+      {
+        // Keep the load factor at or below 1/2, so probe sequences are short.
+        if (!this->index.empty() && 2 * _numNodes <= this->index.size())
+          return;
+
+        size_t capacity = 16;
+        while (capacity < 2 * _numNodes)
+          capacity *= 2;
+
+        std::vector<Slot> old(capacity, {0, kEmptySlot});
+        old.swap(this->index);
+        for (auto const &slot : old)
+        {
+          if (slot.node != kEmptySlot)
+            this->index[this->Probe(slot.key)] = slot;
+        }
+      }
+
+      /// \brief Get the node associated to a unique Id, creating it if it
+      /// doesn't exist. The node is stamped as alive in the current
+      /// reindexing pass.
+      /// \param[in] _id The unique Id.
+      /// \return The node.
+      public: RNDFNode &AddNode(const UniqueId &_id)
+      {
+        this->ReserveNodes(this->numNodes + 1);
+        const uint64_t key = _id.Key();
+        Slot &slot = this->index[this->Probe(key)];
+        if (slot.node == kEmptySlot)
+        {
+          slot.key = key;
+          if (!this->freeNodes.empty())
+          {
+            // Reuse the storage of a removed node.
+            slot.node = this->freeNodes.back();
+            this->freeNodes.pop_back();
+            this->nodes[slot.node].SetUniqueId(_id);
+          }
+          else
+          {
+            slot.node = static_cast<uint32_t>(this->nodes.size());
+            this->nodes.emplace_back(_id);
+            this->nodeStamps.push_back(0);
+          }
+          ++this->numNodes;
+        }
+
+        this->nodeStamps[slot.node] = this->stamp;
+        return this->nodes[slot.node];
+      }
+
+      /// \brief Remove the node associated to a unique Id key, if any. The
+      /// node is reset, so it has no waypoint, and its storage is reused by
+      /// the next node added.
+      /// \param[in] _key The key.
+      public: void RemoveNode(const uint64_t _key)
+      {
+        if (this->index.empty())
+          return;
+
+        size_t hole = this->Probe(_key);
+        if (this->index[hole].node == kEmptySlot)
+          return;
+
+        this->nodes[this->index[hole].node] = RNDFNode();
+        this->freeNodes.push_back(this->index[hole].node);
+        --this->numNodes;
+
+        // Backward shift deletion: move back the following keys of the
+        // cluster whose home slot isn't between the hole and them, so every
+        // key stays reachable from its home slot without tombstones.
+        const size_t mask = this->index.size() - 1;
+        for (size_t pos = (hole + 1) & mask;
+             this->index[pos].node != kEmptySlot; pos = (pos + 1) & mask)
+        {
+          const size_t home = this->Home(this->index[pos].key);
+          if (((pos - home) & mask) >= ((pos - hole) & mask))
+          {
+            this->index[hole] = this->index[pos];
+            hole = pos;
+          }
+        }
+        this->index[hole] = {0, kEmptySlot};
+      }
+
+      /// \brief Remove the node associated to a unique Id key, if any,
+      /// unless it was added or updated in the current pass.
+      /// \param[in] _key The key.
+      public: void RemoveStaleNode(const uint64_t _key)
+      {
+        if (this->index.empty())
+          return;
+
+        const Slot &slot = this->index[this->Probe(_key)];
+        if (slot.node != kEmptySlot &&
+            this->nodeStamps[slot.node] != this->stamp)
+        {
+          this->RemoveNode(_key);
+        }
+      }
+
+      /// \brief Start a new indexing pass. The nodes added or updated
+      /// during the pass aren't removed by the Unindex functions.
+      public: void NextPass()
+      {
+        if (++this->stamp == 0)
+        {
+          std::fill(this->nodeStamps.begin(), this->nodeStamps.end(), 0u);
+          this->stamp = 1;
+        }
+      }
+
+      /// \brief Find the node associated to a unique Id key.
+      /// \param[in] _key The key.
+      /// \return Pointer to the node or nullptr if there's no such node.
+      public: RNDFNode *FindNode(const uint64_t _key)
+      {
+        if (this->index.empty())
+          return nullptr;
+
+        const Slot &slot = this->index[this->Probe(_key)];
+        if (slot.node == kEmptySlot)
+          return nullptr;
+
+        return &this->nodes[slot.node];
+      }
+
+      /// \brief Add the nodes of the waypoints of a lane.
+      /// \param[in] _segment Position of the segment in "segments".
+      /// \param[in] _lane Position of the lane in the segment.
+      public: void IndexLane(const size_t _segment, const size_t _lane)
+      {
+        const rndf::Segment &seg = this->segments[_segment];
+        const rndf::Lane &ln = seg.Lanes()[_lane];
+        for (size_t w = 0; w < ln.NumWaypoints(); ++w)
+        {
+          rndf::UniqueId id(seg.Id(), ln.Id(), ln.Waypoints()[w].Id());
+          this->AddNode(id).SetHandle(&this->segments, _segment, _lane, w);
+        }
+      }
+
+      /// \brief Remove the nodes of the waypoints of a lane that weren't
+      /// indexed again in the current pass.
+      /// \param[in] _segmentId Id of the segment containing the lane.
+      /// \param[in] _lane The lane.
+      public: void UnindexLane(const int _segmentId, const rndf::Lane &_lane)
+      {
+        for (auto const &wp : _lane.Waypoints())
+          this->RemoveStaleNode(waypointKey(_segmentId, _lane.Id(), wp.Id()));
+      }
+
+      /// \brief Add the nodes of the waypoints of a segment.
+      /// \param[in] _segment Position of the segment in "segments".
+      public: void IndexSegment(const size_t _segment)
+      {
+        for (size_t l = 0; l < this->segments[_segment].NumLanes(); ++l)
+          this->IndexLane(_segment, l);
+        this->RecordKeys(this->segments[_segment]);
+      }
+
+      /// \brief Record the keys of the waypoints of a segment in
+      /// "elementKeys".
+      /// \param[in] _segment The segment.
+      public: void RecordKeys(const rndf::Segment &_segment)
+      {
+        std::vector<uint64_t> &keys = this->elementKeys[_segment.Id()];
+        keys.clear();
+        for (auto const &ln : _segment.Lanes())
+        {
+          for (auto const &wp : ln.Waypoints())
+            keys.push_back(waypointKey(_segment.Id(), ln.Id(), wp.Id()));
+        }
+      }
+
+      /// \brief Remove the nodes of the waypoints of a segment that weren't
+      /// indexed again in the current pass.
+      /// \param[in] _segment The segment.
+      public: void UnindexSegment(const rndf::Segment &_segment)
+      {
+        for (auto const &ln : _segment.Lanes())
+          this->UnindexLane(_segment.Id(), ln);
+      }
+
+      /// \brief Add the nodes of the waypoints of a zone.
+      /// \param[in] _zone Position of the zone in "zones".
+      public: void IndexZone(const size_t _zone)
+      {
+        const rndf::Zone &zn = this->zones[_zone];
+        const std::vector<rndf::Waypoint> &points = zn.Perimeter().Points();
+        for (size_t w = 0; w < points.size(); ++w)
+        {
+          rndf::UniqueId id(zn.Id(), 0, points[w].Id());
+          this->AddNode(id).SetHandle(&this->zones, _zone, 0, w);
+        }
+        for (size_t s = 0; s < zn.NumSpots(); ++s)
+        {
+          const rndf::ParkingSpot &spot = zn.Spots()[s];
+          for (size_t w = 0; w < spot.NumWaypoints(); ++w)
+          {
+            rndf::UniqueId id(zn.Id(), spot.Id(), spot.Waypoints()[w].Id());
+            this->AddNode(id).SetHandle(&this->zones, _zone, s, w);
+          }
+        }
+        this->RecordKeys(zn);
+      }
+
+      /// \brief Record the keys of the waypoints of a zone in
+      /// "elementKeys".
+      /// \param[in] _zone The zone.
+      public: void RecordKeys(const rndf::Zone &_zone)
+      {
+        std::vector<uint64_t> &keys = this->elementKeys[_zone.Id()];
+        keys.clear();
+        for (auto const &wp : _zone.Perimeter().Points())
+          keys.push_back(waypointKey(_zone.Id(), 0, wp.Id()));
+        for (auto const &spot : _zone.Spots())
+        {
+          for (auto const &wp : spot.Waypoints())
+            keys.push_back(waypointKey(_zone.Id(), spot.Id(), wp.Id()));
+        }
+      }
+
+      /// \brief Remove the nodes of the waypoints of a zone that weren't
+      /// indexed again in the current pass.
+      /// \param[in] _zone The zone.
+      public: void UnindexZone(const rndf::Zone &_zone)
+      {
+        for (auto const &wp : _zone.Perimeter().Points())
+          this->RemoveStaleNode(waypointKey(_zone.Id(), 0, wp.Id()));
+        for (auto const &spot : _zone.Spots())
+        {
+          for (auto const &wp : spot.Waypoints())
+          {
+            this->RemoveStaleNode(
+              waypointKey(_zone.Id(), spot.Id(), wp.Id()));
+          }
+        }
+      }
+
+      /// \brief Index all the waypoints. The nodes of the unique Ids that
+      /// still exist are kept, so pointers to them remain valid, and the
+      /// rest are removed.
+      public: void Reindex()
+      {
+        size_t total = 0;
+        for (auto const &seg : this->segments)
+          for (auto const &ln : seg.Lanes())
+            total += ln.NumWaypoints();
+
+        for (auto const &zn : this->zones)
+        {
+          total += zn.Perimeter().NumPoints();
+          for (auto const &spot : zn.Spots())
+            total += spot.NumWaypoints();
+        }
+
+        this->ReserveNodes(total);
+        this->NextPass();
+        this->elementKeys.clear();
+        for (size_t i = 0; i < this->segments.size(); ++i)
+          this->IndexSegment(i);
+        for (size_t i = 0; i < this->zones.size(); ++i)
+          this->IndexZone(i);
+
+        // Every node not stamped by this pass belongs to a removed waypoint.
+        std::vector<uint64_t> removed;
+        for (auto const &slot : this->index)
+        {
+          if (slot.node != kEmptySlot &&
+              this->nodeStamps[slot.node] != this->stamp)
+          {
+            removed.push_back(slot.key);
+          }
+        }
+        for (auto const key : removed)
+          this->RemoveNode(key);
+      }
+
+      /// \brief Index again the waypoints of a segment or zone edited in
+      /// place. The nodes of its waypoints that no longer exist are
+      /// removed, and the rest are kept. Only the waypoints of the element
+      /// are visited: the ones it had are in "elementKeys".
+      /// \param[in] _id Id of the segment or zone.
+      public: void ReindexElement(const int _id)
+      {
+        std::vector<uint64_t> previous;
+        auto keys = this->elementKeys.find(_id);
+        if (keys != this->elementKeys.end())
+        {
+          previous.swap(keys->second);
+          this->elementKeys.erase(keys);
+        }
+
+        this->NextPass();
+        const rndf::Segment *seg = findById(this->segments, _id);
+        if (seg)
+          this->IndexSegment(static_cast<size_t>(seg - this->segments.data()));
+        else
+        {
+          // In a valid RNDF, the zones are numbered after the segments.
+          const size_t position = static_cast<size_t>(_id) - 1 -
+            this->segments.size();
+          const rndf::Zone *zn = nullptr;
+          if (position < this->zones.size() &&
+              this->zones[position].Id() == _id)
+          {
+            zn = &this->zones[position];
+          }
+          else
+            zn = findById(this->zones, _id);
+          if (zn)
+            this->IndexZone(static_cast<size_t>(zn - this->zones.data()));
+        }
+
+        for (auto const key : previous)
+          this->RemoveStaleNode(key);
+      }
+
+      /// \brief Find the home slot of a key in the index.
+      /// \param[in] _key The key.
+      /// \return Position of the slot in "index".
+      private: size_t Home(const uint64_t _key) const
+      {
+        // Fibonacci hashing spreads consecutive ids across the table.
+        const uint64_t hash = _key * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash ^ (hash >> 32)) &
+          (this->index.size() - 1);
+      }
+
+      /// \brief Find the slot of the index that contains a key, or the
+      /// empty slot where it would be inserted. Linear probing is used.
+      /// \param[in] _key The key.
+      /// \return Position of the slot in "index".
+      private: size_t Probe(const uint64_t _key) const
+      {
+        const size_t mask = this->index.size() - 1;
+        size_t pos = this->Home(_key);
+        while (this->index[pos].node != kEmptySlot &&
+               this->index[pos].key != _key)
+        {
+          pos = (pos + 1) & mask;
+        }
+        return pos;
+      }
+
+      /// \brief The RNDFNode objects containing the metadata associated to
+      /// every unique Id. A deque never moves its elements when it grows,
+      /// so pointers to the nodes remain valid while their Id exists.
+      public: std::deque<rndf::RNDFNode> nodes;
+
+      /// \brief Reindexing pass in which each node was last seen.
+      public: std::vector<uint32_t> nodeStamps;
+
+      /// \brief Current reindexing pass.
+      public: uint32_t stamp = 0;
+
+      /// \brief Positions in "nodes" of removed nodes, reused first.
+      public: std::vector<uint32_t> freeNodes;
+
+      /// \brief Number of nodes in the index.
+      public: size_t numNodes = 0;
+
+      /// \brief Open addressing hash table that maps unique Id keys to the
+      /// position of their node in "nodes". Its size is a power of two.
+      public: std::vector<Slot> index;
+
+      /// \brief Keys of the nodes of every segment and zone, by Id. They
+      /// are the nodes removed when the element is edited in place.
+      public: std::unordered_map<int, std::vector<uint64_t>> elementKeys;
 
       /// \brief The cache of exits under parsing.
       public: std::vector<ExitCacheEntry> exitCache;
 
-      /// \brief The cache of waypoints under parsing.
-      public: std::vector<std::string> waypointCache;
+      /// \brief The keys of the waypoints under parsing.
+      /// \sa waypointKey()
+      public: std::vector<uint64_t> waypointCache;
+
+      /// \brief A segment or zone block of a RNDF text.
+      public: struct Block
+      {
+        /// \brief Offset of the first character of the block.
+        public: size_t begin;
+
+        /// \brief Offset after the last character of the block.
+        public: size_t end;
+
+        /// \brief Number of lines before the block.
+        public: int lines;
+      };
+
+      /// \brief The result of parsing a block.
+      public: struct BlockResult
+      {
+        /// \brief Whether the block was parsed successfully.
+        public: bool ok = false;
+
+        /// \brief Line number pointed by the reader after parsing.
+        public: int lineNumber = 0;
+
+        /// \brief The exits found in the block.
+        public: std::vector<ExitCacheEntry> exitCache;
+
+        /// \brief The keys of the waypoints found in the block.
+        public: std::vector<uint64_t> waypointCache;
+
+        /// \brief The errors reported while parsing the block.
+        public: std::string errors;
+      };
+
+      /// \brief Parse the beginning of a RNDF: its name, the number of
+      /// segments and zones and the optional file header.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[out] _name RNDF name.
+      /// \param[out] _numSegments Number of segments.
+      /// \param[out] _numZones Number of zones.
+      /// \param[out] _header The file header.
+      /// \return True if all the elements were correctly parsed.
+      public: static bool ParsePreamble(LineReader &_reader,
+                                        int &_lineNumber,
+                                        std::string &_name,
+                                        int &_numSegments,
+                                        int &_numZones,
+                                        RNDFHeader &_header)
+      {
+        // Parse "RNDF_name"
+        if (!parseString(_reader, "RNDF_name", _name, _lineNumber))
+          return false;
+
+        // Parse "num_segments".
+        if (!parsePositive(_reader, "num_segments", _numSegments, _lineNumber))
+          return false;
+
+        // Parse "num_zones".
+        if (!parseNonNegative(_reader, "num_zones", _numZones, _lineNumber))
+          return false;
+
+        // Parse optional file header (format_version and/or creation_date).
+        return _header.Load(_reader, _lineNumber);
+      }
+
+      /// \brief Parse all the segments and then all the zones of a RNDF,
+      /// checking that their Ids are consecutive.
+      /// \param[in, out] _reader Line reader.
+      /// \param[in] _numSegments Number of segments expected.
+      /// \param[in] _numZones Number of zones expected.
+      /// \param[in, out] _lineNumber Line number pointed by the reader.
+      /// \param[in, out] _visitor Visitor that receives the elements parsed.
+      /// \return True if all the segments and zones were correctly parsed.
+      public: static bool ParseBlocks(LineReader &_reader,
+                                      const int _numSegments,
+                                      const int _numZones,
+                                      int &_lineNumber,
+                                      RNDFVisitor &_visitor)
+      {
+        // Parse all segments.
+        for (auto i = 0; i < _numSegments; ++i)
+        {
+          int segmentId;
+          if (!rndf::Segment::Parse(_reader, _lineNumber, _visitor,
+            segmentId))
+          {
+            return false;
+          }
+
+          // Check that all segments are consecutive.
+          if (segmentId != i + 1)
+          {
+            errorStream() << "[Line " << _lineNumber
+                          << "]: Found non-consecutive "
+                          << "segment Id [" << segmentId << "]" << std::endl;
+            return false;
+          }
+        }
+
+        // Parse all zones.
+        for (auto i = 0; i < _numZones; ++i)
+        {
+          int zoneId;
+          if (!rndf::Zone::Parse(_reader, _lineNumber, _visitor, zoneId))
+            return false;
+
+          // Check that all zones are consecutive.
+          if (zoneId != _numSegments + i + 1)
+          {
+            errorStream() << "[Line " << _lineNumber
+                          << "]: Found non-consecutive "
+                          << "zone Id [" << zoneId << "]" << std::endl;
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      /// \brief Find the segment and zone blocks of a RNDF text. Every block
+      /// ends with the first "end_segment" or "end_zone" line found after
+      /// the previous block. Blank lines and comments before a block are
+      /// part of it.
+      /// \param[in] _content The text, starting at the first segment.
+      /// \param[in] _numSegments Number of segment blocks expected.
+      /// \param[in] _numZones Number of zone blocks expected.
+      /// \param[out] _blocks The blocks found.
+      /// \return True if all the blocks expected were found.
+      public: static bool SplitBlocks(const StringView &_content,
+                                      const int _numSegments,
+                                      const int _numZones,
+                                      std::vector<Block> &_blocks)
+      {
+        const size_t numSegments = static_cast<size_t>(_numSegments);
+        const size_t numBlocks = numSegments + static_cast<size_t>(_numZones);
+        _blocks.clear();
+        _blocks.reserve(numBlocks);
+
+        std::string buffer;
+        size_t pos = 0;
+        int lines = 0;
+        Block block = {0, 0, 0};
+        while (_blocks.size() < numBlocks && pos < _content.Size())
+        {
+          const char *start = _content.Data() + pos;
+          const size_t remaining = _content.Size() - pos;
+          const char *eol = static_cast<const char *>(
+            std::memchr(start, '\n', remaining));
+          const StringView raw(start,
+            eol ? static_cast<size_t>(eol - start) : remaining);
+          pos += eol ? raw.Size() + 1 : raw.Size();
+          ++lines;
+
+          // Only lines starting with a delimiter or a comment can end a
+          // block, so the rest aren't tokenized.
+          size_t first = 0;
+          while (first < raw.Size() && std::isspace(
+            static_cast<unsigned char>(raw[first])))
+          {
+            ++first;
+          }
+          if (first == raw.Size() || (raw[first] != 'e' && raw[first] != '/'))
+            continue;
+
+          Tokens tokens;
+          tokenize(trimWhitespaces(raw, buffer), " ", tokens);
+          const char *delimiter =
+            _blocks.size() < numSegments ? "end_segment" : "end_zone";
+          if (tokens.Size() == 0 || tokens[0] != delimiter)
+            continue;
+
+          block.end = pos;
+          _blocks.push_back(block);
+          block.begin = pos;
+          block.lines = lines;
+        }
+
+        return _blocks.size() == numBlocks;
+      }
+
+      /// \brief Parse segment and zone blocks using a pool of threads. Each
+      /// block is parsed with its own exit and waypoint caches, which are
+      /// appended to "exitCache" and "waypointCache" in the order of the
+      /// blocks, as a serial load would do.
+      /// \param[in] _content The text that contains the blocks.
+      /// \param[in] _blocks The blocks.
+      /// \param[in] _numSegments Number of segment blocks. The rest are
+      /// zones.
+      /// \param[in] _numThreads Number of threads.
+      /// \param[in, out] _lineNumber Line number before the first block.
+      /// It's set to the line number after the last one.
+      /// \param[out] _segments The segments parsed.
+      /// \param[out] _zones The zones parsed.
+      /// \return True if all the blocks were correctly parsed.
+      public: bool LoadBlocks(const StringView &_content,
+                              const std::vector<Block> &_blocks,
+                              const int _numSegments,
+                              const unsigned int _numThreads,
+                              int &_lineNumber,
+                              std::vector<rndf::Segment> &_segments,
+                              std::vector<rndf::Zone> &_zones)
+      {
+        const size_t numSegments = static_cast<size_t>(_numSegments);
+        std::vector<BlockResult> results(_blocks.size());
+        _segments.assign(numSegments, rndf::Segment());
+        _zones.assign(_blocks.size() - numSegments, rndf::Zone());
+
+        // A serial load stops at the first block that fails, so the blocks
+        // after it aren't claimed once it's known.
+        std::atomic<size_t> next(0);
+        std::atomic<size_t> firstFailed(_blocks.size());
+        auto work = [&]()
+        {
+          rndf::Arena::Scope scope(this->arena.get());
+          for (size_t i = next++; i < firstFailed.load(); i = next++)
+          {
+            const Block &block = _blocks[i];
+            LineReader reader(_content.Data() + block.begin,
+              block.end - block.begin);
+            BlockResult &result = results[i];
+            result.lineNumber = _lineNumber + block.lines;
+            std::ostringstream errors;
+            {
+              ErrorCapture capture(errors);
+              if (i < numSegments)
+              {
+                result.ok = _segments[i].Load(reader, result.lineNumber,
+                  result.exitCache, result.waypointCache);
+              }
+              else
+              {
+                result.ok = _zones[i - numSegments].Load(reader,
+                  result.lineNumber, result.exitCache, result.waypointCache);
+              }
+            }
+            result.errors = errors.str();
+
+            if (!result.ok)
+            {
+              size_t failed = firstFailed.load();
+              while (i < failed &&
+                     !firstFailed.compare_exchange_weak(failed, i))
+              {
+                // "failed" is reloaded by the exchange.
+              }
+            }
+          }
+        };
+
+        const size_t numThreads =
+          std::min(static_cast<size_t>(_numThreads), _blocks.size());
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < numThreads; ++i)
+          threads.emplace_back(work);
+        work();
+        for (auto &thread : threads)
+          thread.join();
+
+        // Check the results in the same order as a serial load.
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+          errorStream() << results[i].errors;
+          if (!results[i].ok)
+            return false;
+
+          _lineNumber = results[i].lineNumber;
+          if (i < numSegments && _segments[i].Id() != static_cast<int>(i + 1))
+          {
+            errorStream() << "[Line " << _lineNumber
+                          << "]: Found non-consecutive "
+                          << "segment Id [" << _segments[i].Id() << "]"
+                          << std::endl;
+            return false;
+          }
+
+          if (i >= numSegments &&
+              static_cast<size_t>(_zones[i - numSegments].Id()) != i + 1)
+          {
+            errorStream() << "[Line " << _lineNumber
+                          << "]: Found non-consecutive "
+                          << "zone Id [" << _zones[i - numSegments].Id() << "]"
+                          << std::endl;
+            return false;
+          }
+
+          this->exitCache.insert(this->exitCache.end(),
+            std::make_move_iterator(results[i].exitCache.begin()),
+            std::make_move_iterator(results[i].exitCache.end()));
+          this->waypointCache.insert(this->waypointCache.end(),
+            results[i].waypointCache.begin(), results[i].waypointCache.end());
+        }
+
+        return true;
+      }
+
+      /// \brief Replace the arena before loading. The previous arena is
+      /// released once the elements allocated in it are destroyed.
+      /// \return The new arena, or nullptr if disabled.
+      public: rndf::Arena *NewArena()
+      {
+        this->arena.reset(this->arenaEnabled ? new rndf::Arena() : nullptr);
+        return this->arena.get();
+      }
+
+      /// \brief A modification of a segment or zone.
+      public: struct Change
+      {
+        /// \brief Revision after the modification.
+        public: uint64_t revision;
+
+        /// \brief Id of the segment or zone.
+        public: int id;
+
+        /// \brief Whether the layout of the waypoints was kept.
+        public: bool sameLayout;
+      };
+
+      /// \brief Maximum number of modifications remembered.
+      public: static const size_t kMaxChanges = 4096;
+
+      /// \brief Record a modification of a segment or zone.
+      /// \param[in] _id Id of the segment or zone.
+      /// \param[in] _sameLayout Whether the unique Ids and exits of its
+      /// waypoints are the same.
+      public: void Modified(const int _id, const bool _sameLayout)
+      {
+        ++this->revision;
+        if (this->changes.size() >= kMaxChanges)
+        {
+          // Forget the oldest half of the modifications.
+          const size_t forgotten = kMaxChanges / 2;
+          this->untrackedRevision = this->changes[forgotten - 1].revision;
+          this->changes.erase(this->changes.begin(),
+            this->changes.begin() + forgotten);
+        }
+        this->changes.push_back({this->revision, _id, _sameLayout});
+      }
+
+      /// \brief Record a modification that may affect any segment or zone.
+      public: void ModifiedAll()
+      {
+        ++this->revision;
+        this->untrackedRevision = this->revision;
+        this->changes.clear();
+      }
+
+      /// \brief Get the segments and zones modified since a revision.
+      /// \param[in] _revision The revision.
+      /// \param[out] _ids Sorted Ids of the segments and zones.
+      /// \param[out] _sameLayout Whether the layout of the waypoints was
+      /// kept by all the modifications.
+      /// \return False if the modifications aren't known.
+      public: bool Changes(const uint64_t _revision, std::vector<int> &_ids,
+                           bool &_sameLayout) const
+      {
+        _ids.clear();
+        _sameLayout = true;
+        if (_revision < this->untrackedRevision || _revision > this->revision)
+          return false;
+
+        auto it = std::upper_bound(this->changes.begin(), this->changes.end(),
+          _revision,
+          [](const uint64_t _value, const Change &_change)
+          {
+            return _value < _change.revision;
+          });
+        for (; it != this->changes.end(); ++it)
+        {
+          _ids.push_back(it->id);
+          _sameLayout = _sameLayout && it->sameLayout;
+        }
+        std::sort(_ids.begin(), _ids.end());
+        _ids.erase(std::unique(_ids.begin(), _ids.end()), _ids.end());
+        return true;
+      }
+
+      /// \brief Get the positions in "coordinates" of the waypoints that
+      /// may have moved since a revision, if the layout of the waypoints
+      /// was kept. "coordinates" must be up to date.
+      /// \param[in] _revision The revision.
+      /// \param[out] _positions The positions.
+      /// \return False if the layout may have changed.
+      public: bool Moved(const uint64_t _revision,
+                         std::vector<uint32_t> &_positions) const
+      {
+        _positions.clear();
+        std::vector<int> ids;
+        bool sameLayout;
+        if (!this->Changes(_revision, ids, sameLayout) || !sameLayout)
+          return false;
+
+        for (auto const &range : this->coordinates.Ranges())
+        {
+          if (std::binary_search(ids.begin(), ids.end(), range.x))
+          {
+            for (uint32_t i = range.begin; i < range.end; ++i)
+              _positions.push_back(i);
+          }
+        }
+        return true;
+      }
+
+      /// \brief Whether two lanes have the same waypoints and exits.
+      /// \param[in] _a A lane.
+      /// \param[in] _b Another lane.
+      /// \return True if they have the same layout.
+      public: static bool SameLayout(const rndf::Lane &_a,
+                                     const rndf::Lane &_b)
+      {
+        return _a.Id() == _b.Id() && _a.Waypoints() == _b.Waypoints() &&
+          _a.Exits() == _b.Exits();
+      }
+
+      /// \brief Whether two segments have the same lanes, waypoints and
+      /// exits.
+      /// \param[in] _a A segment.
+      /// \param[in] _b Another segment.
+      /// \return True if they have the same layout.
+      public: static bool SameLayout(const rndf::Segment &_a,
+                                     const rndf::Segment &_b)
+      {
+        if (_a.Id() != _b.Id() || _a.NumLanes() != _b.NumLanes())
+          return false;
+
+        for (size_t i = 0; i < _a.NumLanes(); ++i)
+        {
+          if (!SameLayout(_a.Lanes()[i], _b.Lanes()[i]))
+            return false;
+        }
+        return true;
+      }
+
+      /// \brief Whether two zones have the same perimeter, parking spots,
+      /// waypoints and exits.
+      /// \param[in] _a A zone.
+      /// \param[in] _b Another zone.
+      /// \return True if they have the same layout.
+      public: static bool SameLayout(const rndf::Zone &_a,
+                                     const rndf::Zone &_b)
+      {
+        if (_a.Id() != _b.Id() || _a.NumSpots() != _b.NumSpots() ||
+            _a.Perimeter().Points() != _b.Perimeter().Points() ||
+            _a.Perimeter().Exits() != _b.Perimeter().Exits())
+        {
+          return false;
+        }
+
+        for (size_t i = 0; i < _a.NumSpots(); ++i)
+        {
+          if (_a.Spots()[i].Id() != _b.Spots()[i].Id() ||
+              _a.Spots()[i].Waypoints() != _b.Spots()[i].Waypoints())
+          {
+            return false;
+          }
+        }
+        return true;
+      }
+
+      /// \brief Bring a structure derived from the RNDF up to date. Several
+      /// threads may request it at the same time from the const accessors:
+      /// the first one updates it while the rest wait, and once it's up to
+      /// date they only check its revision.
+      /// \param[in, out] _builtRevision Revision of the RNDF the structure
+      /// was built from.
+      /// \param[in] _mutex Mutex of the structure.
+      /// \param[in] _update Function that updates the structure, given the
+      /// revision it was built from.
+      public: template<typename F>
+      void Refresh(std::atomic<uint64_t> &_builtRevision, std::mutex &_mutex,
+                   const F &_update)
+      {
+        if (_builtRevision.load(std::memory_order_acquire) == this->revision)
+          return;
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        const uint64_t built = _builtRevision.load(std::memory_order_relaxed);
+        if (built == this->revision)
+          return;
+
+        _update(built);
+        _builtRevision.store(this->revision, std::memory_order_release);
+      }
+
+      /// \brief A revision that no structure is built from, used to force
+      /// a full rebuild.
+      public: static const uint64_t kNoRevision;
+
+      /// \brief Number of modifications of the segments and zones.
+      public: uint64_t revision = 0;
+
+      /// \brief Last revision of a modification not in "changes".
+      public: uint64_t untrackedRevision = 0;
+
+      /// \brief Modifications after "untrackedRevision", in order.
+      public: std::vector<Change> changes;
+
+      /// \brief Coordinates of all the waypoints.
+      public: CoordinateSnapshot coordinates;
+
+      /// \brief Revision of the RNDF "coordinates" was built from.
+      public: std::atomic<uint64_t> coordinatesRevision{0};
+
+      /// \brief Mutex held while "coordinates" is updated.
+      public: std::mutex coordinatesMutex;
+
+      /// \brief Spatial index of all the waypoints.
+      public: rndf::SpatialIndex spatialIndex;
+
+      /// \brief Revision of the RNDF "spatialIndex" was built from.
+      public: std::atomic<uint64_t> spatialIndexRevision{0};
+
+      /// \brief Mutex held while "spatialIndex" is updated.
+      public: std::mutex spatialIndexMutex;
+
+      /// \brief Index of the lane centerlines.
+      public: rndf::LaneIndex laneIndex;
+
+      /// \brief Revision of the RNDF "laneIndex" was built from.
+      public: std::atomic<uint64_t> laneIndexRevision{0};
+
+      /// \brief Mutex held while "laneIndex" is updated.
+      public: std::mutex laneIndexMutex;
+
+      /// \brief Graph of the road network.
+      public: rndf::RoadGraph roadGraph;
+
+      /// \brief Revision of the RNDF "roadGraph" was built from.
+      public: std::atomic<uint64_t> roadGraphRevision{0};
+
+      /// \brief Mutex held while "roadGraph" is updated.
+      public: std::mutex roadGraphMutex;
+
+      /// \brief Local coordinates of all the waypoints.
+      public: rndf::LocalCoordinates localCoordinates;
+
+      /// \brief Revision of the RNDF "localCoordinates" was built from, or
+      /// kNoRevision if the origin changed since.
+      public: std::atomic<uint64_t> localCoordinatesRevision{0};
+
+      /// \brief Mutex held while "localCoordinates" is updated.
+      public: std::mutex localCoordinatesMutex;
+
+      /// \brief Whether the origin of "localCoordinates" was set.
+      public: bool hasOrigin = false;
+
+      /// \brief Latitude of the origin set in degrees.
+      public: double originLatitude = 0;
+
+      /// \brief Longitude of the origin set in degrees.
+      public: double originLongitude = 0;
+
+      /// \brief Whether the elements loaded are allocated in an arena.
+      public: bool arenaEnabled = false;
+
+      /// \brief Arena of the last load, or nullptr.
+      public: std::unique_ptr<rndf::Arena> arena;
     };
   }
 }
 
+//////////////////////////////////////////////////
+const uint64_t RNDFPrivate::kNoRevision =
+  std::numeric_limits<uint64_t>::max();
+
 //////////////////////////////////////////////////
 RNDFHeader::RNDFHeader()
 {
@@ -109,54 +1086,49 @@ RNDFHeader::~RNDFHeader()
 }
 
 //////////////////////////////////////////////////
-bool RNDFHeader::Load(std::ifstream &_rndfFile, int &_lineNumber)
+bool RNDFHeader::Load(LineReader &_reader, int &_lineNumber)
 {
   bool versionFound = false;
   bool dateFound = false;
 
   for (auto i = 0; i < 2; ++i)
   {
-    auto oldPos = _rndfFile.tellg();
-    int oldLineNumber = _lineNumber;
-
-    std::string lineread;
-    nextRealLine(_rndfFile, lineread, _lineNumber);
+    StringView lineread;
+    _reader.Peek(lineread);
 
-    auto tokens = split(lineread, " ");
+    Tokens tokens;
+    tokenize(lineread, " ", tokens);
 
     // Check if we found the "segment" element.
-    // If this is the case we should leave.
-    if (tokens.size() == 2 && tokens.at(0) == "segment")
-    {
-      // Restore the file position and line number.
-      // ParseHeader() shouldn't have any effect.
-      _rndfFile.seekg(oldPos);
-      _lineNumber = oldLineNumber;
+    // If this is the case we should leave it for the segment parser.
+    if (tokens.Size() == 2 && tokens[0] == "segment")
       return true;
-    }
 
-    if ((tokens.size() != 2)                            ||
+    _reader.Consume(_lineNumber);
+
+    if ((tokens.Size() != 2)                            ||
         (tokens[0] == "format_version" && versionFound) ||
         (tokens[0] == "creation_date" && dateFound))
     {
       // Invalid or repeated header element.
-      std::cerr << "[Line " << _lineNumber << "]: Unable to parse file header "
-                << "element." << std::endl;
-      std::cerr << " \"" << lineread << "\"" << std::endl;
+      errorStream() << "[Line " << _lineNumber
+                    << "]: Unable to parse file header "
+                    << "element." << std::endl;
+      errorStream() << " \"" << lineread << "\"" << std::endl;
       return false;
     }
 
-    assert(tokens.size() == 2);
+    assert(tokens.Size() == 2);
 
     if (tokens[0] == "format_version")
     {
-      this->SetVersion(tokens[1]);
+      this->SetVersion(tokens[1].String());
       versionFound = true;
     }
     // creation_date option.
     else
     {
-      this->SetDate(tokens[1]);
+      this->SetDate(tokens[1].String());
       dateFound = true;
     }
   }
@@ -164,6 +1136,13 @@ bool RNDFHeader::Load(std::ifstream &_rndfFile, int &_lineNumber)
   return true;
 }
 
+//////////////////////////////////////////////////
+bool RNDFHeader::Load(std::ifstream &_rndfFile, int &_lineNumber)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _lineNumber);
+}
+
 //////////////////////////////////////////////////
 std::string RNDFHeader::Version() const
 {
@@ -201,6 +1180,19 @@ RNDF::RNDF(const std::string &_filepath)
   this->Load(_filepath);
 }
 
+//////////////////////////////////////////////////
+RNDF::RNDF(RNDF &&_other) noexcept  // NOLINT
+  : dataPtr(std::move(_other.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+RNDF &RNDF::operator=(RNDF &&_other) noexcept  // NOLINT
+{
+  std::swap(this->dataPtr, _other.dataPtr);
+  return *this;
+}
+
 //////////////////////////////////////////////////
 RNDF::~RNDF()
 {
@@ -209,97 +1201,177 @@ RNDF::~RNDF()
 //////////////////////////////////////////////////
 bool RNDF::Load(const std::string &_filePath)
 {
-  std::ifstream rndfFile(_filePath, std::ifstream::binary);
-  if (!rndfFile.good())
+  LineReader rndfFile;
+  if (!rndfFile.Open(_filePath))
   {
     std::cerr << "Error opening RNDF [" << _filePath << "]" << std::endl;
     return false;
   }
 
-  int lineNumber = 0;
+  return this->Load(rndfFile);
+}
 
-  // Parse "RNDF_name"
-  std::string fileName;
-  if (!parseString(rndfFile, "RNDF_name", fileName, lineNumber))
+//////////////////////////////////////////////////
+bool RNDF::Load(const std::string &_filePath, const unsigned int _numThreads)
+{
+  LineReader rndfFile;
+  if (!rndfFile.Open(_filePath))
+  {
+    std::cerr << "Error opening RNDF [" << _filePath << "]" << std::endl;
     return false;
+  }
 
-  // Parse "num_segments".
-  int numSegments;
-  if (!parsePositive(rndfFile, "num_segments", numSegments, lineNumber))
-    return false;
+  return this->Load(rndfFile, _numThreads);
+}
 
-  // Parse "num_zones".
-  int numZones;
-  if (!parseNonNegative(rndfFile, "num_zones", numZones, lineNumber))
+//////////////////////////////////////////////////
+bool RNDF::Load(const std::string &_filePath, const std::string &_cachePath)
+{
+  LineReader rndfFile;
+  if (!rndfFile.Open(_filePath))
+  {
+    std::cerr << "Error opening RNDF [" << _filePath << "]" << std::endl;
     return false;
+  }
 
-  // Parse optional file header (format_version and/or creation_date).
-  RNDFHeader header;
-  if (!header.Load(rndfFile, lineNumber))
-    return false;
+  // Streamed files can't be hashed without reading them twice.
+  StringView content;
+  if (!rndfFile.Remaining(content))
+    return this->Load(rndfFile);
 
-  // Parse all segments.
-  std::vector<rndf::Segment> segments;
-  for (auto i = 0; i < numSegments; ++i)
+  const uint64_t hash = RNDFCache::Hash(content);
   {
-    rndf::Segment segment;
-    if (!segment.Load(rndfFile, lineNumber, this->dataPtr->exitCache,
-      this->dataPtr->waypointCache))
+    // Allocate the elements in a new arena, if enabled.
+    rndf::Arena::Scope scope(this->dataPtr->NewArena());
+    std::string name;
+    std::string version;
+    std::string date;
+    std::vector<rndf::Segment> segments;
+    std::vector<rndf::Zone> zones;
+    if (RNDFCache::Read(_cachePath, hash, name, version, date, segments,
+      zones))
     {
-      return false;
+      this->dataPtr->exitCache.clear();
+      this->dataPtr->waypointCache.clear();
+      this->SetName(name);
+      this->dataPtr->segments = std::move(segments);
+      this->dataPtr->zones = std::move(zones);
+      this->SetVersion(version);
+      this->SetDate(date);
+      this->dataPtr->ModifiedAll();
+      this->UpdateCache();
+      return true;
     }
+  }
 
-    // Check that all segments are consecutive.
-    if (segment.Id() != i + 1)
-    {
-      std::cerr << "[Line " << lineNumber << "]: Found non-consecutive segment "
-                << "Id [" << segment.Id() << "]" << std::endl;
-      return false;
-    }
+  if (!this->Load(rndfFile))
+    return false;
+
+  if (!RNDFCache::Write(_cachePath, hash, *this))
+  {
+    std::cerr << "Warning: Unable to write RNDF cache [" << _cachePath << "]"
+              << std::endl;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RNDF::Load(std::istream &_stream)
+{
+  if (!_stream.good())
+  {
+    std::cerr << "Error reading RNDF from stream" << std::endl;
+    return false;
+  }
+
+  LineReader reader(_stream);
+  return this->Load(reader);
+}
+
+//////////////////////////////////////////////////
+bool RNDF::Load(LineReader &_reader)
+{
+  return this->Load(_reader, 1u);
+}
+
+//////////////////////////////////////////////////
+bool RNDF::Load(LineReader &_reader, const unsigned int _numThreads)
+{
+  int lineNumber = 0;
+
+  // Discard the exits and waypoints cached by a previous call.
+  this->dataPtr->exitCache.clear();
+  this->dataPtr->waypointCache.clear();
 
-    segments.push_back(segment);
+  // Allocate the elements in a new arena, if enabled.
+  rndf::Arena::Scope scope(this->dataPtr->NewArena());
+
+  std::string fileName;
+  int numSegments;
+  int numZones;
+  RNDFHeader header;
+  if (!RNDFPrivate::ParsePreamble(_reader, lineNumber, fileName, numSegments,
+    numZones, header))
+  {
+    return false;
   }
 
-  // Parse all zones.
+  unsigned int numThreads = _numThreads;
+  if (numThreads == 0)
+    numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+  // Parse the segments and zones in parallel if possible.
+  std::vector<rndf::Segment> segments;
   std::vector<rndf::Zone> zones;
-  for (auto i = 0; i < numZones; ++i)
+  StringView content;
+  std::vector<RNDFPrivate::Block> blocks;
+  if (numThreads > 1 && _reader.Remaining(content) &&
+      RNDFPrivate::SplitBlocks(content, numSegments, numZones, blocks))
   {
-    rndf::Zone zone;
-    if (!zone.Load(rndfFile, lineNumber, this->dataPtr->exitCache,
-      this->dataPtr->waypointCache))
+    int blocksLineNumber = lineNumber;
+    if (!this->dataPtr->LoadBlocks(content, blocks, numSegments, numThreads,
+      lineNumber, segments, zones))
     {
       return false;
     }
 
-    // Check that all zones are consecutive.
-    size_t expectedZoneId = segments.size() + i + 1;
-    if (static_cast<size_t>(zone.Id()) != expectedZoneId)
+    // Move the reader after the last block.
+    _reader.Skip(blocks.back().end, blocksLineNumber);
+    assert(blocksLineNumber == lineNumber);
+  }
+  else
+  {
+    RNDFBuilder builder(this->dataPtr->exitCache,
+      this->dataPtr->waypointCache);
+    if (!RNDFPrivate::ParseBlocks(_reader, numSegments, numZones, lineNumber,
+      builder))
     {
-      std::cerr << "[Line " << lineNumber << "]: Found non-consecutive zone "
-                << "Id [" << zone.Id() << "]" << std::endl;
       return false;
     }
 
-    zones.push_back(zone);
+    segments = std::move(builder.Segments());
+    zones = std::move(builder.Zones());
   }
 
   // Parse "end_file".
-  if (!parseDelimiter(rndfFile, "end_file", lineNumber))
+  if (!parseDelimiter(_reader, "end_file", lineNumber))
     return false;
 
-  rndfFile.close();
+  // Index the waypoints parsed, so each exit is validated in constant time.
+  std::unordered_set<uint64_t> waypoints(
+    this->dataPtr->waypointCache.begin(), this->dataPtr->waypointCache.end());
 
   // Sanity check: Validate all entries.
   for (auto const &exitElement : this->dataPtr->exitCache)
   {
-    if (std::find(this->dataPtr->waypointCache.begin(),
-      this->dataPtr->waypointCache.end(), exitElement.entryId) ==
-      this->dataPtr->waypointCache.end())
+    if (waypoints.find(exitElement.entryKey) == waypoints.end())
     {
-      std::cerr << "[Line " << exitElement.lineNumber << "]: Non-existent entry"
-                << " Id ["  << exitElement.entryId << "]" << std::endl;
-      std::cerr << " \"" << exitElement.line << "\"" << std::endl;
-      this->dataPtr->cache.clear();
+      errorStream() << "[Line " << exitElement.lineNumber
+                    << "]: Non-existent entry"
+                    << " Id ["  << exitElement.entryId << "]" << std::endl;
+      errorStream() << " \"" << exitElement.line << "\"" << std::endl;
+      this->dataPtr->ClearNodes();
       return false;
     }
   }
@@ -307,42 +1379,119 @@ bool RNDF::Load(const std::string &_filePath)
   // Sanity check: Validate all exit Ids.
   for (auto const &exitElement : this->dataPtr->exitCache)
   {
-    if (std::find(this->dataPtr->waypointCache.begin(),
-      this->dataPtr->waypointCache.end(), exitElement.exitId) ==
-      this->dataPtr->waypointCache.end())
+    if (waypoints.find(exitElement.exitKey) == waypoints.end())
     {
-      std::cerr << "[Line " << exitElement.lineNumber << "]: Non-existent exit"
-                << " Id ["  << exitElement.exitId << "]" << std::endl;
-      std::cerr << " \"" << exitElement.line << "\"" << std::endl;
-      this->dataPtr->cache.clear();
+      errorStream() << "[Line " << exitElement.lineNumber
+                    << "]: Non-existent exit"
+                    << " Id ["  << exitElement.exitId << "]" << std::endl;
+      errorStream() << " \"" << exitElement.line << "\"" << std::endl;
+      this->dataPtr->ClearNodes();
       return false;
     }
   }
 
   // Populate the RNDF.
   this->SetName(fileName);
-  this->Segments() = segments;
-  this->Zones() = zones;
+  this->dataPtr->segments = std::move(segments);
+  this->dataPtr->zones = std::move(zones);
   this->SetVersion(header.Version());
   this->SetDate(header.Date());
 
+  this->dataPtr->ModifiedAll();
   this->UpdateCache();
 
   // Set the "entry" flag of the waypoints that are entry points.
-  for (auto &exitElement : this->dataPtr->exitCache)
+  for (auto const &exitElement : this->dataPtr->exitCache)
   {
-    std::string entryId = exitElement.entryId;
-    assert(this->dataPtr->cache.find(exitElement.entryId) !=
-      this->dataPtr->cache.end());
-
-    auto &rndfNode = this->dataPtr->cache[entryId];
-    assert(rndfNode.Waypoint());
-    rndfNode.Waypoint()->SetEntry(true);
+    RNDFNode *rndfNode = this->dataPtr->FindNode(exitElement.entryKey);
+    assert(rndfNode);
+    assert(rndfNode->Waypoint());
+    rndfNode->Waypoint()->SetEntry(true);
   }
 
   return true;
 }
 
+//////////////////////////////////////////////////
+void RNDF::SetArenaEnabled(const bool _enabled)
+{
+  this->dataPtr->arenaEnabled = _enabled;
+}
+
+//////////////////////////////////////////////////
+bool RNDF::ArenaEnabled() const
+{
+  return this->dataPtr->arenaEnabled;
+}
+
+//////////////////////////////////////////////////
+const rndf::Arena *RNDF::Arena() const
+{
+  return this->dataPtr->arena.get();
+}
+
+//////////////////////////////////////////////////
+bool RNDF::Parse(const std::string &_filePath, RNDFVisitor &_visitor)
+{
+  LineReader rndfFile;
+  if (!rndfFile.Open(_filePath))
+  {
+    std::cerr << "Error opening RNDF [" << _filePath << "]" << std::endl;
+    return false;
+  }
+
+  return Parse(rndfFile, _visitor);
+}
+
+//////////////////////////////////////////////////
+bool RNDF::Parse(LineReader &_reader, RNDFVisitor &_visitor)
+{
+  int lineNumber = 0;
+  std::string fileName;
+  int numSegments;
+  int numZones;
+  RNDFHeader header;
+  if (!RNDFPrivate::ParsePreamble(_reader, lineNumber, fileName, numSegments,
+    numZones, header))
+  {
+    return false;
+  }
+
+  _visitor.OnRNDF(fileName, numSegments, numZones, header.Version(),
+    header.Date());
+
+  if (!RNDFPrivate::ParseBlocks(_reader, numSegments, numZones, lineNumber,
+    _visitor))
+  {
+    return false;
+  }
+
+  // Parse "end_file".
+  return parseDelimiter(_reader, "end_file", lineNumber);
+}
+
+//////////////////////////////////////////////////
+bool RNDF::Save(const std::string &_filePath) const
+{
+  std::ofstream file(_filePath, std::ios::binary);
+  if (!file.is_open())
+  {
+    std::cerr << "Error creating RNDF file [" << _filePath << "]"
+              << std::endl;
+    return false;
+  }
+
+  return this->Save(file);
+}
+
+//////////////////////////////////////////////////
+bool RNDF::Save(std::ostream &_stream) const
+{
+  RNDFWriter writer(_stream);
+  writer.WriteRNDF(*this);
+  return writer.Flush();
+}
+
 //////////////////////////////////////////////////
 std::string RNDF::Name() const
 {
@@ -376,29 +1525,46 @@ const std::vector<Segment> &RNDF::Segments() const
 //////////////////////////////////////////////////
 bool RNDF::Segment(const int _segmentId, rndf::Segment &_segment) const
 {
-  auto it = std::find_if(this->dataPtr->segments.begin(),
-    this->dataPtr->segments.end(),
-    [_segmentId](const rndf::Segment &_aSegment)
-    {
-      return _aSegment.Id() == _segmentId;
-    });
+  const rndf::Segment *segment = this->Segment(_segmentId);
+  if (segment)
+    _segment = *segment;
 
-  bool found = it != this->dataPtr->segments.end();
-  if (found)
-    _segment = *it;
+  return segment != nullptr;
+}
 
-  return found;
+//////////////////////////////////////////////////
+const rndf::Segment *RNDF::Segment(const int _segmentId) const
+{
+  return findById(this->dataPtr->segments, _segmentId);
+}
+
+//////////////////////////////////////////////////
+rndf::Segment *RNDF::Segment(const int _segmentId)
+{
+  return findById(this->dataPtr->segments, _segmentId);
 }
 
 //////////////////////////////////////////////////
 bool RNDF::UpdateSegment(const rndf::Segment &_segment)
 {
-  auto it = std::find(this->dataPtr->segments.begin(),
-    this->dataPtr->segments.end(), _segment);
+  auto &segments = this->dataPtr->segments;
+  rndf::Segment *current = findById(segments, _segment.Id());
 
-  bool found = it != this->dataPtr->segments.end();
+  bool found = current != nullptr;
   if (found)
-    *it = _segment;
+  {
+    // Copied, since _segment may be the stored element itself.
+    rndf::Segment previous(*current);
+    *current = _segment;
+    this->dataPtr->Modified(_segment.Id(),
+      RNDFPrivate::SameLayout(previous, _segment));
+
+    // The nodes of the waypoints kept are updated in place.
+    this->dataPtr->NextPass();
+    this->dataPtr->IndexSegment(
+      static_cast<size_t>(current - segments.data()));
+    this->dataPtr->UnindexSegment(previous);
+  }
 
   return found;
 }
@@ -424,17 +1590,60 @@ bool RNDF::AddSegment(const rndf::Segment &_newSegment)
 
   this->dataPtr->segments.push_back(_newSegment);
   assert(this->NumSegments() == this->dataPtr->segments.size());
+  this->dataPtr->Modified(_newSegment.Id(), false);
+  this->dataPtr->IndexSegment(this->dataPtr->segments.size() - 1);
   return true;
 }
 
 //////////////////////////////////////////////////
 bool RNDF::RemoveSegment(const int _segmentId)
 {
+  this->dataPtr->NextPass();
+  for (auto const &seg : this->dataPtr->segments)
+  {
+    if (seg.Id() == _segmentId)
+      this->dataPtr->UnindexSegment(seg);
+  }
+
   rndf::Segment segment(_segmentId);
   auto end = this->dataPtr->segments.end();
   auto removed = std::remove(this->dataPtr->segments.begin(), end, segment);
-  return end !=
-    this->dataPtr->segments.erase(removed, this->dataPtr->segments.end());
+  if (removed == end)
+    return false;
+
+  this->dataPtr->segments.erase(removed, end);
+  this->dataPtr->elementKeys.erase(_segmentId);
+  this->dataPtr->Modified(_segmentId, false);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RNDF::UpdateLane(const int _segmentId, const rndf::Lane &_lane)
+{
+  auto &segments = this->dataPtr->segments;
+  rndf::Segment *seg = findById(segments, _segmentId);
+  if (!seg)
+    return false;
+
+  auto &lanes = seg->Lanes();
+  rndf::Lane *ln = findById(lanes, _lane.Id());
+  if (!ln)
+    return false;
+
+  // Copied, since _lane may be the stored lane itself.
+  rndf::Lane previous(*ln);
+  *ln = _lane;
+  this->dataPtr->Modified(_segmentId,
+    RNDFPrivate::SameLayout(previous, _lane));
+
+  // The nodes of the waypoints kept are updated in place, so the pointers
+  // to them remain valid.
+  this->dataPtr->NextPass();
+  this->dataPtr->IndexLane(static_cast<size_t>(seg - segments.data()),
+    static_cast<size_t>(ln - lanes.data()));
+  this->dataPtr->UnindexLane(_segmentId, previous);
+  this->dataPtr->RecordKeys(*seg);
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -458,29 +1667,45 @@ const std::vector<Zone> &RNDF::Zones() const
 //////////////////////////////////////////////////
 bool RNDF::Zone(const int _zoneId, rndf::Zone &_zone) const
 {
-  auto it = std::find_if(this->dataPtr->zones.begin(),
-    this->dataPtr->zones.end(),
-    [_zoneId](const rndf::Zone &_aZone)
-    {
-      return _aZone.Id() == _zoneId;
-    });
+  const rndf::Zone *zone = this->Zone(_zoneId);
+  if (zone)
+    _zone = *zone;
 
-  bool found = it != this->dataPtr->zones.end();
-  if (found)
-    _zone = *it;
+  return zone != nullptr;
+}
 
-  return found;
+//////////////////////////////////////////////////
+const rndf::Zone *RNDF::Zone(const int _zoneId) const
+{
+  return findById(this->dataPtr->zones, _zoneId);
+}
+
+//////////////////////////////////////////////////
+rndf::Zone *RNDF::Zone(const int _zoneId)
+{
+  return findById(this->dataPtr->zones, _zoneId);
 }
 
 //////////////////////////////////////////////////
 bool RNDF::UpdateZone(const rndf::Zone &_zone)
 {
-  auto it = std::find(this->dataPtr->zones.begin(),
-    this->dataPtr->zones.end(), _zone);
+  auto &zones = this->dataPtr->zones;
+  rndf::Zone *current = findById(zones, _zone.Id());
 
-  bool found = it != this->dataPtr->zones.end();
+  bool found = current != nullptr;
   if (found)
-    *it = _zone;
+  {
+    // Copied, since _zone may be the stored element itself.
+    rndf::Zone previous(*current);
+    *current = _zone;
+    this->dataPtr->Modified(_zone.Id(),
+      RNDFPrivate::SameLayout(previous, _zone));
+
+    // The nodes of the waypoints kept are updated in place.
+    this->dataPtr->NextPass();
+    this->dataPtr->IndexZone(static_cast<size_t>(current - zones.data()));
+    this->dataPtr->UnindexZone(previous);
+  }
 
   return found;
 }
@@ -506,16 +1731,31 @@ bool RNDF::AddZone(const rndf::Zone &_newZone)
 
   this->dataPtr->zones.push_back(_newZone);
   assert(this->NumZones() == this->dataPtr->zones.size());
+  this->dataPtr->Modified(_newZone.Id(), false);
+  this->dataPtr->IndexZone(this->dataPtr->zones.size() - 1);
   return true;
 }
 
 //////////////////////////////////////////////////
 bool RNDF::RemoveZone(const int _zoneId)
 {
+  this->dataPtr->NextPass();
+  for (auto const &zn : this->dataPtr->zones)
+  {
+    if (zn.Id() == _zoneId)
+      this->dataPtr->UnindexZone(zn);
+  }
+
   rndf::Zone zone(_zoneId);
   auto end = this->dataPtr->zones.end();
   auto removed = std::remove(this->dataPtr->zones.begin(), end, zone);
-  return end != this->dataPtr->zones.erase(removed, this->dataPtr->zones.end());
+  if (removed == end)
+    return false;
+
+  this->dataPtr->zones.erase(removed, end);
+  this->dataPtr->elementKeys.erase(_zoneId);
+  this->dataPtr->Modified(_zoneId, false);
+  return true;
 }
 
 //////////////////////////////////////////////////
@@ -570,47 +1810,159 @@ bool RNDF::Valid() const
 //////////////////////////////////////////////////
 void RNDF::UpdateCache()
 {
-  for (auto &segment : this->Segments())
-    for (auto &lane : segment.Lanes())
-      for (auto &wp : lane.Waypoints())
-      {
-        rndf::UniqueId id(segment.Id(), lane.Id(), wp.Id());
-        rndf::RNDFNode node(id);
-        node.SetSegment(&segment);
-        node.SetLane(&lane);
-        node.SetWaypoint(&wp);
-        this->dataPtr->cache[id.String()] = node;
-      }
+  this->dataPtr->Reindex();
+}
 
-  for (auto &zone : this->Zones())
-  {
-    for (auto &wp : zone.Perimeter().Points())
+//////////////////////////////////////////////////
+RNDFNode *RNDF::Info(const rndf::UniqueId &_id) const
+{
+  return this->dataPtr->FindNode(_id.Key());
+}
+
+//////////////////////////////////////////////////
+uint64_t RNDF::Revision() const
+{
+  return this->dataPtr->revision;
+}
+
+//////////////////////////////////////////////////
+bool RNDF::Changes(const uint64_t _revision, std::vector<int> &_ids,
+  bool &_sameLayout) const
+{
+  return this->dataPtr->Changes(_revision, _ids, _sameLayout);
+}
+
+//////////////////////////////////////////////////
+void RNDF::MarkModified(const int _id)
+{
+  this->dataPtr->Modified(_id, false);
+  this->dataPtr->ReindexElement(_id);
+}
+
+//////////////////////////////////////////////////
+void RNDF::MarkModified()
+{
+  this->dataPtr->ModifiedAll();
+  this->dataPtr->Reindex();
+}
+
+//////////////////////////////////////////////////
+const CoordinateSnapshot &RNDF::Coordinates() const
+{
+  RNDFPrivate &data = *this->dataPtr;
+  data.Refresh(data.coordinatesRevision, data.coordinatesMutex,
+    [&](const uint64_t _built)
     {
-      rndf::UniqueId id(zone.Id(), 0, wp.Id());
-      rndf::RNDFNode node(id);
-      node.SetZone(&zone);
-      node.SetWaypoint(&wp);
-      this->dataPtr->cache[id.String()] = node;
-    }
-    for (auto &spot : zone.Spots())
+      // Only copy the coordinates of the segments and zones modified, if
+      // the layout of the waypoints is the same.
+      std::vector<int> ids;
+      bool sameLayout;
+      std::vector<uint32_t> updated;
+      if (data.Changes(_built, ids, sameLayout) && sameLayout)
+        data.coordinates.Update(*this, ids, updated);
+      else
+        data.coordinates.Update(*this);
+    });
+
+  return data.coordinates;
+}
+
+//////////////////////////////////////////////////
+const rndf::SpatialIndex &RNDF::SpatialIndex() const
+{
+  const CoordinateSnapshot &coordinates = this->Coordinates();
+  RNDFPrivate &data = *this->dataPtr;
+  data.Refresh(data.spatialIndexRevision, data.spatialIndexMutex,
+    [&](const uint64_t _built)
     {
-      for (auto &wp : spot.Waypoints())
-      {
-        rndf::UniqueId id(zone.Id(), spot.Id(), wp.Id());
-        rndf::RNDFNode node(id);
-        node.SetZone(&zone);
-        node.SetWaypoint(&wp);
-        this->dataPtr->cache[id.String()] = node;
-      }
-    }
-  }
+      std::vector<uint32_t> moved;
+      if (data.Moved(_built, moved))
+        data.spatialIndex.Update(coordinates, moved);
+      else
+        data.spatialIndex.Update(coordinates);
+    });
+
+  return data.spatialIndex;
 }
 
 //////////////////////////////////////////////////
-RNDFNode *RNDF::Info(const rndf::UniqueId &_id) const
+const rndf::LaneIndex &RNDF::LaneIndex() const
+{
+  RNDFPrivate &data = *this->dataPtr;
+  data.Refresh(data.laneIndexRevision, data.laneIndexMutex,
+    [&](const uint64_t)
+    {
+      data.laneIndex.Update(*this);
+    });
+
+  return data.laneIndex;
+}
+
+//////////////////////////////////////////////////
+const rndf::RoadGraph &RNDF::RoadGraph() const
+{
+  const CoordinateSnapshot &coordinates = this->Coordinates();
+  RNDFPrivate &data = *this->dataPtr;
+  data.Refresh(data.roadGraphRevision, data.roadGraphMutex,
+    [&](const uint64_t _built)
+    {
+      std::vector<uint32_t> moved;
+      if (data.Moved(_built, moved))
+        data.roadGraph.Update(coordinates, moved);
+      else
+        data.roadGraph.Update(*this);
+    });
+
+  return data.roadGraph;
+}
+
+//////////////////////////////////////////////////
+void RNDF::SetOrigin(const double _latitude, const double _longitude)
+{
+  RNDFPrivate &data = *this->dataPtr;
+  data.hasOrigin = true;
+  data.originLatitude = _latitude;
+  data.originLongitude = _longitude;
+  data.localCoordinatesRevision = RNDFPrivate::kNoRevision;
+}
+
+//////////////////////////////////////////////////
+void RNDF::ClearOrigin()
+{
+  RNDFPrivate &data = *this->dataPtr;
+  data.hasOrigin = false;
+  data.localCoordinatesRevision = RNDFPrivate::kNoRevision;
+}
+
+//////////////////////////////////////////////////
+bool RNDF::HasOrigin() const
 {
-  if (this->dataPtr->cache.find(_id.String()) == this->dataPtr->cache.end())
-    return nullptr;
+  return this->dataPtr->hasOrigin;
+}
+
+//////////////////////////////////////////////////
+const rndf::LocalCoordinates &RNDF::LocalCoordinates() const
+{
+  const CoordinateSnapshot &coordinates = this->Coordinates();
+  RNDFPrivate &data = *this->dataPtr;
+  data.Refresh(data.localCoordinatesRevision, data.localCoordinatesMutex,
+    [&](const uint64_t _built)
+    {
+      std::vector<uint32_t> moved;
+      if (_built != RNDFPrivate::kNoRevision && data.Moved(_built, moved))
+      {
+        data.localCoordinates.Update(coordinates, moved);
+      }
+      else if (data.hasOrigin)
+      {
+        data.localCoordinates.Update(coordinates, data.originLatitude,
+          data.originLongitude);
+      }
+      else
+      {
+        data.localCoordinates.Update(coordinates);
+      }
+    });
 
-  return &(this->dataPtr->cache[_id.String()]);
+  return data.localCoordinates;
 }
@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDFBuilder.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for RNDFBuilder class.
+    class RNDFBuilderPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in, out] _exitCache Cache of exits parsed.
+      /// \param[in, out] _waypointCache Cache of waypoints parsed.
+      public: RNDFBuilderPrivate(std::vector<ExitCacheEntry> &_exitCache,
+                                 std::vector<uint64_t> &_waypointCache)
+        : exitCache(_exitCache),
+          waypointCache(_waypointCache)
+      {
+      }
+
+      /// \brief Get the lane under construction.
+      /// \return The last lane of the last segment.
+      public: rndf::Lane &Lane()
+      {
+        assert(!this->segments.empty());
+        assert(!this->segments.back().Lanes().empty());
+        return this->segments.back().Lanes().back();
+      }
+
+      /// \brief The cache of exits parsed.
+      public: std::vector<ExitCacheEntry> &exitCache;
+
+      /// \brief The keys of the lane waypoints and perimeter points parsed.
+      public: std::vector<uint64_t> &waypointCache;
+
+      /// \brief The segments built.
+      public: std::vector<rndf::Segment> segments;
+
+      /// \brief The zones built.
+      public: std::vector<rndf::Zone> zones;
+
+      /// \brief Whether the waypoints reported belong to a zone.
+      public: bool inZone = false;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+RNDFBuilder::RNDFBuilder(std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<uint64_t> &_waypointCache)
+  : dataPtr(new RNDFBuilderPrivate(_exitCache, _waypointCache))
+{
+}
+
+//////////////////////////////////////////////////
+RNDFBuilder::~RNDFBuilder()
+{
+}
+
+//////////////////////////////////////////////////
+std::vector<Segment> &RNDFBuilder::Segments()
+{
+  return this->dataPtr->segments;
+}
+
+//////////////////////////////////////////////////
+std::vector<Zone> &RNDFBuilder::Zones()
+{
+  return this->dataPtr->zones;
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnSegment(const int _segmentId, const int _numLanes,
+  const std::string &_name)
+{
+  this->dataPtr->segments.emplace_back(_segmentId);
+  rndf::Segment &segment = this->dataPtr->segments.back();
+  segment.SetName(_name);
+  segment.Lanes().reserve(_numLanes);
+  this->dataPtr->inZone = false;
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnLane(const int /*_segmentId*/, const int _laneId,
+  const int _numWaypoints)
+{
+  assert(!this->dataPtr->segments.empty());
+  this->dataPtr->segments.back().Lanes().emplace_back(_laneId);
+  this->dataPtr->Lane().Waypoints().reserve(_numWaypoints);
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnLaneHeader(const int /*_segmentId*/,
+  const int /*_laneId*/, const double _width, const Marking _leftBoundary,
+  const Marking _rightBoundary)
+{
+  rndf::Lane &lane = this->dataPtr->Lane();
+  lane.SetWidth(_width);
+  lane.SetLeftBoundary(_leftBoundary);
+  lane.SetRightBoundary(_rightBoundary);
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnCheckpoint(const int /*_segmentId*/,
+  const int /*_laneId*/, const Checkpoint &_checkpoint)
+{
+  this->dataPtr->Lane().Checkpoints().push_back(_checkpoint);
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnStop(const int /*_segmentId*/, const int /*_laneId*/,
+  const int _waypointId)
+{
+  this->dataPtr->Lane().Stops().push_back(_waypointId);
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnExit(const Exit &_exit, const int _lineNumber,
+  const StringView &_line)
+{
+  // Perimeter exits have a 0 lane Id.
+  if (_exit.ExitId().Y() == 0)
+  {
+    assert(!this->dataPtr->zones.empty());
+    this->dataPtr->zones.back().Perimeter().AddExit(_exit);
+  }
+  else
+    this->dataPtr->Lane().Exits().push_back(_exit);
+
+  this->dataPtr->exitCache.push_back({_exit.ExitId().String(),
+    _exit.EntryId().String(), _lineNumber, _line.String(),
+    _exit.ExitId().Key(), _exit.EntryId().Key()});
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnWaypoint(const int _x, const int _y,
+  const Waypoint &_waypoint)
+{
+  if (!this->dataPtr->inZone)
+  {
+    this->dataPtr->waypointCache.push_back(
+      waypointKey(_x, _y, _waypoint.Id()));
+    this->dataPtr->Lane().Waypoints().push_back(_waypoint);
+    return;
+  }
+
+  assert(!this->dataPtr->zones.empty());
+  rndf::Zone &zone = this->dataPtr->zones.back();
+  if (_y == 0)
+  {
+    this->dataPtr->waypointCache.push_back(
+      waypointKey(_x, _y, _waypoint.Id()));
+    zone.Perimeter().Points().push_back(_waypoint);
+  }
+  else
+  {
+    // Parking spot waypoints aren't valid exit or entry points.
+    assert(!zone.Spots().empty());
+    zone.Spots().back().Waypoints().push_back(_waypoint);
+  }
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnZone(const int _zoneId, const int _numSpots,
+  const std::string &_name)
+{
+  this->dataPtr->zones.emplace_back(_zoneId);
+  rndf::Zone &zone = this->dataPtr->zones.back();
+  zone.SetName(_name);
+  zone.Spots().reserve(_numSpots);
+  this->dataPtr->inZone = true;
+}
+
+//////////////////////////////////////////////////
+void RNDFBuilder::OnSpot(const int /*_zoneId*/, const int _spotId,
+  const double _width, const Checkpoint &_checkpoint)
+{
+  assert(!this->dataPtr->zones.empty());
+  this->dataPtr->zones.back().Spots().emplace_back(_spotId);
+  rndf::ParkingSpot &spot = this->dataPtr->zones.back().Spots().back();
+  spot.SetWidth(_width);
+  spot.Checkpoint() = _checkpoint;
+}
@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFCache.hh"
+#include "ignition/rndf/RNDFImage.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/StringView.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Append a string to the text section of an image.
+    /// \param[in] _str The string.
+    /// \param[in, out] _text The text section.
+    /// \return The reference to the string.
+    static ImageString imageString(const std::string &_str, std::string &_text)
+    {
+      ImageString result = {static_cast<uint32_t>(_text.size()),
+                            static_cast<uint32_t>(_str.size())};
+      _text += _str;
+      return result;
+    }
+
+    /// \internal
+    /// \brief Append a list of waypoints to an image.
+    /// \param[in] _waypoints The waypoints.
+    /// \param[in] _x X of the unique Id of the waypoints.
+    /// \param[in] _y Y of the unique Id of the waypoints.
+    /// \param[in] _kind Kind of element the waypoints belong to.
+    /// \param[in] _parent Index of the segment or zone of the waypoints.
+    /// \param[in] _owner Index of the lane, zone or spot of the waypoints.
+    /// \param[in, out] _records The waypoints of the image.
+    /// \param[in, out] _nodes The nodes of the image.
+    static void imageWaypoints(const std::vector<Waypoint> &_waypoints,
+      const int _x, const int _y, const ImageNodeKind _kind,
+      const uint32_t _parent, const uint32_t _owner,
+      std::vector<ImageWaypoint> &_records, std::vector<ImageNode> &_nodes)
+    {
+      for (auto const &wp : _waypoints)
+      {
+        ImageWaypoint w = {wp.Latitude(), wp.Longitude(), wp.Id(),
+          (wp.IsEntry() ? kImageEntry : 0u) | (wp.IsExit() ? kImageExit : 0u)};
+        ImageNode n = {waypointKey(_x, _y, wp.Id()),
+          static_cast<uint32_t>(_records.size()), _kind, _parent, _owner};
+        _records.push_back(w);
+        _nodes.push_back(n);
+      }
+    }
+
+    /// \internal
+    /// \brief Append a list of exits to an image.
+    /// \param[in] _exits The exits.
+    /// \param[in, out] _records The exits of the image.
+    static void imageExits(const std::vector<Exit> &_exits,
+      std::vector<ImageExit> &_records)
+    {
+      for (auto const &exit : _exits)
+      {
+        ImageExit e = {
+          {exit.ExitId().X(), exit.ExitId().Y(), exit.ExitId().Z()},
+          {exit.EntryId().X(), exit.EntryId().Y(), exit.EntryId().Z()}};
+        _records.push_back(e);
+      }
+    }
+
+    /// \internal
+    /// \brief Append a table to an image file, padded to 8 bytes.
+    /// \param[in] _records The records of the table.
+    /// \param[in, out] _file The image file.
+    template<typename T>
+    static void writeTable(const std::vector<T> &_records, std::ofstream &_file)
+    {
+      const size_t bytes = _records.size() * sizeof(T);
+      if (bytes > 0)
+      {
+        _file.write(reinterpret_cast<const char *>(_records.data()),
+          static_cast<std::streamsize>(bytes));
+      }
+
+      const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+      _file.write(padding, static_cast<std::streamsize>(
+        imageTableSize(_records.size(), sizeof(T)) - bytes));
+    }
+
+    /// \internal
+    /// \brief Copy a range of waypoints of an image.
+    /// \param[in] _image The image.
+    /// \param[in] _first Index of the first waypoint.
+    /// \param[in] _count Number of waypoints.
+    /// \param[out] _result The waypoints.
+    static void copyWaypoints(const RNDFImage &_image, const uint32_t _first,
+      const uint32_t _count, std::vector<Waypoint> &_result)
+    {
+      _result.reserve(_count);
+      for (uint32_t i = _first; i < _first + _count; ++i)
+      {
+        const ImageWaypoint &w = _image.waypoints[i];
+        _result.emplace_back(w.id, w.latitude, w.longitude);
+        _result.back().SetEntry((w.flags & kImageEntry) != 0);
+        _result.back().SetExit((w.flags & kImageExit) != 0);
+      }
+    }
+
+    /// \internal
+    /// \brief Copy a range of exits of an image.
+    /// \param[in] _image The image.
+    /// \param[in] _first Index of the first exit.
+    /// \param[in] _count Number of exits.
+    /// \param[out] _result The exits.
+    static void copyExits(const RNDFImage &_image, const uint32_t _first,
+      const uint32_t _count, std::vector<Exit> &_result)
+    {
+      _result.reserve(_count);
+      for (uint32_t i = _first; i < _first + _count; ++i)
+      {
+        const ImageExit &e = _image.exits[i];
+        _result.emplace_back(UniqueId(e.exit[0], e.exit[1], e.exit[2]),
+          UniqueId(e.entry[0], e.entry[1], e.entry[2]));
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+uint64_t RNDFCache::Hash(const StringView &_content)
+{
+  const uint64_t kMultiplier = 0x9E3779B97F4A7C15ull;
+  const char *data = _content.Data();
+  const size_t size = _content.Size();
+
+  // Mix eight bytes at a time.
+  uint64_t hash = 0xCBF29CE484222325ull ^ (size * kMultiplier);
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+  {
+    uint64_t word;
+    std::memcpy(&word, data + i, sizeof(word));
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 29;
+  }
+
+  for (; i < size; ++i)
+  {
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * kMultiplier;
+    hash ^= hash >> 29;
+  }
+
+  hash ^= hash >> 32;
+  return hash * kMultiplier;
+}
+
+//////////////////////////////////////////////////
+bool RNDFCache::Write(const std::string &_cachePath,
+  const uint64_t _sourceHash, const RNDF &_rndf)
+{
+  std::string text;
+  std::vector<ImageSegment> segments;
+  std::vector<ImageLane> lanes;
+  std::vector<ImageWaypoint> waypoints;
+  std::vector<ImageExit> exits;
+  std::vector<ImageCheckpoint> checkpoints;
+  std::vector<int32_t> stops;
+  std::vector<ImageZone> zones;
+  std::vector<ImageSpot> spots;
+  std::vector<ImageNode> nodes;
+
+  ImageHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, kImageMagic, sizeof(header.magic));
+  header.version = kImageVersion;
+  header.byteOrder = kImageByteOrder;
+  header.sourceHash = _sourceHash;
+  header.name = imageString(_rndf.Name(), text);
+  header.formatVersion = imageString(_rndf.Version(), text);
+  header.date = imageString(_rndf.Date(), text);
+
+  for (auto const &segment : _rndf.Segments())
+  {
+    const uint32_t segmentIndex = static_cast<uint32_t>(segments.size());
+    ImageSegment s = {segment.Id(), static_cast<uint32_t>(lanes.size()),
+      static_cast<uint32_t>(segment.Lanes().size()), 0u,
+      imageString(segment.Name(), text)};
+    segments.push_back(s);
+
+    for (auto const &lane : segment.Lanes())
+    {
+      const uint32_t laneIndex = static_cast<uint32_t>(lanes.size());
+      ImageLane l = {lane.Id(),
+        static_cast<uint32_t>(waypoints.size()),
+        static_cast<uint32_t>(lane.Waypoints().size()),
+        static_cast<uint32_t>(exits.size()),
+        static_cast<uint32_t>(lane.Exits().size()),
+        static_cast<uint32_t>(checkpoints.size()),
+        static_cast<uint32_t>(lane.Checkpoints().size()),
+        static_cast<uint32_t>(stops.size()),
+        static_cast<uint32_t>(lane.Stops().size()),
+        static_cast<int32_t>(lane.LeftBoundary()),
+        static_cast<int32_t>(lane.RightBoundary()),
+        0u, lane.Width()};
+      lanes.push_back(l);
+
+      imageWaypoints(lane.Waypoints(), segment.Id(), lane.Id(),
+        ImageNodeKind::LANE, segmentIndex, laneIndex, waypoints, nodes);
+      imageExits(lane.Exits(), exits);
+      for (auto const &cp : lane.Checkpoints())
+        checkpoints.push_back({cp.CheckpointId(), cp.WaypointId()});
+      for (auto const &stop : lane.Stops())
+        stops.push_back(stop);
+    }
+  }
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    const uint32_t zoneIndex = static_cast<uint32_t>(zones.size());
+    const Perimeter &perimeter = zone.Perimeter();
+    ImageZone z = {zone.Id(),
+      static_cast<uint32_t>(spots.size()),
+      static_cast<uint32_t>(zone.Spots().size()),
+      static_cast<uint32_t>(waypoints.size()),
+      static_cast<uint32_t>(perimeter.Points().size()),
+      static_cast<uint32_t>(exits.size()),
+      static_cast<uint32_t>(perimeter.Exits().size()),
+      0u, imageString(zone.Name(), text)};
+    zones.push_back(z);
+
+    imageWaypoints(perimeter.Points(), zone.Id(), 0, ImageNodeKind::PERIMETER,
+      zoneIndex, zoneIndex, waypoints, nodes);
+    imageExits(perimeter.Exits(), exits);
+
+    for (auto const &spot : zone.Spots())
+    {
+      const uint32_t spotIndex = static_cast<uint32_t>(spots.size());
+      ImageSpot s = {spot.Id(),
+        static_cast<uint32_t>(waypoints.size()),
+        static_cast<uint32_t>(spot.Waypoints().size()), 0u,
+        {spot.Checkpoint().CheckpointId(), spot.Checkpoint().WaypointId()},
+        spot.Width()};
+      spots.push_back(s);
+
+      imageWaypoints(spot.Waypoints(), zone.Id(), spot.Id(),
+        ImageNodeKind::SPOT, zoneIndex, spotIndex, waypoints, nodes);
+    }
+  }
+
+  std::stable_sort(nodes.begin(), nodes.end(),
+    [](const ImageNode &_a, const ImageNode &_b)
+    {
+      return _a.key < _b.key;
+    });
+
+  header.numSegments = static_cast<uint32_t>(segments.size());
+  header.numLanes = static_cast<uint32_t>(lanes.size());
+  header.numWaypoints = static_cast<uint32_t>(waypoints.size());
+  header.numExits = static_cast<uint32_t>(exits.size());
+  header.numCheckpoints = static_cast<uint32_t>(checkpoints.size());
+  header.numStops = static_cast<uint32_t>(stops.size());
+  header.numZones = static_cast<uint32_t>(zones.size());
+  header.numSpots = static_cast<uint32_t>(spots.size());
+  header.textSize = static_cast<uint32_t>(text.size());
+
+  // Write under a temporary name, so the cache is replaced atomically.
+  const std::string tmpPath = _cachePath + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+      return false;
+
+    writeTable(std::vector<ImageHeader>(1, header), file);
+    writeTable(segments, file);
+    writeTable(lanes, file);
+    writeTable(waypoints, file);
+    writeTable(exits, file);
+    writeTable(checkpoints, file);
+    writeTable(stops, file);
+    writeTable(zones, file);
+    writeTable(spots, file);
+    writeTable(nodes, file);
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (!file.good())
+    {
+      file.close();
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tmpPath.c_str(), _cachePath.c_str()) != 0)
+  {
+    // Some platforms don't replace existing files when renaming.
+    std::remove(_cachePath.c_str());
+    if (std::rename(tmpPath.c_str(), _cachePath.c_str()) != 0)
+    {
+      std::remove(tmpPath.c_str());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RNDFCache::Read(const std::string &_cachePath,
+  const uint64_t _sourceHash, std::string &_name, std::string &_version,
+  std::string &_date, std::vector<Segment> &_segments,
+  std::vector<Zone> &_zones)
+{
+  LineReader reader;
+  StringView content;
+  RNDFImage image;
+  if (!reader.Open(_cachePath) || !reader.Remaining(content) ||
+      !image.Map(content) || image.header->sourceHash != _sourceHash)
+  {
+    return false;
+  }
+
+  const ImageHeader &header = *image.header;
+  std::vector<Segment> segments;
+  segments.reserve(header.numSegments);
+  for (uint32_t i = 0; i < header.numSegments; ++i)
+  {
+    const ImageSegment &s = image.segments[i];
+    segments.emplace_back(s.id);
+    Segment &segment = segments.back();
+    segment.SetName(image.String(s.name).String());
+    segment.Lanes().reserve(s.numLanes);
+    for (uint32_t j = s.firstLane; j < s.firstLane + s.numLanes; ++j)
+    {
+      const ImageLane &l = image.lanes[j];
+      segment.Lanes().emplace_back(l.id);
+      Lane &lane = segment.Lanes().back();
+      lane.SetWidth(l.width);
+      lane.SetLeftBoundary(static_cast<Marking>(l.leftBoundary));
+      lane.SetRightBoundary(static_cast<Marking>(l.rightBoundary));
+      copyWaypoints(image, l.firstWaypoint, l.numWaypoints, lane.Waypoints());
+      copyExits(image, l.firstExit, l.numExits, lane.Exits());
+
+      for (uint32_t k = l.firstCheckpoint;
+           k < l.firstCheckpoint + l.numCheckpoints; ++k)
+      {
+        lane.Checkpoints().emplace_back(image.checkpoints[k].checkpointId,
+          image.checkpoints[k].waypointId);
+      }
+      lane.Stops().assign(image.stops + l.firstStop,
+        image.stops + l.firstStop + l.numStops);
+    }
+  }
+
+  std::vector<Zone> zones;
+  zones.reserve(header.numZones);
+  for (uint32_t i = 0; i < header.numZones; ++i)
+  {
+    const ImageZone &z = image.zones[i];
+    zones.emplace_back(z.id);
+    Zone &zone = zones.back();
+    zone.SetName(image.String(z.name).String());
+    copyWaypoints(image, z.firstPoint, z.numPoints,
+      zone.Perimeter().Points());
+    copyExits(image, z.firstExit, z.numExits, zone.Perimeter().Exits());
+
+    zone.Spots().reserve(z.numSpots);
+    for (uint32_t j = z.firstSpot; j < z.firstSpot + z.numSpots; ++j)
+    {
+      const ImageSpot &s = image.spots[j];
+      zone.Spots().emplace_back(s.id);
+      ParkingSpot &spot = zone.Spots().back();
+      spot.SetWidth(s.width);
+      spot.Checkpoint() = Checkpoint(s.checkpoint.checkpointId,
+        s.checkpoint.waypointId);
+      copyWaypoints(image, s.firstWaypoint, s.numWaypoints, spot.Waypoints());
+    }
+  }
+
+  _name = image.String(header.name).String();
+  _version = image.String(header.formatVersion).String();
+  _date = image.String(header.date).String();
+  _segments = std::move(segments);
+  _zones = std::move(zones);
+  return true;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFCache.hh"
+#include "ignition/rndf/RNDFNode.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/StringView.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+#include "test/RNDFTestUtils.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Read a whole file.
+/// \param[in] _filePath Path to the file.
+/// \return The content of the file.
+std::string readFile(const std::string &_filePath)
+{
+  std::ifstream file(_filePath, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+    std::istreambuf_iterator<char>());
+}
+
+/// \brief Write a whole file.
+/// \param[in] _filePath Path to the file.
+/// \param[in] _content The content of the file.
+void writeFile(const std::string &_filePath, const std::string &_content)
+{
+  std::ofstream file(_filePath, std::ios::binary | std::ios::trunc);
+  file << _content;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the hash function.
+TEST(RNDFCache, Hash)
+{
+  const std::string text = "RNDF_name\tsample\nnum_segments\t1\n";
+  EXPECT_EQ(RNDFCache::Hash(StringView(text)),
+            RNDFCache::Hash(StringView(text)));
+
+  // Any change of the content or its length changes the hash.
+  std::string other = text;
+  other[text.size() - 2] = '2';
+  EXPECT_NE(RNDFCache::Hash(StringView(text)),
+            RNDFCache::Hash(StringView(other)));
+  EXPECT_NE(RNDFCache::Hash(StringView(text)),
+            RNDFCache::Hash(StringView(text + " ")));
+  EXPECT_NE(RNDFCache::Hash(StringView("")),
+            RNDFCache::Hash(StringView(std::string(1, '\0'))));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that loading a RNDF from its cache produces the same
+/// result as parsing it.
+TEST(RNDFCache, RoundTrip)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  const std::string cachePath =
+    std::string(PROJECT_BINARY_PATH) + "/RNDFCache_TEST.cache";
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    const std::string filePath = dirPath + "/test/rndf/" + sample;
+    std::remove(cachePath.c_str());
+
+    RNDF parsed;
+    ASSERT_TRUE(parsed.Load(filePath));
+
+    // The first load parses the text and writes the cache.
+    RNDF first;
+    ASSERT_TRUE(first.Load(filePath, cachePath));
+    EXPECT_FALSE(readFile(cachePath).empty());
+    testing::expectEqualRNDF(parsed, first);
+
+    // The second load reads the cache.
+    RNDF cached;
+    ASSERT_TRUE(cached.Load(filePath, cachePath));
+    EXPECT_TRUE(cached.Valid());
+    testing::expectEqualRNDF(parsed, cached);
+
+    // The waypoints are indexed.
+    const Segment &segment = cached.Segments().front();
+    const Lane &lane = segment.Lanes().front();
+    const UniqueId id(segment.Id(), lane.Id(), lane.Waypoints().front().Id());
+    const RNDFNode *node = cached.Info(id);
+    ASSERT_TRUE(node != nullptr);
+    ASSERT_TRUE(node->Waypoint() != nullptr);
+    EXPECT_EQ(node->Waypoint()->Id(), id.Z());
+  }
+
+  std::remove(cachePath.c_str());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check when a cache is used and when it's rewritten.
+TEST(RNDFCache, Invalidation)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  const std::string text = readFile(dirPath + "/test/rndf/sample1.rndf");
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/RNDFCache_TEST.rndf";
+  const std::string cachePath = filePath + ".cache";
+  writeFile(filePath, text);
+  std::remove(cachePath.c_str());
+
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath, cachePath));
+  const std::string name = rndf.Name();
+  std::string cache = readFile(cachePath);
+  ASSERT_FALSE(cache.empty());
+
+  // Alter the name stored in the cache. The cache is used, so the altered
+  // name is loaded.
+  const size_t pos = cache.rfind(name);
+  ASSERT_NE(pos, std::string::npos);
+  cache[pos] = cache[pos] == 'x' ? 'y' : 'x';
+  writeFile(cachePath, cache);
+  {
+    RNDF cached;
+    ASSERT_TRUE(cached.Load(filePath, cachePath));
+    EXPECT_NE(cached.Name(), name);
+    EXPECT_EQ(cached.Name().substr(1), name.substr(1));
+  }
+
+  // A cache created from a different text is ignored and rewritten.
+  writeFile(filePath, text + "\n");
+  {
+    RNDF reparsed;
+    ASSERT_TRUE(reparsed.Load(filePath, cachePath));
+    EXPECT_EQ(reparsed.Name(), name);
+    EXPECT_NE(readFile(cachePath), cache);
+  }
+
+  // Truncated and empty caches are ignored.
+  cache = readFile(cachePath);
+  for (auto size : {cache.size() - 1, cache.size() / 2, size_t(10), size_t(0)})
+  {
+    writeFile(cachePath, cache.substr(0, size));
+    RNDF truncated;
+    ASSERT_TRUE(truncated.Load(filePath, cachePath));
+    EXPECT_EQ(truncated.Name(), name);
+    EXPECT_EQ(readFile(cachePath), cache);
+  }
+
+  // Errors in the text are still reported.
+  writeFile(filePath, "RNDF_name\tbroken\n");
+  {
+    RNDF broken;
+    EXPECT_FALSE(broken.Load(filePath, cachePath));
+  }
+
+  // An unwritable cache doesn't prevent loading.
+  writeFile(filePath, text);
+  {
+    RNDF uncached;
+    EXPECT_TRUE(uncached.Load(filePath, dirPath + "/nonexistent/dir/cache"));
+    EXPECT_EQ(uncached.Name(), name);
+  }
+
+  std::remove(filePath.c_str());
+  std::remove(cachePath.c_str());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include "ignition/rndf/RNDFImage.hh"
+#include "ignition/rndf/StringView.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Check that a range of records is within its table.
+    /// \param[in] _first Index of the first record.
+    /// \param[in] _count Number of records.
+    /// \param[in] _size Number of records in the table.
+    /// \return True if the range is within the table.
+    static bool imageRange(const uint32_t _first, const uint32_t _count,
+      const uint32_t _size)
+    {
+      return _first <= _size && _size - _first >= _count;
+    }
+
+    /// \internal
+    /// \brief Point a table to the content of an image.
+    /// \param[in] _content The image.
+    /// \param[in] _count Number of records of the table.
+    /// \param[in, out] _offset Offset of the table in _content. It's moved
+    /// after the table.
+    /// \param[out] _table The table.
+    /// \return False if _content is too small.
+    template<typename T>
+    static bool imageTable(const StringView &_content, const uint32_t _count,
+      size_t &_offset, const T *&_table)
+    {
+      const size_t bytes = imageTableSize(_count, sizeof(T));
+      if (_content.Size() - _offset < bytes)
+        return false;
+
+      _table = reinterpret_cast<const T *>(_content.Data() + _offset);
+      _offset += bytes;
+      return true;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool RNDFImage::Map(const StringView &_content)
+{
+  this->header = nullptr;
+
+  if (_content.Size() < sizeof(ImageHeader) ||
+      reinterpret_cast<uintptr_t>(_content.Data()) % 8 != 0)
+  {
+    return false;
+  }
+
+  const ImageHeader *h =
+    reinterpret_cast<const ImageHeader *>(_content.Data());
+  if (std::memcmp(h->magic, kImageMagic, sizeof(h->magic)) != 0 ||
+      h->version != kImageVersion                                ||
+      h->byteOrder != kImageByteOrder)
+  {
+    return false;
+  }
+
+  size_t offset = imageTableSize(1, sizeof(ImageHeader));
+  if (!imageTable(_content, h->numSegments, offset, this->segments)       ||
+      !imageTable(_content, h->numLanes, offset, this->lanes)             ||
+      !imageTable(_content, h->numWaypoints, offset, this->waypoints)     ||
+      !imageTable(_content, h->numExits, offset, this->exits)             ||
+      !imageTable(_content, h->numCheckpoints, offset, this->checkpoints) ||
+      !imageTable(_content, h->numStops, offset, this->stops)             ||
+      !imageTable(_content, h->numZones, offset, this->zones)             ||
+      !imageTable(_content, h->numSpots, offset, this->spots)             ||
+      !imageTable(_content, h->numWaypoints, offset, this->nodes)         ||
+      _content.Size() - offset != h->textSize)
+  {
+    return false;
+  }
+  this->text = _content.Data() + offset;
+
+  auto validString = [h](const ImageString &_str)
+  {
+    return imageRange(_str.offset, _str.size, h->textSize);
+  };
+
+  if (!validString(h->name) || !validString(h->formatVersion) ||
+      !validString(h->date))
+  {
+    return false;
+  }
+
+  for (uint32_t i = 0; i < h->numSegments; ++i)
+  {
+    const ImageSegment &s = this->segments[i];
+    if (!imageRange(s.firstLane, s.numLanes, h->numLanes) ||
+        !validString(s.name))
+    {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i < h->numLanes; ++i)
+  {
+    const ImageLane &l = this->lanes[i];
+    if (!imageRange(l.firstWaypoint, l.numWaypoints, h->numWaypoints)      ||
+        !imageRange(l.firstExit, l.numExits, h->numExits)                  ||
+        !imageRange(l.firstCheckpoint, l.numCheckpoints, h->numCheckpoints) ||
+        !imageRange(l.firstStop, l.numStops, h->numStops))
+    {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i < h->numZones; ++i)
+  {
+    const ImageZone &z = this->zones[i];
+    if (!imageRange(z.firstSpot, z.numSpots, h->numSpots)       ||
+        !imageRange(z.firstPoint, z.numPoints, h->numWaypoints) ||
+        !imageRange(z.firstExit, z.numExits, h->numExits)       ||
+        !validString(z.name))
+    {
+      return false;
+    }
+  }
+
+  for (uint32_t i = 0; i < h->numSpots; ++i)
+  {
+    const ImageSpot &s = this->spots[i];
+    if (!imageRange(s.firstWaypoint, s.numWaypoints, h->numWaypoints))
+      return false;
+  }
+
+  this->header = h;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RNDFImage::ValidNode(const ImageNode &_node) const
+{
+  if (_node.waypoint >= this->header->numWaypoints)
+    return false;
+
+  switch (_node.kind)
+  {
+    case ImageNodeKind::LANE:
+      return _node.parent < this->header->numSegments &&
+             _node.owner < this->header->numLanes;
+    case ImageNodeKind::PERIMETER:
+      return _node.parent < this->header->numZones &&
+             _node.owner == _node.parent;
+    case ImageNodeKind::SPOT:
+      return _node.parent < this->header->numZones &&
+             _node.owner < this->header->numSpots;
+    default:
+      return false;
+  }
+}
+
+//////////////////////////////////////////////////
+StringView RNDFImage::String(const ImageString &_str) const
+{
+  return StringView(this->text + _str.offset, _str.size);
+}
@@ -15,7 +15,13 @@
  *
 */
 
+#include <atomic>
+#include <vector>
+
+#include "ignition/rndf/Arena.hh"
 #include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
 #include "ignition/rndf/RNDFNode.hh"
 #include "ignition/rndf/Segment.hh"
 #include "ignition/rndf/UniqueId.hh"
@@ -31,7 +37,7 @@ namespace ignition
   {
     /// \internal
     /// \brief Private data for RNDFNode class.
-    class RNDFNodePrivate
+    class RNDFNodePrivate : public ArenaObject
     {
       /// \brief Constructor.
       public: explicit RNDFNodePrivate(const rndf::UniqueId &_id)
@@ -42,6 +48,125 @@ namespace ignition
       /// \brief Destructor.
       public: virtual ~RNDFNodePrivate() = default;
 
+      /// \brief Assignment operator.
+      /// \param[in] _other The data to copy.
+      /// \return A reference to this instance.
+      public: RNDFNodePrivate &operator=(const RNDFNodePrivate &_other)
+      {
+        this->segment = _other.segment;
+        this->lane = _other.lane;
+        this->zone = _other.zone;
+        this->waypoint = _other.waypoint;
+        this->uniqueId = _other.uniqueId;
+        this->segments = _other.segments;
+        this->zones = _other.zones;
+        this->parentHint.store(_other.parentHint.load(
+          std::memory_order_relaxed), std::memory_order_relaxed);
+        this->childHint.store(_other.childHint.load(
+          std::memory_order_relaxed), std::memory_order_relaxed);
+        this->waypointHint.store(_other.waypointHint.load(
+          std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+      }
+
+      /// \brief Find an element by Id, first at a hint position, then at
+      /// the previous one (the element before it was removed) and then
+      /// anywhere. The hint is updated with the position found. The const
+      /// accessors of a shared node resolve it from several threads, so the
+      /// hint is atomic. It's only a guess, checked before being used, so
+      /// relaxed ordering is enough.
+      /// \param[in] _items The elements.
+      /// \param[in] _id The Id.
+      /// \param[in, out] _hint The hint position.
+      /// \return Pointer to the element, or nullptr if not found.
+      public: template<typename T>
+      static T *Find(std::vector<T> &_items, const int _id,
+                     std::atomic<size_t> &_hint)
+      {
+        const size_t hint = _hint.load(std::memory_order_relaxed);
+        if (hint < _items.size() && _items[hint].Id() == _id)
+          return &_items[hint];
+        if (hint > 0 && hint <= _items.size() &&
+            _items[hint - 1].Id() == _id)
+        {
+          _hint.store(hint - 1, std::memory_order_relaxed);
+          return &_items[hint - 1];
+        }
+        for (size_t i = 0; i < _items.size(); ++i)
+        {
+          if (_items[i].Id() == _id)
+          {
+            _hint.store(i, std::memory_order_relaxed);
+            return &_items[i];
+          }
+        }
+        return nullptr;
+      }
+
+      /// \brief Resolve the segment of a handle.
+      /// \return The segment or nullptr.
+      public: rndf::Segment *ResolveSegment()
+      {
+        if (!this->segments)
+          return nullptr;
+        return Find(*this->segments, this->uniqueId.X(), this->parentHint);
+      }
+
+      /// \brief Resolve the lane of a handle.
+      /// \return The lane or nullptr.
+      public: rndf::Lane *ResolveLane()
+      {
+        rndf::Segment *seg = this->ResolveSegment();
+        if (!seg)
+          return nullptr;
+        return Find(seg->Lanes(), this->uniqueId.Y(), this->childHint);
+      }
+
+      /// \brief Resolve the zone of a handle.
+      /// \return The zone or nullptr.
+      public: rndf::Zone *ResolveZone()
+      {
+        if (!this->zones)
+          return nullptr;
+        return Find(*this->zones, this->uniqueId.X(), this->parentHint);
+      }
+
+      /// \brief Resolve the waypoint of a handle.
+      /// \return The waypoint or nullptr.
+      public: rndf::Waypoint *ResolveWaypoint()
+      {
+        std::vector<rndf::Waypoint> *points = nullptr;
+        if (this->segments)
+        {
+          rndf::Lane *ln = this->ResolveLane();
+          if (ln)
+            points = &ln->Waypoints();
+        }
+        else
+        {
+          rndf::Zone *zn = this->ResolveZone();
+          if (zn && this->uniqueId.Y() == 0)
+            points = &zn->Perimeter().Points();
+          else if (zn)
+          {
+            rndf::ParkingSpot *spot =
+              Find(zn->Spots(), this->uniqueId.Y(), this->childHint);
+            if (spot)
+              points = &spot->Waypoints();
+          }
+        }
+        if (!points)
+          return nullptr;
+        return Find(*points, this->uniqueId.Z(), this->waypointHint);
+      }
+
+      /// \brief Discard the handle.
+      public: void ClearHandle()
+      {
+        this->segments = nullptr;
+        this->zones = nullptr;
+      }
+
       /// \brief The segment containing the waypoint.
       public: Segment *segment = nullptr;
 
@@ -56,6 +181,21 @@ namespace ignition
 
       /// \brief The unique Id.
       public: UniqueId uniqueId;
+
+      /// \brief Segments of the handle, or nullptr.
+      public: std::vector<rndf::Segment> *segments = nullptr;
+
+      /// \brief Zones of the handle, or nullptr.
+      public: std::vector<rndf::Zone> *zones = nullptr;
+
+      /// \brief Last known position of the segment or zone.
+      public: std::atomic<size_t> parentHint{0};
+
+      /// \brief Last known position of the lane or parking spot.
+      public: std::atomic<size_t> childHint{0};
+
+      /// \brief Last known position of the waypoint.
+      public: std::atomic<size_t> waypointHint{0};
     };
   }
 }
@@ -93,24 +233,38 @@ UniqueId &RNDFNode::UniqueId() const
 //////////////////////////////////////////////////
 Segment *RNDFNode::Segment() const
 {
+  if (this->dataPtr->segments)
+    return this->dataPtr->ResolveSegment();
+  if (this->dataPtr->zones)
+    return nullptr;
   return this->dataPtr->segment;
 }
 
 //////////////////////////////////////////////////
 Lane *RNDFNode::Lane() const
 {
+  if (this->dataPtr->segments)
+    return this->dataPtr->ResolveLane();
+  if (this->dataPtr->zones)
+    return nullptr;
   return this->dataPtr->lane;
 }
 
 //////////////////////////////////////////////////
 Zone *RNDFNode::Zone() const
 {
+  if (this->dataPtr->zones)
+    return this->dataPtr->ResolveZone();
+  if (this->dataPtr->segments)
+    return nullptr;
   return this->dataPtr->zone;
 }
 
 //////////////////////////////////////////////////
 Waypoint *RNDFNode::Waypoint() const
 {
+  if (this->dataPtr->segments || this->dataPtr->zones)
+    return this->dataPtr->ResolveWaypoint();
   return this->dataPtr->waypoint;
 }
 
@@ -120,27 +274,61 @@ void RNDFNode::SetUniqueId(const rndf::UniqueId &_id)
   this->dataPtr->uniqueId = _id;
 }
 
+//////////////////////////////////////////////////
+void RNDFNode::SetHandle(std::vector<rndf::Segment> *_segments,
+    const size_t _segment, const size_t _lane, const size_t _waypoint)
+{
+  this->dataPtr->segment = nullptr;
+  this->dataPtr->lane = nullptr;
+  this->dataPtr->zone = nullptr;
+  this->dataPtr->waypoint = nullptr;
+  this->dataPtr->segments = _segments;
+  this->dataPtr->zones = nullptr;
+  this->dataPtr->parentHint = _segment;
+  this->dataPtr->childHint = _lane;
+  this->dataPtr->waypointHint = _waypoint;
+}
+
+//////////////////////////////////////////////////
+void RNDFNode::SetHandle(std::vector<rndf::Zone> *_zones,
+    const size_t _zone, const size_t _spot, const size_t _waypoint)
+{
+  this->dataPtr->segment = nullptr;
+  this->dataPtr->lane = nullptr;
+  this->dataPtr->zone = nullptr;
+  this->dataPtr->waypoint = nullptr;
+  this->dataPtr->segments = nullptr;
+  this->dataPtr->zones = _zones;
+  this->dataPtr->parentHint = _zone;
+  this->dataPtr->childHint = _spot;
+  this->dataPtr->waypointHint = _waypoint;
+}
+
 //////////////////////////////////////////////////
 void RNDFNode::SetSegment(rndf::Segment *_segment)
 {
+  this->dataPtr->ClearHandle();
   this->dataPtr->segment = _segment;
 }
 
 //////////////////////////////////////////////////
 void RNDFNode::SetLane(rndf::Lane *_lane)
 {
+  this->dataPtr->ClearHandle();
   this->dataPtr->lane = _lane;
 }
 
 //////////////////////////////////////////////////
 void RNDFNode::SetZone(rndf::Zone *_zone)
 {
+  this->dataPtr->ClearHandle();
   this->dataPtr->zone = _zone;
 }
 
 //////////////////////////////////////////////////
 void RNDFNode::SetWaypoint(rndf::Waypoint *_waypoint)
 {
+  this->dataPtr->ClearHandle();
   this->dataPtr->waypoint = _waypoint;
 }
 
@@ -159,10 +347,6 @@ bool RNDFNode::operator!=(const RNDFNode &_other) const
 //////////////////////////////////////////////////
 RNDFNode &RNDFNode::operator=(const RNDFNode &_other)
 {
-  this->SetUniqueId(_other.UniqueId());
-  this->SetSegment(_other.Segment());
-  this->SetLane(_other.Lane());
-  this->SetZone(_other.Zone());
-  this->SetWaypoint(_other.Waypoint());
+  *this->dataPtr = *_other.dataPtr;
   return *this;
 }
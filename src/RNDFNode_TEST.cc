@@ -17,10 +17,13 @@
 
 #include <iostream>
 #include <string>
+#include <thread>
+#include <vector>
 #include <ignition/math/SphericalCoordinates.hh>
 
 #include "gtest/gtest.h"
 #include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
 #include "ignition/rndf/RNDFNode.hh"
 #include "ignition/rndf/Segment.hh"
 #include "ignition/rndf/UniqueId.hh"
@@ -106,6 +109,74 @@ TEST(UniqueIdTest, operators)
   EXPECT_EQ(rndfNode, rndfNode3);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that nodes shared by several threads are resolved
+/// concurrently from their handles, while the threads update the hints.
+TEST(UniqueIdTest, concurrentHandles)
+{
+  const int kNumSegments = 8;
+  const int kNumLanes = 4;
+  const int kNumWaypoints = 8;
+  RNDF rndf;
+  for (int s = 1; s <= kNumSegments; ++s)
+  {
+    Segment segment(s);
+    for (int l = 1; l <= kNumLanes; ++l)
+    {
+      Lane lane(l);
+      for (int w = 1; w <= kNumWaypoints; ++w)
+        EXPECT_TRUE(lane.AddWaypoint(Waypoint(w, s + 0.5, w + 0.5)));
+      EXPECT_TRUE(segment.AddLane(lane));
+    }
+    EXPECT_TRUE(rndf.AddSegment(segment));
+  }
+
+  // Removing the first segment moves the others, so the hints of their
+  // nodes are wrong and the first resolutions search and update them.
+  EXPECT_TRUE(rndf.RemoveSegment(1));
+  std::vector<const RNDFNode *> constNodes;
+  for (int s = 2; s <= kNumSegments; ++s)
+  {
+    for (int l = 1; l <= kNumLanes; ++l)
+    {
+      for (int w = 1; w <= kNumWaypoints; ++w)
+      {
+        constNodes.push_back(rndf.Info(UniqueId(s, l, w)));
+        ASSERT_TRUE(constNodes.back() != nullptr);
+      }
+    }
+  }
+
+  const int kNumThreads = 4;
+  std::vector<int> found(kNumThreads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t)
+  {
+    threads.emplace_back([&constNodes, &found, t]()
+    {
+      for (int round = 0; round < 10; ++round)
+      {
+        for (auto const node : constNodes)
+        {
+          const Waypoint *wp = node->Waypoint();
+          const Lane *ln = node->Lane();
+          if (wp && ln && wp->Id() == node->UniqueId().Z() &&
+              ln->Id() == node->UniqueId().Y() &&
+              node->Segment()->Id() == node->UniqueId().X())
+          {
+            ++found[t];
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto const count : found)
+    EXPECT_EQ(count, 10 * static_cast<int>(constNodes.size()));
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
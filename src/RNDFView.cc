@@ -0,0 +1,769 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFCache.hh"
+#include "ignition/rndf/RNDFImage.hh"
+#include "ignition/rndf/RNDFView.hh"
+#include "ignition/rndf/StringView.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for RNDFView class.
+    class RNDFViewPrivate
+    {
+      /// \brief Map an image.
+      /// \param[in] _imagePath Path to the image.
+      /// \return True if the image was mapped and it's valid.
+      public: bool Map(const std::string &_imagePath)
+      {
+        this->Unmap();
+
+        std::unique_ptr<LineReader> newReader(new LineReader());
+        StringView content;
+        if (!newReader->Open(_imagePath) ||
+            !newReader->Remaining(content) ||
+            !this->image.Map(content))
+        {
+          return false;
+        }
+
+        this->reader = std::move(newReader);
+        return true;
+      }
+
+      /// \brief Unmap the current image, if any.
+      public: void Unmap()
+      {
+        this->image = RNDFImage();
+        this->reader.reset();
+      }
+
+      /// \brief The reader that keeps the image mapped.
+      public: std::unique_ptr<LineReader> reader;
+
+      /// \brief The tables of the image.
+      public: RNDFImage image;
+    };
+
+    /// \internal
+    /// \brief Create a waypoint from a record of an image.
+    /// \param[in] _w The record.
+    /// \return The waypoint.
+    static rndf::Waypoint viewWaypoint(const ImageWaypoint &_w)
+    {
+      rndf::Waypoint wp(_w.id, _w.latitude, _w.longitude);
+      wp.SetEntry((_w.flags & kImageEntry) != 0);
+      wp.SetExit((_w.flags & kImageExit) != 0);
+      return wp;
+    }
+
+    /// \internal
+    /// \brief Create an exit from a record of an image.
+    /// \param[in] _e The record.
+    /// \return The exit.
+    static rndf::Exit viewExit(const ImageExit &_e)
+    {
+      return rndf::Exit(UniqueId(_e.exit[0], _e.exit[1], _e.exit[2]),
+        UniqueId(_e.entry[0], _e.entry[1], _e.entry[2]));
+    }
+
+    /// \internal
+    /// \brief Find a waypoint by Id in a range of waypoints of an image.
+    /// \param[in] _image The image.
+    /// \param[in] _first Index of the first waypoint.
+    /// \param[in] _count Number of waypoints.
+    /// \param[in] _wpId The waypoint Id.
+    /// \param[out] _wp The waypoint requested.
+    /// \return True if the waypoint was found or false otherwise.
+    static bool viewFindWaypoint(const RNDFImage *_image, const uint32_t _first,
+      const uint32_t _count, const int _wpId, rndf::Waypoint &_wp)
+    {
+      const ImageWaypoint *begin = _image->waypoints + _first;
+      const ImageWaypoint *end = begin + _count;
+      const ImageWaypoint *it = std::find_if(begin, end,
+        [_wpId](const ImageWaypoint &_w)
+        {
+          return _w.id == _wpId;
+        });
+
+      if (it == end)
+        return false;
+
+      _wp = viewWaypoint(*it);
+      return true;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+LaneView::LaneView(const RNDFImage *_image, const uint32_t _index)
+  : image(_image),
+    index(_index)
+{
+}
+
+//////////////////////////////////////////////////
+int LaneView::Id() const
+{
+  return this->image ? this->image->lanes[this->index].id : -1;
+}
+
+//////////////////////////////////////////////////
+size_t LaneView::NumWaypoints() const
+{
+  return this->image ? this->image->lanes[this->index].numWaypoints : 0u;
+}
+
+//////////////////////////////////////////////////
+rndf::Waypoint LaneView::WaypointAt(const size_t _index) const
+{
+  if (_index >= this->NumWaypoints())
+    return rndf::Waypoint();
+
+  const ImageLane &l = this->image->lanes[this->index];
+  return viewWaypoint(this->image->waypoints[l.firstWaypoint + _index]);
+}
+
+//////////////////////////////////////////////////
+bool LaneView::Waypoint(const int _wpId, rndf::Waypoint &_wp) const
+{
+  if (!this->image)
+    return false;
+
+  const ImageLane &l = this->image->lanes[this->index];
+  return viewFindWaypoint(this->image, l.firstWaypoint, l.numWaypoints,
+    _wpId, _wp);
+}
+
+//////////////////////////////////////////////////
+double LaneView::Width() const
+{
+  return this->image ? this->image->lanes[this->index].width : 0.0;
+}
+
+//////////////////////////////////////////////////
+Marking LaneView::LeftBoundary() const
+{
+  if (!this->image)
+    return Marking::UNDEFINED;
+
+  return static_cast<Marking>(this->image->lanes[this->index].leftBoundary);
+}
+
+//////////////////////////////////////////////////
+Marking LaneView::RightBoundary() const
+{
+  if (!this->image)
+    return Marking::UNDEFINED;
+
+  return static_cast<Marking>(this->image->lanes[this->index].rightBoundary);
+}
+
+//////////////////////////////////////////////////
+size_t LaneView::NumCheckpoints() const
+{
+  return this->image ? this->image->lanes[this->index].numCheckpoints : 0u;
+}
+
+//////////////////////////////////////////////////
+rndf::Checkpoint LaneView::CheckpointAt(const size_t _index) const
+{
+  if (_index >= this->NumCheckpoints())
+    return rndf::Checkpoint();
+
+  const ImageLane &l = this->image->lanes[this->index];
+  const ImageCheckpoint &cp =
+    this->image->checkpoints[l.firstCheckpoint + _index];
+  return rndf::Checkpoint(cp.checkpointId, cp.waypointId);
+}
+
+//////////////////////////////////////////////////
+bool LaneView::Checkpoint(const int _cpId, rndf::Checkpoint &_cp) const
+{
+  if (!this->image)
+    return false;
+
+  const ImageLane &l = this->image->lanes[this->index];
+  const ImageCheckpoint *begin =
+    this->image->checkpoints + l.firstCheckpoint;
+  const ImageCheckpoint *end = begin + l.numCheckpoints;
+  const ImageCheckpoint *it = std::find_if(begin, end,
+    [_cpId](const ImageCheckpoint &_c)
+    {
+      return _c.checkpointId == _cpId;
+    });
+
+  if (it == end)
+    return false;
+
+  _cp = rndf::Checkpoint(it->checkpointId, it->waypointId);
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t LaneView::NumStops() const
+{
+  return this->image ? this->image->lanes[this->index].numStops : 0u;
+}
+
+//////////////////////////////////////////////////
+int LaneView::StopAt(const size_t _index) const
+{
+  if (_index >= this->NumStops())
+    return -1;
+
+  const ImageLane &l = this->image->lanes[this->index];
+  return this->image->stops[l.firstStop + _index];
+}
+
+//////////////////////////////////////////////////
+size_t LaneView::NumExits() const
+{
+  return this->image ? this->image->lanes[this->index].numExits : 0u;
+}
+
+//////////////////////////////////////////////////
+rndf::Exit LaneView::ExitAt(const size_t _index) const
+{
+  if (_index >= this->NumExits())
+    return rndf::Exit();
+
+  const ImageLane &l = this->image->lanes[this->index];
+  return viewExit(this->image->exits[l.firstExit + _index]);
+}
+
+//////////////////////////////////////////////////
+SegmentView::SegmentView(const RNDFImage *_image, const uint32_t _index)
+  : image(_image),
+    index(_index)
+{
+}
+
+//////////////////////////////////////////////////
+int SegmentView::Id() const
+{
+  return this->image ? this->image->segments[this->index].id : -1;
+}
+
+//////////////////////////////////////////////////
+std::string SegmentView::Name() const
+{
+  if (!this->image)
+    return "";
+
+  return this->image->String(this->image->segments[this->index].name)
+    .String();
+}
+
+//////////////////////////////////////////////////
+size_t SegmentView::NumLanes() const
+{
+  return this->image ? this->image->segments[this->index].numLanes : 0u;
+}
+
+//////////////////////////////////////////////////
+LaneView SegmentView::LaneAt(const size_t _index) const
+{
+  if (_index >= this->NumLanes())
+    return LaneView();
+
+  const ImageSegment &s = this->image->segments[this->index];
+  return LaneView(this->image,
+    s.firstLane + static_cast<uint32_t>(_index));
+}
+
+//////////////////////////////////////////////////
+bool SegmentView::Lane(const int _laneId, LaneView &_lane) const
+{
+  if (!this->image)
+    return false;
+
+  const ImageSegment &s = this->image->segments[this->index];
+  for (uint32_t i = s.firstLane; i < s.firstLane + s.numLanes; ++i)
+  {
+    if (this->image->lanes[i].id == _laneId)
+    {
+      _lane = LaneView(this->image, i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+PerimeterView::PerimeterView(const RNDFImage *_image, const uint32_t _index)
+  : image(_image),
+    index(_index)
+{
+}
+
+//////////////////////////////////////////////////
+size_t PerimeterView::NumPoints() const
+{
+  return this->image ? this->image->zones[this->index].numPoints : 0u;
+}
+
+//////////////////////////////////////////////////
+rndf::Waypoint PerimeterView::PointAt(const size_t _index) const
+{
+  if (_index >= this->NumPoints())
+    return rndf::Waypoint();
+
+  const ImageZone &z = this->image->zones[this->index];
+  return viewWaypoint(this->image->waypoints[z.firstPoint + _index]);
+}
+
+//////////////////////////////////////////////////
+bool PerimeterView::Point(const int _wpId, rndf::Waypoint &_wp) const
+{
+  if (!this->image)
+    return false;
+
+  const ImageZone &z = this->image->zones[this->index];
+  return viewFindWaypoint(this->image, z.firstPoint, z.numPoints, _wpId,
+    _wp);
+}
+
+//////////////////////////////////////////////////
+size_t PerimeterView::NumExits() const
+{
+  return this->image ? this->image->zones[this->index].numExits : 0u;
+}
+
+//////////////////////////////////////////////////
+rndf::Exit PerimeterView::ExitAt(const size_t _index) const
+{
+  if (_index >= this->NumExits())
+    return rndf::Exit();
+
+  const ImageZone &z = this->image->zones[this->index];
+  return viewExit(this->image->exits[z.firstExit + _index]);
+}
+
+//////////////////////////////////////////////////
+ParkingSpotView::ParkingSpotView(const RNDFImage *_image,
+  const uint32_t _index)
+  : image(_image),
+    index(_index)
+{
+}
+
+//////////////////////////////////////////////////
+int ParkingSpotView::Id() const
+{
+  return this->image ? this->image->spots[this->index].id : -1;
+}
+
+//////////////////////////////////////////////////
+size_t ParkingSpotView::NumWaypoints() const
+{
+  return this->image ? this->image->spots[this->index].numWaypoints : 0u;
+}
+
+//////////////////////////////////////////////////
+rndf::Waypoint ParkingSpotView::WaypointAt(const size_t _index) const
+{
+  if (_index >= this->NumWaypoints())
+    return rndf::Waypoint();
+
+  const ImageSpot &s = this->image->spots[this->index];
+  return viewWaypoint(this->image->waypoints[s.firstWaypoint + _index]);
+}
+
+//////////////////////////////////////////////////
+bool ParkingSpotView::Waypoint(const int _wpId, rndf::Waypoint &_wp) const
+{
+  if (!this->image)
+    return false;
+
+  const ImageSpot &s = this->image->spots[this->index];
+  return viewFindWaypoint(this->image, s.firstWaypoint, s.numWaypoints,
+    _wpId, _wp);
+}
+
+//////////////////////////////////////////////////
+double ParkingSpotView::Width() const
+{
+  return this->image ? this->image->spots[this->index].width : 0.0;
+}
+
+//////////////////////////////////////////////////
+rndf::Checkpoint ParkingSpotView::Checkpoint() const
+{
+  if (!this->image)
+    return rndf::Checkpoint();
+
+  const ImageCheckpoint &cp = this->image->spots[this->index].checkpoint;
+  return rndf::Checkpoint(cp.checkpointId, cp.waypointId);
+}
+
+//////////////////////////////////////////////////
+ZoneView::ZoneView(const RNDFImage *_image, const uint32_t _index)
+  : image(_image),
+    index(_index)
+{
+}
+
+//////////////////////////////////////////////////
+int ZoneView::Id() const
+{
+  return this->image ? this->image->zones[this->index].id : -1;
+}
+
+//////////////////////////////////////////////////
+std::string ZoneView::Name() const
+{
+  if (!this->image)
+    return "";
+
+  return this->image->String(this->image->zones[this->index].name).String();
+}
+
+//////////////////////////////////////////////////
+size_t ZoneView::NumSpots() const
+{
+  return this->image ? this->image->zones[this->index].numSpots : 0u;
+}
+
+//////////////////////////////////////////////////
+ParkingSpotView ZoneView::SpotAt(const size_t _index) const
+{
+  if (_index >= this->NumSpots())
+    return ParkingSpotView();
+
+  const ImageZone &z = this->image->zones[this->index];
+  return ParkingSpotView(this->image,
+    z.firstSpot + static_cast<uint32_t>(_index));
+}
+
+//////////////////////////////////////////////////
+bool ZoneView::Spot(const int _psId, ParkingSpotView &_ps) const
+{
+  if (!this->image)
+    return false;
+
+  const ImageZone &z = this->image->zones[this->index];
+  for (uint32_t i = z.firstSpot; i < z.firstSpot + z.numSpots; ++i)
+  {
+    if (this->image->spots[i].id == _psId)
+    {
+      _ps = ParkingSpotView(this->image, i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+PerimeterView ZoneView::Perimeter() const
+{
+  if (!this->image)
+    return PerimeterView();
+
+  return PerimeterView(this->image, this->index);
+}
+
+//////////////////////////////////////////////////
+RNDFNodeView::RNDFNodeView(const RNDFImage *_image, const uint32_t _index)
+  : image(_image),
+    index(_index)
+{
+}
+
+//////////////////////////////////////////////////
+rndf::UniqueId RNDFNodeView::UniqueId() const
+{
+  if (!this->image)
+    return rndf::UniqueId();
+
+  const ImageNode &n = this->image->nodes[this->index];
+  const int wpId = this->image->waypoints[n.waypoint].id;
+  switch (n.kind)
+  {
+    case ImageNodeKind::LANE:
+      return rndf::UniqueId(this->image->segments[n.parent].id,
+        this->image->lanes[n.owner].id, wpId);
+    case ImageNodeKind::PERIMETER:
+      return rndf::UniqueId(this->image->zones[n.parent].id, 0, wpId);
+    case ImageNodeKind::SPOT:
+      return rndf::UniqueId(this->image->zones[n.parent].id,
+        this->image->spots[n.owner].id, wpId);
+    default:
+      return rndf::UniqueId();
+  }
+}
+
+//////////////////////////////////////////////////
+rndf::Waypoint RNDFNodeView::Waypoint() const
+{
+  if (!this->image)
+    return rndf::Waypoint();
+
+  const ImageNode &n = this->image->nodes[this->index];
+  return viewWaypoint(this->image->waypoints[n.waypoint]);
+}
+
+//////////////////////////////////////////////////
+bool RNDFNodeView::Segment(SegmentView &_segment) const
+{
+  if (!this->image ||
+      this->image->nodes[this->index].kind != ImageNodeKind::LANE)
+  {
+    return false;
+  }
+
+  _segment = SegmentView(this->image, this->image->nodes[this->index].parent);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RNDFNodeView::Lane(LaneView &_lane) const
+{
+  if (!this->image ||
+      this->image->nodes[this->index].kind != ImageNodeKind::LANE)
+  {
+    return false;
+  }
+
+  _lane = LaneView(this->image, this->image->nodes[this->index].owner);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RNDFNodeView::Zone(ZoneView &_zone) const
+{
+  if (!this->image ||
+      this->image->nodes[this->index].kind == ImageNodeKind::LANE)
+  {
+    return false;
+  }
+
+  _zone = ZoneView(this->image, this->image->nodes[this->index].parent);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RNDFNodeView::Spot(ParkingSpotView &_spot) const
+{
+  if (!this->image ||
+      this->image->nodes[this->index].kind != ImageNodeKind::SPOT)
+  {
+    return false;
+  }
+
+  _spot = ParkingSpotView(this->image, this->image->nodes[this->index].owner);
+  return true;
+}
+
+//////////////////////////////////////////////////
+RNDFView::RNDFView()
+  : dataPtr(new RNDFViewPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+RNDFView::~RNDFView()
+{
+}
+
+//////////////////////////////////////////////////
+bool RNDFView::Open(const std::string &_imagePath)
+{
+  if (!this->dataPtr->Map(_imagePath))
+  {
+    std::cerr << "Error opening RNDF image [" << _imagePath << "]"
+              << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool RNDFView::Open(const std::string &_filePath,
+  const std::string &_imagePath)
+{
+  LineReader rndfFile;
+  StringView content;
+  if (!rndfFile.Open(_filePath) || !rndfFile.Remaining(content))
+  {
+    std::cerr << "Error opening RNDF [" << _filePath << "]" << std::endl;
+    return false;
+  }
+
+  const uint64_t hash = RNDFCache::Hash(content);
+  if (this->dataPtr->Map(_imagePath) &&
+      this->dataPtr->image.header->sourceHash == hash)
+  {
+    return true;
+  }
+
+  // The image is missing or outdated.
+  this->dataPtr->Unmap();
+  RNDF rndf;
+  if (!rndf.Load(rndfFile))
+    return false;
+
+  if (!RNDFCache::Write(_imagePath, hash, rndf))
+  {
+    std::cerr << "Error writing RNDF image [" << _imagePath << "]"
+              << std::endl;
+    return false;
+  }
+
+  return this->Open(_imagePath);
+}
+
+//////////////////////////////////////////////////
+bool RNDFView::IsOpen() const
+{
+  return this->dataPtr->image.header != nullptr;
+}
+
+//////////////////////////////////////////////////
+std::string RNDFView::Name() const
+{
+  if (!this->IsOpen())
+    return "";
+
+  const RNDFImage &image = this->dataPtr->image;
+  return image.String(image.header->name).String();
+}
+
+//////////////////////////////////////////////////
+std::string RNDFView::Version() const
+{
+  if (!this->IsOpen())
+    return "";
+
+  const RNDFImage &image = this->dataPtr->image;
+  return image.String(image.header->formatVersion).String();
+}
+
+//////////////////////////////////////////////////
+std::string RNDFView::Date() const
+{
+  if (!this->IsOpen())
+    return "";
+
+  const RNDFImage &image = this->dataPtr->image;
+  return image.String(image.header->date).String();
+}
+
+//////////////////////////////////////////////////
+size_t RNDFView::NumSegments() const
+{
+  return this->IsOpen() ? this->dataPtr->image.header->numSegments : 0u;
+}
+
+//////////////////////////////////////////////////
+SegmentView RNDFView::SegmentAt(const size_t _index) const
+{
+  if (_index >= this->NumSegments())
+    return SegmentView();
+
+  return SegmentView(&this->dataPtr->image, static_cast<uint32_t>(_index));
+}
+
+//////////////////////////////////////////////////
+bool RNDFView::Segment(const int _segmentId, SegmentView &_segment) const
+{
+  const RNDFImage &image = this->dataPtr->image;
+  for (uint32_t i = 0; i < this->NumSegments(); ++i)
+  {
+    if (image.segments[i].id == _segmentId)
+    {
+      _segment = SegmentView(&image, i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+size_t RNDFView::NumZones() const
+{
+  return this->IsOpen() ? this->dataPtr->image.header->numZones : 0u;
+}
+
+//////////////////////////////////////////////////
+ZoneView RNDFView::ZoneAt(const size_t _index) const
+{
+  if (_index >= this->NumZones())
+    return ZoneView();
+
+  return ZoneView(&this->dataPtr->image, static_cast<uint32_t>(_index));
+}
+
+//////////////////////////////////////////////////
+bool RNDFView::Zone(const int _zoneId, ZoneView &_zone) const
+{
+  const RNDFImage &image = this->dataPtr->image;
+  for (uint32_t i = 0; i < this->NumZones(); ++i)
+  {
+    if (image.zones[i].id == _zoneId)
+    {
+      _zone = ZoneView(&image, i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool RNDFView::Info(const rndf::UniqueId &_id, RNDFNodeView &_node) const
+{
+  if (!this->IsOpen())
+    return false;
+
+  const RNDFImage &image = this->dataPtr->image;
+  const uint64_t key = waypointKey(_id.X(), _id.Y(), _id.Z());
+  const ImageNode *begin = image.nodes;
+  const ImageNode *end = begin + image.header->numWaypoints;
+  const ImageNode *it = std::lower_bound(begin, end, key,
+    [](const ImageNode &_n, const uint64_t _key)
+    {
+      return _n.key < _key;
+    });
+
+  if (it == end || it->key != key || !image.ValidNode(*it))
+    return false;
+
+  _node = RNDFNodeView(&image, static_cast<uint32_t>(it - begin));
+  return true;
+}
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFView.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+#include "test/RNDFTestUtils.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Check that a view matches a RNDF.
+/// \param[in] _rndf The RNDF.
+/// \param[in] _view The view of the same RNDF.
+void expectEqualView(const RNDF &_rndf, const RNDFView &_view)
+{
+  EXPECT_EQ(_view.Name(), _rndf.Name());
+  EXPECT_EQ(_view.Version(), _rndf.Version());
+  EXPECT_EQ(_view.Date(), _rndf.Date());
+
+  ASSERT_EQ(_view.NumSegments(), _rndf.NumSegments());
+  for (size_t i = 0; i < _rndf.NumSegments(); ++i)
+  {
+    const Segment &segment = _rndf.Segments()[i];
+    SegmentView s = _view.SegmentAt(i);
+    EXPECT_EQ(s.Id(), segment.Id());
+    EXPECT_EQ(s.Name(), segment.Name());
+
+    SegmentView byId;
+    ASSERT_TRUE(_view.Segment(segment.Id(), byId));
+    EXPECT_EQ(byId.Id(), segment.Id());
+
+    ASSERT_EQ(s.NumLanes(), segment.NumLanes());
+    for (size_t j = 0; j < segment.NumLanes(); ++j)
+    {
+      const Lane &lane = segment.Lanes()[j];
+      LaneView l = s.LaneAt(j);
+      EXPECT_EQ(l.Id(), lane.Id());
+      EXPECT_DOUBLE_EQ(l.Width(), lane.Width());
+      EXPECT_EQ(l.LeftBoundary(), lane.LeftBoundary());
+      EXPECT_EQ(l.RightBoundary(), lane.RightBoundary());
+
+      LaneView laneById;
+      ASSERT_TRUE(s.Lane(lane.Id(), laneById));
+      EXPECT_EQ(laneById.Id(), lane.Id());
+
+      ASSERT_EQ(l.NumWaypoints(), lane.NumWaypoints());
+      for (size_t k = 0; k < lane.NumWaypoints(); ++k)
+      {
+        const Waypoint &wp = lane.Waypoints()[k];
+        testing::expectEqualWaypoint(wp, l.WaypointAt(k));
+
+        Waypoint wpById;
+        ASSERT_TRUE(l.Waypoint(wp.Id(), wpById));
+        testing::expectEqualWaypoint(wp, wpById);
+
+        RNDFNodeView node;
+        ASSERT_TRUE(_view.Info(UniqueId(segment.Id(), lane.Id(), wp.Id()),
+          node));
+        EXPECT_EQ(node.UniqueId(),
+          UniqueId(segment.Id(), lane.Id(), wp.Id()));
+        testing::expectEqualWaypoint(wp, node.Waypoint());
+        SegmentView nodeSegment;
+        LaneView nodeLane;
+        ZoneView nodeZone;
+        ParkingSpotView nodeSpot;
+        ASSERT_TRUE(node.Segment(nodeSegment));
+        ASSERT_TRUE(node.Lane(nodeLane));
+        EXPECT_FALSE(node.Zone(nodeZone));
+        EXPECT_FALSE(node.Spot(nodeSpot));
+        EXPECT_EQ(nodeSegment.Id(), segment.Id());
+        EXPECT_EQ(nodeLane.Id(), lane.Id());
+      }
+
+      ASSERT_EQ(l.NumExits(), lane.NumExits());
+      for (size_t k = 0; k < lane.NumExits(); ++k)
+        testing::expectEqualExit(lane.Exits()[k], l.ExitAt(k));
+
+      ASSERT_EQ(l.NumCheckpoints(), lane.NumCheckpoints());
+      for (size_t k = 0; k < lane.NumCheckpoints(); ++k)
+      {
+        const Checkpoint &cp = lane.Checkpoints()[k];
+        EXPECT_EQ(l.CheckpointAt(k).CheckpointId(), cp.CheckpointId());
+        EXPECT_EQ(l.CheckpointAt(k).WaypointId(), cp.WaypointId());
+
+        Checkpoint cpById;
+        ASSERT_TRUE(l.Checkpoint(cp.CheckpointId(), cpById));
+        EXPECT_EQ(cpById.WaypointId(), cp.WaypointId());
+      }
+
+      ASSERT_EQ(l.NumStops(), lane.NumStops());
+      for (size_t k = 0; k < lane.NumStops(); ++k)
+        EXPECT_EQ(l.StopAt(k), lane.Stops()[k]);
+    }
+  }
+
+  ASSERT_EQ(_view.NumZones(), _rndf.NumZones());
+  for (size_t i = 0; i < _rndf.NumZones(); ++i)
+  {
+    const Zone &zone = _rndf.Zones()[i];
+    ZoneView z = _view.ZoneAt(i);
+    EXPECT_EQ(z.Id(), zone.Id());
+    EXPECT_EQ(z.Name(), zone.Name());
+
+    ZoneView byId;
+    ASSERT_TRUE(_view.Zone(zone.Id(), byId));
+    EXPECT_EQ(byId.Id(), zone.Id());
+
+    const Perimeter &perimeter = zone.Perimeter();
+    PerimeterView p = z.Perimeter();
+    ASSERT_EQ(p.NumPoints(), perimeter.NumPoints());
+    for (size_t j = 0; j < perimeter.NumPoints(); ++j)
+    {
+      const Waypoint &wp = perimeter.Points()[j];
+      testing::expectEqualWaypoint(wp, p.PointAt(j));
+
+      Waypoint wpById;
+      ASSERT_TRUE(p.Point(wp.Id(), wpById));
+      testing::expectEqualWaypoint(wp, wpById);
+
+      RNDFNodeView node;
+      ASSERT_TRUE(_view.Info(UniqueId(zone.Id(), 0, wp.Id()), node));
+      ZoneView nodeZone;
+      LaneView nodeLane;
+      ParkingSpotView nodeSpot;
+      ASSERT_TRUE(node.Zone(nodeZone));
+      EXPECT_FALSE(node.Lane(nodeLane));
+      EXPECT_FALSE(node.Spot(nodeSpot));
+      EXPECT_EQ(nodeZone.Id(), zone.Id());
+    }
+
+    ASSERT_EQ(p.NumExits(), perimeter.NumExits());
+    for (size_t j = 0; j < perimeter.NumExits(); ++j)
+      testing::expectEqualExit(perimeter.Exits()[j], p.ExitAt(j));
+
+    ASSERT_EQ(z.NumSpots(), zone.NumSpots());
+    for (size_t j = 0; j < zone.NumSpots(); ++j)
+    {
+      const ParkingSpot &spot = zone.Spots()[j];
+      ParkingSpotView ps = z.SpotAt(j);
+      EXPECT_EQ(ps.Id(), spot.Id());
+      EXPECT_DOUBLE_EQ(ps.Width(), spot.Width());
+      EXPECT_EQ(ps.Checkpoint().CheckpointId(),
+                spot.Checkpoint().CheckpointId());
+      EXPECT_EQ(ps.Checkpoint().WaypointId(), spot.Checkpoint().WaypointId());
+
+      ParkingSpotView spotById;
+      ASSERT_TRUE(z.Spot(spot.Id(), spotById));
+      EXPECT_EQ(spotById.Id(), spot.Id());
+
+      ASSERT_EQ(ps.NumWaypoints(), spot.NumWaypoints());
+      for (size_t k = 0; k < spot.NumWaypoints(); ++k)
+      {
+        const Waypoint &wp = spot.Waypoints()[k];
+        testing::expectEqualWaypoint(wp, ps.WaypointAt(k));
+
+        RNDFNodeView node;
+        ASSERT_TRUE(_view.Info(UniqueId(zone.Id(), spot.Id(), wp.Id()),
+          node));
+        ParkingSpotView nodeSpot;
+        ZoneView nodeZone;
+        ASSERT_TRUE(node.Spot(nodeSpot));
+        ASSERT_TRUE(node.Zone(nodeZone));
+        EXPECT_EQ(nodeSpot.Id(), spot.Id());
+        EXPECT_EQ(nodeZone.Id(), zone.Id());
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check a view of the sample files.
+TEST(RNDFView, Samples)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  const std::string imagePath =
+    std::string(PROJECT_BINARY_PATH) + "/RNDFView_TEST.image";
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    const std::string filePath = dirPath + "/test/rndf/" + sample;
+    std::remove(imagePath.c_str());
+
+    RNDF rndf;
+    ASSERT_TRUE(rndf.Load(filePath));
+
+    // The image is created from the text file.
+    RNDFView view;
+    EXPECT_FALSE(view.IsOpen());
+    ASSERT_TRUE(view.Open(filePath, imagePath));
+    EXPECT_TRUE(view.IsOpen());
+    expectEqualView(rndf, view);
+
+    // Open the existing image.
+    RNDFView other;
+    ASSERT_TRUE(other.Open(imagePath));
+    expectEqualView(rndf, other);
+  }
+
+  std::remove(imagePath.c_str());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check lookups of elements that don't exist.
+TEST(RNDFView, NotFound)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  const std::string filePath = dirPath + "/test/rndf/sample1.rndf";
+  const std::string imagePath =
+    std::string(PROJECT_BINARY_PATH) + "/RNDFView_TEST_notfound.image";
+
+  RNDFView view;
+  ASSERT_TRUE(view.Open(filePath, imagePath));
+
+  SegmentView segment;
+  ZoneView zone;
+  RNDFNodeView node;
+  EXPECT_FALSE(view.Segment(1000, segment));
+  EXPECT_FALSE(view.Zone(1000, zone));
+  EXPECT_FALSE(view.Info(UniqueId(1000, 1, 1), node));
+  EXPECT_FALSE(view.Info(UniqueId(1, 1, 1000), node));
+  EXPECT_EQ(view.SegmentAt(view.NumSegments()).Id(), -1);
+  EXPECT_EQ(view.ZoneAt(view.NumZones()).Id(), -1);
+
+  segment = view.SegmentAt(0);
+  LaneView lane;
+  EXPECT_FALSE(segment.Lane(1000, lane));
+  lane = segment.LaneAt(0);
+  Waypoint wp;
+  Checkpoint cp;
+  EXPECT_FALSE(lane.Waypoint(1000, wp));
+  EXPECT_FALSE(lane.Checkpoint(1000, cp));
+  EXPECT_EQ(lane.WaypointAt(lane.NumWaypoints()).Id(), -1);
+  EXPECT_EQ(lane.StopAt(lane.NumStops()), -1);
+
+  // Default views are empty.
+  EXPECT_EQ(LaneView().Id(), -1);
+  EXPECT_EQ(LaneView().NumWaypoints(), 0u);
+  EXPECT_EQ(SegmentView().NumLanes(), 0u);
+  EXPECT_EQ(ZoneView().NumSpots(), 0u);
+  EXPECT_EQ(ZoneView().Perimeter().NumPoints(), 0u);
+  EXPECT_EQ(ParkingSpotView().NumWaypoints(), 0u);
+  EXPECT_FALSE(RNDFNodeView().Lane(lane));
+
+  std::remove(imagePath.c_str());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that invalid images are rejected.
+TEST(RNDFView, InvalidImage)
+{
+  const std::string imagePath =
+    std::string(PROJECT_BINARY_PATH) + "/RNDFView_TEST_invalid.image";
+
+  RNDFView view;
+  EXPECT_FALSE(view.Open("__nonexistent__.image"));
+  EXPECT_FALSE(view.IsOpen());
+  EXPECT_EQ(view.NumSegments(), 0u);
+  EXPECT_EQ(view.Name(), "");
+
+  // A RNDF text isn't an image.
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  EXPECT_FALSE(view.Open(dirPath + "/test/rndf/sample1.rndf"));
+
+  // A truncated image.
+  ASSERT_TRUE(view.Open(dirPath + "/test/rndf/sample1.rndf", imagePath));
+  std::string content;
+  {
+    std::ifstream file(imagePath, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+  }
+  {
+    std::ofstream file(imagePath, std::ios::binary | std::ios::trunc);
+    file << content.substr(0, content.size() - 1);
+  }
+
+  RNDFView truncated;
+  EXPECT_FALSE(truncated.Open(imagePath));
+  EXPECT_FALSE(truncated.IsOpen());
+
+  // The view opened before keeps its own mapping.
+  EXPECT_TRUE(view.IsOpen());
+  EXPECT_GT(view.NumSegments(), 0u);
+
+  // The image is rewritten if it isn't valid.
+  ASSERT_TRUE(truncated.Open(dirPath + "/test/rndf/sample1.rndf",
+    imagePath));
+  EXPECT_EQ(truncated.Name(), view.Name());
+
+  std::remove(imagePath.c_str());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <string>
+
+#include "ignition/rndf/RNDFVisitor.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+//////////////////////////////////////////////////
+RNDFVisitor::~RNDFVisitor()
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnRNDF(const std::string &/*_name*/,
+  const int /*_numSegments*/, const int /*_numZones*/,
+  const std::string &/*_version*/, const std::string &/*_date*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnSegment(const int /*_segmentId*/,
+  const int /*_numLanes*/, const std::string &/*_name*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnLane(const int /*_segmentId*/, const int /*_laneId*/,
+  const int /*_numWaypoints*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnLaneHeader(const int /*_segmentId*/,
+  const int /*_laneId*/, const double /*_width*/,
+  const Marking /*_leftBoundary*/, const Marking /*_rightBoundary*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnCheckpoint(const int /*_segmentId*/,
+  const int /*_laneId*/, const Checkpoint &/*_checkpoint*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnStop(const int /*_segmentId*/, const int /*_laneId*/,
+  const int /*_waypointId*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnExit(const Exit &/*_exit*/, const int /*_lineNumber*/,
+  const StringView &/*_line*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnWaypoint(const int /*_x*/, const int /*_y*/,
+  const Waypoint &/*_waypoint*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnZone(const int /*_zoneId*/, const int /*_numSpots*/,
+  const std::string &/*_name*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnPerimeter(const int /*_zoneId*/,
+  const int /*_numPoints*/)
+{
+}
+
+//////////////////////////////////////////////////
+void RNDFVisitor::OnSpot(const int /*_zoneId*/, const int /*_spotId*/,
+  const double /*_width*/, const Checkpoint &/*_checkpoint*/)
+{
+}
@@ -0,0 +1,448 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/StringView.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief A visitor that counts the elements reported.
+class CountingVisitor : public RNDFVisitor
+{
+  // Documentation inherited.
+  public: virtual void OnRNDF(const std::string &_name,
+                              const int _numSegments, const int _numZones,
+                              const std::string &_version,
+                              const std::string &_date)
+  {
+    this->name = _name;
+    this->numSegments = _numSegments;
+    this->numZones = _numZones;
+    this->version = _version;
+    this->date = _date;
+  }
+
+  // Documentation inherited.
+  public: virtual void OnSegment(const int, const int,
+                                 const std::string &)
+  {
+    ++this->segments;
+  }
+
+  // Documentation inherited.
+  public: virtual void OnLane(const int, const int, const int)
+  {
+    ++this->lanes;
+  }
+
+  // Documentation inherited.
+  public: virtual void OnCheckpoint(const int, const int, const Checkpoint &)
+  {
+    ++this->checkpoints;
+  }
+
+  // Documentation inherited.
+  public: virtual void OnStop(const int, const int, const int)
+  {
+    ++this->stops;
+  }
+
+  // Documentation inherited.
+  public: virtual void OnExit(const Exit &, const int, const StringView &)
+  {
+    ++this->exits;
+  }
+
+  // Documentation inherited.
+  public: virtual void OnWaypoint(const int _x, const int _y,
+                                  const Waypoint &_waypoint)
+  {
+    ++this->waypoints;
+    if (_waypoint.IsExit())
+      ++this->exitWaypoints;
+    this->keys.push_back(UniqueId(_x, _y, _waypoint.Id()).Key());
+  }
+
+  // Documentation inherited.
+  public: virtual void OnZone(const int, const int, const std::string &)
+  {
+    ++this->zones;
+  }
+
+  // Documentation inherited.
+  public: virtual void OnSpot(const int, const int, const double,
+                              const Checkpoint &)
+  {
+    ++this->spots;
+  }
+
+  /// \brief RNDF name.
+  public: std::string name;
+
+  /// \brief Number of segments declared.
+  public: int numSegments = 0;
+
+  /// \brief Number of zones declared.
+  public: int numZones = 0;
+
+  /// \brief Format version.
+  public: std::string version;
+
+  /// \brief Creation date.
+  public: std::string date;
+
+  /// \brief Number of segments reported.
+  public: int segments = 0;
+
+  /// \brief Number of lanes reported.
+  public: int lanes = 0;
+
+  /// \brief Number of lane checkpoints reported.
+  public: int checkpoints = 0;
+
+  /// \brief Number of stops reported.
+  public: int stops = 0;
+
+  /// \brief Number of exits reported.
+  public: int exits = 0;
+
+  /// \brief Number of waypoints reported.
+  public: int waypoints = 0;
+
+  /// \brief Number of waypoints reported with the exit flag set.
+  public: int exitWaypoints = 0;
+
+  /// \brief Number of zones reported.
+  public: int zones = 0;
+
+  /// \brief Number of parking spots reported.
+  public: int spots = 0;
+
+  /// \brief Keys of the waypoints reported, in order.
+  public: std::vector<uint64_t> keys;
+};
+
+/// \brief A visitor that records the elements reported as text.
+class RecordingVisitor : public RNDFVisitor
+{
+  // Documentation inherited.
+  public: virtual void OnRNDF(const std::string &_name, const int,
+                              const int, const std::string &,
+                              const std::string &)
+  {
+    this->events.push_back("rndf " + _name);
+  }
+
+  // Documentation inherited.
+  public: virtual void OnSegment(const int _segmentId, const int _numLanes,
+                                 const std::string &_name)
+  {
+    this->events.push_back("segment " + std::to_string(_segmentId) + " " +
+      std::to_string(_numLanes) + " " + _name);
+  }
+
+  // Documentation inherited.
+  public: virtual void OnLane(const int _segmentId, const int _laneId,
+                              const int _numWaypoints)
+  {
+    this->events.push_back("lane " + std::to_string(_segmentId) + "." +
+      std::to_string(_laneId) + " " + std::to_string(_numWaypoints));
+  }
+
+  // Documentation inherited.
+  public: virtual void OnLaneHeader(const int, const int, const double,
+                                    const Marking _left, const Marking _right)
+  {
+    this->events.push_back(std::string("lane_header ") +
+      (_left == Marking::DOUBLE_YELLOW ? "double_yellow" : "other") + " " +
+      (_right == Marking::UNDEFINED ? "undefined" : "other"));
+  }
+
+  // Documentation inherited.
+  public: virtual void OnCheckpoint(const int, const int,
+                                    const Checkpoint &_checkpoint)
+  {
+    this->events.push_back("checkpoint " +
+      std::to_string(_checkpoint.WaypointId()) + " " +
+      std::to_string(_checkpoint.CheckpointId()));
+  }
+
+  // Documentation inherited.
+  public: virtual void OnStop(const int, const int, const int _waypointId)
+  {
+    this->events.push_back("stop " + std::to_string(_waypointId));
+  }
+
+  // Documentation inherited.
+  public: virtual void OnExit(const Exit &_exit, const int _lineNumber,
+                              const StringView &)
+  {
+    this->events.push_back("exit " + _exit.ExitId().String() + " " +
+      _exit.EntryId().String() + " line " + std::to_string(_lineNumber));
+  }
+
+  // Documentation inherited.
+  public: virtual void OnWaypoint(const int _x, const int _y,
+                                  const Waypoint &_waypoint)
+  {
+    this->events.push_back("waypoint " +
+      UniqueId(_x, _y, _waypoint.Id()).String() +
+      (_waypoint.IsExit() ? " exit" : ""));
+  }
+
+  // Documentation inherited.
+  public: virtual void OnZone(const int _zoneId, const int _numSpots,
+                              const std::string &_name)
+  {
+    this->events.push_back("zone " + std::to_string(_zoneId) + " " +
+      std::to_string(_numSpots) + " " + _name);
+  }
+
+  // Documentation inherited.
+  public: virtual void OnPerimeter(const int _zoneId, const int _numPoints)
+  {
+    this->events.push_back("perimeter " + std::to_string(_zoneId) + " " +
+      std::to_string(_numPoints));
+  }
+
+  // Documentation inherited.
+  public: virtual void OnSpot(const int _zoneId, const int _spotId,
+                              const double, const Checkpoint &_checkpoint)
+  {
+    this->events.push_back("spot " + std::to_string(_zoneId) + "." +
+      std::to_string(_spotId) + " checkpoint " +
+      std::to_string(_checkpoint.CheckpointId()));
+  }
+
+  /// \brief The elements reported.
+  public: std::vector<std::string> events;
+};
+
+/// \brief A small RNDF with an element of every kind.
+static const char *kSmallRNDF =
+  "RNDF_name small\n"
+  "num_segments 1\n"
+  "num_zones 1\n"
+  "segment 1\n"
+  "num_lanes 1\n"
+  "segment_name road\n"
+  "lane 1.1\n"
+  "num_waypoints 2\n"
+  "left_boundary double_yellow\n"
+  "checkpoint 1.1.1 3\n"
+  "stop 1.1.2\n"
+  "exit 1.1.2 2.0.1\n"
+  "1.1.1 10.0 20.0\n"
+  "1.1.2 10.1 20.1\n"
+  "end_lane\n"
+  "end_segment\n"
+  "zone 2\n"
+  "num_spots 1\n"
+  "perimeter 2.0\n"
+  "num_perimeterpoints 1\n"
+  "exit 2.0.1 1.1.1\n"
+  "2.0.1 10.2 20.2\n"
+  "end_perimeter\n"
+  "spot 2.1\n"
+  "checkpoint 2.1.2 4\n"
+  "2.1.1 10.3 20.3\n"
+  "2.1.2 10.4 20.4\n"
+  "end_spot\n"
+  "end_zone\n"
+  "end_file\n";
+
+//////////////////////////////////////////////////
+/// \brief Check that the default visitor accepts a complete RNDF.
+TEST(RNDFVisitor, defaults)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDFVisitor visitor;
+  EXPECT_TRUE(RNDF::Parse(dirPath + "/test/rndf/sample1.rndf", visitor));
+  EXPECT_TRUE(RNDF::Parse(dirPath + "/test/rndf/sample2.rndf", visitor));
+  EXPECT_FALSE(RNDF::Parse("__inexistentFile___.rndf", visitor));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the order of the elements reported.
+TEST(RNDFVisitor, order)
+{
+  std::istringstream stream(kSmallRNDF);
+  LineReader reader(stream);
+  RecordingVisitor visitor;
+  ASSERT_TRUE(RNDF::Parse(reader, visitor));
+
+  std::vector<std::string> expected =
+  {
+    "rndf small",
+    "segment 1 1 road",
+    "lane 1.1 2",
+    "checkpoint 1 3",
+    "stop 2",
+    "exit 1.1.2 2.0.1 line 12",
+    "lane_header double_yellow undefined",
+    "waypoint 1.1.1",
+    "waypoint 1.1.2 exit",
+    "zone 2 1 ",
+    "perimeter 2 1",
+    "exit 2.0.1 1.1.1 line 21",
+    "waypoint 2.0.1 exit",
+    "spot 2.1 checkpoint 4",
+    "waypoint 2.1.1",
+    "waypoint 2.1.2",
+  };
+  EXPECT_EQ(visitor.events, expected);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the elements reported match the loaded objects.
+TEST(RNDFVisitor, samples)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    const std::string filePath = dirPath + "/test/rndf/" + sample;
+    RNDF rndf(filePath);
+    ASSERT_TRUE(rndf.Valid());
+
+    CountingVisitor visitor;
+    ASSERT_TRUE(RNDF::Parse(filePath, visitor));
+
+    EXPECT_EQ(visitor.name, rndf.Name());
+    EXPECT_EQ(visitor.version, rndf.Version());
+    EXPECT_EQ(visitor.date, rndf.Date());
+    EXPECT_EQ(static_cast<size_t>(visitor.numSegments), rndf.NumSegments());
+    EXPECT_EQ(static_cast<size_t>(visitor.numZones), rndf.NumZones());
+    EXPECT_EQ(static_cast<size_t>(visitor.segments), rndf.NumSegments());
+    EXPECT_EQ(static_cast<size_t>(visitor.zones), rndf.NumZones());
+
+    int lanes = 0;
+    int checkpoints = 0;
+    int stops = 0;
+    int exits = 0;
+    int exitWaypoints = 0;
+    int spots = 0;
+    std::vector<uint64_t> keys;
+    for (auto const &segment : rndf.Segments())
+    {
+      for (auto const &lane : segment.Lanes())
+      {
+        ++lanes;
+        checkpoints += static_cast<int>(lane.NumCheckpoints());
+        stops += static_cast<int>(lane.NumStops());
+        exits += static_cast<int>(lane.NumExits());
+        for (auto const &wp : lane.Waypoints())
+        {
+          exitWaypoints += wp.IsExit() ? 1 : 0;
+          keys.push_back(UniqueId(segment.Id(), lane.Id(), wp.Id()).Key());
+        }
+      }
+    }
+    for (auto const &zone : rndf.Zones())
+    {
+      exits += static_cast<int>(zone.Perimeter().NumExits());
+      for (auto const &wp : zone.Perimeter().Points())
+      {
+        exitWaypoints += wp.IsExit() ? 1 : 0;
+        keys.push_back(UniqueId(zone.Id(), 0, wp.Id()).Key());
+      }
+      for (auto const &spot : zone.Spots())
+      {
+        ++spots;
+        for (auto const &wp : spot.Waypoints())
+          keys.push_back(UniqueId(zone.Id(), spot.Id(), wp.Id()).Key());
+      }
+    }
+
+    EXPECT_EQ(visitor.lanes, lanes);
+    EXPECT_EQ(visitor.checkpoints, checkpoints);
+    EXPECT_EQ(visitor.stops, stops);
+    EXPECT_EQ(visitor.exits, exits);
+    EXPECT_EQ(visitor.exitWaypoints, exitWaypoints);
+    EXPECT_EQ(visitor.spots, spots);
+    EXPECT_EQ(visitor.waypoints, static_cast<int>(keys.size()));
+    EXPECT_EQ(visitor.keys, keys);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that parsing stops at the first error and that exits are
+/// not validated against the waypoints.
+TEST(RNDFVisitor, errors)
+{
+  // The lane has a non-consecutive waypoint.
+  {
+    std::string content(kSmallRNDF);
+    content.replace(content.find("1.1.2 10.1"), 5, "1.1.3");
+    std::istringstream stream(content);
+    LineReader reader(stream);
+    CountingVisitor visitor;
+    EXPECT_FALSE(RNDF::Parse(reader, visitor));
+    EXPECT_EQ(visitor.waypoints, 1);
+    EXPECT_EQ(visitor.zones, 0);
+  }
+
+  // The file doesn't end with "end_file".
+  {
+    std::string content(kSmallRNDF);
+    content.erase(content.find("end_file"));
+    std::istringstream stream(content);
+    LineReader reader(stream);
+    CountingVisitor visitor;
+    EXPECT_FALSE(RNDF::Parse(reader, visitor));
+    EXPECT_EQ(visitor.spots, 1);
+  }
+
+  // The entry of an exit doesn't exist. Load() rejects it.
+  {
+    std::string content(kSmallRNDF);
+    content.replace(content.find("exit 1.1.2 2.0.1"), 16, "exit 1.1.2 2.0.9");
+    std::istringstream stream(content);
+    LineReader reader(stream);
+    CountingVisitor visitor;
+    EXPECT_TRUE(RNDF::Parse(reader, visitor));
+    EXPECT_EQ(visitor.exits, 2);
+
+    std::istringstream loadStream(content);
+    RNDF rndf;
+    EXPECT_FALSE(rndf.Load(loadStream));
+  }
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,479 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFWriter.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/StringView.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for RNDFWriter class.
+    class RNDFWriterPrivate
+    {
+      /// \brief Constructor.
+      /// \param[in, out] _stream Stream where the text is written.
+      public: explicit RNDFWriterPrivate(std::ostream &_stream)
+        : stream(_stream),
+          buffer(RNDFWriter::kBufferSize)
+      {
+      }
+
+      /// \brief Make room in the buffer, flushing it if needed.
+      /// \param[in] _size Number of characters that will be appended.
+      /// \return Pointer where the characters can be written.
+      public: char *Reserve(const size_t _size)
+      {
+        if (this->buffer.size() - this->used < _size)
+        {
+          this->Flush();
+          if (this->buffer.size() < _size)
+            this->buffer.resize(_size);
+        }
+        return &this->buffer[this->used];
+      }
+
+      /// \brief Write the buffered text to the stream.
+      public: void Flush()
+      {
+        if (this->used > 0)
+        {
+          this->stream.write(this->buffer.data(),
+            static_cast<std::streamsize>(this->used));
+          this->used = 0;
+        }
+      }
+
+      /// \brief Append text.
+      /// \param[in] _text The text.
+      public: void Append(const StringView &_text)
+      {
+        char *out = this->Reserve(_text.Size());
+        std::memcpy(out, _text.Data(), _text.Size());
+        this->used += _text.Size();
+      }
+
+      /// \brief Append an integer.
+      /// \param[in] _value The integer.
+      public: void Append(const int _value)
+      {
+        // Digits are generated backwards into a local buffer.
+        char digits[16];
+        char *end = digits + sizeof(digits);
+        char *begin = end;
+        uint32_t magnitude = _value < 0 ?
+          0u - static_cast<uint32_t>(_value) : static_cast<uint32_t>(_value);
+        do
+        {
+          *--begin = static_cast<char>('0' + magnitude % 10);
+          magnitude /= 10;
+        } while (magnitude > 0);
+
+        if (_value < 0)
+          *--begin = '-';
+
+        this->Append(StringView(begin, static_cast<size_t>(end - begin)));
+      }
+
+      /// \brief Append a double.
+      /// \param[in] _value The double.
+      public: void Append(const double _value)
+      {
+        char *out = this->Reserve(RNDFWriter::kMaxDoubleSize);
+        this->used += RNDFWriter::FormatDouble(_value, out);
+      }
+
+      /// \brief Append a waypoint Id (x.y.z).
+      /// \param[in] _x The "x" element.
+      /// \param[in] _y The "y" element.
+      /// \param[in] _z The "z" element.
+      public: void AppendId(const int _x, const int _y, const int _z)
+      {
+        this->Append(_x);
+        this->Append(".");
+        this->Append(_y);
+        this->Append(".");
+        this->Append(_z);
+      }
+
+      /// \brief Append a unique Id (x.y.z).
+      /// \param[in] _id The unique Id.
+      public: void AppendId(const UniqueId &_id)
+      {
+        this->AppendId(_id.X(), _id.Y(), _id.Z());
+      }
+
+      /// \brief Append a line with a keyword and an integer value.
+      /// \param[in] _keyword The keyword.
+      /// \param[in] _value The value.
+      public: void Line(const char *_keyword, const int _value)
+      {
+        this->Append(_keyword);
+        this->Append("\t");
+        this->Append(_value);
+        this->Append("\n");
+      }
+
+      /// \brief Append a line with a keyword and a string value.
+      /// \param[in] _keyword The keyword.
+      /// \param[in] _value The value.
+      public: void Line(const char *_keyword, const std::string &_value)
+      {
+        this->Append(_keyword);
+        this->Append("\t");
+        this->Append(_value);
+        this->Append("\n");
+      }
+
+      /// \brief Append a width, converted from meters to feet.
+      /// \param[in] _keyword Keyword of the line.
+      /// \param[in] _width Width in meters.
+      public: void Width(const char *_keyword, const double _width)
+      {
+        // The format only supports widths in whole feet.
+        if (_width > 0)
+          this->Line(_keyword, static_cast<int>(std::lround(_width / 0.3048)));
+      }
+
+      /// \brief Append a boundary line, unless it's undefined.
+      /// \param[in] _keyword Keyword of the line.
+      /// \param[in] _boundary The boundary.
+      public: void Boundary(const char *_keyword, const Marking _boundary)
+      {
+        const char *name = nullptr;
+        switch (_boundary)
+        {
+          case Marking::DOUBLE_YELLOW:
+            name = "double_yellow";
+            break;
+          case Marking::SOLID_YELLOW:
+            name = "solid_yellow";
+            break;
+          case Marking::SOLID_WHITE:
+            name = "solid_white";
+            break;
+          case Marking::BROKEN_WHITE:
+            name = "broken_white";
+            break;
+          case Marking::UNDEFINED:
+          default:
+            return;
+        }
+
+        this->Append(_keyword);
+        this->Append("\t");
+        this->Append(name);
+        this->Append("\n");
+      }
+
+      /// \brief Append a checkpoint line.
+      /// \param[in] _x The "x" element of the waypoint Id.
+      /// \param[in] _y The "y" element of the waypoint Id.
+      /// \param[in] _checkpoint The checkpoint.
+      public: void CheckpointLine(const int _x, const int _y,
+                                  const Checkpoint &_checkpoint)
+      {
+        this->Append("checkpoint\t");
+        this->AppendId(_x, _y, _checkpoint.WaypointId());
+        this->Append("\t");
+        this->Append(_checkpoint.CheckpointId());
+        this->Append("\n");
+      }
+
+      /// \brief Append exit lines.
+      /// \param[in] _exits The exits.
+      public: void Exits(const std::vector<Exit> &_exits)
+      {
+        for (auto const &exit : _exits)
+        {
+          this->Append("exit\t");
+          this->AppendId(exit.ExitId());
+          this->Append("\t");
+          this->AppendId(exit.EntryId());
+          this->Append("\n");
+        }
+      }
+
+      /// \brief Append waypoint lines.
+      /// \param[in] _x The "x" element of the waypoint Ids.
+      /// \param[in] _y The "y" element of the waypoint Ids.
+      /// \param[in] _waypoints The waypoints.
+      public: void Waypoints(const int _x, const int _y,
+                             const std::vector<Waypoint> &_waypoints)
+      {
+        for (auto const &wp : _waypoints)
+        {
+          this->AppendId(_x, _y, wp.Id());
+          this->Append("\t");
+          this->Append(wp.Latitude());
+          this->Append("\t");
+          this->Append(wp.Longitude());
+          this->Append("\n");
+        }
+      }
+
+      /// \brief Stream where the text is written.
+      public: std::ostream &stream;
+
+      /// \brief The output buffer.
+      public: std::vector<char> buffer;
+
+      /// \brief Number of characters used in the buffer.
+      public: size_t used = 0;
+    };
+
+    /// \internal
+    /// \brief Compare two doubles bit by bit.
+    /// \param[in] _a First value.
+    /// \param[in] _b Second value.
+    /// \return True if both values have the same representation.
+    static bool sameDouble(const double _a, const double _b)
+    {
+      return std::memcmp(&_a, &_b, sizeof(double)) == 0;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+RNDFWriter::RNDFWriter(std::ostream &_stream)
+  : dataPtr(new RNDFWriterPrivate(_stream))
+{
+}
+
+//////////////////////////////////////////////////
+RNDFWriter::~RNDFWriter()
+{
+  this->dataPtr->Flush();
+}
+
+//////////////////////////////////////////////////
+bool RNDFWriter::Flush()
+{
+  this->dataPtr->Flush();
+  this->dataPtr->stream.flush();
+  return this->dataPtr->stream.good();
+}
+
+//////////////////////////////////////////////////
+void RNDFWriter::WriteRNDF(const RNDF &_rndf)
+{
+  this->dataPtr->Line("RNDF_name", _rndf.Name());
+  this->dataPtr->Line("num_segments", static_cast<int>(_rndf.NumSegments()));
+  this->dataPtr->Line("num_zones", static_cast<int>(_rndf.NumZones()));
+  if (!_rndf.Version().empty())
+    this->dataPtr->Line("format_version", _rndf.Version());
+  if (!_rndf.Date().empty())
+    this->dataPtr->Line("creation_date", _rndf.Date());
+
+  for (auto const &segment : _rndf.Segments())
+    this->WriteSegment(segment);
+
+  for (auto const &zone : _rndf.Zones())
+    this->WriteZone(zone);
+
+  this->dataPtr->Append("end_file\n");
+}
+
+//////////////////////////////////////////////////
+void RNDFWriter::WriteSegment(const Segment &_segment)
+{
+  this->dataPtr->Line("segment", _segment.Id());
+  this->dataPtr->Line("num_lanes", static_cast<int>(_segment.NumLanes()));
+  if (!_segment.Name().empty())
+    this->dataPtr->Line("segment_name", _segment.Name());
+
+  for (auto const &lane : _segment.Lanes())
+    this->WriteLane(_segment.Id(), lane);
+
+  this->dataPtr->Append("end_segment\n");
+}
+
+//////////////////////////////////////////////////
+void RNDFWriter::WriteLane(const int _segmentId, const Lane &_lane)
+{
+  this->dataPtr->Append("lane\t");
+  this->dataPtr->Append(_segmentId);
+  this->dataPtr->Append(".");
+  this->dataPtr->Append(_lane.Id());
+  this->dataPtr->Append("\n");
+  this->dataPtr->Line("num_waypoints",
+    static_cast<int>(_lane.NumWaypoints()));
+  this->dataPtr->Width("lane_width", _lane.Width());
+  this->dataPtr->Boundary("left_boundary", _lane.LeftBoundary());
+  this->dataPtr->Boundary("right_boundary", _lane.RightBoundary());
+
+  for (auto const &checkpoint : _lane.Checkpoints())
+    this->dataPtr->CheckpointLine(_segmentId, _lane.Id(), checkpoint);
+
+  for (auto const &stop : _lane.Stops())
+  {
+    this->dataPtr->Append("stop\t");
+    this->dataPtr->AppendId(_segmentId, _lane.Id(), stop);
+    this->dataPtr->Append("\n");
+  }
+
+  this->dataPtr->Exits(_lane.Exits());
+  this->dataPtr->Waypoints(_segmentId, _lane.Id(), _lane.Waypoints());
+  this->dataPtr->Append("end_lane\n");
+}
+
+//////////////////////////////////////////////////
+void RNDFWriter::WriteZone(const Zone &_zone)
+{
+  this->dataPtr->Line("zone", _zone.Id());
+  this->dataPtr->Line("num_spots", static_cast<int>(_zone.NumSpots()));
+  if (!_zone.Name().empty())
+    this->dataPtr->Line("zone_name", _zone.Name());
+
+  this->WritePerimeter(_zone.Id(), _zone.Perimeter());
+
+  for (auto const &spot : _zone.Spots())
+    this->WriteSpot(_zone.Id(), spot);
+
+  this->dataPtr->Append("end_zone\n");
+}
+
+//////////////////////////////////////////////////
+void RNDFWriter::WritePerimeter(const int _zoneId,
+  const Perimeter &_perimeter)
+{
+  this->dataPtr->Append("perimeter\t");
+  this->dataPtr->Append(_zoneId);
+  this->dataPtr->Append(".0\n");
+  this->dataPtr->Line("num_perimeterpoints",
+    static_cast<int>(_perimeter.NumPoints()));
+  this->dataPtr->Exits(_perimeter.Exits());
+  this->dataPtr->Waypoints(_zoneId, 0, _perimeter.Points());
+  this->dataPtr->Append("end_perimeter\n");
+}
+
+//////////////////////////////////////////////////
+void RNDFWriter::WriteSpot(const int _zoneId, const ParkingSpot &_spot)
+{
+  this->dataPtr->Append("spot\t");
+  this->dataPtr->Append(_zoneId);
+  this->dataPtr->Append(".");
+  this->dataPtr->Append(_spot.Id());
+  this->dataPtr->Append("\n");
+  this->dataPtr->Width("spot_width", _spot.Width());
+  if (_spot.Checkpoint().Valid())
+    this->dataPtr->CheckpointLine(_zoneId, _spot.Id(), _spot.Checkpoint());
+  this->dataPtr->Waypoints(_zoneId, _spot.Id(), _spot.Waypoints());
+  this->dataPtr->Append("end_spot\n");
+}
+
+//////////////////////////////////////////////////
+size_t RNDFWriter::FormatDouble(const double _value, char *_buffer)
+{
+  static const double kPow10[] =
+  {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+  };
+
+  // Fixed notation with the fewest decimals that round-trip. The scaled
+  // value must be an exact integer in a double, so that its division by a
+  // power of ten is rounded once, as parseDouble() does.
+  const double kMaxExact = 9007199254740992.0;
+  if (std::fabs(_value) < 1e9)
+  {
+    for (int decimals = 0; decimals <= 9; ++decimals)
+    {
+      const double scaled = std::round(_value * kPow10[decimals]);
+      if (std::fabs(scaled) > kMaxExact ||
+          !sameDouble(scaled / kPow10[decimals], _value))
+      {
+        continue;
+      }
+
+      // Generate the digits backwards, with at least one integer digit.
+      char digits[kMaxDoubleSize];
+      char *end = digits + sizeof(digits);
+      char *begin = end;
+      uint64_t magnitude = static_cast<uint64_t>(std::fabs(scaled));
+      int count = 0;
+      do
+      {
+        if (count == decimals && decimals > 0)
+          *--begin = '.';
+        *--begin = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+        ++count;
+      } while (magnitude > 0 || count <= decimals);
+
+      if (std::signbit(_value))
+        *--begin = '-';
+
+      const size_t size = static_cast<size_t>(end - begin);
+      std::memcpy(_buffer, begin, size);
+      return size;
+    }
+  }
+
+  // Scientific notation with increasing precision.
+  for (int precision = 15; precision <= 17; ++precision)
+  {
+    char text[kMaxDoubleSize];
+    int size = std::snprintf(text, sizeof(text), "%.*g", precision, _value);
+    if (size <= 0 || static_cast<size_t>(size) >= sizeof(text))
+      break;
+
+    // The decimal separator depends on the locale.
+    for (int i = 0; i < size; ++i)
+    {
+      const char c = text[i];
+      if ((c < '0' || c > '9') && c != '-' && c != '+' && c != 'e' &&
+          c != 'E' && c != 'n' && c != 'a' && c != 'i' && c != 'f')
+      {
+        text[i] = '.';
+      }
+    }
+
+    double parsed;
+    if (precision == 17 ||
+        (parseDouble(StringView(text, static_cast<size_t>(size)), parsed) &&
+         sameDouble(parsed, _value)))
+    {
+      std::memcpy(_buffer, text, static_cast<size_t>(size));
+      return static_cast<size_t>(size);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFWriter.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/StringView.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+#include "test/RNDFTestUtils.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Format a double with RNDFWriter::FormatDouble().
+/// \param[in] _value The value.
+/// \return The text.
+std::string formatDouble(const double _value)
+{
+  char buffer[RNDFWriter::kMaxDoubleSize];
+  const size_t size = RNDFWriter::FormatDouble(_value, buffer);
+  return std::string(buffer, size);
+}
+
+/// \brief Check that a formatted double is parsed back as the same value.
+/// \param[in] _value The value.
+void expectRoundTrip(const double _value)
+{
+  const std::string text = formatDouble(_value);
+  double parsed = 0;
+  ASSERT_TRUE(parseDouble(StringView(text), parsed)) << text;
+  EXPECT_EQ(std::signbit(_value), std::signbit(parsed)) << text;
+  EXPECT_DOUBLE_EQ(_value, parsed) << text;
+  EXPECT_EQ(text, formatDouble(parsed));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the formatting of doubles.
+TEST(RNDFWriter, FormatDouble)
+{
+  EXPECT_EQ(formatDouble(0), "0");
+  EXPECT_EQ(formatDouble(-0.0), "-0");
+  EXPECT_EQ(formatDouble(12), "12");
+  EXPECT_EQ(formatDouble(-3), "-3");
+  EXPECT_EQ(formatDouble(0.1), "0.1");
+  EXPECT_EQ(formatDouble(0.05), "0.05");
+  EXPECT_EQ(formatDouble(34.587489), "34.587489");
+  EXPECT_EQ(formatDouble(-117.367031), "-117.367031");
+  EXPECT_EQ(formatDouble(-0.000001), "-0.000001");
+  EXPECT_EQ(formatDouble(123456789.123456789), "123456789.12345679");
+
+  for (const double value : {0.0, -0.0, 0.1, 1.0 / 3.0, -2.0 / 3.0, 1e-7,
+    1.5e-300, 4.9e-324, 1e9, -1e21, 123456789.987654321, 34.587489,
+    -117.367031, 37.0123456789012, std::numeric_limits<double>::max(),
+    std::numeric_limits<double>::min()})
+  {
+    expectRoundTrip(value);
+  }
+
+  for (int i = 0; i < 100000; ++i)
+  {
+    expectRoundTrip(-90.0 + i * 0.0018000001);
+    expectRoundTrip(i * 1e-6);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that saving and loading the sample files produces the same
+/// RNDF, and that saving it again produces the same text.
+TEST(RNDFWriter, RoundTrip)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/RNDFWriter_TEST.rndf";
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    RNDF rndf;
+    ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/" + sample));
+
+    ASSERT_TRUE(rndf.Save(filePath));
+    RNDF saved;
+    ASSERT_TRUE(saved.Load(filePath));
+    EXPECT_TRUE(saved.Valid());
+    testing::expectEqualRNDF(rndf, saved);
+
+    std::ostringstream text;
+    ASSERT_TRUE(rndf.Save(text));
+    std::ostringstream savedText;
+    ASSERT_TRUE(saved.Save(savedText));
+    EXPECT_EQ(text.str(), savedText.str());
+
+    // The stream overload loads the same text.
+    std::istringstream input(text.str());
+    RNDF streamed;
+    ASSERT_TRUE(streamed.Load(input));
+    testing::expectEqualRNDF(rndf, streamed);
+  }
+
+  std::remove(filePath.c_str());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the text written for each element.
+TEST(RNDFWriter, Elements)
+{
+  Lane lane(2);
+  lane.SetWidth(12 * 0.3048);
+  lane.SetLeftBoundary(Marking::DOUBLE_YELLOW);
+  lane.Checkpoints().push_back(Checkpoint(7, 1));
+  lane.Stops().push_back(2);
+  lane.Exits().push_back(Exit(UniqueId(1, 2, 2), UniqueId(3, 1, 1)));
+  lane.Waypoints().push_back(Waypoint(1, 34.587489, -117.367031));
+  lane.Waypoints().push_back(Waypoint(2, 34.5875, -117.367));
+
+  std::ostringstream laneText;
+  ASSERT_TRUE(lane.Save(laneText, 1));
+  EXPECT_EQ(laneText.str(),
+    "lane\t1.2\n"
+    "num_waypoints\t2\n"
+    "lane_width\t12\n"
+    "left_boundary\tdouble_yellow\n"
+    "checkpoint\t1.2.1\t7\n"
+    "stop\t1.2.2\n"
+    "exit\t1.2.2\t3.1.1\n"
+    "1.2.1\t34.587489\t-117.367031\n"
+    "1.2.2\t34.5875\t-117.367\n"
+    "end_lane\n");
+
+  Segment segment(1);
+  segment.SetName("main_street");
+  segment.Lanes().push_back(lane);
+  std::ostringstream segmentText;
+  ASSERT_TRUE(segment.Save(segmentText));
+  EXPECT_EQ(segmentText.str(),
+    "segment\t1\n"
+    "num_lanes\t1\n"
+    "segment_name\tmain_street\n" + laneText.str() + "end_segment\n");
+
+  ParkingSpot spot(1);
+  spot.SetWidth(10 * 0.3048);
+  spot.Checkpoint() = Checkpoint(3, 2);
+  spot.Waypoints() = lane.Waypoints();
+  std::ostringstream spotText;
+  ASSERT_TRUE(spot.Save(spotText, 4));
+  EXPECT_EQ(spotText.str(),
+    "spot\t4.1\n"
+    "spot_width\t10\n"
+    "checkpoint\t4.1.2\t3\n"
+    "4.1.1\t34.587489\t-117.367031\n"
+    "4.1.2\t34.5875\t-117.367\n"
+    "end_spot\n");
+
+  Perimeter perimeter;
+  perimeter.Points() = lane.Waypoints();
+  perimeter.Exits().push_back(Exit(UniqueId(4, 0, 1), UniqueId(1, 2, 1)));
+  std::ostringstream perimeterText;
+  ASSERT_TRUE(perimeter.Save(perimeterText, 4));
+  EXPECT_EQ(perimeterText.str(),
+    "perimeter\t4.0\n"
+    "num_perimeterpoints\t2\n"
+    "exit\t4.0.1\t1.2.1\n"
+    "4.0.1\t34.587489\t-117.367031\n"
+    "4.0.2\t34.5875\t-117.367\n"
+    "end_perimeter\n");
+
+  Zone zone(4);
+  zone.Perimeter() = perimeter;
+  zone.Spots().push_back(spot);
+  std::ostringstream zoneText;
+  ASSERT_TRUE(zone.Save(zoneText));
+  EXPECT_EQ(zoneText.str(),
+    "zone\t4\n"
+    "num_spots\t1\n" + perimeterText.str() + spotText.str() +
+    "end_zone\n");
+}
+
+//////////////////////////////////////////////////
+/// \brief Check saving to a path that can't be created.
+TEST(RNDFWriter, SaveErrors)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  EXPECT_FALSE(rndf.Save(std::string(PROJECT_BINARY_PATH) +
+    "/missing_directory/RNDFWriter_TEST.rndf"));
+
+  // A stream in a bad state.
+  std::ostringstream text;
+  text.setstate(std::ios::badbit);
+  EXPECT_FALSE(rndf.Save(text));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -15,20 +15,42 @@
  *
 */
 
+#ifndef _WIN32
+  #include <unistd.h>
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <streambuf>
 #include <string>
-#include <vector>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
 
 #include "gtest/gtest.h"
 #include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Checkpoint.hh"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/Exit.hh"
 #include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LaneIndex.hh"
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/LocalCoordinates.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/ParserUtils.hh"
 #include "ignition/rndf/Perimeter.hh"
 #include "ignition/rndf/RNDF.hh"
 #include "ignition/rndf/RNDFNode.hh"
+#include "ignition/rndf/RoadGraph.hh"
 #include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/SpatialIndex.hh"
 #include "ignition/rndf/UniqueId.hh"
 #include "ignition/rndf/Waypoint.hh"
 #include "ignition/rndf/Zone.hh"
@@ -393,6 +415,676 @@ TEST(RNDF, loadSamples)
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Check move constructor and move assignment operator.
+TEST(RNDF, move)
+{
+  static_assert(std::is_nothrow_move_constructible<RNDF>::value &&
+    std::is_nothrow_move_assignable<RNDF>::value,
+    "RNDF should be nothrow movable");
+
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf1(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf1.Valid());
+  RNDFNode *node = rndf1.Info(rndf::UniqueId(1, 1, 1));
+  ASSERT_TRUE(node != nullptr);
+
+  // The nodes still point to the segments after the move.
+  RNDF rndf2(std::move(rndf1));
+  EXPECT_TRUE(rndf2.Valid());
+  EXPECT_EQ(rndf2.NumSegments(), 13u);
+  EXPECT_EQ(rndf2.Info(rndf::UniqueId(1, 1, 1)), node);
+  EXPECT_EQ(node->Segment(), &rndf2.Segments().at(0));
+
+  RNDF rndf3;
+  rndf3 = std::move(rndf2);
+  EXPECT_TRUE(rndf3.Valid());
+  EXPECT_EQ(rndf3.Info(rndf::UniqueId(1, 1, 1)), node);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that Info() finds every waypoint and only those.
+TEST(RNDF, info)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(1, 1, 1)), nullptr);
+  EXPECT_EQ(rndf.Info(rndf::UniqueId()), nullptr);
+
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample2.rndf"));
+  for (auto &segment : rndf.Segments())
+  {
+    for (auto &lane : segment.Lanes())
+    {
+      for (auto &wp : lane.Waypoints())
+      {
+        rndf::UniqueId id(segment.Id(), lane.Id(), wp.Id());
+        RNDFNode *nodeInfo = rndf.Info(id);
+        ASSERT_TRUE(nodeInfo != nullptr);
+        EXPECT_EQ(nodeInfo->UniqueId(), id);
+        EXPECT_EQ(nodeInfo->Segment(), &segment);
+        EXPECT_EQ(nodeInfo->Lane(), &lane);
+        EXPECT_EQ(nodeInfo->Waypoint(), &wp);
+      }
+
+      // One past the last waypoint of the lane.
+      rndf::UniqueId id(segment.Id(), lane.Id(),
+        static_cast<int>(lane.NumWaypoints()) + 1);
+      EXPECT_EQ(rndf.Info(id), nullptr);
+    }
+  }
+
+  // Loading again discards the waypoints of the previous RNDF.
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(68, 0, 20)), nullptr);
+  EXPECT_NE(rndf.Info(rndf::UniqueId(1, 1, 1)), nullptr);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that Info() follows the modifications of the RNDF and its
+/// nodes remain valid.
+TEST(RNDF, infoAfterChanges)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const RNDF &constRndf = rndf;
+  RNDFNode *node = rndf.Info(rndf::UniqueId(2, 1, 1));
+  ASSERT_TRUE(node != nullptr);
+
+  // Adding a segment may reallocate the segments.
+  Segment segment;
+  ASSERT_TRUE(rndf.Segment(2, segment));
+  segment.SetId(20);
+  ASSERT_TRUE(rndf.AddSegment(segment));
+  RNDFNode *added = rndf.Info(rndf::UniqueId(20, 1, 1));
+  ASSERT_TRUE(added != nullptr);
+  ASSERT_TRUE(added->Segment() != nullptr);
+  EXPECT_EQ(added->Segment()->Id(), 20);
+  EXPECT_EQ(added->Waypoint(),
+    &constRndf.Segments().back().Lanes().at(0).Waypoints().at(0));
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(2, 1, 1)), node);
+  EXPECT_EQ(node->Segment(), &constRndf.Segments().at(1));
+
+  // Removing a segment moves the following ones.
+  ASSERT_TRUE(rndf.RemoveSegment(1));
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(1, 1, 1)), nullptr);
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(2, 1, 1)), node);
+  EXPECT_EQ(node->Segment(), &constRndf.Segments().at(0));
+  EXPECT_EQ(node->Lane(), &constRndf.Segments().at(0).Lanes().at(0));
+  EXPECT_EQ(node->Zone(), nullptr);
+
+  // Update a lane.
+  Lane lane(constRndf.Segments().at(0).Lanes().at(0));
+  const int lastId = static_cast<int>(lane.NumWaypoints());
+  ASSERT_TRUE(rndf.Info(rndf::UniqueId(2, 1, lastId)) != nullptr);
+  ASSERT_TRUE(lane.RemoveWaypoint(lastId));
+  EXPECT_TRUE(rndf.UpdateLane(2, lane));
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(2, 1, lastId)), nullptr);
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(2, 1, 1)), node);
+  EXPECT_FALSE(rndf.UpdateLane(99, lane));
+  lane.SetId(99);
+  EXPECT_FALSE(rndf.UpdateLane(2, lane));
+
+  // Remove and add a zone.
+  rndf::Zone zone;
+  ASSERT_TRUE(rndf.Zone(14, zone));
+  RNDFNode *zoneNode = rndf.Info(rndf::UniqueId(14, 0, 1));
+  ASSERT_TRUE(zoneNode != nullptr);
+  ASSERT_TRUE(rndf.RemoveZone(14));
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(14, 0, 1)), nullptr);
+  EXPECT_EQ(zoneNode->Waypoint(), nullptr);
+  ASSERT_TRUE(rndf.AddZone(zone));
+  zoneNode = rndf.Info(rndf::UniqueId(14, 0, 1));
+  ASSERT_TRUE(zoneNode != nullptr);
+  ASSERT_TRUE(zoneNode->Zone() != nullptr);
+  EXPECT_EQ(zoneNode->Zone()->Id(), 14);
+  EXPECT_EQ(zoneNode->Waypoint(),
+    &constRndf.Zones().at(0).Perimeter().Points().at(0));
+  EXPECT_EQ(zoneNode->Segment(), nullptr);
+  EXPECT_EQ(zoneNode->Lane(), nullptr);
+  auto const &spot = constRndf.Zones().at(0).Spots().at(0);
+  RNDFNode *spotNode = rndf.Info(rndf::UniqueId(14, spot.Id(), 2));
+  ASSERT_TRUE(spotNode != nullptr);
+  EXPECT_EQ(spotNode->Waypoint(), &spot.Waypoints().at(1));
+
+  // Edits through the mutable accessors are picked up once they're
+  // recorded.
+  rndf.Segments().pop_back();
+  rndf.MarkModified(20);
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(20, 1, 1)), nullptr);
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(2, 1, 1)), node);
+  EXPECT_EQ(node->Segment(), &constRndf.Segments().at(0));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that Info() can be called from several threads after an
+/// edit in place.
+TEST(RNDF, infoConcurrent)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const RNDF &constRndf = rndf;
+  ASSERT_TRUE(rndf.Segment(2)->Lane(1)->RemoveWaypoint(1));
+  rndf.MarkModified(2);
+
+  std::vector<rndf::UniqueId> ids;
+  for (auto const &segment : constRndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      for (auto const &wp : lane.Waypoints())
+        ids.push_back(rndf::UniqueId(segment.Id(), lane.Id(), wp.Id()));
+    }
+  }
+
+  const int kNumThreads = 4;
+  std::vector<size_t> found(kNumThreads, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t)
+  {
+    threads.emplace_back([&constRndf, &ids, &found, t]()
+    {
+      for (auto const &id : ids)
+      {
+        RNDFNode *node = constRndf.Info(id);
+        if (node && node->Waypoint() && node->Waypoint()->Id() == id.Z())
+          ++found[t];
+      }
+      if (constRndf.Info(rndf::UniqueId(2, 1, 1)) != nullptr)
+        found[t] = 0;
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto const count : found)
+    EXPECT_EQ(count, ids.size());
+}
+
+//////////////////////////////////////////////////
+/// \brief Request the structures derived from a RNDF, in an order that
+/// depends on the thread.
+/// \param[in] _rndf The RNDF.
+/// \param[in] _thread Number of the thread.
+/// \param[out] _sizes Sizes of the structures.
+void requestDerived(const RNDF &_rndf, const int _thread,
+  std::vector<size_t> &_sizes)
+{
+  _sizes.assign(5, 0);
+  for (int i = 0; i < 5; ++i)
+  {
+    const int structure = (i + _thread) % 5;
+    switch (structure)
+    {
+      case 0:
+        _sizes[structure] = _rndf.Coordinates().Size();
+        break;
+      case 1:
+        _sizes[structure] = _rndf.SpatialIndex().Size();
+        break;
+      case 2:
+        _sizes[structure] = _rndf.LaneIndex().Size();
+        break;
+      case 3:
+        _sizes[structure] = _rndf.RoadGraph().NumEdges();
+        break;
+      default:
+        _sizes[structure] = _rndf.LocalCoordinates().Size();
+        break;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the derived structures can be requested from several
+/// threads at once on a freshly loaded RNDF, and after a modification.
+TEST(RNDF, derivedConcurrent)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  std::vector<size_t> expected;
+  {
+    RNDF reference(dirPath + "/test/rndf/sample1.rndf");
+    requestDerived(reference, 0, expected);
+  }
+  EXPECT_GT(expected[0], 0u);
+
+  const int kNumThreads = 8;
+  for (int round = 0; round < 2; ++round)
+  {
+    RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+    ASSERT_TRUE(rndf.Valid());
+    if (round == 1)
+    {
+      // Build everything and then move a waypoint.
+      std::vector<size_t> sizes;
+      requestDerived(rndf, 0, sizes);
+      rndf.Segment(1)->Lane(1)->Waypoints().at(0).SetLocation(1, 2);
+      rndf.MarkModified(1);
+    }
+
+    const RNDF &constRndf = rndf;
+    std::vector<std::vector<size_t>> sizes(kNumThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kNumThreads; ++t)
+    {
+      threads.emplace_back([&constRndf, &sizes, t]()
+      {
+        requestDerived(constRndf, t, sizes[t]);
+      });
+    }
+    for (auto &thread : threads)
+      thread.join();
+
+    for (auto const &threadSizes : sizes)
+      EXPECT_EQ(threadSizes, expected);
+    EXPECT_EQ(constRndf.Coordinates().Keys(),
+      CoordinateSnapshot(constRndf).Keys());
+    EXPECT_EQ(constRndf.LocalCoordinates().East(),
+      LocalCoordinates(CoordinateSnapshot(constRndf)).East());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the coordinate snapshot is reused until the RNDF
+/// changes.
+TEST(RNDF, coordinates)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  EXPECT_EQ(rndf.Coordinates().Size(), 0u);
+
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const RNDF &constRndf = rndf;
+  const CoordinateSnapshot &snapshot = constRndf.Coordinates();
+  EXPECT_EQ(snapshot.Size(), CoordinateSnapshot(rndf).Size());
+  EXPECT_GT(snapshot.Size(), 0u);
+  const double *latitudes = snapshot.Latitudes().data();
+
+  // Const access doesn't rebuild the snapshot.
+  EXPECT_EQ(constRndf.Segments().size(), 13u);
+  EXPECT_EQ(constRndf.Coordinates().Latitudes().data(), latitudes);
+
+  // Edits in place are picked up once they're recorded.
+  rndf.Segments().at(0).Lanes().at(0).Waypoints().at(0).SetLocation(1, 2);
+  EXPECT_EQ(constRndf.Coordinates().Latitudes().data(), latitudes);
+  rndf.MarkModified(1);
+  EXPECT_DOUBLE_EQ(constRndf.Coordinates().Latitudes()[0], 1.0);
+  EXPECT_DOUBLE_EQ(constRndf.Coordinates().Longitudes()[0], 2.0);
+
+  size_t numWaypoints = snapshot.Size();
+  ASSERT_TRUE(rndf.RemoveSegment(13));
+  EXPECT_LT(constRndf.Coordinates().Size(), numWaypoints);
+
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample2.rndf"));
+  EXPECT_EQ(constRndf.Coordinates().Size(), CoordinateSnapshot(rndf).Size());
+  EXPECT_NE(constRndf.Coordinates().Size(), numWaypoints);
+}
+
+//////////////////////////////////////////////////
+/// \brief Describe the waypoints of a RNDF.
+/// \param[in] _waypoints The waypoints.
+/// \param[out] _out Stream where the description is written.
+void describe(const std::vector<Waypoint> &_waypoints, std::ostream &_out)
+{
+  for (auto const &wp : _waypoints)
+  {
+    _out << " " << wp.Id() << "(" << wp.Latitude() << "," << wp.Longitude()
+         << "," << wp.IsEntry() << wp.IsExit() << ")";
+  }
+  _out << "\n";
+}
+
+//////////////////////////////////////////////////
+/// \brief Describe the exits of a lane or perimeter.
+/// \param[in] _exits The exits.
+/// \param[out] _out Stream where the description is written.
+void describe(const std::vector<Exit> &_exits, std::ostream &_out)
+{
+  for (auto const &exit : _exits)
+    _out << " " << exit.ExitId() << ">" << exit.EntryId();
+  _out << "\n";
+}
+
+//////////////////////////////////////////////////
+/// \brief Describe the content of a RNDF, so two RNDFs can be compared.
+/// \param[in] _rndf The RNDF.
+/// \return The description.
+std::string describe(const RNDF &_rndf)
+{
+  std::ostringstream out;
+  out.precision(17);
+  out << _rndf.Name() << " " << _rndf.Version() << " " << _rndf.Date() << "\n";
+  for (auto const &segment : _rndf.Segments())
+  {
+    out << "segment " << segment.Id() << " " << segment.Name() << "\n";
+    for (auto const &lane : segment.Lanes())
+    {
+      out << "lane " << lane.Id() << " " << lane.Width() << " "
+          << static_cast<int>(lane.LeftBoundary()) << " "
+          << static_cast<int>(lane.RightBoundary()) << "\n";
+      for (auto const &cp : lane.Checkpoints())
+        out << " " << cp.CheckpointId() << ":" << cp.WaypointId();
+      for (auto const &stop : lane.Stops())
+        out << " " << stop;
+      describe(lane.Exits(), out);
+      describe(lane.Waypoints(), out);
+    }
+  }
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    out << "zone " << zone.Id() << " " << zone.Name() << "\n";
+    describe(zone.Perimeter().Exits(), out);
+    describe(zone.Perimeter().Points(), out);
+    for (auto const &spot : zone.Spots())
+    {
+      out << "spot " << spot.Id() << " " << spot.Width() << " "
+          << spot.Checkpoint().CheckpointId() << "\n";
+      describe(spot.Waypoints(), out);
+    }
+  }
+  return out.str();
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that loading in parallel gives the same result as loading
+/// serially.
+TEST(RNDF, loadParallel)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    std::string filePath = dirPath + "/test/rndf/" + sample;
+    RNDF serial(filePath);
+    ASSERT_TRUE(serial.Valid());
+    const std::string expected = describe(serial);
+
+    for (unsigned int threads : {0u, 2u, 3u, 64u})
+    {
+      RNDF parallel;
+      EXPECT_TRUE(parallel.Load(filePath, threads));
+      EXPECT_TRUE(parallel.Valid());
+      EXPECT_EQ(describe(parallel), expected);
+
+      auto node = parallel.Info(rndf::UniqueId(1, 1, 1));
+      ASSERT_TRUE(node != nullptr);
+      EXPECT_EQ(node->Segment(), &parallel.Segments().at(0));
+    }
+  }
+
+  // Streams are loaded serially.
+  {
+    std::ifstream file(dirPath + "/test/rndf/sample1.rndf");
+    LineReader reader(file);
+    RNDF rndf;
+    EXPECT_TRUE(rndf.Load(reader, 4));
+    EXPECT_TRUE(rndf.Valid());
+  }
+
+  // Errors are reported with the same line numbers as in a serial load.
+  const std::vector<std::string> invalid =
+  {
+    // Non-consecutive segment Id.
+    "RNDF_name roadA\nnum_segments 2\nnum_zones 0\n"
+    "segment 1\nnum_lanes 1\nlane 1.1\nnum_waypoints 1\n"
+    "1.1.1 1.0 2.0\nend_lane\nend_segment\n\n"
+    "segment 3\nnum_lanes 1\nlane 3.1\nnum_waypoints 1\n"
+    "3.1.1 1.0 2.0\nend_lane\nend_segment\nend_file\n",
+
+    // Error inside the second segment.
+    "RNDF_name roadA\nnum_segments 2\nnum_zones 0\n"
+    "segment 1\nnum_lanes 1\nlane 1.1\nnum_waypoints 1\n"
+    "1.1.1 1.0 2.0\nend_lane\nend_segment\n/* comment */\n"
+    "segment 2\nnum_lanes 1\nlane 2.1\nnum_waypoints 1\n"
+    "2.1.1 1.0 x\nend_lane\nend_segment\nend_file\n",
+
+    // Non-existent entry.
+    "RNDF_name roadA\nnum_segments 2\nnum_zones 0\n"
+    "segment 1\nnum_lanes 1\nlane 1.1\nnum_waypoints 1\n"
+    "exit 1.1.1 2.1.2\n1.1.1 1.0 2.0\nend_lane\nend_segment\n"
+    "segment 2\nnum_lanes 1\nlane 2.1\nnum_waypoints 1\n"
+    "2.1.1 1.0 2.0\nend_lane\nend_segment\nend_file\n",
+
+    // Missing "end_file".
+    "RNDF_name roadA\nnum_segments 1\nnum_zones 0\n"
+    "segment 1\nnum_lanes 1\nlane 1.1\nnum_waypoints 1\n"
+    "1.1.1 1.0 2.0\nend_lane\nend_segment\nend_zone\n",
+
+    // Truncated content.
+    "RNDF_name roadA\nnum_segments 1\nnum_zones 0\n"
+    "segment 1\nnum_lanes 1\nlane 1.1\nnum_waypoints 1\n"
+    "1.1.1 1.0 2.0\nend_lane\nend_segment\n",
+
+    // Truncated inside a lane.
+    "RNDF_name roadA\nnum_segments 2\nnum_zones 0\n"
+    "segment 1\nnum_lanes 1\nlane 1.1\nnum_waypoints 1\n"
+    "1.1.1 1.0 2.0\nend_lane\nend_segment\n"
+    "segment 2\nnum_lanes 1\nlane 2.1\nnum_waypoints 1\n"
+    "2.1.1 1.0 2.0\n",
+  };
+
+  for (auto const &content : invalid)
+  {
+    std::ostringstream serialErrors;
+    std::ostringstream parallelErrors;
+    auto cerrBuf = std::cerr.rdbuf(serialErrors.rdbuf());
+    {
+      LineReader reader(content.data(), content.size());
+      RNDF rndf;
+      EXPECT_FALSE(rndf.Load(reader, 1));
+    }
+    std::cerr.rdbuf(parallelErrors.rdbuf());
+    {
+      LineReader reader(content.data(), content.size());
+      RNDF rndf;
+      EXPECT_FALSE(rndf.Load(reader, 2));
+    }
+    std::cerr.rdbuf(cerrBuf);
+
+    EXPECT_FALSE(serialErrors.str().empty());
+    EXPECT_EQ(parallelErrors.str(), serialErrors.str());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a parallel load with several invalid blocks reports
+/// only the errors of the first one, as a serial load does.
+TEST(RNDF, loadParallelTwoInvalidBlocks)
+{
+  const int kNumSegments = 16;
+  std::string content = "RNDF_name roadA\nnum_segments " +
+    std::to_string(kNumSegments) + "\nnum_zones 0\n";
+  for (int i = 1; i <= kNumSegments; ++i)
+  {
+    const std::string id = std::to_string(i);
+    const std::string latitude = (i == 5 || i == 12) ? "x" : "1.0";
+    content += "segment " + id + "\nnum_lanes 1\nlane " + id +
+      ".1\nnum_waypoints 1\n" + id + ".1.1 " + latitude +
+      " 2.0\nend_lane\nend_segment\n";
+  }
+  content += "end_file\n";
+
+  std::ostringstream serialErrors;
+  auto cerrBuf = std::cerr.rdbuf(serialErrors.rdbuf());
+  {
+    LineReader reader(content.data(), content.size());
+    RNDF rndf;
+    EXPECT_FALSE(rndf.Load(reader, 1));
+  }
+  std::cerr.rdbuf(cerrBuf);
+  EXPECT_NE(serialErrors.str().find("5.1.1 x"), std::string::npos);
+  EXPECT_EQ(serialErrors.str().find("12.1.1 x"), std::string::npos);
+
+  for (unsigned int numThreads = 2; numThreads <= 8; numThreads *= 2)
+  {
+    for (int i = 0; i < 10; ++i)
+    {
+      std::ostringstream parallelErrors;
+      cerrBuf = std::cerr.rdbuf(parallelErrors.rdbuf());
+      {
+        LineReader reader(content.data(), content.size());
+        RNDF rndf;
+        EXPECT_FALSE(rndf.Load(reader, numThreads));
+      }
+      std::cerr.rdbuf(cerrBuf);
+      EXPECT_EQ(parallelErrors.str(), serialErrors.str());
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief A stream buffer that can't be rewound, like a pipe.
+class ForwardOnlyBuf : public std::streambuf
+{
+  /// \brief Constructor.
+  /// \param[in] _content Content to serve.
+  public: explicit ForwardOnlyBuf(const std::string &_content)
+    : content(_content)
+  {
+    char *data = &this->content[0];
+    this->setg(data, data, data + this->content.size());
+  }
+
+  /// \brief The content served.
+  private: std::string content;
+};
+
+//////////////////////////////////////////////////
+/// \brief Check loading RNDFs from streams that can't be rewound.
+TEST(RNDF, loadStream)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    std::string filePath = dirPath + "/test/rndf/" + sample;
+    std::ifstream file(filePath);
+    std::stringstream content;
+    content << file.rdbuf();
+
+    ForwardOnlyBuf buf(content.str());
+    std::istream stream(&buf);
+
+    RNDF fromStream;
+    EXPECT_TRUE(fromStream.Load(stream));
+    EXPECT_TRUE(fromStream.Valid());
+
+    RNDF fromFile(filePath);
+    EXPECT_EQ(fromStream.Name(), fromFile.Name());
+    EXPECT_EQ(fromStream.NumSegments(), fromFile.NumSegments());
+    EXPECT_EQ(fromStream.NumZones(), fromFile.NumZones());
+  }
+
+  {
+    ForwardOnlyBuf buf("RNDF_name roadA\nnum_segments 1\n");
+    std::istream stream(&buf);
+    RNDF rndf;
+    EXPECT_FALSE(rndf.Load(stream));
+    EXPECT_FALSE(rndf.Valid());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the errors found while loading go to the stream of
+/// the current ErrorCapture.
+TEST(RNDF, loadErrors)
+{
+  const std::string segment =
+    "segment 2\n"
+    "num_lanes 1\n"
+    "lane 2.1\n"
+    "num_waypoints 2\n"
+    "2.1.1 34.5 -117.3\n"
+    "2.1.2 34.6 -117.3\n"
+    "end_lane\n"
+    "end_segment\n"
+    "end_file\n";
+
+  {
+    std::istringstream stream(
+      "RNDF_name roadA\n"
+      "num_segments 1\n"
+      "num_zones 0\n" + segment);
+    std::ostringstream errors;
+    ErrorCapture capture(errors);
+    RNDF rndf;
+    EXPECT_FALSE(rndf.Load(stream));
+    EXPECT_NE(errors.str().find("Found non-consecutive segment Id [2]"),
+      std::string::npos) << errors.str();
+  }
+
+  {
+    std::istringstream stream(
+      "RNDF_name roadA\n"
+      "num_segments 1\n"
+      "num_zones 0\n"
+      "format_version 1.0\n"
+      "format_version 1.1\n" + segment);
+    std::ostringstream errors;
+    ErrorCapture capture(errors);
+    RNDF rndf;
+    EXPECT_FALSE(rndf.Load(stream));
+    EXPECT_NE(errors.str().find("Unable to parse file header element"),
+      std::string::npos) << errors.str();
+  }
+}
+
+#ifndef _WIN32
+//////////////////////////////////////////////////
+/// \brief Check loading RNDFs from pipes, which can't be mapped.
+TEST(RNDF, loadPipe)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  const std::string filePath = dirPath + "/test/rndf/sample1.rndf";
+  std::ifstream file(filePath);
+  std::stringstream stream;
+  stream << file.rdbuf();
+  const std::string content = stream.str();
+  const RNDF expected(filePath);
+  ASSERT_TRUE(expected.Valid());
+
+  for (auto const numThreads : {1u, 4u})
+  {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    std::thread writer([&]()
+    {
+      size_t written = 0;
+      while (written < content.size())
+      {
+        const ssize_t bytes = write(fds[1], content.data() + written,
+          content.size() - written);
+        if (bytes <= 0)
+          break;
+        written += static_cast<size_t>(bytes);
+      }
+      close(fds[1]);
+    });
+
+    RNDF rndf;
+    EXPECT_TRUE(rndf.Load("/dev/fd/" + std::to_string(fds[0]), numThreads));
+    writer.join();
+    close(fds[0]);
+
+    EXPECT_TRUE(rndf.Valid());
+    EXPECT_EQ(rndf.Name(), expected.Name());
+    ASSERT_EQ(rndf.NumSegments(), expected.NumSegments());
+    ASSERT_EQ(rndf.NumZones(), expected.NumZones());
+    for (size_t i = 0; i < expected.NumSegments(); ++i)
+    {
+      ASSERT_EQ(rndf.Segments()[i].NumLanes(),
+        expected.Segments()[i].NumLanes());
+      for (size_t j = 0; j < expected.Segments()[i].NumLanes(); ++j)
+      {
+        EXPECT_EQ(rndf.Segments()[i].Lanes()[j].Waypoints(),
+          expected.Segments()[i].Lanes()[j].Waypoints());
+      }
+    }
+  }
+}
+#endif
+
 //////////////////////////////////////////////////
 /// \brief Check loading specific RNDF blocks from files.
 TEST_F(RNDFTest, load)
@@ -1199,6 +1891,256 @@ TEST_F(RNDFTest, load)
   }
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the modifications reported since a revision.
+TEST(RNDF, changes)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  std::vector<int> ids;
+  bool sameLayout;
+  EXPECT_EQ(rndf.Revision(), 0u);
+  EXPECT_TRUE(rndf.Changes(0, ids, sameLayout));
+  EXPECT_TRUE(ids.empty());
+
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const uint64_t loaded = rndf.Revision();
+  EXPECT_GT(loaded, 0u);
+  EXPECT_FALSE(rndf.Changes(0, ids, sameLayout));
+  EXPECT_TRUE(rndf.Changes(loaded, ids, sameLayout));
+  EXPECT_TRUE(ids.empty());
+  EXPECT_TRUE(sameLayout);
+  EXPECT_FALSE(rndf.Changes(loaded + 1, ids, sameLayout));
+
+  // Moving waypoints keeps the layout.
+  const RNDF &constRndf = rndf;
+  Segment segment(constRndf.Segments().at(4));
+  segment.Lanes().at(0).Waypoints().at(0).SetLocation(1, 2);
+  ASSERT_TRUE(rndf.UpdateSegment(segment));
+  Lane lane(constRndf.Segments().at(1).Lanes().at(0));
+  lane.Waypoints().at(0).SetLocation(3, 4);
+  ASSERT_TRUE(rndf.UpdateLane(2, lane));
+  ASSERT_TRUE(rndf.UpdateLane(2, lane));
+  EXPECT_EQ(rndf.Revision(), loaded + 3);
+  EXPECT_TRUE(rndf.Changes(loaded, ids, sameLayout));
+  EXPECT_EQ(ids, std::vector<int>({2, 5}));
+  EXPECT_TRUE(sameLayout);
+  EXPECT_TRUE(rndf.Changes(loaded + 1, ids, sameLayout));
+  EXPECT_EQ(ids, std::vector<int>({2}));
+
+  // Failed modifications aren't reported.
+  EXPECT_FALSE(rndf.RemoveSegment(99));
+  EXPECT_FALSE(rndf.UpdateLane(99, lane));
+  EXPECT_EQ(rndf.Revision(), loaded + 3);
+
+  // Removing waypoints changes the layout.
+  const uint64_t moved = rndf.Revision();
+  ASSERT_TRUE(segment.Lanes().at(0).RemoveWaypoint(2));
+  ASSERT_TRUE(rndf.UpdateSegment(segment));
+  ASSERT_TRUE(rndf.RemoveZone(14));
+  EXPECT_TRUE(rndf.Changes(moved, ids, sameLayout));
+  EXPECT_EQ(ids, std::vector<int>({5, 14}));
+  EXPECT_FALSE(sameLayout);
+
+  // Getting the mutable accessors isn't a modification.
+  rndf.Segments();
+  rndf.Zones();
+  EXPECT_EQ(rndf.Segment(1), &constRndf.Segments().at(0));
+  EXPECT_TRUE(rndf.Changes(moved, ids, sameLayout));
+  EXPECT_EQ(ids, std::vector<int>({5, 14}));
+
+  // Edits in place are recorded explicitly.
+  rndf.MarkModified(3);
+  EXPECT_TRUE(rndf.Changes(moved, ids, sameLayout));
+  EXPECT_EQ(ids, std::vector<int>({3, 5, 14}));
+  EXPECT_FALSE(sameLayout);
+
+  // Any segment or zone may have changed.
+  rndf.MarkModified();
+  EXPECT_FALSE(rndf.Changes(moved, ids, sameLayout));
+  EXPECT_TRUE(rndf.Changes(rndf.Revision(), ids, sameLayout));
+
+  // Only the most recent modifications are remembered.
+  const uint64_t first = rndf.Revision();
+  for (int i = 0; i < 5000; ++i)
+    ASSERT_TRUE(rndf.UpdateLane(2, lane));
+  EXPECT_FALSE(rndf.Changes(first, ids, sameLayout));
+  EXPECT_TRUE(rndf.Changes(rndf.Revision() - 100, ids, sameLayout));
+  EXPECT_EQ(ids, std::vector<int>({2}));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that Info() is updated by UpdateSegment() and UpdateZone().
+TEST(RNDF, infoAfterUpdates)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const RNDF &constRndf = rndf;
+  RNDFNode *node = rndf.Info(rndf::UniqueId(4, 1, 1));
+  ASSERT_TRUE(node != nullptr);
+
+  Segment segment(constRndf.Segments().at(3));
+  const int numWaypoints =
+    static_cast<int>(segment.Lanes().at(0).NumWaypoints());
+  ASSERT_TRUE(segment.Lanes().at(0).RemoveWaypoint(numWaypoints));
+  ASSERT_TRUE(segment.RemoveLane(2));
+  ASSERT_TRUE(rndf.UpdateSegment(segment));
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(4, 1, 1)), node);
+  EXPECT_EQ(node->Waypoint(),
+    &constRndf.Segments().at(3).Lanes().at(0).Waypoints().at(0));
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(4, 1, numWaypoints)), nullptr);
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(4, 2, 1)), nullptr);
+
+  rndf::Zone zone(constRndf.Zones().at(0));
+  const int spotId = zone.Spots().at(0).Id();
+  zone.Spots().erase(zone.Spots().begin());
+  ASSERT_TRUE(rndf.UpdateZone(zone));
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(14, spotId, 1)), nullptr);
+  RNDFNode *zoneNode = rndf.Info(rndf::UniqueId(14, 0, 1));
+  ASSERT_TRUE(zoneNode != nullptr);
+  EXPECT_EQ(zoneNode->Zone(), &constRndf.Zones().at(0));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that updating a segment, a lane or a zone with the stored
+/// element itself keeps it intact.
+TEST(RNDF, selfUpdates)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const RNDF &constRndf = rndf;
+  RNDFNode *node = rndf.Info(rndf::UniqueId(4, 1, 1));
+  ASSERT_TRUE(node != nullptr);
+
+  const Segment segment(constRndf.Segments().at(3));
+  EXPECT_TRUE(rndf.UpdateSegment(rndf.Segments().at(3)));
+  EXPECT_TRUE(rndf.UpdateSegment(*rndf.Segment(4)));
+  EXPECT_EQ(constRndf.Segments().at(3).Id(), 4);
+  EXPECT_TRUE(constRndf.Segments().at(3).Valid());
+  EXPECT_EQ(constRndf.Segments().at(3).NumLanes(), segment.NumLanes());
+  EXPECT_EQ(constRndf.Segments().at(3).Name(), segment.Name());
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(4, 1, 1)), node);
+
+  const rndf::Zone zone(constRndf.Zones().at(0));
+  EXPECT_TRUE(rndf.UpdateZone(rndf.Zones().at(0)));
+  EXPECT_TRUE(rndf.UpdateZone(*rndf.Zone(14)));
+  EXPECT_EQ(constRndf.Zones().at(0).Id(), 14);
+  EXPECT_TRUE(constRndf.Zones().at(0).Valid());
+  EXPECT_EQ(constRndf.Zones().at(0).NumSpots(), zone.NumSpots());
+  EXPECT_EQ(constRndf.Zones().at(0).Perimeter().NumPoints(),
+    zone.Perimeter().NumPoints());
+  EXPECT_TRUE(rndf.Valid());
+
+  const Lane lane(constRndf.Segments().at(3).Lanes().at(0));
+  EXPECT_TRUE(rndf.UpdateLane(4, *rndf.Segment(4)->Lane(1)));
+  const Lane *updated = constRndf.Segment(4)->Lane(1);
+  ASSERT_TRUE(updated != nullptr);
+  EXPECT_TRUE(updated->Valid());
+  EXPECT_EQ(updated->NumWaypoints(), lane.NumWaypoints());
+  EXPECT_EQ(updated->Exits().size(), lane.Exits().size());
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(4, 1, 1)), node);
+  EXPECT_EQ(node->Waypoint(), &updated->Waypoints().at(0));
+  EXPECT_TRUE(rndf.Valid());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the accessors of segments and zones by Id that don't copy
+/// them.
+TEST(RNDF, byId)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const RNDF &constRndf = rndf;
+  EXPECT_EQ(constRndf.Segment(3), &constRndf.Segments().at(2));
+  EXPECT_EQ(constRndf.Zone(14), &constRndf.Zones().at(0));
+  EXPECT_EQ(constRndf.Segment(99), nullptr);
+  EXPECT_EQ(constRndf.Zone(0), nullptr);
+
+  // Looking up a missing element isn't a modification.
+  const uint64_t revision = rndf.Revision();
+  EXPECT_EQ(rndf.Segment(99), nullptr);
+  EXPECT_EQ(rndf.Zone(99), nullptr);
+  EXPECT_EQ(rndf.Revision(), revision);
+  ASSERT_TRUE(rndf.Info(rndf::UniqueId(3, 1, 1)) != nullptr);
+
+  // Edit a segment and a zone in place.
+  rndf::Segment *segment = rndf.Segment(3);
+  ASSERT_TRUE(segment != nullptr);
+  ASSERT_TRUE(segment->Lane(1) != nullptr);
+  EXPECT_TRUE(segment->Lane(1)->RemoveWaypoint(1));
+  rndf::Zone *zone = rndf.Zone(14);
+  ASSERT_TRUE(zone != nullptr);
+  ASSERT_TRUE(zone->Perimeter().Point(1) != nullptr);
+  zone->Perimeter().Point(1)->SetLocation(1, 2);
+  EXPECT_EQ(rndf.Revision(), revision);
+  rndf.MarkModified(3);
+  rndf.MarkModified(14);
+
+  std::vector<int> ids;
+  bool sameLayout;
+  EXPECT_TRUE(rndf.Changes(revision, ids, sameLayout));
+  EXPECT_EQ(ids, std::vector<int>({3, 14}));
+  EXPECT_FALSE(sameLayout);
+
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(3, 1, 1)), nullptr);
+  RNDFNode *node = rndf.Info(rndf::UniqueId(14, 0, 1));
+  ASSERT_TRUE(node != nullptr);
+  EXPECT_DOUBLE_EQ(node->Waypoint()->Latitude(), 1);
+  EXPECT_EQ(rndf.Coordinates().Keys(), CoordinateSnapshot(rndf).Keys());
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that an edit through the mutable accessors, once recorded
+/// with MarkModified(), is seen by Info() and by the spatial and lane
+/// indices.
+TEST(RNDF, accessorEdits)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(dirPath + "/test/rndf/sample1.rndf"));
+  const double latitude = 38.874445;
+  const double longitude = -77.15;
+  const rndf::UniqueId movedId(3, 1, 2);
+  rndf::UniqueId id;
+  double distance;
+  ASSERT_TRUE(rndf.SpatialIndex().Nearest(latitude, longitude, id, distance));
+  EXPECT_GT(distance, 100);
+
+  // Move a waypoint and remove the last one of the same lane.
+  rndf::Segment *segment = rndf.Segment(3);
+  ASSERT_TRUE(segment != nullptr);
+  rndf::Lane *lane = segment->Lane(1);
+  ASSERT_TRUE(lane != nullptr);
+  const int lastId = static_cast<int>(lane->NumWaypoints());
+  const rndf::Waypoint last = lane->Waypoints().back();
+  ASSERT_TRUE(lane->Waypoint(2) != nullptr);
+  lane->Waypoint(2)->SetLocation(latitude, longitude);
+  ASSERT_TRUE(lane->RemoveWaypoint(lastId));
+  rndf.MarkModified(3);
+
+  RNDFNode *node = rndf.Info(movedId);
+  ASSERT_TRUE(node != nullptr);
+  EXPECT_DOUBLE_EQ(node->Waypoint()->Latitude(), latitude);
+  EXPECT_DOUBLE_EQ(node->Waypoint()->Longitude(), longitude);
+  EXPECT_EQ(rndf.Info(rndf::UniqueId(3, 1, lastId)), nullptr);
+
+  ASSERT_TRUE(rndf.SpatialIndex().Nearest(latitude, longitude, id, distance));
+  EXPECT_EQ(id, movedId);
+  EXPECT_LT(distance, 1e-3);
+  ASSERT_TRUE(rndf.SpatialIndex().Nearest(last.Latitude(), last.Longitude(),
+    id));
+  EXPECT_NE(id, rndf::UniqueId(3, 1, lastId));
+
+  LaneProjection projection;
+  ASSERT_TRUE(rndf.LaneIndex().Project(latitude, longitude, projection));
+  EXPECT_EQ(projection.segmentId, 3);
+  EXPECT_EQ(projection.laneId, 1);
+  EXPECT_LT(std::abs(projection.lateralOffset), 1e-3);
+}
+
 //////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <ignition/math/Angle.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/SphericalCoordinates.hh>
+
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for RoadGraph class.
+    class RoadGraphPrivate
+    {
+      /// \brief Find the node of a waypoint.
+      /// \param[in] _key Unique Id key of the waypoint.
+      /// \param[out] _node The node.
+      /// \return True if the waypoint was found.
+      public: bool Find(const uint64_t _key, uint32_t &_node) const
+      {
+        auto it = std::lower_bound(this->lookup.begin(), this->lookup.end(),
+          std::make_pair(_key, static_cast<uint32_t>(0)));
+        if (it == this->lookup.end() || it->first != _key)
+          return false;
+
+        _node = it->second;
+        return true;
+      }
+
+      /// \brief Append the edges of the exits of a lane or perimeter.
+      /// \param[in] _exits The exits.
+      /// \param[in, out] _edges The edges, as (source, target) pairs.
+      /// \param[in, out] _gates Whether every node is the exit or the entry
+      /// of an edge appended.
+      public: void AppendExits(const std::vector<Exit> &_exits,
+        std::vector<std::pair<uint32_t, uint32_t>> &_edges,
+        std::vector<bool> &_gates) const
+      {
+        for (auto const &exit : _exits)
+        {
+          uint32_t source;
+          uint32_t target;
+          if (this->Find(exit.ExitId().Key(), source) &&
+              this->Find(exit.EntryId().Key(), target))
+          {
+            _edges.emplace_back(source, target);
+            _gates[source] = true;
+            _gates[target] = true;
+          }
+        }
+      }
+
+      /// \brief Compute the length of an edge.
+      /// \param[in] _source Source node.
+      /// \param[in] _target Target node.
+      /// \return The length in meters.
+      public: double Length(const uint32_t _source,
+                            const uint32_t _target) const
+      {
+        return math::SphericalCoordinates::Distance(
+          math::Angle(IGN_DTOR(this->latitudes[_source])),
+          math::Angle(IGN_DTOR(this->longitudes[_source])),
+          math::Angle(IGN_DTOR(this->latitudes[_target])),
+          math::Angle(IGN_DTOR(this->longitudes[_target])));
+      }
+
+      /// \brief Build the incoming edges of every node, if needed.
+      public: void BuildIncoming()
+      {
+        if (!this->incomingOffsets.empty() || this->offsets.empty())
+          return;
+
+        const size_t numNodes = this->keys.size();
+        this->incomingOffsets.assign(numNodes + 1, 0);
+        for (auto const target : this->targets)
+          ++this->incomingOffsets[target + 1];
+        for (size_t i = 0; i < numNodes; ++i)
+          this->incomingOffsets[i + 1] += this->incomingOffsets[i];
+
+        this->incoming.resize(this->targets.size());
+        std::vector<uint32_t> next(this->incomingOffsets.begin(),
+          this->incomingOffsets.begin() + numNodes);
+        for (uint32_t e = 0; e < this->targets.size(); ++e)
+          this->incoming[next[this->targets[e]]++] = e;
+
+        // Source node of every edge.
+        this->sources.resize(this->targets.size());
+        for (uint32_t i = 0; i < numNodes; ++i)
+        {
+          for (uint32_t e = this->offsets[i]; e < this->offsets[i + 1]; ++e)
+            this->sources[e] = i;
+        }
+      }
+
+      /// \brief Unique Id keys of the nodes.
+      public: std::vector<uint64_t> keys;
+
+      /// \brief Latitudes of the nodes in degrees.
+      public: std::vector<double> latitudes;
+
+      /// \brief Longitudes of the nodes in degrees.
+      public: std::vector<double> longitudes;
+
+      /// \brief Position of the first outgoing edge of every node.
+      public: std::vector<uint32_t> offsets;
+
+      /// \brief Target node of every edge.
+      public: std::vector<uint32_t> targets;
+
+      /// \brief Length of every edge in meters.
+      public: std::vector<double> lengths;
+
+      /// \brief (key, node) pairs sorted by key, to find nodes by Id.
+      public: std::vector<std::pair<uint64_t, uint32_t>> lookup;
+
+      /// \brief Position in "incoming" of the first incoming edge of every
+      /// node. Built on the first partial update.
+      public: std::vector<uint32_t> incomingOffsets;
+
+      /// \brief Incoming edges of every node.
+      public: std::vector<uint32_t> incoming;
+
+      /// \brief Source node of every edge.
+      public: std::vector<uint32_t> sources;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+RoadGraph::RoadGraph()
+  : dataPtr(new RoadGraphPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+RoadGraph::RoadGraph(const RNDF &_rndf)
+  : RoadGraph()
+{
+  this->Update(_rndf);
+}
+
+//////////////////////////////////////////////////
+RoadGraph::RoadGraph(const RoadGraph &_other)
+  : RoadGraph()
+{
+  *this = _other;
+}
+
+//////////////////////////////////////////////////
+RoadGraph::~RoadGraph()
+{
+}
+
+//////////////////////////////////////////////////
+void RoadGraph::Update(const RNDF &_rndf)
+{
+  RoadGraphPrivate &data = *this->dataPtr;
+  const CoordinateSnapshot &coordinates = _rndf.Coordinates();
+  const std::vector<CoordinateRange> &ranges = coordinates.Ranges();
+  const uint32_t numNodes = static_cast<uint32_t>(coordinates.Size());
+
+  data.keys = coordinates.Keys();
+  data.latitudes = coordinates.Latitudes();
+  data.longitudes = coordinates.Longitudes();
+
+  data.lookup.resize(numNodes);
+  for (uint32_t i = 0; i < numNodes; ++i)
+    data.lookup[i] = std::make_pair(data.keys[i], i);
+  std::sort(data.lookup.begin(), data.lookup.end());
+
+  // Collect the edges in a single pass over the model. The ranges of the
+  // snapshot are in the same order as the lanes, perimeters and spots.
+  std::vector<std::pair<uint32_t, uint32_t>> edges;
+  edges.reserve(numNodes + numNodes / 8);
+  std::vector<bool> gates(numNodes, false);
+  size_t r = 0;
+  for (auto const &segment : _rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      const CoordinateRange &range = ranges[r++];
+      for (uint32_t i = range.begin; i + 1 < range.end; ++i)
+        edges.emplace_back(i, i + 1);
+      data.AppendExits(lane.Exits(), edges, gates);
+    }
+  }
+
+  // The entries of a zone are only known once the exits of all the lanes
+  // and perimeters are.
+  for (auto const &zone : _rndf.Zones())
+    data.AppendExits(zone.Perimeter().Exits(), edges, gates);
+
+  std::vector<uint32_t> access;
+  std::vector<uint32_t> zoneGates;
+  for (auto const &zone : _rndf.Zones())
+  {
+    const CoordinateRange &perimeter = ranges[r++];
+
+    // Vehicles can drive freely inside a zone, between the perimeter and
+    // the entrance of the parking spots. Connecting all of them to each
+    // other would take a quadratic number of edges in large parking lots,
+    // so they are connected to and from the gates of the zone instead: the
+    // perimeter points with an exit or an entry, which are few.
+    access.clear();
+    zoneGates.clear();
+    for (uint32_t i = perimeter.begin; i < perimeter.end; ++i)
+    {
+      access.push_back(i);
+      if (gates[i])
+        zoneGates.push_back(i);
+    }
+    for (size_t s = 0; s < zone.NumSpots(); ++s)
+    {
+      const CoordinateRange &spot = ranges[r++];
+      if (spot.begin < spot.end)
+        access.push_back(spot.begin);
+      for (uint32_t i = spot.begin; i + 1 < spot.end; ++i)
+      {
+        edges.emplace_back(i, i + 1);
+        edges.emplace_back(i + 1, i);
+      }
+    }
+
+    // A zone without gates is still connected inside.
+    if (zoneGates.empty() && !access.empty())
+      zoneGates.push_back(access.front());
+
+    for (auto const gate : zoneGates)
+    {
+      for (auto const node : access)
+      {
+        if (node == gate)
+          continue;
+
+        edges.emplace_back(gate, node);
+        if (std::find(zoneGates.begin(), zoneGates.end(), node) ==
+            zoneGates.end())
+        {
+          edges.emplace_back(node, gate);
+        }
+      }
+    }
+  }
+
+  // Counting sort of the edges by source node.
+  data.offsets.assign(numNodes > 0 ? numNodes + 1 : 0, 0);
+  for (auto const &edge : edges)
+    ++data.offsets[edge.first + 1];
+  for (uint32_t i = 0; i < numNodes; ++i)
+    data.offsets[i + 1] += data.offsets[i];
+
+  data.targets.resize(edges.size());
+  data.lengths.resize(edges.size());
+  std::vector<uint32_t> next(data.offsets.begin(),
+    data.offsets.begin() + numNodes);
+  for (auto const &edge : edges)
+  {
+    const uint32_t e = next[edge.first]++;
+    data.targets[e] = edge.second;
+    data.lengths[e] = data.Length(edge.first, edge.second);
+  }
+
+  data.incomingOffsets.clear();
+  data.incoming.clear();
+  data.sources.clear();
+}
+
+//////////////////////////////////////////////////
+void RoadGraph::Update(const CoordinateSnapshot &_coordinates,
+  const std::vector<uint32_t> &_moved)
+{
+  RoadGraphPrivate &data = *this->dataPtr;
+  for (auto const node : _moved)
+  {
+    data.latitudes[node] = _coordinates.Latitudes()[node];
+    data.longitudes[node] = _coordinates.Longitudes()[node];
+  }
+
+  data.BuildIncoming();
+  for (auto const node : _moved)
+  {
+    for (uint32_t e = data.offsets[node]; e < data.offsets[node + 1]; ++e)
+      data.lengths[e] = data.Length(node, data.targets[e]);
+    for (uint32_t i = data.incomingOffsets[node];
+         i < data.incomingOffsets[node + 1]; ++i)
+    {
+      const uint32_t e = data.incoming[i];
+      data.lengths[e] = data.Length(data.sources[e], node);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+size_t RoadGraph::NumNodes() const
+{
+  return this->dataPtr->keys.size();
+}
+
+//////////////////////////////////////////////////
+size_t RoadGraph::NumEdges() const
+{
+  return this->dataPtr->targets.size();
+}
+
+//////////////////////////////////////////////////
+bool RoadGraph::Node(const UniqueId &_id, uint32_t &_node) const
+{
+  return this->dataPtr->Find(_id.Key(), _node);
+}
+
+//////////////////////////////////////////////////
+const std::vector<uint64_t> &RoadGraph::Keys() const
+{
+  return this->dataPtr->keys;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &RoadGraph::Latitudes() const
+{
+  return this->dataPtr->latitudes;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &RoadGraph::Longitudes() const
+{
+  return this->dataPtr->longitudes;
+}
+
+//////////////////////////////////////////////////
+const std::vector<uint32_t> &RoadGraph::Offsets() const
+{
+  return this->dataPtr->offsets;
+}
+
+//////////////////////////////////////////////////
+const std::vector<uint32_t> &RoadGraph::Targets() const
+{
+  return this->dataPtr->targets;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &RoadGraph::Lengths() const
+{
+  return this->dataPtr->lengths;
+}
+
+//////////////////////////////////////////////////
+RoadGraph &RoadGraph::operator=(const RoadGraph &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
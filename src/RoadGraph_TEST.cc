@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief An edge as a (source key, target key) pair.
+using KeyEdge = std::pair<uint64_t, uint64_t>;
+
+/// \brief Get the edges of a graph as sorted key pairs.
+/// \param[in] _graph The graph.
+/// \return The edges.
+std::vector<KeyEdge> graphEdges(const RoadGraph &_graph)
+{
+  std::vector<KeyEdge> edges;
+  for (size_t i = 0; i < _graph.NumNodes(); ++i)
+  {
+    for (uint32_t e = _graph.Offsets()[i]; e < _graph.Offsets()[i + 1]; ++e)
+    {
+      edges.emplace_back(_graph.Keys()[i],
+        _graph.Keys()[_graph.Targets()[e]]);
+    }
+  }
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+/// \brief Get the expected edges of a RNDF as sorted key pairs.
+/// \param[in] _rndf The RNDF.
+/// \return The edges.
+std::vector<KeyEdge> expectedEdges(const RNDF &_rndf)
+{
+  std::vector<KeyEdge> edges;
+  std::set<uint64_t> gates;
+  auto exits = [&](const std::vector<Exit> &_exits)
+  {
+    for (auto const &exit : _exits)
+    {
+      if (_rndf.Info(exit.ExitId()) && _rndf.Info(exit.EntryId()))
+      {
+        edges.emplace_back(exit.ExitId().Key(), exit.EntryId().Key());
+        gates.insert(exit.ExitId().Key());
+        gates.insert(exit.EntryId().Key());
+      }
+    }
+  };
+
+  for (auto const &segment : _rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      const std::vector<Waypoint> &wps = lane.Waypoints();
+      for (size_t i = 0; i + 1 < wps.size(); ++i)
+      {
+        edges.emplace_back(
+          UniqueId(segment.Id(), lane.Id(), wps[i].Id()).Key(),
+          UniqueId(segment.Id(), lane.Id(), wps[i + 1].Id()).Key());
+      }
+      exits(lane.Exits());
+    }
+  }
+
+  for (auto const &zone : _rndf.Zones())
+    exits(zone.Perimeter().Exits());
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    std::vector<uint64_t> access;
+    std::set<uint64_t> zoneGates;
+    for (auto const &wp : zone.Perimeter().Points())
+    {
+      access.push_back(UniqueId(zone.Id(), 0, wp.Id()).Key());
+      if (gates.count(access.back()))
+        zoneGates.insert(access.back());
+    }
+    for (auto const &spot : zone.Spots())
+    {
+      const std::vector<Waypoint> &wps = spot.Waypoints();
+      if (!wps.empty())
+        access.push_back(UniqueId(zone.Id(), spot.Id(), wps[0].Id()).Key());
+      for (size_t i = 0; i + 1 < wps.size(); ++i)
+      {
+        const uint64_t a = UniqueId(zone.Id(), spot.Id(), wps[i].Id()).Key();
+        const uint64_t b =
+          UniqueId(zone.Id(), spot.Id(), wps[i + 1].Id()).Key();
+        edges.emplace_back(a, b);
+        edges.emplace_back(b, a);
+      }
+    }
+    if (zoneGates.empty() && !access.empty())
+      zoneGates.insert(access.front());
+
+    // Every access node to and from every gate.
+    for (auto const a : access)
+    {
+      for (auto const b : access)
+      {
+        if (a != b && (zoneGates.count(a) || zoneGates.count(b)))
+          edges.emplace_back(a, b);
+      }
+    }
+  }
+
+  std::sort(edges.begin(), edges.end());
+  return edges;
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a default graph is empty.
+TEST(RoadGraph, Empty)
+{
+  RoadGraph graph;
+  EXPECT_EQ(graph.NumNodes(), 0u);
+  EXPECT_EQ(graph.NumEdges(), 0u);
+  EXPECT_TRUE(graph.Offsets().empty());
+
+  uint32_t node;
+  EXPECT_FALSE(graph.Node(UniqueId(1, 1, 1), node));
+
+  RNDF rndf;
+  EXPECT_EQ(rndf.RoadGraph().NumNodes(), 0u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the edges of the sample files against the model.
+TEST(RoadGraph, Samples)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    RNDF rndf(dirPath + "/test/rndf/" + sample);
+    ASSERT_TRUE(rndf.Valid());
+    const RoadGraph &graph = rndf.RoadGraph();
+
+    ASSERT_EQ(graph.NumNodes(), rndf.Coordinates().Size());
+    ASSERT_EQ(graph.Offsets().size(), graph.NumNodes() + 1);
+    EXPECT_EQ(graph.Offsets().back(), graph.NumEdges());
+    EXPECT_EQ(graph.Lengths().size(), graph.NumEdges());
+    EXPECT_EQ(graphEdges(graph), expectedEdges(rndf));
+
+    for (uint32_t i = 0; i < graph.NumNodes(); ++i)
+    {
+      uint32_t node;
+      ASSERT_TRUE(graph.Node(UniqueId::FromKey(graph.Keys()[i]), node));
+      EXPECT_EQ(node, i);
+    }
+
+    for (auto const length : graph.Lengths())
+    {
+      EXPECT_GE(length, 0);
+      EXPECT_LT(length, 5000);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the edges and lengths of a small network.
+TEST(RoadGraph, Lengths)
+{
+  RNDF rndf;
+  Lane lane(1);
+  lane.Waypoints().push_back(Waypoint(1, 0, 0));
+  lane.Waypoints().push_back(Waypoint(2, 0, 0.001));
+  lane.Waypoints().push_back(Waypoint(3, 0.001, 0.001));
+  Exit exit(UniqueId(1, 1, 3), UniqueId(1, 1, 1));
+  ASSERT_TRUE(lane.AddExit(exit));
+  ASSERT_TRUE(lane.AddExit(Exit(UniqueId(1, 1, 2), UniqueId(9, 1, 1))));
+  Segment segment(1);
+  segment.Lanes().push_back(lane);
+  ASSERT_TRUE(rndf.AddSegment(segment));
+
+  const RoadGraph &graph = rndf.RoadGraph();
+  ASSERT_EQ(graph.NumNodes(), 3u);
+  ASSERT_EQ(graph.NumEdges(), 3u);
+
+  // 1.1.1 -> 1.1.2 -> 1.1.3 -> 1.1.1. The exit to an unknown waypoint is
+  // ignored.
+  const double kMeters = 6371000.0 * 0.001 * 3.14159265358979323846 / 180;
+  for (uint32_t i = 0; i < 3; ++i)
+  {
+    ASSERT_EQ(graph.Offsets()[i + 1] - graph.Offsets()[i], 1u);
+    const uint32_t e = graph.Offsets()[i];
+    EXPECT_EQ(graph.Targets()[e], (i + 1) % 3);
+    EXPECT_NEAR(graph.Lengths()[e], i < 2 ? kMeters : std::sqrt(2) * kMeters,
+      0.01);
+  }
+
+  // The graph is rebuilt after a change.
+  rndf.Segments().front().Lanes().front().Exits().clear();
+  rndf.MarkModified(1);
+  EXPECT_EQ(rndf.RoadGraph().NumEdges(), 2u);
+
+  // A copy isn't affected by later changes.
+  RoadGraph copy(rndf.RoadGraph());
+  ASSERT_TRUE(rndf.RemoveSegment(1));
+  EXPECT_EQ(rndf.RoadGraph().NumNodes(), 0u);
+  EXPECT_EQ(copy.NumEdges(), 2u);
+  uint32_t node;
+  ASSERT_TRUE(copy.Node(UniqueId(1, 1, 3), node));
+  EXPECT_EQ(node, 2u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the graph of a RNDF is updated without rebuilding it
+/// after modifications that only move waypoints.
+TEST(RoadGraph, PartialUpdate)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+  const RNDF &constRndf = rndf;
+  const std::vector<double> &lengths = rndf.RoadGraph().Lengths();
+  const std::vector<double> before = lengths;
+
+  // Move the waypoints of a lane and of a zone.
+  Lane lane(constRndf.Segments().at(0).Lanes().at(0));
+  for (auto &wp : lane.Waypoints())
+    wp.SetLocation(wp.Latitude() + 0.0001, wp.Longitude());
+  ASSERT_TRUE(rndf.UpdateLane(1, lane));
+  Zone zone(constRndf.Zones().at(0));
+  for (auto &wp : zone.Perimeter().Points())
+    wp.SetLocation(wp.Latitude(), wp.Longitude() + 0.0001);
+  ASSERT_TRUE(rndf.UpdateZone(zone));
+
+  // The graph is updated in place.
+  const RoadGraph &graph = rndf.RoadGraph();
+  EXPECT_EQ(graph.Lengths().data(), lengths.data());
+  EXPECT_NE(graph.Lengths(), before);
+  const RoadGraph expected(rndf);
+  ASSERT_EQ(graph.NumEdges(), expected.NumEdges());
+  EXPECT_EQ(graph.Targets(), expected.Targets());
+  EXPECT_EQ(graph.Latitudes(), expected.Latitudes());
+  EXPECT_EQ(graph.Longitudes(), expected.Longitudes());
+  for (size_t e = 0; e < graph.NumEdges(); ++e)
+    EXPECT_DOUBLE_EQ(graph.Lengths()[e], expected.Lengths()[e]);
+
+  // A new exit rebuilds the graph.
+  ASSERT_TRUE(lane.AddExit(Exit(UniqueId(1, 1, 2), UniqueId(2, 1, 1))));
+  ASSERT_TRUE(rndf.UpdateLane(1, lane));
+  EXPECT_EQ(rndf.RoadGraph().NumEdges(), expected.NumEdges() + 1);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the number of edges of a zone is linear in the number
+/// of parking spots.
+TEST(RoadGraph, ZoneEdges)
+{
+  RNDF rndf;
+  Zone zone(1);
+  for (int i = 1; i <= 4; ++i)
+    zone.Perimeter().Points().push_back(Waypoint(i, 0.001 * (i / 2), 0));
+  for (int s = 1; s <= 500; ++s)
+  {
+    ParkingSpot spot(s);
+    spot.Waypoints().push_back(Waypoint(1, 0.0005, 0.00001 * s));
+    spot.Waypoints().push_back(Waypoint(2, 0.0006, 0.00001 * s));
+    zone.Spots().push_back(spot);
+  }
+  rndf.Zones().push_back(zone);
+  rndf.MarkModified();
+
+  // Without gates, the first perimeter point is connected to and from the
+  // other 503 access nodes.
+  const size_t spotEdges = 2 * 500;
+  EXPECT_EQ(rndf.RoadGraph().NumEdges(), spotEdges + 2 * 503);
+  EXPECT_EQ(graphEdges(rndf.RoadGraph()), expectedEdges(rndf));
+
+  // Two gates: a perimeter exit to a lane and back.
+  Lane lane(1);
+  lane.Waypoints().push_back(Waypoint(1, 0.002, 0));
+  ASSERT_TRUE(lane.AddExit(Exit(UniqueId(2, 1, 1), UniqueId(1, 0, 4))));
+  Segment segment(2);
+  segment.Lanes().push_back(lane);
+  rndf.Segments().push_back(segment);
+  ASSERT_TRUE(rndf.Zones().front().Perimeter().AddExit(
+    Exit(UniqueId(1, 0, 3), UniqueId(2, 1, 1))));
+  rndf.MarkModified();
+
+  const RoadGraph &graph = rndf.RoadGraph();
+  EXPECT_EQ(graph.NumEdges(), spotEdges + 2 + 2 * (2 * 503 - 1));
+  EXPECT_EQ(graphEdges(graph), expectedEdges(rndf));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,343 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <ignition/math/Helpers.hh>
+
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/Router.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for Router class.
+    /// The search state of every node is valid only if its stamp matches
+    /// the stamp of the current query, so starting a query doesn't touch
+    /// the state of the nodes settled by the previous ones.
+    class RouterPrivate
+    {
+      /// \brief An entry of the priority queue: estimated cost of a route
+      /// through a node, and the node.
+      public: using Entry = std::pair<double, uint32_t>;
+
+      /// \brief Estimate the cost from a node to the goal.
+      /// \param[in] _node The node.
+      /// \param[in] _goal The goal.
+      /// \return The straight-line distance in meters.
+      public: double Heuristic(const uint32_t _node, const uint32_t _goal)
+        const
+      {
+        // The same Earth radius used by the great-circle distances of the
+        // graph.
+        const double kEarthRadius = 6371000.0;
+        const double *a = &this->unit[3 * _node];
+        const double *b = &this->unit[3 * _goal];
+        const double dx = a[0] - b[0];
+        const double dy = a[1] - b[1];
+        const double dz = a[2] - b[2];
+        return kEarthRadius * std::sqrt(dx * dx + dy * dy + dz * dz);
+      }
+
+      /// \brief Start a new query.
+      public: void NextStamp()
+      {
+        this->stamp += 2;
+        if (this->stamp < 2)
+        {
+          // The stamps wrapped around.
+          std::fill(this->stamps.begin(), this->stamps.end(), 0);
+          this->stamp = 2;
+        }
+      }
+
+      /// \brief The graph.
+      public: const RoadGraph *graph = nullptr;
+
+      /// \brief Unit vectors from the center of the Earth to the nodes, as
+      /// (x, y, z) triplets.
+      public: std::vector<double> unit;
+
+      /// \brief Penalty of entering every node, or empty if there are no
+      /// penalties.
+      public: std::vector<double> penalties;
+
+      /// \brief Stamp of the current query. A node is reached in the
+      /// current query if its stamp is "stamp" and settled if it's
+      /// "stamp" + 1.
+      public: uint32_t stamp = 0;
+
+      /// \brief Stamp of every node.
+      public: std::vector<uint32_t> stamps;
+
+      /// \brief Cost of the best route found to every node.
+      public: std::vector<double> costs;
+
+      /// \brief Previous node of the best route found to every node.
+      public: std::vector<uint32_t> parents;
+
+      /// \brief Priority queue of the nodes to settle.
+      public: std::vector<Entry> queue;
+
+      /// \brief Nodes of the last route.
+      public: std::vector<uint32_t> nodes;
+
+      /// \brief Number of nodes settled by the last query.
+      public: size_t settled = 0;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+Router::Router()
+  : dataPtr(new RouterPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+Router::Router(const RoadGraph &_graph)
+  : Router()
+{
+  this->Update(_graph);
+}
+
+//////////////////////////////////////////////////
+Router::Router(const Router &_other)
+  : Router()
+{
+  *this = _other;
+}
+
+//////////////////////////////////////////////////
+Router::~Router()
+{
+}
+
+//////////////////////////////////////////////////
+void Router::Update(const RoadGraph &_graph)
+{
+  RouterPrivate &data = *this->dataPtr;
+  const size_t numNodes = _graph.NumNodes();
+  data.graph = &_graph;
+
+  data.unit.resize(3 * numNodes);
+  for (size_t i = 0; i < numNodes; ++i)
+  {
+    const double lat = IGN_DTOR(_graph.Latitudes()[i]);
+    const double lon = IGN_DTOR(_graph.Longitudes()[i]);
+    data.unit[3 * i] = std::cos(lat) * std::cos(lon);
+    data.unit[3 * i + 1] = std::cos(lat) * std::sin(lon);
+    data.unit[3 * i + 2] = std::sin(lat);
+  }
+
+  data.penalties.clear();
+  data.stamp = 0;
+  data.stamps.assign(numNodes, 0);
+  data.costs.resize(numNodes);
+  data.parents.resize(numNodes);
+  data.queue.clear();
+  data.queue.reserve(1024);
+  data.settled = 0;
+}
+
+//////////////////////////////////////////////////
+bool Router::SetPenalty(const UniqueId &_id, const double _penalty)
+{
+  RouterPrivate &data = *this->dataPtr;
+  uint32_t node;
+  if (!data.graph || !(_penalty >= 0) || !data.graph->Node(_id, node))
+    return false;
+
+  if (data.penalties.empty())
+    data.penalties.assign(data.stamps.size(), 0);
+  data.penalties[node] = _penalty;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Router::SetStopPenalty(const RNDF &_rndf, const double _penalty)
+{
+  if (!(_penalty >= 0))
+    return false;
+
+  for (auto const &segment : _rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      for (auto const stop : lane.Stops())
+        this->SetPenalty(UniqueId(segment.Id(), lane.Id(), stop), _penalty);
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void Router::ClearPenalties()
+{
+  this->dataPtr->penalties.clear();
+}
+
+//////////////////////////////////////////////////
+bool Router::Route(const UniqueId &_start, const UniqueId &_goal,
+  std::vector<UniqueId> &_waypoints)
+{
+  double cost;
+  return this->Route(_start, _goal, _waypoints, cost);
+}
+
+//////////////////////////////////////////////////
+bool Router::Route(const UniqueId &_start, const UniqueId &_goal,
+  std::vector<UniqueId> &_waypoints, double &_cost)
+{
+  RouterPrivate &data = *this->dataPtr;
+  _waypoints.clear();
+
+  uint32_t start;
+  uint32_t goal;
+  if (!data.graph || !data.graph->Node(_start, start) ||
+      !data.graph->Node(_goal, goal))
+  {
+    return false;
+  }
+
+  if (!this->Route(start, goal, data.nodes, _cost))
+    return false;
+
+  _waypoints.reserve(data.nodes.size());
+  for (auto const node : data.nodes)
+    _waypoints.push_back(UniqueId::FromKey(data.graph->Keys()[node]));
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Router::Route(const uint32_t _start, const uint32_t _goal,
+  std::vector<uint32_t> &_nodes, double &_cost)
+{
+  RouterPrivate &data = *this->dataPtr;
+  _nodes.clear();
+  data.settled = 0;
+
+  if (!data.graph)
+    return false;
+
+  const size_t numNodes = data.stamps.size();
+  if (data.graph->NumNodes() != numNodes)
+  {
+    std::cerr << "Router::Route() error: The graph changed. "
+              << "Call Update() first" << std::endl;
+    return false;
+  }
+
+  if (_start >= numNodes || _goal >= numNodes)
+    return false;
+
+  const std::vector<uint32_t> &offsets = data.graph->Offsets();
+  const std::vector<uint32_t> &targets = data.graph->Targets();
+  const std::vector<double> &lengths = data.graph->Lengths();
+  const bool penalized = !data.penalties.empty();
+
+  data.NextStamp();
+  const uint32_t reached = data.stamp;
+  const uint32_t settled = data.stamp + 1;
+
+  std::vector<RouterPrivate::Entry> &queue = data.queue;
+  std::greater<RouterPrivate::Entry> order;
+  queue.clear();
+  data.stamps[_start] = reached;
+  data.costs[_start] = 0;
+  data.parents[_start] = _start;
+  queue.emplace_back(data.Heuristic(_start, _goal), _start);
+
+  bool found = false;
+  while (!queue.empty())
+  {
+    const uint32_t node = queue.front().second;
+    std::pop_heap(queue.begin(), queue.end(), order);
+    queue.pop_back();
+
+    // Skip the outdated entries of settled nodes.
+    if (data.stamps[node] == settled)
+      continue;
+    data.stamps[node] = settled;
+    ++data.settled;
+
+    if (node == _goal)
+    {
+      found = true;
+      break;
+    }
+
+    const double cost = data.costs[node];
+    for (uint32_t e = offsets[node]; e < offsets[node + 1]; ++e)
+    {
+      const uint32_t target = targets[e];
+      const uint32_t targetStamp = data.stamps[target];
+      if (targetStamp == settled)
+        continue;
+
+      double newCost = cost + lengths[e];
+      if (penalized)
+        newCost += data.penalties[target];
+
+      if (targetStamp != reached || newCost < data.costs[target])
+      {
+        data.stamps[target] = reached;
+        data.costs[target] = newCost;
+        data.parents[target] = node;
+        queue.emplace_back(newCost + data.Heuristic(target, _goal), target);
+        std::push_heap(queue.begin(), queue.end(), order);
+      }
+    }
+  }
+
+  if (!found)
+    return false;
+
+  for (uint32_t node = _goal; node != _start; node = data.parents[node])
+    _nodes.push_back(node);
+  _nodes.push_back(_start);
+  std::reverse(_nodes.begin(), _nodes.end());
+  _cost = data.costs[_goal];
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t Router::LastSettled() const
+{
+  return this->dataPtr->settled;
+}
+
+//////////////////////////////////////////////////
+Router &Router::operator=(const Router &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/Router.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Compute the costs of the shortest routes from a node to all the
+/// nodes of a graph with Dijkstra's algorithm.
+/// \param[in] _graph The graph.
+/// \param[in] _start The first node.
+/// \return The costs, infinite for unreachable nodes.
+std::vector<double> dijkstra(const RoadGraph &_graph, const uint32_t _start)
+{
+  std::vector<double> costs(_graph.NumNodes(),
+    std::numeric_limits<double>::infinity());
+  using Entry = std::pair<double, uint32_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  costs[_start] = 0;
+  queue.push(Entry(0, _start));
+  while (!queue.empty())
+  {
+    const Entry entry = queue.top();
+    queue.pop();
+    if (entry.first > costs[entry.second])
+      continue;
+    for (uint32_t e = _graph.Offsets()[entry.second];
+         e < _graph.Offsets()[entry.second + 1]; ++e)
+    {
+      const uint32_t target = _graph.Targets()[e];
+      const double cost = entry.first + _graph.Lengths()[e];
+      if (cost < costs[target])
+      {
+        costs[target] = cost;
+        queue.push(Entry(cost, target));
+      }
+    }
+  }
+  return costs;
+}
+
+/// \brief Create a RNDF with two routes from 1.1.1 to 1.1.3: straight
+/// through 1.1.2, or a slightly longer detour through segment 2.
+/// \param[out] _rndf The RNDF.
+void twoRoutes(RNDF &_rndf)
+{
+  Lane main(1);
+  main.Waypoints().push_back(Waypoint(1, 0, 0));
+  main.Waypoints().push_back(Waypoint(2, 0, 0.001));
+  main.Waypoints().push_back(Waypoint(3, 0, 0.002));
+  ASSERT_TRUE(main.AddExit(Exit(UniqueId(1, 1, 1), UniqueId(2, 1, 1))));
+  ASSERT_TRUE(main.AddStop(2));
+  Segment segment1(1);
+  segment1.Lanes().push_back(main);
+  ASSERT_TRUE(_rndf.AddSegment(segment1));
+
+  Lane detour(1);
+  detour.Waypoints().push_back(Waypoint(1, 0.0001, 0.0005));
+  detour.Waypoints().push_back(Waypoint(2, 0.0001, 0.0015));
+  ASSERT_TRUE(detour.AddExit(Exit(UniqueId(2, 1, 2), UniqueId(1, 1, 3))));
+  Segment segment2(2);
+  segment2.Lanes().push_back(detour);
+  ASSERT_TRUE(_rndf.AddSegment(segment2));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check a router without a graph.
+TEST(Router, Empty)
+{
+  Router router;
+  std::vector<UniqueId> waypoints(2);
+  EXPECT_FALSE(router.Route(UniqueId(1, 1, 1), UniqueId(1, 1, 2),
+    waypoints));
+  EXPECT_TRUE(waypoints.empty());
+  EXPECT_FALSE(router.SetPenalty(UniqueId(1, 1, 1), 10));
+
+  RNDF rndf;
+  router.Update(rndf.RoadGraph());
+  std::vector<uint32_t> nodes;
+  double cost;
+  EXPECT_FALSE(router.Route(0, 0, nodes, cost));
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the routes of the sample files against Dijkstra's
+/// algorithm.
+TEST(Router, Samples)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    RNDF rndf(dirPath + "/test/rndf/" + sample);
+    ASSERT_TRUE(rndf.Valid());
+    const RoadGraph &graph = rndf.RoadGraph();
+    Router router(graph);
+
+    const uint32_t numNodes = static_cast<uint32_t>(graph.NumNodes());
+    std::vector<uint32_t> nodes;
+    for (uint32_t start = 0; start < numNodes; start += 17)
+    {
+      const std::vector<double> expected = dijkstra(graph, start);
+      for (uint32_t goal = 0; goal < numNodes; ++goal)
+      {
+        double cost = -1;
+        const bool found = router.Route(start, goal, nodes, cost);
+        ASSERT_EQ(found, expected[goal] < std::numeric_limits<double>::max());
+        if (!found)
+        {
+          EXPECT_TRUE(nodes.empty());
+          continue;
+        }
+
+        EXPECT_NEAR(cost, expected[goal], 1e-6);
+        ASSERT_FALSE(nodes.empty());
+        EXPECT_EQ(nodes.front(), start);
+        EXPECT_EQ(nodes.back(), goal);
+
+        // The route follows the edges of the graph.
+        double length = 0;
+        for (size_t i = 0; i + 1 < nodes.size(); ++i)
+        {
+          double best = std::numeric_limits<double>::infinity();
+          for (uint32_t e = graph.Offsets()[nodes[i]];
+               e < graph.Offsets()[nodes[i] + 1]; ++e)
+          {
+            if (graph.Targets()[e] == nodes[i + 1])
+              best = std::min(best, graph.Lengths()[e]);
+          }
+          ASSERT_LT(best, std::numeric_limits<double>::max());
+          length += best;
+        }
+        EXPECT_NEAR(length, cost, 1e-6);
+        EXPECT_GE(router.LastSettled(), nodes.size());
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the routes by unique Id and the penalties.
+TEST(Router, Penalties)
+{
+  RNDF rndf;
+  twoRoutes(rndf);
+  Router router(rndf.RoadGraph());
+
+  const UniqueId start(1, 1, 1);
+  const UniqueId goal(1, 1, 3);
+  std::vector<UniqueId> waypoints;
+  double straightCost;
+  ASSERT_TRUE(router.Route(start, goal, waypoints, straightCost));
+  ASSERT_EQ(waypoints.size(), 3u);
+  EXPECT_EQ(waypoints[1], UniqueId(1, 1, 2));
+
+  // A penalty at the stop of the straight route makes the detour shorter.
+  EXPECT_FALSE(router.SetStopPenalty(rndf, -1));
+  EXPECT_TRUE(router.SetStopPenalty(rndf, 100));
+  double detourCost;
+  ASSERT_TRUE(router.Route(start, goal, waypoints, detourCost));
+  ASSERT_EQ(waypoints.size(), 4u);
+  EXPECT_EQ(waypoints[1], UniqueId(2, 1, 1));
+  EXPECT_EQ(waypoints[2], UniqueId(2, 1, 2));
+  EXPECT_GT(detourCost, straightCost);
+  EXPECT_LT(detourCost, straightCost + 100);
+
+  // A penalty at the detour makes the straight route shorter again.
+  EXPECT_FALSE(router.SetPenalty(UniqueId(2, 1, 1), -1));
+  EXPECT_FALSE(router.SetPenalty(UniqueId(9, 1, 1), 1));
+  EXPECT_TRUE(router.SetPenalty(UniqueId(2, 1, 1), 1000));
+  double cost;
+  ASSERT_TRUE(router.Route(start, goal, waypoints, cost));
+  ASSERT_EQ(waypoints.size(), 3u);
+  EXPECT_NEAR(cost, straightCost + 100, 1e-6);
+
+  router.ClearPenalties();
+  ASSERT_TRUE(router.Route(start, goal, waypoints, cost));
+  EXPECT_NEAR(cost, straightCost, 1e-9);
+
+  // Routes to the same waypoint and to an unreachable one.
+  ASSERT_TRUE(router.Route(goal, goal, waypoints, cost));
+  ASSERT_EQ(waypoints.size(), 1u);
+  EXPECT_NEAR(cost, 0, 1e-9);
+  EXPECT_FALSE(router.Route(goal, start, waypoints));
+  EXPECT_TRUE(waypoints.empty());
+  EXPECT_FALSE(router.Route(start, UniqueId(9, 1, 1), waypoints));
+
+  // A copy has its own search state.
+  Router copy(router);
+  ASSERT_TRUE(copy.Route(start, goal, waypoints, cost));
+  EXPECT_NEAR(cost, straightCost, 1e-9);
+
+  // The router must be updated when the graph changes.
+  ASSERT_TRUE(rndf.RemoveSegment(2));
+  EXPECT_EQ(rndf.RoadGraph().NumNodes(), 3u);
+  EXPECT_FALSE(router.Route(start, goal, waypoints));
+  router.Update(rndf.RoadGraph());
+  EXPECT_TRUE(router.Route(start, goal, waypoints));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -19,12 +19,17 @@
 #include <cassert>
 #include <iostream>
 #include <string>
-#include <vector>
-
 #include <fstream>
+#include <utility>
+#include <vector>
 
+#include "ignition/rndf/Arena.hh"
 #include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LineReader.hh"
 #include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/RNDFBuilder.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+#include "ignition/rndf/RNDFWriter.hh"
 #include "ignition/rndf/Segment.hh"
 #include "ignition/rndf/UniqueId.hh"
 #include "ignition/rndf/Waypoint.hh"
@@ -38,7 +43,7 @@ namespace ignition
   {
     /// \internal
     /// \brief Private data for SegmentHeader class.
-    class SegmentHeaderPrivate
+    class SegmentHeaderPrivate : public ArenaObject
     {
       /// \brief Default constructor.
       public: SegmentHeaderPrivate() = default;
@@ -52,7 +57,7 @@ namespace ignition
 
     /// \internal
     /// \brief Private data for Segment class.
-    class SegmentPrivate
+    class SegmentPrivate : public ArenaObject
     {
       /// \brief Constructor.
       /// \param[in] _id Segment Id.
@@ -88,39 +93,43 @@ SegmentHeader::~SegmentHeader()
 }
 
 //////////////////////////////////////////////////
-bool SegmentHeader::Load(std::ifstream &_rndfFile, int &_lineNumber)
+bool SegmentHeader::Load(LineReader &_reader, int &_lineNumber)
 {
-  auto oldPos = _rndfFile.tellg();
-  int oldLineNumber = _lineNumber;
+  StringView lineread;
+  _reader.Peek(lineread);
 
-  std::string lineread;
-  nextRealLine(_rndfFile, lineread, _lineNumber);
+  Tokens tokens;
+  tokenize(lineread, " ", tokens);
 
-  auto tokens = split(lineread, " ");
-  if (tokens.size() == 2 && tokens.at(0) == "lane")
-  {
-    // Restore the file position and line number.
-    // ParseHeader() shouldn't have any effect.
-    _rndfFile.seekg(oldPos);
-    _lineNumber = oldLineNumber;
+  // The "lane" element belongs to the lane parser.
+  if (tokens.Size() == 2 && tokens[0] == "lane")
     return true;
-  }
 
-  if (tokens.size() != 2 || tokens.at(0) != "segment_name")
+  _reader.Consume(_lineNumber);
+
+  if (tokens.Size() != 2 || tokens[0] != "segment_name")
   {
     // Invalid or header element.
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse segment header "
-              << "element" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber
+                  << "]: Unable to parse segment header "
+                  << "element" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  assert(tokens.size() == 2);
+  assert(tokens.Size() == 2);
 
-  this->SetName(tokens.at(1));
+  this->SetName(tokens[1].String());
   return true;
 }
 
+//////////////////////////////////////////////////
+bool SegmentHeader::Load(std::ifstream &_rndfFile, int &_lineNumber)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _lineNumber);
+}
+
 //////////////////////////////////////////////////
 std::string SegmentHeader::Name() const
 {
@@ -156,63 +165,105 @@ Segment::Segment(const Segment &_other)
   *this = _other;
 }
 
+//////////////////////////////////////////////////
+Segment::Segment(Segment &&_other) noexcept  // NOLINT
+  : dataPtr(std::move(_other.dataPtr))
+{
+}
+
 //////////////////////////////////////////////////
 Segment::~Segment()
 {
 }
 
 //////////////////////////////////////////////////
-bool Segment::Load(std::ifstream &_rndfFile, int &_lineNumber,
+bool Segment::Load(LineReader &_reader, int &_lineNumber,
   std::vector<ExitCacheEntry> &_exitCache,
-  std::vector<std::string> &_waypointCache)
+  std::vector<uint64_t> &_waypointCache)
+{
+  RNDFBuilder builder(_exitCache, _waypointCache);
+  int segmentId;
+  if (!Parse(_reader, _lineNumber, builder, segmentId))
+    return false;
+
+  *this = std::move(builder.Segments().back());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Segment::Parse(LineReader &_reader, int &_lineNumber,
+  RNDFVisitor &_visitor, int &_segmentId)
 {
   int segmentId;
-  if (!parsePositive(_rndfFile, "segment", segmentId, _lineNumber))
+  if (!parsePositive(_reader, "segment", segmentId, _lineNumber))
     return false;
 
   int numLanes;
-  if (!parsePositive(_rndfFile, "num_lanes", numLanes, _lineNumber))
+  if (!parsePositive(_reader, "num_lanes", numLanes, _lineNumber))
     return false;
 
   // Parse optional segment header (containing the segment name).
   SegmentHeader header;
-  if (!header.Load(_rndfFile, _lineNumber))
+  if (!header.Load(_reader, _lineNumber))
     return false;
 
-  std::vector<rndf::Lane> lanes;
+  _visitor.OnSegment(segmentId, numLanes, header.Name());
+
   for (auto i = 0; i < numLanes; ++i)
   {
     // Parse a lane.
-    rndf::Lane lane;
-    if (!lane.Load(_rndfFile, segmentId, _lineNumber, _exitCache,
-      _waypointCache))
-    {
+    int laneId;
+    if (!Lane::Parse(_reader, segmentId, _lineNumber, _visitor, laneId))
       return false;
-    }
 
     // Check that all lanes are consecutive.
-    if (lane.Id() != i + 1)
+    if (laneId != i + 1)
     {
-      std::cerr << "[Line " << _lineNumber << "]: Found non-consecutive lane "
-                << "Id [" << lane.Id() << "]" << std::endl;
+      errorStream() << "[Line " << _lineNumber
+                    << "]: Found non-consecutive lane "
+                    << "Id [" << laneId << "]" << std::endl;
       return false;
     }
-
-    lanes.push_back(lane);
   }
 
   // Parse "end_segment".
-  if (!parseDelimiter(_rndfFile, "end_segment", _lineNumber))
+  if (!parseDelimiter(_reader, "end_segment", _lineNumber))
     return false;
 
-  // Populate the segment.
-  this->SetId(segmentId);
-  this->Lanes() = lanes;
-  this->SetName(header.Name());
-
+  _segmentId = segmentId;
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Segment::Load(std::ifstream &_rndfFile, int &_lineNumber,
+  std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<uint64_t> &_waypointCache)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _lineNumber, _exitCache, _waypointCache);
+}
+
+//////////////////////////////////////////////////
+bool Segment::Load(std::ifstream &_rndfFile, int &_lineNumber,
+  std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<std::string> &_waypointCache)
+{
+  std::vector<uint64_t> waypointKeys;
+  const bool result = this->Load(_rndfFile, _lineNumber, _exitCache,
+    waypointKeys);
+  for (const uint64_t key : waypointKeys)
+    _waypointCache.push_back(UniqueId::FromKey(key).String());
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool Segment::Save(std::ostream &_stream) const
+{
+  RNDFWriter writer(_stream);
+  writer.WriteSegment(*this);
+  return writer.Flush();
+}
+
 //////////////////////////////////////////////////
 int Segment::Id() const
 {
@@ -249,31 +300,33 @@ const std::vector<Lane> &Segment::Lanes() const
 //////////////////////////////////////////////////
 bool Segment::Lane(const int _laneId, rndf::Lane &_lane) const
 {
-  auto it = std::find_if(this->dataPtr->lanes.begin(),
-    this->dataPtr->lanes.end(),
-    [_laneId](const rndf::Lane &_aLane)
-    {
-      return _aLane.Id() == _laneId;
-    });
+  const rndf::Lane *lane = this->Lane(_laneId);
+  if (lane)
+    _lane = *lane;
 
-  bool found = it != this->dataPtr->lanes.end();
-  if (found)
-    _lane = *it;
+  return lane != nullptr;
+}
 
-  return found;
+//////////////////////////////////////////////////
+const rndf::Lane *Segment::Lane(const int _laneId) const
+{
+  return findById(this->dataPtr->lanes, _laneId);
 }
 
 //////////////////////////////////////////////////
-bool Segment::UpdateLane(const rndf::Lane &_lane)
+rndf::Lane *Segment::Lane(const int _laneId)
 {
-  auto it = std::find(this->dataPtr->lanes.begin(),
-    this->dataPtr->lanes.end(), _lane);
+  return findById(this->dataPtr->lanes, _laneId);
+}
 
-  bool found = it != this->dataPtr->lanes.end();
-  if (found)
-    *it = _lane;
+//////////////////////////////////////////////////
+bool Segment::UpdateLane(const rndf::Lane &_lane)
+{
+  rndf::Lane *lane = this->Lane(_lane.Id());
+  if (lane)
+    *lane = _lane;
 
-  return found;
+  return lane != nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -282,8 +335,8 @@ bool Segment::AddLane(const rndf::Lane &_newLane)
   // Validate the lane.
   if (!_newLane.Valid())
   {
-    std::cerr << "[Segment::AddLane() Invalid lane Id ["
-              << _newLane.Id() << "]" << std::endl;
+    errorStream() << "[Segment::AddLane() Invalid lane Id ["
+                  << _newLane.Id() << "]" << std::endl;
     return false;
   }
 
@@ -291,7 +344,7 @@ bool Segment::AddLane(const rndf::Lane &_newLane)
   if (std::find(this->dataPtr->lanes.begin(), this->dataPtr->lanes.end(),
     _newLane) != this->dataPtr->lanes.end())
   {
-    std::cerr << "[Segment::AddLane() error: Existing lane" << std::endl;
+    errorStream() << "[Segment::AddLane() error: Existing lane" << std::endl;
     return false;
   }
 
@@ -353,8 +406,19 @@ bool Segment::operator!=(const Segment &_other) const
 //////////////////////////////////////////////////
 Segment &Segment::operator=(const Segment &_other)
 {
+  // This instance might have been moved from.
+  if (!this->dataPtr)
+    this->dataPtr.reset(new SegmentPrivate(-1));
+
   this->SetId(_other.Id());
   this->Lanes() = _other.Lanes();
   this->SetName(_other.Name());
   return *this;
 }
+
+//////////////////////////////////////////////////
+Segment &Segment::operator=(Segment &&_other) noexcept  // NOLINT
+{
+  std::swap(this->dataPtr, _other.dataPtr);
+  return *this;
+}
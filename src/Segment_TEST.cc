@@ -16,6 +16,8 @@
 */
 
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
@@ -128,6 +130,33 @@ TEST(Segment, waypoints)
   EXPECT_EQ(segment.NumLanes(), 0u);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the accessors of lanes by Id that don't copy them.
+TEST(Segment, laneById)
+{
+  Segment segment(1);
+  for (auto const id : {1, 2, 4})
+    segment.Lanes().emplace_back(id);
+  const Segment &constSegment = segment;
+
+  // Consecutive and non-consecutive Ids.
+  EXPECT_EQ(constSegment.Lane(1), &constSegment.Lanes().at(0));
+  EXPECT_EQ(constSegment.Lane(2), &constSegment.Lanes().at(1));
+  EXPECT_EQ(constSegment.Lane(4), &constSegment.Lanes().at(2));
+  EXPECT_EQ(constSegment.Lane(3), nullptr);
+  EXPECT_EQ(constSegment.Lane(0), nullptr);
+  EXPECT_EQ(constSegment.Lane(-1), nullptr);
+
+  // Edit a lane in place.
+  Lane *mutableLane = segment.Lane(4);
+  ASSERT_TRUE(mutableLane != nullptr);
+  mutableLane->SetWidth(3.5);
+  Lane copy;
+  EXPECT_TRUE(segment.Lane(4, copy));
+  EXPECT_DOUBLE_EQ(copy.Width(), 3.5);
+  EXPECT_EQ(segment.Lane(5), nullptr);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check segment name.
 TEST(Segment, Name)
@@ -221,6 +250,34 @@ TEST(Segment, assignment)
   EXPECT_EQ(segment1, segment2);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check move constructor and move assignment operator.
+TEST(Segment, move)
+{
+  static_assert(std::is_nothrow_move_constructible<Segment>::value &&
+    std::is_nothrow_move_assignable<Segment>::value,
+    "Segment should be nothrow movable");
+
+  Segment segment1(1);
+  segment1.Lanes().push_back(Lane(1));
+  segment1.SetName("road");
+
+  Segment segment2(std::move(segment1));
+  EXPECT_EQ(segment2.Id(), 1);
+  EXPECT_EQ(segment2.NumLanes(), 1u);
+  EXPECT_EQ(segment2.Name(), "road");
+
+  // A moved-from segment can be assigned to.
+  segment1 = segment2;
+  EXPECT_EQ(segment1, segment2);
+  EXPECT_EQ(segment1.NumLanes(), 1u);
+
+  Segment segment3(3);
+  segment3 = std::move(segment2);
+  EXPECT_EQ(segment3.Id(), 1);
+  EXPECT_EQ(segment3.NumLanes(), 1u);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check loading a segment from a text file.
 TEST_F(SegmentTest, Load)
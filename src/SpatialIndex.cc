@@ -0,0 +1,463 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/LocalFrame.hh"
+#include "ignition/rndf/SpatialIndex.hh"
+#include "ignition/rndf/UniqueId.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+namespace ignition
+{
+  namespace rndf
+  {
+    /// \internal
+    /// \brief Private data for SpatialIndex class.
+    /// The waypoints are stored as an implicit balanced k-d tree: the node
+    /// of a range [begin, end) is the waypoint in the middle, the waypoints
+    /// before it are its left subtree and the ones after it are its right
+    /// subtree. Small ranges are leaves, which are scanned linearly.
+    ///
+    /// Waypoints moved after the tree was built are hidden in the tree and
+    /// appended after it, where every query scans them linearly, until
+    /// there are too many of them and the tree is rebuilt.
+    class SpatialIndexPrivate
+    {
+      /// \brief Maximum number of waypoints of a leaf.
+      public: static const size_t kLeafSize = 8;
+
+      /// \brief Maximum number of moved waypoints kept after the tree.
+      public: static const size_t kMaxMoved = 256;
+
+      /// \brief Flag of the waypoints that belong to a zone.
+      public: static const uint8_t kZone = 1;
+
+      /// \brief Flag of the waypoints of the tree that were moved.
+      public: static const uint8_t kMoved = 2;
+
+      /// \brief Whether a waypoint is considered by a filter.
+      /// \param[in] _index Position of the waypoint.
+      /// \param[in] _filter The filter.
+      /// \return True if the waypoint is considered.
+      public: bool Matches(const size_t _index,
+                           const SpatialFilter _filter) const
+      {
+        switch (_filter)
+        {
+          case SpatialFilter::LANES:
+            return this->flags[_index] == 0;
+          case SpatialFilter::ZONES:
+            return this->flags[_index] == kZone;
+          case SpatialFilter::ALL:
+          default:
+            return (this->flags[_index] & kMoved) == 0;
+        }
+      }
+
+      /// \brief Get the squared distance from a point to a waypoint.
+      /// \param[in] _x East coordinate of the point.
+      /// \param[in] _y North coordinate of the point.
+      /// \param[in] _index Position of the waypoint.
+      /// \return The squared distance in square meters.
+      public: double SquaredDistance(const double _x, const double _y,
+                                     const size_t _index) const
+      {
+        const double dx = _x - this->xs[_index];
+        const double dy = _y - this->ys[_index];
+        return dx * dx + dy * dy;
+      }
+
+      /// \brief Build the subtree of a range of waypoints.
+      /// \param[in, out] _order Positions of the waypoints in the input
+      /// arrays, reordered as the tree.
+      /// \param[in] _begin First position of the range.
+      /// \param[in] _end Position after the last one of the range.
+      public: void Build(std::vector<uint32_t> &_order, const size_t _begin,
+                         const size_t _end)
+      {
+        if (_end - _begin <= kLeafSize)
+          return;
+
+        // Split along the axis with the largest extent.
+        double minX = std::numeric_limits<double>::max();
+        double maxX = std::numeric_limits<double>::lowest();
+        double minY = minX;
+        double maxY = maxX;
+        for (size_t i = _begin; i < _end; ++i)
+        {
+          minX = std::min(minX, this->xs[_order[i]]);
+          maxX = std::max(maxX, this->xs[_order[i]]);
+          minY = std::min(minY, this->ys[_order[i]]);
+          maxY = std::max(maxY, this->ys[_order[i]]);
+        }
+        const uint8_t axis = maxX - minX >= maxY - minY ? 0 : 1;
+        const std::vector<double> &coords = axis == 0 ? this->xs : this->ys;
+
+        const size_t mid = _begin + (_end - _begin) / 2;
+        std::nth_element(_order.begin() + _begin, _order.begin() + mid,
+          _order.begin() + _end,
+          [&coords](const uint32_t _a, const uint32_t _b)
+          {
+            return coords[_a] < coords[_b];
+          });
+        this->axes[mid] = axis;
+
+        this->Build(_order, _begin, mid);
+        this->Build(_order, mid + 1, _end);
+      }
+
+      /// \brief Find the waypoint of a subtree closest to a point.
+      /// \param[in] _x East coordinate of the point.
+      /// \param[in] _y North coordinate of the point.
+      /// \param[in] _begin First position of the subtree.
+      /// \param[in] _end Position after the last one of the subtree.
+      /// \param[in] _filter Waypoints considered.
+      /// \param[in, out] _best Position of the closest waypoint found.
+      /// \param[in, out] _bestDistance Squared distance to _best.
+      public: void Nearest(const double _x, const double _y,
+                           const size_t _begin, const size_t _end,
+                           const SpatialFilter _filter, size_t &_best,
+                           double &_bestDistance) const
+      {
+        if (_end - _begin <= kLeafSize)
+        {
+          for (size_t i = _begin; i < _end; ++i)
+          {
+            const double distance = this->SquaredDistance(_x, _y, i);
+            if (distance < _bestDistance && this->Matches(i, _filter))
+            {
+              _best = i;
+              _bestDistance = distance;
+            }
+          }
+          return;
+        }
+
+        // Visit the side of the point first, so the other side can be
+        // skipped more often.
+        const size_t mid = _begin + (_end - _begin) / 2;
+        const double diff = this->axes[mid] == 0 ?
+          _x - this->xs[mid] : _y - this->ys[mid];
+        if (diff < 0)
+          this->Nearest(_x, _y, _begin, mid, _filter, _best, _bestDistance);
+        else
+          this->Nearest(_x, _y, mid + 1, _end, _filter, _best, _bestDistance);
+
+        const double distance = this->SquaredDistance(_x, _y, mid);
+        if (distance < _bestDistance && this->Matches(mid, _filter))
+        {
+          _best = mid;
+          _bestDistance = distance;
+        }
+
+        if (diff * diff < _bestDistance)
+        {
+          if (diff < 0)
+            this->Nearest(_x, _y, mid + 1, _end, _filter, _best, _bestDistance);
+          else
+            this->Nearest(_x, _y, _begin, mid, _filter, _best, _bestDistance);
+        }
+      }
+
+      /// \brief Find the waypoints of a subtree within a distance of a
+      /// point.
+      /// \param[in] _x East coordinate of the point.
+      /// \param[in] _y North coordinate of the point.
+      /// \param[in] _radius2 Squared maximum distance.
+      /// \param[in] _begin First position of the subtree.
+      /// \param[in] _end Position after the last one of the subtree.
+      /// \param[in] _filter Waypoints considered.
+      /// \param[in, out] _ids Unique Ids of the waypoints found.
+      public: void Within(const double _x, const double _y,
+                          const double _radius2,
+                          const size_t _begin, const size_t _end,
+                          const SpatialFilter _filter,
+                          std::vector<UniqueId> &_ids) const
+      {
+        if (_end - _begin <= kLeafSize)
+        {
+          for (size_t i = _begin; i < _end; ++i)
+          {
+            if (this->SquaredDistance(_x, _y, i) <= _radius2 &&
+                this->Matches(i, _filter))
+            {
+              _ids.push_back(this->Id(i));
+            }
+          }
+          return;
+        }
+
+        const size_t mid = _begin + (_end - _begin) / 2;
+        const double diff = this->axes[mid] == 0 ?
+          _x - this->xs[mid] : _y - this->ys[mid];
+
+        if (diff <= 0 || diff * diff <= _radius2)
+          this->Within(_x, _y, _radius2, _begin, mid, _filter, _ids);
+
+        if (this->SquaredDistance(_x, _y, mid) <= _radius2 &&
+            this->Matches(mid, _filter))
+        {
+          _ids.push_back(this->Id(mid));
+        }
+
+        if (diff >= 0 || diff * diff <= _radius2)
+          this->Within(_x, _y, _radius2, mid + 1, _end, _filter, _ids);
+      }
+
+      /// \brief Get the unique Id of a waypoint.
+      /// \param[in] _index Position of the waypoint.
+      /// \return The unique Id.
+      public: UniqueId Id(const size_t _index) const
+      {
+        return UniqueId::FromKey(this->keys[_index]);
+      }
+
+      /// \brief Local frame of the waypoints.
+      public: LocalFrame frame;
+
+      /// \brief East coordinates of the waypoints in meters.
+      public: std::vector<double> xs;
+
+      /// \brief North coordinates of the waypoints in meters.
+      public: std::vector<double> ys;
+
+      /// \brief Unique Id keys of the waypoints.
+      public: std::vector<uint64_t> keys;
+
+      /// \brief Flags of each waypoint: kZone and kMoved.
+      public: std::vector<uint8_t> flags;
+
+      /// \brief Number of waypoints of the tree. The moved waypoints are
+      /// stored after them.
+      public: size_t treeSize = 0;
+
+      /// \brief Position in the arrays of every waypoint of the snapshot.
+      public: std::vector<uint32_t> positions;
+
+      /// \brief Split axis of each node: 0 for x and 1 for y.
+      public: std::vector<uint8_t> axes;
+    };
+  }
+}
+
+//////////////////////////////////////////////////
+SpatialIndex::SpatialIndex()
+  : dataPtr(new SpatialIndexPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+SpatialIndex::SpatialIndex(const CoordinateSnapshot &_coordinates)
+  : SpatialIndex()
+{
+  this->Update(_coordinates);
+}
+
+//////////////////////////////////////////////////
+SpatialIndex::SpatialIndex(const SpatialIndex &_other)
+  : SpatialIndex()
+{
+  *this = _other;
+}
+
+//////////////////////////////////////////////////
+SpatialIndex::~SpatialIndex()
+{
+}
+
+//////////////////////////////////////////////////
+void SpatialIndex::Update(const CoordinateSnapshot &_coordinates)
+{
+  const size_t size = _coordinates.Size();
+  const std::vector<double> &latitudes = _coordinates.Latitudes();
+  const std::vector<double> &longitudes = _coordinates.Longitudes();
+
+  // The origin of the local frame is the center of the bounding box.
+  double minLat = 0;
+  double maxLat = 0;
+  double minLon = 0;
+  double maxLon = 0;
+  if (size > 0)
+  {
+    auto lat = std::minmax_element(latitudes.begin(), latitudes.end());
+    auto lon = std::minmax_element(longitudes.begin(), longitudes.end());
+    minLat = *lat.first;
+    maxLat = *lat.second;
+    minLon = *lon.first;
+    maxLon = *lon.second;
+  }
+  SpatialIndexPrivate &data = *this->dataPtr;
+  data.frame.SetBounds(minLat, maxLat, minLon, maxLon);
+
+  // Lanes come first in the snapshot. The zones start with the first
+  // perimeter.
+  std::vector<uint8_t> zones(size, 0);
+  for (auto const &range : _coordinates.Ranges())
+  {
+    if (range.y == 0)
+    {
+      std::fill(zones.begin() + range.begin, zones.end(),
+        SpatialIndexPrivate::kZone);
+      break;
+    }
+  }
+
+  data.xs.resize(size);
+  data.ys.resize(size);
+  for (size_t i = 0; i < size; ++i)
+    data.frame.Project(latitudes[i], longitudes[i], data.xs[i], data.ys[i]);
+
+  std::vector<uint32_t> order(size);
+  for (size_t i = 0; i < size; ++i)
+    order[i] = static_cast<uint32_t>(i);
+  data.axes.assign(size, 0);
+  data.Build(order, 0, size);
+
+  // Store the waypoints in tree order.
+  std::vector<double> xs(size);
+  std::vector<double> ys(size);
+  data.keys.resize(size);
+  data.flags.resize(size);
+  data.positions.resize(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    xs[i] = data.xs[order[i]];
+    ys[i] = data.ys[order[i]];
+    data.keys[i] = _coordinates.Keys()[order[i]];
+    data.flags[i] = zones[order[i]];
+    data.positions[order[i]] = static_cast<uint32_t>(i);
+  }
+  data.xs.swap(xs);
+  data.ys.swap(ys);
+  data.treeSize = size;
+}
+
+//////////////////////////////////////////////////
+void SpatialIndex::Update(const CoordinateSnapshot &_coordinates,
+  const std::vector<uint32_t> &_moved)
+{
+  SpatialIndexPrivate &data = *this->dataPtr;
+  if (_coordinates.Size() != data.treeSize)
+  {
+    this->Update(_coordinates);
+    return;
+  }
+
+  for (auto const pos : _moved)
+  {
+    uint32_t &index = data.positions[pos];
+    if (index < data.treeSize)
+    {
+      // Hide the waypoint in the tree, whose splits stay as they are, and
+      // store it again after the tree.
+      const uint8_t zone = data.flags[index];
+      data.flags[index] |= SpatialIndexPrivate::kMoved;
+      data.xs.push_back(0);
+      data.ys.push_back(0);
+      data.keys.push_back(data.keys[index]);
+      data.flags.push_back(zone);
+      index = static_cast<uint32_t>(data.keys.size() - 1);
+    }
+    data.frame.Project(_coordinates.Latitudes()[pos],
+      _coordinates.Longitudes()[pos], data.xs[index], data.ys[index]);
+  }
+
+  if (data.keys.size() - data.treeSize > SpatialIndexPrivate::kMaxMoved)
+    this->Update(_coordinates);
+}
+
+//////////////////////////////////////////////////
+size_t SpatialIndex::Size() const
+{
+  return this->dataPtr->treeSize;
+}
+
+//////////////////////////////////////////////////
+bool SpatialIndex::Nearest(const double _latitude, const double _longitude,
+  UniqueId &_id, const SpatialFilter _filter) const
+{
+  double distance;
+  return this->Nearest(_latitude, _longitude, _id, distance, _filter);
+}
+
+//////////////////////////////////////////////////
+bool SpatialIndex::Nearest(const double _latitude, const double _longitude,
+  UniqueId &_id, double &_distance, const SpatialFilter _filter) const
+{
+  double x;
+  double y;
+  this->dataPtr->frame.Project(_latitude, _longitude, x, y);
+
+  const SpatialIndexPrivate &data = *this->dataPtr;
+  const size_t none = std::numeric_limits<size_t>::max();
+  size_t best = none;
+  double bestDistance = std::numeric_limits<double>::infinity();
+  data.Nearest(x, y, 0, data.treeSize, _filter, best, bestDistance);
+  for (size_t i = data.treeSize; i < data.keys.size(); ++i)
+  {
+    const double distance = data.SquaredDistance(x, y, i);
+    if (distance < bestDistance && data.Matches(i, _filter))
+    {
+      best = i;
+      bestDistance = distance;
+    }
+  }
+  if (best == none)
+    return false;
+
+  _id = this->dataPtr->Id(best);
+  _distance = std::sqrt(bestDistance);
+  return true;
+}
+
+//////////////////////////////////////////////////
+size_t SpatialIndex::Within(const double _latitude, const double _longitude,
+  const double _radius, std::vector<UniqueId> &_ids,
+  const SpatialFilter _filter) const
+{
+  _ids.clear();
+  if (_radius < 0)
+    return 0;
+
+  double x;
+  double y;
+  this->dataPtr->frame.Project(_latitude, _longitude, x, y);
+  const SpatialIndexPrivate &data = *this->dataPtr;
+  const double radius2 = _radius * _radius;
+  data.Within(x, y, radius2, 0, data.treeSize, _filter, _ids);
+  for (size_t i = data.treeSize; i < data.keys.size(); ++i)
+  {
+    if (data.SquaredDistance(x, y, i) <= radius2 && data.Matches(i, _filter))
+      _ids.push_back(data.Id(i));
+  }
+  return _ids.size();
+}
+
+//////////////////////////////////////////////////
+SpatialIndex &SpatialIndex::operator=(const SpatialIndex &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
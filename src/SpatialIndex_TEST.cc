@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFNode.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/SpatialIndex.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Approximate distance in meters between two locations.
+/// \param[in] _lat1 Latitude of the first location in degrees.
+/// \param[in] _lon1 Longitude of the first location in degrees.
+/// \param[in] _lat2 Latitude of the second location in degrees.
+/// \param[in] _lon2 Longitude of the second location in degrees.
+/// \return The distance.
+double distance(const double _lat1, const double _lon1,
+  const double _lat2, const double _lon2)
+{
+  const double kMetersPerDegree = 6371008.8 * 3.14159265358979323846 / 180;
+  const double dy = (_lat2 - _lat1) * kMetersPerDegree;
+  const double dx = (_lon2 - _lon1) * kMetersPerDegree *
+    std::cos((_lat1 + _lat2) / 2 * 3.14159265358979323846 / 180);
+  return std::sqrt(dx * dx + dy * dy);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that a default index is empty.
+TEST(SpatialIndex, Empty)
+{
+  SpatialIndex index;
+  EXPECT_EQ(index.Size(), 0u);
+
+  UniqueId id;
+  double dist;
+  EXPECT_FALSE(index.Nearest(34.58, -117.36, id));
+  EXPECT_FALSE(index.Nearest(34.58, -117.36, id, dist));
+
+  std::vector<UniqueId> ids(3);
+  EXPECT_EQ(index.Within(34.58, -117.36, 1000, ids), 0u);
+  EXPECT_TRUE(ids.empty());
+
+  RNDF rndf;
+  EXPECT_EQ(rndf.SpatialIndex().Size(), 0u);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the queries against a linear scan of all the waypoints.
+TEST(SpatialIndex, Queries)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    RNDF rndf(dirPath + "/test/rndf/" + sample);
+    ASSERT_TRUE(rndf.Valid());
+    const CoordinateSnapshot &snapshot = rndf.Coordinates();
+    const SpatialIndex &index = rndf.SpatialIndex();
+    ASSERT_EQ(index.Size(), snapshot.Size());
+
+    const auto lat = std::minmax_element(snapshot.Latitudes().begin(),
+      snapshot.Latitudes().end());
+    const auto lon = std::minmax_element(snapshot.Longitudes().begin(),
+      snapshot.Longitudes().end());
+
+    // Every waypoint is its own nearest waypoint.
+    for (size_t i = 0; i < snapshot.Size(); ++i)
+    {
+      UniqueId id;
+      double dist = -1;
+      ASSERT_TRUE(index.Nearest(snapshot.Latitudes()[i],
+        snapshot.Longitudes()[i], id, dist));
+      EXPECT_NEAR(dist, 0, 1e-6);
+      RNDFNode *node = rndf.Info(id);
+      ASSERT_TRUE(node != nullptr);
+      EXPECT_DOUBLE_EQ(node->Waypoint()->Latitude(), snapshot.Latitudes()[i]);
+      EXPECT_DOUBLE_EQ(node->Waypoint()->Longitude(),
+        snapshot.Longitudes()[i]);
+    }
+
+    // The waypoints of the zones come after the ones of the lanes,
+    // starting with the first perimeter.
+    size_t firstZone = snapshot.Size();
+    for (auto const &range : snapshot.Ranges())
+    {
+      if (range.y == 0)
+      {
+        firstZone = range.begin;
+        break;
+      }
+    }
+
+    // A grid of locations around the RNDF.
+    const int kSteps = 25;
+    std::vector<UniqueId> ids;
+    for (int i = 0; i <= kSteps; ++i)
+    {
+      for (int j = 0; j <= kSteps; ++j)
+      {
+        const double qLat = *lat.first - 0.001 +
+          (*lat.second - *lat.first + 0.002) * i / kSteps;
+        const double qLon = *lon.first - 0.001 +
+          (*lon.second - *lon.first + 0.002) * j / kSteps;
+
+        for (auto filter : {SpatialFilter::ALL, SpatialFilter::LANES,
+                            SpatialFilter::ZONES})
+        {
+          double best = std::numeric_limits<double>::infinity();
+          size_t expectedWithin = 0;
+          for (size_t k = 0; k < snapshot.Size(); ++k)
+          {
+            const bool zone = k >= firstZone;
+            if ((filter == SpatialFilter::LANES && zone) ||
+                (filter == SpatialFilter::ZONES && !zone))
+            {
+              continue;
+            }
+
+            const double d = distance(qLat, qLon, snapshot.Latitudes()[k],
+              snapshot.Longitudes()[k]);
+            best = std::min(best, d);
+            if (d <= 100)
+              ++expectedWithin;
+          }
+
+          UniqueId id;
+          double dist;
+          const bool found = index.Nearest(qLat, qLon, id, dist, filter);
+          EXPECT_EQ(found, !std::isinf(best));
+          if (found)
+          {
+            // The index uses a single projection for the whole RNDF, so
+            // its distances differ slightly from the reference ones.
+            EXPECT_NEAR(dist, best, 0.01 + best * 1e-4);
+            RNDFNode *node = rndf.Info(id);
+            ASSERT_TRUE(node != nullptr);
+            EXPECT_NEAR(distance(qLat, qLon, node->Waypoint()->Latitude(),
+              node->Waypoint()->Longitude()), best, 0.01 + best * 1e-4);
+            if (filter == SpatialFilter::LANES)
+            {
+              EXPECT_TRUE(node->Lane() != nullptr);
+            }
+            else if (filter == SpatialFilter::ZONES)
+            {
+              EXPECT_TRUE(node->Zone() != nullptr);
+            }
+          }
+
+          const size_t numWithin = index.Within(qLat, qLon, 100, ids, filter);
+          EXPECT_EQ(numWithin, ids.size());
+          EXPECT_NEAR(static_cast<double>(numWithin),
+            static_cast<double>(expectedWithin), 1);
+          for (auto const &within : ids)
+          {
+            RNDFNode *node = rndf.Info(within);
+            ASSERT_TRUE(node != nullptr);
+            EXPECT_LE(distance(qLat, qLon, node->Waypoint()->Latitude(),
+              node->Waypoint()->Longitude()), 100.1);
+          }
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the index of a RNDF is rebuilt after a change.
+TEST(SpatialIndex, Rebuild)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+
+  const size_t size = rndf.SpatialIndex().Size();
+
+  // Move the first waypoint far away.
+  Segment &segment = rndf.Segments().front();
+  Lane &lane = segment.Lanes().front();
+  Waypoint &wp = lane.Waypoints().front();
+  wp.SetLocation(0.0, 0.0);
+  rndf.MarkModified(segment.Id());
+  const UniqueId movedId(segment.Id(), lane.Id(), wp.Id());
+
+  UniqueId id;
+  ASSERT_TRUE(rndf.SpatialIndex().Nearest(0.0, 0.0, id));
+  EXPECT_EQ(id, movedId);
+  EXPECT_EQ(rndf.SpatialIndex().Size(), size);
+
+  // A copy isn't affected by later changes.
+  SpatialIndex copy(rndf.SpatialIndex());
+  ASSERT_TRUE(rndf.RemoveSegment(segment.Id()));
+  EXPECT_LT(rndf.SpatialIndex().Size(), size);
+  EXPECT_EQ(copy.Size(), size);
+  ASSERT_TRUE(copy.Nearest(0.0, 0.0, id));
+  EXPECT_EQ(id, movedId);
+}
+
+//////////////////////////////////////////////////
+/// \brief Check that the index of a RNDF is updated without rebuilding it
+/// after modifications that only move waypoints.
+TEST(SpatialIndex, PartialUpdate)
+{
+  std::string dirPath(std::string(PROJECT_SOURCE_PATH));
+  RNDF rndf(dirPath + "/test/rndf/sample1.rndf");
+  ASSERT_TRUE(rndf.Valid());
+  const RNDF &constRndf = rndf;
+  const SpatialIndex &index = rndf.SpatialIndex();
+
+  // Move every waypoint of several lanes, more than once, so the index
+  // keeps some waypoints out of the tree and is eventually rebuilt.
+  std::vector<UniqueId> ids;
+  std::vector<UniqueId> expectedIds;
+  for (int round = 0; round < 30; ++round)
+  {
+    for (auto const &seg : constRndf.Segments())
+    {
+      Lane lane(seg.Lanes().at(0));
+      for (auto &wp : lane.Waypoints())
+      {
+        wp.SetLocation(wp.Latitude() + 0.0001 * (round % 3 - 1),
+          wp.Longitude() - 0.0001 * (round % 2));
+      }
+      ASSERT_TRUE(rndf.UpdateLane(seg.Id(), lane));
+    }
+
+    const Waypoint &wp =
+      constRndf.Segments().at(round % 13).Lanes().at(0).Waypoints().at(0);
+    const CoordinateSnapshot snapshot(rndf);
+    const SpatialIndex expected(snapshot);
+    EXPECT_EQ(&rndf.SpatialIndex(), &index);
+    EXPECT_EQ(index.Size(), expected.Size());
+    for (auto const filter :
+         {SpatialFilter::ALL, SpatialFilter::LANES, SpatialFilter::ZONES})
+    {
+      UniqueId id;
+      UniqueId expectedId;
+      double dist;
+      double expectedDist;
+      ASSERT_TRUE(index.Nearest(wp.Latitude(), wp.Longitude(), id, dist,
+        filter));
+      ASSERT_TRUE(expected.Nearest(wp.Latitude(), wp.Longitude(),
+        expectedId, expectedDist, filter));
+      // The projection of the index is not centered again when updated.
+      EXPECT_NEAR(dist, expectedDist, 1e-3);
+
+      index.Within(wp.Latitude(), wp.Longitude(), 50, ids, filter);
+      expected.Within(wp.Latitude(), wp.Longitude(), 50, expectedIds,
+        filter);
+      EXPECT_EQ(ids.size(), expectedIds.size());
+      for (auto const &expectedHit : expectedIds)
+      {
+        EXPECT_NE(std::find(ids.begin(), ids.end(), expectedHit),
+          ids.end());
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -50,34 +50,23 @@ UniqueId::UniqueId(const int _x, const int _y, const int _z)
 UniqueId::UniqueId(const std::string &_id)
   : UniqueId()
 {
-  auto tokens = split(_id, ".");
-  if (tokens.size() != 3)
+  Tokens tokens;
+  if (tokenize(_id, ".", tokens) != 3)
   {
-    std::cerr << "Unable to parse uniqueId [" << _id << "]" << std::endl;
+    errorStream() << "Unable to parse uniqueId [" << _id << "]" << std::endl;
     return;
   }
 
-  std::array<std::string::size_type, 3> sz;
   std::array<int, 3> data;
   const std::array<int, 3> kMin = {1, 0, 1};
-  try
-  {
-    for (int i = 0; i < 3; ++i)
-      data[i] = std::stoi(tokens[i], &(sz[i]));
-  } catch (...)
-  {
-    std::cerr << "Unable to parse uniqueId [" << _id << "]" << std::endl;
-    return;
-  }
-
-  // Sanity check.
   for (int i = 0; i < 3; ++i)
   {
-    if (data[i] < kMin[i]             ||
-        data[i] > 32768               ||
-        sz[i] != tokens.at(i).size())
+    // Sanity check.
+    if (!parseInt(tokens[i], data[i]) ||
+        data[i] < kMin[i]             ||
+        data[i] > 32768)
     {
-      std::cerr << "Unable to parse uniqueId [" << _id << "]" << std::endl;
+      errorStream() << "Unable to parse uniqueId [" << _id << "]" << std::endl;
       return;
     }
   }
@@ -152,6 +141,21 @@ std::string UniqueId::String() const
   return stream.str();
 }
 
+//////////////////////////////////////////////////
+uint64_t UniqueId::Key() const
+{
+  return waypointKey(this->X(), this->Y(), this->Z());
+}
+
+//////////////////////////////////////////////////
+UniqueId UniqueId::FromKey(const uint64_t _key)
+{
+  // The inverse of waypointKey().
+  return UniqueId(static_cast<int>(_key >> 32),
+                  static_cast<int>((_key >> 16) & 0xFFFF),
+                  static_cast<int>(_key & 0xFFFF));
+}
+
 //////////////////////////////////////////////////
 bool UniqueId::Valid() const
 {
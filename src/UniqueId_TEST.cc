@@ -19,6 +19,7 @@
 #include <string>
 
 #include "gtest/gtest.h"
+#include "ignition/rndf/ParserUtils.hh"
 #include "ignition/rndf/UniqueId.hh"
 
 using namespace ignition;
@@ -186,6 +187,30 @@ TEST(UniqueIdTest, equality)
   EXPECT_TRUE(id1 != id3);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that keys are consistent with the equality operators.
+TEST(UniqueIdTest, key)
+{
+  UniqueId id1(1, 2, 3);
+  UniqueId id2(1, 2, 3);
+  UniqueId id3(3, 2, 1);
+  UniqueId id4(1, 0, 2);
+  UniqueId id5("1.0.2");
+
+  EXPECT_EQ(id1.Key(), id2.Key());
+  EXPECT_NE(id1.Key(), id3.Key());
+  EXPECT_EQ(id4.Key(), id5.Key());
+  EXPECT_EQ(id1.Key(), waypointKey(1, 2, 3));
+  EXPECT_EQ(UniqueId::FromKey(id1.Key()), id1);
+  EXPECT_EQ(UniqueId::FromKey(waypointKey(14, 0, 2)), UniqueId(14, 0, 2));
+
+  UniqueId largest(32768, 32768, 32768);
+  EXPECT_NE(largest.Key(), UniqueId(32768, 32768, 1).Key());
+  EXPECT_NE(largest.Key(), UniqueId(32768, 1, 32768).Key());
+  EXPECT_NE(largest.Key(), UniqueId(1, 32768, 32768).Key());
+  EXPECT_EQ(UniqueId::FromKey(largest.Key()), largest);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check assignment operator.
 TEST(UniqueIdTest, assignment)
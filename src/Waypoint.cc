@@ -15,63 +15,24 @@
  *
 */
 
+#include <atomic>
 #include <cassert>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <ignition/math/SphericalCoordinates.hh>
 
+#include "ignition/rndf/LineReader.hh"
 #include "ignition/rndf/ParserUtils.hh"
 #include "ignition/rndf/Waypoint.hh"
 
 using namespace ignition;
 using namespace rndf;
 
-namespace ignition
-{
-  namespace rndf
-  {
-    /// \internal
-    /// \brief Private data for Waypoint class.
-    class WaypointPrivate
-    {
-      /// \brief Constructor.
-      /// \param[in] _id Waypoint Id.
-      /// \param[in] _location Location of the waypoint in decimal-degrees,
-      /// using ITRF00 reference frame and the GRS80 ellipsoid.
-      public: WaypointPrivate(const int &_id,
-                          const ignition::math::SphericalCoordinates &_location)
-        : id(_id),
-          location(_location)
-      {
-      }
-
-      public: WaypointPrivate() = default;
-
-      /// \brief Destructor.
-      public: virtual ~WaypointPrivate() = default;
-
-      /// \brief Unique waypoint identifier.
-      public: int id = -1;
-
-      /// \brief Location of the waypoint in decimal-degrees, using ITRF00
-      /// reference frame and the GRS80 ellipsoid.
-      public: ignition::math::SphericalCoordinates location;
-
-      /// \brief Is the waypoint an entry?
-      public: bool isEntry = false;
-
-      /// \brief Is the waypoint an exit?
-      public: bool isExit = false;
-    };
-  }
-}
-
 //////////////////////////////////////////////////
 Waypoint::Waypoint()
 {
-  this->dataPtr.reset(new WaypointPrivate(
-    -1, ignition::math::SphericalCoordinates()));
 }
 
 //////////////////////////////////////////////////
@@ -86,6 +47,18 @@ Waypoint::Waypoint(const int _id,
   this->Location() = _location;
 }
 
+//////////////////////////////////////////////////
+Waypoint::Waypoint(const int _id, const double _latitude,
+  const double _longitude)
+  : Waypoint()
+{
+  if (_id <= 0)
+    return;
+
+  this->SetId(_id);
+  this->SetLocation(_latitude, _longitude);
+}
+
 //////////////////////////////////////////////////
 Waypoint::Waypoint(const Waypoint &_other)
   : Waypoint()
@@ -93,88 +66,101 @@ Waypoint::Waypoint(const Waypoint &_other)
   *this = _other;
 }
 
+//////////////////////////////////////////////////
+Waypoint::Waypoint(Waypoint &&_other) noexcept  // NOLINT
+  : id(_other.id),
+    isEntry(_other.isEntry),
+    isExit(_other.isExit),
+    locationExposed(_other.locationExposed),
+    latitude(_other.latitude),
+    longitude(_other.longitude),
+    location(_other.location.exchange(nullptr))
+{
+  _other.locationExposed = false;
+}
+
 //////////////////////////////////////////////////
 Waypoint::~Waypoint()
 {
+  delete this->location.load();
 }
 
 //////////////////////////////////////////////////
-bool Waypoint::Load(std::ifstream &_rndfFile, const int _segmentId,
+bool Waypoint::Load(LineReader &_reader, const int _segmentId,
   const int _laneId, int &_lineNumber)
 {
-  std::string lineread;
-  nextRealLine(_rndfFile, lineread, _lineNumber);
+  StringView lineread;
+  nextRealLine(_reader, lineread, _lineNumber);
 
   // Parse the "waypoint".
-  auto tokens = split(lineread, " ");
-  if (tokens.size() < 3)
+  Tokens tokens;
+  tokenize(lineread, " ", tokens);
+  if (tokens.Size() < 3)
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse waypoint "
-              << " element" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber << "]: Unable to parse waypoint "
+                  << " element" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  assert(tokens.size() == 3);
+  assert(tokens.Size() == 3);
 
-  auto waypointIdTokens = split(tokens.at(0), ".");
-  if (waypointIdTokens.size() != 3                         ||
-      waypointIdTokens.at(0) != std::to_string(_segmentId) ||
-      waypointIdTokens.at(1) != std::to_string(_laneId))
+  Tokens waypointIdTokens;
+  tokenize(tokens[0], ".", waypointIdTokens);
+  if (waypointIdTokens.Size() != 3                      ||
+      waypointIdTokens[0] != std::to_string(_segmentId) ||
+      waypointIdTokens[1] != std::to_string(_laneId))
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse waypoint "
-              << " element" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber << "]: Unable to parse waypoint "
+                  << " element" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  std::string::size_type sz;
+  // Like std::stod(), only a valid prefix of the coordinates is required.
+  size_t sz;
   int waypointId;
-  double latitude;
-  double longitude;
-  try
-  {
-    latitude  = std::stod(tokens[1], &sz);
-    longitude = std::stod(tokens[2], &sz);
-    waypointId = std::stoi(waypointIdTokens[2], &sz);
-  } catch (...)
+  double lat;
+  double lon;
+  if (!parseDouble(tokens[1], lat, sz) ||
+      !parseDouble(tokens[2], lon, sz) ||
+      !parseInt(waypointIdTokens[2], waypointId, sz))
   {
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse waypoint "
-              << " element" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber << "]: Unable to parse waypoint "
+                  << " element" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
   if (waypointId <= 0    ||
       waypointId > 32768 ||
-      sz != waypointIdTokens.at(2).size())
+      sz != waypointIdTokens[2].Size())
   {
-    std::cerr << "[Line " << _lineNumber << "]: Out of range value ["
-              << waypointId << "]" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber << "]: Out of range value ["
+                  << waypointId << "]" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
   // Populate the waypoint.
   this->SetId(waypointId);
-
-  ignition::math::SphericalCoordinates::SurfaceType st =
-    ignition::math::SphericalCoordinates::EARTH_WGS84;
-  ignition::math::Angle lat(IGN_DTOR(latitude));
-  ignition::math::Angle lon(IGN_DTOR(longitude));
-  ignition::math::Angle heading(ignition::math::Angle::Zero);
-  double elev = 0.0;
-  ignition::math::SphericalCoordinates sc(st, lat, lon, elev, heading);
-
-  this->Location() = sc;
+  this->SetLocation(lat, lon);
 
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Waypoint::Load(std::ifstream &_rndfFile, const int _segmentId,
+  const int _laneId, int &_lineNumber)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _segmentId, _laneId, _lineNumber);
+}
+
 //////////////////////////////////////////////////
 int Waypoint::Id() const
 {
-  return this->dataPtr->id;
+  return this->id;
 }
 
 //////////////////////////////////////////////////
@@ -182,44 +168,94 @@ bool Waypoint::SetId(const int _id)
 {
   bool valid = _id > 0;
   if (valid)
-    this->dataPtr->id = _id;
+    this->id = _id;
   return valid;
 }
 
 //////////////////////////////////////////////////
 const ignition::math::SphericalCoordinates &Waypoint::Location() const
 {
-  return this->dataPtr->location;
+  ignition::math::SphericalCoordinates *current =
+    this->location.load(std::memory_order_acquire);
+  if (current)
+    return *current;
+
+  // Concurrent readers may create it at the same time. Only the first
+  // object stored is kept.
+  ignition::math::SphericalCoordinates *created =
+    new ignition::math::SphericalCoordinates(
+      ignition::math::SphericalCoordinates::EARTH_WGS84,
+      ignition::math::Angle(IGN_DTOR(this->latitude)),
+      ignition::math::Angle(IGN_DTOR(this->longitude)),
+      0.0, ignition::math::Angle::Zero);
+  if (!this->location.compare_exchange_strong(current, created,
+        std::memory_order_acq_rel, std::memory_order_acquire))
+  {
+    delete created;
+    return *current;
+  }
+
+  return *created;
 }
 
 //////////////////////////////////////////////////
 ignition::math::SphericalCoordinates &Waypoint::Location()
 {
-  return this->dataPtr->location;
+  const Waypoint *constThis = this;
+  this->locationExposed = true;
+  return const_cast<ignition::math::SphericalCoordinates &>(
+    constThis->Location());
+}
+
+//////////////////////////////////////////////////
+double Waypoint::Latitude() const
+{
+  if (this->locationExposed)
+    return this->location.load()->LatitudeReference().Degree();
+
+  return this->latitude;
+}
+
+//////////////////////////////////////////////////
+double Waypoint::Longitude() const
+{
+  if (this->locationExposed)
+    return this->location.load()->LongitudeReference().Degree();
+
+  return this->longitude;
+}
+
+//////////////////////////////////////////////////
+void Waypoint::SetLocation(const double _latitude, const double _longitude)
+{
+  this->latitude = _latitude;
+  this->longitude = _longitude;
+  this->locationExposed = false;
+  delete this->location.exchange(nullptr);
 }
 
 //////////////////////////////////////////////////
 bool Waypoint::IsEntry() const
 {
-  return this->dataPtr->isEntry;
+  return this->isEntry;
 }
 
 //////////////////////////////////////////////////
 void Waypoint::SetEntry(const bool _newValue)
 {
-  this->dataPtr->isEntry = _newValue;
+  this->isEntry = _newValue;
 }
 
 //////////////////////////////////////////////////
 bool Waypoint::IsExit() const
 {
-  return this->dataPtr->isExit;
+  return this->isExit;
 }
 
 //////////////////////////////////////////////////
 void Waypoint::SetExit(const bool _newValue)
 {
-  this->dataPtr->isExit = _newValue;
+  this->isExit = _newValue;
 }
 
 //////////////////////////////////////////////////
@@ -243,9 +279,37 @@ bool Waypoint::operator!=(const Waypoint &_other) const
 //////////////////////////////////////////////////
 Waypoint &Waypoint::operator=(const Waypoint &_other)
 {
+  if (this == &_other)
+    return *this;
+
   this->SetId(_other.Id());
-  this->dataPtr->location = _other.dataPtr->location;
-  this->dataPtr->isExit = _other.IsExit();
-  this->dataPtr->isEntry = _other.IsEntry();
+  this->latitude = _other.latitude;
+  this->longitude = _other.longitude;
+  this->locationExposed = _other.locationExposed;
+
+  // Only a location that may have been modified is copied. Otherwise the
+  // copy creates it on demand.
+  ignition::math::SphericalCoordinates *copy = nullptr;
+  if (_other.locationExposed)
+  {
+    copy = new ignition::math::SphericalCoordinates(
+      *_other.location.load(std::memory_order_acquire));
+  }
+  delete this->location.exchange(copy);
+  this->isExit = _other.IsExit();
+  this->isEntry = _other.IsEntry();
+  return *this;
+}
+
+//////////////////////////////////////////////////
+Waypoint &Waypoint::operator=(Waypoint &&_other) noexcept  // NOLINT
+{
+  std::swap(this->id, _other.id);
+  std::swap(this->isEntry, _other.isEntry);
+  std::swap(this->isExit, _other.isExit);
+  std::swap(this->locationExposed, _other.locationExposed);
+  std::swap(this->latitude, _other.latitude);
+  std::swap(this->longitude, _other.longitude);
+  _other.location.store(this->location.exchange(_other.location.load()));
   return *this;
 }
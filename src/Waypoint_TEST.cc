@@ -17,7 +17,10 @@
 
 #include <map>
 #include <string>
+#include <thread>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <ignition/math/Angle.hh>
 #include <ignition/math/Helpers.hh>
@@ -95,6 +98,89 @@ TEST(Waypoint, location)
   EXPECT_EQ(nonMutablelocation, location);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check that threads reading the location of the same waypoints
+/// get the same objects.
+TEST(Waypoint, concurrentLocation)
+{
+  const int kWaypoints = 1000;
+  const int kThreads = 4;
+  std::vector<Waypoint> waypoints;
+  for (int i = 0; i < kWaypoints; ++i)
+    waypoints.push_back(Waypoint(i + 1, 10 + i * 1e-3, 20 - i * 1e-3));
+  const std::vector<Waypoint> &constWaypoints = waypoints;
+
+  std::vector<std::vector<const ignition::math::SphericalCoordinates *>>
+    locations(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t)
+  {
+    threads.emplace_back([&, t]()
+    {
+      for (auto const &wp : constWaypoints)
+        locations[t].push_back(&wp.Location());
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (int i = 0; i < kWaypoints; ++i)
+  {
+    for (int t = 1; t < kThreads; ++t)
+      EXPECT_EQ(locations[t][i], locations[0][i]);
+    EXPECT_DOUBLE_EQ(locations[0][i]->LatitudeReference().Degree(),
+      constWaypoints[i].Latitude());
+    EXPECT_DOUBLE_EQ(locations[0][i]->LongitudeReference().Degree(),
+      constWaypoints[i].Longitude());
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Check the latitude/longitude accessors and their consistency with
+/// the location created on demand.
+TEST(Waypoint, latitudeLongitude)
+{
+  Waypoint waypoint(1, 34.587489, -117.367106);
+  EXPECT_TRUE(waypoint.Valid());
+  EXPECT_DOUBLE_EQ(waypoint.Latitude(), 34.587489);
+  EXPECT_DOUBLE_EQ(waypoint.Longitude(), -117.367106);
+
+  // The location is created from the latitude and longitude.
+  const Waypoint &constWaypoint = waypoint;
+  auto const &sc = constWaypoint.Location();
+  EXPECT_EQ(sc.Surface(),
+    ignition::math::SphericalCoordinates::EARTH_WGS84);
+  EXPECT_DOUBLE_EQ(sc.LatitudeReference().Degree(), 34.587489);
+  EXPECT_DOUBLE_EQ(sc.LongitudeReference().Degree(), -117.367106);
+  EXPECT_DOUBLE_EQ(sc.ElevationReference(), 0.0);
+
+  // Reading the location doesn't change the values stored.
+  EXPECT_DOUBLE_EQ(waypoint.Latitude(), 34.587489);
+  EXPECT_DOUBLE_EQ(waypoint.Longitude(), -117.367106);
+
+  // Changes through the mutable accessor are visible.
+  waypoint.Location().SetLatitudeReference(ignition::math::Angle(0.5));
+  EXPECT_DOUBLE_EQ(waypoint.Latitude(), IGN_RTOD(0.5));
+  EXPECT_DOUBLE_EQ(waypoint.Longitude(), -117.367106);
+
+  // Copies keep the modified location.
+  Waypoint copy(waypoint);
+  EXPECT_DOUBLE_EQ(copy.Latitude(), IGN_RTOD(0.5));
+  EXPECT_EQ(copy.Location(), waypoint.Location());
+
+  // SetLocation() replaces it.
+  waypoint.SetLocation(10.5, -20.25);
+  EXPECT_DOUBLE_EQ(waypoint.Latitude(), 10.5);
+  EXPECT_DOUBLE_EQ(waypoint.Longitude(), -20.25);
+  EXPECT_DOUBLE_EQ(waypoint.Location().LatitudeReference().Degree(), 10.5);
+  EXPECT_DOUBLE_EQ(copy.Latitude(), IGN_RTOD(0.5));
+
+  // Invalid Ids leave the location untouched.
+  Waypoint wrongWp(-1, 10.5, -20.25);
+  EXPECT_FALSE(wrongWp.Valid());
+  EXPECT_DOUBLE_EQ(wrongWp.Latitude(), 0.0);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check exit/entry accessors.
 TEST(Waypoint, exitEntry)
@@ -208,6 +294,37 @@ TEST(Waypoint, assignment)
   EXPECT_EQ(wp1, wp2);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check move constructor and move assignment operator.
+TEST(Waypoint, move)
+{
+  static_assert(std::is_nothrow_move_constructible<Waypoint>::value &&
+    std::is_nothrow_move_assignable<Waypoint>::value,
+    "Waypoint should be nothrow movable");
+
+  ignition::math::SphericalCoordinates::SurfaceType st =
+    ignition::math::SphericalCoordinates::EARTH_WGS84;
+  ignition::math::Angle lat(0.3), lon(-1.2), heading(0.5);
+  double elev = 354.1;
+  ignition::math::SphericalCoordinates sc(st, lat, lon, elev, heading);
+
+  Waypoint wp1(1, sc);
+  wp1.SetExit(true);
+  Waypoint wp2(std::move(wp1));
+  EXPECT_EQ(wp2.Id(), 1);
+  EXPECT_EQ(wp2.Location(), sc);
+  EXPECT_TRUE(wp2.IsExit());
+
+  // A moved-from waypoint can be assigned to.
+  wp1 = wp2;
+  EXPECT_EQ(wp1, wp2);
+
+  Waypoint wp3(3, ignition::math::SphericalCoordinates());
+  wp3 = std::move(wp2);
+  EXPECT_EQ(wp3.Id(), 1);
+  EXPECT_EQ(wp3.Location(), sc);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check loading a waypoint from a file.
 TEST_F(WaypointTest, load)
@@ -279,6 +396,20 @@ TEST_F(WaypointTest, load)
       "\n\n"
       "6.3.1  34.579979   -117.365607 /* a comment  */ \n"
                                                     , true, 8, 3),
+    // Only a valid prefix of the coordinates is required.
+    std::make_tuple(
+      "\n\n"
+      "6.3.2 34.582012abc -117.351657+1\n"
+                                                    , true, 9, 3),
+    std::make_tuple(
+      "\n\n"
+      "6.3.3 38.86.300 38.866291-1\n"
+                                                    , true, 10, 3),
+    // Characters after the waypoint Id.
+    std::make_tuple(
+      "\n\n"
+      "6.3.1x 34.579979 -117.365607\n"
+                                                    , false, 11, 3),
   };
 
   for (auto const &testCase : testCases)
@@ -321,6 +452,20 @@ TEST_F(WaypointTest, load)
           EXPECT_EQ(w.Location(), loc);
           break;
         }
+        case 9:
+        {
+          EXPECT_EQ(w.Id(), 2);
+          EXPECT_DOUBLE_EQ(w.Latitude(), 34.582012);
+          EXPECT_DOUBLE_EQ(w.Longitude(), -117.351657);
+          break;
+        }
+        case 10:
+        {
+          EXPECT_EQ(w.Id(), 3);
+          EXPECT_DOUBLE_EQ(w.Latitude(), 38.86);
+          EXPECT_DOUBLE_EQ(w.Longitude(), 38.866291);
+          break;
+        }
         default:
           break;
       };
@@ -20,11 +20,18 @@
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "ignition/rndf/Arena.hh"
+#include "ignition/rndf/LineReader.hh"
 #include "ignition/rndf/ParkingSpot.hh"
 #include "ignition/rndf/ParserUtils.hh"
 #include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDFBuilder.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+#include "ignition/rndf/RNDFWriter.hh"
+#include "ignition/rndf/UniqueId.hh"
 #include "ignition/rndf/Zone.hh"
 
 using namespace ignition;
@@ -36,7 +43,7 @@ namespace ignition
   {
     /// \internal
     /// \brief Private data for ZoneHeader class.
-    class ZoneHeaderPrivate
+    class ZoneHeaderPrivate : public ArenaObject
     {
       /// \brief Default constructor.
       public: ZoneHeaderPrivate() = default;
@@ -50,7 +57,7 @@ namespace ignition
 
     /// \internal
     /// \brief Private data for Zone class.
-    class ZonePrivate
+    class ZonePrivate : public ArenaObject
     {
       /// \brief Constructor.
       /// \param[in] _id Zone Id.
@@ -89,42 +96,44 @@ ZoneHeader::~ZoneHeader()
 }
 
 //////////////////////////////////////////////////
-bool ZoneHeader::Load(std::ifstream &_rndfFile, int &_lineNumber)
+bool ZoneHeader::Load(LineReader &_reader, int &_lineNumber)
 {
-  auto oldPos = _rndfFile.tellg();
-  int oldLineNumber = _lineNumber;
-
-  std::string lineread;
-  nextRealLine(_rndfFile, lineread, _lineNumber);
+  StringView lineread;
+  _reader.Peek(lineread);
 
-  auto tokens = split(lineread, " ");
+  Tokens tokens;
+  tokenize(lineread, " ", tokens);
 
   // Check if we found the "perimeter" element.
-  // If this is the case we should leave.
-  if (tokens.size() == 2 && tokens.at(0) == "perimeter")
-  {
-    // Restore the file position and line number.
-    // ParseHeader() shouldn't have any effect.
-    _rndfFile.seekg(oldPos);
-    _lineNumber = oldLineNumber;
+  // If this is the case we should leave it for the perimeter parser.
+  if (tokens.Size() == 2 && tokens[0] == "perimeter")
     return true;
-  }
 
-  if (tokens.size() != 2 || tokens.at(0) != "zone_name")
+  _reader.Consume(_lineNumber);
+
+  if (tokens.Size() != 2 || tokens[0] != "zone_name")
   {
     // Invalid or header element.
-    std::cerr << "[Line " << _lineNumber << "]: Unable to parse zone header "
-              << "element" << std::endl;
-    std::cerr << " \"" << lineread << "\"" << std::endl;
+    errorStream() << "[Line " << _lineNumber
+                  << "]: Unable to parse zone header "
+                  << "element" << std::endl;
+    errorStream() << " \"" << lineread << "\"" << std::endl;
     return false;
   }
 
-  assert(tokens.size() == 2);
+  assert(tokens.Size() == 2);
 
-  this->SetName(tokens[1]);
+  this->SetName(tokens[1].String());
   return true;
 }
 
+//////////////////////////////////////////////////
+bool ZoneHeader::Load(std::ifstream &_rndfFile, int &_lineNumber)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _lineNumber);
+}
+
 //////////////////////////////////////////////////
 std::string ZoneHeader::Name() const
 {
@@ -160,69 +169,109 @@ Zone::Zone(const Zone &_other)
   *this = _other;
 }
 
+//////////////////////////////////////////////////
+Zone::Zone(Zone &&_other) noexcept  // NOLINT
+  : dataPtr(std::move(_other.dataPtr))
+{
+}
+
 //////////////////////////////////////////////////
 Zone::~Zone()
 {
 }
 
 //////////////////////////////////////////////////
-bool Zone::Load(std::ifstream &_rndfFile, int &_lineNumber,
+bool Zone::Load(LineReader &_reader, int &_lineNumber,
   std::vector<ExitCacheEntry> &_exitCache,
-  std::vector<std::string> &_waypointCache)
+  std::vector<uint64_t> &_waypointCache)
 {
+  RNDFBuilder builder(_exitCache, _waypointCache);
   int zoneId;
-  if (!parsePositive(_rndfFile, "zone", zoneId, _lineNumber))
+  if (!Parse(_reader, _lineNumber, builder, zoneId))
+    return false;
+
+  *this = std::move(builder.Zones().back());
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Zone::Parse(LineReader &_reader, int &_lineNumber,
+  RNDFVisitor &_visitor, int &_zoneId)
+{
+  int zoneId;
+  if (!parsePositive(_reader, "zone", zoneId, _lineNumber))
     return false;
 
   int numSpots;
-  if (!parseNonNegative(_rndfFile, "num_spots", numSpots, _lineNumber))
+  if (!parseNonNegative(_reader, "num_spots", numSpots, _lineNumber))
     return false;
 
   // Parse the optional zone header.
   ZoneHeader header;
-  if (!header.Load(_rndfFile, _lineNumber))
+  if (!header.Load(_reader, _lineNumber))
     return false;
 
+  _visitor.OnZone(zoneId, numSpots, header.Name());
+
   // Parse the perimeter.
-  rndf::Perimeter perimeter;
-  if (!perimeter.Load(_rndfFile, zoneId, _lineNumber, _exitCache,
-    _waypointCache))
-  {
+  if (!rndf::Perimeter::Parse(_reader, zoneId, _lineNumber, _visitor))
     return false;
-  }
 
   // Parse parking spots.
-  std::vector<rndf::ParkingSpot> spots;
   for (auto i = 0; i < numSpots; ++i)
   {
-    rndf::ParkingSpot spot;
-    if (!spot.Load(_rndfFile, zoneId, _lineNumber))
+    int spotId;
+    if (!ParkingSpot::Parse(_reader, zoneId, _lineNumber, _visitor, spotId))
       return false;
 
     // Check that all spots are consecutive.
-    if (spot.Id() != i + 1)
+    if (spotId != i + 1)
     {
-      std::cerr << "[Line " << _lineNumber << "]: Found non-consecutive spot "
-                << "Id [" << spot.Id() << "]" << std::endl;
+      errorStream() << "[Line " << _lineNumber
+                    << "]: Found non-consecutive spot "
+                    << "Id [" << spotId << "]" << std::endl;
       return false;
     }
-
-    spots.push_back(spot);
   }
 
   // Parse "end_zone".
-  if (!parseDelimiter(_rndfFile, "end_zone", _lineNumber))
+  if (!parseDelimiter(_reader, "end_zone", _lineNumber))
     return false;
 
-  // Populate the zone.
-  this->SetId(zoneId);
-  this->Spots() = spots;
-  this->Perimeter() = perimeter;
-  this->SetName(header.Name());
-
+  _zoneId = zoneId;
   return true;
 }
 
+//////////////////////////////////////////////////
+bool Zone::Load(std::ifstream &_rndfFile, int &_lineNumber,
+  std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<uint64_t> &_waypointCache)
+{
+  LineReader reader(_rndfFile);
+  return this->Load(reader, _lineNumber, _exitCache, _waypointCache);
+}
+
+//////////////////////////////////////////////////
+bool Zone::Load(std::ifstream &_rndfFile, int &_lineNumber,
+  std::vector<ExitCacheEntry> &_exitCache,
+  std::vector<std::string> &_waypointCache)
+{
+  std::vector<uint64_t> waypointKeys;
+  const bool result = this->Load(_rndfFile, _lineNumber, _exitCache,
+    waypointKeys);
+  for (const uint64_t key : waypointKeys)
+    _waypointCache.push_back(UniqueId::FromKey(key).String());
+  return result;
+}
+
+//////////////////////////////////////////////////
+bool Zone::Save(std::ostream &_stream) const
+{
+  RNDFWriter writer(_stream);
+  writer.WriteZone(*this);
+  return writer.Flush();
+}
+
 //////////////////////////////////////////////////
 int Zone::Id() const
 {
@@ -259,31 +308,33 @@ const std::vector<ParkingSpot> &Zone::Spots() const
 //////////////////////////////////////////////////
 bool Zone::Spot(const int _psId, ParkingSpot &_ps) const
 {
-  auto it = std::find_if(this->dataPtr->spots.begin(),
-    this->dataPtr->spots.end(),
-    [_psId](const ParkingSpot &_spot)
-    {
-      return _spot.Id() == _psId;
-    });
+  const ParkingSpot *spot = this->Spot(_psId);
+  if (spot)
+    _ps = *spot;
 
-  bool found = it != this->dataPtr->spots.end();
-  if (found)
-    _ps = *it;
+  return spot != nullptr;
+}
 
-  return found;
+//////////////////////////////////////////////////
+const ParkingSpot *Zone::Spot(const int _psId) const
+{
+  return findById(this->dataPtr->spots, _psId);
 }
 
 //////////////////////////////////////////////////
-bool Zone::UpdateSpot(const ParkingSpot &_ps)
+ParkingSpot *Zone::Spot(const int _psId)
 {
-  auto it = std::find(this->dataPtr->spots.begin(),
-    this->dataPtr->spots.end(), _ps);
+  return findById(this->dataPtr->spots, _psId);
+}
 
-  bool found = it != this->dataPtr->spots.end();
-  if (found)
-    *it = _ps;
+//////////////////////////////////////////////////
+bool Zone::UpdateSpot(const ParkingSpot &_ps)
+{
+  ParkingSpot *spot = this->Spot(_ps.Id());
+  if (spot)
+    *spot = _ps;
 
-  return found;
+  return spot != nullptr;
 }
 
 //////////////////////////////////////////////////
@@ -292,8 +343,8 @@ bool Zone::AddSpot(const ParkingSpot &_newSpot)
   // Validate the parking spot.
   if (!_newSpot.Valid())
   {
-    std::cerr << "[Zone::AddSpot() Invalid parking spot Id ["
-              << _newSpot.Id() << "]" << std::endl;
+    errorStream() << "[Zone::AddSpot() Invalid parking spot Id ["
+                  << _newSpot.Id() << "]" << std::endl;
     return false;
   }
 
@@ -301,7 +352,7 @@ bool Zone::AddSpot(const ParkingSpot &_newSpot)
   if (std::find(this->dataPtr->spots.begin(),
         this->dataPtr->spots.end(), _newSpot) != this->dataPtr->spots.end())
   {
-    std::cerr << "[Zone::AddSpot() error: Existing spot" << std::endl;
+    errorStream() << "[Zone::AddSpot() error: Existing spot" << std::endl;
     return false;
   }
 
@@ -380,9 +431,20 @@ bool Zone::operator!=(const Zone &_other) const
 //////////////////////////////////////////////////
 Zone &Zone::operator=(const Zone &_other)
 {
+  // This instance might have been moved from.
+  if (!this->dataPtr)
+    this->dataPtr.reset(new ZonePrivate(-1));
+
   this->SetId(_other.Id());
   this->Spots() = _other.Spots();
   this->Perimeter() = _other.Perimeter();
   this->SetName(_other.Name());
   return *this;
 }
+
+//////////////////////////////////////////////////
+Zone &Zone::operator=(Zone &&_other) noexcept  // NOLINT
+{
+  std::swap(this->dataPtr, _other.dataPtr);
+  return *this;
+}
@@ -19,6 +19,8 @@
 #include <map>
 #include <string>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SphericalCoordinates.hh>
@@ -135,6 +137,33 @@ TEST(Zone, spots)
   EXPECT_EQ(zone.NumSpots(), 0u);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check the accessors of spots by Id that don't copy them.
+TEST(Zone, spotById)
+{
+  Zone zone(1);
+  for (auto const id : {1, 2, 4})
+    zone.Spots().emplace_back(id);
+  const Zone &constZone = zone;
+
+  // Consecutive and non-consecutive Ids.
+  EXPECT_EQ(constZone.Spot(1), &constZone.Spots().at(0));
+  EXPECT_EQ(constZone.Spot(2), &constZone.Spots().at(1));
+  EXPECT_EQ(constZone.Spot(4), &constZone.Spots().at(2));
+  EXPECT_EQ(constZone.Spot(3), nullptr);
+  EXPECT_EQ(constZone.Spot(0), nullptr);
+  EXPECT_EQ(constZone.Spot(-1), nullptr);
+
+  // Edit a spot in place.
+  ParkingSpot *mutableSpot = zone.Spot(4);
+  ASSERT_TRUE(mutableSpot != nullptr);
+  mutableSpot->SetWidth(3.5);
+  ParkingSpot copy;
+  EXPECT_TRUE(zone.Spot(4, copy));
+  EXPECT_DOUBLE_EQ(copy.Width(), 3.5);
+  EXPECT_EQ(zone.Spot(5), nullptr);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check perimeter-related functions.
 TEST(Zone, perimeter)
@@ -261,6 +290,34 @@ TEST(Zone, assignment)
   EXPECT_EQ(zone1, zone2);
 }
 
+//////////////////////////////////////////////////
+/// \brief Check move constructor and move assignment operator.
+TEST(Zone, move)
+{
+  static_assert(std::is_nothrow_move_constructible<Zone>::value &&
+    std::is_nothrow_move_assignable<Zone>::value,
+    "Zone should be nothrow movable");
+
+  Zone zone1(1);
+  zone1.Spots().push_back(ParkingSpot(1));
+  zone1.SetName("lot");
+
+  Zone zone2(std::move(zone1));
+  EXPECT_EQ(zone2.Id(), 1);
+  EXPECT_EQ(zone2.NumSpots(), 1u);
+  EXPECT_EQ(zone2.Name(), "lot");
+
+  // A moved-from zone can be assigned to.
+  zone1 = zone2;
+  EXPECT_EQ(zone1.Id(), 1);
+  EXPECT_EQ(zone1.NumSpots(), 1u);
+
+  Zone zone3(3);
+  zone3 = std::move(zone2);
+  EXPECT_EQ(zone3.Id(), 1);
+  EXPECT_EQ(zone3.NumSpots(), 1u);
+}
+
 //////////////////////////////////////////////////
 /// \brief Check loading a zone from a text file.
 TEST_F(ZoneTest, Load)
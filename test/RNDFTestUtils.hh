@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_TEST_RNDFTESTUTILS_HH_
+#define IGNITION_RNDF_TEST_RNDFTESTUTILS_HH_
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+
+namespace testing
+{
+  /// \brief Check that two waypoints are identical.
+  /// \param[in] _expected Expected waypoint.
+  /// \param[in] _wp Waypoint checked.
+  inline void expectEqualWaypoint(const ignition::rndf::Waypoint &_expected,
+    const ignition::rndf::Waypoint &_wp)
+  {
+    EXPECT_EQ(_expected.Id(), _wp.Id());
+    EXPECT_DOUBLE_EQ(_expected.Latitude(), _wp.Latitude());
+    EXPECT_DOUBLE_EQ(_expected.Longitude(), _wp.Longitude());
+    EXPECT_EQ(_expected.IsEntry(), _wp.IsEntry());
+    EXPECT_EQ(_expected.IsExit(), _wp.IsExit());
+  }
+
+  /// \brief Check that two exits are identical.
+  /// \param[in] _expected Expected exit.
+  /// \param[in] _exit Exit checked.
+  inline void expectEqualExit(const ignition::rndf::Exit &_expected,
+    const ignition::rndf::Exit &_exit)
+  {
+    EXPECT_EQ(_expected.ExitId(), _exit.ExitId());
+    EXPECT_EQ(_expected.EntryId(), _exit.EntryId());
+  }
+
+  /// \brief Check that two lists of waypoints are identical.
+  /// \param[in] _wps1 First list.
+  /// \param[in] _wps2 Second list.
+  inline void expectEqualWaypoints(
+    const std::vector<ignition::rndf::Waypoint> &_wps1,
+    const std::vector<ignition::rndf::Waypoint> &_wps2)
+  {
+    ASSERT_EQ(_wps1.size(), _wps2.size());
+    for (size_t i = 0; i < _wps1.size(); ++i)
+      expectEqualWaypoint(_wps1[i], _wps2[i]);
+  }
+
+  /// \brief Check that two lists of exits are identical.
+  /// \param[in] _exits1 First list.
+  /// \param[in] _exits2 Second list.
+  inline void expectEqualExits(const std::vector<ignition::rndf::Exit> &_exits1,
+    const std::vector<ignition::rndf::Exit> &_exits2)
+  {
+    ASSERT_EQ(_exits1.size(), _exits2.size());
+    for (size_t i = 0; i < _exits1.size(); ++i)
+      expectEqualExit(_exits1[i], _exits2[i]);
+  }
+
+  /// \brief Check that two RNDFs are identical, including the values that
+  /// the equality operators of the elements ignore.
+  /// \param[in] _rndf1 First RNDF.
+  /// \param[in] _rndf2 Second RNDF.
+  inline void expectEqualRNDF(const ignition::rndf::RNDF &_rndf1,
+    const ignition::rndf::RNDF &_rndf2)
+  {
+    EXPECT_EQ(_rndf1.Name(), _rndf2.Name());
+    EXPECT_EQ(_rndf1.Version(), _rndf2.Version());
+    EXPECT_EQ(_rndf1.Date(), _rndf2.Date());
+
+    ASSERT_EQ(_rndf1.NumSegments(), _rndf2.NumSegments());
+    for (size_t i = 0; i < _rndf1.NumSegments(); ++i)
+    {
+      const ignition::rndf::Segment &s1 = _rndf1.Segments()[i];
+      const ignition::rndf::Segment &s2 = _rndf2.Segments()[i];
+      EXPECT_EQ(s1.Id(), s2.Id());
+      EXPECT_EQ(s1.Name(), s2.Name());
+      ASSERT_EQ(s1.NumLanes(), s2.NumLanes());
+      for (size_t j = 0; j < s1.NumLanes(); ++j)
+      {
+        const ignition::rndf::Lane &l1 = s1.Lanes()[j];
+        const ignition::rndf::Lane &l2 = s2.Lanes()[j];
+        EXPECT_EQ(l1.Id(), l2.Id());
+        EXPECT_DOUBLE_EQ(l1.Width(), l2.Width());
+        EXPECT_EQ(l1.LeftBoundary(), l2.LeftBoundary());
+        EXPECT_EQ(l1.RightBoundary(), l2.RightBoundary());
+        expectEqualWaypoints(l1.Waypoints(), l2.Waypoints());
+        expectEqualExits(l1.Exits(), l2.Exits());
+        EXPECT_EQ(l1.Checkpoints(), l2.Checkpoints());
+        EXPECT_EQ(l1.Stops(), l2.Stops());
+      }
+    }
+
+    ASSERT_EQ(_rndf1.NumZones(), _rndf2.NumZones());
+    for (size_t i = 0; i < _rndf1.NumZones(); ++i)
+    {
+      const ignition::rndf::Zone &z1 = _rndf1.Zones()[i];
+      const ignition::rndf::Zone &z2 = _rndf2.Zones()[i];
+      EXPECT_EQ(z1.Id(), z2.Id());
+      EXPECT_EQ(z1.Name(), z2.Name());
+      expectEqualWaypoints(z1.Perimeter().Points(), z2.Perimeter().Points());
+      expectEqualExits(z1.Perimeter().Exits(), z2.Perimeter().Exits());
+      ASSERT_EQ(z1.NumSpots(), z2.NumSpots());
+      for (size_t j = 0; j < z1.NumSpots(); ++j)
+      {
+        const ignition::rndf::ParkingSpot &p1 = z1.Spots()[j];
+        const ignition::rndf::ParkingSpot &p2 = z2.Spots()[j];
+        EXPECT_EQ(p1.Id(), p2.Id());
+        EXPECT_DOUBLE_EQ(p1.Width(), p2.Width());
+        EXPECT_EQ(p1.Checkpoint(), p2.Checkpoint());
+        expectEqualWaypoints(p1.Waypoints(), p2.Waypoints());
+      }
+    }
+  }
+}
+
+#endif
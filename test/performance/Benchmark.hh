@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_TEST_PERFORMANCE_BENCHMARK_HH_
+#define IGNITION_RNDF_TEST_PERFORMANCE_BENCHMARK_HH_
+
+// Measurement and allocation counting shared by the performance tests.
+//
+// Every performance test is a single source file, which includes this header
+// once. It replaces the global operator new and delete of the test, so the
+// replacements can't be inline and the header can't be included by two
+// source files linked together.
+//
+// The measurements are reported as one JSON object per line, e.g.:
+//
+//   {"benchmark": "load", "input": "sample1.rndf", "items": 164,
+//    "seconds": 0.00028, "items_per_second": 593098, "allocations": 777,
+//    "deallocations": 356, "live_bytes": 78216, "peak_bytes": 101344,
+//    "peak_rss_kib": 4256}
+//
+// followed by any extra values of the measurement. The lines are written to
+// stdout and, if the RNDF_BENCHMARK_OUTPUT environment variable is set,
+// appended to the file it names.
+
+#ifndef _WIN32
+  #include <sys/resource.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+  namespace rndf
+  {
+    namespace benchmark
+    {
+      /// \brief Counters of the global operator new and delete.
+      class AllocationCounters
+      {
+        /// \brief Number of allocations performed by operator new.
+        public: std::atomic<size_t> allocations;
+
+        /// \brief Number of blocks released by operator delete.
+        public: std::atomic<size_t> deallocations;
+
+        /// \brief Bytes currently allocated with operator new.
+        public: std::atomic<size_t> liveBytes;
+
+        /// \brief Maximum value reached by liveBytes since it was last
+        /// reset.
+        public: std::atomic<size_t> peakBytes;
+      };
+
+      /// \brief Get the allocation counters of the process. They are zero
+      /// initialized before any allocation.
+      /// \return The counters.
+      inline AllocationCounters &allocationCounters()
+      {
+        static AllocationCounters counters;
+        return counters;
+      }
+
+      /// \brief Bytes reserved in front of every allocation to store its
+      /// size. It preserves the alignment of the memory returned by malloc().
+      const size_t kAllocationHeader = alignof(std::max_align_t);
+
+      /// \brief Get the number of allocations performed by operator new.
+      /// \return The number of allocations.
+      inline size_t allocations()
+      {
+        return allocationCounters().allocations.load(
+          std::memory_order_relaxed);
+      }
+
+      /// \brief Get the bytes currently allocated with operator new.
+      /// \return The bytes.
+      inline size_t liveBytes()
+      {
+        return allocationCounters().liveBytes.load(std::memory_order_relaxed);
+      }
+
+      /// \brief Get the maximum value of liveBytes() since the last call to
+      /// resetPeakBytes().
+      /// \return The bytes.
+      inline size_t peakBytes()
+      {
+        return allocationCounters().peakBytes.load(std::memory_order_relaxed);
+      }
+
+      /// \brief Start tracking the peak of liveBytes() from its current
+      /// value.
+      inline void resetPeakBytes()
+      {
+        allocationCounters().peakBytes.store(liveBytes(),
+          std::memory_order_relaxed);
+      }
+
+      /// \brief Get the peak resident set size of the process.
+      /// \return The peak RSS in KiB or -1 if it's not available.
+      inline int64_t peakRssKiB()
+      {
+#ifndef _WIN32
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+        {
+#ifdef __APPLE__
+          return usage.ru_maxrss / 1024;
+#else
+          return usage.ru_maxrss;
+#endif
+        }
+#endif
+        return -1;
+      }
+
+      /// \brief Get the resident set size of the process.
+      /// \return The RSS in KiB or -1 if it's not available.
+      inline int64_t currentRssKiB()
+      {
+#ifndef _WIN32
+        // Only available on Linux.
+        std::ifstream statm("/proc/self/statm");
+        int64_t pages;
+        int64_t resident;
+        if (statm >> pages >> resident)
+          return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+        return -1;
+      }
+
+      /// \brief Get the value of a size_t environment variable.
+      /// \param[in] _name Name of the variable.
+      /// \param[in] _default Value used when the variable isn't set.
+      /// \return The value.
+      inline size_t sizeFromEnv(const char *_name, const size_t _default)
+      {
+        if (const char *value = std::getenv(_name))
+          return std::strtoul(value, nullptr, 10);
+        return _default;
+      }
+
+      /// \brief Measures the time and allocations of a benchmark and reports
+      /// them.
+      class Measurement
+      {
+        /// \brief Constructor. Starts measuring.
+        /// \param[in] _benchmark Name of the benchmark.
+        /// \param[in] _input Name of the input data.
+        public: Measurement(const std::string &_benchmark,
+                            const std::string &_input)
+          : benchmark(_benchmark),
+            input(_input)
+        {
+          this->Restart();
+        }
+
+        /// \brief Start measuring again, e.g. after preparing the input.
+        public: void Restart()
+        {
+          AllocationCounters &counters = allocationCounters();
+          this->allocationsBefore = counters.allocations;
+          this->deallocationsBefore = counters.deallocations;
+          this->liveBytesBefore = liveBytes();
+          resetPeakBytes();
+          this->stopped = false;
+          this->start = std::chrono::steady_clock::now();
+        }
+
+        /// \brief Add a value to the report, such as a ratio or a size.
+        /// \param[in] _key Name of the value.
+        /// \param[in] _value The value.
+        public: void Add(const std::string &_key, const double _value)
+        {
+          this->extra.push_back(std::make_pair(_key, _value));
+        }
+
+        /// \brief Stop measuring, e.g. before computing a value to add to
+        /// the report. Report() stops measuring if this isn't called.
+        public: void Stop()
+        {
+          if (this->stopped)
+            return;
+
+          std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - this->start;
+          this->seconds = elapsed.count();
+          AllocationCounters &counters = allocationCounters();
+          this->allocated = counters.allocations - this->allocationsBefore;
+          this->released = counters.deallocations - this->deallocationsBefore;
+          this->live = static_cast<int64_t>(liveBytes()) -
+            static_cast<int64_t>(this->liveBytesBefore);
+          this->peak = peakBytes() - this->liveBytesBefore;
+          this->stopped = true;
+        }
+
+        /// \brief Stop measuring and report the results.
+        /// \param[in] _items Number of items processed (waypoints,
+        /// lookups...).
+        /// \return The seconds elapsed.
+        public: double Report(const size_t _items)
+        {
+          this->Stop();
+
+          std::ostringstream line;
+          line << "{\"benchmark\": \"" << this->benchmark << "\", "
+               << "\"input\": \"" << this->input << "\", "
+               << "\"items\": " << _items << ", "
+               << "\"seconds\": " << this->seconds << ", "
+               << "\"items_per_second\": " << _items / this->seconds << ", "
+               << "\"allocations\": " << this->allocated << ", "
+               << "\"deallocations\": " << this->released << ", "
+               << "\"live_bytes\": " << this->live << ", "
+               << "\"peak_bytes\": " << this->peak << ", "
+               << "\"peak_rss_kib\": " << peakRssKiB();
+          for (auto const &value : this->extra)
+            line << ", \"" << value.first << "\": " << value.second;
+          line << "}";
+
+          std::cout << line.str() << std::endl;
+          if (const char *path = std::getenv("RNDF_BENCHMARK_OUTPUT"))
+          {
+            std::ofstream output(path, std::ios::app);
+            output << line.str() << std::endl;
+          }
+          return this->seconds;
+        }
+
+        /// \brief Name of the benchmark.
+        private: std::string benchmark;
+
+        /// \brief Name of the input data.
+        private: std::string input;
+
+        /// \brief Extra values reported.
+        private: std::vector<std::pair<std::string, double>> extra;
+
+        /// \brief Allocations when the measurement started.
+        private: size_t allocationsBefore = 0;
+
+        /// \brief Deallocations when the measurement started.
+        private: size_t deallocationsBefore = 0;
+
+        /// \brief Live bytes when the measurement started.
+        private: size_t liveBytesBefore = 0;
+
+        /// \brief Time when the measurement started.
+        private: std::chrono::steady_clock::time_point start;
+
+        /// \brief Whether Stop() was called since the measurement started.
+        private: bool stopped = false;
+
+        /// \brief Seconds measured.
+        private: double seconds = 0;
+
+        /// \brief Allocations measured.
+        private: size_t allocated = 0;
+
+        /// \brief Deallocations measured.
+        private: size_t released = 0;
+
+        /// \brief Change of the live bytes measured.
+        private: int64_t live = 0;
+
+        /// \brief Peak of the live bytes measured.
+        private: size_t peak = 0;
+      };
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+void *operator new(std::size_t _size)
+{
+  using namespace ignition::rndf::benchmark;
+  char *ptr = static_cast<char *>(std::malloc(kAllocationHeader + _size));
+  if (!ptr)
+    throw std::bad_alloc();
+
+  *reinterpret_cast<size_t *>(ptr) = _size;
+  AllocationCounters &counters = allocationCounters();
+  counters.allocations.fetch_add(1, std::memory_order_relaxed);
+  const size_t live =
+    counters.liveBytes.fetch_add(_size, std::memory_order_relaxed) + _size;
+  size_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+  while (live > peak && !counters.peakBytes.compare_exchange_weak(peak, live,
+    std::memory_order_relaxed))
+  {
+  }
+  return ptr + kAllocationHeader;
+}
+
+/////////////////////////////////////////////////
+void operator delete(void *_ptr) noexcept
+{
+  using namespace ignition::rndf::benchmark;
+  if (!_ptr)
+    return;
+
+  void *ptr = reinterpret_cast<void *>(
+    reinterpret_cast<uintptr_t>(_ptr) - kAllocationHeader);
+  AllocationCounters &counters = allocationCounters();
+  counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+  counters.liveBytes.fetch_sub(*static_cast<size_t *>(ptr),
+    std::memory_order_relaxed);
+  std::free(ptr);
+}
+
+#endif
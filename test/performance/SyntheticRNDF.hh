@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef IGNITION_RNDF_TEST_PERFORMANCE_SYNTHETICRNDF_HH_
+#define IGNITION_RNDF_TEST_PERFORMANCE_SYNTHETICRNDF_HH_
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ignition
+{
+  namespace rndf
+  {
+    namespace benchmark
+    {
+      /// \brief Number of waypoints of every lane of a synthetic RNDF.
+      const int kSyntheticLaneWaypoints = 100;
+
+      /// \brief Append a waypoint line to a RNDF.
+      /// \param[in] _x Segment or zone Id.
+      /// \param[in] _y Lane or spot Id, or 0 for perimeter points.
+      /// \param[in] _z Waypoint Id.
+      /// \param[in] _lat Latitude.
+      /// \param[in] _lon Longitude.
+      /// \param[out] _content The RNDF content.
+      inline void appendSyntheticWaypoint(const int _x, const int _y,
+        const int _z, const double _lat, const double _lon,
+        std::string &_content)
+      {
+        char line[96];
+        std::snprintf(line, sizeof(line), "%d.%d.%d %.6f %.6f\n",
+          _x, _y, _z, _lat, _lon);
+        _content += line;
+      }
+
+      /// \brief Generate a valid RNDF with about _numWaypoints waypoints.
+      /// Every segment has two lanes of kSyntheticLaneWaypoints waypoints
+      /// running in opposite directions. The end of the first lane of each
+      /// segment exits to the start of the next segment and the end of the
+      /// second lane exits to the start of the first one. A single zone with
+      /// a perimeter and one parking spot follows the segments.
+      /// \param[in] _numWaypoints Approximate number of waypoints.
+      /// \return The RNDF content.
+      inline std::string syntheticRNDF(const size_t _numWaypoints)
+      {
+        const int w = kSyntheticLaneWaypoints;
+        int numSegments = static_cast<int>(_numWaypoints / (2 * w));
+        if (numSegments < 1)
+          numSegments = 1;
+        const int zoneId = numSegments + 1;
+
+        std::string content;
+        content.reserve((_numWaypoints + 1000) * 32);
+        content += "RNDF_name synthetic_" + std::to_string(_numWaypoints) +
+          "\n";
+        content += "num_segments " + std::to_string(numSegments) + "\n";
+        content += "num_zones 1\n";
+        content += "format_version 1.0\n";
+        content += "creation_date 01-Jan-17\n";
+
+        for (int s = 1; s <= numSegments; ++s)
+        {
+          const std::string seg = std::to_string(s);
+          const double lat = 37.0 + s * 0.001;
+          content += "segment " + seg + "\n";
+          content += "num_lanes 2\n";
+          content += "segment_name synthetic_road_" + seg + "\n";
+
+          for (int l = 1; l <= 2; ++l)
+          {
+            const std::string lane = seg + "." + std::to_string(l);
+            const std::string last = lane + "." + std::to_string(w);
+            content += "lane " + lane + "\n";
+            content += "num_waypoints " + std::to_string(w) + "\n";
+            content += "lane_width 12\n";
+            content += "left_boundary double_yellow\n";
+            content += "right_boundary solid_white\n";
+            if (l == 1 && s < numSegments)
+            {
+              content += "exit " + last + " " + std::to_string(s + 1) +
+                ".1.1\n";
+            }
+            else if (l == 2)
+              content += "exit " + last + " " + seg + ".1.1\n";
+            content += "stop " + last + "\n";
+
+            for (int z = 1; z <= w; ++z)
+            {
+              const int step = l == 1 ? z : w + 1 - z;
+              appendSyntheticWaypoint(s, l, z, lat + (l - 1) * 0.00005,
+                -122.0 + step * 0.00001, content);
+            }
+            content += "end_lane\n";
+          }
+          content += "end_segment\n";
+        }
+
+        const std::string zone = std::to_string(zoneId);
+        const double lat = 36.99;
+        content += "zone " + zone + "\n";
+        content += "num_spots 1\n";
+        content += "zone_name synthetic_parking\n";
+        content += "perimeter " + zone + ".0\n";
+        content += "num_perimeterpoints 4\n";
+        content += "exit " + zone + ".0.1 1.1.1\n";
+        appendSyntheticWaypoint(zoneId, 0, 1, lat, -122.0, content);
+        appendSyntheticWaypoint(zoneId, 0, 2, lat, -121.999, content);
+        appendSyntheticWaypoint(zoneId, 0, 3, lat - 0.001, -121.999, content);
+        appendSyntheticWaypoint(zoneId, 0, 4, lat - 0.001, -122.0, content);
+        content += "end_perimeter\n";
+        content += "spot " + zone + ".1\n";
+        content += "spot_width 16\n";
+        content += "checkpoint " + zone + ".1.2 1\n";
+        appendSyntheticWaypoint(zoneId, 1, 1, lat - 0.0005, -121.9995, content);
+        appendSyntheticWaypoint(zoneId, 1, 2, lat - 0.0006, -121.9995, content);
+        content += "end_spot\n";
+        content += "end_zone\n";
+        content += "end_file\n";
+        return content;
+      }
+
+      /// \brief Generate a valid RNDF with a grid of streets, like the road
+      /// network of a city. The intersections are _rows x _cols points 0.002
+      /// degrees apart. Every street between two neighbor intersections is a
+      /// segment with two lanes of _laneWaypoints waypoints, one per direction.
+      /// The end of every lane exits to the start of all the lanes leaving its
+      /// intersection, except the opposite lane of the same street. The lanes
+      /// of the north-south streets stop at the intersections.
+      /// \param[in] _rows Number of rows of intersections.
+      /// \param[in] _cols Number of columns of intersections.
+      /// \param[in] _laneWaypoints Number of waypoints of every lane (>= 2).
+      /// \return The RNDF content.
+      inline std::string syntheticGridRNDF(const int _rows, const int _cols,
+        const int _laneWaypoints)
+      {
+        // A street goes from intersection "from" to intersection "to".
+        struct Street
+        {
+          int from;
+          int to;
+        };
+        std::vector<Street> streets;
+        for (int r = 0; r < _rows; ++r)
+        {
+          for (int c = 0; c < _cols; ++c)
+          {
+            if (c + 1 < _cols)
+              streets.push_back({r * _cols + c, r * _cols + c + 1});
+            if (r + 1 < _rows)
+              streets.push_back({r * _cols + c, (r + 1) * _cols + c});
+          }
+        }
+
+        // Lanes leaving every intersection, as (segment, lane) pairs. Lane 1
+        // goes from "from" to "to" and lane 2 goes back.
+        std::vector<std::vector<std::pair<int, int>>> leaving(_rows * _cols);
+        for (size_t s = 0; s < streets.size(); ++s)
+        {
+          leaving[streets[s].from].push_back({static_cast<int>(s) + 1, 1});
+          leaving[streets[s].to].push_back({static_cast<int>(s) + 1, 2});
+        }
+
+        std::string content;
+        content.reserve(streets.size() * 2 * (_laneWaypoints + 8) * 32);
+        content += "RNDF_name synthetic_grid\n";
+        content += "num_segments " + std::to_string(streets.size()) + "\n";
+        content += "num_zones 0\n";
+        content += "format_version 1.0\n";
+        content += "creation_date 01-Jan-17\n";
+
+        for (size_t s = 0; s < streets.size(); ++s)
+        {
+          const int segmentId = static_cast<int>(s) + 1;
+          const std::string seg = std::to_string(segmentId);
+          const bool northSouth = streets[s].to - streets[s].from != 1;
+          content += "segment " + seg + "\n";
+          content += "num_lanes 2\n";
+
+          for (int l = 1; l <= 2; ++l)
+          {
+            const int from = l == 1 ? streets[s].from : streets[s].to;
+            const int to = l == 1 ? streets[s].to : streets[s].from;
+            const std::string lane = seg + "." + std::to_string(l);
+            const std::string last =
+              lane + "." + std::to_string(_laneWaypoints);
+            content += "lane " + lane + "\n";
+            content += "num_waypoints " + std::to_string(_laneWaypoints) + "\n";
+            content += "lane_width 12\n";
+            for (auto const &next : leaving[to])
+            {
+              if (next.first != segmentId)
+              {
+                content += "exit " + last + " " + std::to_string(next.first) +
+                  "." + std::to_string(next.second) + ".1\n";
+              }
+            }
+            if (northSouth)
+              content += "stop " + last + "\n";
+
+            // The lanes are 0.00003 degrees to the right of the street.
+            const double lat0 = 37.0 + (from / _cols) * 0.002;
+            const double lon0 = -122.0 + (from % _cols) * 0.002;
+            const double lat1 = 37.0 + (to / _cols) * 0.002;
+            const double lon1 = -122.0 + (to % _cols) * 0.002;
+            const double offsetLat = (lon0 - lon1) / 0.002 * 0.00003;
+            const double offsetLon = (lat1 - lat0) / 0.002 * 0.00003;
+            for (int z = 1; z <= _laneWaypoints; ++z)
+            {
+              const double t = (z - 1.0) / (_laneWaypoints - 1);
+              appendSyntheticWaypoint(segmentId, l, z,
+                lat0 + (lat1 - lat0) * t + offsetLat,
+                lon0 + (lon1 - lon0) * t + offsetLon, content);
+            }
+            content += "end_lane\n";
+          }
+          content += "end_segment\n";
+        }
+        content += "end_file\n";
+        return content;
+      }
+
+      /// \brief Write a synthetic RNDF to a file.
+      /// \param[in] _filePath Path of the file to create.
+      /// \param[in] _numWaypoints Approximate number of waypoints.
+      /// \return True on success.
+      /// \sa syntheticRNDF()
+      inline bool writeSyntheticRNDF(const std::string &_filePath,
+        const size_t _numWaypoints)
+      {
+        std::ofstream file(_filePath, std::ios::binary);
+        file << syntheticRNDF(_numWaypoints);
+        return file.good();
+      }
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+using benchmark::Measurement;
+
+// This suite reports one JSON line per measurement (see Benchmark.hh).
+// RNDF_BENCHMARK_MAX_WAYPOINTS sets the size of the largest synthetic
+// network loaded (100000 by default, up to 5000000).
+
+/////////////////////////////////////////////////
+/// \brief Count the waypoints of a RNDF.
+/// \param[in] _rndf The RNDF.
+/// \return The number of waypoints.
+size_t numWaypoints(const RNDF &_rndf)
+{
+  size_t n = 0;
+  for (auto const &segment : _rndf.Segments())
+    for (auto const &lane : segment.Lanes())
+      n += lane.NumWaypoints();
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    n += zone.Perimeter().NumPoints();
+    for (auto const &spot : zone.Spots())
+      n += spot.NumWaypoints();
+  }
+  return n;
+}
+
+/////////////////////////////////////////////////
+/// \brief Get the unique Ids of all the waypoints of a RNDF.
+/// \param[in] _rndf The RNDF.
+/// \return The unique Ids.
+std::vector<UniqueId> waypointIds(const RNDF &_rndf)
+{
+  std::vector<UniqueId> ids;
+  for (auto const &segment : _rndf.Segments())
+    for (auto const &lane : segment.Lanes())
+      for (auto const &wp : lane.Waypoints())
+        ids.push_back(UniqueId(segment.Id(), lane.Id(), wp.Id()));
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    for (auto const &wp : zone.Perimeter().Points())
+      ids.push_back(UniqueId(zone.Id(), 0, wp.Id()));
+    for (auto const &spot : zone.Spots())
+      for (auto const &wp : spot.Waypoints())
+        ids.push_back(UniqueId(zone.Id(), spot.Id(), wp.Id()));
+  }
+  return ids;
+}
+
+/////////////////////////////////////////////////
+/// \brief Path of a sample RNDF.
+/// \param[in] _name File name.
+/// \return The full path.
+std::string samplePath(const std::string &_name)
+{
+  return std::string(PROJECT_SOURCE_PATH) + "/test/rndf/" + _name;
+}
+
+/////////////////////////////////////////////////
+/// \brief RNDF::Load() with the sample files.
+TEST(Benchmark, LoadSamples)
+{
+  for (auto const &sample : {"sample1.rndf", "sample2.rndf"})
+  {
+    RNDF rndf;
+    Measurement m("load", sample);
+    ASSERT_TRUE(rndf.Load(samplePath(sample)));
+    m.Report(numWaypoints(rndf));
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief RNDF::Load() with synthetic networks of increasing size.
+TEST(Benchmark, LoadSynthetic)
+{
+  const size_t maxWaypoints =
+    benchmark::sizeFromEnv("RNDF_BENCHMARK_MAX_WAYPOINTS", 100000);
+
+  for (size_t size : {10000u, 100000u, 1000000u, 5000000u})
+  {
+    if (size > maxWaypoints)
+      break;
+
+    const std::string filePath = std::string(PROJECT_BINARY_PATH) +
+      "/synthetic_" + std::to_string(size) + ".rndf";
+    ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, size));
+
+    {
+      RNDF rndf;
+      Measurement m("load", "synthetic_" + std::to_string(size));
+      EXPECT_TRUE(rndf.Load(filePath));
+      m.Report(numWaypoints(rndf));
+      EXPECT_TRUE(rndf.Valid());
+    }
+
+    std::remove(filePath.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief RNDF::Load() and the destruction of the RNDF with synthetic
+/// networks, allocating the elements on the heap ("load" and "teardown")
+/// and in an arena ("load_arena" and "teardown_arena").
+TEST(Benchmark, Arena)
+{
+  const size_t maxWaypoints =
+    benchmark::sizeFromEnv("RNDF_BENCHMARK_MAX_WAYPOINTS", 100000);
+
+  for (size_t size : {10000u, 100000u, 1000000u})
+  {
+    if (size > maxWaypoints)
+      break;
+
+    const std::string input = "synthetic_" + std::to_string(size);
+    const std::string filePath =
+      std::string(PROJECT_BINARY_PATH) + "/" + input + ".rndf";
+    ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, size));
+
+    for (bool arena : {false, true})
+    {
+      const std::string suffix = arena ? "_arena" : "";
+      RNDF rndf;
+      rndf.SetArenaEnabled(arena);
+      Measurement load("load" + suffix, input);
+      EXPECT_TRUE(rndf.Load(filePath));
+      const size_t items = numWaypoints(rndf);
+      load.Report(items);
+
+      // The temporary receives the content, which is destroyed with it.
+      Measurement teardown("teardown" + suffix, input);
+      rndf = RNDF();
+      teardown.Report(items);
+    }
+
+    std::remove(filePath.c_str());
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief RNDF::Info() with all the waypoints of sample2.rndf.
+TEST(Benchmark, Info)
+{
+  RNDF rndf(samplePath("sample2.rndf"));
+  ASSERT_TRUE(rndf.Valid());
+  const std::vector<UniqueId> ids = waypointIds(rndf);
+  const int rounds = 1000;
+
+  size_t found = 0;
+  Measurement m("info", "sample2.rndf");
+  for (int i = 0; i < rounds; ++i)
+  {
+    for (auto const &id : ids)
+    {
+      if (rndf.Info(id))
+        ++found;
+    }
+  }
+  m.Report(ids.size() * rounds);
+  EXPECT_EQ(found, ids.size() * rounds);
+}
+
+/////////////////////////////////////////////////
+/// \brief RNDF::Segment(), RNDF::Zone() and Segment::Lane().
+TEST(Benchmark, Accessors)
+{
+  RNDF rndf(samplePath("sample2.rndf"));
+  ASSERT_TRUE(rndf.Valid());
+  const int rounds = 100;
+
+  {
+    rndf::Segment segment;
+    size_t lookups = 0;
+    Measurement m("segment", "sample2.rndf");
+    for (int i = 0; i < rounds; ++i)
+    {
+      for (auto const &s : rndf.Segments())
+      {
+        EXPECT_TRUE(rndf.Segment(s.Id(), segment));
+        ++lookups;
+      }
+    }
+    m.Report(lookups);
+  }
+
+  {
+    rndf::Zone zone;
+    size_t lookups = 0;
+    Measurement m("zone", "sample2.rndf");
+    for (int i = 0; i < rounds; ++i)
+    {
+      for (auto const &z : rndf.Zones())
+      {
+        EXPECT_TRUE(rndf.Zone(z.Id(), zone));
+        ++lookups;
+      }
+    }
+    m.Report(lookups);
+  }
+
+  {
+    rndf::Lane lane(1);
+    size_t lookups = 0;
+    Measurement m("lane", "sample2.rndf");
+    for (int i = 0; i < rounds; ++i)
+    {
+      for (auto const &s : rndf.Segments())
+      {
+        for (auto const &l : s.Lanes())
+        {
+          EXPECT_TRUE(s.Lane(l.Id(), lane));
+          ++lookups;
+        }
+      }
+    }
+    m.Report(lookups);
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief RNDF::Valid() with sample2.rndf.
+TEST(Benchmark, Valid)
+{
+  RNDF rndf(samplePath("sample2.rndf"));
+  const int rounds = 100;
+
+  bool valid = true;
+  Measurement m("valid", "sample2.rndf");
+  for (int i = 0; i < rounds; ++i)
+    valid = rndf.Valid() && valid;
+  m.Report(rounds);
+  EXPECT_TRUE(valid);
+}
+
+/////////////////////////////////////////////////
+/// \brief Copy of the segments and zones of sample2.rndf. RNDF itself
+/// isn't copyable, so the content is copied instead.
+TEST(Benchmark, Copy)
+{
+  RNDF rndf(samplePath("sample2.rndf"));
+  ASSERT_TRUE(rndf.Valid());
+  const RNDF &constRndf = rndf;
+  const int rounds = 10;
+
+  size_t copied = 0;
+  Measurement m("copy", "sample2.rndf");
+  for (int i = 0; i < rounds; ++i)
+  {
+    std::vector<rndf::Segment> segments = constRndf.Segments();
+    std::vector<rndf::Zone> zones = constRndf.Zones();
+    copied += segments.size() + zones.size();
+  }
+  m.Report(copied);
+  EXPECT_EQ(copied, (rndf.NumSegments() + rndf.NumZones()) * rounds);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of waypoints of the synthetic RNDF loaded, unless
+/// RNDF_BENCHMARK_MAX_WAYPOINTS sets another one.
+static const size_t kWaypoints = 100000;
+
+/////////////////////////////////////////////////
+/// \brief Load time of a synthetic RNDF parsing its text and reading its
+/// binary cache. Both results are compared.
+TEST(BinaryCache, LoadTime)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/binary_cache.rndf";
+  const std::string cachePath = filePath + ".cache";
+  const size_t waypoints =
+    benchmark::sizeFromEnv("RNDF_BENCHMARK_MAX_WAYPOINTS", kWaypoints);
+  ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, waypoints));
+  std::remove(cachePath.c_str());
+
+  const std::string input = "synthetic_" + std::to_string(waypoints);
+
+  RNDF parsed;
+  benchmark::Measurement text("load_text", input);
+  ASSERT_TRUE(parsed.Load(filePath));
+  text.Report(waypoints);
+
+  // Parse and write the cache.
+  benchmark::Measurement write("load_text_write_cache", input);
+  {
+    RNDF rndf;
+    ASSERT_TRUE(rndf.Load(filePath, cachePath));
+  }
+  write.Report(waypoints);
+
+  RNDF cached;
+  benchmark::Measurement cache("load_cache", input);
+  ASSERT_TRUE(cached.Load(filePath, cachePath));
+  cache.Report(waypoints);
+
+  const CoordinateSnapshot &expected =
+    static_cast<const RNDF &>(parsed).Coordinates();
+  const CoordinateSnapshot &snapshot =
+    static_cast<const RNDF &>(cached).Coordinates();
+  EXPECT_EQ(snapshot.Keys(), expected.Keys());
+  EXPECT_EQ(snapshot.Latitudes(), expected.Latitudes());
+  EXPECT_EQ(snapshot.Longitudes(), expected.Longitudes());
+
+  std::remove(filePath.c_str());
+  std::remove(cachePath.c_str());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/ContractionHierarchy.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of rows and columns of intersections of the city, unless
+/// RNDF_BENCHMARK_GRID_SIZE sets another one.
+static const int kGridSize = 20;
+
+/// \brief Number of waypoints of every lane of the city.
+static const int kLaneWaypoints = 6;
+
+/// \brief Number of sources and targets of the distance matrix.
+static const size_t kMatrixSize = 200;
+
+/// \brief Compute the lengths of the shortest routes from a node to all the
+/// nodes of a graph with Dijkstra's algorithm.
+/// \param[in] _graph The graph.
+/// \param[in] _start The first node.
+/// \param[out] _costs The lengths, infinite for unreachable nodes.
+void dijkstra(const RoadGraph &_graph, const uint32_t _start,
+  std::vector<double> &_costs)
+{
+  _costs.assign(_graph.NumNodes(), std::numeric_limits<double>::infinity());
+  using Entry = std::pair<double, uint32_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  _costs[_start] = 0;
+  queue.push(Entry(0, _start));
+  while (!queue.empty())
+  {
+    const Entry entry = queue.top();
+    queue.pop();
+    if (entry.first > _costs[entry.second])
+      continue;
+    for (uint32_t e = _graph.Offsets()[entry.second];
+         e < _graph.Offsets()[entry.second + 1]; ++e)
+    {
+      const uint32_t target = _graph.Targets()[e];
+      const double cost = entry.first + _graph.Lengths()[e];
+      if (cost < _costs[target])
+      {
+        _costs[target] = cost;
+        queue.push(Entry(cost, target));
+      }
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+/// \brief Preprocessing time, load time and distance matrix latency of a
+/// contraction hierarchy of a synthetic city, against a single-source
+/// Dijkstra search from every source of the matrix.
+TEST(ContractionHierarchy, City)
+{
+  const int gridSize = static_cast<int>(
+    benchmark::sizeFromEnv("RNDF_BENCHMARK_GRID_SIZE", kGridSize));
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/contraction_hierarchy.rndf";
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    file << benchmark::syntheticGridRNDF(gridSize, gridSize, kLaneWaypoints);
+  }
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+  std::remove(filePath.c_str());
+  const RoadGraph &graph = rndf.RoadGraph();
+
+  const std::string input = "grid_" + std::to_string(gridSize) + "x" +
+    std::to_string(gridSize);
+
+  benchmark::Measurement build("contraction_hierarchy_build", input);
+  ContractionHierarchy hierarchy(graph);
+  build.Stop();
+  build.Add("graph_edges", graph.NumEdges());
+  build.Add("hierarchy_edges", hierarchy.NumEdges());
+  build.Report(graph.NumNodes());
+
+  const std::string chPath =
+    std::string(PROJECT_BINARY_PATH) + "/contraction_hierarchy.ch";
+  ASSERT_TRUE(hierarchy.Save(chPath));
+  benchmark::Measurement load("contraction_hierarchy_load", input);
+  ContractionHierarchy loaded;
+  ASSERT_TRUE(loaded.Load(chPath, graph));
+  load.Report(graph.NumNodes());
+  std::remove(chPath.c_str());
+
+  // Random sources and targets anywhere in the city.
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<uint32_t> nodeDist(0,
+    static_cast<uint32_t>(graph.NumNodes()) - 1);
+  std::vector<uint32_t> sourceNodes;
+  std::vector<uint32_t> targetNodes;
+  std::vector<UniqueId> sources;
+  std::vector<UniqueId> targets;
+  for (size_t i = 0; i < kMatrixSize; ++i)
+  {
+    sourceNodes.push_back(nodeDist(generator));
+    targetNodes.push_back(nodeDist(generator));
+    for (auto const *nodes : {&sourceNodes, &targetNodes})
+    {
+      (nodes == &sourceNodes ? sources : targets).push_back(
+        UniqueId::FromKey(graph.Keys()[nodes->back()]));
+    }
+  }
+
+  std::vector<double> distances;
+  benchmark::Measurement matrix("contraction_hierarchy_matrix", input);
+  ASSERT_TRUE(loaded.Distances(sources, targets, distances));
+  matrix.Report(kMatrixSize * kMatrixSize);
+
+  // One Dijkstra search per source gives a whole row of the matrix.
+  std::vector<double> costs;
+  std::vector<double> expected;
+  benchmark::Measurement baseline("dijkstra_matrix", input);
+  for (size_t s = 0; s < kMatrixSize; ++s)
+  {
+    dijkstra(graph, sourceNodes[s], costs);
+    for (size_t t = 0; t < kMatrixSize; ++t)
+      expected.push_back(costs[targetNodes[t]]);
+  }
+  baseline.Report(kMatrixSize * kMatrixSize);
+
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    if (std::isinf(expected[i]))
+    {
+      EXPECT_TRUE(std::isinf(distances[i]));
+    }
+    else
+    {
+      EXPECT_NEAR(distances[i], expected[i], 1e-6);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/ParkingSpot.hh"
+#include "ignition/rndf/Perimeter.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "ignition/rndf/Zone.hh"
+#include "Benchmark.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of times the bounding box is computed.
+static const int kRounds = 2000;
+
+/// \brief A latitude/longitude bounding box.
+struct Box
+{
+  /// \brief Minimum latitude.
+  double minLat = std::numeric_limits<double>::max();
+
+  /// \brief Maximum latitude.
+  double maxLat = std::numeric_limits<double>::lowest();
+
+  /// \brief Minimum longitude.
+  double minLon = std::numeric_limits<double>::max();
+
+  /// \brief Maximum longitude.
+  double maxLon = std::numeric_limits<double>::lowest();
+
+  /// \brief Grow the box to contain a point.
+  /// \param[in] _lat Latitude.
+  /// \param[in] _lon Longitude.
+  void Add(const double _lat, const double _lon)
+  {
+    this->minLat = std::min(this->minLat, _lat);
+    this->maxLat = std::max(this->maxLat, _lat);
+    this->minLon = std::min(this->minLon, _lon);
+    this->maxLon = std::max(this->maxLon, _lon);
+  }
+};
+
+/////////////////////////////////////////////////
+/// \brief Compute the bounding box of a RNDF walking the object tree.
+/// \param[in] _rndf The RNDF.
+/// \return The bounding box.
+Box treeBox(const RNDF &_rndf)
+{
+  Box box;
+  for (auto const &segment : _rndf.Segments())
+    for (auto const &lane : segment.Lanes())
+      for (auto const &wp : lane.Waypoints())
+        box.Add(wp.Latitude(), wp.Longitude());
+
+  for (auto const &zone : _rndf.Zones())
+  {
+    for (auto const &wp : zone.Perimeter().Points())
+      box.Add(wp.Latitude(), wp.Longitude());
+    for (auto const &spot : zone.Spots())
+      for (auto const &wp : spot.Waypoints())
+        box.Add(wp.Latitude(), wp.Longitude());
+  }
+  return box;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compute the bounding box of a RNDF from its coordinate snapshot.
+/// \param[in] _snapshot The snapshot.
+/// \return The bounding box.
+Box snapshotBox(const CoordinateSnapshot &_snapshot)
+{
+  Box box;
+  const double *lat = _snapshot.Latitudes().data();
+  const double *lon = _snapshot.Longitudes().data();
+  for (size_t i = 0; i < _snapshot.Size(); ++i)
+    box.Add(lat[i], lon[i]);
+  return box;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare the time needed to compute the bounding box of
+/// sample2.rndf walking the object tree and using RNDF::Coordinates().
+TEST(CoordinateSnapshot, BoundingBox)
+{
+  RNDF rndf(std::string(PROJECT_SOURCE_PATH) + "/test/rndf/sample2.rndf");
+  ASSERT_TRUE(rndf.Valid());
+  const RNDF &constRndf = rndf;
+
+  const std::string input = "sample2.rndf";
+
+  benchmark::Measurement build("snapshot_build", input);
+  const CoordinateSnapshot &snapshot = constRndf.Coordinates();
+  build.Report(snapshot.Size());
+
+  Box tree;
+  benchmark::Measurement treeBoxes("bounding_box_tree", input);
+  for (int i = 0; i < kRounds; ++i)
+    tree = treeBox(constRndf);
+  treeBoxes.Report(snapshot.Size() * kRounds);
+
+  Box flat;
+  benchmark::Measurement snapshotBoxes("bounding_box_snapshot", input);
+  for (int i = 0; i < kRounds; ++i)
+    flat = snapshotBox(constRndf.Coordinates());
+  snapshotBoxes.Report(snapshot.Size() * kRounds);
+
+  EXPECT_DOUBLE_EQ(tree.minLat, flat.minLat);
+  EXPECT_DOUBLE_EQ(tree.maxLat, flat.maxLat);
+  EXPECT_DOUBLE_EQ(tree.minLon, flat.minLon);
+  EXPECT_DOUBLE_EQ(tree.maxLon, flat.maxLon);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
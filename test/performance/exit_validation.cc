@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/LineReader.hh"
+#include "ignition/rndf/ParserUtils.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "Benchmark.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of segments of the synthetic RNDF.
+static const int kSegments = 25;
+
+/// \brief Number of lanes per segment.
+static const int kLanes = 4;
+
+/// \brief Number of waypoints per lane.
+static const int kWaypoints = 400;
+
+/// \brief A lane has an exit every kExitStep waypoints.
+static const int kExitStep = 10;
+
+/////////////////////////////////////////////////
+/// \brief Generate a RNDF where every lane has exits to the first waypoint
+/// of the same lane in the next segment.
+/// \return The RNDF content.
+static std::string generateRNDF()
+{
+  std::string content = "RNDF_name synthetic\n"
+    "num_segments " + std::to_string(kSegments) + "\n"
+    "num_zones 0\n";
+
+  for (int s = 1; s <= kSegments; ++s)
+  {
+    const std::string segment = std::to_string(s);
+    const std::string next = std::to_string(s % kSegments + 1);
+    content += "segment " + segment + "\n"
+      "num_lanes " + std::to_string(kLanes) + "\n";
+
+    for (int l = 1; l <= kLanes; ++l)
+    {
+      const std::string lane = segment + "." + std::to_string(l);
+      content += "lane " + lane + "\n"
+        "num_waypoints " + std::to_string(kWaypoints) + "\n";
+
+      for (int w = kExitStep; w <= kWaypoints; w += kExitStep)
+      {
+        content += "exit " + lane + "." + std::to_string(w) + " " + next +
+          "." + std::to_string(l) + ".1\n";
+      }
+
+      for (int w = 1; w <= kWaypoints; ++w)
+      {
+        content += lane + "." + std::to_string(w) + " " +
+          std::to_string(34.5 + s * 1e-3 + w * 1e-6) + " " +
+          std::to_string(-117.3 - l * 1e-3 - w * 1e-6) + "\n";
+      }
+      content += "end_lane\n";
+    }
+    content += "end_segment\n";
+  }
+  content += "end_file\n";
+  return content;
+}
+
+/////////////////////////////////////////////////
+/// \brief Validate exits searching the string ids of all the waypoints,
+/// the way RNDF::Load() did before using waypoint keys.
+/// \param[in] _waypoints Waypoint ids.
+/// \param[in] _exits Exit ids.
+/// \return Number of exits not found.
+static size_t validateStrings(const std::vector<std::string> &_waypoints,
+  const std::vector<std::string> &_exits)
+{
+  size_t missing = 0;
+  for (auto const &exit : _exits)
+  {
+    if (std::find(_waypoints.begin(), _waypoints.end(), exit) ==
+        _waypoints.end())
+    {
+      ++missing;
+    }
+  }
+  return missing;
+}
+
+/////////////////////////////////////////////////
+/// \brief Validate exits using a hash set of waypoint keys.
+/// \param[in] _waypoints Waypoint keys.
+/// \param[in] _exits Exit keys.
+/// \return Number of exits not found.
+static size_t validateKeys(const std::vector<uint64_t> &_waypoints,
+  const std::vector<uint64_t> &_exits)
+{
+  std::unordered_set<uint64_t> index(_waypoints.begin(), _waypoints.end());
+  size_t missing = 0;
+  for (auto const &exit : _exits)
+  {
+    if (index.find(exit) == index.end())
+      ++missing;
+  }
+  return missing;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare the cost of validating exits with string ids and with
+/// waypoint keys, and measure the time to load a RNDF with many exits.
+TEST(ExitValidation, Throughput)
+{
+  std::vector<std::string> waypointStrings;
+  std::vector<uint64_t> waypointKeys;
+  std::vector<std::string> exitStrings;
+  std::vector<uint64_t> exitKeys;
+  for (int s = 1; s <= kSegments; ++s)
+  {
+    for (int l = 1; l <= kLanes; ++l)
+    {
+      for (int w = 1; w <= kWaypoints; ++w)
+      {
+        waypointStrings.push_back(UniqueId(s, l, w).String());
+        waypointKeys.push_back(waypointKey(s, l, w));
+        if (w % kExitStep == 0)
+        {
+          exitStrings.push_back(UniqueId(s % kSegments + 1, l, 1).String());
+          exitKeys.push_back(waypointKey(s % kSegments + 1, l, 1));
+        }
+      }
+    }
+  }
+
+  const std::string input = "synthetic_" + std::to_string(kSegments) + "x" +
+    std::to_string(kLanes) + "x" + std::to_string(kWaypoints);
+
+  benchmark::Measurement strings("exit_validation_strings", input);
+  size_t stringMissing = validateStrings(waypointStrings, exitStrings);
+  strings.Report(exitStrings.size());
+
+  benchmark::Measurement keys("exit_validation_keys", input);
+  size_t keyMissing = validateKeys(waypointKeys, exitKeys);
+  keys.Report(exitKeys.size());
+
+  EXPECT_EQ(stringMissing, 0u);
+  EXPECT_EQ(keyMissing, 0u);
+
+  // Load a complete RNDF with the same structure.
+  std::string content = generateRNDF();
+  LineReader reader(content.data(), content.size());
+  RNDF rndf;
+  benchmark::Measurement load("load_exits", input);
+  EXPECT_TRUE(rndf.Load(reader));
+  load.Report(waypointKeys.size());
+
+  EXPECT_EQ(rndf.NumSegments(), static_cast<size_t>(kSegments));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
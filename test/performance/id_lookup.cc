@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of rows and columns of intersections of the city.
+static const int kGridSize = 50;
+
+/// \brief Number of waypoints of every lane of the city.
+static const int kLaneWaypoints = 6;
+
+/// \brief Number of waypoints looked up.
+static const int kLookups = 2000;
+
+/////////////////////////////////////////////////
+/// \brief Latency of looking up a waypoint of a synthetic city by its
+/// segment, lane and waypoint Ids, through the accessors that copy every
+/// element into an output parameter and through the ones that return a
+/// pointer.
+TEST(IdLookup, City)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/id_lookup.rndf";
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    file << benchmark::syntheticGridRNDF(kGridSize, kGridSize, kLaneWaypoints);
+  }
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+  std::remove(filePath.c_str());
+  const RNDF &constRndf = rndf;
+  const int numSegments = static_cast<int>(rndf.NumSegments());
+
+  const std::string input = "grid_" + std::to_string(kGridSize) + "x" +
+    std::to_string(kGridSize);
+
+  double copySum = 0;
+  benchmark::Measurement copies("lookup_copies", input);
+  for (int i = 0; i < kLookups; ++i)
+  {
+    const int segmentId = 1 + (i * 97) % numSegments;
+    const int waypointId = 1 + i % kLaneWaypoints;
+    Segment segment;
+    Lane lane;
+    Waypoint wp;
+    ASSERT_TRUE(constRndf.Segment(segmentId, segment));
+    ASSERT_TRUE(segment.Lane(1, lane));
+    ASSERT_TRUE(lane.Waypoint(waypointId, wp));
+    copySum += wp.Latitude();
+  }
+  copies.Report(kLookups);
+
+  double pointerSum = 0;
+  benchmark::Measurement pointers("lookup_pointers", input);
+  for (int i = 0; i < kLookups; ++i)
+  {
+    const int segmentId = 1 + (i * 97) % numSegments;
+    const int waypointId = 1 + i % kLaneWaypoints;
+    const Segment *segment = constRndf.Segment(segmentId);
+    ASSERT_TRUE(segment != nullptr);
+    const Lane *lane = segment->Lane(1);
+    ASSERT_TRUE(lane != nullptr);
+    const Waypoint *wp = lane->Waypoint(waypointId);
+    ASSERT_TRUE(wp != nullptr);
+    pointerSum += wp->Latitude();
+  }
+  pointers.Report(kLookups);
+
+  EXPECT_DOUBLE_EQ(copySum, pointerSum);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFNode.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "Benchmark.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of times all the waypoints are looked up.
+static const int kRounds = 200;
+
+/////////////////////////////////////////////////
+/// \brief Compare RNDF::Info() with a lookup in a map keyed by the string
+/// representation of the unique Ids, the way Info() worked before unique Id
+/// keys existed.
+TEST(InfoLookup, Throughput)
+{
+  RNDF rndf(std::string(PROJECT_SOURCE_PATH) + "/test/rndf/sample2.rndf");
+  ASSERT_TRUE(rndf.Valid());
+
+  std::vector<UniqueId> ids;
+  std::map<std::string, RNDFNode *> byString;
+  for (auto const &segment : rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      for (auto const &wp : lane.Waypoints())
+      {
+        ids.push_back(UniqueId(segment.Id(), lane.Id(), wp.Id()));
+        byString[ids.back().String()] = rndf.Info(ids.back());
+      }
+    }
+  }
+
+  const std::string input = "sample2.rndf";
+
+  size_t found = 0;
+  benchmark::Measurement strings("info_lookup_strings", input);
+  for (int i = 0; i < kRounds; ++i)
+  {
+    for (auto const &id : ids)
+    {
+      if (byString.find(id.String()) != byString.end())
+        ++found;
+    }
+  }
+  strings.Report(ids.size() * kRounds);
+  EXPECT_EQ(found, ids.size() * kRounds);
+
+  found = 0;
+  benchmark::Measurement keys("info_lookup_keys", input);
+  const size_t before = benchmark::allocations();
+  for (int i = 0; i < kRounds; ++i)
+  {
+    for (auto const &id : ids)
+    {
+      if (rndf.Info(id))
+        ++found;
+    }
+  }
+  const size_t keyAllocations = benchmark::allocations() - before;
+  keys.Report(ids.size() * kRounds);
+  EXPECT_EQ(found, ids.size() * kRounds);
+
+  EXPECT_EQ(keyAllocations, 0u);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/LaneIndex.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of waypoints of the synthetic RNDF loaded, unless
+/// RNDF_BENCHMARK_MAX_WAYPOINTS sets another one.
+static const size_t kWaypoints = 100000;
+
+/// \brief Number of poses projected.
+static const size_t kPoses = 100000;
+
+/// \brief Number of poses projected by the linear scan.
+static const size_t kScanPoses = 200;
+
+/////////////////////////////////////////////////
+/// \brief Latency of projecting poses of a trajectory along the lanes of a
+/// synthetic RNDF, one by one and in a batch, compared with a linear scan
+/// of all the lane pieces.
+TEST(LaneProjection, Trajectory)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/lane_projection.rndf";
+  const size_t waypoints =
+    benchmark::sizeFromEnv("RNDF_BENCHMARK_MAX_WAYPOINTS", kWaypoints);
+  ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, waypoints));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+  std::remove(filePath.c_str());
+
+  const std::string input = "synthetic_" + std::to_string(waypoints);
+
+  benchmark::Measurement build("lane_index_build", input);
+  const LaneIndex &index = rndf.LaneIndex();
+  build.Report(index.Size());
+
+  // A trajectory that follows the first lanes with some noise.
+  std::mt19937 generator(42);
+  std::normal_distribution<double> noise(0, 0.00001);
+  std::vector<double> lats;
+  std::vector<double> lons;
+  for (auto const &segment : rndf.Segments())
+  {
+    const std::vector<Waypoint> &wps = segment.Lanes().front().Waypoints();
+    for (size_t i = 0; i + 1 < wps.size() && lats.size() < kPoses; ++i)
+    {
+      for (int k = 0; k < 4; ++k)
+      {
+        const double t = k / 4.0;
+        lats.push_back(wps[i].Latitude() * (1 - t) +
+          wps[i + 1].Latitude() * t + noise(generator));
+        lons.push_back(wps[i].Longitude() * (1 - t) +
+          wps[i + 1].Longitude() * t + noise(generator));
+      }
+    }
+    if (lats.size() >= kPoses)
+      break;
+  }
+  lats.resize(std::min(lats.size(), kPoses));
+  lons.resize(lats.size());
+
+  // Linear scan of the first poses.
+  std::vector<const std::vector<Waypoint> *> lanes;
+  for (auto const &segment : rndf.Segments())
+    for (auto const &lane : segment.Lanes())
+      lanes.push_back(&lane.Waypoints());
+  const double latScale = 6371008.8 * 3.14159265358979323846 / 180;
+  const double lonScale = latScale * std::cos(lats.front() *
+    3.14159265358979323846 / 180);
+  double scanSum = 0;
+  benchmark::Measurement scan("linear_scan_project", input);
+  for (size_t q = 0; q < kScanPoses; ++q)
+  {
+    double best = std::numeric_limits<double>::infinity();
+    for (auto const *wps : lanes)
+    {
+      for (size_t k = 0; k + 1 < wps->size(); ++k)
+      {
+        const double px = ((*wps)[k].Longitude() - lons[q]) * lonScale;
+        const double py = ((*wps)[k].Latitude() - lats[q]) * latScale;
+        const double dx = ((*wps)[k + 1].Longitude() - lons[q]) * lonScale -
+          px;
+        const double dy = ((*wps)[k + 1].Latitude() - lats[q]) * latScale -
+          py;
+        const double length2 = dx * dx + dy * dy;
+        double t = length2 > 0 ? -(px * dx + py * dy) / length2 : 0;
+        t = std::min(std::max(t, 0.0), 1.0);
+        best = std::min(best, std::hypot(px + t * dx, py + t * dy));
+      }
+    }
+    scanSum += best;
+  }
+  scan.Report(kScanPoses);
+
+  LaneProjection projection;
+  double singleSum = 0;
+  benchmark::Measurement single("lane_index_project", input);
+  for (size_t q = 0; q < lats.size(); ++q)
+  {
+    ASSERT_TRUE(index.Project(lats[q], lons[q], projection));
+    singleSum += std::fabs(projection.lateralOffset);
+  }
+  single.Report(lats.size());
+
+  std::vector<LaneProjection> projections;
+  benchmark::Measurement batch("lane_index_batch_project", input);
+  ASSERT_EQ(index.Project(lats, lons, projections), lats.size());
+  batch.Report(lats.size());
+
+  double batchSum = 0;
+  double batchScanSum = 0;
+  for (size_t q = 0; q < projections.size(); ++q)
+  {
+    batchSum += std::fabs(projections[q].lateralOffset);
+    if (q < kScanPoses)
+      batchScanSum += std::fabs(projections[q].lateralOffset);
+  }
+  EXPECT_NEAR(singleSum, batchSum, 1e-6 * lats.size());
+  EXPECT_NEAR(scanSum, batchScanSum, 0.01 * kScanPoses);
+
+  // The same poses in random order, as when merging several sensors.
+  std::vector<size_t> shuffle(lats.size());
+  for (size_t q = 0; q < shuffle.size(); ++q)
+    shuffle[q] = q;
+  std::shuffle(shuffle.begin(), shuffle.end(), generator);
+  std::vector<double> shuffledLats(lats.size());
+  std::vector<double> shuffledLons(lats.size());
+  for (size_t q = 0; q < shuffle.size(); ++q)
+  {
+    shuffledLats[q] = lats[shuffle[q]];
+    shuffledLons[q] = lons[shuffle[q]];
+  }
+
+  benchmark::Measurement shuffledSingle("lane_index_project_random_order",
+    input);
+  for (size_t q = 0; q < lats.size(); ++q)
+    ASSERT_TRUE(index.Project(shuffledLats[q], shuffledLons[q], projection));
+  shuffledSingle.Report(lats.size());
+
+  benchmark::Measurement shuffledBatch(
+    "lane_index_batch_project_random_order", input);
+  ASSERT_EQ(index.Project(shuffledLats, shuffledLons, projections),
+    lats.size());
+  shuffledBatch.Report(lats.size());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstddef>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/RNDF.hh"
+#include "Benchmark.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/////////////////////////////////////////////////
+/// \brief Measure the peak heap usage while loading sample2.rndf relative
+/// to the size of the resulting model.
+TEST(LoadMemory, PeakOverModel)
+{
+  const std::string filePath =
+    std::string(PROJECT_SOURCE_PATH) + "/test/rndf/sample2.rndf";
+
+  RNDF rndf;
+  benchmark::Measurement measurement("load_memory", "sample2.rndf");
+  const std::size_t before = benchmark::liveBytes();
+  ASSERT_TRUE(rndf.Load(filePath));
+
+  const std::size_t model = benchmark::liveBytes() - before;
+  const std::size_t peak = benchmark::peakBytes() - before;
+  const double ratio = static_cast<double>(peak) / model;
+
+  measurement.Add("model_bytes", model);
+  measurement.Add("peak_over_model", ratio);
+  measurement.Report(rndf.NumSegments());
+
+  // Segments, lanes and waypoints are moved into the model instead of
+  // being copied, so the parser holds about one copy of the network at a
+  // time. The rest of the overhead comes from the exit and waypoint caches.
+  EXPECT_LT(ratio, 1.5);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/LocalCoordinates.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of rows and columns of intersections of the city.
+static const int kGridSize = 100;
+
+/// \brief Number of waypoints of every lane of the city.
+static const int kLaneWaypoints = 10;
+
+/// \brief Number of times the geometry of the lanes is computed.
+static const int kRounds = 20;
+
+/////////////////////////////////////////////////
+/// \brief Length and total turn of every lane, projecting the waypoints
+/// when needed.
+/// \param[in] _snapshot Coordinates of the waypoints.
+/// \param[in] _local Frame used to project them.
+/// \return The sum of the lengths and the turns.
+double projectedGeometry(const CoordinateSnapshot &_snapshot,
+  const LocalCoordinates &_local)
+{
+  const double *lat = _snapshot.Latitudes().data();
+  const double *lon = _snapshot.Longitudes().data();
+  double sum = 0;
+  for (auto const &range : _snapshot.Ranges())
+  {
+    for (uint32_t i = range.begin + 1; i < range.end; ++i)
+    {
+      double x0;
+      double y0;
+      double x1;
+      double y1;
+      _local.Project(lat[i - 1], lon[i - 1], x0, y0);
+      _local.Project(lat[i], lon[i], x1, y1);
+      sum += std::hypot(x1 - x0, y1 - y0) + std::atan2(y1 - y0, x1 - x0);
+    }
+  }
+  return sum;
+}
+
+/////////////////////////////////////////////////
+/// \brief Length and total turn of every lane, from the projected
+/// coordinates.
+/// \param[in] _snapshot Coordinates of the waypoints.
+/// \param[in] _local The projected coordinates.
+/// \return The sum of the lengths and the turns.
+double planarGeometry(const CoordinateSnapshot &_snapshot,
+  const LocalCoordinates &_local)
+{
+  double sum = 0;
+  for (auto const &range : _snapshot.Ranges())
+  {
+    for (uint32_t i = range.begin + 1; i < range.end; ++i)
+      sum += _local.Distance(i - 1, i) + _local.Heading(i - 1, i);
+  }
+  return sum;
+}
+
+/////////////////////////////////////////////////
+/// \brief Time needed to project all the waypoints of a synthetic city, and
+/// to compute the lengths and headings of its lanes projecting the
+/// waypoints per query and from RNDF::LocalCoordinates().
+TEST(LocalCoordinates, City)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/local_coordinates.rndf";
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    file << benchmark::syntheticGridRNDF(kGridSize, kGridSize, kLaneWaypoints);
+  }
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+  std::remove(filePath.c_str());
+  const RNDF &constRndf = rndf;
+  const CoordinateSnapshot &snapshot = constRndf.Coordinates();
+
+  const std::string input = "grid_" + std::to_string(kGridSize) + "x" +
+    std::to_string(kGridSize);
+
+  benchmark::Measurement build("local_coordinates_build", input);
+  const LocalCoordinates &local = constRndf.LocalCoordinates();
+  build.Report(snapshot.Size());
+  ASSERT_EQ(local.Size(), snapshot.Size());
+
+  double projectedSum = 0;
+  benchmark::Measurement projected("lane_geometry_projected", input);
+  for (int i = 0; i < kRounds; ++i)
+    projectedSum += projectedGeometry(snapshot, local);
+  projected.Report(kRounds * snapshot.Size());
+
+  double planarSum = 0;
+  benchmark::Measurement planar("lane_geometry_planar", input);
+  for (int i = 0; i < kRounds; ++i)
+    planarSum += planarGeometry(snapshot, constRndf.LocalCoordinates());
+  planar.Report(kRounds * snapshot.Size());
+
+  EXPECT_NEAR(projectedSum, planarSum, 1e-6 * std::abs(planarSum));
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
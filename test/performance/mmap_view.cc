@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFNode.hh"
+#include "ignition/rndf/RNDFView.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of waypoints of the synthetic RNDF loaded.
+static const size_t kWaypoints = 500000;
+
+/////////////////////////////////////////////////
+/// \brief Time to open a RNDFView of a synthetic RNDF and to look up all
+/// its lane waypoints, compared with RNDF::Load() and RNDF::Info().
+TEST(MmapView, OpenAndLookup)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/mmap_view.rndf";
+  const std::string imagePath = filePath + ".image";
+  ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, kWaypoints));
+  std::remove(imagePath.c_str());
+
+  // Create the image.
+  {
+    RNDFView view;
+    ASSERT_TRUE(view.Open(filePath, imagePath));
+  }
+
+  const std::string input = "synthetic_" + std::to_string(kWaypoints);
+
+  benchmark::Measurement load("rndf_load", input);
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+  load.Report(kWaypoints);
+
+  benchmark::Measurement open("rndf_view_open", input);
+  RNDFView view;
+  ASSERT_TRUE(view.Open(imagePath));
+  open.Report(kWaypoints);
+
+  std::vector<UniqueId> ids;
+  for (auto const &segment : rndf.Segments())
+    for (auto const &lane : segment.Lanes())
+      for (auto const &wp : lane.Waypoints())
+        ids.push_back(UniqueId(segment.Id(), lane.Id(), wp.Id()));
+
+  double sum = 0;
+  benchmark::Measurement info("rndf_info", input);
+  for (auto const &id : ids)
+  {
+    RNDFNode *node = rndf.Info(id);
+    ASSERT_TRUE(node != nullptr);
+    sum += node->Waypoint()->Latitude();
+  }
+  info.Report(ids.size());
+
+  double viewSum = 0;
+  benchmark::Measurement viewInfo("rndf_view_info", input);
+  for (auto const &id : ids)
+  {
+    RNDFNodeView node;
+    ASSERT_TRUE(view.Info(id, node));
+    viewSum += node.Waypoint().Latitude();
+  }
+  viewInfo.Report(ids.size());
+
+  EXPECT_DOUBLE_EQ(sum, viewSum);
+
+  std::remove(filePath.c_str());
+  std::remove(imagePath.c_str());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/ParserUtils.hh"
+#include "Benchmark.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of times the waypoints of the sample are replicated.
+static const int kScale = 200;
+
+/// \brief The numeric fields of a waypoint line.
+struct WaypointFields
+{
+  /// \brief The "z" element of the waypoint Id.
+  std::string id;
+
+  /// \brief Latitude.
+  std::string latitude;
+
+  /// \brief Longitude.
+  std::string longitude;
+};
+
+/////////////////////////////////////////////////
+/// \brief Collect the numeric fields of all the waypoints of a RNDF file.
+/// \param[in] _filePath Path to the RNDF file.
+/// \return The fields of every waypoint line.
+static std::vector<WaypointFields> loadWaypoints(const std::string &_filePath)
+{
+  std::vector<WaypointFields> fields;
+  std::ifstream file(_filePath);
+  std::string line;
+  while (std::getline(file, line))
+  {
+    trimWhitespaces(line);
+
+    Tokens tokens;
+    Tokens idTokens;
+    if (tokenize(line, " ", tokens) != 3 ||
+        tokenize(tokens[0], ".", idTokens) != 3)
+    {
+      continue;
+    }
+
+    fields.push_back(
+      {idTokens[2].String(), tokens[1].String(), tokens[2].String()});
+  }
+
+  return fields;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse the fields with std::stoi()/std::stod(), the way the
+/// parsers did before parseInt() and parseDouble() existed.
+/// \param[in] _fields Fields to parse.
+/// \param[out] _sum Sum of all values parsed, to compare results.
+/// \return Number of lines that failed to parse.
+static size_t parseStd(const std::vector<WaypointFields> &_fields,
+  double &_sum)
+{
+  size_t failures = 0;
+  _sum = 0;
+  for (auto const &f : _fields)
+  {
+    std::string::size_type sz;
+    try
+    {
+      double latitude = std::stod(f.latitude, &sz);
+      double longitude = std::stod(f.longitude, &sz);
+      int id = std::stoi(f.id, &sz);
+      if (sz != f.id.size())
+      {
+        ++failures;
+        continue;
+      }
+      _sum += latitude + longitude + id;
+    }
+    catch(...)
+    {
+      ++failures;
+    }
+  }
+  return failures;
+}
+
+/////////////////////////////////////////////////
+/// \brief Parse the fields with parseInt() and parseDouble().
+/// \param[in] _fields Fields to parse.
+/// \param[out] _sum Sum of all values parsed, to compare results.
+/// \return Number of lines that failed to parse.
+static size_t parseFast(const std::vector<WaypointFields> &_fields,
+  double &_sum)
+{
+  size_t failures = 0;
+  _sum = 0;
+  for (auto const &f : _fields)
+  {
+    double latitude;
+    double longitude;
+    int id;
+    if (!parseDouble(f.latitude, latitude)   ||
+        !parseDouble(f.longitude, longitude) ||
+        !parseInt(f.id, id))
+    {
+      ++failures;
+      continue;
+    }
+    _sum += latitude + longitude + id;
+  }
+  return failures;
+}
+
+/////////////////////////////////////////////////
+/// \brief Measure a parsing function and report the result.
+/// \param[in] _benchmark Name of the benchmark.
+/// \param[in] _input Name of the input data.
+/// \param[in] _func Function to measure.
+/// \param[in] _fields Fields to parse.
+/// \param[out] _sum Sum of all values parsed.
+/// \return Number of lines that failed to parse.
+template<typename Func>
+static size_t measure(const std::string &_benchmark,
+  const std::string &_input, Func _func,
+  const std::vector<WaypointFields> &_fields, double &_sum)
+{
+  benchmark::Measurement measurement(_benchmark, _input);
+  size_t failures = _func(_fields, _sum);
+  measurement.Report(_fields.size());
+  return failures;
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare std::stod()/std::stoi() with parseDouble()/parseInt() on
+/// the waypoints of sample2.rndf replicated many times.
+TEST(NumericParsing, WaypointThroughput)
+{
+  std::string filePath =
+    std::string(PROJECT_SOURCE_PATH) + "/test/rndf/sample2.rndf";
+  auto sample = loadWaypoints(filePath);
+  ASSERT_FALSE(sample.empty());
+
+  std::vector<WaypointFields> fields;
+  fields.reserve(sample.size() * kScale);
+  for (int i = 0; i < kScale; ++i)
+    fields.insert(fields.end(), sample.begin(), sample.end());
+
+  const std::string input = "sample2.rndf_x" + std::to_string(kScale);
+  double stdSum, fastSum;
+  size_t stdFailures = measure("parse_std", input, parseStd, fields, stdSum);
+  size_t fastFailures = measure("parse_fast", input, parseFast, fields,
+    fastSum);
+
+  EXPECT_EQ(stdFailures, 0u);
+  EXPECT_EQ(fastFailures, 0u);
+  EXPECT_EQ(std::memcmp(&stdSum, &fastSum, sizeof(double)), 0);
+
+  // Malformed files make std::stod() throw on every line.
+  for (auto &f : fields)
+    f.latitude = "xxx";
+
+  const std::string malformed = input + "_malformed";
+  stdFailures = measure("parse_std", malformed, parseStd, fields, stdSum);
+  fastFailures = measure("parse_fast", malformed, parseFast, fields, fastSum);
+
+  EXPECT_EQ(stdFailures, fields.size());
+  EXPECT_EQ(fastFailures, fields.size());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
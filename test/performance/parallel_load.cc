@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of waypoints of the synthetic RNDF loaded.
+static const size_t kWaypoints = 500000;
+
+/////////////////////////////////////////////////
+/// \brief Load time of a synthetic RNDF with an increasing number of
+/// threads. The result of every parallel load is compared with the serial
+/// one.
+TEST(ParallelLoad, Scaling)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/parallel_load.rndf";
+  ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, kWaypoints));
+
+  std::vector<unsigned int> threadCounts = {1, 2, 4, 8, 16, 32};
+  const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+  const std::string input = "synthetic_" + std::to_string(kWaypoints);
+
+  CoordinateSnapshot expected;
+  for (auto threads : threadCounts)
+  {
+    if (threads > 1 && threads > 2 * hardwareThreads)
+      break;
+
+    RNDF rndf;
+    benchmark::Measurement measurement("parallel_load", input);
+    measurement.Add("threads", threads);
+    measurement.Add("hardware_threads", hardwareThreads);
+    ASSERT_TRUE(rndf.Load(filePath, threads));
+    measurement.Report(kWaypoints);
+
+    const CoordinateSnapshot &snapshot = static_cast<const RNDF &>(
+      rndf).Coordinates();
+    if (threads == 1)
+    {
+      expected = snapshot;
+    }
+    else
+    {
+      EXPECT_EQ(snapshot.Keys(), expected.Keys());
+      EXPECT_EQ(snapshot.Latitudes(), expected.Latitudes());
+      EXPECT_EQ(snapshot.Longitudes(), expected.Longitudes());
+    }
+  }
+
+  std::remove(filePath.c_str());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
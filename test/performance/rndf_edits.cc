@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFNode.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of rows and columns of intersections of the city.
+static const int kGridSize = 50;
+
+/// \brief Number of waypoints of every lane of the city.
+static const int kLaneWaypoints = 6;
+
+/// \brief Number of edits of each kind.
+static const int kEdits = 200;
+
+/// \brief Number of runs of the MarkModified(id) edits.
+static const int kRuns = 5;
+
+/// \brief Get the name of a synthetic city in the reports.
+/// \param[in] _gridSize Number of rows and columns of intersections.
+/// \return The name.
+std::string cityName(const int _gridSize)
+{
+  return "grid_" + std::to_string(_gridSize) + "x" +
+    std::to_string(_gridSize);
+}
+
+/// \brief Get the seconds elapsed since a time.
+/// \param[in] _start The time.
+/// \return The seconds.
+double secondsSince(const std::chrono::steady_clock::time_point &_start)
+{
+  const std::chrono::duration<double> time =
+    std::chrono::steady_clock::now() - _start;
+  return time.count();
+}
+
+/// \brief Load a synthetic city.
+/// \param[in] _gridSize Number of rows and columns of intersections.
+/// \param[out] _rndf The RNDF loaded.
+void loadCity(const int _gridSize, RNDF &_rndf)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/rndf_edits.rndf";
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    file << benchmark::syntheticGridRNDF(_gridSize, _gridSize, kLaneWaypoints);
+  }
+  ASSERT_TRUE(_rndf.Load(filePath));
+  std::remove(filePath.c_str());
+}
+
+/// \brief Get the seconds per edit of a segment through the mutable
+/// accessor followed by MarkModified(id) and a lookup.
+/// \param[in] _rndf The RNDF edited.
+/// \param[in] _input Name of the RNDF in the report.
+/// \return The seconds per edit, the best of a few runs.
+double markModifiedTime(RNDF &_rndf, const std::string &_input)
+{
+  const int numSegments = static_cast<int>(_rndf.NumSegments());
+  double best = 0;
+  benchmark::Measurement measurement("mark_modified_id", _input);
+  for (int run = 0; run < kRuns; ++run)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kEdits; ++i)
+    {
+      const int segmentId = 1 + (i * 97) % numSegments;
+      Lane &lane = _rndf.Segments().at(segmentId - 1).Lanes().at(0);
+      lane.Waypoints().at(0).SetLocation(0.003 * i, 0.003 * i);
+      _rndf.MarkModified(segmentId);
+      RNDFNode *edited = _rndf.Info(UniqueId(segmentId, 1, 1));
+      EXPECT_TRUE(edited != nullptr);
+    }
+    const double time = secondsSince(start) / kEdits;
+    if (run == 0 || time < best)
+      best = time;
+  }
+  measurement.Stop();
+  measurement.Add("best_seconds_per_edit", best);
+  measurement.Report(kRuns * kEdits);
+  return best;
+}
+
+/////////////////////////////////////////////////
+/// \brief Latency of small edits of a synthetic city followed by a lookup
+/// of the waypoints edited, through the incremental mutators and through
+/// the mutable accessors, which reindex the whole RNDF.
+TEST(RNDFEdits, City)
+{
+  RNDF rndf;
+  loadCity(kGridSize, rndf);
+  const RNDF &constRndf = rndf;
+  const int numSegments = static_cast<int>(rndf.NumSegments());
+  RNDFNode *node = rndf.Info(UniqueId(2, 1, 1));
+  ASSERT_TRUE(node != nullptr);
+
+  const std::string input = cityName(kGridSize);
+
+  // Move the first waypoint of a lane of every edited segment.
+  benchmark::Measurement updateLane("update_lane", input);
+  for (int i = 0; i < kEdits; ++i)
+  {
+    const int segmentId = 1 + (i * 97) % numSegments;
+    Lane lane(constRndf.Segments().at(segmentId - 1).Lanes().at(0));
+    lane.Waypoints().at(0).SetLocation(0.001 * i, 0.001 * i);
+    ASSERT_TRUE(rndf.UpdateLane(segmentId, lane));
+    RNDFNode *edited = rndf.Info(UniqueId(segmentId, 1, 1));
+    ASSERT_TRUE(edited != nullptr);
+    EXPECT_DOUBLE_EQ(
+      edited->Waypoint()->Location().LatitudeReference().Degree(), 0.001 * i);
+  }
+  updateLane.Report(kEdits);
+
+  benchmark::Measurement markModified("mark_modified", input);
+  for (int i = 0; i < kEdits; ++i)
+  {
+    const int segmentId = 1 + (i * 97) % numSegments;
+    Lane &lane = rndf.Segments().at(segmentId - 1).Lanes().at(0);
+    lane.Waypoints().at(0).SetLocation(0.002 * i, 0.002 * i);
+    rndf.MarkModified();
+    RNDFNode *edited = rndf.Info(UniqueId(segmentId, 1, 1));
+    ASSERT_TRUE(edited != nullptr);
+    EXPECT_DOUBLE_EQ(
+      edited->Waypoint()->Location().LatitudeReference().Degree(), 0.002 * i);
+  }
+  markModified.Report(kEdits);
+
+  markModifiedTime(rndf, input);
+
+  // Remove and add back segments.
+  benchmark::Measurement removeAdd("remove_add_segment", input);
+  for (int i = 0; i < kEdits; ++i)
+  {
+    const int segmentId = 1 + (i * 97) % numSegments;
+    Segment segment;
+    ASSERT_TRUE(rndf.Segment(segmentId, segment));
+    ASSERT_TRUE(rndf.RemoveSegment(segmentId));
+    EXPECT_EQ(rndf.Info(UniqueId(segmentId, 1, 1)), nullptr);
+    ASSERT_TRUE(rndf.AddSegment(segment));
+    EXPECT_NE(rndf.Info(UniqueId(segmentId, 1, 1)), nullptr);
+  }
+  removeAdd.Report(kEdits);
+
+  // The nodes of the waypoints not edited are the same.
+  EXPECT_EQ(rndf.Info(UniqueId(2, 1, 1)), node);
+}
+
+/////////////////////////////////////////////////
+/// \brief MarkModified(id) only visits the waypoints of the segment edited,
+/// so its latency does not grow with the size of the RNDF.
+TEST(RNDFEdits, MarkModifiedScaling)
+{
+  const int kSmallGridSize = 5;
+
+  RNDF small;
+  loadCity(kSmallGridSize, small);
+  RNDF large;
+  loadCity(kGridSize, large);
+  ASSERT_GT(large.NumSegments(), 50 * small.NumSegments());
+
+  const double smallTime = markModifiedTime(small, cityName(kSmallGridSize));
+  const double largeTime = markModifiedTime(large, cityName(kGridSize));
+
+  // The large city has 100 times the waypoints of the small one. Allow for
+  // cache effects and timer noise.
+  EXPECT_LT(largeTime, 10 * smallTime + 1e-6);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/Exit.hh"
+#include "ignition/rndf/Lane.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/Segment.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of waypoints of the synthetic RNDF loaded.
+static const size_t kWaypoints = 500000;
+
+/////////////////////////////////////////////////
+/// \brief Time to build the road graph of a synthetic RNDF and to traverse
+/// it, compared with an adjacency map keyed by string Ids built from the
+/// lanes and exits.
+TEST(RoadGraph, Build)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/road_graph.rndf";
+  ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, kWaypoints));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+  std::remove(filePath.c_str());
+  rndf.Coordinates();
+
+  const std::string input = "synthetic_" + std::to_string(kWaypoints);
+
+  benchmark::Measurement build("road_graph_build", input);
+  const RoadGraph &graph = rndf.RoadGraph();
+  build.Stop();
+  build.Add("edges", graph.NumEdges());
+  build.Report(graph.NumNodes());
+
+  // The adjacency map of the lanes.
+  benchmark::Measurement map("string_adjacency_map_build", input);
+  std::unordered_map<std::string, std::vector<std::string>> adjacency;
+  size_t mapEdges = 0;
+  for (auto const &segment : rndf.Segments())
+  {
+    for (auto const &lane : segment.Lanes())
+    {
+      const std::vector<Waypoint> &wps = lane.Waypoints();
+      for (size_t i = 0; i + 1 < wps.size(); ++i)
+      {
+        adjacency[UniqueId(segment.Id(), lane.Id(), wps[i].Id()).String()]
+          .push_back(
+            UniqueId(segment.Id(), lane.Id(), wps[i + 1].Id()).String());
+        ++mapEdges;
+      }
+      for (auto const &exit : lane.Exits())
+      {
+        adjacency[exit.ExitId().String()].push_back(exit.EntryId().String());
+        ++mapEdges;
+      }
+    }
+  }
+  map.Report(mapEdges);
+
+  // Breadth-first traversal from the first waypoint, which reaches the
+  // first lane of every segment.
+  benchmark::Measurement bfs("road_graph_breadth_first", input);
+  std::vector<uint8_t> visited(graph.NumNodes(), 0);
+  std::vector<uint32_t> queue;
+  queue.reserve(graph.NumNodes());
+  queue.push_back(0);
+  visited[0] = 1;
+  for (size_t q = 0; q < queue.size(); ++q)
+  {
+    const uint32_t node = queue[q];
+    for (uint32_t e = graph.Offsets()[node]; e < graph.Offsets()[node + 1];
+         ++e)
+    {
+      const uint32_t target = graph.Targets()[e];
+      if (!visited[target])
+      {
+        visited[target] = 1;
+        queue.push_back(target);
+      }
+    }
+  }
+  bfs.Report(queue.size());
+  EXPECT_GE(queue.size(), kWaypoints / 2);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RoadGraph.hh"
+#include "ignition/rndf/Router.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of rows and columns of intersections of the city, unless
+/// RNDF_BENCHMARK_GRID_SIZE sets another one.
+static const int kGridSize = 30;
+
+/// \brief Number of waypoints of every lane of the city.
+static const int kLaneWaypoints = 6;
+
+/// \brief Number of random routes of each size.
+static const size_t kRoutes = 500;
+
+/// \brief Cost of the shortest route between two nodes with Dijkstra's
+/// algorithm, allocating its state on every call.
+/// \param[in] _graph The graph.
+/// \param[in] _start The first node.
+/// \param[in] _goal The last node.
+/// \return The cost, or infinity if there is no route.
+double dijkstra(const RoadGraph &_graph, const uint32_t _start,
+  const uint32_t _goal)
+{
+  std::vector<double> costs(_graph.NumNodes(),
+    std::numeric_limits<double>::infinity());
+  using Entry = std::pair<double, uint32_t>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+  costs[_start] = 0;
+  queue.push(Entry(0, _start));
+  while (!queue.empty())
+  {
+    const Entry entry = queue.top();
+    queue.pop();
+    if (entry.second == _goal)
+      return entry.first;
+    if (entry.first > costs[entry.second])
+      continue;
+    for (uint32_t e = _graph.Offsets()[entry.second];
+         e < _graph.Offsets()[entry.second + 1]; ++e)
+    {
+      const uint32_t target = _graph.Targets()[e];
+      const double cost = entry.first + _graph.Lengths()[e];
+      if (cost < costs[target])
+      {
+        costs[target] = cost;
+        queue.push(Entry(cost, target));
+      }
+    }
+  }
+  return costs[_goal];
+}
+
+/// \brief Get the median of some durations.
+/// \param[in] _times The durations in seconds.
+/// \return The median in microseconds.
+double medianUs(std::vector<double> _times)
+{
+  std::nth_element(_times.begin(), _times.begin() + _times.size() / 2,
+    _times.end());
+  return _times[_times.size() / 2] * 1e6;
+}
+
+/////////////////////////////////////////////////
+/// \brief Latency of routes between random waypoints of a synthetic city,
+/// short (nearby waypoints) and long (anywhere in the city), with A* and
+/// with Dijkstra's algorithm.
+TEST(Routing, City)
+{
+  const int gridSize = static_cast<int>(
+    benchmark::sizeFromEnv("RNDF_BENCHMARK_GRID_SIZE", kGridSize));
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/routing.rndf";
+  {
+    std::ofstream file(filePath, std::ios::binary);
+    file << benchmark::syntheticGridRNDF(gridSize, gridSize, kLaneWaypoints);
+  }
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+  std::remove(filePath.c_str());
+
+  const RoadGraph &graph = rndf.RoadGraph();
+  Router router(graph);
+
+  // Random pairs of nodes. Short routes stay within 3 blocks.
+  std::mt19937 generator(42);
+  const uint32_t numNodes = static_cast<uint32_t>(graph.NumNodes());
+  std::uniform_int_distribution<uint32_t> nodeDist(0, numNodes - 1);
+  std::vector<std::pair<uint32_t, uint32_t>> longPairs;
+  std::vector<std::pair<uint32_t, uint32_t>> shortPairs;
+  while (longPairs.size() < kRoutes)
+    longPairs.emplace_back(nodeDist(generator), nodeDist(generator));
+  while (shortPairs.size() < kRoutes)
+  {
+    const uint32_t start = nodeDist(generator);
+    const uint32_t goal = nodeDist(generator);
+    if (std::abs(graph.Latitudes()[start] - graph.Latitudes()[goal]) <
+          0.006 &&
+        std::abs(graph.Longitudes()[start] - graph.Longitudes()[goal]) <
+          0.006)
+    {
+      shortPairs.emplace_back(start, goal);
+    }
+  }
+
+  const std::string input = "grid_" + std::to_string(gridSize) + "x" +
+    std::to_string(gridSize);
+
+  std::vector<uint32_t> nodes;
+  for (auto const *pairs : {&shortPairs, &longPairs})
+  {
+    const std::string length = pairs == &shortPairs ? "short" : "long";
+
+    std::vector<double> costs;
+    std::vector<double> times;
+    size_t settled = 0;
+    benchmark::Measurement aStar("route_astar_" + length, input);
+    for (auto const &pair : *pairs)
+    {
+      double cost = std::numeric_limits<double>::infinity();
+      auto start = std::chrono::steady_clock::now();
+      router.Route(pair.first, pair.second, nodes, cost);
+      std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+      times.push_back(time.count());
+      costs.push_back(cost);
+      settled += router.LastSettled();
+    }
+    aStar.Stop();
+    aStar.Add("median_us", medianUs(times));
+    aStar.Add("settled_per_route",
+      static_cast<double>(settled) / pairs->size());
+    aStar.Report(pairs->size());
+
+    std::vector<double> expected;
+    times.clear();
+    benchmark::Measurement baseline("route_dijkstra_" + length, input);
+    for (auto const &pair : *pairs)
+    {
+      auto start = std::chrono::steady_clock::now();
+      expected.push_back(dijkstra(graph, pair.first, pair.second));
+      std::chrono::duration<double> time =
+        std::chrono::steady_clock::now() - start;
+      times.push_back(time.count());
+    }
+    baseline.Stop();
+    baseline.Add("median_us", medianUs(times));
+    baseline.Report(pairs->size());
+
+    for (size_t i = 0; i < pairs->size(); ++i)
+    {
+      if (!std::isinf(expected[i]))
+      {
+        EXPECT_NEAR(costs[i], expected[i], 1e-6);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
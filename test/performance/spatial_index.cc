@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/CoordinateSnapshot.hh"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/SpatialIndex.hh"
+#include "ignition/rndf/UniqueId.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of waypoints of the synthetic RNDF loaded, unless
+/// RNDF_BENCHMARK_MAX_WAYPOINTS sets another one.
+static const size_t kWaypoints = 100000;
+
+/// \brief Number of queries of each kind.
+static const size_t kQueries = 2000;
+
+/// \brief Number of nearest waypoint queries answered by the linear scan.
+static const size_t kScanQueries = 200;
+
+/////////////////////////////////////////////////
+/// \brief Latency of nearest waypoint and radius queries of the spatial
+/// index of a synthetic RNDF, compared with a linear scan of the
+/// coordinate snapshot.
+TEST(SpatialIndex, Queries)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/spatial_index.rndf";
+  const size_t waypoints =
+    benchmark::sizeFromEnv("RNDF_BENCHMARK_MAX_WAYPOINTS", kWaypoints);
+  ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, waypoints));
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+  std::remove(filePath.c_str());
+
+  const std::string input = "synthetic_" + std::to_string(waypoints);
+
+  const CoordinateSnapshot &snapshot = rndf.Coordinates();
+  benchmark::Measurement build("spatial_index_build", input);
+  const SpatialIndex &index = rndf.SpatialIndex();
+  build.Report(snapshot.Size());
+  ASSERT_EQ(index.Size(), snapshot.Size());
+
+  // Random locations inside the bounding box of the RNDF.
+  const auto lat = std::minmax_element(snapshot.Latitudes().begin(),
+    snapshot.Latitudes().end());
+  const auto lon = std::minmax_element(snapshot.Longitudes().begin(),
+    snapshot.Longitudes().end());
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> latDist(*lat.first, *lat.second);
+  std::uniform_real_distribution<double> lonDist(*lon.first, *lon.second);
+  std::vector<double> qLats(kQueries);
+  std::vector<double> qLons(kQueries);
+  for (size_t i = 0; i < kQueries; ++i)
+  {
+    qLats[i] = latDist(generator);
+    qLons[i] = lonDist(generator);
+  }
+
+  // Linear scan in the same local frame used by the index.
+  const double latScale = 6371008.8 * 3.14159265358979323846 / 180;
+  const double lonScale = latScale *
+    std::cos((*lat.first + *lat.second) / 2 * 3.14159265358979323846 / 180);
+  std::vector<double> scanDistances(kScanQueries);
+  benchmark::Measurement scan("linear_scan_nearest", input);
+  for (size_t i = 0; i < kScanQueries; ++i)
+  {
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < snapshot.Size(); ++j)
+    {
+      const double dy = (snapshot.Latitudes()[j] - qLats[i]) * latScale;
+      const double dx = (snapshot.Longitudes()[j] - qLons[i]) * lonScale;
+      best = std::min(best, dx * dx + dy * dy);
+    }
+    scanDistances[i] = std::sqrt(best);
+  }
+  scan.Report(kScanQueries);
+
+  std::vector<double> distances(kQueries);
+  benchmark::Measurement nearest("spatial_index_nearest", input);
+  for (size_t i = 0; i < kQueries; ++i)
+  {
+    UniqueId id;
+    ASSERT_TRUE(index.Nearest(qLats[i], qLons[i], id, distances[i]));
+  }
+  nearest.Report(kQueries);
+
+  for (size_t i = 0; i < kScanQueries; ++i)
+    EXPECT_NEAR(distances[i], scanDistances[i], 1e-6);
+
+  std::vector<UniqueId> ids;
+  size_t found = 0;
+  benchmark::Measurement within("spatial_index_within_50m", input);
+  for (size_t i = 0; i < kQueries; ++i)
+    found += index.Within(qLats[i], qLons[i], 50, ids);
+  within.Stop();
+  within.Add("waypoints_per_query", static_cast<double>(found) / kQueries);
+  within.Report(kQueries);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/RNDF.hh"
+#include "ignition/rndf/RNDFVisitor.hh"
+#include "ignition/rndf/Waypoint.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief A visitor that only computes the mean position of the waypoints.
+class MeanVisitor : public RNDFVisitor
+{
+  // Documentation inherited.
+  public: virtual void OnWaypoint(const int, const int,
+                                  const Waypoint &_waypoint)
+  {
+    this->latitude += _waypoint.Latitude();
+    this->longitude += _waypoint.Longitude();
+    ++this->count;
+  }
+
+  /// \brief Sum of the latitudes.
+  public: double latitude = 0;
+
+  /// \brief Sum of the longitudes.
+  public: double longitude = 0;
+
+  /// \brief Number of waypoints.
+  public: size_t count = 0;
+};
+
+/////////////////////////////////////////////////
+/// \brief Peak heap usage of RNDF::Parse() and RNDF::Load() with synthetic
+/// networks of increasing size. The heap used by Parse() shouldn't grow
+/// with the size of the network.
+TEST(StreamingParse, PeakHeap)
+{
+  for (size_t size : {10000u, 100000u, 500000u})
+  {
+    const std::string filePath = std::string(PROJECT_BINARY_PATH) +
+      "/streaming_" + std::to_string(size) + ".rndf";
+    ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, size));
+
+    const std::string input = "synthetic_" + std::to_string(size);
+
+    MeanVisitor visitor;
+    benchmark::Measurement parse("streaming_parse", input);
+    const size_t before = benchmark::liveBytes();
+    EXPECT_TRUE(RNDF::Parse(filePath, visitor));
+    const size_t parsePeak = benchmark::peakBytes() - before;
+    parse.Report(visitor.count);
+
+    size_t loaded = 0;
+    benchmark::Measurement load("streaming_load", input);
+    {
+      RNDF rndf;
+      EXPECT_TRUE(rndf.Load(filePath));
+      loaded = rndf.NumSegments();
+    }
+    load.Report(visitor.count);
+
+    EXPECT_GT(loaded, 0u);
+    EXPECT_GE(visitor.count, size);
+    EXPECT_LT(parsePeak, 64u * 1024u);
+
+    std::remove(filePath.c_str());
+  }
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/test_config.h"
+#include "ignition/rndf/RNDF.hh"
+#include "Benchmark.hh"
+#include "SyntheticRNDF.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of waypoints of the synthetic RNDF saved.
+static const size_t kWaypoints = 500000;
+
+/////////////////////////////////////////////////
+/// \brief Time to save a synthetic RNDF as text and throughput of the
+/// writer, compared with the time to load the text back.
+TEST(TextWriter, Save)
+{
+  const std::string filePath =
+    std::string(PROJECT_BINARY_PATH) + "/text_writer.rndf";
+  const std::string savedPath = filePath + ".saved";
+  ASSERT_TRUE(benchmark::writeSyntheticRNDF(filePath, kWaypoints));
+
+  RNDF rndf;
+  ASSERT_TRUE(rndf.Load(filePath));
+
+  const std::string input = "synthetic_" + std::to_string(kWaypoints);
+
+  benchmark::Measurement save("rndf_save", input);
+  ASSERT_TRUE(rndf.Save(savedPath));
+  save.Stop();
+
+  std::ifstream saved(savedPath, std::ios::binary | std::ios::ate);
+  const double size = static_cast<double>(saved.tellg());
+  saved.close();
+  save.Add("bytes", size);
+  save.Report(kWaypoints);
+
+  benchmark::Measurement load("rndf_load", input);
+  RNDF loaded;
+  ASSERT_TRUE(loaded.Load(savedPath));
+  load.Report(kWaypoints);
+  EXPECT_EQ(rndf.NumSegments(), loaded.NumSegments());
+
+  std::remove(filePath.c_str());
+  std::remove(savedPath.c_str());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
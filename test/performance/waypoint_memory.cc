@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2017 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <ignition/math/SphericalCoordinates.hh>
+
+#include "gtest/gtest.h"
+#include "ignition/rndf/Waypoint.hh"
+#include "Benchmark.hh"
+
+using namespace ignition;
+using namespace rndf;
+
+/// \brief Number of waypoints created.
+static const int kWaypoints = 100000;
+
+/// \brief Number of times all the waypoints are visited.
+static const int kRounds = 20;
+
+/////////////////////////////////////////////////
+/// \brief Sum the latitude of all the waypoints kRounds times and report
+/// the time it takes.
+/// \param[in] _benchmark Name of the benchmark.
+/// \param[in] _waypoints The waypoints.
+/// \param[in] _viaLocation Whether to read the latitude through Location().
+/// \param[in] _bytes Bytes used by the waypoints.
+/// \param[in] _rssKiB Resident set size in KiB after creating them.
+void visit(const std::string &_benchmark,
+  const std::vector<Waypoint> &_waypoints, const bool _viaLocation,
+  const std::size_t _bytes, const int64_t _rssKiB)
+{
+  double sum = 0;
+  benchmark::Measurement measurement(_benchmark,
+    std::to_string(_waypoints.size()) + "_waypoints");
+  for (int i = 0; i < kRounds; ++i)
+  {
+    for (auto const &wp : _waypoints)
+    {
+      if (_viaLocation)
+        sum += wp.Location().LatitudeReference().Degree();
+      else
+        sum += wp.Latitude();
+    }
+  }
+  measurement.Stop();
+  measurement.Add("waypoint_bytes", static_cast<double>(_bytes));
+  measurement.Add("bytes_per_waypoint",
+    static_cast<double>(_bytes) / _waypoints.size());
+  measurement.Add("rss_kib", static_cast<double>(_rssKiB));
+  measurement.Report(_waypoints.size() * kRounds);
+  EXPECT_GT(sum, 0.0);
+}
+
+/////////////////////////////////////////////////
+/// \brief Compare the memory used by waypoints storing a plain latitude and
+/// longitude with the memory used once every waypoint also holds a
+/// SphericalCoordinates object, which is what each waypoint used to carry.
+TEST(WaypointMemory, CompactVersusLocation)
+{
+  std::vector<Waypoint> waypoints;
+  const std::size_t before = benchmark::liveBytes();
+  waypoints.reserve(kWaypoints);
+  for (int i = 0; i < kWaypoints; ++i)
+  {
+    waypoints.push_back(
+      Waypoint(i + 1, 34.58 + i * 1e-6, -117.36 - i * 1e-6));
+  }
+  const std::size_t compact = benchmark::liveBytes() - before;
+  visit("waypoint_visit_compact", waypoints, false, compact,
+    benchmark::currentRssKiB());
+
+  // Materialize the SphericalCoordinates of every waypoint through the
+  // read-only accessor, as the consumers that scan all the waypoints do.
+  // They are kept by the waypoints from then on.
+  const std::vector<Waypoint> &constWaypoints = waypoints;
+  for (auto const &wp : constWaypoints)
+    wp.Location();
+  const std::size_t full = benchmark::liveBytes() - before;
+  visit("waypoint_visit_location", waypoints, true, full,
+    benchmark::currentRssKiB());
+
+  // The compact waypoints don't allocate anything besides the vector.
+  EXPECT_EQ(compact, kWaypoints * sizeof(Waypoint));
+  if (sizeof(void *) == 8)
+  {
+    EXPECT_EQ(sizeof(Waypoint), 40u);
+  }
+  EXPECT_GT(full, compact);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}